@@ -0,0 +1,95 @@
+/**
+ * @file ana_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding ana.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef ANA_E_H
+#define ANA_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "main.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Analog inputs, in the order of the ADC1 regular sequence (see MX_ADC1_Init)
+ *
+ */
+typedef enum
+{
+  ANA_CH_HALL_01 = 0, /* PC1, ADC1_IN11 */
+  ANA_CH_HALL_02,     /* PC2, ADC1_IN12 */
+  ANA_CH_HALL_03,     /* PC3, ADC1_IN13 */
+  ANA_CH_EMG_01,      /* PA3, ADC1_IN3 */
+  ANA_CH_EMG_02,      /* PA4, ADC1_IN4 */
+  ANA_CH_TRIM_POT_01, /* PA2, ADC1_IN2 */
+  ANA_CH_TRIM_POT_02, /* PA1, ADC1_IN1 */
+  ANA_CH_BATT,        /* PC0, ADC1_IN10 */
+  ANA_CH_COUNT
+} ana_Channel_e;
+
+/**
+ * @brief Point of the motor PWM cycle at which a scan was taken
+ *
+ * The motor timers count up and down (center-aligned) and trigger a scan at both turning points,
+ * which are the middle of the on and of the off part of every PWM output
+ */
+typedef enum
+{
+  ANA_PHASE_PEAK = 0, /* Counter at its top, middle of the off time */
+  ANA_PHASE_TROUGH,   /* Counter at zero, middle of the on time */
+  ANA_PHASE_COUNT
+} ana_Phase_e;
+
+/**
+ * @brief Largest value a 12-bit conversion can return
+ *
+ */
+#define ANA_MAX_VALUE 4095
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Latest conversion of every analog input at both points of the PWM cycle,
+ * written by the DMA in the background
+ *
+ * @values 0..ANA_MAX_VALUE, indexed by ana_Phase_e and ana_Channel_e
+ */
+extern volatile uint16_t ana_g_Raw_u16[ANA_PHASE_COUNT][ANA_CH_COUNT];
+
+/**
+ * @brief Which of the two scans ana_f_Get_u16() returns, the one furthest from any switching edge
+ *
+ */
+extern ana_Phase_e ana_g_QuietPhase_e;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void ana_f_Init_v(void);
+extern void ana_f_Start_v(void);
+extern void ana_f_Stop_v(void);
+extern void ana_f_SetBattSampling_v(uint32_t samplingTime);
+extern uint16_t ana_f_Get_u16(ana_Channel_e channel);
+extern void ana_f_SetQuietPhase_v(ana_Phase_e phase);
+
+#endif // ANA_E_H
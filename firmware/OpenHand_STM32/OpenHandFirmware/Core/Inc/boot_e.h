@@ -0,0 +1,108 @@
+/**
+ * @file boot_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding boot.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef BOOT_E_H
+#define BOOT_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "main.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Flash layout, has to match the memory regions of the linker script
+ *
+ * The boot stage, the application and the staging area for a new application, then the control record with
+ * the page the boot stage swaps through, and the records of nvm.c. The application and the staging area are
+ * the same size, so any application that fits can be staged
+ */
+#define BOOT_BOOT_ADDRESS 0x08000000UL
+#define BOOT_APP_ADDRESS 0x08004000UL
+#define BOOT_STAGE_ADDRESS 0x08041000UL
+#define BOOT_CONTROL_ADDRESS 0x0807E000UL
+#define BOOT_SCRATCH_ADDRESS (BOOT_CONTROL_ADDRESS + FLASH_PAGE_SIZE)
+#define BOOT_IMAGE_SIZE (BOOT_STAGE_ADDRESS - BOOT_APP_ADDRESS)
+#define BOOT_IMAGE_PAGES (BOOT_IMAGE_SIZE / FLASH_PAGE_SIZE)
+
+/**
+ * @brief Marks a valid control record, an erased page reads 0xFFFFFFFF
+ *
+ */
+#define BOOT_MAGIC 0x31445055UL /* "UPD1" */
+
+/**
+ * @brief Value of a flag in the control record
+ *
+ * A flag is set by programming its erased halfword once, so no flag ever needs the page erased
+ */
+#define BOOT_FLAG_CLEAR 0xFFFF
+#define BOOT_FLAG_SET 0x0000
+
+/**
+ * @brief Swaps of the application and the staging area, each has its own progress flags in the control record
+ *
+ */
+typedef enum
+{
+  BOOT_SWAP_INSTALL = 0, /* New image in, the old one into the staging area */
+  BOOT_SWAP_REVERT,      /* And back, when the new image was not confirmed */
+  BOOT_SWAP_COUNT
+} boot_Swap_e;
+
+/**
+ * @brief Steps of swapping one page, each one is marked done in the control record
+ *
+ */
+typedef enum
+{
+  BOOT_STEP_SAVED = 0, /* Application page copied to the scratch page */
+  BOOT_STEP_APP,       /* Staging page copied to the application page */
+  BOOT_STEP_STAGE,     /* Scratch page copied to the staging page */
+  BOOT_STEP_COUNT
+} boot_Step_e;
+
+/**************************************************************************
+ * Structures
+ **************************************************************************/
+
+/**
+ * @brief Control record shared by the boot stage and the updater (upd.c), at BOOT_CONTROL_ADDRESS
+ *
+ * Written by the updater in this order: header, erased, committed, then confirmed once the new image runs.
+ * The boot stage sets installed, reverted and the steps of its swaps
+ */
+typedef struct
+{
+  uint32_t magic_u32;     /* BOOT_MAGIC */
+  uint32_t size_u32;      /* Size of the staged image, bytes */
+  uint32_t crc_u32;       /* CRC-32 of the staged image */
+  uint16_t erased_u16;    /* Staging area erased for this image */
+  uint16_t committed_u16; /* Whole image received and its CRC checked, install on the next reset */
+  uint16_t installed_u16; /* Image swapped into the application area and checked there, the old one is staged */
+  uint16_t confirmed_u16; /* The new image reached its updater, the old one is let go */
+  uint16_t reverted_u16;  /* The new image was not confirmed or didn't check out, the old one is back */
+  uint16_t reserved_u16;
+  uint16_t swap_u16[BOOT_SWAP_COUNT][BOOT_IMAGE_PAGES][BOOT_STEP_COUNT]; /* Steps done, a swap resumes from them */
+} boot_s_Control_t;
+
+_Static_assert(sizeof(boot_s_Control_t) <= FLASH_PAGE_SIZE, "the control record has to fit into its page");
+
+#endif // BOOT_E_H
@@ -0,0 +1,74 @@
+/**
+ * @file boot_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding boot.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef BOOT_I_H
+#define BOOT_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "boot_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Puts code into the boot stage, which the linker script keeps at the start of flash
+ *
+ * Everything the boot stage calls has to be in there as well, as the application area may be half written
+ */
+#define BOOT_TEXT __attribute__((section(".boot.text")))
+
+/**
+ * @brief RAM the stack pointer of a valid application points into
+ *
+ */
+#define BOOT_RAM_START 0x20000000UL
+#define BOOT_RAM_END 0x20010000UL
+
+/**
+ * @brief Entry of the vector table
+ *
+ */
+typedef void (*boot_Vector_t)(void);
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Top of the stack, from the linker script
+ *
+ */
+extern uint32_t _estack;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void boot_f_Reset_v(void) BOOT_TEXT;
+extern void boot_f_Fault_v(void) BOOT_TEXT;
+extern void boot_f_Swap_v(const boot_s_Control_t *control, boot_Swap_e swap) BOOT_TEXT;
+extern void boot_f_CopyPage_v(uint32_t destination, uint32_t source) BOOT_TEXT;
+extern void boot_f_StartApp_v(void) BOOT_TEXT;
+extern uint32_t boot_f_Crc32_u32(uint32_t address, uint32_t len) BOOT_TEXT;
+extern void boot_f_FlashWait_v(void) BOOT_TEXT;
+extern void boot_f_ErasePage_v(uint32_t address) BOOT_TEXT;
+extern void boot_f_Program_v(uint32_t address, uint16_t halfWord) BOOT_TEXT;
+
+#endif // BOOT_I_H
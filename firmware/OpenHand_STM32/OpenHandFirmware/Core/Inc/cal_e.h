@@ -0,0 +1,89 @@
+/**
+ * @file cal_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding cal.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef CAL_E_H
+#define CAL_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "main.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief States of the calibration routine
+ *
+ */
+typedef enum
+{
+  CAL_IDLE = 0, /* Not running, motors belong to the rest of the firmware */
+  CAL_OPENING,  /* Driving the current finger to its open end stop */
+  CAL_SETTLE,   /* Waiting for the finger to come to rest at the open end stop */
+  CAL_CLOSING,  /* Driving the current finger to its closed end stop, recording the hall sensor */
+  CAL_DONE,     /* All fingers calibrated and stored */
+  CAL_FAILED    /* Aborted, see cal_g_Error_e */
+} cal_State_e;
+
+/**
+ * @brief Why the calibration failed
+ *
+ */
+typedef enum
+{
+  CAL_ERR_NONE = 0,
+  CAL_ERR_TIMEOUT, /* No end stop found within CAL_SWEEP_TIMEOUT_MS */
+  CAL_ERR_FAULT,   /* The motor bridge reported a fault */
+  CAL_ERR_RANGE,   /* The hall value barely changed over the sweep (magnet or sensor missing) */
+  CAL_ERR_FLASH    /* The result could not be stored */
+} cal_Error_e;
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Current state of the calibration routine
+ *
+ */
+extern cal_State_e cal_g_State_e;
+
+/**
+ * @brief Finger being calibrated, or that failed
+ *
+ * @values 0..POS_FINGER_COUNT - 1
+ */
+extern uint8_t cal_g_Finger_u8;
+
+/**
+ * @brief Reason of the last failure
+ *
+ */
+extern cal_Error_e cal_g_Error_e;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void cal_f_Init_v(void);
+extern void cal_f_Handle_v(void);
+extern void cal_f_Start_v(void);
+extern uint8_t cal_f_IsRunning_u8(void);
+
+#endif // CAL_E_H
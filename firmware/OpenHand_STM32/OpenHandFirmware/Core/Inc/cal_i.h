@@ -0,0 +1,147 @@
+/**
+ * @file cal_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding cal.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef CAL_I_H
+#define CAL_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "cal_e.h"
+#include "pos_e.h"
+#include "mot_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Duty cycle used to sweep the fingers
+ *
+ * Low enough that hitting an end stop does no harm, high enough that the finger never stalls on friction.
+ * The sweep assumes the finger moves at a constant speed, so this should be well above the breakaway duty
+ *
+ * @values 1..MOT_DUTY_MAX (permille)
+ */
+#define CAL_SWEEP_DUTY 250
+
+/**
+ * @brief End stop detection: the finger is at an end stop when the hall value changes
+ * by less than CAL_STALL_DELTA within CAL_STALL_WINDOW_MS
+ *
+ * @values CAL_STALL_WINDOW_MS in milliseconds, CAL_STALL_DELTA in raw ADC counts (above the noise)
+ */
+#define CAL_STALL_WINDOW_MS 200
+#define CAL_STALL_DELTA 6
+
+/**
+ * @brief Longest time a single sweep may take before it is considered stuck
+ *
+ * @values in milliseconds
+ */
+#define CAL_SWEEP_TIMEOUT_MS 8000
+
+/**
+ * @brief How long to coast at the open end stop before the closing sweep
+ *
+ * @values in milliseconds
+ */
+#define CAL_SETTLE_MS 300
+
+/**
+ * @brief Smallest raw hall range over the full travel that is still usable
+ *
+ * @values in raw ADC counts, > CAL_STALL_DELTA * 4
+ */
+#define CAL_MIN_RANGE 100
+
+/**
+ * @brief Recording of the closing sweep
+ *
+ * The hall value is recorded every CAL_SAMPLE_PERIOD_MS. When the buffer fills up every other
+ * sample is dropped and the period doubled, so any sweep length fits into CAL_MAX_SAMPLES
+ *
+ * @values CAL_SAMPLE_PERIOD_MS in milliseconds, CAL_MAX_SAMPLES even and > POS_LUT_SIZE * 4
+ */
+#define CAL_SAMPLE_PERIOD_MS 2
+#define CAL_MAX_SAMPLES 512
+
+/**
+ * @brief Holding BTN_01 this long starts a new calibration
+ *
+ * @values in milliseconds
+ */
+#define CAL_BUTTON_HOLD_MS 3000
+
+/**
+ * @brief Pin level of BTN_01 when pressed
+ *
+ * @values GPIO_PIN_RESET, GPIO_PIN_SET
+ */
+#define CAL_BUTTON_PRESSED GPIO_PIN_RESET
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Time spent in the current state
+ *
+ * @values in milliseconds
+ */
+extern uint32_t cal_g_StateMs_u32;
+
+/**
+ * @brief End stop detection window: its age and the hall value at its start
+ *
+ */
+extern uint16_t cal_g_WindowMs_u16;
+extern uint16_t cal_g_WindowRaw_u16;
+
+/**
+ * @brief Hall values recorded during the closing sweep, evenly spaced in time
+ *
+ */
+extern uint16_t cal_g_Samples_u16[CAL_MAX_SAMPLES];
+extern uint16_t cal_g_SampleCnt_u16;
+extern uint16_t cal_g_SamplePeriodMs_u16;
+extern uint16_t cal_g_SampleTimerMs_u16;
+
+/**
+ * @brief Calibration being built, handed over to pos.c once all fingers are done
+ *
+ */
+extern pos_s_CalData_t cal_g_Result_s;
+
+/**
+ * @brief How long BTN_01 has been held
+ *
+ * @values in milliseconds
+ */
+extern uint16_t cal_g_ButtonMs_u16;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void cal_f_StartFinger_v(uint8_t fingerIndex);
+extern uint8_t cal_f_Stalled_u8(uint16_t raw);
+extern void cal_f_Record_v(uint16_t raw);
+extern uint8_t cal_f_BuildLut_u8(pos_s_FingerLut_t *lut);
+extern void cal_f_Fail_v(cal_Error_e error);
+
+#endif // CAL_I_H
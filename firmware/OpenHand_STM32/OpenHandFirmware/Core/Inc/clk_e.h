@@ -0,0 +1,88 @@
+/**
+ * @file clk_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding clk.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef CLK_E_H
+#define CLK_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "main.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Clock profiles the system can run in
+ *
+ */
+typedef enum
+{
+  CLK_PROFILE_FULL = 0, /* 72 MHz from HSE through the PLL, USB clocked */
+  CLK_PROFILE_LOW,      /* 16 MHz straight from HSE, PLL off, USB not clocked */
+  CLK_PROFILE_COUNT
+} clk_Profile_e;
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Clock profile the system currently runs in
+ *
+ */
+extern clk_Profile_e clk_g_Profile_e;
+
+/**
+ * @brief Whether the profile follows the load, clear it to keep a profile set with clk_f_SetProfile_u8()
+ *
+ * @values 0 - fixed, 1 - automatic
+ */
+extern uint8_t clk_g_Auto_u8;
+
+/**
+ * @brief Share of the CPU time the modules took over the last load window
+ *
+ * @values 0..1000 (permille)
+ */
+extern uint16_t clk_g_LoadPermille_u16;
+
+/**
+ * @brief How many times the profile was switched, and how many switches did not end up in the requested profile
+ *
+ */
+extern uint32_t clk_g_SwitchCnt_u32;
+extern uint32_t clk_g_SwitchFailCnt_u32;
+
+/**
+ * @brief How many switches were followed by a first scan that did not come at the top of the PWM cycle
+ *
+ */
+extern uint32_t clk_g_PhaseSlipCnt_u32;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void clk_f_Init_v(void);
+extern void clk_f_Handle_v(void);
+extern uint8_t clk_f_SetProfile_u8(clk_Profile_e profile);
+extern uint32_t clk_f_Cycles_u32(void);
+extern void clk_f_AddBusy_v(uint32_t cycles);
+
+#endif // CLK_E_H
@@ -0,0 +1,149 @@
+/**
+ * @file clk_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding clk.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef CLK_I_H
+#define CLK_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "clk_e.h"
+#include "ana_e.h"
+#include "mot_e.h"
+#include "cal_e.h"
+#include "hom_e.h"
+#include "led_e.h"
+#include "tlm_e.h"
+#include "upd_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Length of the window over which the CPU load is averaged
+ *
+ * @values 1..1000 (milliseconds)
+ */
+#define CLK_LOAD_WINDOW_MS 100
+
+/**
+ * @brief Load at which the low profile switches up, and load the full profile has to project
+ * below in the low profile before switching down
+ *
+ * The gap between the two keeps the profile from toggling on a steady load
+ *
+ * @values 0..1000 (permille), CLK_LOAD_DOWN_PERMILLE < CLK_LOAD_UP_PERMILLE
+ */
+#define CLK_LOAD_UP_PERMILLE 600
+#define CLK_LOAD_DOWN_PERMILLE 300
+
+/**
+ * @brief How long the fingers have to be idle before switching down
+ *
+ * @values in milliseconds
+ */
+#define CLK_IDLE_MS 2000
+
+/**
+ * @brief How long clk_f_CheckPhase_u8() waits for the first scan after a switch
+ *
+ * The first trigger comes half a PWM period after the timers start, and the scan takes up to 90us
+ *
+ * @values in microseconds, more than half a PWM period plus one scan
+ */
+#define CLK_PHASE_TIMEOUT_US 200
+
+/**
+ * @brief Configuration of a clock profile
+ *
+ * AHB and APB2 are never divided, so TIM1, ADC and the CPU always see the system clock.
+ * APB1 is limited to 36 MHz
+ *
+ * A scan of all 8 analog inputs has to end before the next trigger, 25us later (both turning points of the 20 kHz
+ * PWM). It takes 7 x (7.5 + 12.5) ADC cycles for the hall, EMG and trim pot inputs, plus the battery sampling time
+ * and 12.5 cycles
+ */
+typedef struct
+{
+  uint32_t pllState_u32;     /* RCC_PLL_ON, RCC_PLL_OFF */
+  uint32_t pllMul_u32;       /* RCC_PLL_MULx, PLL input is HSE / 2 = 8 MHz */
+  uint32_t sysclkSource_u32; /* RCC_SYSCLKSOURCE_x */
+  uint32_t flashLatency_u32; /* FLASH_LATENCY_x: 0 up to 24 MHz, 1 up to 48 MHz, 2 above */
+  uint32_t apb1Div_u32;      /* RCC_HCLK_DIVx */
+  uint32_t adcDiv_u32;       /* RCC_ADCPCLK2_DIVx, ADC clock has to stay below 14 MHz */
+  uint32_t battSampling_u32; /* ADC_SAMPLETIME_x of the battery input */
+  uint32_t hclkHz_u32;       /* Resulting system clock, used to project the load */
+} clk_s_ProfileConfig_t;
+
+/**
+ * @brief Configures all clock profiles, indexed by clk_Profile_e
+ *
+ * CLK_PROFILE_FULL has to match SystemClock_Config() and MX_ADC1_Init(), which start the system in it.
+ *
+ * Full: ADC 12 MHz, battery 28.5 cycles, scan 181 cycles = 15.1us, 9.9us margin.
+ * Low: ADC 8 MHz (the most 16 MHz allows), battery 13.5 cycles, scan 166 cycles = 20.8us, 4.2us margin.
+ * With 28.5 cycles the low profile scan would take 22.6us and leave 2.4us. 13.5 cycles at 8 MHz still sample
+ * the battery divider for 1.7us, 70% of the full profile, and the battery is only watched while the fingers are idle
+ */
+clk_s_ProfileConfig_t clk_s_ProfileConfig_s[CLK_PROFILE_COUNT] = {
+    /* PLL          mul            sysclk                    latency          APB1            ADC                battery                    HCLK */
+    {RCC_PLL_ON,  RCC_PLL_MUL9, RCC_SYSCLKSOURCE_PLLCLK, FLASH_LATENCY_2, RCC_HCLK_DIV2, RCC_ADCPCLK2_DIV6, ADC_SAMPLETIME_28CYCLES_5, 72000000}, /* full: ADC 12 MHz */
+    {RCC_PLL_OFF, RCC_PLL_MUL9, RCC_SYSCLKSOURCE_HSE,    FLASH_LATENCY_0, RCC_HCLK_DIV1, RCC_ADCPCLK2_DIV2, ADC_SAMPLETIME_13CYCLES_5, 16000000}  /* low: ADC 8 MHz */
+};
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Peripheral handles whose timings depend on the clock, configured in main.c
+ *
+ */
+extern UART_HandleTypeDef huart4;
+extern I2C_HandleTypeDef hi2c1;
+
+/**
+ * @brief Motor timer triggering the ADC and the DMA of the ADC, configured in main.c
+ *
+ */
+extern TIM_HandleTypeDef htim3;
+extern DMA_HandleTypeDef hdma_adc1;
+
+/**
+ * @brief CPU cycles spent in the modules and milliseconds counted in the current load window
+ *
+ */
+extern uint32_t clk_g_BusyCycles_u32;
+extern uint16_t clk_g_WindowMs_u16;
+
+/**
+ * @brief How long the fingers have been idle
+ *
+ * @values 0..CLK_IDLE_MS (milliseconds)
+ */
+extern uint32_t clk_g_IdleMs_u32;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern uint8_t clk_f_HasDemand_u8(void);
+extern void clk_f_RetimePeripherals_v(void);
+extern uint8_t clk_f_CheckPhase_u8(void);
+
+#endif // CLK_I_H
@@ -0,0 +1,86 @@
+/**
+ * @file hom_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding hom.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef HOM_E_H
+#define HOM_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "main.h"
+#include "pos_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief States of the homing sequence
+ *
+ */
+typedef enum
+{
+  HOM_PENDING = 0, /* Waiting for the hall calibration to finish before starting */
+  HOM_RUNNING,     /* Fingers are moving to their open end stops */
+  HOM_DONE,        /* All fingers reached their open end stop */
+  HOM_FAILED       /* At least one finger did not, see hom_g_FingerState_e */
+} hom_State_e;
+
+/**
+ * @brief Homing state of a single finger
+ *
+ */
+typedef enum
+{
+  HOM_FINGER_MOVING = 0,
+  HOM_FINGER_HOMED,   /* Stalled at the open end stop, reference taken */
+  HOM_FINGER_TIMEOUT, /* Still moving when the time budget ran out */
+  HOM_FINGER_FAULT    /* The motor bridge reported a fault */
+} hom_FingerState_e;
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief State of the homing sequence
+ *
+ */
+extern hom_State_e hom_g_State_e;
+
+/**
+ * @brief Homing state of each finger
+ *
+ */
+extern hom_FingerState_e hom_g_FingerState_e[POS_FINGER_COUNT];
+
+/**
+ * @brief How long the homing took, from boot until the last finger stopped
+ *
+ * @values in milliseconds
+ */
+extern uint32_t hom_g_DoneAtMs_u32;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void hom_f_Init_v(void);
+extern void hom_f_Handle_v(void);
+extern uint8_t hom_f_IsRunning_u8(void);
+
+#endif // HOM_E_H
@@ -0,0 +1,114 @@
+/**
+ * @file hom_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding hom.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef HOM_I_H
+#define HOM_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "hom_e.h"
+#include "mot_e.h"
+#include "cal_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Time from the start of homing by which all fingers have to be at their open end stop
+ *
+ * Counted from hom_f_Start_v(), so the wait for a running hall calibration comes on top of it
+ *
+ * @values in milliseconds
+ */
+#define HOM_TIME_BUDGET_MS 1500
+
+/**
+ * @brief Opening duty cycle: while far from the end stop, and on the last part of the way
+ *
+ * The approach duty limits the force on the end stop. Without a calibration the position is not known,
+ * so the whole way is done at the approach duty
+ *
+ * @values 1..MOT_DUTY_MAX (permille)
+ */
+#define HOM_FAST_DUTY 600
+#define HOM_APPROACH_DUTY 300
+
+/**
+ * @brief Position below which the finger slows down to HOM_APPROACH_DUTY
+ *
+ * @values 0..POS_FULL_SCALE
+ */
+#define HOM_APPROACH_POS 1500
+
+/**
+ * @brief Hall velocity is the change of the raw value over HOM_VEL_WINDOW_MS
+ *
+ * @values 1..HOM_VEL_HISTORY (milliseconds)
+ */
+#define HOM_VEL_WINDOW_MS 20
+#define HOM_VEL_HISTORY 32
+
+/**
+ * @brief A finger has stalled once its hall velocity stays below HOM_STALL_DELTA for HOM_STALL_CONFIRM_MS
+ *
+ * @values HOM_STALL_DELTA in raw ADC counts per HOM_VEL_WINDOW_MS, HOM_STALL_CONFIRM_MS in milliseconds
+ */
+#define HOM_STALL_DELTA 3
+#define HOM_STALL_CONFIRM_MS 40
+
+/**
+ * @brief Stall detection is off for this long after start, while the motors spin up
+ *
+ * @values in milliseconds
+ */
+#define HOM_SPINUP_MS 60
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Last HOM_VEL_HISTORY filtered raw hall values of each finger, and where the next one goes
+ *
+ */
+extern uint16_t hom_g_History_u16[POS_FINGER_COUNT][HOM_VEL_HISTORY];
+extern uint8_t hom_g_HistoryIdx_u8;
+
+/**
+ * @brief Time since homing started
+ *
+ * @values in milliseconds
+ */
+extern uint32_t hom_g_ElapsedMs_u32;
+
+/**
+ * @brief For how long the hall velocity of each finger has been below HOM_STALL_DELTA
+ *
+ * @values in milliseconds
+ */
+extern uint16_t hom_g_StillMs_u16[POS_FINGER_COUNT];
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void hom_f_Start_v(void);
+extern void hom_f_Finish_v(void);
+
+#endif // HOM_I_H
@@ -0,0 +1,156 @@
+/**
+ * @file hwa_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding hwa.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * The accessors are inline register accesses for the control loop hot path, each compiles down to
+ * one or two load/store instructions instead of a HAL call with its parameter checks.
+ * They take the same GPIO_PIN_x masks and TIM_CHANNEL_x values as the HAL, so the pin and channel
+ * definitions from CubeMX can be used as they are. They don't lock or check anything,
+ * the caller has to pass a pin configured as output or input and a running PWM channel
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef HWA_E_H
+#define HWA_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "main.h"
+#include "ana_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Operations measured by the benchmark, each once through the HAL and once through the fast path
+ *
+ */
+typedef enum
+{
+  HWA_BENCH_PIN_WRITE = 0, /* Direction pin write */
+  HWA_BENCH_PIN_READ,      /* Fault pin read */
+  HWA_BENCH_SET_COMPARE,   /* PWM compare update */
+  HWA_BENCH_ANA_READ,      /* Hall value, HAL_ADC_GetValue() against the ADC DMA buffer */
+  HWA_BENCH_CONTROL_STEP,  /* All of the above for every motor, as one motor control loop iteration does it */
+  HWA_BENCH_COUNT
+} hwa_Bench_e;
+
+/**************************************************************************
+ * Structures
+ **************************************************************************/
+
+/**
+ * @brief Result of one benchmarked operation
+ *
+ */
+typedef struct
+{
+  uint32_t halCycles_u32;  /* Fastest of all runs through the HAL */
+  uint32_t fastCycles_u32; /* Fastest of all runs through the fast path */
+} hwa_s_BenchResult_t;
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief CPU cycles each operation takes, measured once on boot, with the measurement overhead removed
+ *
+ * @values indexed by hwa_Bench_e
+ */
+extern hwa_s_BenchResult_t hwa_g_Bench_s[HWA_BENCH_COUNT];
+
+/**
+ * @brief Share of a HWA_LOOP_FREQ_HZ loop period one fast path control step takes, at the boot clock
+ *
+ * @values 0..1000 (permille)
+ */
+extern uint16_t hwa_g_StepPermille_u16;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void hwa_f_Benchmark_v(void);
+
+/**
+ * @brief Drive an output pin high or low, atomically through BSRR
+ *
+ * @param port - GPIO port
+ * @param pin - GPIO_PIN_x mask
+ * @param state - 0 low, otherwise high
+ *
+ * @return void
+ */
+static inline void hwa_f_PinWrite_v(GPIO_TypeDef *port, uint16_t pin, uint8_t state)
+{
+  port->BSRR = state ? (uint32_t)pin : ((uint32_t)pin << 16);
+}
+
+/**
+ * @brief Read the level of an input pin
+ *
+ * @param port - GPIO port
+ * @param pin - GPIO_PIN_x mask
+ *
+ * @return uint8_t - 0 low, 1 high
+ */
+static inline uint8_t hwa_f_PinRead_u8(GPIO_TypeDef *port, uint16_t pin)
+{
+  return (port->IDR & pin) != 0;
+}
+
+/**
+ * @brief Address of the compare register of a timer channel, to be looked up once and then written directly
+ *
+ * CCR1..CCR4 follow each other, and TIM_CHANNEL_x is 4 times the channel offset
+ *
+ * @param tim - timer
+ * @param channel - TIM_CHANNEL_1..TIM_CHANNEL_4
+ *
+ * @return volatile uint32_t* - compare register
+ */
+static inline volatile uint32_t *hwa_f_CompareReg_pu32(TIM_TypeDef *tim, uint32_t channel)
+{
+  return &tim->CCR1 + (channel >> 2);
+}
+
+/**
+ * @brief Write a PWM compare value, takes effect at the next timer update (compare preload is on)
+ *
+ * @param ccr - compare register from hwa_f_CompareReg_pu32()
+ * @param value - 0..ARR + 1
+ *
+ * @return void
+ */
+static inline void hwa_f_SetCompare_v(volatile uint32_t *ccr, uint32_t value)
+{
+  *ccr = value;
+}
+
+/**
+ * @brief Latest conversion of an analog input from the quiet half of the DMA buffer, same as ana_f_Get_u16()
+ *
+ * @param channel - which input
+ *
+ * @return uint16_t - raw 12-bit value
+ */
+static inline uint16_t hwa_f_AnaRead_u16(ana_Channel_e channel)
+{
+  return ana_g_Raw_u16[ana_g_QuietPhase_e][channel];
+}
+
+#endif // HWA_E_H
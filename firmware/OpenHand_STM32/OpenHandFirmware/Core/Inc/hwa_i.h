@@ -0,0 +1,101 @@
+/**
+ * @file hwa_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding hwa.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef HWA_I_H
+#define HWA_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "hwa_e.h"
+#include "clk_e.h"
+#include "mot_e.h"
+#include "pos_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief How many times each operation is run, the fastest run is kept,
+ * so runs hit by an interrupt or a flash prefetch miss are filtered out
+ *
+ * @values 1..UINT16_MAX
+ */
+#define HWA_BENCH_RUNS 64
+
+/**
+ * @brief Rate of the motor control loop the control step is compared against
+ *
+ * @values in Hz
+ */
+#define HWA_LOOP_FREQ_HZ 5000
+
+/**
+ * @brief Time one statement in CPU cycles, keeping the fastest of HWA_BENCH_RUNS runs
+ *
+ * The cycle counter reads are part of every run, so hwa_g_OverheadCycles_u32 is taken off afterwards
+ */
+#define HWA_BENCH_MIN(result, statement)                 \
+  do                                                     \
+  {                                                      \
+    uint16_t l_run_u16;                                  \
+    uint32_t l_start_u32;                                \
+    uint32_t l_cycles_u32;                               \
+    (result) = UINT32_MAX;                               \
+    for (l_run_u16 = 0; l_run_u16 < HWA_BENCH_RUNS; l_run_u16++) \
+    {                                                    \
+      l_start_u32 = clk_f_Cycles_u32();                  \
+      statement;                                         \
+      l_cycles_u32 = clk_f_Cycles_u32() - l_start_u32;   \
+      if (l_cycles_u32 < (result))                       \
+      {                                                  \
+        (result) = l_cycles_u32;                         \
+      }                                                  \
+    }                                                    \
+  } while (0)
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief ADC handle, configured in main.c
+ *
+ */
+extern ADC_HandleTypeDef hadc1;
+
+/**
+ * @brief Cycles the measurement itself takes
+ *
+ */
+extern uint32_t hwa_g_OverheadCycles_u32;
+
+/**
+ * @brief Sink for the values read in the benchmark, so the compiler can't drop the reads
+ *
+ */
+extern volatile uint32_t hwa_g_Sink_u32;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void hwa_f_ControlStepHal_v(void);
+extern void hwa_f_ControlStepFast_v(void);
+
+#endif // HWA_I_H
@@ -0,0 +1,160 @@
+/**
+ * @file irq_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding irq.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * The measurement functions are inline, as they are called at the start and end of every measured ISR
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef IRQ_E_H
+#define IRQ_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "main.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Interrupts whose timing is measured
+ *
+ */
+typedef enum
+{
+  IRQ_ID_SYSTICK = 0, /* HAL time base, paces the main loop */
+  IRQ_ID_ADC_DMA,     /* DMA1 channel 1, ADC scans; disabled, stays at 0 unless someone needs the scan interrupts again */
+  IRQ_ID_UART4,       /* Telemetry link */
+  IRQ_ID_RCC,         /* Clock system */
+  IRQ_ID_COUNT
+} irq_Id_e;
+
+/**
+ * @brief Interrupt that drives the probe pin high from its entry to its exit, for measuring with a scope
+ *
+ * With a scope on the probe pin and on the signal that raises the interrupt, the delay between the two edges
+ * is the real entry latency, and the pulse width is the execution time
+ *
+ * @values irq_Id_e, IRQ_ID_COUNT for none
+ */
+#define IRQ_PROBE_ID IRQ_ID_COUNT
+
+/**
+ * @brief Probe pin, LED_02 is reachable on the board
+ *
+ * The LED module hands the pin over to the probe whenever IRQ_PROBE_ID is set, see led_f_Init_v()
+ */
+#define IRQ_PROBE_PORT LED_02_GPIO_Port
+#define IRQ_PROBE_PIN LED_02_Pin
+
+/**************************************************************************
+ * Structures
+ **************************************************************************/
+
+/**
+ * @brief Timing of one interrupt, all times in CPU cycles
+ *
+ */
+typedef struct
+{
+  uint32_t count_u32;      /* How many times it ran */
+  uint32_t lastCycles_u32; /* Entry to exit of the last run */
+  uint32_t maxCycles_u32;  /* Longest entry to exit, including time spent in interrupts that preempted it */
+  uint32_t maxLatency_u32; /* Longest time from the event to the entry, for interrupts where the event time is known */
+} irq_s_Stats_t;
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Timing of every measured interrupt
+ *
+ * @values indexed by irq_Id_e
+ */
+extern irq_s_Stats_t irq_g_Stats_s[IRQ_ID_COUNT];
+
+/**
+ * @brief Cycle counter at the entry of the running instance of every interrupt
+ *
+ */
+extern uint32_t irq_g_EntryCycles_u32[IRQ_ID_COUNT];
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void irq_f_Init_v(void);
+extern void irq_f_ResetStats_v(void);
+
+/**
+ * @brief Mark the entry of a measured interrupt, first thing in its handler
+ *
+ * @param id - which interrupt
+ *
+ * @return void
+ */
+static inline void irq_f_Enter_v(irq_Id_e id)
+{
+  irq_g_EntryCycles_u32[id] = DWT->CYCCNT;
+
+  if (id == IRQ_PROBE_ID)
+  {
+    IRQ_PROBE_PORT->BSRR = IRQ_PROBE_PIN;
+  }
+}
+
+/**
+ * @brief Mark the exit of a measured interrupt, last thing in its handler
+ *
+ * @param id - which interrupt
+ *
+ * @return void
+ */
+static inline void irq_f_Exit_v(irq_Id_e id)
+{
+  uint32_t l_cycles_u32 = DWT->CYCCNT - irq_g_EntryCycles_u32[id];
+
+  irq_g_Stats_s[id].count_u32++;
+  irq_g_Stats_s[id].lastCycles_u32 = l_cycles_u32;
+  if (l_cycles_u32 > irq_g_Stats_s[id].maxCycles_u32)
+  {
+    irq_g_Stats_s[id].maxCycles_u32 = l_cycles_u32;
+  }
+
+  if (id == IRQ_PROBE_ID)
+  {
+    IRQ_PROBE_PORT->BRR = IRQ_PROBE_PIN;
+  }
+}
+
+/**
+ * @brief Record the entry latency of an interrupt whose handler knows when its event happened
+ *
+ * @param id - which interrupt
+ * @param cycles - CPU cycles from the event to the entry
+ *
+ * @return void
+ */
+static inline void irq_f_Latency_v(irq_Id_e id, uint32_t cycles)
+{
+  if (cycles > irq_g_Stats_s[id].maxLatency_u32)
+  {
+    irq_g_Stats_s[id].maxLatency_u32 = cycles;
+  }
+}
+
+#endif // IRQ_E_H
@@ -0,0 +1,72 @@
+/**
+ * @file irq_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding irq.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef IRQ_I_H
+#define IRQ_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "irq_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Split of the 4 priority bits: 2 bits preemption (0..3), 2 bits sub-priority (0..3)
+ *
+ * Only the preemption priority decides whether an interrupt can interrupt another one,
+ * the sub-priority only orders interrupts pending at the same time
+ */
+#define IRQ_PRIORITY_GROUP NVIC_PRIORITYGROUP_2
+
+/**
+ * @brief Priority of a single interrupt
+ *
+ */
+typedef struct
+{
+  IRQn_Type irq_e;      /* Interrupt number */
+  uint8_t preempt_u8;   /* 0 (highest)..3 */
+  uint8_t sub_u8;       /* 0 (highest)..3 */
+} irq_s_PriorityConfig_t;
+
+/**
+ * @brief The priority of every interrupt the hand enables, in one place
+ *
+ * 1 - control loop: the SysTick paces the main loop and is the HAL time base, so the HAL timeouts
+ *     in all lower levels keep working; the ADC scan DMA sits next to it
+ * 2 - communication: telemetry UART, it has a hardware buffer and can wait
+ * 3 - background: the clock system
+ *
+ * Level 0 is free. The motor bridge faults (MOTOR_0x_FAULT, HAPTIC_FAULT) are plain inputs that mot_f_Handle_v()
+ * polls every main cycle, the DRV8833 switches its outputs off by itself on a fault. The ADC scan DMA is enabled
+ * in the NVIC by CubeMX, but ana_f_Init_v() keeps its interrupts off, so it never runs. I2C and USB run without
+ * interrupts. CubeMX has the same values, so the generated code starts out with the same priorities
+ */
+irq_s_PriorityConfig_t irq_s_PriorityConfig_s[] = {
+    /* interrupt             preempt  sub */
+    {SysTick_IRQn,             1,     0},
+    {DMA1_Channel1_IRQn,       1,     1}, /* ADC1 scans, kept disabled by ana_f_Init_v() */
+    {UART4_IRQn,               2,     0},
+    {RCC_IRQn,                 3,     0}
+};
+
+#define IRQ_PRIORITY_COUNT (sizeof(irq_s_PriorityConfig_s) / sizeof(irq_s_PriorityConfig_s[0]))
+
+#endif // IRQ_I_H
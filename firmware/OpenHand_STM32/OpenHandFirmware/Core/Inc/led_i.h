@@ -0,0 +1,143 @@
+/**
+ * @file led_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding led.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef LED_I_H
+#define LED_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "led_e.h"
+#include "hwa_e.h"
+#include "irq_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Half period of the slow and the fast blink
+ *
+ * @values in milliseconds
+ */
+#define LED_BLINK_SLOW_MS 500
+#define LED_BLINK_FAST_MS 100
+
+/**
+ * @brief Blink code timing: each flash, the gap between flashes and the pause after the last one
+ *
+ * @values in milliseconds
+ */
+#define LED_CODE_ON_MS 150
+#define LED_CODE_OFF_MS 300
+#define LED_CODE_PAUSE_MS 1500
+
+/**
+ * @brief Breathing: the brightness is updated every LED_RAMP_MS, LED_BREATHE_STEPS times to fade in
+ * and as many to fade out
+ *
+ * @values LED_RAMP_MS * LED_BREATHE_STEPS is one fade, in milliseconds
+ */
+#define LED_RAMP_MS 20
+#define LED_BREATHE_STEPS 60
+
+/**
+ * @brief How long a steady pattern waits before it is looked at again, it only changes on a new request
+ *
+ */
+#define LED_HOLD_MS UINT16_MAX
+
+/**
+ * @brief Full brightness
+ *
+ */
+#define LED_LEVEL_MAX 1000
+
+/**
+ * @brief PWM frequency of the dimmable LEDs, well above what the eye can see
+ *
+ * @values in Hz, timer clock / LED_PWM_FREQ_HZ has to be a whole number of LED_LEVEL_MAX steps
+ */
+#define LED_PWM_FREQ_HZ 1000
+
+/**
+ * @brief Hardware of an LED
+ *
+ */
+typedef struct
+{
+  GPIO_TypeDef *port_ps;     /* Pin of the LED */
+  uint16_t pin_u16;
+  TIM_HandleTypeDef *tim_ps; /* PWM timer driving the pin of a dimmable LED, NULL for an on/off LED */
+  uint32_t channel_u32;
+} led_s_LedConfig_t;
+
+/**
+ * @brief What an LED is playing right now, only used from SysTick
+ *
+ */
+typedef struct
+{
+  uint16_t request_u16; /* Request being played, as in led_g_Request_u16 */
+  uint16_t step_u16;    /* Step of the pattern */
+  uint16_t waitMs_u16;  /* Time left until the next step */
+  uint16_t level_u16;   /* Brightness set right now, 0..LED_LEVEL_MAX */
+  uint8_t enabled_u8;   /* 0 if the pin belongs to someone else (interrupt probe) */
+} led_s_LedState_t;
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+extern TIM_HandleTypeDef htim4;
+
+/**
+ * @brief Configures the hardware of every LED, indexed by led_Id_e
+ *
+ */
+led_s_LedConfig_t led_s_LedConfig_s[LED_ID_COUNT] = {
+    /* port              pin          timer   channel      */
+    {LED_01_GPIO_Port, LED_01_Pin, NULL,   0            }, /* LED_01 */
+    {LED_02_GPIO_Port, LED_02_Pin, &htim4, TIM_CHANNEL_1}  /* LED_02 */
+};
+
+/**
+ * @brief What every LED is playing right now
+ *
+ */
+extern led_s_LedState_t led_g_State_s[LED_ID_COUNT];
+
+/**
+ * @brief Compare register of every dimmable LED, NULL for an on/off LED
+ *
+ */
+extern volatile uint32_t *led_g_Compare_pu32[LED_ID_COUNT];
+
+/**
+ * @brief Whether SysTick may drive the LEDs, set once they are set up
+ *
+ */
+extern volatile uint8_t led_g_Ready_u8;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern uint16_t led_f_NextStep_u16(led_s_LedState_t *state);
+extern void led_f_SetLevel_v(led_Id_e led, uint16_t level);
+
+#endif // LED_I_H
@@ -0,0 +1,97 @@
+/**
+ * @file mem_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding mem.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef MEM_E_H
+#define MEM_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "main.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Memory pools, each hands out blocks of one fixed size
+ *
+ */
+typedef enum
+{
+  MEM_POOL_FRAME = 0, /* Communication frames, received or waiting to be sent */
+  MEM_POOL_COUNT
+} mem_Pool_e;
+
+/**
+ * @brief Size of one block and number of blocks of each pool
+ *
+ * @values block size: multiple of 4, at least 4 (bytes); block count: 1..UINT16_MAX
+ */
+#define MEM_FRAME_SIZE 64
+#define MEM_FRAME_COUNT 8
+
+/**************************************************************************
+ * Structures
+ **************************************************************************/
+
+/**
+ * @brief Usage statistics of a pool
+ *
+ */
+typedef struct
+{
+  uint16_t used_u16;      /* Blocks currently handed out */
+  uint16_t highWater_u16; /* Most blocks ever handed out at the same time */
+  uint32_t failCnt_u32;   /* Allocations refused because the pool was empty */
+  uint32_t badFreeCnt_u32; /* Frees of a pointer that is not a block of this pool, or of a block that is already free */
+} mem_s_PoolStats_t;
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Usage statistics of every pool
+ *
+ * @values indexed by mem_Pool_e
+ */
+extern mem_s_PoolStats_t mem_g_Stats_s[MEM_POOL_COUNT];
+
+/**
+ * @brief Whether the C library heap is closed, from then on every malloc fails
+ *
+ * @values 0 - open, 1 - closed
+ */
+extern uint8_t mem_g_HeapLocked_u8;
+
+/**
+ * @brief How many heap requests were refused after the heap was closed
+ *
+ */
+extern uint32_t mem_g_HeapRejectCnt_u32;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void mem_f_Init_v(void);
+extern void mem_f_LockHeap_v(void);
+extern void *mem_f_Alloc_pv(mem_Pool_e pool);
+extern void mem_f_Free_v(mem_Pool_e pool, void *block);
+
+#endif // MEM_E_H
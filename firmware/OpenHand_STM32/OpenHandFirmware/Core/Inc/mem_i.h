@@ -0,0 +1,79 @@
+/**
+ * @file mem_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding mem.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef MEM_I_H
+#define MEM_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "mem_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Configuration parameters of a pool
+ *
+ */
+typedef struct
+{
+  uint32_t *storage_pu32; /* Memory of all blocks, word aligned */
+  uint32_t *inUse_pu32;   /* One bit per block, set while it is handed out */
+  uint16_t blockSize_u16; /* Bytes per block */
+  uint16_t blockCount_u16;
+} mem_s_PoolConfig_t;
+
+/**
+ * @brief Number of words of the in-use bits of a pool with blockCount blocks
+ *
+ */
+#define MEM_IN_USE_WORDS(blockCount) (((blockCount) + 31) / 32)
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Memory of every pool, reserved at link time
+ *
+ */
+extern uint32_t mem_g_FrameStorage_u32[(MEM_FRAME_SIZE / 4) * MEM_FRAME_COUNT];
+
+/**
+ * @brief Which blocks of every pool are handed out, so freeing one twice is caught
+ *
+ */
+extern uint32_t mem_g_FrameInUse_u32[MEM_IN_USE_WORDS(MEM_FRAME_COUNT)];
+
+/**
+ * @brief Configures all pools, indexed by mem_Pool_e
+ *
+ */
+mem_s_PoolConfig_t mem_s_PoolConfig_s[MEM_POOL_COUNT] = {
+    /* storage               in use                block size      block count */
+    {mem_g_FrameStorage_u32, mem_g_FrameInUse_u32, MEM_FRAME_SIZE, MEM_FRAME_COUNT} /* frames */
+};
+
+/**
+ * @brief First free block of every pool, each free block holds the address of the next one
+ *
+ */
+extern void *mem_g_FreeHead_pv[MEM_POOL_COUNT];
+
+#endif // MEM_I_H
@@ -0,0 +1,109 @@
+/**
+ * @file mot_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding mot.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef MOT_E_H
+#define MOT_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "main.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Number of finger motors (one DRV8833 bridge each)
+ *
+ */
+#define MOT_COUNT 3
+
+/**
+ * @brief Full scale of the signed duty cycle
+ *
+ * Positive duty closes the finger, negative opens it
+ *
+ * @values -MOT_DUTY_MAX..MOT_DUTY_MAX (permille)
+ */
+#define MOT_DUTY_MAX 1000
+
+/**************************************************************************
+ * Structures
+ **************************************************************************/
+
+/**
+ * @brief Configuration parameters of a motor bridge
+ *
+ * The PWM pin drives IN1 and the DIR pin drives IN2 of the DRV8833.
+ * With DIR low, the bridge drives forward while PWM is high and coasts while it is low.
+ * With DIR high, it brakes while PWM is high and drives in reverse while it is low,
+ * so in reverse the compare value has to be inverted.
+ *
+ * TIM1 and TIM3 count up and down (center-aligned) with the same period, TIM3 is started by TIM1
+ * so the two stay in phase, and every output switches at the same distance from the counter turning points.
+ */
+typedef struct
+{
+  TIM_HandleTypeDef *tim_ps;   /* Timer generating the PWM */
+  uint32_t channel_u32;        /* Timer channel, TIM_CHANNEL_x */
+  GPIO_TypeDef *dirPort_ps;    /* IN2 of the bridge */
+  uint16_t dirPin_u16;
+  GPIO_TypeDef *enPort_ps;     /* nSLEEP of the bridge */
+  uint16_t enPin_u16;
+  GPIO_TypeDef *faultPort_ps;  /* nFAULT of the bridge, active low */
+  uint16_t faultPin_u16;
+} mot_s_MotorConfig_t;
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Last duty cycle requested for each motor
+ *
+ * @values -MOT_DUTY_MAX..MOT_DUTY_MAX
+ */
+extern int16_t mot_g_Duty_s16[MOT_COUNT];
+
+/**
+ * @brief Whether the DRV8833 of the motor reports a fault (over-current, over-temperature)
+ *
+ * @values 0 - ok, 1 - fault
+ */
+extern uint8_t mot_g_Fault_u8[MOT_COUNT];
+
+/**
+ * @brief Configures all connected motors, defined in mot_i.h
+ *
+ */
+extern mot_s_MotorConfig_t mot_s_MotorConfig_s[MOT_COUNT];
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void mot_f_Init_v(void);
+extern void mot_f_Handle_v(void);
+extern void mot_f_SetDuty_v(uint8_t motorIndex, int16_t duty);
+extern void mot_f_StopAll_v(void);
+extern void mot_f_UpdateTiming_v(void);
+extern void mot_f_PauseTimers_v(void);
+extern void mot_f_ReloadTimers_v(void);
+extern void mot_f_ResumeTimers_v(void);
+
+#endif // MOT_E_H
@@ -0,0 +1,72 @@
+/**
+ * @file mot_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding mot.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef MOT_I_H
+#define MOT_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "mot_e.h"
+#include "ana_e.h"
+#include "hwa_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Frequency of the motor PWM
+ *
+ * The timer periods are computed from it for whatever clock the timers currently run on (see mot_f_UpdateTiming_v())
+ *
+ * @values 1000..36000 (Hz), above the audible range is quieter, lower loses less in the bridges
+ */
+#define MOT_PWM_FREQ_HZ 20000
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Timer handles, configured in main.c
+ *
+ */
+extern TIM_HandleTypeDef htim1;
+extern TIM_HandleTypeDef htim3;
+
+/**
+ * @brief Configures all connected motors, the code does all the rest
+ *
+ * MOTOR_01 uses PC9 as its direction pin, CubeMX has it labelled MOTOR_02_DIRC9.
+ * Shared through mot_e.h, the benchmark in hwa.c works on the same pins and channels
+ */
+mot_s_MotorConfig_t mot_s_MotorConfig_s[MOT_COUNT] = {
+    /* timer   channel         dir                                          enable                                       fault */
+    {&htim3, TIM_CHANNEL_3, MOTOR_02_DIRC9_GPIO_Port, MOTOR_02_DIRC9_Pin, MOTOR_01_EN_GPIO_Port, MOTOR_01_EN_Pin, MOTOR_01_FAULT_GPIO_Port, MOTOR_01_FAULT_Pin}, /* motor 1 */
+    {&htim1, TIM_CHANNEL_1, MOTOR_02_DIR_GPIO_Port,   MOTOR_02_DIR_Pin,   MOTOR_02_EN_GPIO_Port, MOTOR_02_EN_Pin, MOTOR_02_FAULT_GPIO_Port, MOTOR_02_FAULT_Pin}, /* motor 2 */
+    {&htim1, TIM_CHANNEL_3, MOTOR_03_DIR_GPIO_Port,   MOTOR_03_DIR_Pin,   MOTOR_03_EN_GPIO_Port, MOTOR_03_EN_Pin, MOTOR_03_FAULT_GPIO_Port, MOTOR_03_FAULT_Pin}  /* motor 3 */
+};
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void mot_f_UpdateQuietPhase_v(void);
+extern uint32_t mot_f_TimerClock_u32(TIM_HandleTypeDef *tim);
+
+#endif // MOT_I_H
@@ -0,0 +1,188 @@
+/**
+ * @file msg_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding msg.c
+ *
+ * Generated from firmware/msg/messages.py by firmware/msg/msggen.py, do not edit.
+ * Packers write the current layout, unpackers take every layout since version 1 (newer fields
+ * missing from an older payload are 0, anything after the known fields is ignored)
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef MSG_E_H
+#define MSG_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "stdint.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Version of messages.py this was generated from
+ *
+ */
+#define MSG_SCHEMA_VERSION 8
+
+/**
+ * @brief Frame IDs, payload lengths (_MIN_LEN of the oldest layout, _LEN of the current one with all group
+ * entries) and group sizes
+ *
+ */
+#define MSG_ID_UPD_BEGIN 0x10
+#define MSG_UPD_BEGIN_MIN_LEN 8
+#define MSG_UPD_BEGIN_LEN 8
+#define MSG_ID_UPD_DATA 0x11
+#define MSG_UPD_DATA_MIN_LEN 4
+#define MSG_UPD_DATA_LEN 4
+#define MSG_ID_UPD_COMMIT 0x12
+#define MSG_UPD_COMMIT_MIN_LEN 0
+#define MSG_UPD_COMMIT_LEN 0
+#define MSG_ID_UPD_STATUS 0x13
+#define MSG_UPD_STATUS_MIN_LEN 0
+#define MSG_UPD_STATUS_LEN 0
+#define MSG_ID_TSY_REQ 0x14
+#define MSG_TSY_REQ_MIN_LEN 1
+#define MSG_TSY_REQ_LEN 1
+#define MSG_ID_IRQ_STATS 0x84
+#define MSG_IRQ_STATS_MIN_LEN 4
+#define MSG_IRQ_STATS_LEN 52
+#define MSG_IRQ_STATS_IRQS_MAX 4
+#define MSG_IRQ_STATS_IRQ_LEN 12
+#define MSG_ID_UPD_REPLY 0x90
+#define MSG_UPD_REPLY_MIN_LEN 7
+#define MSG_UPD_REPLY_LEN 12
+#define MSG_ID_TSY_RESP 0x94
+#define MSG_TSY_RESP_MIN_LEN 17
+#define MSG_TSY_RESP_LEN 17
+#define MSG_ID_TSY_STATS 0x95
+#define MSG_TSY_STATS_MIN_LEN 36
+#define MSG_TSY_STATS_LEN 36
+
+/**************************************************************************
+ * Structures
+ **************************************************************************/
+
+/**
+ * @brief UPD_BEGIN (host -> device): Start or resume a firmware update
+ *
+ */
+typedef struct
+{
+  uint32_t size_u32; /* Size of the new image in bytes */
+  uint32_t crc_u32;  /* CRC-32 of the new image */
+} msg_s_UpdBegin_t;
+
+/**
+ * @brief UPD_DATA (host -> device): Next chunk of the new firmware
+ *
+ */
+typedef struct
+{
+  uint32_t offset_u32;     /* Offset of the chunk in the image */
+  const uint8_t *data_pu8; /* The chunk, an even number of bytes */
+  uint8_t dataLen_u8;      /* Length of data */
+} msg_s_UpdData_t;
+
+/**
+ * @brief TSY_REQ (either way): Time sync request, answered with TSY_RESP
+ *
+ */
+typedef struct
+{
+  uint8_t tag_u8; /* Tells the reply apart from a late reply to an earlier request */
+} msg_s_TsyReq_t;
+
+/**
+ * @brief One entry of IRQ_STATS
+ *
+ */
+typedef struct
+{
+  uint32_t count_u32;      /* Number of times the interrupt ran */
+  uint32_t maxCycles_u32;  /* Worst execution time */
+  uint32_t maxLatency_u32; /* Worst entry latency, 0 where it is not measured */
+} msg_s_IrqStatsIrq_t;
+
+/**
+ * @brief IRQ_STATS (device -> host): Interrupt timing, one entry per irq_Id_e
+ *
+ */
+typedef struct
+{
+  uint32_t cpuHz_u32;                                 /* CPU clock, to convert the cycles */
+  uint8_t irqsCount_u8;                               /* Entries in irqs_s */
+  msg_s_IrqStatsIrq_t irqs_s[MSG_IRQ_STATS_IRQS_MAX]; /* Entries */
+} msg_s_IrqStats_t;
+
+/**
+ * @brief UPD_REPLY (device -> host): Reply to every firmware update frame
+ *
+ */
+typedef struct
+{
+  uint8_t reqId_u8;  /* ID of the frame replied to */
+  uint8_t status_u8; /* upd_Status_e */
+  uint8_t state_u8;  /* upd_State_e */
+  uint32_t next_u32; /* Offset of the next chunk expected */
+  uint8_t image_u8;  /* upd_Image_e, where the last committed image stands with the boot stage (since version 8) */
+  uint32_t crc_u32;  /* CRC-32 of the last committed image, 0 without one (since version 8) */
+} msg_s_UpdReply_t;
+
+/**
+ * @brief TSY_RESP (either way): Time sync reply, dated by the last byte of both frames
+ *
+ */
+typedef struct
+{
+  uint8_t tag_u8;    /* Tag of the request */
+  uint64_t rxUs_u64; /* When the last byte of the request arrived */
+  uint64_t txUs_u64; /* When the last byte of this reply leaves */
+} msg_s_TsyResp_t;
+
+/**
+ * @brief TSY_STATS (STM32 -> ESP32): Clock model of the STM32 against the ESP32 clock
+ *
+ */
+typedef struct
+{
+  uint64_t refUs_u64;   /* STM32 time of the exchange the model is based on */
+  int64_t offsetUs_s64; /* ESP32 time minus STM32 time at refUs */
+  int32_t driftPpb_s32; /* How much faster the ESP32 clock runs, parts per billion */
+  uint32_t rttUs_u32;   /* Round trip of that exchange */
+  uint32_t errorUs_u32; /* Error bound of the model */
+  uint32_t samples_u32; /* Windows that had a usable exchange */
+  uint32_t lost_u32;    /* Requests without a usable reply */
+} msg_s_TsyStats_t;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern uint8_t msg_f_PackUpdBegin_u8(uint8_t *buf, const msg_s_UpdBegin_t *msg);
+extern uint8_t msg_f_UnpackUpdBegin_u8(msg_s_UpdBegin_t *msg, const uint8_t *buf, uint8_t len);
+extern uint8_t msg_f_PackUpdData_u8(uint8_t *buf, const msg_s_UpdData_t *msg);
+extern uint8_t msg_f_UnpackUpdData_u8(msg_s_UpdData_t *msg, const uint8_t *buf, uint8_t len);
+extern uint8_t msg_f_PackTsyReq_u8(uint8_t *buf, const msg_s_TsyReq_t *msg);
+extern uint8_t msg_f_UnpackTsyReq_u8(msg_s_TsyReq_t *msg, const uint8_t *buf, uint8_t len);
+extern uint8_t msg_f_PackIrqStats_u8(uint8_t *buf, const msg_s_IrqStats_t *msg);
+extern uint8_t msg_f_UnpackIrqStats_u8(msg_s_IrqStats_t *msg, const uint8_t *buf, uint8_t len);
+extern uint8_t msg_f_PackUpdReply_u8(uint8_t *buf, const msg_s_UpdReply_t *msg);
+extern uint8_t msg_f_UnpackUpdReply_u8(msg_s_UpdReply_t *msg, const uint8_t *buf, uint8_t len);
+extern uint8_t msg_f_PackTsyResp_u8(uint8_t *buf, const msg_s_TsyResp_t *msg);
+extern uint8_t msg_f_UnpackTsyResp_u8(msg_s_TsyResp_t *msg, const uint8_t *buf, uint8_t len);
+extern uint8_t msg_f_PackTsyStats_u8(uint8_t *buf, const msg_s_TsyStats_t *msg);
+extern uint8_t msg_f_UnpackTsyStats_u8(msg_s_TsyStats_t *msg, const uint8_t *buf, uint8_t len);
+
+#endif // MSG_E_H
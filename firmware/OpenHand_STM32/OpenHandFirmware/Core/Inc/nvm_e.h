@@ -0,0 +1,47 @@
+/**
+ * @file nvm_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding nvm.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef NVM_E_H
+#define NVM_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "main.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Records kept in flash, each one has its own flash page (see nvm_s_RecordConfig_s)
+ *
+ */
+typedef enum
+{
+  NVM_REC_HALL_CAL = 0, /* Hall sensor calibration, see pos_s_CalData_t */
+  NVM_REC_COUNT
+} nvm_Record_e;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern uint8_t nvm_f_Load_u8(nvm_Record_e record, void *data, uint16_t len);
+extern uint8_t nvm_f_Store_u8(nvm_Record_e record, const void *data, uint16_t len);
+
+#endif // NVM_E_H
@@ -0,0 +1,80 @@
+/**
+ * @file nvm_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding nvm.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef NVM_I_H
+#define NVM_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "nvm_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Marks a programmed record, an erased page reads 0xFFFFFFFF
+ *
+ */
+#define NVM_MAGIC 0x4E56484FUL /* "OHVN" */
+
+/**
+ * @brief Header written in front of the data of every record
+ *
+ * The CRC covers the data only, the rest of the header is checked field by field
+ */
+typedef struct
+{
+  uint32_t magic_u32;
+  uint16_t version_u16;
+  uint16_t len_u16;
+  uint32_t crc_u32;
+} nvm_s_Header_t;
+
+/**
+ * @brief Where a record lives and which version of its layout is current
+ *
+ * Bump the version whenever the structure stored in the record changes,
+ * so an old record is ignored instead of being read with the new layout
+ */
+typedef struct
+{
+  uint32_t address_u32; /* Start of the flash page, inside the NVM region of the linker script */
+  uint16_t version_u16;
+} nvm_s_RecordConfig_t;
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief All records, one flash page (FLASH_PAGE_SIZE) each
+ *
+ */
+nvm_s_RecordConfig_t nvm_s_RecordConfig_s[NVM_REC_COUNT] = {
+    /* address     version */
+    {0x0807F800UL, 1} /* NVM_REC_HALL_CAL */
+};
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern uint32_t nvm_f_Crc32_u32(const uint8_t *data, uint16_t len);
+
+#endif // NVM_I_H
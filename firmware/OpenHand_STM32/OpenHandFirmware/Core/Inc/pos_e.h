@@ -0,0 +1,131 @@
+/**
+ * @file pos_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding pos.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef POS_E_H
+#define POS_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "main.h"
+#include "mot_e.h"
+#include "ana_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Number of fingers with a hall sensor, one per motor
+ *
+ */
+#define POS_FINGER_COUNT MOT_COUNT
+
+/**
+ * @brief Finger position at the closed end stop, the open end stop is 0
+ *
+ * @values 0..POS_FULL_SCALE (0.01% of the travel)
+ */
+#define POS_FULL_SCALE 10000
+
+/**
+ * @brief Number of points in the position LUT of each finger
+ *
+ * The points are evenly spaced over the raw hall range, so the lookup needs no search
+ *
+ * @values 2^n + 1
+ */
+#define POS_LUT_SIZE 33
+
+/**************************************************************************
+ * Structures
+ **************************************************************************/
+
+/**
+ * @brief Linearisation of one finger: raw hall value -> position
+ *
+ */
+typedef struct
+{
+  uint16_t rawMin_u16;         /* Lowest raw value seen between the end stops */
+  uint16_t rawMax_u16;         /* Highest raw value seen between the end stops */
+  uint32_t indexScaleQ16_u32;  /* ((POS_LUT_SIZE - 1) << 16) / (rawMax - rawMin) */
+  uint16_t lut_u16[POS_LUT_SIZE]; /* Position at rawMin + k * (rawMax - rawMin) / (POS_LUT_SIZE - 1), monotonic */
+} pos_s_FingerLut_t;
+
+/**
+ * @brief Calibration of all fingers, as stored in flash (NVM_REC_HALL_CAL)
+ *
+ */
+typedef struct
+{
+  pos_s_FingerLut_t finger_s[POS_FINGER_COUNT];
+} pos_s_CalData_t;
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Filtered raw hall value of each finger
+ *
+ * @values 0..ANA_MAX_VALUE
+ */
+extern uint16_t pos_g_Raw_u16[POS_FINGER_COUNT];
+
+/**
+ * @brief Which analog input carries the hall sensor of each finger, defined in pos_i.h
+ *
+ */
+extern const ana_Channel_e pos_c_HallChannel_e[POS_FINGER_COUNT];
+
+/**
+ * @brief Linearised position of each finger
+ *
+ * @values 0..POS_FULL_SCALE, 0 is open
+ */
+extern uint16_t pos_g_Position_u16[POS_FINGER_COUNT];
+
+/**
+ * @brief Whether a valid calibration is in use
+ *
+ * Without it the position is just the raw value scaled to POS_FULL_SCALE
+ *
+ * @values 0 - not calibrated, 1 - calibrated
+ */
+extern uint8_t pos_g_Calibrated_u8;
+
+/**
+ * @brief Hall offset found by homing, subtracted from the raw value before the lookup
+ *
+ * Hall sensors drift with temperature, so the raw value at the open end stop moves a bit between boots
+ *
+ * @values in raw ADC counts
+ */
+extern int16_t pos_g_RawOffset_s16[POS_FINGER_COUNT];
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void pos_f_Init_v(void);
+extern void pos_f_Handle_v(void);
+extern uint16_t pos_f_RawToPosition_u16(uint8_t fingerIndex, uint16_t raw);
+extern uint8_t pos_f_SetCalibration_u8(const pos_s_CalData_t *calData);
+extern int16_t pos_f_SetOpenReference_s16(uint8_t fingerIndex, uint16_t raw);
+
+#endif // POS_E_H
@@ -0,0 +1,70 @@
+/**
+ * @file pos_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding pos.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef POS_I_H
+#define POS_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "pos_e.h"
+#include "hwa_e.h"
+#include "ana_e.h"
+#include "nvm_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Strength of the low-pass filter on the raw hall values
+ *
+ * Each new value moves the filtered one by 1/2^x of the difference
+ *
+ * The hall sensors are sampled away from the motor switching edges (see ana.c), so little filtering is needed
+ *
+ * @values 0 (off)..4, higher is smoother but lags more
+ */
+#define POS_FILTER_SHIFT 1
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Which analog input carries the hall sensor of each finger
+ *
+ */
+const ana_Channel_e pos_c_HallChannel_e[POS_FINGER_COUNT] = {
+    ANA_CH_HALL_01, /* finger 1 */
+    ANA_CH_HALL_02, /* finger 2 */
+    ANA_CH_HALL_03  /* finger 3 */
+};
+
+/**
+ * @brief Calibration in use, loaded from flash or set by the calibration routine
+ *
+ */
+extern pos_s_CalData_t pos_g_CalData_s;
+
+/**
+ * @brief Filter state, raw value << POS_FILTER_SHIFT
+ *
+ */
+extern uint32_t pos_g_FilterAcc_u32[POS_FINGER_COUNT];
+
+#endif // POS_I_H
@@ -0,0 +1,117 @@
+/**
+ * @file tlm_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding tlm.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef TLM_E_H
+#define TLM_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "main.h"
+#include "mem_e.h"
+#include "msg_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Frame layout: sync1, sync2, id, seq, len, payload[len], crc16 (LSB first)
+ *
+ * Same as on the ESP32, so the same host tools can read both boards
+ */
+#define TLM_HEADER_LEN 5
+#define TLM_CRC_LEN 2
+
+/**
+ * @brief Largest payload a single frame can carry, a whole frame has to fit into one frame pool block
+ *
+ */
+#define TLM_MAX_PAYLOAD (MEM_FRAME_SIZE - TLM_HEADER_LEN - TLM_CRC_LEN)
+
+/**
+ * @brief Largest payload a frame from the host can carry, received frames are not kept in pool blocks
+ *
+ * @values 1..255
+ */
+#define TLM_RX_MAX_PAYLOAD 160
+
+/**
+ * @brief IDs of the frames sent over the telemetry link
+ *
+ * Frames from the device have the MSB set. The IDs and payloads of both boards are defined in
+ * firmware/msg/messages.py, see msg_e.h
+ */
+typedef enum
+{
+  TLM_ID_UPD_BEGIN = MSG_ID_UPD_BEGIN,   /* host -> device: start or resume a firmware update, see upd.c */
+  TLM_ID_UPD_DATA = MSG_ID_UPD_DATA,     /* host -> device: next chunk of the new firmware */
+  TLM_ID_UPD_COMMIT = MSG_ID_UPD_COMMIT, /* host -> device: check the whole new firmware and install it */
+  TLM_ID_UPD_STATUS = MSG_ID_UPD_STATUS, /* host -> device: ask where the update stands */
+  TLM_ID_TSY_REQ = MSG_ID_TSY_REQ,       /* either way: time sync request, answered with TSY_RESP, see tsy.c */
+  TLM_ID_IRQ_STATS = MSG_ID_IRQ_STATS,   /* device -> host: interrupt timing, see tlm_f_SendIrqStats_v() */
+  TLM_ID_UPD_REPLY = MSG_ID_UPD_REPLY,   /* device -> host: reply to every firmware update frame */
+  TLM_ID_TSY_RESP = MSG_ID_TSY_RESP,     /* either way: time sync reply, request tag + receive and send timestamps */
+  TLM_ID_TSY_STATS = MSG_ID_TSY_STATS    /* device -> peer: clock model against the peer clock, see tsy_f_SendStats_v() */
+} tlm_MsgId_e;
+
+/**************************************************************************
+ * Structures
+ **************************************************************************/
+
+/**
+ * @brief Statistics of the telemetry link
+ *
+ */
+typedef struct
+{
+  uint32_t txFrames_u32;  /* Frames handed to the UART */
+  uint32_t txDropped_u32; /* Frames dropped because no block or queue slot was free */
+  uint32_t rxFrames_u32;  /* Valid frames received */
+  uint32_t rxErrors_u32;  /* Frames received with a bad CRC or length */
+  uint32_t rxDropped_u32; /* Bytes lost to a full receive buffer or a UART overrun */
+} tlm_s_LinkStats_t;
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Statistics of the telemetry link
+ *
+ */
+extern tlm_s_LinkStats_t tlm_g_LinkStats_s;
+
+/**
+ * @brief When the last byte of the frame being handled arrived, in tsy_f_LocalUs_u64() time
+ *
+ * @values 0 if it is not known, because more bytes arrived before the frame was parsed
+ */
+extern uint64_t tlm_g_RxFrameUs_u64;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void tlm_f_Init_v(void);
+extern void tlm_f_Handle_v(void);
+extern uint8_t tlm_f_SendFrame_u8(tlm_MsgId_e id, const uint8_t *payload, uint8_t len);
+extern void tlm_f_EnableRx_v(void);
+extern void tlm_f_RxIsr_v(void);
+extern uint8_t tlm_f_IsTxIdle_u8(void);
+
+#endif // TLM_E_H
@@ -0,0 +1,145 @@
+/**
+ * @file tlm_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding tlm.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef TLM_I_H
+#define TLM_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "tlm_e.h"
+#include "irq_e.h"
+#include "upd_e.h"
+#include "tsy_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Two sync bytes that start every frame
+ *
+ */
+#define TLM_SYNC_1 0xA5
+#define TLM_SYNC_2 0x5A
+
+/**
+ * @brief Size of the ring the UART interrupt puts received bytes into
+ *
+ * Has to hold what arrives between two runs of tlm_f_Handle_v(), at 1Mbaud that is 100 bytes per millisecond
+ *
+ * @values power of 2, up to 32768
+ */
+#define TLM_RX_BUF_LEN 512
+
+/**
+ * @brief How many frames can wait for the UART
+ *
+ * @values 1..MEM_FRAME_COUNT
+ */
+#define TLM_TX_QUEUE_LEN 6
+
+/**
+ * @brief How often the interrupt timing is sent
+ *
+ * @values in milliseconds
+ */
+#define TLM_IRQ_PERIOD_MS 1000
+
+/**
+ * @brief States of the receive parser
+ *
+ */
+typedef enum
+{
+  TLM_RX_SYNC_1 = 0,
+  TLM_RX_SYNC_2,
+  TLM_RX_ID,
+  TLM_RX_SEQ,
+  TLM_RX_LEN,
+  TLM_RX_PAYLOAD,
+  TLM_RX_CRC_1,
+  TLM_RX_CRC_2
+} tlm_RxState_e;
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief UART of the telemetry link, configured in main.c
+ *
+ */
+extern UART_HandleTypeDef huart4;
+
+/**
+ * @brief Frames waiting to be sent (ring), and the frame the UART is sending right now
+ *
+ */
+extern uint8_t *tlm_g_TxQueue_pu8[TLM_TX_QUEUE_LEN];
+extern uint8_t tlm_g_TxHead_u8;
+extern uint8_t tlm_g_TxCount_u8;
+extern uint8_t *tlm_g_TxActive_pu8;
+
+/**
+ * @brief Sequence number of the next frame sent, lets the host count lost frames
+ *
+ */
+extern uint8_t tlm_g_TxSeq_u8;
+
+/**
+ * @brief Bytes received by the UART interrupt (ring), the interrupt moves the head and the main loop the tail
+ *
+ */
+extern uint8_t tlm_g_RxBuf_u8[TLM_RX_BUF_LEN];
+extern volatile uint16_t tlm_g_RxHead_u16;
+extern volatile uint16_t tlm_g_RxTail_u16;
+
+/**
+ * @brief When the UART interrupt took the last byte into the ring, in tsy_f_LocalUs_u64() time
+ *
+ */
+extern volatile uint64_t tlm_g_RxLastUs_u64;
+
+/**
+ * @brief Receive parser state and the frame being received
+ *
+ */
+extern tlm_RxState_e tlm_g_RxState_e;
+extern uint8_t tlm_g_RxId_u8;
+extern uint8_t tlm_g_RxSeq_u8;
+extern uint8_t tlm_g_RxLen_u8;
+extern uint8_t tlm_g_RxIdx_u8;
+extern uint16_t tlm_g_RxCrc_u16;
+extern uint8_t tlm_g_RxPayload_u8[TLM_RX_MAX_PAYLOAD];
+
+/**
+ * @brief Time since the interrupt timing was last sent
+ *
+ */
+extern uint16_t tlm_g_IrqMs_u16;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void tlm_f_Receive_v(void);
+extern void tlm_f_HandleFrame_v(uint8_t id, const uint8_t *payload, uint8_t len);
+extern void tlm_f_SendIrqStats_v(void);
+extern uint16_t tlm_f_Crc16_u16(uint16_t crc, const uint8_t *data, uint16_t len);
+
+#endif // TLM_I_H
@@ -0,0 +1,61 @@
+/**
+ * @file trm_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding trm.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef TRM_E_H
+#define TRM_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "main.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Parameters that can be tuned with the trim pots
+ *
+ */
+typedef enum
+{
+  TRM_PARAM_EMG_GAIN = 0,   /* Gain applied to the EMG envelope, in percent */
+  TRM_PARAM_EMG_THRESHOLD,  /* EMG envelope above which the hand reacts, in raw ADC counts */
+  TRM_PARAM_STIFFNESS,      /* Finger position controller stiffness, in permille of its full gain */
+  TRM_PARAM_COUNT
+} trm_Param_e;
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Current value of every parameter, in the unit of the parameter
+ *
+ * @values indexed by trm_Param_e, between the limits in trm_s_ParamConfig_s
+ */
+extern uint16_t trm_g_Param_u16[TRM_PARAM_COUNT];
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void trm_f_Init_v(void);
+extern void trm_f_Handle_v(void);
+extern uint16_t trm_f_Get_u16(trm_Param_e param);
+
+#endif // TRM_E_H
@@ -0,0 +1,101 @@
+/**
+ * @file trm_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding trm.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef TRM_I_H
+#define TRM_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "trm_e.h"
+#include "ana_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief How often the trim pots are read, they are turned by hand so this can be slow
+ *
+ * @values in milliseconds
+ */
+#define TRM_PERIOD_MS 20
+
+/**
+ * @brief Smoothing of the trim pot values, the filter averages the last 2^TRM_FILTER_SHIFT reads
+ *
+ * @values 0 (off)..4
+ */
+#define TRM_FILTER_SHIFT 2
+
+/**
+ * @brief How far a trim pot has to turn before its parameter follows
+ *
+ * Without it, a pot resting between two values would make the parameter flicker.
+ * Within this distance of either end the value snaps to the end, so the full range stays reachable
+ *
+ * @values 0..ANA_MAX_VALUE / 4 (raw ADC counts), 4095 counts over the whole turn
+ */
+#define TRM_HYSTERESIS 24
+
+/**
+ * @brief Mapping of a trim pot to a parameter
+ *
+ */
+typedef struct
+{
+  ana_Channel_e channel_e; /* Trim pot driving the parameter, ANA_CH_COUNT if none (the parameter stays at its default) */
+  uint16_t min_u16;        /* Parameter value with the pot fully counter-clockwise */
+  uint16_t max_u16;        /* Parameter value with the pot fully clockwise, may be below min_u16 to reverse the direction */
+  uint16_t default_u16;    /* Parameter value until the pot is first read, and always if no pot is mapped */
+} trm_s_ParamConfig_t;
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Configures the mapping of every parameter, indexed by trm_Param_e
+ *
+ */
+trm_s_ParamConfig_t trm_s_ParamConfig_s[TRM_PARAM_COUNT] = {
+    /* pot                  min   max   default */
+    {ANA_CH_TRIM_POT_01,   25,  800,   100}, /* EMG gain: 0.25x..8x */
+    {ANA_CH_TRIM_POT_02,   20, 1000,   200}, /* EMG threshold */
+    {ANA_CH_COUNT,        100, 1000,  1000}  /* Stiffness, not on a pot yet */
+};
+
+/**
+ * @brief Filter accumulator and last accepted (after hysteresis) raw value of every parameter's pot
+ *
+ */
+extern uint16_t trm_g_FilterAcc_u16[TRM_PARAM_COUNT];
+extern uint16_t trm_g_Accepted_u16[TRM_PARAM_COUNT];
+
+/**
+ * @brief Time since the pots were last read
+ *
+ */
+extern uint8_t trm_g_Ms_u8;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void trm_f_Update_v(trm_Param_e param);
+
+#endif // TRM_I_H
@@ -0,0 +1,67 @@
+/**
+ * @file tsy_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding tsy.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef TSY_E_H
+#define TSY_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "main.h"
+
+/**************************************************************************
+ * Structures
+ **************************************************************************/
+
+/**
+ * @brief Model of the peer clock against the local clock
+ *
+ * peer = local + offsetUs + driftPpb * (local - refLocalUs) / 10^9
+ */
+typedef struct
+{
+  uint64_t refLocalUs_u64; /* Local time of the exchange the model is based on */
+  int64_t offsetUs_s64;    /* Peer time minus local time at refLocalUs */
+  int32_t driftPpb_s32;    /* How much faster the peer clock runs than the local one, parts per billion */
+  uint32_t rttUs_u32;      /* Round trip of the exchange the model is based on */
+  uint32_t errorUs_u32;    /* Error bound of the model: half the round trip plus how far the last prediction was off */
+  uint32_t samples_u32;    /* Windows that had a usable exchange */
+  uint32_t lost_u32;       /* Requests without a usable reply */
+  uint8_t synced_u8;       /* Whether the model is valid, 0 until the first usable exchange */
+} tsy_s_Model_t;
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Model of the peer clock, see tsy_s_Model_t
+ *
+ */
+extern tsy_s_Model_t tsy_g_Model_s;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void tsy_f_Init_v(void);
+extern void tsy_f_Handle_v(void);
+extern void tsy_f_HandleFrame_v(uint8_t id, const uint8_t *payload, uint8_t len);
+extern uint64_t tsy_f_LocalUs_u64(void);
+extern uint64_t tsy_f_ToPeerUs_u64(uint64_t localUs);
+
+#endif // TSY_E_H
@@ -0,0 +1,145 @@
+/**
+ * @file tsy_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding tsy.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef TSY_I_H
+#define TSY_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "tsy_e.h"
+#include "tlm_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Time between two requests
+ *
+ * @values in milliseconds, more than TSY_TIMEOUT_MS
+ */
+#define TSY_PERIOD_MS 100
+
+/**
+ * @brief How long a reply is waited for, a later one is counted as lost
+ *
+ * @values in milliseconds
+ */
+#define TSY_TIMEOUT_MS 50
+
+/**
+ * @brief Requests per window, only the exchange with the shortest round trip of a window updates the model
+ *
+ * The shortest round trip was the least delayed by both sides being busy, so it also has the smallest error
+ *
+ * @values 1..255
+ */
+#define TSY_WINDOW 10
+
+/**
+ * @brief How much of the drift seen over one window goes into the drift of the model, as 1/TSY_DRIFT_FILTER
+ *
+ * @values 1 (no filtering)..
+ */
+#define TSY_DRIFT_FILTER 4
+
+/**
+ * @brief How far an exchange may be off the prediction of the model before the model starts over
+ *
+ * Only a reset of either side or a lost tick gets the clocks that far apart within one window
+ *
+ * @values in microseconds
+ */
+#define TSY_RESYNC_US 10000
+
+/**
+ * @brief How often the model is sent to the peer
+ *
+ * @values in milliseconds
+ */
+#define TSY_STATS_PERIOD_MS 1000
+
+/**
+ * @brief Length of a request frame and a reply frame on the wire (header, payload, CRC)
+ *
+ */
+#define TSY_REQ_FRAME_LEN (TLM_HEADER_LEN + MSG_TSY_REQ_LEN + TLM_CRC_LEN)
+#define TSY_RESP_FRAME_LEN (TLM_HEADER_LEN + MSG_TSY_RESP_LEN + TLM_CRC_LEN)
+
+/**
+ * @brief One exchange, all times in microseconds and dated by the last byte of the frame
+ *
+ */
+typedef struct
+{
+  uint64_t t4_u64;      /* Local time the reply arrived */
+  int64_t offsetUs_s64; /* Peer time minus local time */
+  uint32_t rttUs_u32;   /* Round trip without the time the peer took to reply */
+} tsy_s_Sample_t;
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief UART of the telemetry link, configured in main.c
+ *
+ */
+extern UART_HandleTypeDef huart4;
+
+/**
+ * @brief Upper 32 bits of the millisecond tick, counted up whenever HAL_GetTick() wraps
+ *
+ */
+extern volatile uint32_t tsy_g_TickHigh_u32;
+extern uint32_t tsy_g_LastTick_u32;
+
+/**
+ * @brief Request waiting for its reply: its tag, when its last byte left, and whether it is still waiting
+ *
+ */
+extern uint8_t tsy_g_Tag_u8;
+extern uint64_t tsy_g_T1_u64;
+extern uint8_t tsy_g_Pending_u8;
+
+/**
+ * @brief Milliseconds since the last request and since the model was last sent
+ *
+ */
+extern uint16_t tsy_g_RequestMs_u16;
+extern uint16_t tsy_g_StatsMs_u16;
+
+/**
+ * @brief Requests sent in the current window, and the best exchange of it (rttUs_u32 is UINT32_MAX while there is none)
+ *
+ */
+extern uint8_t tsy_g_WindowCnt_u8;
+extern tsy_s_Sample_t tsy_g_Best_s;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void tsy_f_SendRequest_v(void);
+extern void tsy_f_SendReply_v(const uint8_t *payload, uint8_t len);
+extern void tsy_f_TakeReply_v(const uint8_t *payload, uint8_t len);
+extern void tsy_f_UpdateModel_v(void);
+extern void tsy_f_SendStats_v(void);
+extern uint32_t tsy_f_FrameUs_u32(uint8_t frameLen);
+
+#endif // TSY_I_H
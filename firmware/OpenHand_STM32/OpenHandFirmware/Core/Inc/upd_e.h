@@ -0,0 +1,75 @@
+/**
+ * @file upd_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding upd.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef UPD_E_H
+#define UPD_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "main.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief States of the firmware update
+ *
+ */
+typedef enum
+{
+  UPD_IDLE = 0,   /* No update running */
+  UPD_ERASING,    /* Erasing the staging area, one page per millisecond */
+  UPD_RECEIVING,  /* Taking the chunks of the new firmware */
+  UPD_VERIFYING,  /* Checking the CRC of the whole staged firmware */
+  UPD_COMMITTED   /* Staged firmware checked and committed, about to reset into the boot stage */
+} upd_State_e;
+
+/**
+ * @brief Where the last committed image stands with the boot stage, sent in every reply
+ *
+ */
+typedef enum
+{
+  UPD_IMAGE_NONE = 0,  /* No committed image, e.g. an update is being received or was never run */
+  UPD_IMAGE_COMMITTED, /* Committed, installed by the boot stage on the next reset */
+  UPD_IMAGE_TRIAL,     /* Installed and running, the boot stage swaps the old one back on a reset until confirmed */
+  UPD_IMAGE_CONFIRMED, /* Installed, running and confirmed, the old one is gone */
+  UPD_IMAGE_REVERTED   /* Not confirmed in time or didn't check out once installed, the old one is running again */
+} upd_Image_e;
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief State of the firmware update
+ *
+ */
+extern upd_State_e upd_g_State_e;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void upd_f_Init_v(void);
+extern void upd_f_Handle_v(void);
+extern void upd_f_HandleFrame_v(uint8_t id, const uint8_t *payload, uint8_t len);
+extern uint8_t upd_f_IsBusy_u8(void);
+
+#endif // UPD_E_H
@@ -0,0 +1,112 @@
+/**
+ * @file upd_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding upd.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef UPD_I_H
+#define UPD_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "upd_e.h"
+#include "boot_e.h"
+#include "tlm_e.h"
+#include "mot_e.h"
+#include "cal_e.h"
+#include "hom_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Most firmware bytes in one data frame, the frame also carries the offset (u32)
+ *
+ * @values even, up to TLM_RX_MAX_PAYLOAD - 4
+ */
+#define UPD_CHUNK_SIZE 128
+
+/**
+ * @brief How many staged bytes the CRC is run over every millisecond while verifying
+ *
+ * About 3ms of CPU time at 72MHz, the whole staging area takes about 60ms
+ *
+ * @values 1..BOOT_IMAGE_SIZE
+ */
+#define UPD_VERIFY_SLICE 4096
+
+/**
+ * @brief Time between committing and the reset, so the reply still makes it out of the UART
+ *
+ * @values in milliseconds
+ */
+#define UPD_RESET_DELAY_MS 50
+
+/**
+ * @brief Status in a reply, tells the host what to do next
+ *
+ */
+typedef enum
+{
+  UPD_STATUS_OK = 0,          /* Done, carry on from the offset in the reply */
+  UPD_STATUS_REFUSED,         /* Fingers are moving, calibrating or homing, try again later */
+  UPD_STATUS_BAD_REQUEST,     /* Frame too short or too long, or the image doesn't fit */
+  UPD_STATUS_BAD_STATE,       /* Frame not expected now, e.g. data before begin, start over with begin */
+  UPD_STATUS_BAD_OFFSET,      /* Chunk not at the offset in the reply, carry on from there */
+  UPD_STATUS_FLASH_ERROR,     /* Erasing or programming failed, start over with begin */
+  UPD_STATUS_BAD_CRC          /* Staged image doesn't match the CRC given in begin, start over with begin */
+} upd_Status_e;
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Next offset into the image the update expects a chunk for
+ *
+ */
+extern uint32_t upd_g_Next_u32;
+
+/**
+ * @brief Next staging page to erase (ERASING), next offset to run the CRC over (VERIFYING),
+ * or milliseconds left until the reset (COMMITTED)
+ *
+ */
+extern uint32_t upd_g_Progress_u32;
+
+/**
+ * @brief CRC of the staged image so far, while verifying
+ *
+ */
+extern uint32_t upd_g_Crc_u32;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void upd_f_Begin_v(const uint8_t *payload, uint8_t len);
+extern void upd_f_Data_v(const uint8_t *payload, uint8_t len);
+extern void upd_f_Commit_v(void);
+extern void upd_f_Confirm_v(void);
+extern upd_Image_e upd_f_Image_e(void);
+extern void upd_f_Reply_v(uint8_t id, upd_Status_e status);
+extern uint32_t upd_f_ResumeOffset_u32(uint32_t size);
+extern uint8_t upd_f_ErasePage_u8(uint32_t address);
+extern uint8_t upd_f_Program_u8(uint32_t address, const uint8_t *data, uint32_t len);
+extern uint8_t upd_f_SetFlag_u8(const volatile uint16_t *flag);
+extern uint32_t upd_f_Crc32_u32(uint32_t crc, uint32_t address, uint32_t len);
+
+#endif // UPD_I_H
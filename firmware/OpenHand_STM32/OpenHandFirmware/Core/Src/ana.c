@@ -0,0 +1,165 @@
+/**
+ * @file ana.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Analog inputs software component / driver
+ *
+ * ADC1 converts all analog inputs (hall sensors, EMG, trim pots, battery) in one scan sequence,
+ * and the DMA copies every scan into a buffer in circular mode.
+ * Other modules just read the latest value from that buffer, without ever waiting for a conversion.
+ *
+ * Scans are started by TIM3 TRGO, at the top and at the bottom of the center-aligned motor PWM cycle,
+ * so the samples are taken as far as possible from the switching edges. The two scans land in their
+ * own half of the buffer, and mot.c picks the quieter one for the current duty cycles.
+ * The hall and EMG channels come first in the sequence, so they are done within about 8us of the trigger.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "ana_e.h"
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Latest conversion of every analog input, written by the DMA in the background
+ *
+ * @values 0..ANA_MAX_VALUE, indexed by ana_Channel_e
+ */
+volatile uint16_t ana_g_Raw_u16[ANA_PHASE_COUNT][ANA_CH_COUNT];
+
+/**
+ * @brief Which of the two scans ana_f_Get_u16() returns, the one furthest from any switching edge
+ *
+ */
+ana_Phase_e ana_g_QuietPhase_e;
+
+/**
+ * @brief ADC handle and its DMA channel, configured in main.c / stm32f1xx_hal_msp.c
+ *
+ */
+extern ADC_HandleTypeDef hadc1;
+extern DMA_HandleTypeDef hdma_adc1;
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+void ana_f_Init_v(void);
+void ana_f_Start_v(void);
+void ana_f_Stop_v(void);
+void ana_f_SetBattSampling_v(uint32_t samplingTime);
+uint16_t ana_f_Get_u16(ana_Channel_e channel);
+void ana_f_SetQuietPhase_v(ana_Phase_e phase);
+
+/**
+ * @brief Initialise function to be called once on boot, after MX_ADC1_Init() and before mot_f_Init_v()
+ *
+ * Calibrate the ADC and arm it for the timer trigger. The timers only start counting in mot_f_Init_v(),
+ * and their first turning point is the top, so the first scan of every pair is ANA_PHASE_PEAK
+ *
+ * @return void
+ */
+void ana_f_Init_v(void)
+{
+  if (HAL_ADCEx_Calibration_Start(&hadc1) != HAL_OK)
+  {
+    Error_Handler();
+  }
+
+  ana_f_Start_v();
+}
+
+/**
+ * @brief Arm the ADC for the timer trigger, with the DMA writing from the start of the buffer
+ *
+ * The timers have to be stopped, with their counters at 0 and their update event already generated, as it is
+ * a trigger too (see mot_f_ReloadTimers_v()): the first scan after they start is the top of the PWM cycle
+ * and lands in ANA_PHASE_PEAK, so both halves of the buffer hold the phase they are named after
+ *
+ * @return void
+ */
+void ana_f_Start_v(void)
+{
+  if (HAL_ADC_Start_DMA(&hadc1, (uint32_t *)ana_g_Raw_u16, ANA_PHASE_COUNT * ANA_CH_COUNT) != HAL_OK)
+  {
+    Error_Handler();
+  }
+
+  /* Nobody needs to know when a scan is done, the buffer is simply read when needed, so don't take an interrupt
+   * twice per scan at priority 1. A transfer error stops the channel in hardware, HAL_DMA_IRQHandler() could only
+   * report it to a callback nobody implements. CubeMX always enables the DMA interrupt line, turn it off too */
+  __HAL_DMA_DISABLE_IT(&hdma_adc1, DMA_IT_HT | DMA_IT_TC | DMA_IT_TE);
+  HAL_NVIC_DisableIRQ(DMA1_Channel1_IRQn);
+}
+
+/**
+ * @brief Stop the scans and the DMA, the buffer keeps the last values
+ *
+ * A scan that misses triggers (a slow ADC clock, a clock switch) would leave the DMA one phase off for good,
+ * so anything that changes the ADC or timer clocks stops the scans first and starts them again with ana_f_Start_v()
+ *
+ * @return void
+ */
+void ana_f_Stop_v(void)
+{
+  if (HAL_ADC_Stop_DMA(&hadc1) != HAL_OK)
+  {
+    Error_Handler();
+  }
+}
+
+/**
+ * @brief Set the sampling time of the battery, the last and slowest channel of the scan, only while stopped
+ *
+ * @param samplingTime - ADC_SAMPLETIME_x
+ *
+ * @return void
+ */
+void ana_f_SetBattSampling_v(uint32_t samplingTime)
+{
+  ADC_ChannelConfTypeDef l_cfg_s = {0};
+
+  l_cfg_s.Channel = ADC_CHANNEL_10;
+  l_cfg_s.Rank = ADC_REGULAR_RANK_1 + ANA_CH_BATT;
+  l_cfg_s.SamplingTime = samplingTime;
+  if (HAL_ADC_ConfigChannel(&hadc1, &l_cfg_s) != HAL_OK)
+  {
+    Error_Handler();
+  }
+}
+
+/**
+ * @brief Get the latest conversion of an analog input
+ *
+ * @param channel - which input to read
+ *
+ * @return uint16_t - raw 12-bit value, from the scan taken in the quieter part of the PWM cycle
+ */
+uint16_t ana_f_Get_u16(ana_Channel_e channel)
+{
+  return ana_g_Raw_u16[ana_g_QuietPhase_e][channel];
+}
+
+/**
+ * @brief Select which of the two scans ana_f_Get_u16() returns
+ *
+ * @param phase - point of the PWM cycle furthest from any switching edge
+ *
+ * @return void
+ */
+void ana_f_SetQuietPhase_v(ana_Phase_e phase)
+{
+  ana_g_QuietPhase_e = phase;
+}
@@ -0,0 +1,312 @@
+/**
+ * @file boot.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Resident boot stage
+ *
+ * Sits in the first 16K of flash and runs on every reset, before the application. It never talks to the host,
+ * receiving an update is done by the application (see upd.c), which writes the new image into the staging area.
+ * The boot stage only installs a staged image: once it is committed and its CRC checks out, it is swapped with
+ * the application a page at a time, through a scratch page, and checked again there. The old application then
+ * waits in the staging area until the new one confirms itself, which it does as soon as an update frame of the
+ * host reaches it (upd_f_Confirm_v()). A new image that is reset before that, because it hangs, crashes or never
+ * gets its link up, is swapped back out on that reset, so a hand whose new firmware can't be reached again by
+ * the updater always goes back to the firmware that could.
+ *
+ * Every step of a swap is marked in the control record once it is done, and each one only reads pages the
+ * steps before it left alone, so a reset or power loss at any point simply resumes the swap on the next reset.
+ * Swapping takes three page erases and copies per page of the image, a few seconds for a large one.
+ *
+ * The boot stage uses no HAL, no interrupts and no initialised or zeroed RAM (the startup code of the application
+ * has not run yet), only locals on the stack and the flash registers. It is never updated itself.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "boot_e.h"
+#include "boot_i.h"
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Vector table used on reset, only the stack pointer, the reset and the fault handlers
+ *
+ * The application has its own complete vector table (startup file), which the boot stage switches to
+ */
+__attribute__((section(".boot.vector"), used)) const boot_Vector_t boot_g_Vector_s[] = {
+    (boot_Vector_t)&_estack, /* Initial stack pointer */
+    boot_f_Reset_v,          /* Reset */
+    boot_f_Fault_v,          /* NMI */
+    boot_f_Fault_v,          /* HardFault */
+    boot_f_Fault_v,          /* MemManage */
+    boot_f_Fault_v,          /* BusFault */
+    boot_f_Fault_v           /* UsageFault */
+};
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+void boot_f_Reset_v(void);
+void boot_f_Fault_v(void);
+void boot_f_Swap_v(const boot_s_Control_t *control, boot_Swap_e swap);
+void boot_f_CopyPage_v(uint32_t destination, uint32_t source);
+void boot_f_StartApp_v(void);
+uint32_t boot_f_Crc32_u32(uint32_t address, uint32_t len);
+void boot_f_FlashWait_v(void);
+void boot_f_ErasePage_v(uint32_t address);
+void boot_f_Program_v(uint32_t address, uint16_t halfWord);
+
+/**
+ * @brief Reset handler, installs a committed image or takes back one that was never confirmed,
+ * and starts the application
+ *
+ * Runs on the 8MHz HSI the chip resets to, which needs no flash wait states
+ *
+ * @return void
+ */
+void boot_f_Reset_v(void)
+{
+  const boot_s_Control_t *l_control_ps = (const boot_s_Control_t *)BOOT_CONTROL_ADDRESS;
+
+  if ((l_control_ps->magic_u32 != BOOT_MAGIC) ||
+      (l_control_ps->size_u32 == 0) ||
+      (l_control_ps->size_u32 > BOOT_IMAGE_SIZE) ||
+      (l_control_ps->reverted_u16 == BOOT_FLAG_SET))
+  {
+    boot_f_StartApp_v();
+  }
+
+  FLASH->KEYR = FLASH_KEY1;
+  FLASH->KEYR = FLASH_KEY2;
+
+  /* A swap that was cut short leaves part of either image in the staging area, so only a new one checks the CRC */
+  if ((l_control_ps->committed_u16 == BOOT_FLAG_SET) &&
+      (l_control_ps->installed_u16 != BOOT_FLAG_SET) &&
+      ((l_control_ps->swap_u16[BOOT_SWAP_INSTALL][0][BOOT_STEP_SAVED] == BOOT_FLAG_SET) ||
+       (boot_f_Crc32_u32(BOOT_STAGE_ADDRESS, l_control_ps->size_u32) == l_control_ps->crc_u32)))
+  {
+    boot_f_Swap_v(l_control_ps, BOOT_SWAP_INSTALL);
+
+    if (boot_f_Crc32_u32(BOOT_APP_ADDRESS, l_control_ps->size_u32) == l_control_ps->crc_u32)
+    {
+      boot_f_Program_v((uint32_t)&l_control_ps->installed_u16, BOOT_FLAG_SET);
+    }
+    else
+    {
+      boot_f_Swap_v(l_control_ps, BOOT_SWAP_REVERT);
+      boot_f_Program_v((uint32_t)&l_control_ps->reverted_u16, BOOT_FLAG_SET);
+    }
+  }
+  /* Installed on an earlier reset, and reset again before the host reached it */
+  else if ((l_control_ps->installed_u16 == BOOT_FLAG_SET) && (l_control_ps->confirmed_u16 != BOOT_FLAG_SET))
+  {
+    boot_f_Swap_v(l_control_ps, BOOT_SWAP_REVERT);
+    boot_f_Program_v((uint32_t)&l_control_ps->reverted_u16, BOOT_FLAG_SET);
+  }
+
+  FLASH->CR |= FLASH_CR_LOCK;
+
+  boot_f_StartApp_v();
+}
+
+/**
+ * @brief Fault handler of the boot stage
+ *
+ * @return void
+ */
+void boot_f_Fault_v(void)
+{
+  while (1)
+  {
+  }
+}
+
+/**
+ * @brief Swap the pages of the image between the application and the staging area, the flash has to be unlocked
+ *
+ * Both swaps move the same pages, those the new image covers. Pages of a larger old application beyond them
+ * are never touched, so the old application comes back whole. Steps already marked done are skipped
+ *
+ * @param control - control record of the staged image
+ * @param swap - which swap, each one has its own steps in the record
+ *
+ * @return void
+ */
+void boot_f_Swap_v(const boot_s_Control_t *control, boot_Swap_e swap)
+{
+  const uint16_t *l_steps_pu16;
+  uint32_t l_pages_u32 = (control->size_u32 + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE;
+  uint32_t l_offset_u32;
+  uint32_t i;
+
+  for (i = 0; i < l_pages_u32; i++)
+  {
+    l_steps_pu16 = control->swap_u16[swap][i];
+    l_offset_u32 = i * FLASH_PAGE_SIZE;
+
+    if (l_steps_pu16[BOOT_STEP_SAVED] != BOOT_FLAG_SET)
+    {
+      boot_f_CopyPage_v(BOOT_SCRATCH_ADDRESS, BOOT_APP_ADDRESS + l_offset_u32);
+      boot_f_Program_v((uint32_t)&l_steps_pu16[BOOT_STEP_SAVED], BOOT_FLAG_SET);
+    }
+
+    if (l_steps_pu16[BOOT_STEP_APP] != BOOT_FLAG_SET)
+    {
+      boot_f_CopyPage_v(BOOT_APP_ADDRESS + l_offset_u32, BOOT_STAGE_ADDRESS + l_offset_u32);
+      boot_f_Program_v((uint32_t)&l_steps_pu16[BOOT_STEP_APP], BOOT_FLAG_SET);
+    }
+
+    if (l_steps_pu16[BOOT_STEP_STAGE] != BOOT_FLAG_SET)
+    {
+      boot_f_CopyPage_v(BOOT_STAGE_ADDRESS + l_offset_u32, BOOT_SCRATCH_ADDRESS);
+      boot_f_Program_v((uint32_t)&l_steps_pu16[BOOT_STEP_STAGE], BOOT_FLAG_SET);
+    }
+  }
+}
+
+/**
+ * @brief Erase a page and copy another one into it, until the copy reads back right, the flash has to be unlocked
+ *
+ * Nothing to fall back to if it never does, the step before it already moved the only other copy along
+ *
+ * @param destination - start of the page to overwrite
+ * @param source - start of the page to copy
+ *
+ * @return void
+ */
+void boot_f_CopyPage_v(uint32_t destination, uint32_t source)
+{
+  uint32_t l_offset_u32;
+  uint8_t l_ok_u8 = 0;
+
+  while (!l_ok_u8)
+  {
+    boot_f_ErasePage_v(destination);
+
+    for (l_offset_u32 = 0; l_offset_u32 < FLASH_PAGE_SIZE; l_offset_u32 += 2)
+    {
+      boot_f_Program_v(destination + l_offset_u32, *(const uint16_t *)(source + l_offset_u32));
+    }
+
+    l_ok_u8 = 1;
+    for (l_offset_u32 = 0; l_offset_u32 < FLASH_PAGE_SIZE; l_offset_u32 += 4)
+    {
+      if (*(const volatile uint32_t *)(destination + l_offset_u32) != *(const uint32_t *)(source + l_offset_u32))
+      {
+        l_ok_u8 = 0;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Switch to the vector table and stack of the application and jump into its reset handler
+ *
+ * An application area without a plausible stack pointer and reset handler is never started
+ *
+ * @return void
+ */
+void boot_f_StartApp_v(void)
+{
+  uint32_t l_stack_u32 = ((const uint32_t *)BOOT_APP_ADDRESS)[0];
+  uint32_t l_reset_u32 = ((const uint32_t *)BOOT_APP_ADDRESS)[1];
+
+  if ((l_stack_u32 <= BOOT_RAM_START) || (l_stack_u32 > BOOT_RAM_END) ||
+      (l_reset_u32 < BOOT_APP_ADDRESS) || (l_reset_u32 >= BOOT_STAGE_ADDRESS))
+  {
+    boot_f_Fault_v();
+  }
+
+  SCB->VTOR = BOOT_APP_ADDRESS;
+
+  /* In one go, without a debug build reading the locals back from the stack that was just switched */
+  __ASM volatile("msr msp, %0\n"
+                 "bx %1\n"
+                 :
+                 : "r"(l_stack_u32), "r"(l_reset_u32));
+}
+
+/**
+ * @brief Standard CRC-32 (reflected, polynomial 0xEDB88320) over flash, same as nvm_f_Crc32_u32()
+ *
+ * @param address - start of the flash to run the CRC over
+ * @param len - number of bytes
+ *
+ * @return uint32_t - the CRC
+ */
+uint32_t boot_f_Crc32_u32(uint32_t address, uint32_t len)
+{
+  const uint8_t *l_data_pu8 = (const uint8_t *)address;
+  uint32_t l_crc_u32 = 0xFFFFFFFFUL;
+  uint32_t i;
+  uint8_t j;
+
+  for (i = 0; i < len; i++)
+  {
+    l_crc_u32 ^= l_data_pu8[i];
+    for (j = 0; j < 8; j++)
+    {
+      l_crc_u32 = (l_crc_u32 & 1) ? ((l_crc_u32 >> 1) ^ 0xEDB88320UL) : (l_crc_u32 >> 1);
+    }
+  }
+
+  return ~l_crc_u32;
+}
+
+/**
+ * @brief Wait until the flash is done with the last erase or program operation, and clear its status
+ *
+ * @return void
+ */
+void boot_f_FlashWait_v(void)
+{
+  while (FLASH->SR & FLASH_SR_BSY)
+  {
+  }
+  FLASH->SR = FLASH_SR_EOP | FLASH_SR_PGERR | FLASH_SR_WRPRTERR;
+}
+
+/**
+ * @brief Erase one flash page, the flash has to be unlocked
+ *
+ * @param address - any address inside the page
+ *
+ * @return void
+ */
+void boot_f_ErasePage_v(uint32_t address)
+{
+  FLASH->CR |= FLASH_CR_PER;
+  FLASH->AR = address;
+  FLASH->CR |= FLASH_CR_STRT;
+  boot_f_FlashWait_v();
+  FLASH->CR &= ~FLASH_CR_PER;
+}
+
+/**
+ * @brief Program one halfword, the flash has to be unlocked and the halfword erased
+ *
+ * @param address - halfword aligned address
+ * @param halfWord - value to program
+ *
+ * @return void
+ */
+void boot_f_Program_v(uint32_t address, uint16_t halfWord)
+{
+  FLASH->CR |= FLASH_CR_PG;
+  *(volatile uint16_t *)address = halfWord;
+  boot_f_FlashWait_v();
+  FLASH->CR &= ~FLASH_CR_PG;
+}
@@ -0,0 +1,462 @@
+/**
+ * @file cal.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Hall sensor calibration software component
+ *
+ * Drives one finger at a time slowly to its open end stop, then across the whole range to its closed end stop,
+ * recording the hall sensor on the way. End stops are found by the hall value no longer changing (the motor stalls).
+ * As the finger moves at a constant speed during the sweep, the time since leaving the open end stop is
+ * a measure of its position, which is what makes the linearisation possible without any other sensor.
+ *
+ * The recording is turned into a monotonic LUT over evenly spaced raw values (see pos.c),
+ * and the LUTs of all fingers are stored in flash.
+ *
+ * Starts by itself at boot when there is no valid calibration in flash, or when BTN_01 is held.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "cal_e.h"
+#include "cal_i.h"
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Current state of the calibration routine
+ *
+ */
+cal_State_e cal_g_State_e;
+
+/**
+ * @brief Finger being calibrated, or that failed
+ *
+ * @values 0..POS_FINGER_COUNT - 1
+ */
+uint8_t cal_g_Finger_u8;
+
+/**
+ * @brief Reason of the last failure
+ *
+ */
+cal_Error_e cal_g_Error_e;
+
+/**
+ * @brief Time spent in the current state
+ *
+ * @values in milliseconds
+ */
+uint32_t cal_g_StateMs_u32;
+
+/**
+ * @brief End stop detection window: its age and the hall value at its start
+ *
+ */
+uint16_t cal_g_WindowMs_u16;
+uint16_t cal_g_WindowRaw_u16;
+
+/**
+ * @brief Hall values recorded during the closing sweep, evenly spaced in time
+ *
+ */
+uint16_t cal_g_Samples_u16[CAL_MAX_SAMPLES];
+uint16_t cal_g_SampleCnt_u16;
+uint16_t cal_g_SamplePeriodMs_u16;
+uint16_t cal_g_SampleTimerMs_u16;
+
+/**
+ * @brief Calibration being built, handed over to pos.c once all fingers are done
+ *
+ */
+pos_s_CalData_t cal_g_Result_s;
+
+/**
+ * @brief How long BTN_01 has been held
+ *
+ * @values in milliseconds
+ */
+uint16_t cal_g_ButtonMs_u16;
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+void cal_f_Init_v(void);
+void cal_f_Handle_v(void);
+void cal_f_Start_v(void);
+uint8_t cal_f_IsRunning_u8(void);
+
+void cal_f_StartFinger_v(uint8_t fingerIndex);
+uint8_t cal_f_Stalled_u8(uint16_t raw);
+void cal_f_Record_v(uint16_t raw);
+uint8_t cal_f_BuildLut_u8(pos_s_FingerLut_t *lut);
+void cal_f_Fail_v(cal_Error_e error);
+
+/**
+ * @brief Initialise function to be called once on boot, after pos_f_Init_v()
+ *
+ * Without a stored calibration the position feedback is useless, so calibrate right away
+ *
+ * @return void
+ */
+void cal_f_Init_v(void)
+{
+  cal_g_State_e = CAL_IDLE;
+  cal_g_Error_e = CAL_ERR_NONE;
+  cal_g_ButtonMs_u16 = 0;
+
+  if (!pos_g_Calibrated_u8)
+  {
+    cal_f_Start_v();
+  }
+}
+
+/**
+ * @brief Handle function to be called every millisecond, after pos_f_Handle_v() and mot_f_Handle_v()
+ *
+ * Watch BTN_01 and step the calibration state machine
+ *
+ * @return void
+ */
+void cal_f_Handle_v(void)
+{
+  uint8_t l_finger_u8 = cal_g_Finger_u8;
+  uint16_t l_raw_u16;
+
+  /* Long press on BTN_01 starts a new calibration */
+  if (HAL_GPIO_ReadPin(BTN_01_GPIO_Port, BTN_01_Pin) == CAL_BUTTON_PRESSED)
+  {
+    if (cal_g_ButtonMs_u16 < CAL_BUTTON_HOLD_MS)
+    {
+      cal_g_ButtonMs_u16++;
+      if ((cal_g_ButtonMs_u16 == CAL_BUTTON_HOLD_MS) && !cal_f_IsRunning_u8())
+      {
+        cal_f_Start_v();
+      }
+    }
+  }
+  else
+  {
+    cal_g_ButtonMs_u16 = 0;
+  }
+
+  if (!cal_f_IsRunning_u8())
+  {
+    return;
+  }
+
+  if (mot_g_Fault_u8[l_finger_u8])
+  {
+    cal_f_Fail_v(CAL_ERR_FAULT);
+    return;
+  }
+
+  l_raw_u16 = pos_g_Raw_u16[l_finger_u8];
+  cal_g_StateMs_u32++;
+
+  switch (cal_g_State_e)
+  {
+  case CAL_OPENING:
+    if (cal_f_Stalled_u8(l_raw_u16))
+    {
+      mot_f_SetDuty_v(l_finger_u8, 0);
+      cal_g_State_e = CAL_SETTLE;
+      cal_g_StateMs_u32 = 0;
+    }
+    else if (cal_g_StateMs_u32 > CAL_SWEEP_TIMEOUT_MS)
+    {
+      cal_f_Fail_v(CAL_ERR_TIMEOUT);
+    }
+    break;
+
+  case CAL_SETTLE:
+    if (cal_g_StateMs_u32 >= CAL_SETTLE_MS)
+    {
+      cal_g_SampleCnt_u16 = 0;
+      cal_g_SamplePeriodMs_u16 = CAL_SAMPLE_PERIOD_MS;
+      cal_g_SampleTimerMs_u16 = 0;
+      cal_g_WindowMs_u16 = 0;
+      cal_g_WindowRaw_u16 = l_raw_u16;
+
+      mot_f_SetDuty_v(l_finger_u8, CAL_SWEEP_DUTY);
+      cal_g_State_e = CAL_CLOSING;
+      cal_g_StateMs_u32 = 0;
+    }
+    break;
+
+  case CAL_CLOSING:
+    cal_f_Record_v(l_raw_u16);
+
+    if (cal_f_Stalled_u8(l_raw_u16))
+    {
+      mot_f_SetDuty_v(l_finger_u8, 0);
+
+      if (!cal_f_BuildLut_u8(&cal_g_Result_s.finger_s[l_finger_u8]))
+      {
+        cal_f_Fail_v(CAL_ERR_RANGE);
+      }
+      else if ((l_finger_u8 + 1) < POS_FINGER_COUNT)
+      {
+        cal_f_StartFinger_v(l_finger_u8 + 1);
+      }
+      else if (pos_f_SetCalibration_u8(&cal_g_Result_s))
+      {
+        /* All motors are stopped by now, so the CPU stalling during the flash write does no harm */
+        cal_g_State_e = CAL_DONE;
+      }
+      else
+      {
+        cal_f_Fail_v(CAL_ERR_FLASH);
+      }
+    }
+    else if (cal_g_StateMs_u32 > CAL_SWEEP_TIMEOUT_MS)
+    {
+      cal_f_Fail_v(CAL_ERR_TIMEOUT);
+    }
+    break;
+
+  default:
+    break;
+  }
+}
+
+/**
+ * @brief Start calibrating all fingers, the motors are taken over until it is done
+ *
+ * @return void
+ */
+void cal_f_Start_v(void)
+{
+  cal_g_Error_e = CAL_ERR_NONE;
+  mot_f_StopAll_v();
+  cal_f_StartFinger_v(0);
+}
+
+/**
+ * @brief Whether the calibration is currently driving the motors
+ *
+ * @return uint8_t - 1 while running, 0 otherwise
+ */
+uint8_t cal_f_IsRunning_u8(void)
+{
+  return (cal_g_State_e == CAL_OPENING) || (cal_g_State_e == CAL_SETTLE) || (cal_g_State_e == CAL_CLOSING);
+}
+
+/**
+ * @brief Start the opening sweep of one finger
+ *
+ * @param fingerIndex - which finger, 0..POS_FINGER_COUNT - 1
+ *
+ * @return void
+ */
+void cal_f_StartFinger_v(uint8_t fingerIndex)
+{
+  cal_g_Finger_u8 = fingerIndex;
+  cal_g_WindowMs_u16 = 0;
+  cal_g_WindowRaw_u16 = pos_g_Raw_u16[fingerIndex];
+
+  mot_f_SetDuty_v(fingerIndex, -CAL_SWEEP_DUTY);
+  cal_g_State_e = CAL_OPENING;
+  cal_g_StateMs_u32 = 0;
+}
+
+/**
+ * @brief End stop detection, to be called every millisecond while sweeping
+ *
+ * @param raw - current filtered hall value of the finger
+ *
+ * @return uint8_t - 1 if the hall value barely changed over the last window (finger stopped), 0 otherwise
+ */
+uint8_t cal_f_Stalled_u8(uint16_t raw)
+{
+  uint16_t l_delta_u16;
+
+  cal_g_WindowMs_u16++;
+  if (cal_g_WindowMs_u16 < CAL_STALL_WINDOW_MS)
+  {
+    return 0;
+  }
+
+  l_delta_u16 = (raw > cal_g_WindowRaw_u16) ? (raw - cal_g_WindowRaw_u16) : (cal_g_WindowRaw_u16 - raw);
+  cal_g_WindowMs_u16 = 0;
+  cal_g_WindowRaw_u16 = raw;
+
+  return (l_delta_u16 < CAL_STALL_DELTA);
+}
+
+/**
+ * @brief Record the hall value during the closing sweep, to be called every millisecond
+ *
+ * When the buffer is full every other sample is dropped and the period doubled,
+ * so the samples stay evenly spaced in time
+ *
+ * @param raw - current filtered hall value of the finger
+ *
+ * @return void
+ */
+void cal_f_Record_v(uint16_t raw)
+{
+  uint16_t i;
+
+  if (cal_g_SampleTimerMs_u16 == 0)
+  {
+    if (cal_g_SampleCnt_u16 >= CAL_MAX_SAMPLES)
+    {
+      for (i = 0; i < (CAL_MAX_SAMPLES / 2); i++)
+      {
+        cal_g_Samples_u16[i] = cal_g_Samples_u16[i * 2];
+      }
+      cal_g_SampleCnt_u16 = CAL_MAX_SAMPLES / 2;
+      cal_g_SamplePeriodMs_u16 *= 2;
+    }
+
+    cal_g_Samples_u16[cal_g_SampleCnt_u16++] = raw;
+  }
+
+  cal_g_SampleTimerMs_u16++;
+  if (cal_g_SampleTimerMs_u16 >= cal_g_SamplePeriodMs_u16)
+  {
+    cal_g_SampleTimerMs_u16 = 0;
+  }
+}
+
+/**
+ * @brief Turn the recording of the closing sweep into the LUT of the finger
+ *
+ * The flat start (motor spinning up) and end (pushing against the end stop) are cut off,
+ * what is left spans the travel from open to closed at constant speed. Noise going against
+ * the overall direction is flattened so the LUT is monotonic, then for every evenly spaced
+ * raw value the time (= position) at which the sweep passed it is interpolated.
+ *
+ * @param lut - where to put the result
+ *
+ * @return uint8_t - 1 if the LUT was built, 0 if the recording is not usable
+ */
+uint8_t cal_f_BuildLut_u8(pos_s_FingerLut_t *lut)
+{
+  uint16_t *l_s_pu16 = cal_g_Samples_u16;
+  uint16_t l_cnt_u16 = cal_g_SampleCnt_u16;
+  uint16_t l_first_u16 = 0;
+  uint16_t l_last_u16;
+  uint16_t l_span_u16;
+  uint16_t l_range_u16;
+  uint16_t l_target_u16;
+  uint16_t l_tmp_u16;
+  uint16_t l_diff_u16;
+  uint16_t i, j, k;
+  uint32_t l_frac16_u32;
+  uint32_t l_pos_u32;
+  uint8_t l_rising_u8;
+
+  if (l_cnt_u16 < 2)
+  {
+    return 0;
+  }
+  l_last_u16 = l_cnt_u16 - 1;
+
+  /* Cut off the flat start and end */
+  while ((l_first_u16 < l_last_u16) &&
+         (((l_s_pu16[l_first_u16 + 1] > l_s_pu16[0]) ? (l_s_pu16[l_first_u16 + 1] - l_s_pu16[0]) : (l_s_pu16[0] - l_s_pu16[l_first_u16 + 1])) < CAL_STALL_DELTA))
+  {
+    l_first_u16++;
+  }
+  while ((l_last_u16 > l_first_u16) &&
+         (((l_s_pu16[l_last_u16 - 1] > l_s_pu16[l_cnt_u16 - 1]) ? (l_s_pu16[l_last_u16 - 1] - l_s_pu16[l_cnt_u16 - 1]) : (l_s_pu16[l_cnt_u16 - 1] - l_s_pu16[l_last_u16 - 1])) < CAL_STALL_DELTA))
+  {
+    l_last_u16--;
+  }
+
+  l_span_u16 = l_last_u16 - l_first_u16;
+  if (l_span_u16 < POS_LUT_SIZE)
+  {
+    return 0;
+  }
+
+  /* Work on a rising curve, a falling one is reversed and its positions mirrored at the end */
+  l_rising_u8 = (l_s_pu16[l_last_u16] > l_s_pu16[l_first_u16]);
+  if (!l_rising_u8)
+  {
+    for (i = l_first_u16, j = l_last_u16; i < j; i++, j--)
+    {
+      l_tmp_u16 = l_s_pu16[i];
+      l_s_pu16[i] = l_s_pu16[j];
+      l_s_pu16[j] = l_tmp_u16;
+    }
+  }
+
+  /* The position can only move one way during the sweep, so any dip is noise */
+  for (i = l_first_u16 + 1; i <= l_last_u16; i++)
+  {
+    if (l_s_pu16[i] < l_s_pu16[i - 1])
+    {
+      l_s_pu16[i] = l_s_pu16[i - 1];
+    }
+  }
+
+  l_range_u16 = l_s_pu16[l_last_u16] - l_s_pu16[l_first_u16];
+  if (l_range_u16 < CAL_MIN_RANGE)
+  {
+    return 0;
+  }
+
+  lut->rawMin_u16 = l_s_pu16[l_first_u16];
+  lut->rawMax_u16 = l_s_pu16[l_last_u16];
+  lut->indexScaleQ16_u32 = ((uint32_t)(POS_LUT_SIZE - 1) << 16) / l_range_u16;
+
+  j = l_first_u16;
+  for (k = 0; k < POS_LUT_SIZE; k++)
+  {
+    l_target_u16 = lut->rawMin_u16 + (uint16_t)(((uint32_t)l_range_u16 * k) / (POS_LUT_SIZE - 1));
+
+    /* Find the samples j, j + 1 around the target, the targets only grow so j never goes back */
+    while ((j < (l_last_u16 - 1)) && (l_s_pu16[j + 1] < l_target_u16))
+    {
+      j++;
+    }
+
+    l_diff_u16 = l_s_pu16[j + 1] - l_s_pu16[j];
+    l_frac16_u32 = (l_diff_u16 > 0) ? (((uint32_t)(l_target_u16 - l_s_pu16[j]) << 16) / l_diff_u16) : 0;
+    if (l_frac16_u32 > 0x10000)
+    {
+      l_frac16_u32 = 0x10000;
+    }
+
+    l_pos_u32 = ((uint32_t)(j - l_first_u16) * POS_FULL_SCALE + ((l_frac16_u32 * POS_FULL_SCALE) >> 16)) / l_span_u16;
+    if (l_pos_u32 > POS_FULL_SCALE)
+    {
+      l_pos_u32 = POS_FULL_SCALE;
+    }
+
+    lut->lut_u16[k] = l_rising_u8 ? (uint16_t)l_pos_u32 : (uint16_t)(POS_FULL_SCALE - l_pos_u32);
+  }
+
+  return 1;
+}
+
+/**
+ * @brief Abort the calibration and stop all motors
+ *
+ * The calibration in use (if any) stays as it was
+ *
+ * @param error - why it failed
+ *
+ * @return void
+ */
+void cal_f_Fail_v(cal_Error_e error)
+{
+  mot_f_StopAll_v();
+  cal_g_Error_e = error;
+  cal_g_State_e = CAL_FAILED;
+}
@@ -0,0 +1,382 @@
+/**
+ * @file clk.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief System clock profile software component
+ *
+ * The system starts at full speed, 72 MHz from the 16 MHz HSE crystal (see SystemClock_Config()).
+ * While the fingers are idle and the modules need little CPU time, it drops to 16 MHz straight from the crystal
+ * with the PLL off, and it goes back to full speed as soon as a finger has to move or the load rises.
+ *
+ * The load is the share of every millisecond spent in the modules, measured with the DWT cycle counter.
+ * After each switch the peripherals that derive their timing from a bus clock (UART baud rate, I2C clock,
+ * ADC clock, motor and LED PWM period) are set up again, SysTick is set up again by the HAL itself.
+ *
+ * USB has no clock in the low profile. The USB device is not started by this firmware yet,
+ * once it is, it has to count as demand for the full profile in clk_f_HasDemand_u8()
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "clk_e.h"
+#include "clk_i.h"
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Clock profile the system currently runs in
+ *
+ */
+clk_Profile_e clk_g_Profile_e;
+
+/**
+ * @brief Whether the profile follows the load, clear it to keep a profile set with clk_f_SetProfile_u8()
+ *
+ * @values 0 - fixed, 1 - automatic
+ */
+uint8_t clk_g_Auto_u8;
+
+/**
+ * @brief Share of the CPU time the modules took over the last load window
+ *
+ * @values 0..1000 (permille)
+ */
+uint16_t clk_g_LoadPermille_u16;
+
+/**
+ * @brief How many times the profile was switched, and how many switches did not end up in the requested profile
+ *
+ */
+uint32_t clk_g_SwitchCnt_u32;
+uint32_t clk_g_SwitchFailCnt_u32;
+
+/**
+ * @brief How many switches were followed by a first scan that did not come at the top of the PWM cycle
+ *
+ * Anything but 0 means the two halves of the scan buffer hold the wrong phases (see clk_f_CheckPhase_u8())
+ */
+uint32_t clk_g_PhaseSlipCnt_u32;
+
+/**
+ * @brief CPU cycles spent in the modules and milliseconds counted in the current load window
+ *
+ */
+uint32_t clk_g_BusyCycles_u32;
+uint16_t clk_g_WindowMs_u16;
+
+/**
+ * @brief How long the fingers have been idle
+ *
+ * @values 0..CLK_IDLE_MS (milliseconds)
+ */
+uint32_t clk_g_IdleMs_u32;
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+void clk_f_Init_v(void);
+void clk_f_Handle_v(void);
+uint8_t clk_f_SetProfile_u8(clk_Profile_e profile);
+uint32_t clk_f_Cycles_u32(void);
+void clk_f_AddBusy_v(uint32_t cycles);
+
+uint8_t clk_f_HasDemand_u8(void);
+void clk_f_RetimePeripherals_v(void);
+uint8_t clk_f_CheckPhase_u8(void);
+
+/**
+ * @brief Initialise function to be called once on boot, after SystemClock_Config()
+ *
+ * Start the DWT cycle counter used to measure the load
+ *
+ * @return void
+ */
+void clk_f_Init_v(void)
+{
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  clk_g_Profile_e = CLK_PROFILE_FULL;
+  clk_g_Auto_u8 = 1;
+}
+
+/**
+ * @brief Handle function to be called every millisecond
+ *
+ * Switch up right away when a finger has to move, otherwise decide once per load window
+ *
+ * @return void
+ */
+void clk_f_Handle_v(void)
+{
+  uint32_t l_windowCycles_u32;
+  uint32_t l_projected_u32;
+
+  if (clk_f_HasDemand_u8())
+  {
+    clk_g_IdleMs_u32 = 0;
+  }
+  else if (clk_g_IdleMs_u32 < CLK_IDLE_MS)
+  {
+    clk_g_IdleMs_u32++;
+  }
+
+  if (clk_g_Auto_u8 && (clk_g_IdleMs_u32 == 0) && (clk_g_Profile_e != CLK_PROFILE_FULL))
+  {
+    clk_f_SetProfile_u8(CLK_PROFILE_FULL);
+    return;
+  }
+
+  clk_g_WindowMs_u16++;
+  if (clk_g_WindowMs_u16 < CLK_LOAD_WINDOW_MS)
+  {
+    return;
+  }
+
+  l_windowCycles_u32 = (HAL_RCC_GetHCLKFreq() / 1000) * clk_g_WindowMs_u16;
+  clk_g_LoadPermille_u16 = (uint16_t)(((uint64_t)clk_g_BusyCycles_u32 * 1000) / l_windowCycles_u32);
+  clk_g_BusyCycles_u32 = 0;
+  clk_g_WindowMs_u16 = 0;
+
+  if (!clk_g_Auto_u8)
+  {
+    return;
+  }
+
+  if (clk_g_Profile_e == CLK_PROFILE_FULL)
+  {
+    /* Same work at the lower clock takes proportionally longer */
+    l_projected_u32 = ((uint32_t)clk_g_LoadPermille_u16 * (clk_s_ProfileConfig_s[CLK_PROFILE_FULL].hclkHz_u32 / 1000)) /
+                      (clk_s_ProfileConfig_s[CLK_PROFILE_LOW].hclkHz_u32 / 1000);
+
+    if ((clk_g_IdleMs_u32 >= CLK_IDLE_MS) && (l_projected_u32 < CLK_LOAD_DOWN_PERMILLE))
+    {
+      clk_f_SetProfile_u8(CLK_PROFILE_LOW);
+    }
+  }
+  else if (clk_g_LoadPermille_u16 >= CLK_LOAD_UP_PERMILLE)
+  {
+    clk_f_SetProfile_u8(CLK_PROFILE_FULL);
+  }
+}
+
+/**
+ * @brief Switch the system clock to another profile and set up the peripherals for it
+ *
+ * The scans and the motor timers are stopped for the switch. With the ADC clock divided down the most (2 MHz) a
+ * scan takes about 90us, longer than the 25us between two triggers, so triggers would be lost and the DMA could
+ * end up one phase off in the scan buffer for good. Afterwards the DMA starts over at the start of the buffer and
+ * the timers from 0, so the first scan is ANA_PHASE_PEAK again, which clk_f_CheckPhase_u8() checks.
+ * The ADC clock is still divided down the most while switching, so it can't go over its limit in between.
+ * If the oscillators don't cooperate, the system keeps running on whatever clock it ended up on,
+ * with the peripherals set up for that clock
+ *
+ * @param profile - profile to switch to
+ *
+ * @return uint8_t - 1 if the system now runs in the requested profile, 0 if not
+ */
+uint8_t clk_f_SetProfile_u8(clk_Profile_e profile)
+{
+  const clk_s_ProfileConfig_t *l_cfg_ps = &clk_s_ProfileConfig_s[profile];
+  RCC_OscInitTypeDef l_osc_s = {0};
+  RCC_ClkInitTypeDef l_clk_s = {0};
+  RCC_PeriphCLKInitTypeDef l_periph_s = {0};
+
+  if (profile == clk_g_Profile_e)
+  {
+    return 1;
+  }
+
+  mot_f_PauseTimers_v();
+  ana_f_Stop_v();
+
+  l_periph_s.PeriphClockSelection = RCC_PERIPHCLK_ADC;
+  l_periph_s.AdcClockSelection = RCC_ADCPCLK2_DIV8;
+  HAL_RCCEx_PeriphCLKConfig(&l_periph_s);
+
+  /* The PLL can only be changed while the system doesn't run from it */
+  l_osc_s.OscillatorType = RCC_OSCILLATORTYPE_NONE;
+  l_osc_s.HSEPredivValue = RCC_HSE_PREDIV_DIV2;
+  l_osc_s.PLL.PLLSource = RCC_PLLSOURCE_HSE;
+  l_osc_s.PLL.PLLMUL = l_cfg_ps->pllMul_u32;
+  if (l_cfg_ps->pllState_u32 == RCC_PLL_ON)
+  {
+    l_osc_s.PLL.PLLState = RCC_PLL_ON;
+    HAL_RCC_OscConfig(&l_osc_s);
+  }
+
+  l_clk_s.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
+  l_clk_s.SYSCLKSource = l_cfg_ps->sysclkSource_u32;
+  l_clk_s.AHBCLKDivider = RCC_SYSCLK_DIV1;
+  l_clk_s.APB1CLKDivider = l_cfg_ps->apb1Div_u32;
+  l_clk_s.APB2CLKDivider = RCC_HCLK_DIV1;
+  HAL_RCC_ClockConfig(&l_clk_s, l_cfg_ps->flashLatency_u32);
+
+  if (l_cfg_ps->pllState_u32 == RCC_PLL_OFF)
+  {
+    l_osc_s.PLL.PLLState = RCC_PLL_OFF;
+    HAL_RCC_OscConfig(&l_osc_s);
+  }
+
+  /* Whatever happened above, the registers now tell which profile the system runs in */
+  clk_g_Profile_e = (__HAL_RCC_GET_SYSCLK_SOURCE() == RCC_SYSCLKSOURCE_STATUS_PLLCLK) ? CLK_PROFILE_FULL : CLK_PROFILE_LOW;
+
+  l_periph_s.AdcClockSelection = clk_s_ProfileConfig_s[clk_g_Profile_e].adcDiv_u32;
+  HAL_RCCEx_PeriphCLKConfig(&l_periph_s);
+
+  clk_f_RetimePeripherals_v();
+
+  /* The update event also goes out to the ADC, so it comes before the scans are armed, and the DMA is waiting
+     at the start of the buffer when the first real trigger comes */
+  mot_f_ReloadTimers_v();
+  ana_f_SetBattSampling_v(clk_s_ProfileConfig_s[clk_g_Profile_e].battSampling_u32);
+  ana_f_Start_v();
+  mot_f_ResumeTimers_v();
+
+  if (!clk_f_CheckPhase_u8())
+  {
+    clk_g_PhaseSlipCnt_u32++;
+  }
+
+  /* The load measured so far was at the old clock */
+  clk_g_BusyCycles_u32 = 0;
+  clk_g_WindowMs_u16 = 0;
+
+  clk_g_SwitchCnt_u32++;
+  if (clk_g_Profile_e != profile)
+  {
+    clk_g_SwitchFailCnt_u32++;
+    return 0;
+  }
+
+  return 1;
+}
+
+/**
+ * @brief Current value of the free running CPU cycle counter
+ *
+ * @return uint32_t - CPU cycles, wraps around
+ */
+uint32_t clk_f_Cycles_u32(void)
+{
+  return DWT->CYCCNT;
+}
+
+/**
+ * @brief Add CPU cycles spent in the modules to the current load window
+ *
+ * @param cycles - CPU cycles, measured with clk_f_Cycles_u32()
+ *
+ * @return void
+ */
+void clk_f_AddBusy_v(uint32_t cycles)
+{
+  clk_g_BusyCycles_u32 += cycles;
+}
+
+/**
+ * @brief Whether anything needs the full profile regardless of the load
+ *
+ * Moving fingers want the finest PWM resolution, which scales with the timer clock,
+ * and a firmware update must not have its UART re-initialised in the middle
+ *
+ * @return uint8_t - 1 if the full profile is needed, 0 if not
+ */
+uint8_t clk_f_HasDemand_u8(void)
+{
+  uint8_t i;
+
+  if (cal_f_IsRunning_u8() || hom_f_IsRunning_u8() || upd_f_IsBusy_u8())
+  {
+    return 1;
+  }
+
+  for (i = 0; i < MOT_COUNT; i++)
+  {
+    if (mot_g_Duty_s16[i] != 0)
+    {
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Set up every peripheral whose timing is derived from a bus clock again, for the current clock
+ *
+ * The HAL init functions compute the baud rate and I2C clock registers from the current bus clock
+ *
+ * @return void
+ */
+void clk_f_RetimePeripherals_v(void)
+{
+  /* A transfer cut short by the re-init would leave its interrupt enabled, so stop it cleanly first */
+  HAL_UART_Abort(&huart4);
+
+  if (HAL_UART_Init(&huart4) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  tlm_f_EnableRx_v();
+
+  if (HAL_I2C_Init(&hi2c1) != HAL_OK)
+  {
+    Error_Handler();
+  }
+
+  mot_f_UpdateTiming_v();
+  led_f_UpdateTiming_v();
+}
+
+/**
+ * @brief Check that the first scan after the timers were started again landed at the top of the PWM cycle
+ *
+ * Waits for the DMA to finish the first half of the buffer (ANA_PHASE_PEAK), then reads the counting direction
+ * of TIM3, the timer triggering the ADC: right after the top it counts down, right after the bottom it counts up.
+ * Interrupts are held off, so the direction is read within the same half of the PWM cycle as the scan ended.
+ * Takes at most half a PWM period and one scan
+ *
+ * @return uint8_t - 1 if the first scan was ANA_PHASE_PEAK, 0 if it was not or never came
+ */
+uint8_t clk_f_CheckPhase_u8(void)
+{
+  uint32_t l_primask_u32 = __get_PRIMASK();
+  uint32_t l_timeout_u32 = (HAL_RCC_GetHCLKFreq() / 1000000) * CLK_PHASE_TIMEOUT_US;
+  uint32_t l_start_u32 = clk_f_Cycles_u32();
+  uint8_t l_ok_u8 = 0;
+
+  __disable_irq();
+
+  while (__HAL_DMA_GET_COUNTER(&hdma_adc1) > ANA_CH_COUNT)
+  {
+    if ((clk_f_Cycles_u32() - l_start_u32) > l_timeout_u32)
+    {
+      break;
+    }
+  }
+
+  /* Only the first scan done, and the counter turned at the top */
+  if ((__HAL_DMA_GET_COUNTER(&hdma_adc1) == ANA_CH_COUNT) && (htim3.Instance->CR1 & TIM_CR1_DIR))
+  {
+    l_ok_u8 = 1;
+  }
+
+  __set_PRIMASK(l_primask_u32);
+
+  return l_ok_u8;
+}
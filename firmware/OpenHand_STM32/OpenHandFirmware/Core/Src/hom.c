@@ -0,0 +1,249 @@
+/**
+ * @file hom.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Homing software component
+ *
+ * After power-up nothing is known about where the fingers are, so all fingers are driven open at the same time,
+ * fast while the calibrated position says they are far from the end stop and at a limited duty for the last part.
+ * A finger is at its end stop when its hall velocity stays near zero, its hall value there becomes
+ * the reference for the position lookup (see pos_f_SetOpenReference_s16()).
+ *
+ * Every finger that is not home within HOM_TIME_BUDGET_MS is stopped and reported, so the hand is in
+ * a known open posture (or known to be faulty) within a fixed time after homing starts.
+ * Homing waits for a running hall calibration to finish, as that needs the motors for itself.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "hom_e.h"
+#include "hom_i.h"
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief State of the homing sequence
+ *
+ */
+hom_State_e hom_g_State_e;
+
+/**
+ * @brief Homing state of each finger
+ *
+ */
+hom_FingerState_e hom_g_FingerState_e[POS_FINGER_COUNT];
+
+/**
+ * @brief How long the homing took, from boot until the last finger stopped
+ *
+ * @values in milliseconds
+ */
+uint32_t hom_g_DoneAtMs_u32;
+
+/**
+ * @brief Last HOM_VEL_HISTORY filtered raw hall values of each finger, and where the next one goes
+ *
+ */
+uint16_t hom_g_History_u16[POS_FINGER_COUNT][HOM_VEL_HISTORY];
+uint8_t hom_g_HistoryIdx_u8;
+
+/**
+ * @brief Time since homing started
+ *
+ * @values in milliseconds
+ */
+uint32_t hom_g_ElapsedMs_u32;
+
+/**
+ * @brief For how long the hall velocity of each finger has been below HOM_STALL_DELTA
+ *
+ * @values in milliseconds
+ */
+uint16_t hom_g_StillMs_u16[POS_FINGER_COUNT];
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+void hom_f_Init_v(void);
+void hom_f_Handle_v(void);
+uint8_t hom_f_IsRunning_u8(void);
+
+void hom_f_Start_v(void);
+void hom_f_Finish_v(void);
+
+/**
+ * @brief Initialise function to be called once on boot, after cal_f_Init_v()
+ *
+ * @return void
+ */
+void hom_f_Init_v(void)
+{
+  hom_g_State_e = HOM_PENDING;
+  hom_g_DoneAtMs_u32 = 0;
+}
+
+/**
+ * @brief Handle function to be called every millisecond, after pos_f_Handle_v() and cal_f_Handle_v()
+ *
+ * Start homing once the motors are free, then watch every finger until it stalls at its open end stop
+ *
+ * @return void
+ */
+void hom_f_Handle_v(void)
+{
+  uint8_t i;
+  uint8_t l_idx_u8;
+  uint8_t l_moving_u8 = 0;
+  uint16_t l_raw_u16;
+  uint16_t l_old_u16;
+  uint16_t l_vel_u16;
+
+  if (hom_g_State_e == HOM_PENDING)
+  {
+    if (!cal_f_IsRunning_u8())
+    {
+      hom_f_Start_v();
+    }
+    return;
+  }
+
+  if (hom_g_State_e != HOM_RUNNING)
+  {
+    return;
+  }
+
+  hom_g_ElapsedMs_u32++;
+  l_idx_u8 = hom_g_HistoryIdx_u8;
+
+  for (i = 0; i < POS_FINGER_COUNT; i++)
+  {
+    l_raw_u16 = pos_g_Raw_u16[i];
+    l_old_u16 = hom_g_History_u16[i][(l_idx_u8 + HOM_VEL_HISTORY - HOM_VEL_WINDOW_MS) % HOM_VEL_HISTORY];
+    hom_g_History_u16[i][l_idx_u8] = l_raw_u16;
+
+    if (hom_g_FingerState_e[i] != HOM_FINGER_MOVING)
+    {
+      continue;
+    }
+
+    if (mot_g_Fault_u8[i])
+    {
+      mot_f_SetDuty_v(i, 0);
+      hom_g_FingerState_e[i] = HOM_FINGER_FAULT;
+      continue;
+    }
+
+    l_vel_u16 = (l_raw_u16 > l_old_u16) ? (l_raw_u16 - l_old_u16) : (l_old_u16 - l_raw_u16);
+    if ((hom_g_ElapsedMs_u32 > HOM_SPINUP_MS) && (l_vel_u16 < HOM_STALL_DELTA))
+    {
+      hom_g_StillMs_u16[i]++;
+    }
+    else
+    {
+      hom_g_StillMs_u16[i] = 0;
+    }
+
+    if (hom_g_StillMs_u16[i] >= HOM_STALL_CONFIRM_MS)
+    {
+      mot_f_SetDuty_v(i, 0);
+      pos_f_SetOpenReference_s16(i, l_raw_u16);
+      hom_g_FingerState_e[i] = HOM_FINGER_HOMED;
+      continue;
+    }
+
+    if (hom_g_ElapsedMs_u32 >= HOM_TIME_BUDGET_MS)
+    {
+      mot_f_SetDuty_v(i, 0);
+      hom_g_FingerState_e[i] = HOM_FINGER_TIMEOUT;
+      continue;
+    }
+
+    /* Only trust the position to be far from the end stop when there is a calibration */
+    if (pos_g_Calibrated_u8 && (pos_g_Position_u16[i] > HOM_APPROACH_POS))
+    {
+      mot_f_SetDuty_v(i, -HOM_FAST_DUTY);
+    }
+    else
+    {
+      mot_f_SetDuty_v(i, -HOM_APPROACH_DUTY);
+    }
+    l_moving_u8 = 1;
+  }
+
+  hom_g_HistoryIdx_u8 = (l_idx_u8 + 1) % HOM_VEL_HISTORY;
+
+  if (!l_moving_u8)
+  {
+    hom_f_Finish_v();
+  }
+}
+
+/**
+ * @brief Whether the homing is currently driving the motors
+ *
+ * @return uint8_t - 1 while running, 0 otherwise
+ */
+uint8_t hom_f_IsRunning_u8(void)
+{
+  return (hom_g_State_e == HOM_RUNNING);
+}
+
+/**
+ * @brief Start moving all fingers towards their open end stops
+ *
+ * @return void
+ */
+void hom_f_Start_v(void)
+{
+  uint8_t i, j;
+
+  for (i = 0; i < POS_FINGER_COUNT; i++)
+  {
+    for (j = 0; j < HOM_VEL_HISTORY; j++)
+    {
+      hom_g_History_u16[i][j] = pos_g_Raw_u16[i];
+    }
+    hom_g_StillMs_u16[i] = 0;
+    hom_g_FingerState_e[i] = HOM_FINGER_MOVING;
+  }
+
+  hom_g_HistoryIdx_u8 = 0;
+  hom_g_ElapsedMs_u32 = 0;
+  hom_g_State_e = HOM_RUNNING;
+}
+
+/**
+ * @brief All fingers have stopped, note the result
+ *
+ * @return void
+ */
+void hom_f_Finish_v(void)
+{
+  uint8_t i;
+
+  mot_f_StopAll_v();
+
+  hom_g_State_e = HOM_DONE;
+  for (i = 0; i < POS_FINGER_COUNT; i++)
+  {
+    if (hom_g_FingerState_e[i] != HOM_FINGER_HOMED)
+    {
+      hom_g_State_e = HOM_FAILED;
+    }
+  }
+
+  hom_g_DoneAtMs_u32 = HAL_GetTick();
+}
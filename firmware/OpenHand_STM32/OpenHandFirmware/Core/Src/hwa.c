@@ -0,0 +1,179 @@
+/**
+ * @file hwa.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Fast hardware access software component
+ *
+ * The accessors themselves are inline in hwa_e.h, this file only holds the benchmark that compares them
+ * against the HAL calls they replace. It runs once on boot and leaves its results in hwa_g_Bench_s,
+ * to be read with the debugger. All numbers are CPU cycles, so they don't depend on the clock profile,
+ * while hwa_g_StepPermille_u16 is relative to the boot clock.
+ *
+ * The control step is what a motor control loop does for every finger: read the hall value,
+ * read the fault pin, compute the duty, write the direction pin and the compare value.
+ * The fast version is the real code path (mot_f_Handle_v() and mot_f_SetDuty_v()),
+ * the HAL version does the same work through HAL calls. Both work on the motors of mot_s_MotorConfig_s
+ * and the hall channels of pos_c_HallChannel_e.
+ *
+ * The HAL has no call that returns one channel of a DMA scan, its ADC read is HAL_ADC_GetValue(), which returns
+ * the data register of the last conversion. That is what a HAL control loop would call for every value,
+ * so it is what the DMA buffer read is compared against. A polled conversion (HAL_ADC_Start(),
+ * HAL_ADC_PollForConversion()) would measure the ADC itself rather than the access, and would stop the scans.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "hwa_e.h"
+#include "hwa_i.h"
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief CPU cycles each operation takes, measured once on boot, with the measurement overhead removed
+ *
+ * @values indexed by hwa_Bench_e
+ */
+hwa_s_BenchResult_t hwa_g_Bench_s[HWA_BENCH_COUNT];
+
+/**
+ * @brief Share of a HWA_LOOP_FREQ_HZ loop period one fast path control step takes, at the boot clock
+ *
+ * @values 0..1000 (permille)
+ */
+uint16_t hwa_g_StepPermille_u16;
+
+/**
+ * @brief Cycles the measurement itself takes
+ *
+ */
+uint32_t hwa_g_OverheadCycles_u32;
+
+/**
+ * @brief Sink for the values read in the benchmark, so the compiler can't drop the reads
+ *
+ */
+volatile uint32_t hwa_g_Sink_u32;
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+void hwa_f_Benchmark_v(void);
+
+void hwa_f_ControlStepHal_v(void);
+void hwa_f_ControlStepFast_v(void);
+
+/**
+ * @brief Measure every operation through the HAL and through the fast path
+ *
+ * To be called once on boot, after clk_f_Init_v() and ana_f_Init_v(), but before mot_f_Init_v(),
+ * as it writes the motor direction pins and compare values
+ *
+ * @return void
+ */
+void hwa_f_Benchmark_v(void)
+{
+  mot_s_MotorConfig_t *l_mot_ps = &mot_s_MotorConfig_s[0];
+  volatile uint32_t *l_ccr_pu32 = hwa_f_CompareReg_pu32(l_mot_ps->tim_ps->Instance, l_mot_ps->channel_u32);
+  uint32_t l_cycles_u32;
+  uint8_t i;
+
+  HWA_BENCH_MIN(hwa_g_OverheadCycles_u32, (void)0);
+
+  HWA_BENCH_MIN(hwa_g_Bench_s[HWA_BENCH_PIN_WRITE].halCycles_u32,
+                HAL_GPIO_WritePin(l_mot_ps->dirPort_ps, l_mot_ps->dirPin_u16, GPIO_PIN_RESET));
+  HWA_BENCH_MIN(hwa_g_Bench_s[HWA_BENCH_PIN_WRITE].fastCycles_u32,
+                hwa_f_PinWrite_v(l_mot_ps->dirPort_ps, l_mot_ps->dirPin_u16, 0));
+
+  HWA_BENCH_MIN(hwa_g_Bench_s[HWA_BENCH_PIN_READ].halCycles_u32,
+                hwa_g_Sink_u32 = HAL_GPIO_ReadPin(l_mot_ps->faultPort_ps, l_mot_ps->faultPin_u16));
+  HWA_BENCH_MIN(hwa_g_Bench_s[HWA_BENCH_PIN_READ].fastCycles_u32,
+                hwa_g_Sink_u32 = hwa_f_PinRead_u8(l_mot_ps->faultPort_ps, l_mot_ps->faultPin_u16));
+
+  HWA_BENCH_MIN(hwa_g_Bench_s[HWA_BENCH_SET_COMPARE].halCycles_u32,
+                __HAL_TIM_SET_COMPARE(l_mot_ps->tim_ps, l_mot_ps->channel_u32, 0));
+  HWA_BENCH_MIN(hwa_g_Bench_s[HWA_BENCH_SET_COMPARE].fastCycles_u32,
+                hwa_f_SetCompare_v(l_ccr_pu32, 0));
+
+  HWA_BENCH_MIN(hwa_g_Bench_s[HWA_BENCH_ANA_READ].halCycles_u32,
+                hwa_g_Sink_u32 = HAL_ADC_GetValue(&hadc1));
+  HWA_BENCH_MIN(hwa_g_Bench_s[HWA_BENCH_ANA_READ].fastCycles_u32,
+                hwa_g_Sink_u32 = hwa_f_AnaRead_u16(pos_c_HallChannel_e[0]));
+
+  HWA_BENCH_MIN(hwa_g_Bench_s[HWA_BENCH_CONTROL_STEP].halCycles_u32, hwa_f_ControlStepHal_v());
+  HWA_BENCH_MIN(hwa_g_Bench_s[HWA_BENCH_CONTROL_STEP].fastCycles_u32, hwa_f_ControlStepFast_v());
+
+  /* A single store can overlap with the counter read, so the result is never taken below 0 */
+  for (i = 0; i < HWA_BENCH_COUNT; i++)
+  {
+    hwa_g_Bench_s[i].halCycles_u32 = (hwa_g_Bench_s[i].halCycles_u32 > hwa_g_OverheadCycles_u32) ? (hwa_g_Bench_s[i].halCycles_u32 - hwa_g_OverheadCycles_u32) : 0;
+    hwa_g_Bench_s[i].fastCycles_u32 = (hwa_g_Bench_s[i].fastCycles_u32 > hwa_g_OverheadCycles_u32) ? (hwa_g_Bench_s[i].fastCycles_u32 - hwa_g_OverheadCycles_u32) : 0;
+  }
+
+  l_cycles_u32 = HAL_RCC_GetHCLKFreq() / HWA_LOOP_FREQ_HZ;
+  hwa_g_StepPermille_u16 = (uint16_t)((hwa_g_Bench_s[HWA_BENCH_CONTROL_STEP].fastCycles_u32 * 1000) / l_cycles_u32);
+
+  mot_f_StopAll_v();
+}
+
+/**
+ * @brief One motor control step for every finger through the HAL, the way mot.c used to do it
+ *
+ * @return void
+ */
+void hwa_f_ControlStepHal_v(void)
+{
+  mot_s_MotorConfig_t *l_mot_ps;
+  uint32_t l_period_u32;
+  int32_t l_duty_s32;
+  uint8_t i;
+
+  for (i = 0; i < MOT_COUNT; i++)
+  {
+    l_mot_ps = &mot_s_MotorConfig_s[i];
+    l_period_u32 = __HAL_TIM_GET_AUTORELOAD(l_mot_ps->tim_ps) + 1;
+
+    hwa_g_Sink_u32 = (HAL_GPIO_ReadPin(l_mot_ps->faultPort_ps, l_mot_ps->faultPin_u16) == GPIO_PIN_RESET);
+    l_duty_s32 = ((int32_t)HAL_ADC_GetValue(&hadc1) - (ANA_MAX_VALUE / 2)) / 2;
+
+    if (l_duty_s32 >= 0)
+    {
+      HAL_GPIO_WritePin(l_mot_ps->dirPort_ps, l_mot_ps->dirPin_u16, GPIO_PIN_RESET);
+      __HAL_TIM_SET_COMPARE(l_mot_ps->tim_ps, l_mot_ps->channel_u32, (l_period_u32 * (uint32_t)l_duty_s32) / MOT_DUTY_MAX);
+    }
+    else
+    {
+      HAL_GPIO_WritePin(l_mot_ps->dirPort_ps, l_mot_ps->dirPin_u16, GPIO_PIN_SET);
+      __HAL_TIM_SET_COMPARE(l_mot_ps->tim_ps, l_mot_ps->channel_u32, l_period_u32 - (l_period_u32 * (uint32_t)(-l_duty_s32)) / MOT_DUTY_MAX);
+    }
+  }
+}
+
+/**
+ * @brief One motor control step for every finger through the fast path
+ *
+ * @return void
+ */
+void hwa_f_ControlStepFast_v(void)
+{
+  uint8_t i;
+
+  mot_f_Handle_v();
+
+  for (i = 0; i < MOT_COUNT; i++)
+  {
+    mot_f_SetDuty_v(i, (int16_t)(((int32_t)hwa_f_AnaRead_u16(pos_c_HallChannel_e[i]) - (ANA_MAX_VALUE / 2)) / 2));
+  }
+}
@@ -0,0 +1,109 @@
+/**
+ * @file irq.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Interrupt priority and timing software component
+ *
+ * All interrupt priorities come from one table in irq_i.h, applied once on boot after the peripherals
+ * are initialised, so whatever the generated code set before, the plan is what runs.
+ *
+ * Every measured interrupt handler calls irq_f_Enter_v() first and irq_f_Exit_v() last,
+ * which time it with the DWT cycle counter (started by clk_f_Init_v()). The worst case is kept per interrupt
+ * and sent to the host by tlm.c. Where the handler knows when its event happened (SysTick),
+ * it also records the entry latency, for the others the probe pin (IRQ_PROBE_ID) allows measuring it with a scope.
+ *
+ * What is covered: the SysTick (execution time and entry latency), the UART4 and RCC interrupts (execution time).
+ * These are the only interrupts that run, the ADC scan interrupt is kept off and its entry stays at 0.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "irq_e.h"
+#include "irq_i.h"
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Timing of every measured interrupt
+ *
+ * @values indexed by irq_Id_e
+ */
+irq_s_Stats_t irq_g_Stats_s[IRQ_ID_COUNT];
+
+/**
+ * @brief Cycle counter at the entry of the running instance of every interrupt
+ *
+ */
+uint32_t irq_g_EntryCycles_u32[IRQ_ID_COUNT];
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+void irq_f_Init_v(void);
+void irq_f_ResetStats_v(void);
+
+/**
+ * @brief Initialise function to be called once on boot, after all MX_..._Init() functions
+ *
+ * Apply the priority grouping and the priority of every interrupt in the plan.
+ * The SysTick priority goes through HAL_InitTick(), as the HAL sets it again on every clock change
+ *
+ * @return void
+ */
+void irq_f_Init_v(void)
+{
+  uint8_t i;
+
+  HAL_NVIC_SetPriorityGrouping(IRQ_PRIORITY_GROUP);
+
+  for (i = 0; i < IRQ_PRIORITY_COUNT; i++)
+  {
+    if (irq_s_PriorityConfig_s[i].irq_e == SysTick_IRQn)
+    {
+      if (HAL_InitTick(irq_s_PriorityConfig_s[i].preempt_u8) != HAL_OK)
+      {
+        Error_Handler();
+      }
+    }
+    else
+    {
+      HAL_NVIC_SetPriority(irq_s_PriorityConfig_s[i].irq_e, irq_s_PriorityConfig_s[i].preempt_u8, irq_s_PriorityConfig_s[i].sub_u8);
+    }
+  }
+}
+
+/**
+ * @brief Clear the timing of all interrupts, to measure the worst case of a new situation
+ *
+ * @return void
+ */
+void irq_f_ResetStats_v(void)
+{
+  uint32_t l_primask_u32 = __get_PRIMASK();
+  uint8_t i;
+
+  __disable_irq();
+
+  for (i = 0; i < IRQ_ID_COUNT; i++)
+  {
+    irq_g_Stats_s[i].count_u32 = 0;
+    irq_g_Stats_s[i].lastCycles_u32 = 0;
+    irq_g_Stats_s[i].maxCycles_u32 = 0;
+    irq_g_Stats_s[i].maxLatency_u32 = 0;
+  }
+
+  __set_PRIMASK(l_primask_u32);
+}
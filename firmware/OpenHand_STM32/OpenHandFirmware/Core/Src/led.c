@@ -0,0 +1,319 @@
+/**
+ * @file led.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief LED status pattern software component
+ *
+ * The rest of the firmware only requests a pattern for an LED (led_f_SetPattern_v()), which is a single store.
+ * The patterns are played from SysTick, every millisecond each LED counts down to its next step,
+ * so nothing here runs in the main loop and nothing ever waits.
+ *
+ * LED_02 sits on TIM4_CH1, so its brightness is set by the hardware PWM and it can breathe or show a level.
+ * LED_01 has no timer on its pin and is only switched on and off. When the interrupt probe is set to LED_02
+ * (see IRQ_PROBE_ID), the pin is handed back to the probe and this module leaves it alone.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "led_e.h"
+#include "led_i.h"
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Pattern requested for every LED, pattern in the high byte and its argument in the low byte
+ *
+ * @values indexed by led_Id_e
+ */
+volatile uint16_t led_g_Request_u16[LED_ID_COUNT];
+
+/**
+ * @brief What every LED is playing right now
+ *
+ */
+led_s_LedState_t led_g_State_s[LED_ID_COUNT];
+
+/**
+ * @brief Compare register of every dimmable LED, NULL for an on/off LED
+ *
+ */
+volatile uint32_t *led_g_Compare_pu32[LED_ID_COUNT];
+
+/**
+ * @brief Whether SysTick may drive the LEDs, set once they are set up
+ *
+ * @values 0 - not yet, 1 - ready
+ */
+volatile uint8_t led_g_Ready_u8;
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+void led_f_Init_v(void);
+void led_f_Tick_v(void);
+void led_f_SetPattern_v(led_Id_e led, led_Pattern_e pattern, uint8_t arg);
+void led_f_UpdateTiming_v(void);
+
+uint16_t led_f_NextStep_u16(led_s_LedState_t *state);
+void led_f_SetLevel_v(led_Id_e led, uint16_t level);
+
+/**
+ * @brief Initialise function to be called once on boot, after MX_TIM4_Init() and irq_f_Init_v()
+ *
+ * Start the PWM of the dimmable LEDs, all LEDs start off
+ *
+ * @return void
+ */
+void led_f_Init_v(void)
+{
+  led_s_LedConfig_t *l_cfg_ps;
+  GPIO_InitTypeDef l_pin_s = {0};
+  uint8_t i;
+
+  for (i = 0; i < LED_ID_COUNT; i++)
+  {
+    l_cfg_ps = &led_s_LedConfig_s[i];
+    led_g_Request_u16[i] = (uint16_t)LED_PATTERN_OFF << 8;
+    led_g_State_s[i].request_u16 = led_g_Request_u16[i];
+    led_g_State_s[i].enabled_u8 = 1;
+    led_g_Compare_pu32[i] = NULL;
+
+    if ((IRQ_PROBE_ID != IRQ_ID_COUNT) && (l_cfg_ps->port_ps == IRQ_PROBE_PORT) && (l_cfg_ps->pin_u16 == IRQ_PROBE_PIN))
+    {
+      /* The probe writes the pin directly, which only works with the pin as a plain output */
+      l_pin_s.Pin = l_cfg_ps->pin_u16;
+      l_pin_s.Mode = GPIO_MODE_OUTPUT_PP;
+      l_pin_s.Pull = GPIO_NOPULL;
+      l_pin_s.Speed = GPIO_SPEED_FREQ_LOW;
+      HAL_GPIO_Init(l_cfg_ps->port_ps, &l_pin_s);
+      led_g_State_s[i].enabled_u8 = 0;
+    }
+    else if (l_cfg_ps->tim_ps != NULL)
+    {
+      led_g_Compare_pu32[i] = hwa_f_CompareReg_pu32(l_cfg_ps->tim_ps->Instance, l_cfg_ps->channel_u32);
+      HAL_TIM_PWM_Start(l_cfg_ps->tim_ps, l_cfg_ps->channel_u32);
+    }
+
+    if (led_g_State_s[i].enabled_u8)
+    {
+      led_f_SetLevel_v(i, 0);
+    }
+  }
+
+  led_f_UpdateTiming_v();
+
+  led_g_Ready_u8 = 1;
+}
+
+/**
+ * @brief Plays the patterns, to be called from SysTick every millisecond
+ *
+ * Most ticks only count down, an LED is only written when its pattern moves on to the next step
+ *
+ * @return void
+ */
+void led_f_Tick_v(void)
+{
+  led_s_LedState_t *l_state_ps;
+  uint16_t l_request_u16;
+  uint16_t l_level_u16;
+  uint8_t i;
+
+  if (!led_g_Ready_u8)
+  {
+    return;
+  }
+
+  for (i = 0; i < LED_ID_COUNT; i++)
+  {
+    l_state_ps = &led_g_State_s[i];
+    if (!l_state_ps->enabled_u8)
+    {
+      continue;
+    }
+
+    /* A new request starts from its first step right away */
+    l_request_u16 = led_g_Request_u16[i];
+    if (l_request_u16 != l_state_ps->request_u16)
+    {
+      l_state_ps->request_u16 = l_request_u16;
+      l_state_ps->step_u16 = 0;
+      l_state_ps->waitMs_u16 = 0;
+    }
+
+    if (l_state_ps->waitMs_u16 > 0)
+    {
+      l_state_ps->waitMs_u16--;
+    }
+
+    if (l_state_ps->waitMs_u16 == 0)
+    {
+      l_level_u16 = l_state_ps->level_u16;
+      l_state_ps->waitMs_u16 = led_f_NextStep_u16(l_state_ps);
+
+      if (l_state_ps->level_u16 != l_level_u16)
+      {
+        led_f_SetLevel_v(i, l_state_ps->level_u16);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Request a pattern for an LED
+ *
+ * Only stores the request, so it is cheap enough to call every millisecond with the same pattern,
+ * an LED only starts over when the pattern or its argument change
+ *
+ * @param led - which LED
+ * @param pattern - pattern to play
+ * @param arg - argument of the pattern (see led_Pattern_e), ignored by patterns without one
+ *
+ * @return void
+ */
+void led_f_SetPattern_v(led_Id_e led, led_Pattern_e pattern, uint8_t arg)
+{
+  if (pattern == LED_PATTERN_CODE)
+  {
+    arg = (arg < 1) ? 1 : ((arg > LED_CODE_MAX) ? LED_CODE_MAX : arg);
+  }
+  else if (pattern == LED_PATTERN_LEVEL)
+  {
+    arg = (arg > 100) ? 100 : arg;
+  }
+  else
+  {
+    arg = 0;
+  }
+
+  led_g_Request_u16[led] = ((uint16_t)pattern << 8) | arg;
+}
+
+/**
+ * @brief Set up the PWM of the dimmable LEDs for the current clock, to be called after every clock switch
+ *
+ * One PWM period is LED_LEVEL_MAX timer counts, so a compare value is the brightness itself
+ *
+ * @return void
+ */
+void led_f_UpdateTiming_v(void)
+{
+  uint32_t l_timClk_u32;
+  uint8_t i;
+
+  /* TIM4 hangs on APB1, which doubles its clock for the timers whenever it is divided */
+  l_timClk_u32 = HAL_RCC_GetPCLK1Freq();
+  if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1)
+  {
+    l_timClk_u32 *= 2;
+  }
+
+  for (i = 0; i < LED_ID_COUNT; i++)
+  {
+    if (led_g_Compare_pu32[i] != NULL)
+    {
+      __HAL_TIM_SET_AUTORELOAD(led_s_LedConfig_s[i].tim_ps, LED_LEVEL_MAX - 1);
+      __HAL_TIM_SET_PRESCALER(led_s_LedConfig_s[i].tim_ps, (l_timClk_u32 / (LED_PWM_FREQ_HZ * LED_LEVEL_MAX)) - 1);
+    }
+  }
+}
+
+/**
+ * @brief Work out the next step of the pattern an LED plays
+ *
+ * @param state - LED state, its level and step are updated
+ *
+ * @return uint16_t - how long the step lasts, in milliseconds
+ */
+uint16_t led_f_NextStep_u16(led_s_LedState_t *state)
+{
+  led_Pattern_e l_pattern_e = (led_Pattern_e)(state->request_u16 >> 8);
+  uint8_t l_arg_u8 = (uint8_t)state->request_u16;
+  uint16_t l_step_u16 = state->step_u16;
+  uint32_t l_ramp_u32;
+  uint16_t l_wait_u16;
+
+  switch (l_pattern_e)
+  {
+  case LED_PATTERN_ON:
+    state->level_u16 = LED_LEVEL_MAX;
+    l_wait_u16 = LED_HOLD_MS;
+    break;
+
+  case LED_PATTERN_BLINK_SLOW:
+  case LED_PATTERN_BLINK_FAST:
+    state->level_u16 = (l_step_u16 == 0) ? LED_LEVEL_MAX : 0;
+    state->step_u16 = (l_step_u16 + 1) % 2;
+    l_wait_u16 = (l_pattern_e == LED_PATTERN_BLINK_SLOW) ? LED_BLINK_SLOW_MS : LED_BLINK_FAST_MS;
+    break;
+
+  case LED_PATTERN_BREATHE:
+    /* Up and down in a triangle, squared as the eye is far more sensitive to changes in the dark */
+    l_ramp_u32 = (l_step_u16 < LED_BREATHE_STEPS) ? l_step_u16 : ((2 * LED_BREATHE_STEPS) - l_step_u16);
+    state->level_u16 = (uint16_t)((l_ramp_u32 * l_ramp_u32 * LED_LEVEL_MAX) / (LED_BREATHE_STEPS * LED_BREATHE_STEPS));
+    state->step_u16 = (l_step_u16 + 1) % (2 * LED_BREATHE_STEPS);
+    l_wait_u16 = LED_RAMP_MS;
+    break;
+
+  case LED_PATTERN_CODE:
+    /* Even steps are the flashes, the odd step after the last flash is the pause */
+    if ((l_step_u16 % 2) == 0)
+    {
+      state->level_u16 = LED_LEVEL_MAX;
+      l_wait_u16 = LED_CODE_ON_MS;
+    }
+    else
+    {
+      state->level_u16 = 0;
+      l_wait_u16 = (l_step_u16 == ((2 * l_arg_u8) - 1)) ? LED_CODE_PAUSE_MS : LED_CODE_OFF_MS;
+    }
+    state->step_u16 = (l_step_u16 + 1) % (2 * l_arg_u8);
+    break;
+
+  case LED_PATTERN_LEVEL:
+    state->level_u16 = l_arg_u8 * (LED_LEVEL_MAX / 100);
+    l_wait_u16 = LED_HOLD_MS;
+    break;
+
+  case LED_PATTERN_OFF:
+  default:
+    state->level_u16 = 0;
+    l_wait_u16 = LED_HOLD_MS;
+    break;
+  }
+
+  return l_wait_u16;
+}
+
+/**
+ * @brief Set the brightness of an LED, an on/off LED is on from half brightness
+ *
+ * @param led - which LED
+ * @param level - brightness, 0..LED_LEVEL_MAX
+ *
+ * @return void
+ */
+void led_f_SetLevel_v(led_Id_e led, uint16_t level)
+{
+  if (led_g_Compare_pu32[led] != NULL)
+  {
+    hwa_f_SetCompare_v(led_g_Compare_pu32[led], level);
+  }
+  else
+  {
+    hwa_f_PinWrite_v(led_s_LedConfig_s[led].port_ps, led_s_LedConfig_s[led].pin_u16, level >= (LED_LEVEL_MAX / 2));
+  }
+}
@@ -0,0 +1,216 @@
+/**
+ * @file mem.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Fixed block memory pool software component
+ *
+ * Every pool is a statically reserved array of equally sized blocks, the free ones are chained in a list
+ * through their own first word. Allocating pops the head of the list and freeing pushes the block back,
+ * both take the same few cycles no matter how full the pool is and can't fragment memory.
+ * One bit per block tells whether it is handed out, so a block freed twice is counted instead of
+ * ending up on the list twice and being handed out to two owners.
+ * Both can be called from interrupts, the list is only touched with interrupts off.
+ *
+ * The C library heap (_sbrk() in sysmem.c) is closed once the system is initialised,
+ * so anything that still calls malloc at runtime fails visibly instead of slowly eating into the stack.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "mem_e.h"
+#include "mem_i.h"
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Usage statistics of every pool
+ *
+ * @values indexed by mem_Pool_e
+ */
+mem_s_PoolStats_t mem_g_Stats_s[MEM_POOL_COUNT];
+
+/**
+ * @brief Whether the C library heap is closed, from then on every malloc fails
+ *
+ * @values 0 - open, 1 - closed
+ */
+uint8_t mem_g_HeapLocked_u8;
+
+/**
+ * @brief How many heap requests were refused after the heap was closed
+ *
+ */
+uint32_t mem_g_HeapRejectCnt_u32;
+
+/**
+ * @brief Memory of every pool, reserved at link time
+ *
+ */
+uint32_t mem_g_FrameStorage_u32[(MEM_FRAME_SIZE / 4) * MEM_FRAME_COUNT];
+
+/**
+ * @brief Which blocks of every pool are handed out, so freeing one twice is caught
+ *
+ */
+uint32_t mem_g_FrameInUse_u32[MEM_IN_USE_WORDS(MEM_FRAME_COUNT)];
+
+/**
+ * @brief First free block of every pool, each free block holds the address of the next one
+ *
+ */
+void *mem_g_FreeHead_pv[MEM_POOL_COUNT];
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+void mem_f_Init_v(void);
+void mem_f_LockHeap_v(void);
+void *mem_f_Alloc_pv(mem_Pool_e pool);
+void mem_f_Free_v(mem_Pool_e pool, void *block);
+
+/**
+ * @brief Initialise function to be called once on boot, before any other module allocates
+ *
+ * Chain all blocks of every pool into its free list
+ *
+ * @return void
+ */
+void mem_f_Init_v(void)
+{
+  uint8_t i;
+  uint16_t j;
+  uint8_t *l_block_pu8;
+  mem_s_PoolConfig_t *l_cfg_ps;
+
+  for (i = 0; i < MEM_POOL_COUNT; i++)
+  {
+    l_cfg_ps = &mem_s_PoolConfig_s[i];
+    l_block_pu8 = (uint8_t *)l_cfg_ps->storage_pu32;
+
+    for (j = 0; j < (l_cfg_ps->blockCount_u16 - 1); j++)
+    {
+      *(void **)l_block_pu8 = l_block_pu8 + l_cfg_ps->blockSize_u16;
+      l_block_pu8 += l_cfg_ps->blockSize_u16;
+    }
+    *(void **)l_block_pu8 = NULL;
+
+    mem_g_FreeHead_pv[i] = l_cfg_ps->storage_pu32;
+  }
+}
+
+/**
+ * @brief Close the C library heap, to be called once all modules are initialised
+ *
+ * @return void
+ */
+void mem_f_LockHeap_v(void)
+{
+  mem_g_HeapLocked_u8 = 1;
+}
+
+/**
+ * @brief Take a block from a pool
+ *
+ * @param pool - which pool
+ *
+ * @return void* - block of the pool's block size, word aligned, or NULL if the pool is empty
+ */
+void *mem_f_Alloc_pv(mem_Pool_e pool)
+{
+  mem_s_PoolConfig_t *l_cfg_ps = &mem_s_PoolConfig_s[pool];
+  uint32_t l_primask_u32 = __get_PRIMASK();
+  uint32_t l_index_u32;
+  void *l_block_pv;
+
+  __disable_irq();
+
+  l_block_pv = mem_g_FreeHead_pv[pool];
+  if (l_block_pv != NULL)
+  {
+    mem_g_FreeHead_pv[pool] = *(void **)l_block_pv;
+
+    l_index_u32 = (uint32_t)((uint8_t *)l_block_pv - (uint8_t *)l_cfg_ps->storage_pu32) / l_cfg_ps->blockSize_u16;
+    l_cfg_ps->inUse_pu32[l_index_u32 / 32] |= (1UL << (l_index_u32 % 32));
+
+    mem_g_Stats_s[pool].used_u16++;
+    if (mem_g_Stats_s[pool].used_u16 > mem_g_Stats_s[pool].highWater_u16)
+    {
+      mem_g_Stats_s[pool].highWater_u16 = mem_g_Stats_s[pool].used_u16;
+    }
+  }
+  else
+  {
+    mem_g_Stats_s[pool].failCnt_u32++;
+  }
+
+  __set_PRIMASK(l_primask_u32);
+
+  return l_block_pv;
+}
+
+/**
+ * @brief Give a block back to its pool
+ *
+ * A pointer that doesn't point to the start of a block of this pool is only counted, not freed,
+ * as putting it on the list would hand out memory that isn't the pool's.
+ * So is a block that is already free, it would be on the list twice and handed out twice
+ *
+ * @param pool - pool the block was taken from
+ * @param block - block returned by mem_f_Alloc_pv(), NULL is ignored
+ *
+ * @return void
+ */
+void mem_f_Free_v(mem_Pool_e pool, void *block)
+{
+  mem_s_PoolConfig_t *l_cfg_ps = &mem_s_PoolConfig_s[pool];
+  uint32_t l_offset_u32 = (uint32_t)((uint8_t *)block - (uint8_t *)l_cfg_ps->storage_pu32);
+  uint32_t l_index_u32;
+  uint32_t l_mask_u32;
+  uint32_t l_primask_u32;
+
+  if (block == NULL)
+  {
+    return;
+  }
+
+  /* A pointer below the storage wraps around to a huge offset */
+  if ((l_offset_u32 >= ((uint32_t)l_cfg_ps->blockSize_u16 * l_cfg_ps->blockCount_u16)) ||
+      ((l_offset_u32 % l_cfg_ps->blockSize_u16) != 0))
+  {
+    mem_g_Stats_s[pool].badFreeCnt_u32++;
+    return;
+  }
+
+  l_index_u32 = l_offset_u32 / l_cfg_ps->blockSize_u16;
+  l_mask_u32 = 1UL << (l_index_u32 % 32);
+
+  l_primask_u32 = __get_PRIMASK();
+  __disable_irq();
+
+  if ((l_cfg_ps->inUse_pu32[l_index_u32 / 32] & l_mask_u32) == 0)
+  {
+    mem_g_Stats_s[pool].badFreeCnt_u32++;
+  }
+  else
+  {
+    l_cfg_ps->inUse_pu32[l_index_u32 / 32] &= ~l_mask_u32;
+    *(void **)block = mem_g_FreeHead_pv[pool];
+    mem_g_FreeHead_pv[pool] = block;
+    mem_g_Stats_s[pool].used_u16--;
+  }
+
+  __set_PRIMASK(l_primask_u32);
+}
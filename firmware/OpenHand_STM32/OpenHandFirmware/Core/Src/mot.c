@@ -0,0 +1,304 @@
+/**
+ * @file mot.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Finger motor software component / driver
+ *
+ * Each finger is moved by a DC motor on its own DRV8833 bridge, driven by one timer PWM channel
+ * and a direction pin. Other modules only request a signed duty cycle, this module turns it into
+ * the compare value and direction, and watches the fault outputs of the bridges.
+ * Everything that runs every control step goes straight to the registers (see hwa_e.h).
+ *
+ * After every change it also tells ana.c which turning point of the PWM cycle is further
+ * from the switching edges of all motors, so the analog inputs are read there.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "mot_e.h"
+#include "mot_i.h"
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Last duty cycle requested for each motor
+ *
+ * @values -MOT_DUTY_MAX..MOT_DUTY_MAX
+ */
+int16_t mot_g_Duty_s16[MOT_COUNT];
+
+/**
+ * @brief Whether the DRV8833 of the motor reports a fault (over-current, over-temperature)
+ *
+ * @values 0 - ok, 1 - fault
+ */
+uint8_t mot_g_Fault_u8[MOT_COUNT];
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+void mot_f_Init_v(void);
+void mot_f_Handle_v(void);
+void mot_f_SetDuty_v(uint8_t motorIndex, int16_t duty);
+void mot_f_StopAll_v(void);
+void mot_f_UpdateTiming_v(void);
+void mot_f_PauseTimers_v(void);
+void mot_f_ReloadTimers_v(void);
+void mot_f_ResumeTimers_v(void);
+
+void mot_f_UpdateQuietPhase_v(void);
+uint32_t mot_f_TimerClock_u32(TIM_HandleTypeDef *tim);
+
+/**
+ * @brief Initialise function to be called once on boot, after the timers are initialised
+ *
+ * Start all PWM channels with the motors stopped, then wake up the bridges.
+ * TIM3 is a trigger slave of TIM1, so its counter only starts together with TIM1, and both start counting up
+ *
+ * @return void
+ */
+void mot_f_Init_v(void)
+{
+  uint8_t i;
+
+  mot_f_UpdateTiming_v();
+
+  for (i = 0; i < MOT_COUNT; i++)
+  {
+    mot_f_SetDuty_v(i, 0);
+
+    if (HAL_TIM_PWM_Start(mot_s_MotorConfig_s[i].tim_ps, mot_s_MotorConfig_s[i].channel_u32) != HAL_OK)
+    {
+      Error_Handler();
+    }
+
+    HAL_GPIO_WritePin(mot_s_MotorConfig_s[i].enPort_ps, mot_s_MotorConfig_s[i].enPin_u16, GPIO_PIN_SET);
+  }
+}
+
+/**
+ * @brief Handle function to be called cyclically
+ *
+ * Read the fault outputs of all bridges
+ *
+ * @return void
+ */
+void mot_f_Handle_v(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < MOT_COUNT; i++)
+  {
+    mot_g_Fault_u8[i] = !hwa_f_PinRead_u8(mot_s_MotorConfig_s[i].faultPort_ps, mot_s_MotorConfig_s[i].faultPin_u16);
+  }
+}
+
+/**
+ * @brief Set the duty cycle of one motor
+ *
+ * @param motorIndex - which motor, 0..MOT_COUNT - 1
+ * @param duty - positive closes, negative opens, 0 coasts; clamped to -MOT_DUTY_MAX..MOT_DUTY_MAX
+ *
+ * @return void
+ */
+void mot_f_SetDuty_v(uint8_t motorIndex, int16_t duty)
+{
+  mot_s_MotorConfig_t *l_cfg_ps = &mot_s_MotorConfig_s[motorIndex];
+  uint32_t l_period_u32 = l_cfg_ps->tim_ps->Instance->ARR + 1;
+  uint32_t l_compare_u32;
+
+  if (duty > MOT_DUTY_MAX)
+  {
+    duty = MOT_DUTY_MAX;
+  }
+  else if (duty < -MOT_DUTY_MAX)
+  {
+    duty = -MOT_DUTY_MAX;
+  }
+
+  mot_g_Duty_s16[motorIndex] = duty;
+
+  if (duty >= 0)
+  {
+    /* Forward: drive while PWM is high, coast while it is low */
+    l_compare_u32 = (l_period_u32 * (uint32_t)duty) / MOT_DUTY_MAX;
+    hwa_f_PinWrite_v(l_cfg_ps->dirPort_ps, l_cfg_ps->dirPin_u16, 0);
+  }
+  else
+  {
+    /* Reverse: drive while PWM is low, brake while it is high */
+    l_compare_u32 = l_period_u32 - (l_period_u32 * (uint32_t)(-duty)) / MOT_DUTY_MAX;
+    hwa_f_PinWrite_v(l_cfg_ps->dirPort_ps, l_cfg_ps->dirPin_u16, 1);
+  }
+
+  hwa_f_SetCompare_v(hwa_f_CompareReg_pu32(l_cfg_ps->tim_ps->Instance, l_cfg_ps->channel_u32), l_compare_u32);
+
+  mot_f_UpdateQuietPhase_v();
+}
+
+/**
+ * @brief Stop (coast) all motors
+ *
+ * @return void
+ */
+void mot_f_StopAll_v(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < MOT_COUNT; i++)
+  {
+    mot_f_SetDuty_v(i, 0);
+  }
+}
+
+/**
+ * @brief Recompute the timer periods for the current system clock, to be called after every clock change
+ *
+ * Both timers keep MOT_PWM_FREQ_HZ and the same period, so they stay in phase,
+ * and all duty cycles are applied again at the new resolution.
+ * The auto-reload and compare registers are preloaded, so the new values take effect together at the next update
+ *
+ * @return void
+ */
+void mot_f_UpdateTiming_v(void)
+{
+  uint8_t i;
+
+  /* Center-aligned: the counter goes up and down once per PWM cycle */
+  __HAL_TIM_SET_AUTORELOAD(&htim1, (mot_f_TimerClock_u32(&htim1) / (2 * MOT_PWM_FREQ_HZ)) - 1);
+  __HAL_TIM_SET_AUTORELOAD(&htim3, (mot_f_TimerClock_u32(&htim3) / (2 * MOT_PWM_FREQ_HZ)) - 1);
+
+  for (i = 0; i < MOT_COUNT; i++)
+  {
+    mot_f_SetDuty_v(i, mot_g_Duty_s16[i]);
+  }
+}
+
+/**
+ * @brief Stop both PWM timers where they are, for a clock switch
+ *
+ * The outputs hold their level until mot_f_ResumeTimers_v(), the switch takes a few hundred microseconds at most
+ *
+ * @return void
+ */
+void mot_f_PauseTimers_v(void)
+{
+  htim1.Instance->CR1 &= ~TIM_CR1_CEN;
+  htim3.Instance->CR1 &= ~TIM_CR1_CEN;
+}
+
+/**
+ * @brief Load the periods of mot_f_UpdateTiming_v() into both stopped PWM timers and clear their counters
+ *
+ * The update event loads the preloaded periods and compare values. TIM3 sends it to the ADC as a trigger,
+ * so the scans have to be stopped while it is generated, or it starts a scan the timers never asked for
+ * and the DMA ends up one phase off
+ *
+ * @return void
+ */
+void mot_f_ReloadTimers_v(void)
+{
+  htim1.Instance->EGR = TIM_EGR_UG;
+  htim3.Instance->EGR = TIM_EGR_UG;
+  __HAL_TIM_CLEAR_FLAG(&htim1, TIM_FLAG_UPDATE);
+  __HAL_TIM_CLEAR_FLAG(&htim3, TIM_FLAG_UPDATE);
+}
+
+/**
+ * @brief Start both PWM timers again from 0, in phase, after mot_f_ReloadTimers_v()
+ *
+ * Starting TIM1 starts TIM3 (trigger slave), and the first turning point of both is the top, like at boot,
+ * so the first trigger the ADC gets is ANA_PHASE_PEAK
+ *
+ * @return void
+ */
+void mot_f_ResumeTimers_v(void)
+{
+  htim1.Instance->CR1 |= TIM_CR1_CEN;
+}
+
+/**
+ * @brief Choose the turning point of the PWM cycle that is furthest from any switching edge
+ *
+ * In center-aligned PWM mode 1 an output switches when the counter passes its compare value,
+ * so its edges are compare counts away from the bottom and period - compare counts away from the top.
+ * Outputs that are fully off or fully on never switch and don't count
+ *
+ * @return void
+ */
+void mot_f_UpdateQuietPhase_v(void)
+{
+  uint8_t i;
+  uint32_t l_period_u32;
+  uint32_t l_compare_u32;
+  uint32_t l_troughMargin_u32 = UINT32_MAX;
+  uint32_t l_peakMargin_u32 = UINT32_MAX;
+
+  for (i = 0; i < MOT_COUNT; i++)
+  {
+    l_period_u32 = mot_s_MotorConfig_s[i].tim_ps->Instance->ARR + 1;
+    l_compare_u32 = *hwa_f_CompareReg_pu32(mot_s_MotorConfig_s[i].tim_ps->Instance, mot_s_MotorConfig_s[i].channel_u32);
+
+    if ((l_compare_u32 == 0) || (l_compare_u32 >= l_period_u32))
+    {
+      continue;
+    }
+
+    if (l_compare_u32 < l_troughMargin_u32)
+    {
+      l_troughMargin_u32 = l_compare_u32;
+    }
+    if ((l_period_u32 - l_compare_u32) < l_peakMargin_u32)
+    {
+      l_peakMargin_u32 = l_period_u32 - l_compare_u32;
+    }
+  }
+
+  ana_f_SetQuietPhase_v((l_troughMargin_u32 > l_peakMargin_u32) ? ANA_PHASE_TROUGH : ANA_PHASE_PEAK);
+}
+
+/**
+ * @brief Clock the timer counts with
+ *
+ * TIM1 is on APB2, TIM3 on APB1. A timer runs at twice its bus clock whenever that bus is divided down
+ *
+ * @param tim - timer handle
+ *
+ * @return uint32_t - timer clock in Hz
+ */
+uint32_t mot_f_TimerClock_u32(TIM_HandleTypeDef *tim)
+{
+  uint32_t l_clock_u32;
+
+  if (tim->Instance == TIM1)
+  {
+    l_clock_u32 = HAL_RCC_GetPCLK2Freq();
+    if ((RCC->CFGR & RCC_CFGR_PPRE2) != RCC_CFGR_PPRE2_DIV1)
+    {
+      l_clock_u32 *= 2;
+    }
+  }
+  else
+  {
+    l_clock_u32 = HAL_RCC_GetPCLK1Freq();
+    if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1)
+    {
+      l_clock_u32 *= 2;
+    }
+  }
+
+  return l_clock_u32;
+}
@@ -0,0 +1,422 @@
+/**
+ * @file msg.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Telemetry message packers and unpackers
+ *
+ * Generated from firmware/msg/messages.py by firmware/msg/msggen.py, do not edit
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "msg_e.h"
+#include "msg_i.h"
+
+#include "string.h"
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+uint8_t msg_f_PackUpdBegin_u8(uint8_t *buf, const msg_s_UpdBegin_t *msg);
+uint8_t msg_f_UnpackUpdBegin_u8(msg_s_UpdBegin_t *msg, const uint8_t *buf, uint8_t len);
+uint8_t msg_f_PackUpdData_u8(uint8_t *buf, const msg_s_UpdData_t *msg);
+uint8_t msg_f_UnpackUpdData_u8(msg_s_UpdData_t *msg, const uint8_t *buf, uint8_t len);
+uint8_t msg_f_PackTsyReq_u8(uint8_t *buf, const msg_s_TsyReq_t *msg);
+uint8_t msg_f_UnpackTsyReq_u8(msg_s_TsyReq_t *msg, const uint8_t *buf, uint8_t len);
+uint8_t msg_f_PackIrqStats_u8(uint8_t *buf, const msg_s_IrqStats_t *msg);
+uint8_t msg_f_UnpackIrqStats_u8(msg_s_IrqStats_t *msg, const uint8_t *buf, uint8_t len);
+uint8_t msg_f_PackUpdReply_u8(uint8_t *buf, const msg_s_UpdReply_t *msg);
+uint8_t msg_f_UnpackUpdReply_u8(msg_s_UpdReply_t *msg, const uint8_t *buf, uint8_t len);
+uint8_t msg_f_PackTsyResp_u8(uint8_t *buf, const msg_s_TsyResp_t *msg);
+uint8_t msg_f_UnpackTsyResp_u8(msg_s_TsyResp_t *msg, const uint8_t *buf, uint8_t len);
+uint8_t msg_f_PackTsyStats_u8(uint8_t *buf, const msg_s_TsyStats_t *msg);
+uint8_t msg_f_UnpackTsyStats_u8(msg_s_TsyStats_t *msg, const uint8_t *buf, uint8_t len);
+
+uint8_t msg_f_PutU16_u8(uint8_t *buf, uint8_t idx, uint16_t val);
+uint8_t msg_f_PutU32_u8(uint8_t *buf, uint8_t idx, uint32_t val);
+uint8_t msg_f_PutU64_u8(uint8_t *buf, uint8_t idx, uint64_t val);
+uint16_t msg_f_GetU16_u16(const uint8_t *buf);
+uint32_t msg_f_GetU32_u32(const uint8_t *buf);
+uint64_t msg_f_GetU64_u64(const uint8_t *buf);
+
+/**
+ * @brief Write UPD_BEGIN into a payload
+ *
+ * @param buf - payload, room for MSG_UPD_BEGIN_LEN bytes
+ * @param msg - message to write
+ *
+ * @return uint8_t - payload length
+ */
+uint8_t msg_f_PackUpdBegin_u8(uint8_t *buf, const msg_s_UpdBegin_t *msg)
+{
+  uint8_t l_idx_u8 = 0;
+
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->size_u32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->crc_u32);
+
+  return l_idx_u8;
+}
+
+/**
+ * @brief Read UPD_BEGIN out of a payload
+ *
+ * @param msg - message to fill
+ * @param buf - payload
+ * @param len - payload length
+ *
+ * @return uint8_t - 1 if the payload holds at least MSG_UPD_BEGIN_MIN_LEN bytes, 0 if not
+ */
+uint8_t msg_f_UnpackUpdBegin_u8(msg_s_UpdBegin_t *msg, const uint8_t *buf, uint8_t len)
+{
+  if (len < MSG_UPD_BEGIN_MIN_LEN)
+  {
+    return 0;
+  }
+
+  msg->size_u32 = msg_f_GetU32_u32(&buf[0]);
+  msg->crc_u32 = msg_f_GetU32_u32(&buf[4]);
+
+  return 1;
+}
+
+/**
+ * @brief Write UPD_DATA into a payload
+ *
+ * @param buf - payload, room for MSG_UPD_DATA_LEN bytes plus the bytes
+ * @param msg - message to write
+ *
+ * @return uint8_t - payload length
+ */
+uint8_t msg_f_PackUpdData_u8(uint8_t *buf, const msg_s_UpdData_t *msg)
+{
+  uint8_t l_idx_u8 = 0;
+
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->offset_u32);
+  memcpy(&buf[l_idx_u8], msg->data_pu8, msg->dataLen_u8);
+  l_idx_u8 += msg->dataLen_u8;
+
+  return l_idx_u8;
+}
+
+/**
+ * @brief Read UPD_DATA out of a payload
+ *
+ * @param msg - message to fill
+ * @param buf - payload
+ * @param len - payload length
+ *
+ * @return uint8_t - 1 if the payload holds at least MSG_UPD_DATA_MIN_LEN bytes, 0 if not
+ */
+uint8_t msg_f_UnpackUpdData_u8(msg_s_UpdData_t *msg, const uint8_t *buf, uint8_t len)
+{
+  if (len < MSG_UPD_DATA_MIN_LEN)
+  {
+    return 0;
+  }
+
+  msg->offset_u32 = msg_f_GetU32_u32(&buf[0]);
+  msg->data_pu8 = &buf[4];
+  msg->dataLen_u8 = len - 4;
+
+  return 1;
+}
+
+/**
+ * @brief Write TSY_REQ into a payload
+ *
+ * @param buf - payload, room for MSG_TSY_REQ_LEN bytes
+ * @param msg - message to write
+ *
+ * @return uint8_t - payload length
+ */
+uint8_t msg_f_PackTsyReq_u8(uint8_t *buf, const msg_s_TsyReq_t *msg)
+{
+  uint8_t l_idx_u8 = 0;
+
+  buf[l_idx_u8++] = msg->tag_u8;
+
+  return l_idx_u8;
+}
+
+/**
+ * @brief Read TSY_REQ out of a payload
+ *
+ * @param msg - message to fill
+ * @param buf - payload
+ * @param len - payload length
+ *
+ * @return uint8_t - 1 if the payload holds at least MSG_TSY_REQ_MIN_LEN bytes, 0 if not
+ */
+uint8_t msg_f_UnpackTsyReq_u8(msg_s_TsyReq_t *msg, const uint8_t *buf, uint8_t len)
+{
+  if (len < MSG_TSY_REQ_MIN_LEN)
+  {
+    return 0;
+  }
+
+  msg->tag_u8 = buf[0];
+
+  return 1;
+}
+
+/**
+ * @brief Write IRQ_STATS into a payload
+ *
+ * @param buf - payload, room for MSG_IRQ_STATS_LEN bytes
+ * @param msg - message to write
+ *
+ * @return uint8_t - payload length
+ */
+uint8_t msg_f_PackIrqStats_u8(uint8_t *buf, const msg_s_IrqStats_t *msg)
+{
+  uint8_t l_idx_u8 = 0;
+  uint8_t i;
+
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->cpuHz_u32);
+  for (i = 0; (i < msg->irqsCount_u8) && (i < MSG_IRQ_STATS_IRQS_MAX); i++)
+  {
+    l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->irqs_s[i].count_u32);
+    l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->irqs_s[i].maxCycles_u32);
+    l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->irqs_s[i].maxLatency_u32);
+  }
+
+  return l_idx_u8;
+}
+
+/**
+ * @brief Read IRQ_STATS out of a payload
+ *
+ * @param msg - message to fill
+ * @param buf - payload
+ * @param len - payload length
+ *
+ * @return uint8_t - 1 if the payload holds at least MSG_IRQ_STATS_MIN_LEN bytes, 0 if not
+ */
+uint8_t msg_f_UnpackIrqStats_u8(msg_s_IrqStats_t *msg, const uint8_t *buf, uint8_t len)
+{
+  uint8_t l_pos_u8;
+  uint8_t i;
+
+  if (len < MSG_IRQ_STATS_MIN_LEN)
+  {
+    return 0;
+  }
+
+  msg->cpuHz_u32 = msg_f_GetU32_u32(&buf[0]);
+
+  msg->irqsCount_u8 = (len - MSG_IRQ_STATS_MIN_LEN) / MSG_IRQ_STATS_IRQ_LEN;
+  if (msg->irqsCount_u8 > MSG_IRQ_STATS_IRQS_MAX)
+  {
+    msg->irqsCount_u8 = MSG_IRQ_STATS_IRQS_MAX;
+  }
+  for (i = 0; i < msg->irqsCount_u8; i++)
+  {
+    l_pos_u8 = MSG_IRQ_STATS_MIN_LEN + (i * MSG_IRQ_STATS_IRQ_LEN);
+    msg->irqs_s[i].count_u32 = msg_f_GetU32_u32(&buf[l_pos_u8]);
+    msg->irqs_s[i].maxCycles_u32 = msg_f_GetU32_u32(&buf[l_pos_u8 + 4]);
+    msg->irqs_s[i].maxLatency_u32 = msg_f_GetU32_u32(&buf[l_pos_u8 + 8]);
+  }
+
+  return 1;
+}
+
+/**
+ * @brief Write UPD_REPLY into a payload
+ *
+ * @param buf - payload, room for MSG_UPD_REPLY_LEN bytes
+ * @param msg - message to write
+ *
+ * @return uint8_t - payload length
+ */
+uint8_t msg_f_PackUpdReply_u8(uint8_t *buf, const msg_s_UpdReply_t *msg)
+{
+  uint8_t l_idx_u8 = 0;
+
+  buf[l_idx_u8++] = msg->reqId_u8;
+  buf[l_idx_u8++] = msg->status_u8;
+  buf[l_idx_u8++] = msg->state_u8;
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->next_u32);
+  buf[l_idx_u8++] = msg->image_u8;
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->crc_u32);
+
+  return l_idx_u8;
+}
+
+/**
+ * @brief Read UPD_REPLY out of a payload
+ *
+ * @param msg - message to fill
+ * @param buf - payload
+ * @param len - payload length
+ *
+ * @return uint8_t - 1 if the payload holds at least MSG_UPD_REPLY_MIN_LEN bytes, 0 if not
+ */
+uint8_t msg_f_UnpackUpdReply_u8(msg_s_UpdReply_t *msg, const uint8_t *buf, uint8_t len)
+{
+  if (len < MSG_UPD_REPLY_MIN_LEN)
+  {
+    return 0;
+  }
+
+  msg->reqId_u8 = buf[0];
+  msg->status_u8 = buf[1];
+  msg->state_u8 = buf[2];
+  msg->next_u32 = msg_f_GetU32_u32(&buf[3]);
+  msg->image_u8 = (len >= 8) ? buf[7] : 0;
+  msg->crc_u32 = (len >= 12) ? msg_f_GetU32_u32(&buf[8]) : 0;
+
+  return 1;
+}
+
+/**
+ * @brief Write TSY_RESP into a payload
+ *
+ * @param buf - payload, room for MSG_TSY_RESP_LEN bytes
+ * @param msg - message to write
+ *
+ * @return uint8_t - payload length
+ */
+uint8_t msg_f_PackTsyResp_u8(uint8_t *buf, const msg_s_TsyResp_t *msg)
+{
+  uint8_t l_idx_u8 = 0;
+
+  buf[l_idx_u8++] = msg->tag_u8;
+  l_idx_u8 = msg_f_PutU64_u8(buf, l_idx_u8, msg->rxUs_u64);
+  l_idx_u8 = msg_f_PutU64_u8(buf, l_idx_u8, msg->txUs_u64);
+
+  return l_idx_u8;
+}
+
+/**
+ * @brief Read TSY_RESP out of a payload
+ *
+ * @param msg - message to fill
+ * @param buf - payload
+ * @param len - payload length
+ *
+ * @return uint8_t - 1 if the payload holds at least MSG_TSY_RESP_MIN_LEN bytes, 0 if not
+ */
+uint8_t msg_f_UnpackTsyResp_u8(msg_s_TsyResp_t *msg, const uint8_t *buf, uint8_t len)
+{
+  if (len < MSG_TSY_RESP_MIN_LEN)
+  {
+    return 0;
+  }
+
+  msg->tag_u8 = buf[0];
+  msg->rxUs_u64 = msg_f_GetU64_u64(&buf[1]);
+  msg->txUs_u64 = msg_f_GetU64_u64(&buf[9]);
+
+  return 1;
+}
+
+/**
+ * @brief Write TSY_STATS into a payload
+ *
+ * @param buf - payload, room for MSG_TSY_STATS_LEN bytes
+ * @param msg - message to write
+ *
+ * @return uint8_t - payload length
+ */
+uint8_t msg_f_PackTsyStats_u8(uint8_t *buf, const msg_s_TsyStats_t *msg)
+{
+  uint8_t l_idx_u8 = 0;
+
+  l_idx_u8 = msg_f_PutU64_u8(buf, l_idx_u8, msg->refUs_u64);
+  l_idx_u8 = msg_f_PutU64_u8(buf, l_idx_u8, (uint64_t)msg->offsetUs_s64);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, (uint32_t)msg->driftPpb_s32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->rttUs_u32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->errorUs_u32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->samples_u32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->lost_u32);
+
+  return l_idx_u8;
+}
+
+/**
+ * @brief Read TSY_STATS out of a payload
+ *
+ * @param msg - message to fill
+ * @param buf - payload
+ * @param len - payload length
+ *
+ * @return uint8_t - 1 if the payload holds at least MSG_TSY_STATS_MIN_LEN bytes, 0 if not
+ */
+uint8_t msg_f_UnpackTsyStats_u8(msg_s_TsyStats_t *msg, const uint8_t *buf, uint8_t len)
+{
+  if (len < MSG_TSY_STATS_MIN_LEN)
+  {
+    return 0;
+  }
+
+  msg->refUs_u64 = msg_f_GetU64_u64(&buf[0]);
+  msg->offsetUs_s64 = (int64_t)msg_f_GetU64_u64(&buf[8]);
+  msg->driftPpb_s32 = (int32_t)msg_f_GetU32_u32(&buf[16]);
+  msg->rttUs_u32 = msg_f_GetU32_u32(&buf[20]);
+  msg->errorUs_u32 = msg_f_GetU32_u32(&buf[24]);
+  msg->samples_u32 = msg_f_GetU32_u32(&buf[28]);
+  msg->lost_u32 = msg_f_GetU32_u32(&buf[32]);
+
+  return 1;
+}
+
+/**
+ * @brief Write a value LSB first
+ *
+ * @param buf - payload
+ * @param idx - where to write
+ * @param val - value
+ *
+ * @return uint8_t - index after the value
+ */
+uint8_t msg_f_PutU16_u8(uint8_t *buf, uint8_t idx, uint16_t val)
+{
+  buf[idx++] = (uint8_t)val;
+  buf[idx++] = (uint8_t)(val >> 8);
+  return idx;
+}
+
+uint8_t msg_f_PutU32_u8(uint8_t *buf, uint8_t idx, uint32_t val)
+{
+  idx = msg_f_PutU16_u8(buf, idx, (uint16_t)val);
+  return msg_f_PutU16_u8(buf, idx, (uint16_t)(val >> 16));
+}
+
+uint8_t msg_f_PutU64_u8(uint8_t *buf, uint8_t idx, uint64_t val)
+{
+  idx = msg_f_PutU32_u8(buf, idx, (uint32_t)val);
+  return msg_f_PutU32_u8(buf, idx, (uint32_t)(val >> 32));
+}
+
+/**
+ * @brief Read a value sent LSB first, from any alignment
+ *
+ * @param buf - first byte of the value
+ *
+ * @return the value
+ */
+uint16_t msg_f_GetU16_u16(const uint8_t *buf)
+{
+  return (uint16_t)(buf[0] | ((uint16_t)buf[1] << 8));
+}
+
+uint32_t msg_f_GetU32_u32(const uint8_t *buf)
+{
+  return (uint32_t)msg_f_GetU16_u16(buf) | ((uint32_t)msg_f_GetU16_u16(&buf[2]) << 16);
+}
+
+uint64_t msg_f_GetU64_u64(const uint8_t *buf)
+{
+  return (uint64_t)msg_f_GetU32_u32(buf) | ((uint64_t)msg_f_GetU32_u32(&buf[4]) << 32);
+}
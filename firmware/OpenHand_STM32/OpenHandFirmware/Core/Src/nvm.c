@@ -0,0 +1,173 @@
+/**
+ * @file nvm.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Non-volatile memory software component / driver
+ *
+ * Keeps small records (calibration data and such) in the last pages of the internal flash,
+ * which the linker script keeps free of code. Each record has a header with its layout version,
+ * length and a CRC, so a blank, old or half written page is detected and not used.
+ *
+ * Erasing and programming stalls the CPU for tens of milliseconds, so only store while the motors are stopped.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "nvm_e.h"
+#include "nvm_i.h"
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+uint8_t nvm_f_Load_u8(nvm_Record_e record, void *data, uint16_t len);
+uint8_t nvm_f_Store_u8(nvm_Record_e record, const void *data, uint16_t len);
+
+uint32_t nvm_f_Crc32_u32(const uint8_t *data, uint16_t len);
+
+/**
+ * @brief Read a record from flash
+ *
+ * @param record - which record
+ * @param data - where to copy the record to, left untouched if the record is not valid
+ * @param len - expected length of the record in bytes
+ *
+ * @return uint8_t - 1 if a valid record was read, 0 if it is missing, old or corrupted
+ */
+uint8_t nvm_f_Load_u8(nvm_Record_e record, void *data, uint16_t len)
+{
+  const nvm_s_Header_t *l_header_ps = (const nvm_s_Header_t *)nvm_s_RecordConfig_s[record].address_u32;
+  const uint8_t *l_data_pu8 = (const uint8_t *)(l_header_ps + 1);
+  uint16_t i;
+
+  if ((l_header_ps->magic_u32 != NVM_MAGIC) ||
+      (l_header_ps->version_u16 != nvm_s_RecordConfig_s[record].version_u16) ||
+      (l_header_ps->len_u16 != len) ||
+      (l_header_ps->crc_u32 != nvm_f_Crc32_u32(l_data_pu8, len)))
+  {
+    return 0;
+  }
+
+  for (i = 0; i < len; i++)
+  {
+    ((uint8_t *)data)[i] = l_data_pu8[i];
+  }
+
+  return 1;
+}
+
+/**
+ * @brief Erase the page of a record and write new content to it
+ *
+ * @param record - which record
+ * @param data - new content
+ * @param len - length of the content in bytes, header included it has to fit into one flash page
+ *
+ * @return uint8_t - 1 if the record was written and reads back correctly, 0 otherwise
+ */
+uint8_t nvm_f_Store_u8(nvm_Record_e record, const void *data, uint16_t len)
+{
+  FLASH_EraseInitTypeDef l_erase_s = {0};
+  nvm_s_Header_t l_header_s;
+  uint32_t l_address_u32 = nvm_s_RecordConfig_s[record].address_u32;
+  uint32_t l_pageError_u32;
+  uint16_t l_halfWord_u16;
+  uint16_t i;
+  uint8_t l_ok_u8 = 1;
+
+  if ((sizeof(nvm_s_Header_t) + len) > FLASH_PAGE_SIZE)
+  {
+    return 0;
+  }
+
+  l_header_s.magic_u32 = NVM_MAGIC;
+  l_header_s.version_u16 = nvm_s_RecordConfig_s[record].version_u16;
+  l_header_s.len_u16 = len;
+  l_header_s.crc_u32 = nvm_f_Crc32_u32((const uint8_t *)data, len);
+
+  HAL_FLASH_Unlock();
+
+  l_erase_s.TypeErase = FLASH_TYPEERASE_PAGES;
+  l_erase_s.PageAddress = l_address_u32;
+  l_erase_s.NbPages = 1;
+  if (HAL_FLASHEx_Erase(&l_erase_s, &l_pageError_u32) != HAL_OK)
+  {
+    l_ok_u8 = 0;
+  }
+
+  /* Data first and the header last, so a reset in between leaves a page without the magic */
+  for (i = 0; (i < len) && l_ok_u8; i += 2)
+  {
+    l_halfWord_u16 = ((const uint8_t *)data)[i];
+    if ((i + 1) < len)
+    {
+      l_halfWord_u16 |= (uint16_t)((const uint8_t *)data)[i + 1] << 8;
+    }
+    else
+    {
+      l_halfWord_u16 |= 0xFF00;
+    }
+
+    if (HAL_FLASH_Program(FLASH_TYPEPROGRAM_HALFWORD, l_address_u32 + sizeof(nvm_s_Header_t) + i, l_halfWord_u16) != HAL_OK)
+    {
+      l_ok_u8 = 0;
+    }
+  }
+
+  for (i = 0; (i < sizeof(nvm_s_Header_t)) && l_ok_u8; i += 2)
+  {
+    l_halfWord_u16 = ((const uint16_t *)&l_header_s)[i / 2];
+    if (HAL_FLASH_Program(FLASH_TYPEPROGRAM_HALFWORD, l_address_u32 + i, l_halfWord_u16) != HAL_OK)
+    {
+      l_ok_u8 = 0;
+    }
+  }
+
+  HAL_FLASH_Lock();
+
+  if (l_ok_u8)
+  {
+    /* Check the CRC against what really ended up in flash */
+    l_ok_u8 = (((const nvm_s_Header_t *)l_address_u32)->crc_u32 == nvm_f_Crc32_u32((const uint8_t *)(l_address_u32 + sizeof(nvm_s_Header_t)), len));
+  }
+
+  return l_ok_u8;
+}
+
+/**
+ * @brief Standard CRC-32 (reflected, polynomial 0xEDB88320)
+ *
+ * Bitwise, as records are small and only checked at boot or after storing
+ *
+ * @param data - bytes to run the CRC over
+ * @param len - number of bytes
+ *
+ * @return uint32_t - the CRC
+ */
+uint32_t nvm_f_Crc32_u32(const uint8_t *data, uint16_t len)
+{
+  uint32_t l_crc_u32 = 0xFFFFFFFFUL;
+  uint16_t i;
+  uint8_t j;
+
+  for (i = 0; i < len; i++)
+  {
+    l_crc_u32 ^= data[i];
+    for (j = 0; j < 8; j++)
+    {
+      l_crc_u32 = (l_crc_u32 & 1) ? ((l_crc_u32 >> 1) ^ 0xEDB88320UL) : (l_crc_u32 >> 1);
+    }
+  }
+
+  return ~l_crc_u32;
+}
@@ -0,0 +1,219 @@
+/**
+ * @file pos.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Finger position software component
+ *
+ * The hall sensors are not linear in finger position and the magnets sit a bit differently in every build,
+ * so the raw values are linearised with a per-finger LUT made by the calibration routine (see cal.c).
+ * The LUT points are evenly spaced over the raw range, which makes the lookup at control rate
+ * one multiply to find the segment and one interpolation inside it.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "pos_e.h"
+#include "pos_i.h"
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Filtered raw hall value of each finger
+ *
+ * @values 0..ANA_MAX_VALUE
+ */
+uint16_t pos_g_Raw_u16[POS_FINGER_COUNT];
+
+/**
+ * @brief Linearised position of each finger
+ *
+ * @values 0..POS_FULL_SCALE, 0 is open
+ */
+uint16_t pos_g_Position_u16[POS_FINGER_COUNT];
+
+/**
+ * @brief Whether a valid calibration is in use
+ *
+ * @values 0 - not calibrated, 1 - calibrated
+ */
+uint8_t pos_g_Calibrated_u8;
+
+/**
+ * @brief Hall offset found by homing, subtracted from the raw value before the lookup
+ *
+ * @values in raw ADC counts
+ */
+int16_t pos_g_RawOffset_s16[POS_FINGER_COUNT];
+
+/**
+ * @brief Calibration in use, loaded from flash or set by the calibration routine
+ *
+ */
+pos_s_CalData_t pos_g_CalData_s;
+
+/**
+ * @brief Filter state, raw value << POS_FILTER_SHIFT
+ *
+ */
+uint32_t pos_g_FilterAcc_u32[POS_FINGER_COUNT];
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+void pos_f_Init_v(void);
+void pos_f_Handle_v(void);
+uint16_t pos_f_RawToPosition_u16(uint8_t fingerIndex, uint16_t raw);
+uint8_t pos_f_SetCalibration_u8(const pos_s_CalData_t *calData);
+int16_t pos_f_SetOpenReference_s16(uint8_t fingerIndex, uint16_t raw);
+
+/**
+ * @brief Initialise function to be called once on boot, after ana_f_Init_v()
+ *
+ * Load the calibration from flash and preset the filters with the current hall values
+ *
+ * @return void
+ */
+void pos_f_Init_v(void)
+{
+  uint8_t i;
+
+  pos_g_Calibrated_u8 = nvm_f_Load_u8(NVM_REC_HALL_CAL, &pos_g_CalData_s, sizeof(pos_s_CalData_t));
+
+  for (i = 0; i < POS_FINGER_COUNT; i++)
+  {
+    pos_g_FilterAcc_u32[i] = (uint32_t)ana_f_Get_u16(pos_c_HallChannel_e[i]) << POS_FILTER_SHIFT;
+  }
+}
+
+/**
+ * @brief Handle function to be called cyclically, at control rate
+ *
+ * Filter the raw hall values and convert them to finger positions
+ *
+ * @return void
+ */
+void pos_f_Handle_v(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < POS_FINGER_COUNT; i++)
+  {
+    pos_g_FilterAcc_u32[i] -= pos_g_FilterAcc_u32[i] >> POS_FILTER_SHIFT;
+    pos_g_FilterAcc_u32[i] += hwa_f_AnaRead_u16(pos_c_HallChannel_e[i]);
+    pos_g_Raw_u16[i] = (uint16_t)(pos_g_FilterAcc_u32[i] >> POS_FILTER_SHIFT);
+
+    pos_g_Position_u16[i] = pos_f_RawToPosition_u16(i, pos_g_Raw_u16[i]);
+  }
+}
+
+/**
+ * @brief Convert a raw hall value to a finger position
+ *
+ * @param fingerIndex - which finger, 0..POS_FINGER_COUNT - 1
+ * @param raw - raw hall value, values outside the calibrated range are clamped to the end stops
+ *
+ * @return uint16_t - position 0..POS_FULL_SCALE
+ */
+uint16_t pos_f_RawToPosition_u16(uint8_t fingerIndex, uint16_t raw)
+{
+  const pos_s_FingerLut_t *l_lut_ps = &pos_g_CalData_s.finger_s[fingerIndex];
+  uint32_t l_indexQ16_u32;
+  uint32_t l_idx_u32;
+  int32_t l_lo_s32;
+  int32_t l_hi_s32;
+  int32_t l_raw_s32;
+
+  if (!pos_g_Calibrated_u8)
+  {
+    return (uint16_t)(((uint32_t)raw * POS_FULL_SCALE) / ANA_MAX_VALUE);
+  }
+
+  l_raw_s32 = (int32_t)raw - pos_g_RawOffset_s16[fingerIndex];
+  raw = (l_raw_s32 < 0) ? 0 : ((l_raw_s32 > ANA_MAX_VALUE) ? ANA_MAX_VALUE : (uint16_t)l_raw_s32);
+
+  if (raw <= l_lut_ps->rawMin_u16)
+  {
+    return l_lut_ps->lut_u16[0];
+  }
+  if (raw >= l_lut_ps->rawMax_u16)
+  {
+    return l_lut_ps->lut_u16[POS_LUT_SIZE - 1];
+  }
+
+  /* Segment index in the upper 16 bits, position inside the segment in the lower 16 */
+  l_indexQ16_u32 = (uint32_t)(raw - l_lut_ps->rawMin_u16) * l_lut_ps->indexScaleQ16_u32;
+  l_idx_u32 = l_indexQ16_u32 >> 16;
+  if (l_idx_u32 >= (POS_LUT_SIZE - 1))
+  {
+    return l_lut_ps->lut_u16[POS_LUT_SIZE - 1];
+  }
+
+  l_lo_s32 = l_lut_ps->lut_u16[l_idx_u32];
+  l_hi_s32 = l_lut_ps->lut_u16[l_idx_u32 + 1];
+
+  return (uint16_t)(l_lo_s32 + (((l_hi_s32 - l_lo_s32) * (int32_t)(l_indexQ16_u32 & 0xFFFF)) >> 16));
+}
+
+/**
+ * @brief Start using a new calibration and store it in flash
+ *
+ * @param calData - new calibration of all fingers
+ *
+ * @return uint8_t - 1 if it was stored, 0 if writing the flash failed (it is still used until reset)
+ */
+uint8_t pos_f_SetCalibration_u8(const pos_s_CalData_t *calData)
+{
+  uint8_t i;
+
+  pos_g_CalData_s = *calData;
+  pos_g_Calibrated_u8 = 1;
+
+  /* The new calibration was made with the sensors as they are now */
+  for (i = 0; i < POS_FINGER_COUNT; i++)
+  {
+    pos_g_RawOffset_s16[i] = 0;
+  }
+
+  return nvm_f_Store_u8(NVM_REC_HALL_CAL, &pos_g_CalData_s, sizeof(pos_s_CalData_t));
+}
+
+/**
+ * @brief Take the current hall value of a finger resting at its open end stop as the reference
+ *
+ * The difference to the raw value the calibration has for the open end stop becomes the offset
+ * applied to all further lookups of that finger
+ *
+ * @param fingerIndex - which finger, 0..POS_FINGER_COUNT - 1
+ * @param raw - filtered raw hall value at the open end stop
+ *
+ * @return int16_t - the new offset, 0 when there is no calibration to compare against
+ */
+int16_t pos_f_SetOpenReference_s16(uint8_t fingerIndex, uint16_t raw)
+{
+  const pos_s_FingerLut_t *l_lut_ps = &pos_g_CalData_s.finger_s[fingerIndex];
+  uint16_t l_openRaw_u16;
+
+  if (!pos_g_Calibrated_u8)
+  {
+    return 0;
+  }
+
+  /* Position 0 sits at whichever end of the raw range the LUT starts from */
+  l_openRaw_u16 = (l_lut_ps->lut_u16[0] < l_lut_ps->lut_u16[POS_LUT_SIZE - 1]) ? l_lut_ps->rawMin_u16 : l_lut_ps->rawMax_u16;
+  pos_g_RawOffset_s16[fingerIndex] = (int16_t)raw - (int16_t)l_openRaw_u16;
+
+  return pos_g_RawOffset_s16[fingerIndex];
+}
@@ -22,6 +22,9 @@
 #include "stm32f1xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "irq_e.h"
+#include "led_e.h"
+#include "tlm_e.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -56,6 +59,8 @@
 
 /* External variables --------------------------------------------------------*/
 
+extern DMA_HandleTypeDef hdma_adc1;
+extern UART_HandleTypeDef huart4;
 /* USER CODE BEGIN EV */
 
 /* USER CODE END EV */
@@ -183,11 +188,14 @@ void PendSV_Handler(void)
 void SysTick_Handler(void)
 {
   /* USER CODE BEGIN SysTick_IRQn 0 */
-
+  irq_f_Enter_v(IRQ_ID_SYSTICK);
+  /* SysTick counts HCLK cycles down from LOAD since it fired, so this is the exact entry latency */
+  irq_f_Latency_v(IRQ_ID_SYSTICK, SysTick->LOAD - SysTick->VAL);
   /* USER CODE END SysTick_IRQn 0 */
   HAL_IncTick();
   /* USER CODE BEGIN SysTick_IRQn 1 */
-
+  led_f_Tick_v();
+  irq_f_Exit_v(IRQ_ID_SYSTICK);
   /* USER CODE END SysTick_IRQn 1 */
 }
 
@@ -204,13 +212,42 @@ void SysTick_Handler(void)
 void RCC_IRQHandler(void)
 {
   /* USER CODE BEGIN RCC_IRQn 0 */
-
+  irq_f_Enter_v(IRQ_ID_RCC);
   /* USER CODE END RCC_IRQn 0 */
   /* USER CODE BEGIN RCC_IRQn 1 */
-
+  irq_f_Exit_v(IRQ_ID_RCC);
   /* USER CODE END RCC_IRQn 1 */
 }
 
+/**
+  * @brief This function handles DMA1 channel1 global interrupt.
+  */
+void DMA1_Channel1_IRQHandler(void)
+{
+  /* USER CODE BEGIN DMA1_Channel1_IRQn 0 */
+  irq_f_Enter_v(IRQ_ID_ADC_DMA);
+  /* USER CODE END DMA1_Channel1_IRQn 0 */
+  HAL_DMA_IRQHandler(&hdma_adc1);
+  /* USER CODE BEGIN DMA1_Channel1_IRQn 1 */
+  irq_f_Exit_v(IRQ_ID_ADC_DMA);
+  /* USER CODE END DMA1_Channel1_IRQn 1 */
+}
+
+/**
+  * @brief This function handles UART4 global interrupt.
+  */
+void UART4_IRQHandler(void)
+{
+  /* USER CODE BEGIN UART4_IRQn 0 */
+  irq_f_Enter_v(IRQ_ID_UART4);
+  tlm_f_RxIsr_v();
+  /* USER CODE END UART4_IRQn 0 */
+  HAL_UART_IRQHandler(&huart4);
+  /* USER CODE BEGIN UART4_IRQn 1 */
+  irq_f_Exit_v(IRQ_ID_UART4);
+  /* USER CODE END UART4_IRQn 1 */
+}
+
 /* USER CODE BEGIN 1 */
 
 /* USER CODE END 1 */
@@ -24,6 +24,12 @@
 #include <errno.h>
 #include <stdint.h>
 
+/**
+ * Closed heap flag and rejected request counter, owned by mem.c
+ */
+extern uint8_t mem_g_HeapLocked_u8;
+extern uint32_t mem_g_HeapRejectCnt_u32;
+
 /**
  * Pointer to the current high watermark of the heap usage
  */
@@ -46,6 +52,7 @@ static uint8_t *__sbrk_heap_end = NULL;
  * The implementation considers '_estack' linker symbol to be RAM end
  * NOTE: If the MSP stack, at any point during execution, grows larger than the
  * reserved size, please increase the '_Min_Stack_Size'.
+ * Once mem_f_LockHeap_v() closed the heap, every request fails, runtime memory comes from the mem.c pools.
  *
  * @param incr Memory size
  * @return Pointer to allocated memory
@@ -65,6 +72,14 @@ void *_sbrk(ptrdiff_t incr)
     __sbrk_heap_end = &_end;
   }
 
+  /* No heap growth after init, it would fragment RAM at runtime */
+  if (mem_g_HeapLocked_u8)
+  {
+    mem_g_HeapRejectCnt_u32++;
+    errno = ENOMEM;
+    return (void *)-1;
+  }
+
   /* Protect heap from growing into the reserved MSP stack */
   if (__sbrk_heap_end + incr > max_heap)
   {
@@ -0,0 +1,456 @@
+/**
+ * @file tlm.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Telemetry software component
+ *
+ * Sends binary frames to the host over UART4, in the same frame format as the ESP32 telemetry.
+ * Every frame is built in a block of the frame pool (see mem.c) and queued, the UART sends one block at a time
+ * in the background (interrupt driven), and tlm_f_Handle_v() gives the block back once the UART is done with it.
+ * Frames can only be sent from the main loop, not from interrupts.
+ *
+ * Frames from the host are received byte by byte in the UART interrupt (tlm_f_RxIsr_v()) into a ring,
+ * which the main loop parses and hands the valid frames to the module they are meant for.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "tlm_e.h"
+#include "tlm_i.h"
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Statistics of the telemetry link
+ *
+ */
+tlm_s_LinkStats_t tlm_g_LinkStats_s;
+
+/**
+ * @brief Frames waiting to be sent (ring), and the frame the UART is sending right now
+ *
+ */
+uint8_t *tlm_g_TxQueue_pu8[TLM_TX_QUEUE_LEN];
+uint8_t tlm_g_TxHead_u8;
+uint8_t tlm_g_TxCount_u8;
+uint8_t *tlm_g_TxActive_pu8;
+
+/**
+ * @brief Sequence number of the next frame sent, lets the host count lost frames
+ *
+ */
+uint8_t tlm_g_TxSeq_u8;
+
+/**
+ * @brief Bytes received by the UART interrupt (ring), the interrupt moves the head and the main loop the tail
+ *
+ */
+uint8_t tlm_g_RxBuf_u8[TLM_RX_BUF_LEN];
+volatile uint16_t tlm_g_RxHead_u16;
+volatile uint16_t tlm_g_RxTail_u16;
+
+/**
+ * @brief When the UART interrupt took the last byte into the ring, in tsy_f_LocalUs_u64() time
+ *
+ */
+volatile uint64_t tlm_g_RxLastUs_u64;
+
+/**
+ * @brief When the last byte of the frame being handled arrived, 0 if not known
+ *
+ */
+uint64_t tlm_g_RxFrameUs_u64;
+
+/**
+ * @brief Receive parser state and the frame being received
+ *
+ */
+tlm_RxState_e tlm_g_RxState_e;
+uint8_t tlm_g_RxId_u8;
+uint8_t tlm_g_RxSeq_u8;
+uint8_t tlm_g_RxLen_u8;
+uint8_t tlm_g_RxIdx_u8;
+uint16_t tlm_g_RxCrc_u16;
+uint8_t tlm_g_RxPayload_u8[TLM_RX_MAX_PAYLOAD];
+
+/**
+ * @brief Time since the interrupt timing was last sent
+ *
+ */
+uint16_t tlm_g_IrqMs_u16;
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+void tlm_f_Init_v(void);
+void tlm_f_Handle_v(void);
+uint8_t tlm_f_SendFrame_u8(tlm_MsgId_e id, const uint8_t *payload, uint8_t len);
+void tlm_f_EnableRx_v(void);
+void tlm_f_RxIsr_v(void);
+uint8_t tlm_f_IsTxIdle_u8(void);
+
+void tlm_f_Receive_v(void);
+void tlm_f_HandleFrame_v(uint8_t id, const uint8_t *payload, uint8_t len);
+void tlm_f_SendIrqStats_v(void);
+uint16_t tlm_f_Crc16_u16(uint16_t crc, const uint8_t *data, uint16_t len);
+
+/**
+ * @brief Initialise function to be called once on boot, after mem_f_Init_v() and MX_UART4_Init()
+ *
+ * @return void
+ */
+void tlm_f_Init_v(void)
+{
+  tlm_g_TxHead_u8 = 0;
+  tlm_g_TxCount_u8 = 0;
+  tlm_g_TxActive_pu8 = NULL;
+  tlm_g_LinkStats_s.txFrames_u32 = 0;
+  tlm_g_LinkStats_s.txDropped_u32 = 0;
+  tlm_g_LinkStats_s.rxFrames_u32 = 0;
+  tlm_g_LinkStats_s.rxErrors_u32 = 0;
+  tlm_g_LinkStats_s.rxDropped_u32 = 0;
+  tlm_g_RxHead_u16 = 0;
+  tlm_g_RxTail_u16 = 0;
+  tlm_g_RxState_e = TLM_RX_SYNC_1;
+
+  tlm_f_EnableRx_v();
+}
+
+/**
+ * @brief Handle function to be called every millisecond
+ *
+ * Handle the frames received since the last call, give back the frame the UART finished
+ * (or that a UART re-init cut short), start the next one, and queue the periodic frames
+ *
+ * @return void
+ */
+void tlm_f_Handle_v(void)
+{
+  uint8_t *l_frame_pu8;
+
+  tlm_f_Receive_v();
+
+  if ((tlm_g_TxActive_pu8 != NULL) && (huart4.gState == HAL_UART_STATE_READY))
+  {
+    mem_f_Free_v(MEM_POOL_FRAME, tlm_g_TxActive_pu8);
+    tlm_g_TxActive_pu8 = NULL;
+  }
+
+  if ((tlm_g_TxActive_pu8 == NULL) && (tlm_g_TxCount_u8 > 0))
+  {
+    l_frame_pu8 = tlm_g_TxQueue_pu8[tlm_g_TxHead_u8];
+    tlm_g_TxHead_u8 = (tlm_g_TxHead_u8 + 1) % TLM_TX_QUEUE_LEN;
+    tlm_g_TxCount_u8--;
+
+    /* The payload length is in the header, so the frame length doesn't have to be stored separately */
+    if (HAL_UART_Transmit_IT(&huart4, l_frame_pu8, TLM_HEADER_LEN + l_frame_pu8[4] + TLM_CRC_LEN) == HAL_OK)
+    {
+      tlm_g_TxActive_pu8 = l_frame_pu8;
+      tlm_g_LinkStats_s.txFrames_u32++;
+    }
+    else
+    {
+      mem_f_Free_v(MEM_POOL_FRAME, l_frame_pu8);
+      tlm_g_LinkStats_s.txDropped_u32++;
+    }
+  }
+
+  tlm_g_IrqMs_u16++;
+  if (tlm_g_IrqMs_u16 >= TLM_IRQ_PERIOD_MS)
+  {
+    tlm_g_IrqMs_u16 = 0;
+    tlm_f_SendIrqStats_v();
+  }
+}
+
+/**
+ * @brief Build a frame and queue it for sending
+ *
+ * @param id - frame ID
+ * @param payload - payload bytes
+ * @param len - payload length, 0..TLM_MAX_PAYLOAD
+ *
+ * @return uint8_t - 1 if queued, 0 if dropped (too long, no free block or queue full)
+ */
+uint8_t tlm_f_SendFrame_u8(tlm_MsgId_e id, const uint8_t *payload, uint8_t len)
+{
+  uint8_t *l_frame_pu8;
+  uint16_t l_crc_u16;
+  uint8_t i;
+
+  if ((len > TLM_MAX_PAYLOAD) || (tlm_g_TxCount_u8 >= TLM_TX_QUEUE_LEN))
+  {
+    tlm_g_LinkStats_s.txDropped_u32++;
+    return 0;
+  }
+
+  l_frame_pu8 = mem_f_Alloc_pv(MEM_POOL_FRAME);
+  if (l_frame_pu8 == NULL)
+  {
+    tlm_g_LinkStats_s.txDropped_u32++;
+    return 0;
+  }
+
+  l_frame_pu8[0] = TLM_SYNC_1;
+  l_frame_pu8[1] = TLM_SYNC_2;
+  l_frame_pu8[2] = (uint8_t)id;
+  l_frame_pu8[3] = tlm_g_TxSeq_u8++;
+  l_frame_pu8[4] = len;
+  for (i = 0; i < len; i++)
+  {
+    l_frame_pu8[TLM_HEADER_LEN + i] = payload[i];
+  }
+
+  /* CRC over id, seq, len and the payload */
+  l_crc_u16 = tlm_f_Crc16_u16(0xFFFF, &l_frame_pu8[2], 3 + len);
+  l_frame_pu8[TLM_HEADER_LEN + len] = (uint8_t)l_crc_u16;
+  l_frame_pu8[TLM_HEADER_LEN + len + 1] = (uint8_t)(l_crc_u16 >> 8);
+
+  tlm_g_TxQueue_pu8[(tlm_g_TxHead_u8 + tlm_g_TxCount_u8) % TLM_TX_QUEUE_LEN] = l_frame_pu8;
+  tlm_g_TxCount_u8++;
+
+  return 1;
+}
+
+/**
+ * @brief Let the UART interrupt receive, to be called after every HAL_UART_Init() of the telemetry UART
+ *
+ * The bytes are taken straight from the data register in tlm_f_RxIsr_v(), the HAL is only used for sending
+ *
+ * @return void
+ */
+void tlm_f_EnableRx_v(void)
+{
+  __HAL_UART_ENABLE_IT(&huart4, UART_IT_RXNE);
+}
+
+/**
+ * @brief Take a received byte from the UART into the ring, to be called from the UART interrupt before the HAL handler
+ *
+ * Reading the data register after the status register also clears an overrun or framing error,
+ * so the HAL handler never sees a receive error and never aborts a transfer because of one
+ *
+ * @return void
+ */
+void tlm_f_RxIsr_v(void)
+{
+  uint32_t l_status_u32 = huart4.Instance->SR;
+  uint16_t l_next_u16;
+  uint8_t l_byte_u8;
+
+  if (l_status_u32 & (USART_SR_RXNE | USART_SR_ORE))
+  {
+    l_byte_u8 = (uint8_t)huart4.Instance->DR;
+
+    if (l_status_u32 & USART_SR_ORE)
+    {
+      tlm_g_LinkStats_s.rxDropped_u32++;
+    }
+
+    l_next_u16 = (tlm_g_RxHead_u16 + 1) & (TLM_RX_BUF_LEN - 1);
+    if (l_next_u16 != tlm_g_RxTail_u16)
+    {
+      tlm_g_RxBuf_u8[tlm_g_RxHead_u16] = l_byte_u8;
+      tlm_g_RxHead_u16 = l_next_u16;
+      tlm_g_RxLastUs_u64 = tsy_f_LocalUs_u64();
+    }
+    else
+    {
+      tlm_g_LinkStats_s.rxDropped_u32++;
+    }
+  }
+}
+
+/**
+ * @brief Parse the bytes received since the last call and handle every valid frame
+ *
+ * Same parser as on the ESP32, a frame with a bad CRC or length is dropped and the parser looks for the next sync
+ *
+ * @return void
+ */
+void tlm_f_Receive_v(void)
+{
+  uint8_t l_header_u8[3];
+  uint8_t l_byte_u8;
+  uint32_t l_primask_u32;
+
+  while (tlm_g_RxTail_u16 != tlm_g_RxHead_u16)
+  {
+    l_byte_u8 = tlm_g_RxBuf_u8[tlm_g_RxTail_u16];
+    tlm_g_RxTail_u16 = (tlm_g_RxTail_u16 + 1) & (TLM_RX_BUF_LEN - 1);
+
+    switch (tlm_g_RxState_e)
+    {
+    case TLM_RX_SYNC_1:
+      if (l_byte_u8 == TLM_SYNC_1)
+      {
+        tlm_g_RxState_e = TLM_RX_SYNC_2;
+      }
+      break;
+    case TLM_RX_SYNC_2:
+      tlm_g_RxState_e = (l_byte_u8 == TLM_SYNC_2) ? TLM_RX_ID : TLM_RX_SYNC_1;
+      break;
+    case TLM_RX_ID:
+      tlm_g_RxId_u8 = l_byte_u8;
+      tlm_g_RxState_e = TLM_RX_SEQ;
+      break;
+    case TLM_RX_SEQ:
+      tlm_g_RxSeq_u8 = l_byte_u8;
+      tlm_g_RxState_e = TLM_RX_LEN;
+      break;
+    case TLM_RX_LEN:
+      tlm_g_RxLen_u8 = l_byte_u8;
+      tlm_g_RxIdx_u8 = 0;
+      if (tlm_g_RxLen_u8 > TLM_RX_MAX_PAYLOAD)
+      {
+        tlm_g_LinkStats_s.rxErrors_u32++;
+        tlm_g_RxState_e = TLM_RX_SYNC_1;
+      }
+      else
+      {
+        tlm_g_RxState_e = (tlm_g_RxLen_u8 > 0) ? TLM_RX_PAYLOAD : TLM_RX_CRC_1;
+      }
+      break;
+    case TLM_RX_PAYLOAD:
+      tlm_g_RxPayload_u8[tlm_g_RxIdx_u8++] = l_byte_u8;
+      if (tlm_g_RxIdx_u8 >= tlm_g_RxLen_u8)
+      {
+        tlm_g_RxState_e = TLM_RX_CRC_1;
+      }
+      break;
+    case TLM_RX_CRC_1:
+      tlm_g_RxCrc_u16 = l_byte_u8;
+      tlm_g_RxState_e = TLM_RX_CRC_2;
+      break;
+    case TLM_RX_CRC_2:
+    default:
+      tlm_g_RxCrc_u16 |= (uint16_t)l_byte_u8 << 8;
+      tlm_g_RxState_e = TLM_RX_SYNC_1;
+
+      /* CRC over id, seq, len and payload, same as on the sending side */
+      l_header_u8[0] = tlm_g_RxId_u8;
+      l_header_u8[1] = tlm_g_RxSeq_u8;
+      l_header_u8[2] = tlm_g_RxLen_u8;
+      if (tlm_f_Crc16_u16(tlm_f_Crc16_u16(0xFFFF, l_header_u8, 3), tlm_g_RxPayload_u8, tlm_g_RxLen_u8) == tlm_g_RxCrc_u16)
+      {
+        tlm_g_LinkStats_s.rxFrames_u32++;
+
+        /* The arrival of the last byte is only known if nothing arrived after it */
+        l_primask_u32 = __get_PRIMASK();
+        __disable_irq();
+        tlm_g_RxFrameUs_u64 = (tlm_g_RxTail_u16 == tlm_g_RxHead_u16) ? tlm_g_RxLastUs_u64 : 0;
+        __set_PRIMASK(l_primask_u32);
+
+        tlm_f_HandleFrame_v(tlm_g_RxId_u8, tlm_g_RxPayload_u8, tlm_g_RxLen_u8);
+      }
+      else
+      {
+        tlm_g_LinkStats_s.rxErrors_u32++;
+      }
+      break;
+    }
+  }
+}
+
+/**
+ * @brief Hand a valid frame received from the host to the module it is meant for
+ *
+ * @param id - frame ID, see tlm_MsgId_e
+ * @param payload - received payload
+ * @param len - payload length
+ *
+ * @return void
+ */
+void tlm_f_HandleFrame_v(uint8_t id, const uint8_t *payload, uint8_t len)
+{
+  switch (id)
+  {
+  case TLM_ID_UPD_BEGIN:
+  case TLM_ID_UPD_DATA:
+  case TLM_ID_UPD_COMMIT:
+  case TLM_ID_UPD_STATUS:
+    upd_f_HandleFrame_v(id, payload, len);
+    break;
+  case TLM_ID_TSY_REQ:
+  case TLM_ID_TSY_RESP:
+    tsy_f_HandleFrame_v(id, payload, len);
+    break;
+  default:
+    /* Unknown frames are ignored, the host might be newer than the firmware */
+    break;
+  }
+}
+
+/**
+ * @brief Whether the UART is idle with nothing queued, so a frame queued now starts with the next tlm_f_Handle_v()
+ *
+ * @return uint8_t - 1 if idle, 0 if not
+ */
+uint8_t tlm_f_IsTxIdle_u8(void)
+{
+  return ((tlm_g_TxActive_pu8 == NULL) && (tlm_g_TxCount_u8 == 0));
+}
+
+/**
+ * @brief Send the timing of all measured interrupts
+ *
+ * Payload: IRQ_STATS, see firmware/msg/messages.py, one entry for every irq_Id_e
+ *
+ * @return void
+ */
+void tlm_f_SendIrqStats_v(void)
+{
+  msg_s_IrqStats_t l_stats_s;
+  uint8_t l_payload_u8[MSG_IRQ_STATS_LEN];
+  uint8_t i;
+
+  l_stats_s.cpuHz_u32 = HAL_RCC_GetHCLKFreq();
+  for (i = 0; (i < IRQ_ID_COUNT) && (i < MSG_IRQ_STATS_IRQS_MAX); i++)
+  {
+    l_stats_s.irqs_s[i].count_u32 = irq_g_Stats_s[i].count_u32;
+    l_stats_s.irqs_s[i].maxCycles_u32 = irq_g_Stats_s[i].maxCycles_u32;
+    l_stats_s.irqs_s[i].maxLatency_u32 = irq_g_Stats_s[i].maxLatency_u32;
+  }
+  l_stats_s.irqsCount_u8 = i;
+
+  tlm_f_SendFrame_u8(TLM_ID_IRQ_STATS, l_payload_u8, msg_f_PackIrqStats_u8(l_payload_u8, &l_stats_s));
+}
+
+/**
+ * @brief CRC-16/CCITT, bitwise, small and fast enough for the frame sizes used here
+ *
+ * @param crc - start value, 0xFFFF for a new frame
+ * @param data - bytes to add
+ * @param len - number of bytes
+ *
+ * @return uint16_t - updated CRC
+ */
+uint16_t tlm_f_Crc16_u16(uint16_t crc, const uint8_t *data, uint16_t len)
+{
+  uint16_t i;
+  uint8_t j;
+
+  for (i = 0; i < len; i++)
+  {
+    crc ^= (uint16_t)data[i] << 8;
+    for (j = 0; j < 8; j++)
+    {
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+  }
+
+  return crc;
+}
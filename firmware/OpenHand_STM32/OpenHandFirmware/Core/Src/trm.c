@@ -0,0 +1,164 @@
+/**
+ * @file trm.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Trim pot parameter tuning software component
+ *
+ * The two trim pots on the board tune parameters of the hand on the spot, without a computer.
+ * Which pot drives which parameter and over which range is set in trm_s_ParamConfig_s.
+ * The pots are read from the ADC scan buffer (see ana.c) every TRM_PERIOD_MS, filtered,
+ * and a parameter only follows its pot once it moved by more than TRM_HYSTERESIS.
+ * Other modules read the result from trm_g_Param_u16 (or trm_f_Get_u16()), which costs nothing extra.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "trm_e.h"
+#include "trm_i.h"
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Current value of every parameter, in the unit of the parameter
+ *
+ * @values indexed by trm_Param_e, between the limits in trm_s_ParamConfig_s
+ */
+uint16_t trm_g_Param_u16[TRM_PARAM_COUNT];
+
+/**
+ * @brief Filter accumulator and last accepted (after hysteresis) raw value of every parameter's pot
+ *
+ */
+uint16_t trm_g_FilterAcc_u16[TRM_PARAM_COUNT];
+uint16_t trm_g_Accepted_u16[TRM_PARAM_COUNT];
+
+/**
+ * @brief Time since the pots were last read
+ *
+ */
+uint8_t trm_g_Ms_u8;
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+void trm_f_Init_v(void);
+void trm_f_Handle_v(void);
+uint16_t trm_f_Get_u16(trm_Param_e param);
+
+void trm_f_Update_v(trm_Param_e param);
+
+/**
+ * @brief Initialise function to be called once on boot, once the ADC scan runs
+ *
+ * Start the filters from the current pot positions, so the parameters are right from the start
+ *
+ * @return void
+ */
+void trm_f_Init_v(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < TRM_PARAM_COUNT; i++)
+  {
+    trm_g_Param_u16[i] = trm_s_ParamConfig_s[i].default_u16;
+
+    if (trm_s_ParamConfig_s[i].channel_e < ANA_CH_COUNT)
+    {
+      trm_g_FilterAcc_u16[i] = ana_f_Get_u16(trm_s_ParamConfig_s[i].channel_e) << TRM_FILTER_SHIFT;
+      /* Far from any real reading, so the first update always takes the pot position */
+      trm_g_Accepted_u16[i] = UINT16_MAX;
+      trm_f_Update_v(i);
+    }
+  }
+}
+
+/**
+ * @brief Handle function to be called every millisecond
+ *
+ * @return void
+ */
+void trm_f_Handle_v(void)
+{
+  uint8_t i;
+
+  trm_g_Ms_u8++;
+  if (trm_g_Ms_u8 < TRM_PERIOD_MS)
+  {
+    return;
+  }
+  trm_g_Ms_u8 = 0;
+
+  for (i = 0; i < TRM_PARAM_COUNT; i++)
+  {
+    if (trm_s_ParamConfig_s[i].channel_e < ANA_CH_COUNT)
+    {
+      trm_g_FilterAcc_u16[i] -= trm_g_FilterAcc_u16[i] >> TRM_FILTER_SHIFT;
+      trm_g_FilterAcc_u16[i] += ana_f_Get_u16(trm_s_ParamConfig_s[i].channel_e);
+      trm_f_Update_v(i);
+    }
+  }
+}
+
+/**
+ * @brief Current value of a parameter
+ *
+ * @param param - which parameter
+ *
+ * @return uint16_t - value in the unit of the parameter
+ */
+uint16_t trm_f_Get_u16(trm_Param_e param)
+{
+  return trm_g_Param_u16[param];
+}
+
+/**
+ * @brief Move a parameter to its pot position, if the pot moved far enough
+ *
+ * The pot has to leave the hysteresis band around the last accepted reading, readings within TRM_HYSTERESIS
+ * of either end are then taken as that end
+ *
+ * @param param - which parameter, has to have a pot mapped
+ *
+ * @return void
+ */
+void trm_f_Update_v(trm_Param_e param)
+{
+  trm_s_ParamConfig_t *l_cfg_ps = &trm_s_ParamConfig_s[param];
+  int32_t l_raw_s32 = trm_g_FilterAcc_u16[param] >> TRM_FILTER_SHIFT;
+
+  /* The band comes first, also at the ends: a pot resting just next to the snap point must not flicker between
+   * the end and the reading. Once accepted, an end stays until the pot moves a whole band away from it */
+  if ((trm_g_Accepted_u16[param] != UINT16_MAX) &&
+      (l_raw_s32 > (trm_g_Accepted_u16[param] - TRM_HYSTERESIS)) &&
+      (l_raw_s32 < (trm_g_Accepted_u16[param] + TRM_HYSTERESIS)))
+  {
+    return;
+  }
+
+  /* Near an end counts as the end, so both limits of the parameter can be reached despite the pot tolerance */
+  if (l_raw_s32 <= TRM_HYSTERESIS)
+  {
+    l_raw_s32 = 0;
+  }
+  else if (l_raw_s32 >= (ANA_MAX_VALUE - TRM_HYSTERESIS))
+  {
+    l_raw_s32 = ANA_MAX_VALUE;
+  }
+
+  trm_g_Accepted_u16[param] = (uint16_t)l_raw_s32;
+  trm_g_Param_u16[param] = (uint16_t)((int32_t)l_cfg_ps->min_u16 +
+                                      (((int32_t)l_cfg_ps->max_u16 - l_cfg_ps->min_u16) * l_raw_s32) / ANA_MAX_VALUE);
+}
@@ -0,0 +1,425 @@
+/**
+ * @file tsy.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Time sync software component
+ *
+ * Keeps a microsecond local clock (SysTick) and a model of the clock of the peer on the other end of the telemetry
+ * link, the ESP32 board when the two boards are wired together, whose clock is then the shared timebase.
+ * Every TSY_PERIOD_MS a request goes out, the peer replies with when the request arrived and when its reply leaves,
+ * and with the local send and arrival times that gives the offset and the round trip, like NTP does.
+ * Out of every TSY_WINDOW exchanges only the one with the shortest round trip updates the model, and the offset
+ * change between such exchanges gives the drift. The model is sent to the peer every TSY_STATS_PERIOD_MS,
+ * so it can convert our timestamps as well.
+ *
+ * All four times are taken at the last byte of a frame (on receive in the UART interrupt, see tlm_f_RxIsr_v()),
+ * so both directions take the same time and only the busy time of either side adds to the error.
+ * Requests of the peer are answered the same way, so a host can also sync to this board.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "tsy_e.h"
+#include "tsy_i.h"
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Model of the peer clock, see tsy_s_Model_t
+ *
+ */
+tsy_s_Model_t tsy_g_Model_s;
+
+/**
+ * @brief Upper 32 bits of the millisecond tick, counted up whenever HAL_GetTick() wraps
+ *
+ */
+volatile uint32_t tsy_g_TickHigh_u32;
+uint32_t tsy_g_LastTick_u32;
+
+/**
+ * @brief Request waiting for its reply: its tag, when its last byte left, and whether it is still waiting
+ *
+ */
+uint8_t tsy_g_Tag_u8;
+uint64_t tsy_g_T1_u64;
+uint8_t tsy_g_Pending_u8;
+
+/**
+ * @brief Milliseconds since the last request and since the model was last sent
+ *
+ */
+uint16_t tsy_g_RequestMs_u16;
+uint16_t tsy_g_StatsMs_u16;
+
+/**
+ * @brief Requests sent in the current window, and the best exchange of it
+ *
+ */
+uint8_t tsy_g_WindowCnt_u8;
+tsy_s_Sample_t tsy_g_Best_s;
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+void tsy_f_Init_v(void);
+void tsy_f_Handle_v(void);
+void tsy_f_HandleFrame_v(uint8_t id, const uint8_t *payload, uint8_t len);
+uint64_t tsy_f_LocalUs_u64(void);
+uint64_t tsy_f_ToPeerUs_u64(uint64_t localUs);
+
+void tsy_f_SendRequest_v(void);
+void tsy_f_SendReply_v(const uint8_t *payload, uint8_t len);
+void tsy_f_TakeReply_v(const uint8_t *payload, uint8_t len);
+void tsy_f_UpdateModel_v(void);
+void tsy_f_SendStats_v(void);
+uint32_t tsy_f_FrameUs_u32(uint8_t frameLen);
+
+/**
+ * @brief Initialise function to be called once on boot, after tlm_f_Init_v()
+ *
+ * @return void
+ */
+void tsy_f_Init_v(void)
+{
+  tsy_g_TickHigh_u32 = 0;
+  tsy_g_LastTick_u32 = HAL_GetTick();
+  tsy_g_Pending_u8 = 0;
+  tsy_g_RequestMs_u16 = 0;
+  tsy_g_StatsMs_u16 = 0;
+  tsy_g_WindowCnt_u8 = 0;
+  tsy_g_Best_s.rttUs_u32 = UINT32_MAX;
+  tsy_g_Model_s.synced_u8 = 0;
+  tsy_g_Model_s.samples_u32 = 0;
+  tsy_g_Model_s.lost_u32 = 0;
+}
+
+/**
+ * @brief Handle function to be called every millisecond, right before tlm_f_Handle_v()
+ *
+ * A request is only sent while the UART is idle, tlm_f_Handle_v() then starts it right away,
+ * so its last byte leaves at a known time
+ *
+ * @return void
+ */
+void tsy_f_Handle_v(void)
+{
+  uint32_t l_tick_u32 = HAL_GetTick();
+
+  if (l_tick_u32 < tsy_g_LastTick_u32)
+  {
+    tsy_g_TickHigh_u32++;
+  }
+  tsy_g_LastTick_u32 = l_tick_u32;
+
+  if (tsy_g_RequestMs_u16 < TSY_PERIOD_MS)
+  {
+    tsy_g_RequestMs_u16++;
+  }
+
+  if (tsy_g_Pending_u8 && (tsy_g_RequestMs_u16 >= TSY_TIMEOUT_MS))
+  {
+    tsy_g_Pending_u8 = 0;
+    tsy_g_Model_s.lost_u32++;
+  }
+
+  if ((tsy_g_RequestMs_u16 >= TSY_PERIOD_MS) && tlm_f_IsTxIdle_u8())
+  {
+    if (tsy_g_WindowCnt_u8 >= TSY_WINDOW)
+    {
+      tsy_f_UpdateModel_v();
+      tsy_g_WindowCnt_u8 = 0;
+    }
+
+    tsy_f_SendRequest_v();
+    tsy_g_RequestMs_u16 = 0;
+    tsy_g_WindowCnt_u8++;
+  }
+
+  tsy_g_StatsMs_u16++;
+  if (tsy_g_StatsMs_u16 >= TSY_STATS_PERIOD_MS)
+  {
+    tsy_g_StatsMs_u16 = 0;
+    if (tsy_g_Model_s.synced_u8)
+    {
+      tsy_f_SendStats_v();
+    }
+  }
+}
+
+/**
+ * @brief Handle a time sync frame received over the telemetry link, called by tlm.c
+ *
+ * @param id - TLM_ID_TSY_REQ or TLM_ID_TSY_RESP
+ * @param payload - received payload
+ * @param len - payload length
+ *
+ * @return void
+ */
+void tsy_f_HandleFrame_v(uint8_t id, const uint8_t *payload, uint8_t len)
+{
+  if (id == TLM_ID_TSY_REQ)
+  {
+    tsy_f_SendReply_v(payload, len);
+  }
+  else
+  {
+    tsy_f_TakeReply_v(payload, len);
+  }
+}
+
+/**
+ * @brief Local time in microseconds since boot, from the millisecond tick and the SysTick counter
+ *
+ * Follows the clock profile switches, as SysTick is set up again for every clock. Can be called from interrupts.
+ * Right after the millisecond tick wraps (every 49 days) it is 2^32 ms behind until the next tsy_f_Handle_v()
+ *
+ * @return uint64_t - local time
+ */
+uint64_t tsy_f_LocalUs_u64(void)
+{
+  uint32_t l_high_u32;
+  uint32_t l_ms_u32;
+  uint32_t l_val_u32;
+  uint32_t l_load_u32;
+
+  do
+  {
+    l_high_u32 = tsy_g_TickHigh_u32;
+    l_ms_u32 = HAL_GetTick();
+    l_val_u32 = SysTick->VAL;
+  } while ((l_ms_u32 != HAL_GetTick()) || (l_high_u32 != tsy_g_TickHigh_u32));
+
+  l_load_u32 = SysTick->LOAD + 1;
+
+  /* The counter reloaded but the tick interrupt is held off by the caller (an interrupt or a masked section) */
+  if ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) && (l_val_u32 > (l_load_u32 / 2)))
+  {
+    l_ms_u32++;
+    if (l_ms_u32 == 0)
+    {
+      l_high_u32++;
+    }
+  }
+
+  return ((((uint64_t)l_high_u32 << 32) | l_ms_u32) * 1000) + (((l_load_u32 - 1 - l_val_u32) * 1000) / l_load_u32);
+}
+
+/**
+ * @brief Convert a local time into the time of the peer
+ *
+ * Only meaningful while tsy_g_Model_s.synced_u8 is set
+ *
+ * @param localUs - local time, see tsy_f_LocalUs_u64()
+ *
+ * @return uint64_t - the same moment in peer time
+ */
+uint64_t tsy_f_ToPeerUs_u64(uint64_t localUs)
+{
+  int64_t l_sinceRefUs_s64 = (int64_t)(localUs - tsy_g_Model_s.refLocalUs_u64);
+
+  return localUs + tsy_g_Model_s.offsetUs_s64 + ((l_sinceRefUs_s64 * tsy_g_Model_s.driftPpb_s32) / 1000000000LL);
+}
+
+/**
+ * @brief Send a request, its tag tells its reply apart from a late reply to an earlier one
+ *
+ * @return void
+ */
+void tsy_f_SendRequest_v(void)
+{
+  msg_s_TsyReq_t l_req_s;
+  uint8_t l_payload_u8[MSG_TSY_REQ_LEN];
+
+  tsy_g_Tag_u8++;
+  l_req_s.tag_u8 = tsy_g_Tag_u8;
+
+  if (tlm_f_SendFrame_u8(TLM_ID_TSY_REQ, l_payload_u8, msg_f_PackTsyReq_u8(l_payload_u8, &l_req_s)))
+  {
+    tsy_g_T1_u64 = tsy_f_LocalUs_u64() + tsy_f_FrameUs_u32(TSY_REQ_FRAME_LEN);
+    tsy_g_Pending_u8 = 1;
+  }
+}
+
+/**
+ * @brief Answer a request of the peer
+ *
+ * Payload: tag of the request u8, when the last byte of the request arrived u64 and when the last byte of this reply
+ * leaves u64, local microseconds. The reply goes out in the same tlm_f_Handle_v() if the UART is idle,
+ * otherwise it waits, which the peer sees as a longer round trip
+ *
+ * @param payload - request payload, its first byte is the tag
+ * @param len - payload length
+ *
+ * @return void
+ */
+void tsy_f_SendReply_v(const uint8_t *payload, uint8_t len)
+{
+  msg_s_TsyReq_t l_req_s;
+  msg_s_TsyResp_t l_resp_s;
+  uint8_t l_reply_u8[MSG_TSY_RESP_LEN];
+
+  if (!msg_f_UnpackTsyReq_u8(&l_req_s, payload, len))
+  {
+    return;
+  }
+
+  l_resp_s.tag_u8 = l_req_s.tag_u8;
+  l_resp_s.rxUs_u64 = tlm_g_RxFrameUs_u64;
+  if (l_resp_s.rxUs_u64 == 0)
+  {
+    l_resp_s.rxUs_u64 = tsy_f_LocalUs_u64();
+  }
+  l_resp_s.txUs_u64 = tsy_f_LocalUs_u64() + tsy_f_FrameUs_u32(TSY_RESP_FRAME_LEN);
+
+  tlm_f_SendFrame_u8(TLM_ID_TSY_RESP, l_reply_u8, msg_f_PackTsyResp_u8(l_reply_u8, &l_resp_s));
+}
+
+/**
+ * @brief Take the reply to our request, keep it if it is the best exchange of the window so far
+ *
+ * @param payload - tag u8, peer receive time u64, peer send time u64
+ * @param len - payload length
+ *
+ * @return void
+ */
+void tsy_f_TakeReply_v(const uint8_t *payload, uint8_t len)
+{
+  msg_s_TsyResp_t l_resp_s;
+  uint64_t l_t2_u64;
+  uint64_t l_t3_u64;
+  uint64_t l_t4_u64 = tlm_g_RxFrameUs_u64;
+  int64_t l_rttUs_s64;
+
+  if (!tsy_g_Pending_u8 || !msg_f_UnpackTsyResp_u8(&l_resp_s, payload, len) || (l_resp_s.tag_u8 != tsy_g_Tag_u8))
+  {
+    return;
+  }
+  tsy_g_Pending_u8 = 0;
+
+  /* Without the arrival time of the last byte the exchange is worthless */
+  if (l_t4_u64 == 0)
+  {
+    tsy_g_Model_s.lost_u32++;
+    return;
+  }
+
+  l_t2_u64 = l_resp_s.rxUs_u64;
+  l_t3_u64 = l_resp_s.txUs_u64;
+
+  l_rttUs_s64 = (int64_t)(l_t4_u64 - tsy_g_T1_u64) - (int64_t)(l_t3_u64 - l_t2_u64);
+  if (l_rttUs_s64 < 0)
+  {
+    l_rttUs_s64 = 0;
+  }
+
+  if ((uint32_t)l_rttUs_s64 < tsy_g_Best_s.rttUs_u32)
+  {
+    tsy_g_Best_s.t4_u64 = l_t4_u64;
+    tsy_g_Best_s.offsetUs_s64 = ((int64_t)(l_t2_u64 - tsy_g_T1_u64) + (int64_t)(l_t3_u64 - l_t4_u64)) / 2;
+    tsy_g_Best_s.rttUs_u32 = (uint32_t)l_rttUs_s64;
+  }
+}
+
+/**
+ * @brief Update the model with the best exchange of the window that just ended
+ *
+ * The model starts over if the exchange is far off the prediction, e.g. after the peer was reset
+ *
+ * @return void
+ */
+void tsy_f_UpdateModel_v(void)
+{
+  tsy_s_Model_t *l_model_ps = &tsy_g_Model_s;
+  int64_t l_sinceRefUs_s64;
+  int64_t l_residualUs_s64;
+  int32_t l_slopePpb_s32;
+
+  if (tsy_g_Best_s.rttUs_u32 == UINT32_MAX)
+  {
+    return;
+  }
+
+  l_sinceRefUs_s64 = (int64_t)(tsy_g_Best_s.t4_u64 - l_model_ps->refLocalUs_u64);
+  l_residualUs_s64 = tsy_g_Best_s.offsetUs_s64 - (int64_t)(tsy_f_ToPeerUs_u64(tsy_g_Best_s.t4_u64) - tsy_g_Best_s.t4_u64);
+  if (l_residualUs_s64 < 0)
+  {
+    l_residualUs_s64 = -l_residualUs_s64;
+  }
+
+  if (!l_model_ps->synced_u8 || (l_sinceRefUs_s64 <= 0) || (l_residualUs_s64 > TSY_RESYNC_US))
+  {
+    l_model_ps->driftPpb_s32 = 0;
+    l_model_ps->samples_u32 = 0;
+    l_residualUs_s64 = 0;
+  }
+  else
+  {
+    l_slopePpb_s32 = (int32_t)(((tsy_g_Best_s.offsetUs_s64 - l_model_ps->offsetUs_s64) * 1000000000LL) / l_sinceRefUs_s64);
+    if (l_model_ps->samples_u32 == 1)
+    {
+      l_model_ps->driftPpb_s32 = l_slopePpb_s32;
+    }
+    else
+    {
+      l_model_ps->driftPpb_s32 += (l_slopePpb_s32 - l_model_ps->driftPpb_s32) / TSY_DRIFT_FILTER;
+    }
+  }
+
+  l_model_ps->refLocalUs_u64 = tsy_g_Best_s.t4_u64;
+  l_model_ps->offsetUs_s64 = tsy_g_Best_s.offsetUs_s64;
+  l_model_ps->rttUs_u32 = tsy_g_Best_s.rttUs_u32;
+  l_model_ps->errorUs_u32 = (tsy_g_Best_s.rttUs_u32 / 2) + (uint32_t)l_residualUs_s64;
+  l_model_ps->samples_u32++;
+  l_model_ps->synced_u8 = 1;
+
+  tsy_g_Best_s.rttUs_u32 = UINT32_MAX;
+}
+
+/**
+ * @brief Send the model to the peer
+ *
+ * Payload: TSY_STATS, see firmware/msg/messages.py
+ *
+ * @return void
+ */
+void tsy_f_SendStats_v(void)
+{
+  msg_s_TsyStats_t l_stats_s;
+  uint8_t l_payload_u8[MSG_TSY_STATS_LEN];
+
+  l_stats_s.refUs_u64 = tsy_g_Model_s.refLocalUs_u64;
+  l_stats_s.offsetUs_s64 = tsy_g_Model_s.offsetUs_s64;
+  l_stats_s.driftPpb_s32 = tsy_g_Model_s.driftPpb_s32;
+  l_stats_s.rttUs_u32 = tsy_g_Model_s.rttUs_u32;
+  l_stats_s.errorUs_u32 = tsy_g_Model_s.errorUs_u32;
+  l_stats_s.samples_u32 = tsy_g_Model_s.samples_u32;
+  l_stats_s.lost_u32 = tsy_g_Model_s.lost_u32;
+
+  tlm_f_SendFrame_u8(TLM_ID_TSY_STATS, l_payload_u8, msg_f_PackTsyStats_u8(l_payload_u8, &l_stats_s));
+}
+
+/**
+ * @brief Time a whole frame takes on the wire, 10 bits per byte
+ *
+ * @param frameLen - frame length in bytes
+ *
+ * @return uint32_t - microseconds
+ */
+uint32_t tsy_f_FrameUs_u32(uint8_t frameLen)
+{
+  return ((uint32_t)frameLen * 10 * 1000000) / huart4.Init.BaudRate;
+}
@@ -0,0 +1,614 @@
+/**
+ * @file upd.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Firmware update software component
+ *
+ * Receives a new application over the telemetry link (UART4 at 1Mbaud) into the staging area of the flash,
+ * while the current application keeps running. Only once the whole image is in and its CRC-32 checks out,
+ * the update is committed and the hand resets, the boot stage (boot.c) then swaps it with the application.
+ * The image is the application part of the build only (from BOOT_APP_ADDRESS on, without the .boot section),
+ * the boot stage itself is never updated.
+ *
+ * The host drives the update with BEGIN (size u32, CRC-32 u32), DATA (offset u32, up to UPD_CHUNK_SIZE bytes),
+ * COMMIT and STATUS frames, and waits for the reply (TLM_ID_UPD_REPLY) to each one before it sends the next:
+ * request ID u8, status u8 (upd_Status_e), state u8 (upd_State_e), next offset u32, image u8 (upd_Image_e),
+ * CRC-32 of the image u32.
+ * Erasing and programming stall the CPU, interrupts included, so a byte the host sends in the meantime is lost.
+ * Every request can simply be repeated when its reply doesn't come. Each chunk is protected by the frame CRC
+ * and read back after programming. A BEGIN with the same size and CRC as an update that was cut short
+ * (reset, cable pulled) resumes it from the last chunk in the staging area instead of erasing it again.
+ *
+ * A newly installed image confirms itself with the first update frame that reaches it, a STATUS is enough,
+ * proving the host can still get the next update to it. Until then the boot stage swaps the old one back on
+ * any reset, which the host sees as UPD_IMAGE_REVERTED.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "upd_e.h"
+#include "upd_i.h"
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief State of the firmware update
+ *
+ */
+upd_State_e upd_g_State_e;
+
+/**
+ * @brief Next offset into the image the update expects a chunk for
+ *
+ */
+uint32_t upd_g_Next_u32;
+
+/**
+ * @brief Next staging page to erase (ERASING), next offset to run the CRC over (VERIFYING),
+ * or milliseconds left until the reset (COMMITTED)
+ *
+ */
+uint32_t upd_g_Progress_u32;
+
+/**
+ * @brief CRC of the staged image so far, while verifying
+ *
+ */
+uint32_t upd_g_Crc_u32;
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+void upd_f_Init_v(void);
+void upd_f_Handle_v(void);
+void upd_f_HandleFrame_v(uint8_t id, const uint8_t *payload, uint8_t len);
+uint8_t upd_f_IsBusy_u8(void);
+
+void upd_f_Begin_v(const uint8_t *payload, uint8_t len);
+void upd_f_Data_v(const uint8_t *payload, uint8_t len);
+void upd_f_Commit_v(void);
+void upd_f_Confirm_v(void);
+upd_Image_e upd_f_Image_e(void);
+void upd_f_Reply_v(uint8_t id, upd_Status_e status);
+uint32_t upd_f_ResumeOffset_u32(uint32_t size);
+uint8_t upd_f_ErasePage_u8(uint32_t address);
+uint8_t upd_f_Program_u8(uint32_t address, const uint8_t *data, uint32_t len);
+uint8_t upd_f_SetFlag_u8(const volatile uint16_t *flag);
+uint32_t upd_f_Crc32_u32(uint32_t crc, uint32_t address, uint32_t len);
+
+/**
+ * @brief Initialise function to be called once on boot, after tlm_f_Init_v()
+ *
+ * @return void
+ */
+void upd_f_Init_v(void)
+{
+  upd_g_State_e = UPD_IDLE;
+  upd_g_Next_u32 = 0;
+}
+
+/**
+ * @brief Handle function to be called every millisecond
+ *
+ * Does the work that is too long for a single millisecond a slice at a time, and replies once it is done
+ *
+ * @return void
+ */
+void upd_f_Handle_v(void)
+{
+  const boot_s_Control_t *l_control_ps = (const boot_s_Control_t *)BOOT_CONTROL_ADDRESS;
+  uint32_t l_len_u32;
+
+  switch (upd_g_State_e)
+  {
+  case UPD_ERASING:
+    if (!upd_f_ErasePage_u8(BOOT_STAGE_ADDRESS + (upd_g_Progress_u32 * FLASH_PAGE_SIZE)))
+    {
+      upd_g_State_e = UPD_IDLE;
+      upd_f_Reply_v(TLM_ID_UPD_BEGIN, UPD_STATUS_FLASH_ERROR);
+      break;
+    }
+
+    upd_g_Progress_u32++;
+    if ((upd_g_Progress_u32 * FLASH_PAGE_SIZE) >= l_control_ps->size_u32)
+    {
+      if (upd_f_SetFlag_u8(&l_control_ps->erased_u16))
+      {
+        upd_g_State_e = UPD_RECEIVING;
+        upd_f_Reply_v(TLM_ID_UPD_BEGIN, UPD_STATUS_OK);
+      }
+      else
+      {
+        upd_g_State_e = UPD_IDLE;
+        upd_f_Reply_v(TLM_ID_UPD_BEGIN, UPD_STATUS_FLASH_ERROR);
+      }
+    }
+    break;
+
+  case UPD_VERIFYING:
+    l_len_u32 = l_control_ps->size_u32 - upd_g_Progress_u32;
+    if (l_len_u32 > UPD_VERIFY_SLICE)
+    {
+      l_len_u32 = UPD_VERIFY_SLICE;
+    }
+    upd_g_Crc_u32 = upd_f_Crc32_u32(upd_g_Crc_u32, BOOT_STAGE_ADDRESS + upd_g_Progress_u32, l_len_u32);
+    upd_g_Progress_u32 += l_len_u32;
+
+    if (upd_g_Progress_u32 >= l_control_ps->size_u32)
+    {
+      if ((~upd_g_Crc_u32 == l_control_ps->crc_u32) && upd_f_SetFlag_u8(&l_control_ps->committed_u16))
+      {
+        upd_g_State_e = UPD_COMMITTED;
+        upd_g_Progress_u32 = UPD_RESET_DELAY_MS;
+        upd_f_Reply_v(TLM_ID_UPD_COMMIT, UPD_STATUS_OK);
+      }
+      else
+      {
+        /* Invalidate the record, so the next begin starts over instead of resuming the broken image */
+        upd_f_ErasePage_u8(BOOT_CONTROL_ADDRESS);
+        upd_g_State_e = UPD_IDLE;
+        upd_f_Reply_v(TLM_ID_UPD_COMMIT, UPD_STATUS_BAD_CRC);
+      }
+    }
+    break;
+
+  case UPD_COMMITTED:
+    if (upd_g_Progress_u32 > 0)
+    {
+      upd_g_Progress_u32--;
+    }
+    else
+    {
+      NVIC_SystemReset();
+    }
+    break;
+
+  case UPD_IDLE:
+  case UPD_RECEIVING:
+  default:
+    break;
+  }
+}
+
+/**
+ * @brief Handle a firmware update frame received from the host, called by tlm.c
+ *
+ * @param id - frame ID, one of the TLM_ID_UPD_* host -> device IDs
+ * @param payload - received payload
+ * @param len - payload length
+ *
+ * @return void
+ */
+void upd_f_HandleFrame_v(uint8_t id, const uint8_t *payload, uint8_t len)
+{
+  upd_f_Confirm_v();
+
+  switch (id)
+  {
+  case TLM_ID_UPD_BEGIN:
+    upd_f_Begin_v(payload, len);
+    break;
+  case TLM_ID_UPD_DATA:
+    upd_f_Data_v(payload, len);
+    break;
+  case TLM_ID_UPD_COMMIT:
+    upd_f_Commit_v();
+    break;
+  case TLM_ID_UPD_STATUS:
+  default:
+    upd_f_Reply_v(id, UPD_STATUS_OK);
+    break;
+  }
+}
+
+/**
+ * @brief Whether an update is running, the clock has to stay in the full profile meanwhile
+ *
+ * A clock switch re-initialises the UART, which would cut off the frames of the update
+ *
+ * @return uint8_t - 1 if an update is running, 0 if not
+ */
+uint8_t upd_f_IsBusy_u8(void)
+{
+  return (upd_g_State_e != UPD_IDLE);
+}
+
+/**
+ * @brief Start a new update, or resume the one that was cut short if it is for the same image
+ *
+ * A new update erases the staging area first, its reply is only sent once that is done
+ *
+ * @param payload - size of the image u32, CRC-32 of the image u32
+ * @param len - payload length
+ *
+ * @return void
+ */
+void upd_f_Begin_v(const uint8_t *payload, uint8_t len)
+{
+  const boot_s_Control_t *l_control_ps = (const boot_s_Control_t *)BOOT_CONTROL_ADDRESS;
+  msg_s_UpdBegin_t l_begin_s;
+  boot_s_Control_t l_header_s;
+  uint8_t l_same_u8;
+  uint8_t i;
+
+  if (!msg_f_UnpackUpdBegin_u8(&l_begin_s, payload, len))
+  {
+    upd_f_Reply_v(TLM_ID_UPD_BEGIN, UPD_STATUS_BAD_REQUEST);
+    return;
+  }
+
+  l_header_s.magic_u32 = BOOT_MAGIC;
+  l_header_s.size_u32 = l_begin_s.size_u32;
+  l_header_s.crc_u32 = l_begin_s.crc_u32;
+
+  l_same_u8 = ((l_control_ps->magic_u32 == BOOT_MAGIC) &&
+               (l_control_ps->size_u32 == l_header_s.size_u32) &&
+               (l_control_ps->crc_u32 == l_header_s.crc_u32) &&
+               (l_control_ps->committed_u16 != BOOT_FLAG_SET));
+
+  if (l_same_u8 && (upd_g_State_e != UPD_IDLE))
+  {
+    /* A repeated begin, the reply to the first one either is on its way or got lost */
+    if (upd_g_State_e != UPD_ERASING)
+    {
+      upd_f_Reply_v(TLM_ID_UPD_BEGIN, UPD_STATUS_OK);
+    }
+    return;
+  }
+
+  if ((upd_g_State_e == UPD_VERIFYING) || (upd_g_State_e == UPD_COMMITTED))
+  {
+    upd_f_Reply_v(TLM_ID_UPD_BEGIN, UPD_STATUS_BAD_STATE);
+    return;
+  }
+
+  if (cal_f_IsRunning_u8() || hom_f_IsRunning_u8())
+  {
+    upd_f_Reply_v(TLM_ID_UPD_BEGIN, UPD_STATUS_REFUSED);
+    return;
+  }
+
+  for (i = 0; i < MOT_COUNT; i++)
+  {
+    if (mot_g_Duty_s16[i] != 0)
+    {
+      upd_f_Reply_v(TLM_ID_UPD_BEGIN, UPD_STATUS_REFUSED);
+      return;
+    }
+  }
+
+  if ((l_header_s.size_u32 == 0) || (l_header_s.size_u32 > BOOT_IMAGE_SIZE))
+  {
+    upd_f_Reply_v(TLM_ID_UPD_BEGIN, UPD_STATUS_BAD_REQUEST);
+    return;
+  }
+
+  if (l_same_u8 && (l_control_ps->erased_u16 == BOOT_FLAG_SET))
+  {
+    upd_g_Next_u32 = upd_f_ResumeOffset_u32(l_header_s.size_u32);
+    upd_g_State_e = UPD_RECEIVING;
+    upd_f_Reply_v(TLM_ID_UPD_BEGIN, UPD_STATUS_OK);
+    return;
+  }
+
+  /* A new image: a fresh record without any flags set, then the staging area is erased a page at a time */
+  if (!upd_f_ErasePage_u8(BOOT_CONTROL_ADDRESS) ||
+      !upd_f_Program_u8(BOOT_CONTROL_ADDRESS, (const uint8_t *)&l_header_s, 3 * sizeof(uint32_t)))
+  {
+    upd_g_State_e = UPD_IDLE;
+    upd_f_Reply_v(TLM_ID_UPD_BEGIN, UPD_STATUS_FLASH_ERROR);
+    return;
+  }
+
+  upd_g_Next_u32 = 0;
+  upd_g_Progress_u32 = 0;
+  upd_g_State_e = UPD_ERASING;
+}
+
+/**
+ * @brief Program the next chunk of the image into the staging area
+ *
+ * Halfwords already holding the right value are skipped, so a chunk that was cut short can be written again
+ *
+ * @param payload - offset into the image u32, then the chunk, an even number of bytes unless it is the last one
+ * @param len - payload length
+ *
+ * @return void
+ */
+void upd_f_Data_v(const uint8_t *payload, uint8_t len)
+{
+  const boot_s_Control_t *l_control_ps = (const boot_s_Control_t *)BOOT_CONTROL_ADDRESS;
+  msg_s_UpdData_t l_data_s;
+  uint32_t l_offset_u32;
+  uint32_t l_len_u32;
+
+  if (upd_g_State_e != UPD_RECEIVING)
+  {
+    upd_f_Reply_v(TLM_ID_UPD_DATA, UPD_STATUS_BAD_STATE);
+    return;
+  }
+
+  if (!msg_f_UnpackUpdData_u8(&l_data_s, payload, len) || (l_data_s.dataLen_u8 == 0) || (l_data_s.dataLen_u8 > UPD_CHUNK_SIZE))
+  {
+    upd_f_Reply_v(TLM_ID_UPD_DATA, UPD_STATUS_BAD_REQUEST);
+    return;
+  }
+
+  l_offset_u32 = l_data_s.offset_u32;
+  l_len_u32 = l_data_s.dataLen_u8;
+
+  if (l_offset_u32 != upd_g_Next_u32)
+  {
+    upd_f_Reply_v(TLM_ID_UPD_DATA, UPD_STATUS_BAD_OFFSET);
+    return;
+  }
+
+  if (((l_offset_u32 + l_len_u32) > l_control_ps->size_u32) ||
+      (((l_len_u32 % 2) != 0) && ((l_offset_u32 + l_len_u32) != l_control_ps->size_u32)))
+  {
+    upd_f_Reply_v(TLM_ID_UPD_DATA, UPD_STATUS_BAD_REQUEST);
+    return;
+  }
+
+  if (!upd_f_Program_u8(BOOT_STAGE_ADDRESS + l_offset_u32, l_data_s.data_pu8, l_len_u32))
+  {
+    upd_f_ErasePage_u8(BOOT_CONTROL_ADDRESS);
+    upd_g_State_e = UPD_IDLE;
+    upd_f_Reply_v(TLM_ID_UPD_DATA, UPD_STATUS_FLASH_ERROR);
+    return;
+  }
+
+  upd_g_Next_u32 += l_len_u32;
+  upd_f_Reply_v(TLM_ID_UPD_DATA, UPD_STATUS_OK);
+}
+
+/**
+ * @brief Start checking the whole staged image, the reply is sent once that is done
+ *
+ * @return void
+ */
+void upd_f_Commit_v(void)
+{
+  const boot_s_Control_t *l_control_ps = (const boot_s_Control_t *)BOOT_CONTROL_ADDRESS;
+
+  if ((upd_g_State_e == UPD_VERIFYING) || (upd_g_State_e == UPD_COMMITTED))
+  {
+    /* A repeated commit, only reply again once committed */
+    if (upd_g_State_e == UPD_COMMITTED)
+    {
+      upd_f_Reply_v(TLM_ID_UPD_COMMIT, UPD_STATUS_OK);
+    }
+    return;
+  }
+
+  if ((upd_g_State_e != UPD_RECEIVING) || (upd_g_Next_u32 != l_control_ps->size_u32))
+  {
+    upd_f_Reply_v(TLM_ID_UPD_COMMIT, UPD_STATUS_BAD_STATE);
+    return;
+  }
+
+  upd_g_Crc_u32 = 0xFFFFFFFFUL;
+  upd_g_Progress_u32 = 0;
+  upd_g_State_e = UPD_VERIFYING;
+}
+
+/**
+ * @brief Keep a newly installed image, now that an update frame of the host reached it
+ *
+ * Before anything else, a begin erases the old image in the staging area the boot stage would swap back
+ *
+ * @return void
+ */
+void upd_f_Confirm_v(void)
+{
+  const boot_s_Control_t *l_control_ps = (const boot_s_Control_t *)BOOT_CONTROL_ADDRESS;
+
+  if (upd_f_Image_e() == UPD_IMAGE_TRIAL)
+  {
+    upd_f_SetFlag_u8(&l_control_ps->confirmed_u16);
+  }
+}
+
+/**
+ * @brief Where the last committed image stands with the boot stage, from the flags of the control record
+ *
+ * @return upd_Image_e - see there
+ */
+upd_Image_e upd_f_Image_e(void)
+{
+  const boot_s_Control_t *l_control_ps = (const boot_s_Control_t *)BOOT_CONTROL_ADDRESS;
+
+  if ((l_control_ps->magic_u32 != BOOT_MAGIC) || (l_control_ps->committed_u16 != BOOT_FLAG_SET))
+  {
+    return UPD_IMAGE_NONE;
+  }
+  if (l_control_ps->reverted_u16 == BOOT_FLAG_SET)
+  {
+    return UPD_IMAGE_REVERTED;
+  }
+  if (l_control_ps->installed_u16 != BOOT_FLAG_SET)
+  {
+    return UPD_IMAGE_COMMITTED;
+  }
+  if (l_control_ps->confirmed_u16 != BOOT_FLAG_SET)
+  {
+    return UPD_IMAGE_TRIAL;
+  }
+  return UPD_IMAGE_CONFIRMED;
+}
+
+/**
+ * @brief Send the reply to an update frame
+ *
+ * @param id - ID of the frame replied to
+ * @param status - outcome
+ *
+ * @return void
+ */
+void upd_f_Reply_v(uint8_t id, upd_Status_e status)
+{
+  msg_s_UpdReply_t l_reply_s;
+  uint8_t l_payload_u8[MSG_UPD_REPLY_LEN];
+
+  l_reply_s.reqId_u8 = id;
+  l_reply_s.status_u8 = (uint8_t)status;
+  l_reply_s.state_u8 = (uint8_t)upd_g_State_e;
+  l_reply_s.next_u32 = upd_g_Next_u32;
+  l_reply_s.image_u8 = (uint8_t)upd_f_Image_e();
+  l_reply_s.crc_u32 = (l_reply_s.image_u8 != UPD_IMAGE_NONE) ? ((const boot_s_Control_t *)BOOT_CONTROL_ADDRESS)->crc_u32 : 0;
+
+  tlm_f_SendFrame_u8(TLM_ID_UPD_REPLY, l_payload_u8, msg_f_PackUpdReply_u8(l_payload_u8, &l_reply_s));
+}
+
+/**
+ * @brief Where an update that was cut short carries on
+ *
+ * Chunks are written in order, so everything up to the last programmed byte is in. That chunk may be cut short,
+ * so it is sent again from its start
+ *
+ * @param size - size of the image
+ *
+ * @return uint32_t - offset of the first chunk to send again
+ */
+uint32_t upd_f_ResumeOffset_u32(uint32_t size)
+{
+  const uint8_t *l_stage_pu8 = (const uint8_t *)BOOT_STAGE_ADDRESS;
+  uint32_t l_end_u32 = size;
+
+  while ((l_end_u32 > 0) && (l_stage_pu8[l_end_u32 - 1] == 0xFF))
+  {
+    l_end_u32--;
+  }
+
+  return l_end_u32 - (l_end_u32 % UPD_CHUNK_SIZE);
+}
+
+/**
+ * @brief Erase one flash page
+ *
+ * @param address - start of the page
+ *
+ * @return uint8_t - 1 if erased, 0 on a flash error
+ */
+uint8_t upd_f_ErasePage_u8(uint32_t address)
+{
+  FLASH_EraseInitTypeDef l_erase_s = {0};
+  uint32_t l_pageError_u32;
+  uint8_t l_ok_u8;
+
+  l_erase_s.TypeErase = FLASH_TYPEERASE_PAGES;
+  l_erase_s.PageAddress = address;
+  l_erase_s.NbPages = 1;
+
+  HAL_FLASH_Unlock();
+  l_ok_u8 = (HAL_FLASHEx_Erase(&l_erase_s, &l_pageError_u32) == HAL_OK);
+  HAL_FLASH_Lock();
+
+  return l_ok_u8;
+}
+
+/**
+ * @brief Program bytes into erased flash and read them back
+ *
+ * A halfword already holding the right value is skipped, one holding anything else but the erased value fails
+ *
+ * @param address - halfword aligned start
+ * @param data - bytes to program, an odd last byte is padded with 0xFF
+ * @param len - number of bytes
+ *
+ * @return uint8_t - 1 if the flash holds the bytes, 0 otherwise
+ */
+uint8_t upd_f_Program_u8(uint32_t address, const uint8_t *data, uint32_t len)
+{
+  uint16_t l_halfWord_u16;
+  uint16_t l_current_u16;
+  uint32_t i;
+  uint8_t l_ok_u8 = 1;
+
+  HAL_FLASH_Unlock();
+
+  for (i = 0; (i < len) && l_ok_u8; i += 2)
+  {
+    l_halfWord_u16 = data[i];
+    l_halfWord_u16 |= ((i + 1) < len) ? ((uint16_t)data[i + 1] << 8) : 0xFF00;
+
+    l_current_u16 = *(const volatile uint16_t *)(address + i);
+    if (l_current_u16 == l_halfWord_u16)
+    {
+      continue;
+    }
+
+    if ((l_current_u16 != 0xFFFF) || (HAL_FLASH_Program(FLASH_TYPEPROGRAM_HALFWORD, address + i, l_halfWord_u16) != HAL_OK))
+    {
+      l_ok_u8 = 0;
+    }
+  }
+
+  HAL_FLASH_Lock();
+
+  for (i = 0; (i < len) && l_ok_u8; i++)
+  {
+    l_ok_u8 = (*(const volatile uint8_t *)(address + i) == data[i]);
+  }
+
+  return l_ok_u8;
+}
+
+/**
+ * @brief Set a flag of the control record, see BOOT_FLAG_SET
+ *
+ * @param flag - flag inside the control record
+ *
+ * @return uint8_t - 1 if the flag is set, 0 on a flash error
+ */
+uint8_t upd_f_SetFlag_u8(const volatile uint16_t *flag)
+{
+  HAL_FLASH_Unlock();
+  HAL_FLASH_Program(FLASH_TYPEPROGRAM_HALFWORD, (uint32_t)flag, BOOT_FLAG_SET);
+  HAL_FLASH_Lock();
+
+  return (*flag == BOOT_FLAG_SET);
+}
+
+/**
+ * @brief Standard CRC-32 (reflected, polynomial 0xEDB88320) over flash, in slices
+ *
+ * Start with 0xFFFFFFFF and invert the result of the last slice, the CRC is then the same as nvm_f_Crc32_u32()
+ * and boot_f_Crc32_u32(). The boot stage has its own copy, as a new application may be linked differently
+ *
+ * @param crc - CRC of the slices so far
+ * @param address - start of the slice
+ * @param len - number of bytes
+ *
+ * @return uint32_t - CRC including this slice
+ */
+uint32_t upd_f_Crc32_u32(uint32_t crc, uint32_t address, uint32_t len)
+{
+  const uint8_t *l_data_pu8 = (const uint8_t *)address;
+  uint32_t i;
+  uint8_t j;
+
+  for (i = 0; i < len; i++)
+  {
+    crc ^= l_data_pu8[i];
+    for (j = 0; j < 8; j++)
+    {
+      crc = (crc & 1) ? ((crc >> 1) ^ 0xEDB88320UL) : (crc >> 1);
+    }
+  }
+
+  return crc;
+}
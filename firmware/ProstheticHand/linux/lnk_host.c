@@ -0,0 +1,597 @@
+/**
+ * @file lnk_host.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Host build of the telemetry link of the firmware
+ *
+ * Runs the link protocol (drivers/lnk) and the generated messages (drivers/msg) on a PC, so the host tools can be
+ * run and regression-tested against the real framing without the hand, the UART adapter or BLE. The transport is
+ * either a pseudo-terminal, which the host tools open like the USB-UART adapter of the board (openSerial()), or a
+ * TCP socket on localhost. It answers PING with PONG, keeps the configuration parameters in memory (CFG_SET / CFG)
+ * and sends LINK_STATS of its transport every second, like the firmware does on each of its transports. The telemetry
+ * task itself (drivers/tlm: subscriptions, SIGNALS and the other periodic frames) is not part of it, that needs the
+ * UART driver, FreeRTOS and the input modules of the ESP-IDF build.
+ *
+ * With --stream it also sends RTM frames at the given rate in bytes per second, paced every telemetry period like
+ * the TX buffer of the UART drains (100000 B/s is the 1 Mbaud link). Their timestamp is CLOCK_MONOTONIC, the
+ * steady_clock of a host tool on the same machine, so the tool can measure the latency of every single frame from
+ * the moment it was built here to its callback.
+ *
+ * Built with the host tools (host/CMakeLists.txt, target openhand-fwlink), or on its own with:
+ *   gcc -std=gnu17 -Wall -I../src -o lnk_host lnk_host.c ../src/drivers/lnk/lnk.c ../src/drivers/msg/msg.c
+ * and run with the transport:
+ *   ./lnk_host --pty /tmp/openhand [--stream 100000]    then e.g. openhand-dump --serial /tmp/openhand
+ *   ./lnk_host --tcp 5760                                then e.g. openhand-dump --tcp localhost:5760
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/* posix_openpt() and the rest of the pseudo-terminal calls */
+#define _GNU_SOURCE
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "errno.h"
+#include "signal.h"
+#include "time.h"
+#include "unistd.h"
+#include "fcntl.h"
+#include "poll.h"
+#include "termios.h"
+#include "arpa/inet.h"
+#include "netinet/in.h"
+#include "sys/socket.h"
+
+#include "drivers/lnk/lnk_e.h"
+#include "drivers/msg/msg_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+#define HOST_DEFAULT_PORT 5760
+
+/**
+ * @brief Same periods as the telemetry task of the firmware
+ *
+ * @values in milliseconds
+ */
+#define HOST_PERIOD_MS 10
+#define HOST_STATS_PERIOD_MS 1000
+
+/**
+ * @brief How long a frame may wait for room in the pseudo-terminal before it is dropped
+ *
+ * The UART driver of the firmware takes a frame whole or not at all, the pseudo-terminal can take part of it
+ *
+ * @values in milliseconds
+ */
+#define HOST_WRITE_TIMEOUT_MS 10
+
+/**
+ * @brief Value in CFG_SET that leaves a parameter as it is, CFG_KEEP of drivers/cfg
+ *
+ */
+#define HOST_CFG_KEEP 0xFFFF
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Listening socket, -1 with a pseudo-terminal
+ *
+ */
+int host_g_Server_s32 = -1;
+
+/**
+ * @brief Connected socket, or the master side of the pseudo-terminal, -1 while there is none
+ *
+ */
+int host_g_Fd_s32 = -1;
+
+/**
+ * @brief Whether the transport is a pseudo-terminal
+ *
+ */
+uint8_t host_g_Pty_u8 = 0;
+
+/**
+ * @brief Symbolic link to the pseudo-terminal, removed again on exit
+ *
+ */
+const char *host_g_PtyLink_pc = 0;
+
+/**
+ * @brief RTM frames streamed per second, 0 for none
+ *
+ * @values in bytes per second
+ */
+uint32_t host_g_StreamRate_u32 = 0;
+
+/**
+ * @brief Set by SIGINT / SIGTERM
+ *
+ */
+volatile sig_atomic_t host_g_Stop_u8 = 0;
+
+/**
+ * @brief Configuration parameters, as many and in the order of CFG_PARAMS in firmware/msg/messages.py
+ *
+ * The values are not checked like on the hand, a parameter without a default here starts at 0
+ */
+uint16_t host_g_Cfg_u16[MSG_PARAM_COUNT] = {
+    [MSG_PARAM_SNS1_THRESHOLD] = 2000,
+    [MSG_PARAM_SNS2_THRESHOLD] = 2000,
+    [MSG_PARAM_SRV1_RANGE] = 90,
+    [MSG_PARAM_SRV2_RANGE] = 90,
+    [MSG_PARAM_SRV3_RANGE] = 90,
+    [MSG_PARAM_OS_STATS_PERIOD] = 1000};
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+uint8_t host_f_OpenTcp_u8(uint16_t port);
+uint8_t host_f_OpenPty_u8(const char *link);
+void host_f_Connection_v(int timeoutMs);
+uint8_t host_f_Write_u8(const uint8_t *frame, uint16_t len);
+void host_f_HandleFrame_v(lnk_s_Transport_t *transport, uint8_t id, const uint8_t *payload, uint8_t len);
+void host_f_SendCfg_v(lnk_s_Transport_t *transport);
+void host_f_SendLinkStats_v(lnk_s_Transport_t *transport);
+void host_f_SendRtm_v(lnk_s_Transport_t *transport);
+void host_f_OnSignal_v(int sig);
+int64_t host_f_NowUs_s64(void);
+
+/**
+ * @brief The socket or pseudo-terminal as a transport of the link
+ *
+ */
+lnk_s_Transport_t host_g_Transport_s = {
+    .name_pc = "HOST",
+    .write_pf = host_f_Write_u8,
+    .flush_pf = 0,
+    .poll_pf = 0,
+    .connected_u8 = 0};
+
+int main(int argc, char **argv)
+{
+  const char *l_pty_pc = 0;
+  uint16_t l_port_u16 = HOST_DEFAULT_PORT;
+  int64_t l_nowUs_s64;
+  int64_t l_nextPeriodUs_s64;
+  int64_t l_nextStatsUs_s64;
+  uint32_t l_lastTxBytes_u32 = 0;
+  uint32_t l_streamBudget_u32 = 0;
+  int l_timeoutMs_s32;
+  int i;
+
+  for (i = 1; i < argc; i++)
+  {
+    if ((strcmp(argv[i], "--tcp") == 0) && (i + 1 < argc))
+    {
+      l_port_u16 = (uint16_t)atoi(argv[++i]);
+    }
+    else if ((strcmp(argv[i], "--pty") == 0) && (i + 1 < argc))
+    {
+      l_pty_pc = argv[++i];
+    }
+    else if ((strcmp(argv[i], "--stream") == 0) && (i + 1 < argc))
+    {
+      host_g_StreamRate_u32 = (uint32_t)strtoul(argv[++i], 0, 10);
+    }
+    else
+    {
+      fprintf(stderr, "usage: lnk_host [--tcp PORT | --pty LINK] [--stream BYTES_PER_SEC]\n");
+      return 2;
+    }
+  }
+
+  if (!((l_pty_pc != 0) ? host_f_OpenPty_u8(l_pty_pc) : host_f_OpenTcp_u8(l_port_u16)))
+  {
+    return 1;
+  }
+  fflush(stdout);
+
+  signal(SIGINT, host_f_OnSignal_v);
+  signal(SIGTERM, host_f_OnSignal_v);
+
+  lnk_f_Init_v(host_f_HandleFrame_v);
+  lnk_f_Add_u8(&host_g_Transport_s);
+  l_nextPeriodUs_s64 = host_f_NowUs_s64() + HOST_PERIOD_MS * 1000LL;
+  l_nextStatsUs_s64 = host_f_NowUs_s64() + HOST_STATS_PERIOD_MS * 1000LL;
+
+  while (!host_g_Stop_u8)
+  {
+    /* Handle what comes in until the next telemetry period is due */
+    l_timeoutMs_s32 = (int)((l_nextPeriodUs_s64 - host_f_NowUs_s64() + 999) / 1000);
+    host_f_Connection_v((l_timeoutMs_s32 > 0) ? l_timeoutMs_s32 : 0);
+
+    l_nowUs_s64 = host_f_NowUs_s64();
+    if (l_nowUs_s64 < l_nextPeriodUs_s64)
+    {
+      continue;
+    }
+    l_nextPeriodUs_s64 += HOST_PERIOD_MS * 1000LL;
+    if (l_nextPeriodUs_s64 < l_nowUs_s64)
+    {
+      /* Fell behind (suspended, debugger), don't send the missed periods all at once */
+      l_nextPeriodUs_s64 = l_nowUs_s64 + HOST_PERIOD_MS * 1000LL;
+    }
+
+    /* As much as the link takes in one period, like the UART of the firmware */
+    if ((host_g_StreamRate_u32 > 0) && host_g_Transport_s.connected_u8)
+    {
+      l_streamBudget_u32 += host_g_StreamRate_u32 * HOST_PERIOD_MS / 1000;
+      while (l_streamBudget_u32 >= LNK_HEADER_LEN + MSG_RTM_LEN + LNK_CRC_LEN)
+      {
+        l_streamBudget_u32 -= LNK_HEADER_LEN + MSG_RTM_LEN + LNK_CRC_LEN;
+        host_f_SendRtm_v(&host_g_Transport_s);
+      }
+    }
+    else
+    {
+      l_streamBudget_u32 = 0;
+    }
+
+    if (l_nowUs_s64 >= l_nextStatsUs_s64)
+    {
+      l_nextStatsUs_s64 += HOST_STATS_PERIOD_MS * 1000LL;
+      host_g_Transport_s.stats_s.txBytesPerSec_u32 = (host_g_Transport_s.stats_s.txBytes_u32 - l_lastTxBytes_u32) * 1000 / HOST_STATS_PERIOD_MS;
+      l_lastTxBytes_u32 = host_g_Transport_s.stats_s.txBytes_u32;
+      if (host_g_Transport_s.connected_u8)
+      {
+        host_f_SendLinkStats_v(&host_g_Transport_s);
+      }
+    }
+  }
+
+  if (host_g_PtyLink_pc != 0)
+  {
+    unlink(host_g_PtyLink_pc);
+  }
+  printf("Sent %u frames (%u bytes), dropped %u, received %u, errors %u\n",
+         host_g_Transport_s.stats_s.txFrames_u32, host_g_Transport_s.stats_s.txBytes_u32, host_g_Transport_s.stats_s.txDropped_u32,
+         host_g_Transport_s.stats_s.rxFrames_u32, host_g_Transport_s.stats_s.rxErrors_u32);
+  return 0;
+}
+
+/**
+ * @brief Listen on localhost for one host at a time, like over BLE
+ *
+ * @param port to listen on
+ * @return 1 if listening, 0 on error
+ */
+uint8_t host_f_OpenTcp_u8(uint16_t port)
+{
+  struct sockaddr_in l_addr_s;
+  int l_one_s32 = 1;
+
+  memset(&l_addr_s, 0, sizeof(l_addr_s));
+  l_addr_s.sin_family = AF_INET;
+  l_addr_s.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  l_addr_s.sin_port = htons(port);
+
+  host_g_Server_s32 = socket(AF_INET, SOCK_STREAM, 0);
+  setsockopt(host_g_Server_s32, SOL_SOCKET, SO_REUSEADDR, &l_one_s32, sizeof(l_one_s32));
+  if ((bind(host_g_Server_s32, (struct sockaddr *)&l_addr_s, sizeof(l_addr_s)) != 0) || (listen(host_g_Server_s32, 1) != 0))
+  {
+    perror("lnk_host");
+    return 0;
+  }
+
+  printf("Listening on 127.0.0.1:%u\n", port);
+  return 1;
+}
+
+/**
+ * @brief Open a pseudo-terminal in raw mode and link it to where the host tools look for it
+ *
+ * The slave side is opened and closed once, so the master reports a hangup until a host tool opens it: that is
+ * how host_f_Connection_v() tells whether someone listens
+ *
+ * @param link path of the symbolic link to the slave side, replaced if it exists
+ * @return 1 if it is open, 0 on error
+ */
+uint8_t host_f_OpenPty_u8(const char *link)
+{
+  struct termios l_tio_s;
+  const char *l_name_pc;
+  int l_slave_s32;
+
+  host_g_Fd_s32 = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+  if ((host_g_Fd_s32 < 0) || (grantpt(host_g_Fd_s32) != 0) || (unlockpt(host_g_Fd_s32) != 0) ||
+      ((l_name_pc = ptsname(host_g_Fd_s32)) == 0))
+  {
+    perror("lnk_host: pty");
+    return 0;
+  }
+
+  /* Raw 8N1 like the UART, the host tools set it up the same way when they open it */
+  l_slave_s32 = open(l_name_pc, O_RDWR | O_NOCTTY);
+  if ((l_slave_s32 < 0) || (tcgetattr(l_slave_s32, &l_tio_s) != 0))
+  {
+    perror("lnk_host: pty");
+    return 0;
+  }
+  cfmakeraw(&l_tio_s);
+  tcsetattr(l_slave_s32, TCSANOW, &l_tio_s);
+  close(l_slave_s32);
+
+  unlink(link);
+  if (symlink(l_name_pc, link) != 0)
+  {
+    perror("lnk_host: symlink");
+    return 0;
+  }
+
+  host_g_Pty_u8 = 1;
+  host_g_PtyLink_pc = link;
+  printf("Serial port %s -> %s\n", link, l_name_pc);
+  return 1;
+}
+
+/**
+ * @brief Wait up to timeoutMs for the host: accept or notice it, and hand what it sent to the link
+ *
+ * @return void
+ */
+void host_f_Connection_v(int timeoutMs)
+{
+  struct pollfd l_fd_s;
+  uint8_t l_buf_u8[256];
+  ssize_t l_cnt_s32;
+  uint8_t l_connected_u8;
+
+  l_fd_s.fd = (host_g_Fd_s32 < 0) ? host_g_Server_s32 : host_g_Fd_s32;
+  l_fd_s.events = POLLIN;
+  l_fd_s.revents = 0;
+
+  if (poll(&l_fd_s, 1, timeoutMs) < 0)
+  {
+    return;
+  }
+
+  if (host_g_Pty_u8)
+  {
+    /* The master side hangs up while no host has the slave side open */
+    l_connected_u8 = !(l_fd_s.revents & POLLHUP);
+    if (l_connected_u8 != host_g_Transport_s.connected_u8)
+    {
+      host_g_Transport_s.connected_u8 = l_connected_u8;
+      host_g_Transport_s.rx_s.state_e = LNK_RX_SYNC_1;
+      printf(l_connected_u8 ? "Host connected\n" : "Host disconnected\n");
+      fflush(stdout);
+    }
+    if (!l_connected_u8)
+    {
+      /* Keeps reporting the hangup, wait here instead */
+      poll(0, 0, timeoutMs);
+      return;
+    }
+  }
+
+  if (!(l_fd_s.revents & POLLIN))
+  {
+    return;
+  }
+
+  if (host_g_Fd_s32 < 0)
+  {
+    host_g_Fd_s32 = accept(host_g_Server_s32, NULL, NULL);
+    host_g_Transport_s.connected_u8 = (host_g_Fd_s32 >= 0);
+    host_g_Transport_s.rx_s.state_e = LNK_RX_SYNC_1;
+    printf("Host connected\n");
+    fflush(stdout);
+  }
+  else if ((l_cnt_s32 = read(host_g_Fd_s32, l_buf_u8, sizeof(l_buf_u8))) > 0)
+  {
+    host_g_Transport_s.rxUs_s64 = host_f_NowUs_s64();
+    lnk_f_Receive_v(&host_g_Transport_s, l_buf_u8, (uint32_t)l_cnt_s32);
+  }
+  else if (!host_g_Pty_u8 && ((l_cnt_s32 == 0) || (errno != EAGAIN)))
+  {
+    close(host_g_Fd_s32);
+    host_g_Fd_s32 = -1;
+    host_g_Transport_s.connected_u8 = 0;
+    printf("Host disconnected\n");
+    fflush(stdout);
+  }
+}
+
+/**
+ * @brief Send a frame to the host, write_pf of the transport
+ *
+ * The pseudo-terminal may take only part of a frame, the rest is waited for up to HOST_WRITE_TIMEOUT_MS. A frame
+ * that doesn't make it by then is cut off and the host resyncs on the next one, like after a lost byte on the UART
+ *
+ * @return 1 if the whole frame was sent, 0 if the host is gone or too slow
+ */
+uint8_t host_f_Write_u8(const uint8_t *frame, uint16_t len)
+{
+  struct pollfd l_fd_s;
+  int64_t l_startUs_s64 = host_f_NowUs_s64();
+  uint32_t l_writeUs_u32;
+  ssize_t l_cnt_s32;
+  uint16_t l_done_u16 = 0;
+
+  if (!host_g_Pty_u8)
+  {
+    /* Localhost, the kernel takes it right away */
+    return (send(host_g_Fd_s32, frame, len, MSG_NOSIGNAL) == (ssize_t)len);
+  }
+
+  while (l_done_u16 < len)
+  {
+    l_cnt_s32 = write(host_g_Fd_s32, frame + l_done_u16, len - l_done_u16);
+    if (l_cnt_s32 > 0)
+    {
+      l_done_u16 += (uint16_t)l_cnt_s32;
+      continue;
+    }
+    if ((l_cnt_s32 < 0) && (errno != EAGAIN) && (errno != EINTR))
+    {
+      return 0;
+    }
+
+    l_fd_s.fd = host_g_Fd_s32;
+    l_fd_s.events = POLLOUT;
+    if ((poll(&l_fd_s, 1, HOST_WRITE_TIMEOUT_MS) <= 0) || (l_fd_s.revents & (POLLHUP | POLLERR)))
+    {
+      return 0;
+    }
+  }
+
+  l_writeUs_u32 = (uint32_t)(host_f_NowUs_s64() - l_startUs_s64);
+  if (l_writeUs_u32 > host_g_Transport_s.stats_s.maxWriteUs_u32)
+  {
+    host_g_Transport_s.stats_s.maxWriteUs_u32 = l_writeUs_u32;
+  }
+  return 1;
+}
+
+/**
+ * @brief Act on a valid frame received from the host, handler of the link
+ *
+ * @return void
+ */
+void host_f_HandleFrame_v(lnk_s_Transport_t *transport, uint8_t id, const uint8_t *payload, uint8_t len)
+{
+  msg_s_CfgSet_t l_set_s;
+  uint8_t l_reply_u8[LNK_MAX_PAYLOAD];
+  uint8_t l_idx_u8;
+  uint8_t i;
+
+  switch (id)
+  {
+  case MSG_ID_PING:
+    if (len > LNK_MAX_PAYLOAD - 4)
+    {
+      len = LNK_MAX_PAYLOAD - 4;
+    }
+    memcpy(l_reply_u8, payload, len);
+    l_idx_u8 = lnk_f_PutU32_u8(l_reply_u8, len, (uint32_t)host_f_NowUs_s64());
+    lnk_f_SendTo_u8(transport, MSG_ID_PONG, l_reply_u8, l_idx_u8);
+    break;
+  case MSG_ID_CFG_SET:
+    if (!msg_f_UnpackCfgSet_u8(&l_set_s, payload, len))
+    {
+      transport->stats_s.rxErrors_u32++;
+      break;
+    }
+    for (i = 0; (i < l_set_s.valuesCount_u8) && (i < MSG_PARAM_COUNT); i++)
+    {
+      if (l_set_s.values_s[i].value_u16 != HOST_CFG_KEEP)
+      {
+        host_g_Cfg_u16[i] = l_set_s.values_s[i].value_u16;
+      }
+    }
+    host_f_SendCfg_v(transport);
+    break;
+  default:
+    printf("Frame 0x%02X with %u bytes ignored\n", id, len);
+    break;
+  }
+}
+
+/**
+ * @brief Send all configuration parameters
+ *
+ * @return void
+ */
+void host_f_SendCfg_v(lnk_s_Transport_t *transport)
+{
+  msg_s_Cfg_t l_cfg_s;
+  uint8_t l_payload_u8[MSG_CFG_LEN];
+  uint8_t i;
+
+  for (i = 0; i < MSG_PARAM_COUNT; i++)
+  {
+    l_cfg_s.values_s[i].value_u16 = host_g_Cfg_u16[i];
+  }
+  l_cfg_s.valuesCount_u8 = MSG_PARAM_COUNT;
+
+  lnk_f_SendTo_u8(transport, MSG_ID_CFG, l_payload_u8, msg_f_PackCfg_u8(l_payload_u8, &l_cfg_s));
+}
+
+/**
+ * @brief Send the statistics of the transport
+ *
+ * @return void
+ */
+void host_f_SendLinkStats_v(lnk_s_Transport_t *transport)
+{
+  msg_s_LinkStats_t l_stats_s;
+  uint8_t l_payload_u8[MSG_LINK_STATS_LEN];
+
+  l_stats_s.timeUs_u32 = (uint32_t)host_f_NowUs_s64();
+  l_stats_s.txBytes_u32 = transport->stats_s.txBytes_u32;
+  l_stats_s.txFrames_u32 = transport->stats_s.txFrames_u32;
+  l_stats_s.txDropped_u32 = transport->stats_s.txDropped_u32;
+  l_stats_s.rxFrames_u32 = transport->stats_s.rxFrames_u32;
+  l_stats_s.rxErrors_u32 = transport->stats_s.rxErrors_u32;
+  l_stats_s.txBytesPerSec_u32 = transport->stats_s.txBytesPerSec_u32;
+  l_stats_s.maxWriteUs_u32 = transport->stats_s.maxWriteUs_u32;
+  l_stats_s.maxBacklogUs_u32 = transport->stats_s.maxBacklogUs_u32;
+
+  lnk_f_SendTo_u8(transport, MSG_ID_LINK_STATS, l_payload_u8, msg_f_PackLinkStats_u8(l_payload_u8, &l_stats_s));
+}
+
+/**
+ * @brief Send an RTM frame with all slots, dated when it is built
+ *
+ * @return void
+ */
+void host_f_SendRtm_v(lnk_s_Transport_t *transport)
+{
+  static uint16_t s_cnt_u16 = 0;
+  msg_s_Rtm_t l_rtm_s;
+  uint8_t l_payload_u8[MSG_RTM_LEN];
+  uint8_t i;
+
+  s_cnt_u16++;
+  for (i = 0; i < MSG_RTM_SLOTS_MAX; i++)
+  {
+    l_rtm_s.slots_s[i].currentUs_u16 = (uint16_t)(100 + i * 10 + (s_cnt_u16 & 0x0F));
+    l_rtm_s.slots_s[i].minUs_u16 = (uint16_t)(100 + i * 10);
+    l_rtm_s.slots_s[i].maxUs_u16 = (uint16_t)(100 + i * 10 + 0x0F);
+  }
+  l_rtm_s.slotsCount_u8 = MSG_RTM_SLOTS_MAX;
+  l_rtm_s.timeUs_u32 = (uint32_t)host_f_NowUs_s64();
+
+  lnk_f_SendTo_u8(transport, MSG_ID_RTM, l_payload_u8, msg_f_PackRtm_u8(l_payload_u8, &l_rtm_s));
+}
+
+/**
+ * @brief Stop the main loop, so the link to the pseudo-terminal is removed
+ *
+ * @return void
+ */
+void host_f_OnSignal_v(int sig)
+{
+  (void)sig;
+  host_g_Stop_u8 = 1;
+}
+
+/**
+ * @brief Monotonic time, stands in for esp_timer_get_time()
+ *
+ * @return microseconds
+ */
+int64_t host_f_NowUs_s64(void)
+{
+  struct timespec l_ts_s;
+
+  clock_gettime(CLOCK_MONOTONIC, &l_ts_s);
+  return (int64_t)l_ts_s.tv_sec * 1000000LL + l_ts_s.tv_nsec / 1000;
+}
@@ -34,6 +34,139 @@
  */
 #define SERIAL_DEBUG
 
+/**
+ * @brief Define whether to send binary telemetry frames over the telemetry UART (see drivers/tlm)
+ * Runs in its own task on core 0, and only queues frames into the UART driver buffer,
+ * so it doesn't slow down the main OS like the serial debug does.
+ *
+ * @values Comment out the line to disable telemetry
+ */
+#define TELEMETRY
+
+/**
+ * @brief Define whether to offer the telemetry link and the configuration over BLE as well (see drivers/ble)
+ * The NimBLE stack runs on core 0 next to the telemetry task, so the main OS doesn't notice it.
+ * Needs TELEMETRY, and Bluetooth with NimBLE enabled in the sdkconfig.
+ *
+ * @values Comment out the line to disable BLE
+ */
+#define BLUETOOTH
+
+#if defined(BLUETOOTH) && !defined(TELEMETRY)
+#error "BLUETOOTH is one more transport of the telemetry link, it needs TELEMETRY"
+#endif
+
+/**
+ * @brief Define whether to run the scheduler load test (see drivers/ldt)
+ * Synthetic work gets injected into the 1ms task slots until they miss their deadline,
+ * so the servo outputs are delayed on purpose. Never leave it enabled on a hand that is worn.
+ *
+ * @values Comment out the line to disable the load test
+ */
+// #define LOAD_TEST
+
+/**
+ * @brief Define whether to run the flash cache benchmark (see drivers/cht)
+ * A task on core 0 keeps writing to NVS and reading through flash every other few seconds, while the worst
+ * slot runtimes and start delays of the main OS are recorded with and without that flash activity.
+ * Wears the flash, so it's meant for the bench only.
+ *
+ * @values Comment out the line to disable the benchmark
+ */
+// #define CACHE_TEST
+
+/**
+ * @brief Define which modules of the control loop run from IRAM, with their constant data in internal DRAM
+ * Code in flash runs through the instruction cache, every miss waits for the flash, and while the flash is
+ * written (NVS) the cache is off and a miss waits until the write is done. Code in IRAM doesn't miss.
+ * The mutable data of every module is in internal DRAM anyway, only the constants are read from flash.
+ * Calls into ESP-IDF keep running from flash, apart from the ones it places in IRAM on its own.
+ * Costs IRAM, about as much as the code of the module.
+ *
+ * @values Comment out a line to leave that module in flash
+ */
+#define IRAM_MAIN /* The main OS: scheduler and runtime measurement */
+#define IRAM_DLM  /* Deadline monitor, runs after every slot */
+#define IRAM_ERR  /* Retries of the driver calls */
+#define IRAM_BAT  /* Battery input and filter */
+#define IRAM_POT  /* Potentiometer inputs and filter */
+#define IRAM_SNS  /* EMG sensor inputs and filter */
+#define IRAM_SRV  /* Servo output stage */
+#define IRAM_SUP  /* Safety supervisor check and the heartbeat */
+#define IRAM_BLK  /* Sample blocks of the input filters */
+
+#ifdef IRAM_MAIN
+#define MAIN_IRAM_ATTR IRAM_ATTR
+#define MAIN_DRAM_ATTR DRAM_ATTR
+#else
+#define MAIN_IRAM_ATTR
+#define MAIN_DRAM_ATTR
+#endif
+
+#ifdef IRAM_DLM
+#define DLM_IRAM_ATTR IRAM_ATTR
+#define DLM_DRAM_ATTR DRAM_ATTR
+#else
+#define DLM_IRAM_ATTR
+#define DLM_DRAM_ATTR
+#endif
+
+#ifdef IRAM_ERR
+#define ERR_IRAM_ATTR IRAM_ATTR
+#define ERR_DRAM_ATTR DRAM_ATTR
+#else
+#define ERR_IRAM_ATTR
+#define ERR_DRAM_ATTR
+#endif
+
+#ifdef IRAM_BAT
+#define BAT_IRAM_ATTR IRAM_ATTR
+#define BAT_DRAM_ATTR DRAM_ATTR
+#else
+#define BAT_IRAM_ATTR
+#define BAT_DRAM_ATTR
+#endif
+
+#ifdef IRAM_POT
+#define POT_IRAM_ATTR IRAM_ATTR
+#define POT_DRAM_ATTR DRAM_ATTR
+#else
+#define POT_IRAM_ATTR
+#define POT_DRAM_ATTR
+#endif
+
+#ifdef IRAM_SNS
+#define SNS_IRAM_ATTR IRAM_ATTR
+#define SNS_DRAM_ATTR DRAM_ATTR
+#else
+#define SNS_IRAM_ATTR
+#define SNS_DRAM_ATTR
+#endif
+
+#ifdef IRAM_SRV
+#define SRV_IRAM_ATTR IRAM_ATTR
+#define SRV_DRAM_ATTR DRAM_ATTR
+#else
+#define SRV_IRAM_ATTR
+#define SRV_DRAM_ATTR
+#endif
+
+#ifdef IRAM_SUP
+#define SUP_IRAM_ATTR IRAM_ATTR
+#define SUP_DRAM_ATTR DRAM_ATTR
+#else
+#define SUP_IRAM_ATTR
+#define SUP_DRAM_ATTR
+#endif
+
+#ifdef IRAM_BLK
+#define BLK_IRAM_ATTR IRAM_ATTR
+#define BLK_DRAM_ATTR DRAM_ATTR
+#else
+#define BLK_IRAM_ATTR
+#define BLK_DRAM_ATTR
+#endif
+
 #define MILLISEC_TO_MICROSEC 1000
 
 /**************************************************************************
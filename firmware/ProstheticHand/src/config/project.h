@@ -32,6 +32,7 @@
 #include "esp_adc/adc_cali.h"
 #include "driver/ledc.h"
 #include "esp_timer.h"
+#include "esp_attr.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 
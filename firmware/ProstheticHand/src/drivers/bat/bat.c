@@ -20,6 +20,9 @@
 #include "bat_e.h"
 #include "bat_i.h"
 
+/* Other components used here */
+#include "drivers/err/err_e.h"
+
 /**************************************************************************
  * Global variables
  **************************************************************************/
@@ -38,11 +41,12 @@ float32_t bat_g_BatVoltage_f32 = 0;
 adc_channel_t bat_g_BatAdcCh_s;
 
 /**
- * @brief Buffer for storing previous values of the batt voltage for filtering
+ * @brief Last BAT_AVG_CNT voltage readings for filtering, and their storage
  * 
  * @values same as bat values
  */
-float32_t bat_g_PrevBatVoltages_f32[BAT_AVG_CNT];
+blk_s_Block_t bat_g_Block_s;
+float32_t bat_g_Samples_f32[1][BLK_STRIDE(BAT_AVG_CNT)] BLK_STORAGE_ATTR;
 
 /**************************************************************************
  * Functions
@@ -65,8 +69,6 @@ void bat_f_SerialDebug_v(void);
  */
 void bat_f_Init_v(void)
 {
-  uint8_t i;
-
   /* Default configuration for all ADC channels */
   adc_oneshot_chan_cfg_t channel_config = {
       .atten = ADC_ATTEN_DB_11,
@@ -84,10 +86,7 @@ void bat_f_Init_v(void)
   }
 
   /* Set default values of the low-pass filter */
-  for (i = 0; i < BAT_AVG_CNT; i++)
-  {
-    bat_g_PrevBatVoltages_f32[i] = 0;
-  }
+  blk_f_Init_v(&bat_g_Block_s, &bat_g_Samples_f32[0][0], 1, BAT_AVG_CNT);
 }
 
 /**
@@ -97,40 +96,34 @@ void bat_f_Init_v(void)
  *
  * @return void
  */
-void bat_f_Handle_v(void)
+void BAT_IRAM_ATTR bat_f_Handle_v(void)
 {
-  uint8_t i;
-  uint16_t adcAnalogRead = 0;
-  float32_t sum = 0;
+  int adcAnalogRead = 0;
+  float32_t l_voltage_f32;
+  esp_err_t l_err_s32;
+  adc_oneshot_unit_handle_t l_unit_s;
 
   /* Based on which ADC group this pin belongs to, read the corresponding group */
-  if (bat_s_BatSensConfig_s.adc_unit_s == ADC_UNIT_1)
-  {
-    ESP_ERROR_CHECK(adc_oneshot_read(main_g_AdcUnit1Handle_s, bat_g_BatAdcCh_s, (int *)&adcAnalogRead));
-  }
-  else // ADC_UNIT_2
-  {
-    ESP_ERROR_CHECK(adc_oneshot_read(main_g_AdcUnit2Handle_s, bat_g_BatAdcCh_s, (int *)&adcAnalogRead));
-  }
+  l_unit_s = (bat_s_BatSensConfig_s.adc_unit_s == ADC_UNIT_1) ? main_g_AdcUnit1Handle_s : main_g_AdcUnit2Handle_s;
 
-  /* Shift all values in buffer to the next place in the array */
-  for (i = BAT_AVG_CNT - 1; i > 0; i--)
-  { 
-    bat_g_PrevBatVoltages_f32[i] = bat_g_PrevBatVoltages_f32[i - 1];
+  l_err_s32 = adc_oneshot_read(l_unit_s, bat_g_BatAdcCh_s, &adcAnalogRead);
+  while (err_f_Retry_u8(ERR_SRC_BAT, l_err_s32))
+  {
+    l_err_s32 = adc_oneshot_read(l_unit_s, bat_g_BatAdcCh_s, &adcAnalogRead);
   }
 
-  /* Set current value to first index (and scale the value to get exact voltage) */
-  bat_g_PrevBatVoltages_f32[0] = bat_f_MapAdcToMillivolts_f32(adcAnalogRead) * bat_s_BatSensConfig_s.mult_f32 / (float)1000;
-
-  /* Take the average of all those readings */
-  sum = 0;
-  for (i = 0; i < BAT_AVG_CNT; i++)
+  /* A failed read keeps the last good voltage */
+  if (l_err_s32 != ESP_OK)
   {
-    sum += bat_g_PrevBatVoltages_f32[i];
+    return;
   }
 
-  /* Finally get the average value */
-  bat_g_BatVoltage_f32 = sum / (float32_t)BAT_AVG_CNT;
+  /* Scale the value to get exact voltage, and put it in place of the oldest one */
+  l_voltage_f32 = bat_f_MapAdcToMillivolts_f32((uint16_t)adcAnalogRead) * bat_s_BatSensConfig_s.mult_f32 / (float)1000;
+  blk_f_Push_v(&bat_g_Block_s, &l_voltage_f32, (uint32_t)esp_timer_get_time());
+
+  /* Finally get the average value of all those readings */
+  blk_f_Mean_v(&bat_g_Block_s, &bat_g_BatVoltage_f32);
 }
 
 /**
@@ -139,7 +132,7 @@ void bat_f_Handle_v(void)
  * @param val
  * @return scaled float32_t value
  */
-float32_t bat_f_MapAdcToMillivolts_f32(uint16_t val)
+float32_t BAT_IRAM_ATTR bat_f_MapAdcToMillivolts_f32(uint16_t val)
 {
   return (float32_t)val * BAT_ADC_COUNT_TO_MILLIVOLT_MULT;
 }
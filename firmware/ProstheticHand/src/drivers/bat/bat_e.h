@@ -22,6 +22,7 @@
  **************************************************************************/
 
 #include "config/project.h"
+#include "drivers/blk/blk_e.h"
 
 /**************************************************************************
  * Defines
@@ -29,6 +30,17 @@
 
 #define BAT_TAG "BTN"
 
+/**
+ * @brief Battery voltages at which LED01 warns, and below which no battery is connected (powered over USB)
+ *
+ * Below BAT_CRITICAL_V the safety supervisor (drivers/sup) also puts the servos into the open posture
+ *
+ * @values in volts, 4 cell Li-ion battery: 3.4V and 3.2V per cell
+ */
+#define BAT_LOW_V 13.6
+#define BAT_CRITICAL_V 12.8
+#define BAT_PRESENT_V 5.0
+
 /**************************************************************************
  * Global variables
  **************************************************************************/
@@ -40,6 +52,13 @@
  */
 extern float32_t bat_g_BatVoltage_f32;
 
+/**
+ * @brief Last BAT_AVG_CNT voltage readings, for the filters and recording to take by reference
+ *
+ * @values Voltage, see blk_s_Block_t
+ */
+extern blk_s_Block_t bat_g_Block_s;
+
 
 /**************************************************************************
  * Function prototypes
@@ -108,7 +108,7 @@ extern adc_channel_t bat_g_BatAdcCh_s;
  * 
  * @values same as bat values
  */
-extern float32_t bat_g_PrevBatVoltages_f32[BAT_AVG_CNT];
+extern float32_t bat_g_Samples_f32[1][BLK_STRIDE(BAT_AVG_CNT)];
 
 /**************************************************************************
  * Function prototypes
@@ -0,0 +1,644 @@
+/**
+ * @file ble.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief BLE GATT service software component
+ *
+ * Offers the telemetry link and the configuration parameters over BLE, so the hand can be looked at and tuned
+ * from a phone or a laptop without a cable. The service is one more transport of the link (see drivers/lnk):
+ * the same frames as on the telemetry UART go out as notifications of the TX characteristic and come in as
+ * writes to the RX characteristic. The CFG characteristic reads and writes the parameters directly (see drivers/cfg).
+ *
+ * RX and CFG move the hand and change its parameters, so they only take writes over a link encrypted with a key from
+ * an authenticated (passkey) and bonded pairing, CFG reads need an encrypted link. The passkey is drawn for every
+ * hand on its first boot and kept in NVS (see ble_f_LoadPasskey_v). The stack enforces encryption and authentication
+ * on the characteristics, the bond is checked before the transport is trusted (see lnk_s_Transport_t), and writes
+ * are refused until it is.
+ *
+ * Frames are not sent one notification each: everything queued during a telemetry period is sent at the end of
+ * it, cut into notifications as large as the MTU allows. Each notification starts with a sequence number, the
+ * rest is the byte stream of frames, so the host just appends them and runs its usual frame parser. If the stack
+ * runs out of buffers, whatever did not fit waits for the next period instead of being dropped.
+ *
+ * The NimBLE host and the controller run on core 0 next to the telemetry task, the main OS on core 1 never sees them.
+ * The host task only moves bytes into a stream buffer, frames are parsed and handled in the telemetry task.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "config/project.h"
+
+#ifdef BLUETOOTH
+
+/* Own header file */
+#include "ble_e.h"
+#include "ble_i.h"
+
+#include "string.h"
+#include "nvs_flash.h"
+#include "nvs.h"
+#include "esp_random.h"
+
+/* Other components used here */
+#include "drivers/msg/msg_e.h"
+#include "drivers/cfg/cfg_e.h"
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief The GATT service as a transport of the link, connected while the host listens to the TX characteristic,
+ * trusted while the link is encrypted with the key of an authenticated and bonded pairing
+ *
+ */
+lnk_s_Transport_t ble_g_Transport_s = {
+    .name_pc = "BLE",
+    .write_pf = ble_f_Write_u8,
+    .flush_pf = ble_f_Flush_v,
+    .poll_pf = ble_f_Poll_v,
+    .connected_u8 = 0,
+    .trusted_u8 = 0};
+
+/**
+ * @brief Passkey of this hand, see ble_f_LoadPasskey_v
+ *
+ * @values 0..BLE_PASSKEY_MAX
+ */
+uint32_t ble_g_Passkey_u32 = 0;
+
+/**
+ * @brief Frames waiting to be sent as notifications, only touched by the telemetry task
+ *
+ */
+uint8_t ble_g_TxBuf_u8[BLE_TX_BUF_SIZE];
+uint16_t ble_g_TxHead_u16 = 0;
+uint16_t ble_g_TxTail_u16 = 0;
+
+/**
+ * @brief When the oldest byte still waiting in ble_g_TxBuf_u8 was queued, for the backlog statistics
+ *
+ */
+int64_t ble_g_TxSinceUs_s64;
+
+/**
+ * @brief Sequence number of the next notification, lets the host notice a lost one and resync on the next frame
+ *
+ */
+uint8_t ble_g_NotifySeq_u8 = 0;
+
+/**
+ * @brief Bytes written by the host, from the NimBLE host task to the telemetry task
+ *
+ */
+StreamBufferHandle_t ble_g_RxStream_s;
+
+/**
+ * @brief Bytes written by the host that did not fit into ble_g_RxStream_s, and how many of those were already counted
+ *
+ */
+uint32_t ble_g_RxOverflow_u32 = 0;
+uint32_t ble_g_RxOverflowCounted_u32 = 0;
+
+/**
+ * @brief Connection, the attribute handle of TX and the MTU, written by the NimBLE host task
+ *
+ */
+uint16_t ble_g_ConnHandle_u16 = BLE_HS_CONN_HANDLE_NONE;
+uint16_t ble_g_TxHandle_u16;
+uint16_t ble_g_Mtu_u16 = BLE_DEFAULT_MTU;
+
+/**
+ * @brief Own address type, found out once the host and the controller are in sync
+ *
+ */
+uint8_t ble_g_AddrType_u8;
+
+/**
+ * @brief UUIDs of the service and its characteristics
+ *
+ */
+const ble_uuid128_t ble_g_SvcUuid_s = BLE_UUID(BLE_UUID_SERVICE);
+const ble_uuid128_t ble_g_TxUuid_s = BLE_UUID(BLE_UUID_TX);
+const ble_uuid128_t ble_g_RxUuid_s = BLE_UUID(BLE_UUID_RX);
+const ble_uuid128_t ble_g_CfgUuid_s = BLE_UUID(BLE_UUID_CFG);
+
+/**
+ * @brief The GATT service and its characteristics
+ *
+ */
+const struct ble_gatt_svc_def ble_g_Services_s[] = {
+    {
+        .type = BLE_GATT_SVC_TYPE_PRIMARY,
+        .uuid = &ble_g_SvcUuid_s.u,
+        .characteristics = (struct ble_gatt_chr_def[]){
+            {
+                .uuid = &ble_g_TxUuid_s.u,
+                .access_cb = ble_f_Access_s32,
+                .arg = (void *)BLE_CHR_TX,
+                .flags = BLE_GATT_CHR_F_NOTIFY,
+                .val_handle = &ble_g_TxHandle_u16,
+            },
+            {
+                .uuid = &ble_g_RxUuid_s.u,
+                .access_cb = ble_f_Access_s32,
+                .arg = (void *)BLE_CHR_RX,
+                .flags = BLE_GATT_CHR_F_WRITE | BLE_GATT_CHR_F_WRITE_NO_RSP | BLE_GATT_CHR_F_WRITE_ENC | BLE_GATT_CHR_F_WRITE_AUTHEN,
+            },
+            {
+                .uuid = &ble_g_CfgUuid_s.u,
+                .access_cb = ble_f_Access_s32,
+                .arg = (void *)BLE_CHR_CFG,
+                .flags = BLE_GATT_CHR_F_READ | BLE_GATT_CHR_F_READ_ENC | BLE_GATT_CHR_F_WRITE | BLE_GATT_CHR_F_WRITE_ENC | BLE_GATT_CHR_F_WRITE_AUTHEN,
+            },
+            {0}, /* No more characteristics */
+        },
+    },
+    {0}, /* No more services */
+};
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+void ble_f_Init_v(void);
+void ble_f_LoadPasskey_v(void);
+
+uint8_t ble_f_Write_u8(const uint8_t *frame, uint16_t len);
+void ble_f_Flush_v(void);
+void ble_f_Poll_v(void);
+void ble_f_Advertise_v(void);
+void ble_f_OnSync_v(void);
+void ble_f_OnReset_v(int reason);
+int ble_f_GapEvent_s32(struct ble_gap_event *event, void *arg);
+int ble_f_Access_s32(uint16_t connHandle, uint16_t attrHandle, struct ble_gatt_access_ctxt *ctxt, void *arg);
+void ble_f_HostTask_v(void *arg);
+
+/**
+ * @brief Init function called once on boot, after the telemetry link
+ *
+ * Bring up NVS (the controller keeps its calibration there, the host the bonds) and the NimBLE stack with bonded,
+ * MITM protected pairing, register the service and add it to the link. Advertising starts as soon as the host and
+ * the controller are in sync
+ *
+ * @return void
+ */
+void ble_f_Init_v(void)
+{
+  esp_err_t l_ret_s32;
+
+  l_ret_s32 = nvs_flash_init();
+  if ((l_ret_s32 == ESP_ERR_NVS_NO_FREE_PAGES) || (l_ret_s32 == ESP_ERR_NVS_NEW_VERSION_FOUND))
+  {
+    ESP_ERROR_CHECK(nvs_flash_erase());
+    l_ret_s32 = nvs_flash_init();
+  }
+  ESP_ERROR_CHECK(l_ret_s32);
+
+  ble_g_RxStream_s = xStreamBufferCreate(BLE_RX_BUF_SIZE, 1);
+  configASSERT(ble_g_RxStream_s != NULL);
+
+  /* After the controller is up, the random number generator only gives true random numbers with the radio on */
+  ESP_ERROR_CHECK(nimble_port_init());
+  ble_f_LoadPasskey_v();
+
+  ble_hs_cfg.sync_cb = ble_f_OnSync_v;
+  ble_hs_cfg.reset_cb = ble_f_OnReset_v;
+  ble_hs_cfg.store_status_cb = ble_store_util_status_rr;
+
+  /* LE Secure Connections with passkey entry, the host types in the passkey the hand "displays" */
+  ble_hs_cfg.sm_io_cap = BLE_SM_IO_CAP_DISP_ONLY;
+  ble_hs_cfg.sm_bonding = 1;
+  ble_hs_cfg.sm_mitm = 1;
+  ble_hs_cfg.sm_sc = 1;
+  ble_hs_cfg.sm_our_key_dist = BLE_KEY_DIST;
+  ble_hs_cfg.sm_their_key_dist = BLE_KEY_DIST;
+
+  ble_svc_gap_init();
+  ble_svc_gatt_init();
+  ESP_ERROR_CHECK(ble_gatts_count_cfg(ble_g_Services_s));
+  ESP_ERROR_CHECK(ble_gatts_add_svcs(ble_g_Services_s));
+  ESP_ERROR_CHECK(ble_svc_gap_device_name_set(BLE_DEVICE_NAME));
+  ble_store_config_init();
+
+  if (!lnk_f_Add_u8(&ble_g_Transport_s))
+  {
+    ESP_LOGE(BLE_TAG, "No room for another transport, raise LNK_MAX_TRANSPORTS");
+  }
+
+  /* Runs on the core NimBLE is pinned to in the sdkconfig (core 0) */
+  nimble_port_freertos_init(ble_f_HostTask_v);
+}
+
+/**
+ * @brief Load the pairing passkey of this hand from NVS, drawing and storing one on the first boot
+ *
+ * Called once from the init function, after the controller is up. Without NVS the passkey is drawn for this boot only,
+ * the bonds can't be kept either then
+ *
+ * @return void
+ */
+void ble_f_LoadPasskey_v(void)
+{
+  nvs_handle_t l_nvs_s;
+  esp_err_t l_ret_s32;
+
+  l_ret_s32 = nvs_open(BLE_NVS_NAMESPACE, NVS_READWRITE, &l_nvs_s);
+  if (l_ret_s32 != ESP_OK)
+  {
+    ble_g_Passkey_u32 = esp_random() % (BLE_PASSKEY_MAX + 1);
+    ESP_LOGE(BLE_TAG, "No NVS (%d), the passkey changes with every boot", l_ret_s32);
+  }
+  else
+  {
+    l_ret_s32 = nvs_get_u32(l_nvs_s, BLE_NVS_KEY_PASSKEY, &ble_g_Passkey_u32);
+    if ((l_ret_s32 != ESP_OK) || (ble_g_Passkey_u32 > BLE_PASSKEY_MAX))
+    {
+      ble_g_Passkey_u32 = esp_random() % (BLE_PASSKEY_MAX + 1);
+      l_ret_s32 = nvs_set_u32(l_nvs_s, BLE_NVS_KEY_PASSKEY, ble_g_Passkey_u32);
+      if (l_ret_s32 == ESP_OK)
+      {
+        l_ret_s32 = nvs_commit(l_nvs_s);
+      }
+      if (l_ret_s32 != ESP_OK)
+      {
+        ESP_LOGE(BLE_TAG, "Passkey not stored (%d), it changes with every boot", l_ret_s32);
+      }
+    }
+    nvs_close(l_nvs_s);
+  }
+
+  ESP_LOGI(BLE_TAG, "Pairing passkey %06lu", (unsigned long)ble_g_Passkey_u32);
+}
+
+/**
+ * @brief Queue a frame for the next notifications, write_pf of the transport
+ *
+ * Called from the telemetry task only
+ *
+ * @param frame whole frame, built by lnk
+ * @param len frame length
+ * @return 1 if the frame was queued, 0 if the buffer has no room for it
+ */
+uint8_t ble_f_Write_u8(const uint8_t *frame, uint16_t len)
+{
+  uint16_t l_used_u16 = (uint16_t)((ble_g_TxHead_u16 - ble_g_TxTail_u16 + BLE_TX_BUF_SIZE) % BLE_TX_BUF_SIZE);
+  uint16_t i;
+
+  /* One byte stays free, so a full buffer can be told from an empty one */
+  if ((BLE_TX_BUF_SIZE - 1 - l_used_u16) < len)
+  {
+    return 0;
+  }
+
+  if (l_used_u16 == 0)
+  {
+    ble_g_TxSinceUs_s64 = esp_timer_get_time();
+  }
+
+  for (i = 0; i < len; i++)
+  {
+    ble_g_TxBuf_u8[ble_g_TxHead_u16] = frame[i];
+    ble_g_TxHead_u16 = (ble_g_TxHead_u16 + 1) % BLE_TX_BUF_SIZE;
+  }
+
+  return 1;
+}
+
+/**
+ * @brief Send the queued frames as notifications, flush_pf of the transport
+ *
+ * Called from the telemetry task at the end of every period. Stops at the first notification the stack has no
+ * buffer for, the rest goes out with the next flush. Without a listener whatever is queued is thrown away
+ *
+ * @return void
+ */
+void ble_f_Flush_v(void)
+{
+  uint8_t l_notify_u8[BLE_MAX_NOTIFY];
+  uint16_t l_conn_u16 = ble_g_ConnHandle_u16;
+  uint16_t l_chunk_u16;
+  uint16_t l_used_u16;
+  uint16_t l_len_u16;
+  uint16_t i;
+  struct os_mbuf *l_om_ps;
+  uint64_t l_startUs_u64;
+  uint32_t l_durationUs_u32;
+
+  if (!ble_g_Transport_s.connected_u8 || (l_conn_u16 == BLE_HS_CONN_HANDLE_NONE))
+  {
+    ble_g_TxTail_u16 = ble_g_TxHead_u16;
+    return;
+  }
+
+  l_chunk_u16 = ble_g_Mtu_u16 - BLE_NOTIFY_OVERHEAD;
+  if (l_chunk_u16 > (BLE_MAX_NOTIFY - 1))
+  {
+    l_chunk_u16 = BLE_MAX_NOTIFY - 1;
+  }
+
+  l_startUs_u64 = esp_timer_get_time();
+
+  while (ble_g_TxTail_u16 != ble_g_TxHead_u16)
+  {
+    l_used_u16 = (uint16_t)((ble_g_TxHead_u16 - ble_g_TxTail_u16 + BLE_TX_BUF_SIZE) % BLE_TX_BUF_SIZE);
+    l_len_u16 = (l_used_u16 < l_chunk_u16) ? l_used_u16 : l_chunk_u16;
+
+    l_notify_u8[0] = ble_g_NotifySeq_u8;
+    for (i = 0; i < l_len_u16; i++)
+    {
+      l_notify_u8[1 + i] = ble_g_TxBuf_u8[(ble_g_TxTail_u16 + i) % BLE_TX_BUF_SIZE];
+    }
+
+    l_om_ps = ble_hs_mbuf_from_flat(l_notify_u8, 1 + l_len_u16);
+    if (l_om_ps == NULL)
+    {
+      break;
+    }
+
+    /* The stack frees the mbuf whether the notification went out or not */
+    if (ble_gatts_notify_custom(l_conn_u16, ble_g_TxHandle_u16, l_om_ps) != 0)
+    {
+      break;
+    }
+
+    ble_g_NotifySeq_u8++;
+    ble_g_TxTail_u16 = (ble_g_TxTail_u16 + l_len_u16) % BLE_TX_BUF_SIZE;
+  }
+
+  l_durationUs_u32 = (uint32_t)(esp_timer_get_time() - l_startUs_u64);
+  if (l_durationUs_u32 > ble_g_Transport_s.stats_s.maxWriteUs_u32)
+  {
+    ble_g_Transport_s.stats_s.maxWriteUs_u32 = l_durationUs_u32;
+  }
+
+  /* Only measured once everything went out, so it is the wait of the oldest byte */
+  if (ble_g_TxTail_u16 == ble_g_TxHead_u16)
+  {
+    l_durationUs_u32 = (uint32_t)(esp_timer_get_time() - ble_g_TxSinceUs_s64);
+    if (l_durationUs_u32 > ble_g_Transport_s.stats_s.maxBacklogUs_u32)
+    {
+      ble_g_Transport_s.stats_s.maxBacklogUs_u32 = l_durationUs_u32;
+    }
+  }
+}
+
+/**
+ * @brief Hand the bytes the host wrote to the link, poll_pf of the transport
+ *
+ * Called from the telemetry task every period. The bytes are dated when they are picked up, at most a period
+ * after they arrived, which is less than a connection interval anyway
+ *
+ * @return void
+ */
+void ble_f_Poll_v(void)
+{
+  uint8_t l_buf_u8[64];
+  size_t l_cnt_u32;
+  uint32_t l_overflow_u32 = ble_g_RxOverflow_u32;
+
+  if (l_overflow_u32 != ble_g_RxOverflowCounted_u32)
+  {
+    /* Bytes went missing, the frame they were part of can't be trusted */
+    ble_g_Transport_s.stats_s.rxErrors_u32 += l_overflow_u32 - ble_g_RxOverflowCounted_u32;
+    ble_g_RxOverflowCounted_u32 = l_overflow_u32;
+    ble_g_Transport_s.rx_s.state_e = LNK_RX_SYNC_1;
+  }
+
+  while ((l_cnt_u32 = xStreamBufferReceive(ble_g_RxStream_s, l_buf_u8, sizeof(l_buf_u8), 0)) > 0)
+  {
+    ble_g_Transport_s.rxUs_s64 = esp_timer_get_time();
+    lnk_f_Receive_v(&ble_g_Transport_s, l_buf_u8, (uint32_t)l_cnt_u32);
+  }
+}
+
+/**
+ * @brief Start advertising the service
+ *
+ * The advertisement carries the flags, the service UUID and the name, so a host can filter on either.
+ * Anyone can connect and read the telemetry, moving the hand or changing parameters takes pairing first
+ *
+ * @return void
+ */
+void ble_f_Advertise_v(void)
+{
+  struct ble_hs_adv_fields l_fields_s;
+  struct ble_gap_adv_params l_params_s;
+  int l_rc_s32;
+
+  memset(&l_fields_s, 0, sizeof(l_fields_s));
+  l_fields_s.flags = BLE_HS_ADV_F_DISC_GEN | BLE_HS_ADV_F_BREDR_UNSUP;
+  l_fields_s.uuids128 = &ble_g_SvcUuid_s;
+  l_fields_s.num_uuids128 = 1;
+  l_fields_s.uuids128_is_complete = 1;
+  l_fields_s.name = (const uint8_t *)BLE_DEVICE_NAME;
+  l_fields_s.name_len = sizeof(BLE_DEVICE_NAME) - 1;
+  l_fields_s.name_is_complete = 1;
+
+  l_rc_s32 = ble_gap_adv_set_fields(&l_fields_s);
+  if (l_rc_s32 != 0)
+  {
+    ESP_LOGE(BLE_TAG, "Setting the advertisement failed: %d", l_rc_s32);
+    return;
+  }
+
+  memset(&l_params_s, 0, sizeof(l_params_s));
+  l_params_s.conn_mode = BLE_GAP_CONN_MODE_UND;
+  l_params_s.disc_mode = BLE_GAP_DISC_MODE_GEN;
+
+  l_rc_s32 = ble_gap_adv_start(ble_g_AddrType_u8, NULL, BLE_HS_FOREVER, &l_params_s, ble_f_GapEvent_s32, NULL);
+  if (l_rc_s32 != 0)
+  {
+    ESP_LOGE(BLE_TAG, "Starting to advertise failed: %d", l_rc_s32);
+  }
+}
+
+/**
+ * @brief Host and controller are in sync, called by NimBLE from its host task
+ *
+ * @return void
+ */
+void ble_f_OnSync_v(void)
+{
+  ESP_ERROR_CHECK(ble_hs_util_ensure_addr(0));
+  ESP_ERROR_CHECK(ble_hs_id_infer_auto(0, &ble_g_AddrType_u8));
+
+  ble_f_Advertise_v();
+}
+
+/**
+ * @brief Host and controller lost sync, NimBLE resets itself and calls ble_f_OnSync_v() again
+ *
+ * @param reason NimBLE error code
+ * @return void
+ */
+void ble_f_OnReset_v(int reason)
+{
+  ble_g_Transport_s.connected_u8 = 0;
+  ESP_LOGW(BLE_TAG, "Stack reset, reason %d", reason);
+}
+
+/**
+ * @brief Act on a GAP event, called by NimBLE from its host task
+ *
+ * Only one host at a time: advertising stops on a connection and starts again once it is gone.
+ * The transport is trusted from the moment the link is encrypted with the key of an authenticated and bonded pairing
+ * until it is gone
+ *
+ * @param event what happened
+ * @param arg not used
+ * @return BLE_GAP_REPEAT_PAIRING_RETRY for a repeated pairing, 0 otherwise, NimBLE ignores it for the other events
+ */
+int ble_f_GapEvent_s32(struct ble_gap_event *event, void *arg)
+{
+  struct ble_gap_conn_desc l_desc_s;
+  struct ble_sm_io l_io_s;
+
+  switch (event->type)
+  {
+  case BLE_GAP_EVENT_CONNECT:
+    ble_g_Transport_s.trusted_u8 = 0;
+    if (event->connect.status == 0)
+    {
+      ble_g_ConnHandle_u16 = event->connect.conn_handle;
+      ble_g_Mtu_u16 = BLE_DEFAULT_MTU;
+    }
+    else
+    {
+      ble_f_Advertise_v();
+    }
+    break;
+  case BLE_GAP_EVENT_DISCONNECT:
+    ble_g_Transport_s.connected_u8 = 0;
+    ble_g_Transport_s.trusted_u8 = 0;
+    ble_g_ConnHandle_u16 = BLE_HS_CONN_HANDLE_NONE;
+    ble_f_Advertise_v();
+    break;
+  case BLE_GAP_EVENT_SUBSCRIBE:
+    if (event->subscribe.attr_handle == ble_g_TxHandle_u16)
+    {
+      ble_g_Transport_s.connected_u8 = event->subscribe.cur_notify;
+    }
+    break;
+  case BLE_GAP_EVENT_MTU:
+    ble_g_Mtu_u16 = event->mtu.value;
+    break;
+  case BLE_GAP_EVENT_ENC_CHANGE:
+    ble_g_Transport_s.trusted_u8 = 0;
+    if ((event->enc_change.status == 0) && (ble_gap_conn_find(event->enc_change.conn_handle, &l_desc_s) == 0))
+    {
+      ble_g_Transport_s.trusted_u8 = l_desc_s.sec_state.encrypted && l_desc_s.sec_state.authenticated &&
+                                     l_desc_s.sec_state.bonded;
+    }
+    if (!ble_g_Transport_s.trusted_u8)
+    {
+      ESP_LOGW(BLE_TAG, "Link not secured (status %d), control frames are ignored", event->enc_change.status);
+    }
+    break;
+  case BLE_GAP_EVENT_PASSKEY_ACTION:
+    if (event->passkey.params.action == BLE_SM_IOACT_DISP)
+    {
+      memset(&l_io_s, 0, sizeof(l_io_s));
+      l_io_s.action = BLE_SM_IOACT_DISP;
+      l_io_s.passkey = ble_g_Passkey_u32;
+      ble_sm_inject_io(event->passkey.conn_handle, &l_io_s);
+    }
+    break;
+  case BLE_GAP_EVENT_REPEAT_PAIRING:
+    /* The host lost its keys and pairs again, it still needs the passkey, so the old bond can go */
+    if (ble_gap_conn_find(event->repeat_pairing.conn_handle, &l_desc_s) == 0)
+    {
+      ble_store_util_delete_peer(&l_desc_s.peer_id_addr);
+    }
+    return BLE_GAP_REPEAT_PAIRING_RETRY;
+  case BLE_GAP_EVENT_ADV_COMPLETE:
+    ble_f_Advertise_v();
+    break;
+  default:
+    break;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Read or write of a characteristic, called by NimBLE from its host task
+ *
+ * RX only moves the bytes on to the telemetry task. CFG is handled right here, the parameters are
+ * single u16 values in the modules they belong to, which the telemetry task changes from this core as well.
+ * The stack already refuses writes over a link that isn't secured (see the flags in ble_g_Services_s),
+ * they are refused here as well in case it ever lets one through
+ *
+ * @param connHandle connection of the host
+ * @param attrHandle attribute accessed
+ * @param ctxt what the host does and its data
+ * @param arg characteristic, see ble_Chr_e
+ * @return 0 or an ATT error code
+ */
+int ble_f_Access_s32(uint16_t connHandle, uint16_t attrHandle, struct ble_gatt_access_ctxt *ctxt, void *arg)
+{
+  uint8_t l_buf_u8[BLE_MAX_NOTIFY];
+  uint16_t l_len_u16 = 0;
+  size_t l_sent_u32;
+
+  switch ((ble_Chr_e)(uintptr_t)arg)
+  {
+  case BLE_CHR_RX:
+    if (ctxt->op != BLE_GATT_ACCESS_OP_WRITE_CHR)
+    {
+      return BLE_ATT_ERR_UNLIKELY;
+    }
+    if (!ble_g_Transport_s.trusted_u8)
+    {
+      return BLE_ATT_ERR_INSUFFICIENT_AUTHEN;
+    }
+    if (ble_hs_mbuf_to_flat(ctxt->om, l_buf_u8, sizeof(l_buf_u8), &l_len_u16) != 0)
+    {
+      return BLE_ATT_ERR_INVALID_ATTR_VALUE_LEN;
+    }
+    l_sent_u32 = xStreamBufferSend(ble_g_RxStream_s, l_buf_u8, l_len_u16, 0);
+    ble_g_RxOverflow_u32 += l_len_u16 - l_sent_u32;
+    return 0;
+  case BLE_CHR_CFG:
+    if (ctxt->op == BLE_GATT_ACCESS_OP_READ_CHR)
+    {
+      l_len_u16 = cfg_f_Pack_u8(l_buf_u8);
+      return (os_mbuf_append(ctxt->om, l_buf_u8, l_len_u16) == 0) ? 0 : BLE_ATT_ERR_INSUFFICIENT_RES;
+    }
+    if (!ble_g_Transport_s.trusted_u8)
+    {
+      return BLE_ATT_ERR_INSUFFICIENT_AUTHEN;
+    }
+    if (ble_hs_mbuf_to_flat(ctxt->om, l_buf_u8, sizeof(l_buf_u8), &l_len_u16) != 0)
+    {
+      return BLE_ATT_ERR_INVALID_ATTR_VALUE_LEN;
+    }
+    /* Valid values are applied even if another one is not, a read shows what the parameters ended up at */
+    return cfg_f_Apply_u8(l_buf_u8, (uint8_t)l_len_u16) ? 0 : BLE_ATT_ERR_UNLIKELY;
+  case BLE_CHR_TX:
+  default:
+    return BLE_ATT_ERR_UNLIKELY;
+  }
+}
+
+/**
+ * @brief NimBLE host task, runs until the stack is stopped
+ *
+ * @return void
+ */
+void ble_f_HostTask_v(void *arg)
+{
+  nimble_port_run();
+  nimble_port_freertos_deinit();
+}
+
+#endif // BLUETOOTH
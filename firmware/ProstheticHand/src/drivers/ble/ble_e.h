@@ -0,0 +1,49 @@
+/**
+ * @file ble_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding ble.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef BLE_E_H
+#define BLE_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "config/project.h"
+#include "drivers/lnk/lnk_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+#define BLE_TAG "BLE"
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief The GATT service as a transport of the link, connected while the host listens to the TX characteristic
+ *
+ */
+extern lnk_s_Transport_t ble_g_Transport_s;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void ble_f_Init_v(void);
+
+#endif // BLE_E_H
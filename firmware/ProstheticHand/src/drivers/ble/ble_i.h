@@ -0,0 +1,205 @@
+/**
+ * @file ble_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding ble.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef BLE_I_H
+#define BLE_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "ble_e.h"
+
+#include "nimble/nimble_port.h"
+#include "nimble/nimble_port_freertos.h"
+#include "host/ble_hs.h"
+#include "host/util/util.h"
+#include "services/gap/ble_svc_gap.h"
+#include "services/gatt/ble_svc_gatt.h"
+#include "freertos/stream_buffer.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Name the hand advertises with
+ *
+ * @values up to 8 characters, so the name still fits next to the service UUID in the advertisement
+ */
+#define BLE_DEVICE_NAME "OpenHand"
+
+/**
+ * @brief 128-bit UUIDs of the service and its characteristics, 4f70656e-4861-6e64-0000-00000000000N ("OpenHand")
+ *
+ * Written LSB first, as BLE_UUID128_INIT() takes them
+ */
+#define BLE_UUID(n) BLE_UUID128_INIT((n), 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x64, 0x6e, 0x61, 0x48, 0x6e, 0x65, 0x70, 0x4f)
+#define BLE_UUID_SERVICE 0x01
+#define BLE_UUID_TX 0x02  /* notify: the telemetry frames, as a byte stream */
+#define BLE_UUID_RX 0x03  /* write, write without response (encrypted, authenticated): frames from the host, as a byte stream */
+#define BLE_UUID_CFG 0x04 /* read (encrypted): CFG payload, write (encrypted, authenticated): CFG_SET payload */
+
+/**
+ * @brief Where the passkey a host has to enter when it pairs with the hand is kept in NVS
+ *
+ * The hand has no display or keyboard, so the passkey is drawn from the hardware random number generator on the first
+ * boot and kept from then on, every hand gets its own. It is logged on the console at every boot, to be printed on
+ * the hand; erasing the namespace draws a new one
+ *
+ * @values NVS namespace and key, at most 15 characters each
+ */
+#define BLE_NVS_NAMESPACE "ble"
+#define BLE_NVS_KEY_PASSKEY "passkey"
+
+/**
+ * @brief Passkeys are 6 digits
+ *
+ * @values 0..BLE_PASSKEY_MAX
+ */
+#define BLE_PASSKEY_MAX 999999
+
+/**
+ * @brief Size of the buffer the frames wait in until the next flush sends them as notifications
+ *
+ * A period of telemetry at the default subscriptions is well below 1 kB, the rest is for a slow connection interval
+ *
+ * @values > LNK_MAX_FRAME
+ */
+#define BLE_TX_BUF_SIZE 2048
+
+/**
+ * @brief Size of the buffer the bytes written by the host wait in until the telemetry task picks them up
+ *
+ * @values > LNK_MAX_FRAME
+ */
+#define BLE_RX_BUF_SIZE 1024
+
+/**
+ * @brief ATT MTU until the host negotiates a larger one, and what a notification takes of it
+ *
+ * A notification carries MTU - 3 bytes (ATT header), one of which is our notification sequence number
+ */
+#define BLE_DEFAULT_MTU 23
+#define BLE_NOTIFY_OVERHEAD (3 + 1)
+
+/**
+ * @brief Largest notification sent and largest write taken, whatever MTU the host offers
+ *
+ * @values >= MSG_CFG_LEN, as the CFG characteristic is read and written in one go
+ */
+#define BLE_MAX_NOTIFY 244
+
+/**
+ * @brief Keys exchanged when pairing, kept in NVS so a bonded host doesn't have to pair again
+ *
+ */
+#define BLE_KEY_DIST (BLE_SM_PAIR_KEY_DIST_ENC | BLE_SM_PAIR_KEY_DIST_ID)
+
+/**
+ * @brief Characteristics, passed to the access callback as its argument
+ *
+ */
+typedef enum
+{
+  BLE_CHR_TX = 0,
+  BLE_CHR_RX,
+  BLE_CHR_CFG
+} ble_Chr_e;
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Frames waiting to be sent as notifications, only touched by the telemetry task
+ *
+ */
+extern uint8_t ble_g_TxBuf_u8[BLE_TX_BUF_SIZE];
+extern uint16_t ble_g_TxHead_u16;
+extern uint16_t ble_g_TxTail_u16;
+
+/**
+ * @brief When the oldest byte still waiting in ble_g_TxBuf_u8 was queued, for the backlog statistics
+ *
+ */
+extern int64_t ble_g_TxSinceUs_s64;
+
+/**
+ * @brief Sequence number of the next notification, lets the host notice a lost one and resync on the next frame
+ *
+ */
+extern uint8_t ble_g_NotifySeq_u8;
+
+/**
+ * @brief Bytes written by the host, from the NimBLE host task to the telemetry task
+ *
+ */
+extern StreamBufferHandle_t ble_g_RxStream_s;
+
+/**
+ * @brief Bytes written by the host that did not fit into ble_g_RxStream_s, and how many of those were already counted
+ *
+ */
+extern uint32_t ble_g_RxOverflow_u32;
+extern uint32_t ble_g_RxOverflowCounted_u32;
+
+/**
+ * @brief Connection, the attribute handle of TX and the MTU, written by the NimBLE host task
+ *
+ */
+extern uint16_t ble_g_ConnHandle_u16;
+extern uint16_t ble_g_TxHandle_u16;
+extern uint16_t ble_g_Mtu_u16;
+
+/**
+ * @brief Own address type, found out once the host and the controller are in sync
+ *
+ */
+extern uint8_t ble_g_AddrType_u8;
+
+/**
+ * @brief Passkey of this hand, loaded from NVS at init
+ *
+ * @values 0..BLE_PASSKEY_MAX
+ */
+extern uint32_t ble_g_Passkey_u32;
+
+/**
+ * @brief The GATT service and its characteristics
+ *
+ */
+extern const struct ble_gatt_svc_def ble_g_Services_s[];
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void ble_f_LoadPasskey_v(void);
+extern uint8_t ble_f_Write_u8(const uint8_t *frame, uint16_t len);
+extern void ble_f_Flush_v(void);
+extern void ble_f_Poll_v(void);
+extern void ble_f_Advertise_v(void);
+extern void ble_f_OnSync_v(void);
+extern void ble_f_OnReset_v(int reason);
+extern int ble_f_GapEvent_s32(struct ble_gap_event *event, void *arg);
+extern int ble_f_Access_s32(uint16_t connHandle, uint16_t attrHandle, struct ble_gatt_access_ctxt *ctxt, void *arg);
+extern void ble_f_HostTask_v(void *arg);
+
+/* NimBLE keeps the bonds in NVS with this, it has no header of its own */
+extern void ble_store_config_init(void);
+
+#endif // BLE_I_H
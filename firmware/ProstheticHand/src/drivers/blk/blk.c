@@ -0,0 +1,145 @@
+/**
+ * @file blk.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Sample block software component
+ *
+ * One block type for the inputs of the sensor pipeline (SNS, POT, BAT): the last len samples of every channel
+ * as floats, channel-major, each channel starting on a BLK_ALIGN boundary, plus the sequence number and the
+ * timestamp of the newest frame. A frame (one sample of every channel) goes into the ring of every channel
+ * without shifting the older ones, and the stages after it (filters, features, recording) take the whole block
+ * by reference. Their inner loops run over one channel's contiguous, aligned samples in steps of BLK_LANES,
+ * with an accumulator per lane, which is the shape SIMD loads and the dual FPU issue want.
+ *
+ * A block never takes locks, it belongs to the module that pushes into it. Other cores reading it see every
+ * single sample whole, like any other float.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "blk_e.h"
+#include "blk_i.h"
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+void blk_f_Init_v(blk_s_Block_t *block, float32_t *storage, uint8_t channels, uint16_t len);
+void blk_f_Push_v(blk_s_Block_t *block, const float32_t *frame, uint32_t timeUs);
+void blk_f_Mean_v(const blk_s_Block_t *block, float32_t *means);
+float32_t blk_f_Latest_f32(const blk_s_Block_t *block, uint8_t channel);
+
+/**
+ * @brief Set up a block over its storage, every sample starts at 0
+ *
+ * @param block to set up
+ * @param storage float32_t [channels][BLK_STRIDE(len)], BLK_STORAGE_ATTR
+ * @param channels of the input
+ * @param len samples of every channel, 1..
+ * @return void
+ */
+void blk_f_Init_v(blk_s_Block_t *block, float32_t *storage, uint8_t channels, uint16_t len)
+{
+  uint32_t i;
+
+  block->samples_pf32 = storage;
+  block->channels_u8 = channels;
+  block->len_u16 = len;
+  block->stride_u16 = BLK_STRIDE(len);
+  block->head_u16 = 0;
+  block->seq_u32 = 0;
+  block->timeUs_u32 = 0;
+
+  /* The padding as well, the inner loops add it */
+  for (i = 0; i < (uint32_t)channels * block->stride_u16; i++)
+  {
+    storage[i] = 0;
+  }
+}
+
+/**
+ * @brief Put a frame into the block, in place of the oldest one
+ *
+ * @param block to put it into
+ * @param frame one sample of every channel
+ * @param timeUs when it was taken, lower 32 bits of esp_timer_get_time()
+ * @return void
+ */
+void BLK_IRAM_ATTR blk_f_Push_v(blk_s_Block_t *block, const float32_t *frame, uint32_t timeUs)
+{
+  float32_t *l_sample_pf32 = block->samples_pf32 + block->head_u16;
+  uint8_t i;
+
+  for (i = 0; i < block->channels_u8; i++)
+  {
+    *l_sample_pf32 = frame[i];
+    l_sample_pf32 += block->stride_u16;
+  }
+
+  block->head_u16++;
+  if (block->head_u16 >= block->len_u16)
+  {
+    block->head_u16 = 0;
+  }
+  block->timeUs_u32 = timeUs;
+  block->seq_u32++;
+}
+
+/**
+ * @brief Moving average: the mean of the samples of every channel
+ *
+ * @param block to average
+ * @param means one per channel
+ * @return void
+ */
+void BLK_IRAM_ATTR blk_f_Mean_v(const blk_s_Block_t *block, float32_t *means)
+{
+  const float32_t *l_row_pf32 = block->samples_pf32;
+  float32_t l_acc0_f32, l_acc1_f32, l_acc2_f32, l_acc3_f32;
+  uint16_t j;
+  uint8_t i;
+
+  for (i = 0; i < block->channels_u8; i++)
+  {
+    l_acc0_f32 = 0;
+    l_acc1_f32 = 0;
+    l_acc2_f32 = 0;
+    l_acc3_f32 = 0;
+
+    /* Up to the stride, the padding is 0 */
+    for (j = 0; j < block->stride_u16; j += BLK_LANES)
+    {
+      l_acc0_f32 += l_row_pf32[j];
+      l_acc1_f32 += l_row_pf32[j + 1];
+      l_acc2_f32 += l_row_pf32[j + 2];
+      l_acc3_f32 += l_row_pf32[j + 3];
+    }
+
+    means[i] = ((l_acc0_f32 + l_acc1_f32) + (l_acc2_f32 + l_acc3_f32)) / (float32_t)block->len_u16;
+    l_row_pf32 += block->stride_u16;
+  }
+}
+
+/**
+ * @brief Newest sample of a channel
+ *
+ * @param block to read
+ * @param channel 0..channels - 1
+ * @return the sample, 0 before the first frame
+ */
+float32_t BLK_IRAM_ATTR blk_f_Latest_f32(const blk_s_Block_t *block, uint8_t channel)
+{
+  uint16_t l_index_u16 = (block->head_u16 == 0) ? (block->len_u16 - 1) : (block->head_u16 - 1);
+
+  return block->samples_pf32[(uint32_t)channel * block->stride_u16 + l_index_u16];
+}
@@ -0,0 +1,80 @@
+/**
+ * @file blk_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding blk.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef BLK_E_H
+#define BLK_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "config/project.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+#define BLK_TAG "BLK"
+
+/**
+ * @brief Alignment of the samples of every channel, what 4 float lanes of a SIMD load need
+ *
+ * @values in bytes
+ */
+#define BLK_ALIGN 16
+
+/**
+ * @brief Samples a channel takes up in the storage of a block of len samples, rounded up so every channel
+ * starts aligned and the inner loops can go 4 samples at a time
+ *
+ * @values len rounded up to a multiple of 4
+ */
+#define BLK_STRIDE(len) ((((len) + 3) / 4) * 4)
+
+/**
+ * @brief Storage of a block, to be declared by its owner with BLK_ALIGN
+ *
+ * @values float32_t name[channels][BLK_STRIDE(len)]
+ */
+#define BLK_STORAGE_ATTR __attribute__((aligned(BLK_ALIGN)))
+
+/**
+ * @brief Block of the last len samples of every channel of an input, channel-major (structure of arrays)
+ *
+ * Every channel is a ring of len samples, the newest one is the one before head_u16. Whoever reads it
+ * gets it by reference, the samples are never copied
+ */
+typedef struct
+{
+  float32_t *samples_pf32; /* [channels_u8][stride_u16], zero from len_u16 up to stride_u16 */
+  uint32_t seq_u32;        /* Frames pushed so far, the sequence number of the newest one */
+  uint32_t timeUs_u32;     /* When the newest frame was taken, lower 32 bits of esp_timer_get_time() */
+  uint16_t len_u16;        /* Samples of every channel */
+  uint16_t stride_u16;     /* BLK_STRIDE(len_u16), from one channel to the next */
+  uint16_t head_u16;       /* Where the next frame goes */
+  uint8_t channels_u8;     /* Channels of the input */
+} blk_s_Block_t;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void blk_f_Init_v(blk_s_Block_t *block, float32_t *storage, uint8_t channels, uint16_t len);
+extern void blk_f_Push_v(blk_s_Block_t *block, const float32_t *frame, uint32_t timeUs);
+extern void blk_f_Mean_v(const blk_s_Block_t *block, float32_t *means);
+extern float32_t blk_f_Latest_f32(const blk_s_Block_t *block, uint8_t channel);
+
+#endif // BLK_E_H
@@ -0,0 +1,40 @@
+/**
+ * @file blk_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding blk.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef BLK_I_H
+#define BLK_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "blk_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Samples every step of the inner loops takes, one per accumulator
+ *
+ * @values 4, BLK_STRIDE() rounds to it
+ */
+#define BLK_LANES 4
+
+_Static_assert(BLK_STRIDE(1) == BLK_LANES, "BLK_STRIDE has to round to BLK_LANES samples");
+_Static_assert(BLK_ALIGN == BLK_LANES * sizeof(float32_t), "A lane step has to be exactly one aligned load");
+
+#endif // BLK_I_H
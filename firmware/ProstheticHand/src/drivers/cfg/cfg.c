@@ -0,0 +1,157 @@
+/**
+ * @file cfg.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Configuration parameters software component
+ *
+ * One list of the parameters that can be tuned without reflashing, shared by the telemetry link
+ * (CFG_SET / CFG frames) and the BLE config characteristic, so both read and write them the same way.
+ * The values live in the modules they belong to, this only maps a parameter index onto them.
+ * Nothing is stored, every value is back to its default after a reset.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "cfg_e.h"
+#include "cfg_i.h"
+
+/* Other components used here */
+#include "drivers/sns/sns_e.h"
+#include "drivers/srv/srv_e.h"
+#include "drivers/osm/osm_e.h"
+#include "drivers/trc/trc_e.h"
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+uint16_t cfg_f_Get_u16(cfg_Param_e param);
+uint8_t cfg_f_Set_u8(cfg_Param_e param, uint16_t value);
+uint8_t cfg_f_Pack_u8(uint8_t *buf);
+uint8_t cfg_f_Apply_u8(const uint8_t *payload, uint8_t len);
+
+/**
+ * @brief Current value of a parameter
+ *
+ * @param param parameter, see cfg_Param_e
+ * @return its value, 0 for an unknown parameter
+ */
+uint16_t cfg_f_Get_u16(cfg_Param_e param)
+{
+  switch (param)
+  {
+  case CFG_SNS1_THRESHOLD:
+  case CFG_SNS2_THRESHOLD:
+    return sns_f_GetThreshold_u16(param - CFG_SNS1_THRESHOLD);
+  case CFG_SRV1_RANGE:
+  case CFG_SRV2_RANGE:
+  case CFG_SRV3_RANGE:
+    return srv_f_GetRange_u16(param - CFG_SRV1_RANGE);
+#ifdef TELEMETRY
+  case CFG_OS_STATS_PERIOD:
+    return osm_f_GetPeriod_u16();
+  case CFG_TRACE_EVENTS:
+    return trc_f_GetEvents_u16();
+#endif
+  default:
+    return 0;
+  }
+}
+
+/**
+ * @brief Change a parameter
+ *
+ * @param param parameter, see cfg_Param_e
+ * @param value new value, checked by the module it belongs to
+ * @return 1 if it was changed, 0 if the parameter is unknown or the value out of range
+ */
+uint8_t cfg_f_Set_u8(cfg_Param_e param, uint16_t value)
+{
+  switch (param)
+  {
+  case CFG_SNS1_THRESHOLD:
+  case CFG_SNS2_THRESHOLD:
+    return sns_f_SetThreshold_u8(param - CFG_SNS1_THRESHOLD, value);
+  case CFG_SRV1_RANGE:
+  case CFG_SRV2_RANGE:
+  case CFG_SRV3_RANGE:
+    return srv_f_SetRange_u8(param - CFG_SRV1_RANGE, value);
+#ifdef TELEMETRY
+  case CFG_OS_STATS_PERIOD:
+    return osm_f_SetPeriod_u8(value);
+  case CFG_TRACE_EVENTS:
+    return trc_f_SetEvents_u8(value);
+#endif
+  default:
+    return 0;
+  }
+}
+
+/**
+ * @brief Write all parameters into a payload
+ *
+ * Payload: CFG, see firmware/msg/messages.py
+ *
+ * @param buf room for MSG_CFG_LEN bytes
+ * @return payload length
+ */
+uint8_t cfg_f_Pack_u8(uint8_t *buf)
+{
+  msg_s_Cfg_t l_cfg_s;
+  uint8_t i;
+
+  for (i = 0; i < CFG_COUNT; i++)
+  {
+    l_cfg_s.values_s[i].value_u16 = cfg_f_Get_u16((cfg_Param_e)i);
+  }
+  l_cfg_s.valuesCount_u8 = CFG_COUNT;
+
+  return msg_f_PackCfg_u8(buf, &l_cfg_s);
+}
+
+/**
+ * @brief Change the parameters as the host asked
+ *
+ * Payload: CFG_SET, see firmware/msg/messages.py. Every valid value is applied even if another one is not,
+ * the host sees what it ended up with in the CFG reply
+ *
+ * @param payload received payload
+ * @param len payload length
+ * @return 1 if every value was applied (or kept), 0 if at least one was rejected
+ */
+uint8_t cfg_f_Apply_u8(const uint8_t *payload, uint8_t len)
+{
+  msg_s_CfgSet_t l_set_s;
+  uint8_t l_ok_u8 = 1;
+  uint8_t i;
+
+  if (!msg_f_UnpackCfgSet_u8(&l_set_s, payload, len))
+  {
+    return 0;
+  }
+
+  for (i = 0; i < l_set_s.valuesCount_u8; i++)
+  {
+    if (l_set_s.values_s[i].value_u16 == CFG_KEEP)
+    {
+      continue;
+    }
+
+    if ((i >= CFG_COUNT) || !cfg_f_Set_u8((cfg_Param_e)i, l_set_s.values_s[i].value_u16))
+    {
+      l_ok_u8 = 0;
+    }
+  }
+
+  return l_ok_u8;
+}
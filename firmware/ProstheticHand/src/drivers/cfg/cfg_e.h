@@ -0,0 +1,66 @@
+/**
+ * @file cfg_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding cfg.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef CFG_E_H
+#define CFG_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "config/project.h"
+#include "drivers/msg/msg_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+#define CFG_TAG "CFG"
+
+/**
+ * @brief Value in CFG_SET that leaves a parameter as it is
+ *
+ */
+#define CFG_KEEP 0xFFFF
+
+/**
+ * @brief Parameters that can be tuned over the telemetry link or BLE, in the order they are sent in CFG
+ *
+ * Defined in CFG_PARAMS of firmware/msg/messages.py, so firmware and host can't disagree about the indexes;
+ * a parameter missing here or there doesn't build (see cfg_i.h)
+ */
+typedef enum
+{
+  CFG_SNS1_THRESHOLD = MSG_PARAM_SNS1_THRESHOLD,
+  CFG_SNS2_THRESHOLD = MSG_PARAM_SNS2_THRESHOLD,
+  CFG_SRV1_RANGE = MSG_PARAM_SRV1_RANGE,
+  CFG_SRV2_RANGE = MSG_PARAM_SRV2_RANGE,
+  CFG_SRV3_RANGE = MSG_PARAM_SRV3_RANGE,
+  CFG_OS_STATS_PERIOD = MSG_PARAM_OS_STATS_PERIOD,
+  CFG_TRACE_EVENTS = MSG_PARAM_TRACE_EVENTS,
+  CFG_COUNT
+} cfg_Param_e;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern uint16_t cfg_f_Get_u16(cfg_Param_e param);
+extern uint8_t cfg_f_Set_u8(cfg_Param_e param, uint16_t value);
+extern uint8_t cfg_f_Pack_u8(uint8_t *buf);
+extern uint8_t cfg_f_Apply_u8(const uint8_t *payload, uint8_t len);
+
+#endif // CFG_E_H
@@ -0,0 +1,42 @@
+/**
+ * @file cfg_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding cfg.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef CFG_I_H
+#define CFG_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "cfg_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Every parameter has to fit into one CFG frame, otherwise raise the group max of CFG and CFG_SET in messages.py
+ *
+ */
+_Static_assert(CFG_COUNT <= MSG_CFG_VALUES_MAX, "More parameters than a CFG frame can carry");
+
+/**
+ * @brief Every parameter of CFG_PARAMS in messages.py has its cfg_Param_e, so the last one is the last one there
+ *
+ */
+_Static_assert((int)CFG_COUNT == (int)MSG_PARAM_COUNT, "cfg_Param_e and CFG_PARAMS in messages.py differ");
+
+#endif // CFG_I_H
@@ -0,0 +1,402 @@
+/**
+ * @file cht.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Flash cache benchmark software component
+ *
+ * Shows what the flash cache costs the main OS, and what placing the control loop in IRAM (IRAM_MAIN... in
+ * defines.h) buys. After settling, a task on core 0 alternates quiet phases with flash phases, in which it
+ * writes a blob to NVS (the cache is off on both cores while the flash is erased or written) and then reads a table
+ * twice the size of the data cache through it (which evicts everything else). Meanwhile the worst runtime and start
+ * delay of every slot are recorded per kind of phase. Build it once with the IRAM_* lines and once without to
+ * compare them.
+ *
+ * The same comparison within one build: after slot CHT_PROBE_SLOT the same moving average filter runs once from
+ * IRAM with its taps in DRAM, and once from flash with its taps in flash, each timed in CPU cycles.
+ *
+ * IRAM doesn't keep the main OS running through a write: only IRAM code that reads no flash data runs then, and
+ * interrupts registered with ESP_INTR_FLAG_IRAM. ESP-IDF parks the other core for the length of the write, and the
+ * main OS task calls FreeRTOS and esp_timer functions that aren't IRAM-safe, so core 1 stalls in any build. IRAM only
+ * removes the misses after a write. The worst slot start delay of the flash phases is the measured bound of how late
+ * an NVS write makes the control loop, the report prints it per phase. Only compiled in when CACHE_TEST is defined
+ * (see defines.h).
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "cht_e.h"
+#include "cht_i.h"
+
+#ifdef CACHE_TEST
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Current phase, switched by the flash task
+ *
+ * @values see cht_Phase_e
+ */
+volatile cht_Phase_e cht_g_Phase_e = CHT_PHASE_SETTLE;
+
+/**
+ * @brief Worst cases of every kind of phase
+ *
+ * @values indexed by cht_Phase_e, CHT_PHASE_SETTLE stays empty
+ */
+cht_s_Report_t cht_g_Report_s[CHT_PHASE_COUNT];
+
+/**
+ * @brief Handle of the flash task, and of its NVS namespace
+ *
+ */
+TaskHandle_t cht_g_TaskHandle_s = NULL;
+nvs_handle_t cht_g_Nvs_s;
+
+/**
+ * @brief What the flash task writes, and what it reads through the flash cache
+ *
+ */
+uint8_t cht_g_Blob_u8[CHT_BLOB_LEN];
+const uint8_t cht_c_Table_u8[CHT_TABLE_LEN] = {[0 ... CHT_TABLE_LEN - 1] = 0xA5};
+
+/**
+ * @brief Modules of this build placed in IRAM, for the report
+ *
+ */
+const char cht_c_Placement_c[] = "IRAM:"
+#ifdef IRAM_MAIN
+                                 " MAIN"
+#endif
+#ifdef IRAM_DLM
+                                 " DLM"
+#endif
+#ifdef IRAM_ERR
+                                 " ERR"
+#endif
+#ifdef IRAM_BAT
+                                 " BAT"
+#endif
+#ifdef IRAM_POT
+                                 " POT"
+#endif
+#ifdef IRAM_SNS
+                                 " SNS"
+#endif
+#ifdef IRAM_SRV
+                                 " SRV"
+#endif
+#ifdef IRAM_SUP
+                                 " SUP"
+#endif
+#ifdef IRAM_BLK
+                                 " BLK"
+#endif
+    ;
+
+/**
+ * @brief Sum of the table reads, so they can't be optimized away
+ *
+ */
+volatile uint32_t cht_g_Sink_u32 = 0;
+
+/**
+ * @brief Samples and taps of the filter probe, one copy of the taps in DRAM and one in flash
+ *
+ */
+float32_t cht_g_Samples_f32[CHT_PROBE_TAPS];
+DRAM_ATTR const float32_t cht_c_TapsDram_f32[CHT_PROBE_TAPS] = {[0 ... CHT_PROBE_TAPS - 1] = 1.0f / CHT_PROBE_TAPS};
+const float32_t cht_c_TapsFlash_f32[CHT_PROBE_TAPS] = {[0 ... CHT_PROBE_TAPS - 1] = 1.0f / CHT_PROBE_TAPS};
+
+/**
+ * @brief Last output of the filter probe
+ *
+ */
+volatile float32_t cht_g_ProbeOut_f32 = 0;
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+void cht_f_Init_v(void);
+void cht_f_Handle_v(uint16_t slotIndex, uint32_t startDelayUs, uint32_t runtimeUs);
+
+void cht_f_Task_v(void *arg);
+void cht_f_Probe_v(cht_s_Report_t *report);
+float32_t cht_f_FilterIram_f32(void) __attribute__((noinline));
+float32_t cht_f_FilterFlash_f32(void) __attribute__((noinline));
+
+#ifdef SERIAL_DEBUG
+void cht_f_SerialDebug_v(void);
+#endif
+
+/**
+ * @brief Initialize function to be called once on startup/boot
+ *
+ * Open the NVS namespace of the benchmark and start the flash task
+ *
+ * @return void
+ */
+void cht_f_Init_v(void)
+{
+  esp_err_t l_ret_s32;
+  uint16_t i, j;
+
+  for (i = 0; i < CHT_PHASE_COUNT; i++)
+  {
+    for (j = 0; j < MAIN_CYCLE_TASK_COUNT; j++)
+    {
+      cht_g_Report_s[i].maxRuntime_u32[j] = 0;
+      cht_g_Report_s[i].maxStartDelay_u32[j] = 0;
+    }
+    cht_g_Report_s[i].iramMaxCycles_u32 = 0;
+    cht_g_Report_s[i].flashMaxCycles_u32 = 0;
+    cht_g_Report_s[i].iramSumCycles_u64 = 0;
+    cht_g_Report_s[i].flashSumCycles_u64 = 0;
+    cht_g_Report_s[i].probes_u32 = 0;
+    cht_g_Report_s[i].writes_u32 = 0;
+    cht_g_Report_s[i].maxWriteUs_u32 = 0;
+  }
+
+  for (i = 0; i < CHT_PROBE_TAPS; i++)
+  {
+    cht_g_Samples_f32[i] = (float32_t)i;
+  }
+
+  /* Already done if BLE is on, then this only returns ESP_OK */
+  l_ret_s32 = nvs_flash_init();
+  if ((l_ret_s32 == ESP_ERR_NVS_NO_FREE_PAGES) || (l_ret_s32 == ESP_ERR_NVS_NEW_VERSION_FOUND))
+  {
+    ESP_ERROR_CHECK(nvs_flash_erase());
+    l_ret_s32 = nvs_flash_init();
+  }
+  ESP_ERROR_CHECK(l_ret_s32);
+  ESP_ERROR_CHECK(nvs_open(CHT_TAG, NVS_READWRITE, &cht_g_Nvs_s));
+
+  xTaskCreatePinnedToCore(cht_f_Task_v, "cht_f_Task_v", 2048, NULL, CHT_TASK_PRIO, &cht_g_TaskHandle_s, 0);
+
+  ESP_LOGI(CHT_TAG, "Flash cache benchmark enabled, %s", cht_c_Placement_c);
+}
+
+/**
+ * @brief Handle function to be called after each slot
+ *
+ * Update the worst cases of the current phase with the finished slot, and run the filter probe
+ * after CHT_PROBE_SLOT
+ *
+ * @param slotIndex index of the slot that just finished
+ * @param startDelayUs how late the slot started compared to its ideal start
+ * @param runtimeUs how long the slot took
+ * @return void
+ */
+void cht_f_Handle_v(uint16_t slotIndex, uint32_t startDelayUs, uint32_t runtimeUs)
+{
+  cht_s_Report_t *l_report_s;
+
+  if (cht_g_Phase_e == CHT_PHASE_SETTLE)
+  {
+    return;
+  }
+
+  l_report_s = &cht_g_Report_s[cht_g_Phase_e];
+
+  if (runtimeUs > l_report_s->maxRuntime_u32[slotIndex])
+  {
+    l_report_s->maxRuntime_u32[slotIndex] = runtimeUs;
+  }
+  if (startDelayUs > l_report_s->maxStartDelay_u32[slotIndex])
+  {
+    l_report_s->maxStartDelay_u32[slotIndex] = startDelayUs;
+  }
+
+  if (slotIndex == CHT_PROBE_SLOT)
+  {
+    cht_f_Probe_v(l_report_s);
+  }
+}
+
+/**
+ * @brief Flash task, switches the phases and writes / reads the flash during flash phases
+ *
+ * @param arg - unused
+ *
+ * @return void
+ */
+void cht_f_Task_v(void *arg)
+{
+  uint64_t l_startUs_u64 = esp_timer_get_time();
+  uint64_t l_writeUs_u64;
+  uint32_t l_phases_u32;
+  uint32_t l_sum_u32;
+  uint32_t i;
+  cht_s_Report_t *l_report_s = &cht_g_Report_s[CHT_PHASE_FLASH];
+
+  while (true)
+  {
+    l_phases_u32 = (uint32_t)((esp_timer_get_time() - l_startUs_u64) / CHT_PHASE_US);
+    if (l_phases_u32 == 0)
+    {
+      cht_g_Phase_e = CHT_PHASE_SETTLE;
+    }
+    else
+    {
+      cht_g_Phase_e = (l_phases_u32 % 2) ? CHT_PHASE_QUIET : CHT_PHASE_FLASH;
+    }
+
+    if (cht_g_Phase_e == CHT_PHASE_FLASH)
+    {
+      /* A different blob every time, NVS skips writing what it already holds */
+      cht_g_Blob_u8[l_report_s->writes_u32 % CHT_BLOB_LEN]++;
+
+      l_writeUs_u64 = esp_timer_get_time();
+      ESP_ERROR_CHECK_WITHOUT_ABORT(nvs_set_blob(cht_g_Nvs_s, "blob", cht_g_Blob_u8, CHT_BLOB_LEN));
+      ESP_ERROR_CHECK_WITHOUT_ABORT(nvs_commit(cht_g_Nvs_s));
+      l_writeUs_u64 = esp_timer_get_time() - l_writeUs_u64;
+
+      l_report_s->writes_u32++;
+      if (l_writeUs_u64 > l_report_s->maxWriteUs_u32)
+      {
+        l_report_s->maxWriteUs_u32 = (uint32_t)l_writeUs_u64;
+      }
+
+      /* One read per cache line */
+      l_sum_u32 = 0;
+      for (i = 0; i < CHT_TABLE_LEN; i += 32)
+      {
+        l_sum_u32 += cht_c_Table_u8[i];
+      }
+      cht_g_Sink_u32 = l_sum_u32;
+    }
+
+    vTaskDelay(CHT_WRITE_PERIOD_MS / portTICK_PERIOD_MS);
+  }
+}
+
+/**
+ * @brief Time the filter probe from IRAM and from flash
+ *
+ * @param report of the current phase
+ * @return void
+ */
+void cht_f_Probe_v(cht_s_Report_t *report)
+{
+  uint32_t l_start_u32;
+  uint32_t l_iram_u32;
+  uint32_t l_flash_u32;
+
+  /* New sample, so the output keeps changing */
+  cht_g_Samples_f32[report->probes_u32 % CHT_PROBE_TAPS] += 1.0f;
+
+  l_start_u32 = esp_cpu_get_cycle_count();
+  cht_g_ProbeOut_f32 = cht_f_FilterIram_f32();
+  l_iram_u32 = esp_cpu_get_cycle_count() - l_start_u32;
+
+  l_start_u32 = esp_cpu_get_cycle_count();
+  cht_g_ProbeOut_f32 = cht_f_FilterFlash_f32();
+  l_flash_u32 = esp_cpu_get_cycle_count() - l_start_u32;
+
+  if (l_iram_u32 > report->iramMaxCycles_u32)
+  {
+    report->iramMaxCycles_u32 = l_iram_u32;
+  }
+  if (l_flash_u32 > report->flashMaxCycles_u32)
+  {
+    report->flashMaxCycles_u32 = l_flash_u32;
+  }
+  report->iramSumCycles_u64 += l_iram_u32;
+  report->flashSumCycles_u64 += l_flash_u32;
+  report->probes_u32++;
+}
+
+/**
+ * @brief Filter probe from IRAM, taps from DRAM
+ *
+ * @return filter output
+ */
+float32_t IRAM_ATTR cht_f_FilterIram_f32(void)
+{
+  float32_t l_sum_f32 = 0;
+  uint8_t i;
+
+  for (i = 0; i < CHT_PROBE_TAPS; i++)
+  {
+    l_sum_f32 += cht_g_Samples_f32[i] * cht_c_TapsDram_f32[i];
+  }
+
+  return l_sum_f32;
+}
+
+/**
+ * @brief The same filter probe from flash, taps from flash
+ *
+ * @return filter output
+ */
+float32_t cht_f_FilterFlash_f32(void)
+{
+  float32_t l_sum_f32 = 0;
+  uint8_t i;
+
+  for (i = 0; i < CHT_PROBE_TAPS; i++)
+  {
+    l_sum_f32 += cht_g_Samples_f32[i] * cht_c_TapsFlash_f32[i];
+  }
+
+  return l_sum_f32;
+}
+
+#ifdef SERIAL_DEBUG
+void cht_f_SerialDebug_v(void)
+{
+  const char *l_names_pc[CHT_PHASE_COUNT] = {"settle", "quiet", "flash"};
+  cht_s_Report_t *l_report_s;
+  uint32_t l_ticksPerUs_u32 = esp_rom_get_cpu_ticks_per_us();
+  uint32_t l_maxStartDelay_u32;
+  uint32_t l_maxRuntime_u32;
+  uint16_t i, j;
+
+  ESP_LOGD(CHT_TAG, " > flash cache benchmark, %s, phase: %s", cht_c_Placement_c, l_names_pc[cht_g_Phase_e]);
+  for (i = CHT_PHASE_QUIET; i < CHT_PHASE_COUNT; i++)
+  {
+    l_report_s = &cht_g_Report_s[i];
+    if (l_report_s->probes_u32 == 0)
+    {
+      continue;
+    }
+
+    ESP_LOGD(CHT_TAG, "  %s: filter iram avg/max: %llu/%lu cycles (%lu us), flash avg/max: %llu/%lu cycles (%lu us), nvs writes: %lu, longest: %lu us",
+             l_names_pc[i],
+             l_report_s->iramSumCycles_u64 / l_report_s->probes_u32, l_report_s->iramMaxCycles_u32, l_report_s->iramMaxCycles_u32 / l_ticksPerUs_u32,
+             l_report_s->flashSumCycles_u64 / l_report_s->probes_u32, l_report_s->flashMaxCycles_u32, l_report_s->flashMaxCycles_u32 / l_ticksPerUs_u32,
+             l_report_s->writes_u32, l_report_s->maxWriteUs_u32);
+    l_maxStartDelay_u32 = 0;
+    l_maxRuntime_u32 = 0;
+    for (j = 0; j < MAIN_CYCLE_TASK_COUNT; j++)
+    {
+      ESP_LOGD(CHT_TAG, "    [%u] \tmax runtime: %lu, \tmax start delay: %lu", j, l_report_s->maxRuntime_u32[j], l_report_s->maxStartDelay_u32[j]);
+      if (l_report_s->maxStartDelay_u32[j] > l_maxStartDelay_u32)
+      {
+        l_maxStartDelay_u32 = l_report_s->maxStartDelay_u32[j];
+      }
+      if (l_report_s->maxRuntime_u32[j] > l_maxRuntime_u32)
+      {
+        l_maxRuntime_u32 = l_report_s->maxRuntime_u32[j];
+      }
+    }
+    /* In the flash phase the bound of what an NVS write costs the control loop */
+    ESP_LOGD(CHT_TAG, "    worst of all slots: start delay %lu us, runtime %lu us", l_maxStartDelay_u32, l_maxRuntime_u32);
+  }
+}
+#endif
+
+#endif // CACHE_TEST
@@ -0,0 +1,100 @@
+/**
+ * @file cht_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding cht.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef CHT_E_H
+#define CHT_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "config/project.h"
+#include "main_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+#define CHT_TAG "CHT"
+
+/**
+ * @brief Phases of the benchmark, after settling it alternates between quiet and flash
+ *
+ */
+typedef enum
+{
+  CHT_PHASE_SETTLE = 0, /* Waiting for the boot to settle, nothing recorded */
+  CHT_PHASE_QUIET,      /* No flash activity of the benchmark */
+  CHT_PHASE_FLASH,      /* The flash task writes NVS and reads through flash */
+  CHT_PHASE_COUNT
+} cht_Phase_e;
+
+/**************************************************************************
+ * Structures
+ **************************************************************************/
+
+/**
+ * @brief Worst cases seen during one kind of phase
+ *
+ */
+typedef struct
+{
+  /* Longest runtime and start delay of every slot of the main OS (us) */
+  uint32_t maxRuntime_u32[MAIN_CYCLE_TASK_COUNT];
+  uint32_t maxStartDelay_u32[MAIN_CYCLE_TASK_COUNT];
+
+  /* The same filter from IRAM with its taps in DRAM, and from flash with its taps in flash (CPU cycles) */
+  uint32_t iramMaxCycles_u32;
+  uint32_t flashMaxCycles_u32;
+  uint64_t iramSumCycles_u64;
+  uint64_t flashSumCycles_u64;
+  uint32_t probes_u32;
+
+  /* NVS writes of the flash task and the longest one (us) */
+  uint32_t writes_u32;
+  uint32_t maxWriteUs_u32;
+} cht_s_Report_t;
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Current phase, switched by the flash task
+ *
+ * @values see cht_Phase_e
+ */
+extern volatile cht_Phase_e cht_g_Phase_e;
+
+/**
+ * @brief Worst cases of every kind of phase
+ *
+ * @values indexed by cht_Phase_e, CHT_PHASE_SETTLE stays empty
+ */
+extern cht_s_Report_t cht_g_Report_s[CHT_PHASE_COUNT];
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void cht_f_Init_v(void);
+extern void cht_f_Handle_v(uint16_t slotIndex, uint32_t startDelayUs, uint32_t runtimeUs);
+
+#ifdef SERIAL_DEBUG
+extern void cht_f_SerialDebug_v(void);
+#endif
+
+#endif // CHT_E_H
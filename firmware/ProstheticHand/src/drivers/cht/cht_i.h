@@ -0,0 +1,78 @@
+/**
+ * @file cht_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding cht.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef CHT_I_H
+#define CHT_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "cht_e.h"
+
+#include "nvs.h"
+#include "nvs_flash.h"
+#include "esp_cpu.h"
+#include "esp_rom_sys.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Length of every phase, the first one is the settling
+ *
+ * @values in microseconds
+ */
+#define CHT_PHASE_US 5000000
+
+/**
+ * @brief How often the flash task writes during a flash phase
+ *
+ * @values in milliseconds, at least one tick
+ */
+#define CHT_WRITE_PERIOD_MS 20
+
+/**
+ * @brief Size of the NVS blob written every time, and of the table read through the flash cache after it
+ *
+ * The table is twice the data cache of the ESP32-S3, so reading it evicts everything else
+ *
+ * @values in bytes
+ */
+#define CHT_BLOB_LEN 1024
+#define CHT_TABLE_LEN (64 * 1024)
+
+/**
+ * @brief Priority of the flash task, below every other task on core 0
+ *
+ */
+#define CHT_TASK_PRIO 1
+
+/**
+ * @brief Free slot of the main OS after which the filter probe runs, it delays the start of the next slot
+ *
+ * @values 0..MAIN_CYCLE_TASK_COUNT - 1
+ */
+#define CHT_PROBE_SLOT 7
+
+/**
+ * @brief Taps of the filter probe, a moving average as in the sensor filters
+ *
+ */
+#define CHT_PROBE_TAPS 32
+
+#endif // CHT_I_H
@@ -0,0 +1,223 @@
+/**
+ * @file dlm.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Deadline monitor software component
+ *
+ * Every 1ms slot of the main OS has a declared execution budget (dlm_c_BudgetUs_u16) and its deadline is the end
+ * of the slot. After every slot the main OS hands over how late it started and how long it ran:
+ *  - a run longer than the budget is an overrun: counted, timestamped, marked in the trace and logged with
+ *    the serial debug output
+ *  - after DLM_SKIP_AFTER overruns in a row the next period of the slot is skipped, so the slots after it
+ *    get their time back
+ *  - after DLM_SAFE_AFTER overruns in a row the supervisor is tripped and holds the servos in the safe posture
+ * A run within the budget ends the overruns in a row. Ending after the end of the slot is counted as a deadline
+ * miss, it only escalates through the overruns, as a late start is the fault of the slot before.
+ *
+ * Hard hangs never return to the main OS, so they never get here: the supervisor catches them with its heartbeat,
+ * and the ESP-IDF task watchdog, fed every main cycle, resets the chip after DLM_WDT_TIMEOUT_MS.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "dlm_e.h"
+#include "dlm_i.h"
+
+/* Other components used here */
+#include "drivers/sup/sup_e.h"
+#include "drivers/trc/trc_e.h"
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Counters and state of every slot
+ *
+ * @values indexed by slot
+ */
+dlm_s_Slot_t dlm_g_Slots_s[MAIN_CYCLE_TASK_COUNT];
+
+/**
+ * @brief Execution budget of every slot, what its modules take at most on the bench with some margin
+ *
+ * @values in microseconds, at most main_c_CycleTaskLengthUs_u16, indexed by slot
+ */
+DLM_DRAM_ATTR const uint16_t dlm_c_BudgetUs_u16[MAIN_CYCLE_TASK_COUNT] = {
+    200, /* 0: debug LED patterns */
+    500, /* 1: BAT, ADC read */
+    200, /* 2: BTN */
+    500, /* 3: POT, ADC reads */
+    500, /* 4: SNS, ADC reads */
+    500, /* 5: SRV, PWM updates */
+    100, /* 6: ERR */
+    100, /* 7: free */
+    100, /* 8: free */
+    100  /* 9: free */
+};
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+void dlm_f_Init_v(void);
+uint8_t dlm_f_Skip_u8(uint16_t slot);
+void dlm_f_Check_v(uint16_t slot, uint32_t startDelayUs, uint32_t runtimeUs);
+
+#ifdef SERIAL_DEBUG
+void dlm_f_SerialDebug_v(void);
+#endif
+
+/**
+ * @brief Init function called once on boot, from the task of the main OS, after every other module
+ *
+ * Subscribes the task to the task watchdog, so the time the other modules take to start up doesn't count
+ *
+ * @return void
+ */
+void dlm_f_Init_v(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < MAIN_CYCLE_TASK_COUNT; i++)
+  {
+    dlm_g_Slots_s[i].overruns_u32 = 0;
+    dlm_g_Slots_s[i].misses_u32 = 0;
+    dlm_g_Slots_s[i].skips_u32 = 0;
+    dlm_g_Slots_s[i].lastOverrunUs_u32 = 0;
+    dlm_g_Slots_s[i].worstUs_u32 = 0;
+    dlm_g_Slots_s[i].logged_u32 = 0;
+    dlm_g_Slots_s[i].inARow_u16 = 0;
+    dlm_g_Slots_s[i].skipNext_u8 = 0;
+    dlm_g_Slots_s[i].level_e = DLM_LEVEL_OK;
+  }
+
+  /* The main OS polls the timer without ever blocking, so only the idle task of core 0 stays watched */
+  esp_task_wdt_config_t l_wdtConfig_s = {
+      .timeout_ms = DLM_WDT_TIMEOUT_MS,
+      .idle_core_mask = DLM_WDT_IDLE_CORE_MASK,
+      .trigger_panic = true};
+  ESP_ERROR_CHECK(esp_task_wdt_reconfigure(&l_wdtConfig_s));
+  ESP_ERROR_CHECK(esp_task_wdt_add(NULL));
+}
+
+/**
+ * @brief Called by the main OS before every slot, feeds the task watchdog when a main cycle starts
+ *
+ * @param slot which one
+ * @return 1 if this period of the slot is skipped, 0 if it runs
+ */
+uint8_t DLM_IRAM_ATTR dlm_f_Skip_u8(uint16_t slot)
+{
+  if (slot == 0)
+  {
+    esp_task_wdt_reset();
+  }
+
+  if (!dlm_g_Slots_s[slot].skipNext_u8)
+  {
+    return 0;
+  }
+
+  dlm_g_Slots_s[slot].skipNext_u8 = 0;
+  dlm_g_Slots_s[slot].skips_u32++;
+  return 1;
+}
+
+/**
+ * @brief Called by the main OS after every slot that ran, with its timing
+ *
+ * @param slot which one
+ * @param startDelayUs how much later than planned it started
+ * @param runtimeUs how long it ran
+ * @return void
+ */
+void DLM_IRAM_ATTR dlm_f_Check_v(uint16_t slot, uint32_t startDelayUs, uint32_t runtimeUs)
+{
+  dlm_s_Slot_t *l_slot_ps = &dlm_g_Slots_s[slot];
+
+  if (runtimeUs > l_slot_ps->worstUs_u32)
+  {
+    l_slot_ps->worstUs_u32 = runtimeUs;
+  }
+
+  if ((startDelayUs + runtimeUs) > main_c_CycleTaskLengthUs_u16)
+  {
+    l_slot_ps->misses_u32++;
+  }
+
+  if (runtimeUs <= dlm_c_BudgetUs_u16[slot])
+  {
+    l_slot_ps->inARow_u16 = 0;
+    if (l_slot_ps->level_e != DLM_LEVEL_SAFE)
+    {
+      l_slot_ps->level_e = DLM_LEVEL_OK;
+    }
+    return;
+  }
+
+  l_slot_ps->overruns_u32++;
+  l_slot_ps->lastOverrunUs_u32 = (uint32_t)esp_timer_get_time();
+  if (l_slot_ps->inARow_u16 < UINT16_MAX)
+  {
+    l_slot_ps->inARow_u16++;
+  }
+  trc_f_Record_v(TRC_EV_MARK, TRC_MARK_OVERRUN, slot);
+
+  if (l_slot_ps->level_e == DLM_LEVEL_OK)
+  {
+    l_slot_ps->level_e = DLM_LEVEL_LOG;
+  }
+
+#if !defined(LOAD_TEST) && !defined(CACHE_TEST)
+  /* The load test and the cache benchmark overrun the slots on purpose, there the overruns are only counted */
+  if (l_slot_ps->inARow_u16 >= DLM_SAFE_AFTER)
+  {
+    if (l_slot_ps->level_e != DLM_LEVEL_SAFE)
+    {
+      l_slot_ps->level_e = DLM_LEVEL_SAFE;
+      sup_f_Trip_v(SUP_FAULT_DEADLINE);
+    }
+  }
+  else if (l_slot_ps->inARow_u16 >= DLM_SKIP_AFTER)
+  {
+    l_slot_ps->level_e = DLM_LEVEL_SKIP;
+    l_slot_ps->skipNext_u8 = 1;
+  }
+#endif
+}
+
+#ifdef SERIAL_DEBUG
+void dlm_f_SerialDebug_v(void)
+{
+  uint8_t i;
+  dlm_s_Slot_t *l_slot_ps;
+
+  for (i = 0; i < MAIN_CYCLE_TASK_COUNT; i++)
+  {
+    l_slot_ps = &dlm_g_Slots_s[i];
+
+    /* The warning of the log step, from here so the main OS never waits for the console */
+    if (l_slot_ps->overruns_u32 != l_slot_ps->logged_u32)
+    {
+      ESP_LOGW(DLM_TAG, "Slot #%u over its budget of %u us %lu times, %u in a row, level %u", i, dlm_c_BudgetUs_u16[i], l_slot_ps->overruns_u32 - l_slot_ps->logged_u32, l_slot_ps->inARow_u16, l_slot_ps->level_e);
+      l_slot_ps->logged_u32 = l_slot_ps->overruns_u32;
+    }
+
+    if (l_slot_ps->overruns_u32 || l_slot_ps->misses_u32)
+    {
+      ESP_LOGD(DLM_TAG, "Slot #%u overruns = %lu (last at %lu us), deadline misses = %lu, skips = %lu, worst = %lu us", i, l_slot_ps->overruns_u32, l_slot_ps->lastOverrunUs_u32, l_slot_ps->misses_u32, l_slot_ps->skips_u32, l_slot_ps->worstUs_u32);
+    }
+  }
+}
+#endif
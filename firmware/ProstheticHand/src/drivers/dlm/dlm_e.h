@@ -0,0 +1,85 @@
+/**
+ * @file dlm_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding dlm.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef DLM_E_H
+#define DLM_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "config/project.h"
+#include "main_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+#define DLM_TAG "DLM"
+
+/**
+ * @brief How far a slot got on the escalation path, see dlm.c
+ *
+ */
+typedef enum
+{
+  DLM_LEVEL_OK = 0, /* Within its budget */
+  DLM_LEVEL_LOG,    /* Overran its budget, counted and logged */
+  DLM_LEVEL_SKIP,   /* Overran DLM_SKIP_AFTER times in a row, its next period is skipped */
+  DLM_LEVEL_SAFE    /* Overran DLM_SAFE_AFTER times in a row, the supervisor was tripped */
+} dlm_Level_e;
+
+/**
+ * @brief Counters and state of one slot of the main OS
+ *
+ */
+typedef struct
+{
+  uint32_t overruns_u32;      /* Runs that took longer than the budget of the slot */
+  uint32_t misses_u32;        /* Runs that ended after the end of the slot, start delay included */
+  uint32_t skips_u32;         /* Periods skipped because of overruns */
+  uint32_t lastOverrunUs_u32; /* When it overran last, lower 32 bits of esp_timer_get_time() */
+  uint32_t worstUs_u32;       /* Longest run */
+  uint32_t logged_u32;        /* overruns_u32 when the serial debug logged the slot last */
+  uint16_t inARow_u16;        /* Overruns in a row, skipped periods don't count either way */
+  uint8_t skipNext_u8;        /* 1 - the next period is skipped */
+  dlm_Level_e level_e;        /* Highest escalation step of the current overruns in a row */
+} dlm_s_Slot_t;
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Counters and state of every slot
+ *
+ * @values indexed by slot
+ */
+extern dlm_s_Slot_t dlm_g_Slots_s[MAIN_CYCLE_TASK_COUNT];
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void dlm_f_Init_v(void);
+extern uint8_t dlm_f_Skip_u8(uint16_t slot);
+extern void dlm_f_Check_v(uint16_t slot, uint32_t startDelayUs, uint32_t runtimeUs);
+
+#ifdef SERIAL_DEBUG
+extern void dlm_f_SerialDebug_v(void);
+#endif
+
+#endif // DLM_E_H
@@ -0,0 +1,68 @@
+/**
+ * @file dlm_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding dlm.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef DLM_I_H
+#define DLM_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "dlm_e.h"
+
+#include "esp_task_wdt.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Overruns in a row after which the next period of the slot is skipped, and after which the supervisor
+ * puts the servos into the safe posture
+ *
+ * A single overrun (flash cache miss, an interrupt storm) is only counted. Between DLM_SKIP_AFTER and
+ * DLM_SAFE_AFTER every other period of the slot is skipped, so the slots after it get their time back
+ *
+ * @values 1..DLM_SAFE_AFTER, and more than DLM_SKIP_AFTER
+ */
+#define DLM_SKIP_AFTER 3
+#define DLM_SAFE_AFTER 6
+
+/**
+ * @brief Task watchdog timeout of the main OS, for the hangs the supervisor can't end: it holds the safe posture,
+ * the watchdog resets the chip
+ *
+ * The main OS feeds it every main cycle (10ms), much longer than the supervisor heartbeat timeout, so the safe
+ * posture always comes first
+ *
+ * @values in milliseconds
+ */
+#define DLM_WDT_TIMEOUT_MS 1000
+
+/**
+ * @brief Idle tasks the task watchdog keeps watching, as configured (CONFIG_ESP_TASK_WDT_CHECK_IDLE_TASK_CPU0)
+ *
+ * Only core 0: the main OS on core 1 polls the timer without ever blocking, so the idle task of core 1 never runs
+ *
+ * @values bit mask of the cores
+ */
+#ifdef CONFIG_ESP_TASK_WDT_CHECK_IDLE_TASK_CPU0
+#define DLM_WDT_IDLE_CORE_MASK (1 << 0)
+#else
+#define DLM_WDT_IDLE_CORE_MASK 0
+#endif
+
+#endif // DLM_I_H
@@ -0,0 +1,226 @@
+/**
+ * @file err.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Runtime error handling software component
+ *
+ * Driver calls made from the Handle functions don't abort on an error: ESP_ERROR_CHECK would reboot the whole hand
+ * over one ADC conversion that timed out (ADC2 is shared with the radio), which takes seconds. Instead every call goes
+ * through err_f_Retry_u8(), which counts the error for its source and says whether to repeat the call:
+ *
+ *   l_err_s32 = adc_oneshot_read(handle, channel, &l_raw_s32);
+ *   while (err_f_Retry_u8(ERR_SRC_POT, l_err_s32))
+ *   {
+ *     l_err_s32 = adc_oneshot_read(handle, channel, &l_raw_s32);
+ *   }
+ *   if (l_err_s32 != ESP_OK) -> keep the last good value
+ *
+ * A call is repeated at most ERR_RETRY_MAX times, and each source at most ERR_RETRY_BUDGET times per main cycle,
+ * so a driver that keeps failing costs little time. A source that fails ERR_DEGRADE_AFTER times in a row is degraded
+ * (LED01 shows it) until it works ERR_RECOVER_AFTER times in a row. The inputs hold their last good values meanwhile,
+ * but a degraded POT or SNS can't be trusted to say the hand should stay closed, so the servos go to the open posture
+ * until it recovers (srv_f_Handle_v()). The servos skip their heartbeat, so the supervisor (drivers/sup) takes over
+ * if the PWM can't be updated anymore. The counters go out in ERR_STATS every second.
+ * ESP_ERROR_CHECK stays in the Init functions, where a failure means the hardware can't work at all.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "err_e.h"
+#include "err_i.h"
+
+/* Other components used here */
+#include "drivers/trc/trc_e.h"
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Counters and state of every source
+ *
+ * @values indexed by err_Source_e
+ */
+err_s_Source_t err_g_Sources_s[ERR_SRC_COUNT];
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+void err_f_Init_v(void);
+void err_f_Handle_v(void);
+uint8_t err_f_Retry_u8(err_Source_e source, esp_err_t result);
+uint8_t err_f_Degraded_u8(err_Source_e source);
+uint8_t err_f_AnyDegraded_u8(void);
+
+#ifdef TELEMETRY
+uint8_t err_f_Pack_u8(uint8_t *buf);
+#endif
+
+#ifdef SERIAL_DEBUG
+void err_f_SerialDebug_v(void);
+#endif
+
+/**
+ * @brief Init function called once on boot, before every module that reports to it
+ *
+ * @return void
+ */
+void err_f_Init_v(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < ERR_SRC_COUNT; i++)
+  {
+    err_g_Sources_s[i] = (err_s_Source_t){0};
+    err_g_Sources_s[i].budget_u8 = ERR_RETRY_BUDGET;
+    err_g_Sources_s[i].lastError_s32 = ESP_OK;
+  }
+}
+
+/**
+ * @brief Handle function to be called cyclically, once per main cycle
+ *
+ * Refills the retry budget of every source
+ *
+ * @return void
+ */
+void ERR_IRAM_ATTR err_f_Handle_v(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < ERR_SRC_COUNT; i++)
+  {
+    err_g_Sources_s[i].budget_u8 = ERR_RETRY_BUDGET;
+  }
+}
+
+/**
+ * @brief Book the result of a driver call and decide whether to repeat it
+ *
+ * @param source who made the call
+ * @param result what the driver returned
+ * @return 1 to repeat the call, 0 if it succeeded or is given up on (then result tells which)
+ */
+uint8_t ERR_IRAM_ATTR err_f_Retry_u8(err_Source_e source, esp_err_t result)
+{
+  err_s_Source_t *l_src_ps = &err_g_Sources_s[source];
+
+  if (result == ESP_OK)
+  {
+    l_src_ps->attempt_u8 = 0;
+    l_src_ps->inARow_u16 = 0;
+    if (l_src_ps->degraded_u8 && (++l_src_ps->okInARow_u16 >= ERR_RECOVER_AFTER))
+    {
+      l_src_ps->degraded_u8 = 0;
+    }
+    return 0;
+  }
+
+  l_src_ps->errors_u32++;
+  l_src_ps->lastError_s32 = result;
+
+  if ((l_src_ps->attempt_u8 < ERR_RETRY_MAX) && (l_src_ps->budget_u8 > 0))
+  {
+    l_src_ps->attempt_u8++;
+    l_src_ps->budget_u8--;
+    l_src_ps->retries_u32++;
+    return 1;
+  }
+
+  /* Given up, the caller holds its last good value */
+  l_src_ps->attempt_u8 = 0;
+  l_src_ps->failures_u32++;
+  trc_f_Record_v(TRC_EV_MARK, TRC_MARK_DRIVER_FAILURE, (uint16_t)source);
+  l_src_ps->okInARow_u16 = 0;
+  if ((l_src_ps->inARow_u16 < UINT16_MAX) && (++l_src_ps->inARow_u16 >= ERR_DEGRADE_AFTER))
+  {
+    l_src_ps->degraded_u8 = 1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Whether a source failed too often lately to be trusted
+ *
+ * @param source which one
+ * @return 1 if degraded, 0 otherwise
+ */
+uint8_t err_f_Degraded_u8(err_Source_e source)
+{
+  return err_g_Sources_s[source].degraded_u8;
+}
+
+/**
+ * @brief Whether any source is degraded
+ *
+ * @return 1 if any is, 0 otherwise
+ */
+uint8_t err_f_AnyDegraded_u8(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < ERR_SRC_COUNT; i++)
+  {
+    if (err_g_Sources_s[i].degraded_u8)
+    {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+#ifdef TELEMETRY
+/**
+ * @brief Write the counters of every source into a payload
+ *
+ * Payload: ERR_STATS, see firmware/msg/messages.py. Called from the telemetry task on core 0 while the sources
+ * count on core 1, every counter is read in one go but they are not a snapshot of the same moment
+ *
+ * @param buf room for MSG_ERR_STATS_LEN bytes
+ * @return payload length
+ */
+uint8_t err_f_Pack_u8(uint8_t *buf)
+{
+  msg_s_ErrStats_t l_stats_s;
+  uint8_t i;
+
+  l_stats_s.timeUs_u32 = (uint32_t)esp_timer_get_time();
+  l_stats_s.sourcesCount_u8 = ERR_SRC_COUNT;
+  for (i = 0; i < ERR_SRC_COUNT; i++)
+  {
+    l_stats_s.sources_s[i].errors_u32 = err_g_Sources_s[i].errors_u32;
+    l_stats_s.sources_s[i].retries_u32 = err_g_Sources_s[i].retries_u32;
+    l_stats_s.sources_s[i].failures_u32 = err_g_Sources_s[i].failures_u32;
+    l_stats_s.sources_s[i].lastError_s32 = err_g_Sources_s[i].lastError_s32;
+    l_stats_s.sources_s[i].degraded_u8 = err_g_Sources_s[i].degraded_u8;
+  }
+
+  return msg_f_PackErrStats_u8(buf, &l_stats_s);
+}
+#endif
+
+#ifdef SERIAL_DEBUG
+void err_f_SerialDebug_v(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < ERR_SRC_COUNT; i++)
+  {
+    if (err_g_Sources_s[i].errors_u32)
+    {
+      ESP_LOGD(ERR_TAG, "Source #%u errors = %lu, retries = %lu, failures = %lu, degraded = %u, last = %s", i, err_g_Sources_s[i].errors_u32, err_g_Sources_s[i].retries_u32, err_g_Sources_s[i].failures_u32, err_g_Sources_s[i].degraded_u8, esp_err_to_name(err_g_Sources_s[i].lastError_s32));
+    }
+  }
+}
+#endif
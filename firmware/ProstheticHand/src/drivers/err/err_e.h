@@ -0,0 +1,100 @@
+/**
+ * @file err_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding err.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef ERR_E_H
+#define ERR_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "config/project.h"
+#include "drivers/msg/msg_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+#define ERR_TAG "ERR"
+
+/**
+ * @brief Blink code of LED01 while any source is degraded, after the safe state code of the supervisor
+ *
+ * @values 1..LED_CODE_MAX
+ */
+#define ERR_LED_CODE_DEGRADED 5
+
+/**
+ * @brief Driver calls made at runtime, every source keeps its own counters and retry budget
+ *
+ */
+typedef enum
+{
+  ERR_SRC_BAT = 0, /* Battery ADC reads */
+  ERR_SRC_POT,     /* Potentiometer ADC reads */
+  ERR_SRC_SNS,     /* EMG sensor ADC reads */
+  ERR_SRC_SRV,     /* Servo PWM updates */
+  ERR_SRC_LED,     /* Debug LED PWM updates, from the LED timers */
+  ERR_SRC_COUNT
+} err_Source_e;
+
+/**
+ * @brief Counters and state of one source
+ *
+ */
+typedef struct
+{
+  uint32_t errors_u32;      /* Driver calls that returned an error, retries included */
+  uint32_t retries_u32;     /* Driver calls repeated after an error */
+  uint32_t failures_u32;    /* Driver calls that still failed after their retries, the last good value was held */
+  uint16_t inARow_u16;      /* Failures in a row */
+  uint16_t okInARow_u16;    /* Successful calls in a row since the source degraded */
+  uint8_t attempt_u8;       /* Retries of the call going on */
+  uint8_t budget_u8;        /* Retries left in this main cycle */
+  uint8_t degraded_u8;      /* 1 after ERR_DEGRADE_AFTER failures in a row, until ERR_RECOVER_AFTER successes in a row */
+  esp_err_t lastError_s32;  /* Last error returned */
+} err_s_Source_t;
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Counters and state of every source
+ *
+ * @values indexed by err_Source_e
+ */
+extern err_s_Source_t err_g_Sources_s[ERR_SRC_COUNT];
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void err_f_Init_v(void);
+extern void err_f_Handle_v(void);
+extern uint8_t err_f_Retry_u8(err_Source_e source, esp_err_t result);
+extern uint8_t err_f_Degraded_u8(err_Source_e source);
+extern uint8_t err_f_AnyDegraded_u8(void);
+
+#ifdef TELEMETRY
+extern uint8_t err_f_Pack_u8(uint8_t *buf);
+#endif
+
+#ifdef SERIAL_DEBUG
+extern void err_f_SerialDebug_v(void);
+#endif
+
+#endif // ERR_E_H
@@ -0,0 +1,60 @@
+/**
+ * @file err_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding err.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef ERR_I_H
+#define ERR_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "err_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief How often a single driver call is repeated before the caller gives up on it
+ *
+ * @values 0..ERR_RETRY_BUDGET
+ */
+#define ERR_RETRY_MAX 2
+
+/**
+ * @brief Retries a source may spend in one main cycle (10ms), so a driver that keeps failing can't stretch the 1ms slots
+ *
+ * An ADC read takes a few tens of microseconds, so the worst case is well within a slot
+ *
+ * @values 0..255
+ */
+#define ERR_RETRY_BUDGET 4
+
+/**
+ * @brief Failures in a row after which a source counts as degraded, and successes in a row after which it is fine again
+ *
+ * @values in calls, a source is usually called once or a few times per main cycle (10ms)
+ */
+#define ERR_DEGRADE_AFTER 10
+#define ERR_RECOVER_AFTER 100
+
+/**
+ * @brief Every source has its entry in ERR_STATS
+ *
+ */
+_Static_assert(ERR_SRC_COUNT <= MSG_ERR_STATS_SOURCES_MAX, "ERR_STATS has no room for every err_Source_e");
+
+#endif // ERR_I_H
@@ -0,0 +1,413 @@
+/**
+ * @file ldt.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Scheduler load test software component
+ *
+ * Injects calibrated synthetic work into the 1ms task slots of the main OS and sweeps
+ * it upwards, one slot at a time, until the slot misses its deadline. While doing that
+ * it keeps track of how much headroom each slot has, how an overrun propagates into the
+ * following slots and the main cycle, and how much the start of each slot jitters.
+ *
+ * Only compiled in when LOAD_TEST is defined (see defines.h), never leave it on in a
+ * build that drives a real hand, as the servo outputs get delayed on purpose.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "ldt_e.h"
+#include "ldt_i.h"
+
+#ifdef LOAD_TEST
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Current state of the load test
+ *
+ * @values see ldt_State_e
+ */
+ldt_State_e ldt_g_State_e = LDT_STATE_SETTLE;
+
+/**
+ * @brief Load test report for each of the scheduler slots
+ *
+ * @values see ldt_g_SlotReportTyp_t
+ */
+ldt_g_SlotReportTyp_t ldt_g_SlotReport_s[MAIN_CYCLE_TASK_COUNT];
+
+/**
+ * @brief Synthetic work loop iterations that take one microsecond, measured at init
+ *
+ * @values > 0
+ */
+float32_t ldt_g_LoopsPerUs_f32 = 1;
+
+/**
+ * @brief Slot into which the work is currently injected
+ *
+ * @values 0..MAIN_CYCLE_TASK_COUNT - 1
+ */
+uint16_t ldt_g_TargetSlot_u16 = 0;
+
+/**
+ * @brief Amount of synthetic work currently injected into the target slot
+ *
+ * @values 0..main_c_CycleTaskLengthUs_u16 * 2 (microseconds)
+ */
+uint32_t ldt_g_InjectedUs_u32 = 0;
+
+/**
+ * @brief Main cycles counted in the current state/step
+ *
+ */
+uint32_t ldt_g_CycleCnt_u32 = 0;
+
+/**
+ * @brief Start time of the previous main cycle (slot 0), for the cycle stretch
+ *
+ */
+uint64_t ldt_g_CycleStartUs_u64 = 0;
+
+/**
+ * @brief Ideal start of the slot that ran last, on a schedule of one slot length per slot anchored at the start
+ * of the cycle (slot 0) and at every slot that starts on time
+ *
+ * The main OS times every slot from the actual start of the one before it, so after an overrun all following
+ * slots start late by the same amount, while their start delays only show it for the first of them
+ */
+uint64_t ldt_g_IdealStartUs_u64 = 0;
+
+/**
+ * @brief Whether the target slot has overrun at the current load level
+ *
+ */
+uint8_t ldt_g_Missed_u8 = 0;
+
+/**
+ * @brief Whether the previous slot overran, so the next start delay is not plain jitter
+ *
+ */
+uint8_t ldt_g_PrevSlotLate_u8 = 1;
+
+/**
+ * @brief Consecutive late slots seen since the target slot last overran
+ *
+ */
+uint16_t ldt_g_LateRun_u16 = 0;
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+void ldt_f_Init_v(void);
+void ldt_f_InjectLoad_v(uint16_t slotIndex);
+void ldt_f_Handle_v(uint16_t slotIndex, uint64_t startUs, uint32_t startDelayUs, uint32_t runtimeUs);
+
+void ldt_f_Calibrate_v(void);
+void ldt_f_SyntheticWork_v(uint32_t loops);
+void ldt_f_NextSlot_v(void);
+
+#ifdef SERIAL_DEBUG
+void ldt_f_SerialDebug_v(void);
+#endif
+
+/**
+ * @brief Initialize function to be called once on startup/boot
+ *
+ * Clear the report and calibrate the synthetic work loop against the microsecond timer
+ *
+ * @return void
+ */
+void ldt_f_Init_v(void)
+{
+  uint16_t i;
+
+  for (i = 0; i < MAIN_CYCLE_TASK_COUNT; i++)
+  {
+    ldt_g_SlotReport_s[i].baseMaxRuntime_u32 = 0;
+    ldt_g_SlotReport_s[i].headroom_u32 = 0;
+    ldt_g_SlotReport_s[i].missLoad_u32 = 0;
+    ldt_g_SlotReport_s[i].lateSlots_u16 = 0;
+    ldt_g_SlotReport_s[i].maxPropagatedDelay_u32 = 0;
+    ldt_g_SlotReport_s[i].maxCycleStretch_u32 = 0;
+    ldt_g_SlotReport_s[i].minJitter_u32 = UINT32_MAX;
+    ldt_g_SlotReport_s[i].maxJitter_u32 = 0;
+    ldt_g_SlotReport_s[i].sumJitter_u64 = 0;
+    ldt_g_SlotReport_s[i].jitterCnt_u32 = 0;
+  }
+
+  ldt_f_Calibrate_v();
+
+  ldt_g_State_e = LDT_STATE_SETTLE;
+  ldt_g_CycleCnt_u32 = 0;
+
+  ESP_LOGI(LDT_TAG, "Load test enabled, %f loops/us", ldt_g_LoopsPerUs_f32);
+}
+
+/**
+ * @brief Burn the synthetic work meant for this slot, if it is the one being swept
+ *
+ * Called by the main OS at the end of each slot, inside the runtime measurement
+ *
+ * @param slotIndex index of the slot that is running
+ * @return void
+ */
+void ldt_f_InjectLoad_v(uint16_t slotIndex)
+{
+  if ((ldt_g_State_e == LDT_STATE_SWEEP) && (slotIndex == ldt_g_TargetSlot_u16) && (ldt_g_InjectedUs_u32 > 0))
+  {
+    ldt_f_SyntheticWork_v((uint32_t)((float32_t)ldt_g_InjectedUs_u32 * ldt_g_LoopsPerUs_f32));
+  }
+}
+
+/**
+ * @brief Handle function to be called after each slot
+ *
+ * Update the statistics with the finished slot and step the sweep
+ *
+ * @param slotIndex index of the slot that just finished
+ * @param startUs when the slot started
+ * @param startDelayUs how late the slot started compared to one slot length after the start of the previous one
+ * @param runtimeUs how long the slot took (including injected work)
+ * @return void
+ */
+void ldt_f_Handle_v(uint16_t slotIndex, uint64_t startUs, uint32_t startDelayUs, uint32_t runtimeUs)
+{
+  ldt_g_SlotReportTyp_t *l_report_s = &ldt_g_SlotReport_s[slotIndex];
+  uint64_t l_idealStartUs_u64 = ldt_g_IdealStartUs_u64 + main_c_CycleTaskLengthUs_u16;
+  uint32_t l_scheduleDelayUs_u32;
+  uint32_t l_cycleLengthUs_u32;
+
+  /* How late the slot started against the ideal schedule, everything the slots before it overran added up */
+  l_scheduleDelayUs_u32 = (startUs > l_idealStartUs_u64) ? (uint32_t)(startUs - l_idealStartUs_u64) : 0;
+
+  /* A new cycle starts a new schedule, after its delay was counted, and so does a slot on time,
+     so the few microseconds every slot starts late by don't add up */
+  if ((slotIndex == 0) || (l_scheduleDelayUs_u32 <= LDT_LATE_THRESHOLD_US))
+  {
+    l_idealStartUs_u64 = startUs;
+  }
+  ldt_g_IdealStartUs_u64 = l_idealStartUs_u64;
+
+  /* Start jitter only counts when nothing before this slot overran */
+  if (ldt_g_PrevSlotLate_u8 == 0)
+  {
+    if (startDelayUs < l_report_s->minJitter_u32)
+    {
+      l_report_s->minJitter_u32 = startDelayUs;
+    }
+    if (startDelayUs > l_report_s->maxJitter_u32)
+    {
+      l_report_s->maxJitter_u32 = startDelayUs;
+    }
+    l_report_s->sumJitter_u64 += startDelayUs;
+    l_report_s->jitterCnt_u32++;
+  }
+  ldt_g_PrevSlotLate_u8 = runtimeUs > main_c_CycleTaskLengthUs_u16;
+
+  /* Runtime of the real modules, without anything injected into them */
+  if ((ldt_g_State_e != LDT_STATE_SWEEP) || (slotIndex != ldt_g_TargetSlot_u16))
+  {
+    if (runtimeUs > l_report_s->baseMaxRuntime_u32)
+    {
+      l_report_s->baseMaxRuntime_u32 = runtimeUs;
+    }
+  }
+
+  /* Deadline miss of the target slot, and how it propagates to the next slots */
+  if (ldt_g_State_e == LDT_STATE_SWEEP)
+  {
+    l_report_s = &ldt_g_SlotReport_s[ldt_g_TargetSlot_u16];
+
+    if (slotIndex == ldt_g_TargetSlot_u16)
+    {
+      ldt_g_LateRun_u16 = 0;
+
+      if ((runtimeUs > main_c_CycleTaskLengthUs_u16) && (ldt_g_Missed_u8 == 0))
+      {
+        ldt_g_Missed_u8 = 1;
+        l_report_s->missLoad_u32 = ldt_g_InjectedUs_u32;
+        l_report_s->headroom_u32 = (ldt_g_InjectedUs_u32 >= LDT_LOAD_STEP_US) ? (ldt_g_InjectedUs_u32 - LDT_LOAD_STEP_US) : 0;
+      }
+    }
+    else if ((ldt_g_Missed_u8 == 1) && (l_scheduleDelayUs_u32 > LDT_LATE_THRESHOLD_US) &&
+             (ldt_g_LateRun_u16 == (slotIndex + MAIN_CYCLE_TASK_COUNT - ldt_g_TargetSlot_u16 - 1) % MAIN_CYCLE_TASK_COUNT))
+    {
+      /* Only count slots late one after the other, right after the target slot, also past the end of the cycle */
+      ldt_g_LateRun_u16++;
+      if (ldt_g_LateRun_u16 > l_report_s->lateSlots_u16)
+      {
+        l_report_s->lateSlots_u16 = ldt_g_LateRun_u16;
+      }
+      if (l_scheduleDelayUs_u32 > l_report_s->maxPropagatedDelay_u32)
+      {
+        l_report_s->maxPropagatedDelay_u32 = l_scheduleDelayUs_u32;
+      }
+    }
+  }
+
+  /* Once per main cycle: measure how long the whole cycle took */
+  if (slotIndex == 0)
+  {
+    l_cycleLengthUs_u32 = (uint32_t)(startUs - ldt_g_CycleStartUs_u64);
+    ldt_g_CycleStartUs_u64 = startUs;
+
+    if ((ldt_g_State_e == LDT_STATE_SWEEP) && (ldt_g_Missed_u8 == 1) && (ldt_g_CycleCnt_u32 > 0) &&
+        (l_cycleLengthUs_u32 > MAIN_CYCLE_LENGTH_MS * MILLISEC_TO_MICROSEC) &&
+        (l_cycleLengthUs_u32 - MAIN_CYCLE_LENGTH_MS * MILLISEC_TO_MICROSEC > l_report_s->maxCycleStretch_u32))
+    {
+      l_report_s->maxCycleStretch_u32 = l_cycleLengthUs_u32 - MAIN_CYCLE_LENGTH_MS * MILLISEC_TO_MICROSEC;
+    }
+  }
+
+  /* Step the sweep at the end of each main cycle */
+  if (slotIndex == MAIN_CYCLE_TASK_COUNT - 1)
+  {
+    ldt_g_CycleCnt_u32++;
+
+    switch (ldt_g_State_e)
+    {
+    case LDT_STATE_SETTLE:
+      if (ldt_g_CycleCnt_u32 >= LDT_SETTLE_CYCLES)
+      {
+        ldt_g_State_e = LDT_STATE_SWEEP;
+        ldt_g_TargetSlot_u16 = 0;
+        ldt_g_InjectedUs_u32 = 0;
+        ldt_g_Missed_u8 = 0;
+        ldt_g_CycleCnt_u32 = 0;
+      }
+      break;
+    case LDT_STATE_SWEEP:
+      if (ldt_g_CycleCnt_u32 >= LDT_CYCLES_PER_STEP)
+      {
+        /* Keep the overrunning level for one full step so the propagation is seen, then move on */
+        if ((ldt_g_Missed_u8 == 1) || (ldt_g_InjectedUs_u32 >= 2 * main_c_CycleTaskLengthUs_u16))
+        {
+          ldt_f_NextSlot_v();
+        }
+        else
+        {
+          ldt_g_InjectedUs_u32 += LDT_LOAD_STEP_US;
+          ldt_g_CycleCnt_u32 = 0;
+        }
+      }
+      break;
+    case LDT_STATE_DONE:
+    default:
+      break;
+    }
+  }
+}
+
+/**
+ * @brief Measure how many synthetic work loop iterations fit into one microsecond
+ *
+ * Takes the fastest of a few runs, so an interrupt hitting one of them doesn't skew it
+ *
+ * @return void
+ */
+void ldt_f_Calibrate_v(void)
+{
+  uint8_t i;
+  uint64_t l_startUs_u64;
+  uint32_t l_durationUs_u32;
+  uint32_t l_fastestUs_u32 = UINT32_MAX;
+
+  for (i = 0; i < 3; i++)
+  {
+    l_startUs_u64 = esp_timer_get_time();
+    ldt_f_SyntheticWork_v(LDT_CALIBRATION_LOOPS);
+    l_durationUs_u32 = (uint32_t)(esp_timer_get_time() - l_startUs_u64);
+
+    if (l_durationUs_u32 < l_fastestUs_u32)
+    {
+      l_fastestUs_u32 = l_durationUs_u32;
+    }
+  }
+
+  if (l_fastestUs_u32 > 0)
+  {
+    ldt_g_LoopsPerUs_f32 = (float32_t)LDT_CALIBRATION_LOOPS / (float32_t)l_fastestUs_u32;
+  }
+}
+
+/**
+ * @brief Busy loop doing some integer arithmetic, stands in for the real module code
+ *
+ * @param loops how many iterations to run
+ * @return void
+ */
+void ldt_f_SyntheticWork_v(uint32_t loops)
+{
+  volatile uint32_t l_acc_u32 = 0;
+  uint32_t i;
+
+  for (i = 0; i < loops; i++)
+  {
+    l_acc_u32 += i ^ (l_acc_u32 >> 3);
+  }
+}
+
+/**
+ * @brief Done with the current target slot, move the sweep to the next one
+ *
+ * @return void
+ */
+void ldt_f_NextSlot_v(void)
+{
+  ldt_g_TargetSlot_u16++;
+  ldt_g_InjectedUs_u32 = 0;
+  ldt_g_Missed_u8 = 0;
+  ldt_g_LateRun_u16 = 0;
+  ldt_g_CycleCnt_u32 = 0;
+
+  if (ldt_g_TargetSlot_u16 >= MAIN_CYCLE_TASK_COUNT)
+  {
+    ldt_g_TargetSlot_u16 = 0;
+    ldt_g_State_e = LDT_STATE_DONE;
+  }
+}
+
+#ifdef SERIAL_DEBUG
+void ldt_f_SerialDebug_v(void)
+{
+  uint16_t i;
+  ldt_g_SlotReportTyp_t *l_report_s;
+
+  ESP_LOGD(LDT_TAG, " > load test (%s), slot %u, injecting %lu us, %f loops/us:",
+           (ldt_g_State_e == LDT_STATE_SETTLE) ? "settling" : ((ldt_g_State_e == LDT_STATE_SWEEP) ? "sweeping" : "done"),
+           ldt_g_TargetSlot_u16, ldt_g_InjectedUs_u32, ldt_g_LoopsPerUs_f32);
+
+  for (i = 0; i < MAIN_CYCLE_TASK_COUNT; i++)
+  {
+    l_report_s = &ldt_g_SlotReport_s[i];
+
+    ESP_LOGD(LDT_TAG, "    [%u] \tbase max: %lu, \theadroom: %lu, \tmiss at: %lu, \tlate slots: %u, \tmax delay: %lu, \tcycle stretch: %lu, \tjitter min/avg/max: %lu/%lu/%lu",
+             i,
+             l_report_s->baseMaxRuntime_u32,
+             l_report_s->headroom_u32,
+             l_report_s->missLoad_u32,
+             l_report_s->lateSlots_u16,
+             l_report_s->maxPropagatedDelay_u32,
+             l_report_s->maxCycleStretch_u32,
+             (l_report_s->jitterCnt_u32 > 0) ? l_report_s->minJitter_u32 : 0,
+             (l_report_s->jitterCnt_u32 > 0) ? (uint32_t)(l_report_s->sumJitter_u64 / l_report_s->jitterCnt_u32) : 0,
+             l_report_s->maxJitter_u32);
+  }
+}
+#endif
+
+#endif // LOAD_TEST
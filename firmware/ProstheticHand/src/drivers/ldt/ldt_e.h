@@ -0,0 +1,109 @@
+/**
+ * @file ldt_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding ldt.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef LDT_E_H
+#define LDT_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "config/project.h"
+#include "main_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+#define LDT_TAG "LDT"
+
+/**
+ * @brief States of the load test sweep
+ *
+ */
+typedef enum
+{
+  LDT_STATE_SETTLE = 0, /* Waiting for the scheduler to settle after boot, nothing injected */
+  LDT_STATE_SWEEP,      /* Injecting synthetic work into the current target slot */
+  LDT_STATE_DONE        /* All slots swept, report is final */
+} ldt_State_e;
+
+/**************************************************************************
+ * Structures
+ **************************************************************************/
+
+/**
+ * @brief Load test results of one 1ms scheduler slot
+ *
+ */
+typedef struct
+{
+  /* Longest slot runtime seen before anything was injected into this slot (us) */
+  uint32_t baseMaxRuntime_u32;
+
+  /* Largest injected load at which the slot still met its deadline (us) */
+  uint32_t headroom_u32;
+
+  /* Injected load at which the slot first missed its deadline (us), 0 if it never did */
+  uint32_t missLoad_u32;
+
+  /* How many following slots started late after the first miss */
+  uint16_t lateSlots_u16;
+
+  /* Largest start delay of a following slot after the first miss, against the schedule of the cycle (us) */
+  uint32_t maxPropagatedDelay_u32;
+
+  /* Largest stretch of the 10ms main cycle while this slot was overrunning (us) */
+  uint32_t maxCycleStretch_u32;
+
+  /* Start delay of this slot relative to its ideal start, while nothing overruns (us) */
+  uint32_t minJitter_u32;
+  uint32_t maxJitter_u32;
+  uint64_t sumJitter_u64;
+  uint32_t jitterCnt_u32;
+} ldt_g_SlotReportTyp_t;
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Current state of the load test
+ *
+ * @values see ldt_State_e
+ */
+extern ldt_State_e ldt_g_State_e;
+
+/**
+ * @brief Load test report for each of the scheduler slots
+ *
+ * @values see ldt_g_SlotReportTyp_t
+ */
+extern ldt_g_SlotReportTyp_t ldt_g_SlotReport_s[MAIN_CYCLE_TASK_COUNT];
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void ldt_f_Init_v(void);
+extern void ldt_f_InjectLoad_v(uint16_t slotIndex);
+extern void ldt_f_Handle_v(uint16_t slotIndex, uint64_t startUs, uint32_t startDelayUs, uint32_t runtimeUs);
+
+#ifdef SERIAL_DEBUG
+extern void ldt_f_SerialDebug_v(void);
+#endif
+
+#endif // LDT_E_H
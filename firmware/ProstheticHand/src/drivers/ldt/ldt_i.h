@@ -0,0 +1,135 @@
+/**
+ * @file ldt_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding ldt.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef LDT_I_H
+#define LDT_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "ldt_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief How many main cycles to wait after boot before sweeping,
+ * so the min/max runtimes of the real modules are known first
+ *
+ * @values 1..UINT32_MAX (main cycles, 100 = 1s)
+ */
+#define LDT_SETTLE_CYCLES 300
+
+/**
+ * @brief How many main cycles to run at each load level before increasing it
+ *
+ * @values 1..UINT32_MAX (main cycles, 50 = 0.5s)
+ */
+#define LDT_CYCLES_PER_STEP 50
+
+/**
+ * @brief By how much to increase the injected work at each step
+ *
+ * @values 1..main_c_CycleTaskLengthUs_u16 (microseconds)
+ */
+#define LDT_LOAD_STEP_US 20
+
+/**
+ * @brief Start delay above which a slot is considered to have started late
+ *
+ * A slot always starts a couple of microseconds after its ideal time, as the main loop
+ * has to spin around to notice it, so this filters out that normal scheduling noise
+ *
+ * @values recommended 10..100 (microseconds)
+ */
+#define LDT_LATE_THRESHOLD_US 50
+
+/**
+ * @brief How many iterations of the synthetic work loop to time during calibration
+ *
+ * @values recommended 100000+ (more is more precise, but delays the boot)
+ */
+#define LDT_CALIBRATION_LOOPS 200000
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Synthetic work loop iterations that take one microsecond, measured at init
+ *
+ * @values > 0
+ */
+extern float32_t ldt_g_LoopsPerUs_f32;
+
+/**
+ * @brief Slot into which the work is currently injected
+ *
+ * @values 0..MAIN_CYCLE_TASK_COUNT - 1
+ */
+extern uint16_t ldt_g_TargetSlot_u16;
+
+/**
+ * @brief Amount of synthetic work currently injected into the target slot
+ *
+ * @values 0..main_c_CycleTaskLengthUs_u16 * 2 (microseconds)
+ */
+extern uint32_t ldt_g_InjectedUs_u32;
+
+/**
+ * @brief Main cycles counted in the current state/step
+ *
+ */
+extern uint32_t ldt_g_CycleCnt_u32;
+
+/**
+ * @brief Start time of the previous main cycle (slot 0), for the cycle stretch
+ *
+ */
+extern uint64_t ldt_g_CycleStartUs_u64;
+
+/**
+ * @brief Ideal start of the slot that ran last, on a schedule of one slot length per slot anchored at the start
+ * of the cycle (slot 0) and at every slot that starts on time
+ *
+ * The main OS times every slot from the actual start of the one before it, so after an overrun all following
+ * slots start late by the same amount, while their start delays only show it for the first of them
+ */
+extern uint64_t ldt_g_IdealStartUs_u64;
+
+/**
+ * @brief Whether the target slot has overrun at the current load level
+ *
+ */
+extern uint8_t ldt_g_Missed_u8;
+
+/**
+ * @brief Whether the previous slot overran, so the next start delay is not plain jitter
+ *
+ */
+extern uint8_t ldt_g_PrevSlotLate_u8;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void ldt_f_Calibrate_v(void);
+extern void ldt_f_SyntheticWork_v(uint32_t loops);
+extern void ldt_f_NextSlot_v(void);
+
+#endif // LDT_I_H
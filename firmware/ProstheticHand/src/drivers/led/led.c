@@ -0,0 +1,303 @@
+/**
+ * @file led.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Debug LED status pattern driver
+ *
+ * The main OS only requests a pattern for an LED with led_f_SetPattern_v(), which does nothing more than
+ * compare and store the request as long as the pattern stays the same.
+ * The patterns are played by one esp_timer per LED, which fires only when the pattern moves on to its next step,
+ * and the LEDs are driven by the LEDC peripheral, so they can be dimmed and fade in hardware.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "led_e.h"
+#include "led_i.h"
+
+/* Other components used here */
+#include "drivers/err/err_e.h"
+#include "drivers/trc/trc_e.h"
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Pattern requested for every LED, pattern in the high byte and its argument in the low byte
+ *
+ * @values indexed by led_Id_e
+ */
+volatile uint16_t led_g_Request_u16[LED_ID_COUNT];
+
+/**
+ * @brief What every LED is playing right now
+ *
+ */
+led_s_LedState_t led_g_State_s[LED_ID_COUNT];
+
+/**
+ * @brief One shot timer of every LED, fires at the next step of its pattern
+ *
+ */
+esp_timer_handle_t led_g_Timer_s[LED_ID_COUNT];
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+void led_f_Init_v(void);
+void led_f_SetPattern_v(led_Id_e led, led_Pattern_e pattern, uint8_t arg);
+
+void led_f_Step_v(void *arg);
+uint16_t led_f_NextStep_u16(led_s_LedState_t *state);
+esp_err_t led_f_Show_s32(ledc_channel_t chn, const led_s_LedState_t *state, uint16_t waitMs);
+
+/**
+ * @brief Init function called once on boot
+ *
+ * Set the timer and channel configuration for the LED PWM, and create the pattern timers. All LEDs start off
+ *
+ * @return void
+ */
+void led_f_Init_v(void)
+{
+  uint8_t i;
+
+  ledc_timer_config_t ledPWM_TimerConfig = {
+      .speed_mode = LEDC_LOW_SPEED_MODE,
+      .duty_resolution = LED_PWM_RESOLUTION,
+      .timer_num = LED_PWM_TIMER,
+      .freq_hz = LED_PWM_FREQUENCY,
+      .clk_cfg = LEDC_AUTO_CLK};
+  ESP_ERROR_CHECK(ledc_timer_config(&ledPWM_TimerConfig));
+
+  /* Hardware fades (breathing) */
+  ESP_ERROR_CHECK(ledc_fade_func_install(0));
+
+  for (i = 0; i < LED_ID_COUNT; i++)
+  {
+    ledc_channel_config_t ledPWM_ChannelConfig = {
+        .gpio_num = led_s_LedConfig_s[i].pin_u16,
+        .speed_mode = LEDC_LOW_SPEED_MODE,
+        .channel = led_s_LedConfig_s[i].chn_s,
+        .intr_type = LEDC_INTR_DISABLE,
+        .timer_sel = LED_PWM_TIMER,
+        .duty = 0,
+        .hpoint = 0,
+        .flags = {.output_invert = 0}};
+    ESP_ERROR_CHECK(ledc_channel_config(&ledPWM_ChannelConfig));
+
+    esp_timer_create_args_t ledStep_TimerArgs = {
+        .callback = led_f_Step_v,
+        .arg = (void *)(uintptr_t)i,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "led_f_Step_v",
+        .skip_unhandled_events = true};
+    ESP_ERROR_CHECK(esp_timer_create(&ledStep_TimerArgs, &led_g_Timer_s[i]));
+
+    led_g_Request_u16[i] = (uint16_t)LED_PATTERN_OFF << 8;
+    led_g_State_s[i].request_u16 = led_g_Request_u16[i];
+  }
+}
+
+/**
+ * @brief Request a pattern for an LED
+ *
+ * Cheap enough to call every cycle with the same pattern, the LED only starts over
+ * (with its first step right away) when the pattern or its argument change
+ *
+ * @param led - which LED
+ * @param pattern - pattern to play
+ * @param arg - argument of the pattern (see led_Pattern_e), ignored by patterns without one
+ *
+ * @return void
+ */
+void led_f_SetPattern_v(led_Id_e led, led_Pattern_e pattern, uint8_t arg)
+{
+  uint16_t l_request_u16;
+
+  if (pattern == LED_PATTERN_CODE)
+  {
+    arg = (arg < 1) ? 1 : ((arg > LED_CODE_MAX) ? LED_CODE_MAX : arg);
+  }
+  else if (pattern == LED_PATTERN_LEVEL)
+  {
+    arg = (arg > 100) ? 100 : arg;
+  }
+  else
+  {
+    arg = 0;
+  }
+
+  l_request_u16 = ((uint16_t)pattern << 8) | arg;
+  if (l_request_u16 == led_g_Request_u16[led])
+  {
+    return;
+  }
+
+  led_g_Request_u16[led] = l_request_u16;
+
+  /* Either call can find the timer in the other state, which is fine, so their result is not checked */
+  esp_timer_stop(led_g_Timer_s[led]);
+  esp_timer_start_once(led_g_Timer_s[led], 0);
+}
+
+/**
+ * @brief Timer callback, plays the next step of an LED's pattern and sets the timer for the one after
+ *
+ * @param arg - which LED (led_Id_e)
+ *
+ * @return void
+ */
+void led_f_Step_v(void *arg)
+{
+  led_Id_e l_led_e = (led_Id_e)(uintptr_t)arg;
+  led_s_LedState_t *l_state_ps = &led_g_State_s[l_led_e];
+  ledc_channel_t l_chn_s = led_s_LedConfig_s[l_led_e].chn_s;
+  uint16_t l_request_u16 = led_g_Request_u16[l_led_e];
+  uint16_t l_wait_u16;
+  esp_err_t l_err_s32;
+
+  trc_f_Record_v(TRC_EV_ISR_ENTER, TRC_ISR_LED, l_led_e);
+
+  /* A new request starts from its first step, cutting short what the LED was doing */
+  if (l_request_u16 != l_state_ps->request_u16)
+  {
+    if (l_state_ps->fade_u8)
+    {
+      ledc_fade_stop(LEDC_LOW_SPEED_MODE, l_chn_s);
+    }
+    l_state_ps->request_u16 = l_request_u16;
+    l_state_ps->step_u16 = 0;
+  }
+
+  l_wait_u16 = led_f_NextStep_u16(l_state_ps);
+
+  /* A step that can't be shown is skipped, the LED catches up with the next one */
+  l_err_s32 = led_f_Show_s32(l_chn_s, l_state_ps, l_wait_u16);
+  while (err_f_Retry_u8(ERR_SRC_LED, l_err_s32))
+  {
+    l_err_s32 = led_f_Show_s32(l_chn_s, l_state_ps, l_wait_u16);
+  }
+
+  if (l_wait_u16 != LED_HOLD_MS)
+  {
+    /* Fails only if a new request restarted the timer in the meantime, which then plays its first step */
+    esp_timer_start_once(led_g_Timer_s[l_led_e], (uint64_t)l_wait_u16 * MILLISEC_TO_MICROSEC);
+  }
+
+  trc_f_Record_v(TRC_EV_ISR_EXIT, TRC_ISR_LED, l_led_e);
+}
+
+/**
+ * @brief Put the level of the current step onto an LED, faded or right away
+ *
+ * @param chn - LEDC channel of the LED
+ * @param state - LED state with the level and fade flag of the step
+ * @param waitMs - how long the step lasts
+ *
+ * @return ESP_OK or the error of the LEDC driver
+ */
+esp_err_t led_f_Show_s32(ledc_channel_t chn, const led_s_LedState_t *state, uint16_t waitMs)
+{
+  esp_err_t l_err_s32;
+
+  if (state->fade_u8)
+  {
+    l_err_s32 = ledc_set_fade_with_time(LEDC_LOW_SPEED_MODE, chn, state->level_u16, waitMs - LED_FADE_MARGIN_MS);
+    if (l_err_s32 == ESP_OK)
+    {
+      l_err_s32 = ledc_fade_start(LEDC_LOW_SPEED_MODE, chn, LEDC_FADE_NO_WAIT);
+    }
+  }
+  else
+  {
+    l_err_s32 = ledc_set_duty(LEDC_LOW_SPEED_MODE, chn, state->level_u16);
+    if (l_err_s32 == ESP_OK)
+    {
+      l_err_s32 = ledc_update_duty(LEDC_LOW_SPEED_MODE, chn);
+    }
+  }
+  return l_err_s32;
+}
+
+/**
+ * @brief Work out the next step of the pattern an LED plays
+ *
+ * @param state - LED state, its level, fade flag and step are updated
+ *
+ * @return uint16_t - how long the step lasts in milliseconds, LED_HOLD_MS if it lasts until the next request
+ */
+uint16_t led_f_NextStep_u16(led_s_LedState_t *state)
+{
+  led_Pattern_e l_pattern_e = (led_Pattern_e)(state->request_u16 >> 8);
+  uint8_t l_arg_u8 = (uint8_t)state->request_u16;
+  uint16_t l_step_u16 = state->step_u16;
+  uint32_t l_ramp_u32;
+  uint16_t l_wait_u16;
+
+  state->fade_u8 = 0;
+
+  switch (l_pattern_e)
+  {
+  case LED_PATTERN_ON:
+    state->level_u16 = LED_LEVEL_MAX;
+    l_wait_u16 = LED_HOLD_MS;
+    break;
+
+  case LED_PATTERN_BLINK_SLOW:
+  case LED_PATTERN_BLINK_FAST:
+    state->level_u16 = (l_step_u16 == 0) ? LED_LEVEL_MAX : 0;
+    state->step_u16 = (l_step_u16 + 1) % 2;
+    l_wait_u16 = (l_pattern_e == LED_PATTERN_BLINK_SLOW) ? LED_BLINK_SLOW_MS : LED_BLINK_FAST_MS;
+    break;
+
+  case LED_PATTERN_BREATHE:
+    /* Each step fades to the next point of a squared triangle, as the eye is far more sensitive to changes in the dark */
+    l_ramp_u32 = (l_step_u16 < LED_BREATHE_STEPS) ? (l_step_u16 + 1) : ((2 * LED_BREATHE_STEPS) - 1 - l_step_u16);
+    state->level_u16 = (uint16_t)((l_ramp_u32 * l_ramp_u32 * LED_LEVEL_MAX) / (LED_BREATHE_STEPS * LED_BREATHE_STEPS));
+    state->step_u16 = (l_step_u16 + 1) % (2 * LED_BREATHE_STEPS);
+    state->fade_u8 = 1;
+    l_wait_u16 = LED_RAMP_MS;
+    break;
+
+  case LED_PATTERN_CODE:
+    /* Even steps are the flashes, the odd step after the last flash is the pause */
+    if ((l_step_u16 % 2) == 0)
+    {
+      state->level_u16 = LED_LEVEL_MAX;
+      l_wait_u16 = LED_CODE_ON_MS;
+    }
+    else
+    {
+      state->level_u16 = 0;
+      l_wait_u16 = (l_step_u16 == ((2 * l_arg_u8) - 1)) ? LED_CODE_PAUSE_MS : LED_CODE_OFF_MS;
+    }
+    state->step_u16 = (l_step_u16 + 1) % (2 * l_arg_u8);
+    break;
+
+  case LED_PATTERN_LEVEL:
+    state->level_u16 = (uint16_t)(((uint32_t)l_arg_u8 * LED_LEVEL_MAX) / 100);
+    l_wait_u16 = LED_HOLD_MS;
+    break;
+
+  case LED_PATTERN_OFF:
+  default:
+    state->level_u16 = 0;
+    l_wait_u16 = LED_HOLD_MS;
+    break;
+  }
+
+  return l_wait_u16;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file led_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding led.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef LED_E_H
+#define LED_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "config/project.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+#define LED_TAG "LED"
+
+/**
+ * @brief Debug LEDs on the board
+ *
+ */
+typedef enum
+{
+  LED_ID_01 = 0, /* Board state: running, homing, battery */
+  LED_ID_02,     /* Mode (hardware revision) specific */
+  LED_ID_COUNT
+} led_Id_e;
+
+/**
+ * @brief Patterns an LED can play, the argument given with the pattern is in brackets
+ *
+ */
+typedef enum
+{
+  LED_PATTERN_OFF = 0,
+  LED_PATTERN_ON,
+  LED_PATTERN_BLINK_SLOW,
+  LED_PATTERN_BLINK_FAST,
+  LED_PATTERN_BREATHE, /* Fades in and out */
+  LED_PATTERN_CODE,    /* (number of flashes, 1..LED_CODE_MAX) flashes, then a pause */
+  LED_PATTERN_LEVEL,   /* (brightness, 0..100 percent) steady */
+  LED_PATTERN_COUNT
+} led_Pattern_e;
+
+/**
+ * @brief Most flashes a blink code can have, so it can still be counted by eye
+ *
+ */
+#define LED_CODE_MAX 9
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Pattern requested for every LED, pattern in the high byte and its argument in the low byte
+ *
+ * Written in one go, so the LED timer always sees a whole request
+ *
+ * @values indexed by led_Id_e
+ */
+extern volatile uint16_t led_g_Request_u16[LED_ID_COUNT];
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void led_f_Init_v(void);
+extern void led_f_SetPattern_v(led_Id_e led, led_Pattern_e pattern, uint8_t arg);
+
+#endif // LED_E_H
@@ -0,0 +1,150 @@
+/**
+ * @file led_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding led.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef LED_I_H
+#define LED_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "led_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief PWM timer of the LEDs and its settings
+ *
+ * The servos use LEDC_TIMER_0 at 50Hz, which would make the LEDs flicker, so the LEDs get their own timer
+ */
+#define LED_PWM_TIMER LEDC_TIMER_1
+#define LED_PWM_RESOLUTION LEDC_TIMER_10_BIT
+#define LED_PWM_FREQUENCY 1000
+
+/**
+ * @brief Full brightness, as a duty cycle
+ *
+ */
+#define LED_LEVEL_MAX ((1 << LED_PWM_RESOLUTION) - 1)
+
+/**
+ * @brief Half period of the slow and the fast blink
+ *
+ * @values in milliseconds
+ */
+#define LED_BLINK_SLOW_MS 500
+#define LED_BLINK_FAST_MS 100
+
+/**
+ * @brief Blink code timing: each flash, the gap between flashes and the pause after the last one
+ *
+ * @values in milliseconds
+ */
+#define LED_CODE_ON_MS 150
+#define LED_CODE_OFF_MS 300
+#define LED_CODE_PAUSE_MS 1500
+
+/**
+ * @brief Breathing: the LEDC hardware fades linearly, so every fade in (and out) is made of LED_BREATHE_STEPS
+ * linear fades of LED_RAMP_MS each, that together follow a curve the eye sees as even
+ *
+ * @values LED_RAMP_MS * LED_BREATHE_STEPS is one fade, in milliseconds
+ */
+#define LED_RAMP_MS 250
+#define LED_BREATHE_STEPS 4
+
+/**
+ * @brief A fade ends this much before its step, so the next fade never has to wait for it to finish
+ *
+ * @values in milliseconds, less than LED_RAMP_MS
+ */
+#define LED_FADE_MARGIN_MS 10
+
+/**
+ * @brief Marks a steady step, the LED stays as it is until the next request
+ *
+ */
+#define LED_HOLD_MS 0
+
+/**
+ * @brief Configuration parameters of a debug LED
+ */
+typedef struct
+{
+  /**
+   * GPIO pin the LED is connected to
+   *
+   * @values See which pins are usable in file "ESP32_Pins.xlsx"
+   */
+  uint16_t pin_u16;
+
+  /**
+   * PWM channel of the LED, the servos use LEDC_CHANNEL_0
+   *
+   * @values LEDC_CHANNEL_1..LEDC_CHANNEL_7
+   */
+  ledc_channel_t chn_s;
+} led_s_LedConfig_t;
+
+/**
+ * @brief What an LED is playing right now, only used from the LED timer
+ *
+ */
+typedef struct
+{
+  uint16_t request_u16; /* Request being played, as in led_g_Request_u16 */
+  uint16_t step_u16;    /* Step of the pattern */
+  uint16_t level_u16;   /* Brightness at the end of the current step, 0..LED_LEVEL_MAX */
+  uint8_t fade_u8;      /* Whether the current step fades to its brightness instead of jumping */
+} led_s_LedState_t;
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Configures all debug LEDs, indexed by led_Id_e
+ *
+ */
+led_s_LedConfig_t led_s_LedConfig_s[LED_ID_COUNT] = {
+    /*  pin           channel        */
+    {GPIO_NUM_37,  LEDC_CHANNEL_6 }, /* LED01 */
+    {GPIO_NUM_38,  LEDC_CHANNEL_7 }  /* LED02 */
+};
+
+/**
+ * @brief What every LED is playing right now
+ *
+ */
+extern led_s_LedState_t led_g_State_s[LED_ID_COUNT];
+
+/**
+ * @brief One shot timer of every LED, fires at the next step of its pattern
+ *
+ */
+extern esp_timer_handle_t led_g_Timer_s[LED_ID_COUNT];
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void led_f_Step_v(void *arg);
+extern uint16_t led_f_NextStep_u16(led_s_LedState_t *state);
+extern esp_err_t led_f_Show_s32(ledc_channel_t chn, const led_s_LedState_t *state, uint16_t waitMs);
+
+#endif // LED_I_H
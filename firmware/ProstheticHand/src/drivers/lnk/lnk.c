@@ -0,0 +1,376 @@
+/**
+ * @file lnk.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Link protocol software component
+ *
+ * Frames and parses the telemetry frames (A5 5A, id, seq, len, payload, CRC16) over any number of transports.
+ * A transport only has to move bytes: the telemetry link adds its UART and the BLE GATT service, and on Linux
+ * a pseudo-terminal or a socket stands in for both (see linux/lnk_host.c), so everything here can be tried out without the hand.
+ *
+ * Frames sent with lnk_f_Send_u8() go to every connected transport, replies with lnk_f_SendTo_u8() only to the
+ * transport the request came on. Nothing here blocks or knows about time, the transports take care of both.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "lnk_e.h"
+#include "lnk_i.h"
+
+#include "string.h"
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Transports added so far, in the order they were added
+ *
+ */
+lnk_s_Transport_t *lnk_g_Transports_ps[LNK_MAX_TRANSPORTS];
+uint8_t lnk_g_Count_u8 = 0;
+
+/**
+ * @brief Where the received frames go
+ *
+ */
+lnk_Handler_t lnk_g_Handler_pf = 0;
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+void lnk_f_Init_v(lnk_Handler_t handler);
+uint8_t lnk_f_Add_u8(lnk_s_Transport_t *transport);
+uint8_t lnk_f_Send_u8(uint8_t id, const uint8_t *payload, uint8_t len);
+uint8_t lnk_f_SendTo_u8(lnk_s_Transport_t *transport, uint8_t id, const uint8_t *payload, uint8_t len);
+void lnk_f_Receive_v(lnk_s_Transport_t *transport, const uint8_t *data, uint32_t len);
+void lnk_f_Flush_v(void);
+void lnk_f_Poll_v(void);
+uint8_t lnk_f_Count_u8(void);
+lnk_s_Transport_t *lnk_f_Get_ps(uint8_t index);
+uint16_t lnk_f_Crc16_u16(uint16_t crc, const uint8_t *data, uint16_t len);
+uint8_t lnk_f_PutU16_u8(uint8_t *buf, uint8_t idx, uint16_t val);
+uint8_t lnk_f_PutU32_u8(uint8_t *buf, uint8_t idx, uint32_t val);
+uint16_t lnk_f_Build_u16(uint8_t *frame, uint8_t id, uint8_t seq, const uint8_t *payload, uint8_t len);
+void lnk_f_Parse_v(lnk_s_Transport_t *transport, uint8_t byte);
+
+/**
+ * @brief Init function, called once before any transport is added
+ *
+ * @param handler called for every valid frame received
+ * @return void
+ */
+void lnk_f_Init_v(lnk_Handler_t handler)
+{
+  lnk_g_Handler_pf = handler;
+  lnk_g_Count_u8 = 0;
+}
+
+/**
+ * @brief Add a transport, its parser and statistics start over
+ *
+ * @param transport transport with write_pf (and flush_pf if it batches) filled in, has to stay valid
+ * @return 1 if it was added, 0 if there are already LNK_MAX_TRANSPORTS
+ */
+uint8_t lnk_f_Add_u8(lnk_s_Transport_t *transport)
+{
+  if (lnk_g_Count_u8 >= LNK_MAX_TRANSPORTS)
+  {
+    return 0;
+  }
+
+  transport->txSeq_u8 = 0;
+  transport->rx_s.state_e = LNK_RX_SYNC_1;
+  memset(&transport->stats_s, 0, sizeof(transport->stats_s));
+
+  lnk_g_Transports_ps[lnk_g_Count_u8++] = transport;
+
+  return 1;
+}
+
+/**
+ * @brief Send a frame on every connected transport
+ *
+ * @param id frame ID
+ * @param payload pointer to the payload bytes (already packed)
+ * @param len payload length, no more than LNK_MAX_PAYLOAD
+ * @return 1 if at least one transport queued the frame, 0 if it was dropped everywhere (or nobody listens)
+ */
+uint8_t lnk_f_Send_u8(uint8_t id, const uint8_t *payload, uint8_t len)
+{
+  uint8_t l_queued_u8 = 0;
+  uint8_t i;
+
+  for (i = 0; i < lnk_g_Count_u8; i++)
+  {
+    if (lnk_g_Transports_ps[i]->connected_u8)
+    {
+      l_queued_u8 |= lnk_f_SendTo_u8(lnk_g_Transports_ps[i], id, payload, len);
+    }
+  }
+
+  return l_queued_u8;
+}
+
+/**
+ * @brief Send a frame on one transport only, e.g. a reply to a request that came on it
+ *
+ * @param transport where to send it
+ * @param id frame ID
+ * @param payload pointer to the payload bytes (already packed)
+ * @param len payload length, no more than LNK_MAX_PAYLOAD
+ * @return 1 if the frame was queued, 0 if it was dropped
+ */
+uint8_t lnk_f_SendTo_u8(lnk_s_Transport_t *transport, uint8_t id, const uint8_t *payload, uint8_t len)
+{
+  uint8_t l_frame_u8[LNK_MAX_FRAME];
+  uint16_t l_frameLen_u16;
+
+  if ((len > LNK_MAX_PAYLOAD) || !transport->connected_u8)
+  {
+    transport->stats_s.txDropped_u32++;
+    return 0;
+  }
+
+  /* The sequence number only counts up for frames that were queued, so a gap on the host always means a loss on the way */
+  l_frameLen_u16 = lnk_f_Build_u16(l_frame_u8, id, transport->txSeq_u8, payload, len);
+  if (!transport->write_pf(l_frame_u8, l_frameLen_u16))
+  {
+    transport->stats_s.txDropped_u32++;
+    return 0;
+  }
+
+  transport->txSeq_u8++;
+  transport->stats_s.txBytes_u32 += l_frameLen_u16;
+  transport->stats_s.txFrames_u32++;
+
+  return 1;
+}
+
+/**
+ * @brief Run received bytes through the frame parser of their transport
+ *
+ * Valid frames are handed to the handler right away, from the task that calls this
+ *
+ * @param transport the bytes came on, with rxUs_s64 set to when they arrived
+ * @param data received bytes
+ * @param len number of bytes
+ * @return void
+ */
+void lnk_f_Receive_v(lnk_s_Transport_t *transport, const uint8_t *data, uint32_t len)
+{
+  uint32_t i;
+
+  for (i = 0; i < len; i++)
+  {
+    lnk_f_Parse_v(transport, data[i]);
+  }
+}
+
+/**
+ * @brief Let every transport that batches frames send them
+ *
+ * @return void
+ */
+void lnk_f_Flush_v(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < lnk_g_Count_u8; i++)
+  {
+    if (lnk_g_Transports_ps[i]->flush_pf != 0)
+    {
+      lnk_g_Transports_ps[i]->flush_pf();
+    }
+  }
+}
+
+/**
+ * @brief Let every transport that needs it hand over what it received
+ *
+ * @return void
+ */
+void lnk_f_Poll_v(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < lnk_g_Count_u8; i++)
+  {
+    if (lnk_g_Transports_ps[i]->poll_pf != 0)
+    {
+      lnk_g_Transports_ps[i]->poll_pf();
+    }
+  }
+}
+
+/**
+ * @brief Number of transports added, and the transport with the given index
+ *
+ */
+uint8_t lnk_f_Count_u8(void)
+{
+  return lnk_g_Count_u8;
+}
+
+lnk_s_Transport_t *lnk_f_Get_ps(uint8_t index)
+{
+  return (index < lnk_g_Count_u8) ? lnk_g_Transports_ps[index] : 0;
+}
+
+/**
+ * @brief Put the frame together
+ *
+ * @param frame at least LNK_HEADER_LEN + len + LNK_CRC_LEN bytes
+ * @return length of the frame
+ */
+uint16_t lnk_f_Build_u16(uint8_t *frame, uint8_t id, uint8_t seq, const uint8_t *payload, uint8_t len)
+{
+  uint16_t l_crc_u16;
+
+  frame[0] = LNK_SYNC_1;
+  frame[1] = LNK_SYNC_2;
+  frame[2] = id;
+  frame[3] = seq;
+  frame[4] = len;
+  memcpy(&frame[LNK_HEADER_LEN], payload, len);
+
+  l_crc_u16 = lnk_f_Crc16_u16(0xFFFF, &frame[2], LNK_HEADER_LEN - 2 + len);
+  lnk_f_PutU16_u8(frame, LNK_HEADER_LEN + len, l_crc_u16);
+
+  return LNK_HEADER_LEN + len + LNK_CRC_LEN;
+}
+
+/**
+ * @brief Feed one received byte to the frame parser of the transport
+ *
+ * @return void
+ */
+void lnk_f_Parse_v(lnk_s_Transport_t *transport, uint8_t byte)
+{
+  lnk_s_Parser_t *l_rx_ps = &transport->rx_s;
+  uint8_t l_header_u8[3];
+
+  switch (l_rx_ps->state_e)
+  {
+  case LNK_RX_SYNC_1:
+    if (byte == LNK_SYNC_1)
+    {
+      l_rx_ps->state_e = LNK_RX_SYNC_2;
+    }
+    break;
+  case LNK_RX_SYNC_2:
+    l_rx_ps->state_e = (byte == LNK_SYNC_2) ? LNK_RX_ID : LNK_RX_SYNC_1;
+    break;
+  case LNK_RX_ID:
+    l_rx_ps->id_u8 = byte;
+    l_rx_ps->state_e = LNK_RX_SEQ;
+    break;
+  case LNK_RX_SEQ:
+    l_rx_ps->seq_u8 = byte;
+    l_rx_ps->state_e = LNK_RX_LEN;
+    break;
+  case LNK_RX_LEN:
+    l_rx_ps->len_u8 = byte;
+    l_rx_ps->idx_u8 = 0;
+    if (l_rx_ps->len_u8 > LNK_MAX_PAYLOAD)
+    {
+      transport->stats_s.rxErrors_u32++;
+      l_rx_ps->state_e = LNK_RX_SYNC_1;
+    }
+    else
+    {
+      l_rx_ps->state_e = (l_rx_ps->len_u8 > 0) ? LNK_RX_PAYLOAD : LNK_RX_CRC_1;
+    }
+    break;
+  case LNK_RX_PAYLOAD:
+    l_rx_ps->payload_u8[l_rx_ps->idx_u8++] = byte;
+    if (l_rx_ps->idx_u8 >= l_rx_ps->len_u8)
+    {
+      l_rx_ps->state_e = LNK_RX_CRC_1;
+    }
+    break;
+  case LNK_RX_CRC_1:
+    l_rx_ps->crc_u16 = byte;
+    l_rx_ps->state_e = LNK_RX_CRC_2;
+    break;
+  case LNK_RX_CRC_2:
+  default:
+    l_rx_ps->crc_u16 |= (uint16_t)byte << 8;
+    l_rx_ps->state_e = LNK_RX_SYNC_1;
+
+    /* CRC over id, seq, len and payload, same as on the sending side */
+    l_header_u8[0] = l_rx_ps->id_u8;
+    l_header_u8[1] = l_rx_ps->seq_u8;
+    l_header_u8[2] = l_rx_ps->len_u8;
+    if (lnk_f_Crc16_u16(lnk_f_Crc16_u16(0xFFFF, l_header_u8, 3), l_rx_ps->payload_u8, l_rx_ps->len_u8) == l_rx_ps->crc_u16)
+    {
+      transport->stats_s.rxFrames_u32++;
+      if (lnk_g_Handler_pf != 0)
+      {
+        lnk_g_Handler_pf(transport, l_rx_ps->id_u8, l_rx_ps->payload_u8, l_rx_ps->len_u8);
+      }
+    }
+    else
+    {
+      transport->stats_s.rxErrors_u32++;
+    }
+    break;
+  }
+}
+
+/**
+ * @brief CRC-16/CCITT, bit by bit (frames are short, so no lookup table)
+ *
+ * @param crc starting value (0xFFFF for a new frame), lets the CRC be computed in parts
+ * @param data bytes to add to the CRC
+ * @param len number of bytes
+ * @return updated CRC
+ */
+uint16_t lnk_f_Crc16_u16(uint16_t crc, const uint8_t *data, uint16_t len)
+{
+  uint16_t i;
+  uint8_t j;
+
+  for (i = 0; i < len; i++)
+  {
+    crc ^= (uint16_t)data[i] << 8;
+    for (j = 0; j < 8; j++)
+    {
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+  }
+
+  return crc;
+}
+
+/**
+ * @brief Write a value into the buffer LSB first, no matter the alignment
+ *
+ * @return index right after the written value
+ */
+uint8_t lnk_f_PutU16_u8(uint8_t *buf, uint8_t idx, uint16_t val)
+{
+  buf[idx] = (uint8_t)val;
+  buf[idx + 1] = (uint8_t)(val >> 8);
+  return idx + 2;
+}
+
+uint8_t lnk_f_PutU32_u8(uint8_t *buf, uint8_t idx, uint32_t val)
+{
+  buf[idx] = (uint8_t)val;
+  buf[idx + 1] = (uint8_t)(val >> 8);
+  buf[idx + 2] = (uint8_t)(val >> 16);
+  buf[idx + 3] = (uint8_t)(val >> 24);
+  return idx + 4;
+}
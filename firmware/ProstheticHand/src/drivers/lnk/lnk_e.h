@@ -0,0 +1,172 @@
+/**
+ * @file lnk_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding lnk.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef LNK_E_H
+#define LNK_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Plain C only, so the module also builds on Linux (see linux/lnk_host.c) */
+#include "stdint.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Two sync bytes that start every frame
+ *
+ */
+#define LNK_SYNC_1 0xA5
+#define LNK_SYNC_2 0x5A
+
+/**
+ * @brief Frame layout: sync1, sync2, id, seq, len, payload[len], crc16 (LSB first)
+ *
+ * The CRC (CCITT, init 0xFFFF) covers id, seq, len and the payload
+ */
+#define LNK_HEADER_LEN 5
+#define LNK_CRC_LEN 2
+
+/**
+ * @brief Largest payload a single frame can carry
+ *
+ * @values 1..255 (payload length is sent as one byte)
+ */
+#define LNK_MAX_PAYLOAD 240
+#define LNK_MAX_FRAME (LNK_HEADER_LEN + LNK_MAX_PAYLOAD + LNK_CRC_LEN)
+
+/**
+ * @brief Most transports that can be added
+ *
+ * @values 1..255
+ */
+#define LNK_MAX_TRANSPORTS 4
+
+/**
+ * @brief States of the receive frame parser
+ *
+ */
+typedef enum
+{
+  LNK_RX_SYNC_1 = 0,
+  LNK_RX_SYNC_2,
+  LNK_RX_ID,
+  LNK_RX_SEQ,
+  LNK_RX_LEN,
+  LNK_RX_PAYLOAD,
+  LNK_RX_CRC_1,
+  LNK_RX_CRC_2
+} lnk_RxState_e;
+
+/**************************************************************************
+ * Structures
+ **************************************************************************/
+
+/**
+ * @brief Receive parser state and the frame being received
+ *
+ */
+typedef struct
+{
+  lnk_RxState_e state_e;
+  uint8_t id_u8;
+  uint8_t seq_u8;
+  uint8_t len_u8;
+  uint8_t idx_u8;
+  uint16_t crc_u16;
+  uint8_t payload_u8[LNK_MAX_PAYLOAD];
+} lnk_s_Parser_t;
+
+/**
+ * @brief Statistics of one transport, as seen from the device
+ *
+ */
+typedef struct
+{
+  uint32_t txBytes_u32;       /* Bytes handed to the transport */
+  uint32_t txFrames_u32;      /* Frames handed to the transport */
+  uint32_t txDropped_u32;     /* Frames dropped because the transport had no room for them */
+  uint32_t rxFrames_u32;      /* Valid frames received from the host */
+  uint32_t rxErrors_u32;      /* Frames received with a bad CRC or length, or a payload that made no sense */
+  uint32_t txBytesPerSec_u32; /* Throughput over the last second */
+  uint32_t maxWriteUs_u32;    /* Longest time spent queueing a frame, filled in by the transport */
+  uint32_t maxBacklogUs_u32;  /* Longest time a queued byte had to wait until it goes out, filled in by the transport */
+} lnk_s_Stats_t;
+
+/**
+ * @brief A byte stream the frames go over (UART, BLE, a socket on Linux)
+ *
+ * The transport only moves bytes, everything about frames is done here. Each transport has its own
+ * sequence numbers and parser, so the host on each of them sees a complete stream
+ */
+typedef struct
+{
+  const char *name_pc; /* For the debug output */
+
+  /**
+   * Queue a whole frame, or nothing at all if there is no room for it. Must not block
+   *
+   * @return 1 if the frame was queued, 0 if it was dropped
+   */
+  uint8_t (*write_pf)(const uint8_t *frame, uint16_t len);
+
+  /**
+   * Send whatever was queued, called once every telemetry period after all frames of that period.
+   * NULL if the transport sends the frames as they are queued
+   */
+  void (*flush_pf)(void);
+
+  /**
+   * Hand whatever arrived since the last call to lnk_f_Receive_v(), called every telemetry period from the task
+   * that handles the frames. NULL if the transport already does that from that task on its own
+   */
+  void (*poll_pf)(void);
+
+  uint8_t connected_u8; /* Whether someone listens on the other end, frames are only sent while they do */
+  uint8_t trusted_u8;   /* Whether frames that move the hand or change its parameters (STP_CTRL, STP, CFG_SET) are taken */
+  int64_t rxUs_s64;     /* When the data being received arrived, set by the transport before lnk_f_Receive_v() */
+  uint8_t txSeq_u8;     /* Sequence number of the next frame sent, lets the host count lost frames */
+  lnk_s_Parser_t rx_s;
+  lnk_s_Stats_t stats_s;
+} lnk_s_Transport_t;
+
+/**
+ * @brief Called for every valid frame received, with the transport it came on
+ *
+ */
+typedef void (*lnk_Handler_t)(lnk_s_Transport_t *transport, uint8_t id, const uint8_t *payload, uint8_t len);
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void lnk_f_Init_v(lnk_Handler_t handler);
+extern uint8_t lnk_f_Add_u8(lnk_s_Transport_t *transport);
+extern uint8_t lnk_f_Send_u8(uint8_t id, const uint8_t *payload, uint8_t len);
+extern uint8_t lnk_f_SendTo_u8(lnk_s_Transport_t *transport, uint8_t id, const uint8_t *payload, uint8_t len);
+extern void lnk_f_Receive_v(lnk_s_Transport_t *transport, const uint8_t *data, uint32_t len);
+extern void lnk_f_Flush_v(void);
+extern void lnk_f_Poll_v(void);
+extern uint8_t lnk_f_Count_u8(void);
+extern lnk_s_Transport_t *lnk_f_Get_ps(uint8_t index);
+extern uint16_t lnk_f_Crc16_u16(uint16_t crc, const uint8_t *data, uint16_t len);
+extern uint8_t lnk_f_PutU16_u8(uint8_t *buf, uint8_t idx, uint16_t val);
+extern uint8_t lnk_f_PutU32_u8(uint8_t *buf, uint8_t idx, uint32_t val);
+
+#endif // LNK_E_H
@@ -0,0 +1,50 @@
+/**
+ * @file lnk_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding lnk.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef LNK_I_H
+#define LNK_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "lnk_e.h"
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Transports added so far, in the order they were added
+ *
+ */
+extern lnk_s_Transport_t *lnk_g_Transports_ps[LNK_MAX_TRANSPORTS];
+extern uint8_t lnk_g_Count_u8;
+
+/**
+ * @brief Where the received frames go
+ *
+ */
+extern lnk_Handler_t lnk_g_Handler_pf;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern uint16_t lnk_f_Build_u16(uint8_t *frame, uint8_t id, uint8_t seq, const uint8_t *payload, uint8_t len);
+extern void lnk_f_Parse_v(lnk_s_Transport_t *transport, uint8_t byte);
+
+#endif // LNK_I_H
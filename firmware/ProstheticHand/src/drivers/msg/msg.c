@@ -0,0 +1,1123 @@
+/**
+ * @file msg.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Telemetry message packers and unpackers
+ *
+ * Generated from firmware/msg/messages.py by firmware/msg/msggen.py, do not edit
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "msg_e.h"
+#include "msg_i.h"
+
+#include "string.h"
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+uint8_t msg_f_PackUpdBegin_u8(uint8_t *buf, const msg_s_UpdBegin_t *msg);
+uint8_t msg_f_UnpackUpdBegin_u8(msg_s_UpdBegin_t *msg, const uint8_t *buf, uint8_t len);
+uint8_t msg_f_PackUpdData_u8(uint8_t *buf, const msg_s_UpdData_t *msg);
+uint8_t msg_f_UnpackUpdData_u8(msg_s_UpdData_t *msg, const uint8_t *buf, uint8_t len);
+uint8_t msg_f_PackTsyReq_u8(uint8_t *buf, const msg_s_TsyReq_t *msg);
+uint8_t msg_f_UnpackTsyReq_u8(msg_s_TsyReq_t *msg, const uint8_t *buf, uint8_t len);
+uint8_t msg_f_PackSub_u8(uint8_t *buf, const msg_s_Sub_t *msg);
+uint8_t msg_f_UnpackSub_u8(msg_s_Sub_t *msg, const uint8_t *buf, uint8_t len);
+uint8_t msg_f_PackStpCtrl_u8(uint8_t *buf, const msg_s_StpCtrl_t *msg);
+uint8_t msg_f_UnpackStpCtrl_u8(msg_s_StpCtrl_t *msg, const uint8_t *buf, uint8_t len);
+uint8_t msg_f_PackStp_u8(uint8_t *buf, const msg_s_Stp_t *msg);
+uint8_t msg_f_UnpackStp_u8(msg_s_Stp_t *msg, const uint8_t *buf, uint8_t len);
+uint8_t msg_f_PackCfgSet_u8(uint8_t *buf, const msg_s_CfgSet_t *msg);
+uint8_t msg_f_UnpackCfgSet_u8(msg_s_CfgSet_t *msg, const uint8_t *buf, uint8_t len);
+uint8_t msg_f_PackLinkStats_u8(uint8_t *buf, const msg_s_LinkStats_t *msg);
+uint8_t msg_f_UnpackLinkStats_u8(msg_s_LinkStats_t *msg, const uint8_t *buf, uint8_t len);
+uint8_t msg_f_PackRtm_u8(uint8_t *buf, const msg_s_Rtm_t *msg);
+uint8_t msg_f_UnpackRtm_u8(msg_s_Rtm_t *msg, const uint8_t *buf, uint8_t len);
+uint8_t msg_f_PackSignals_u8(uint8_t *buf, const msg_s_Signals_t *msg);
+uint8_t msg_f_UnpackSignals_u8(msg_s_Signals_t *msg, const uint8_t *buf, uint8_t len);
+uint8_t msg_f_PackTsyResp_u8(uint8_t *buf, const msg_s_TsyResp_t *msg);
+uint8_t msg_f_UnpackTsyResp_u8(msg_s_TsyResp_t *msg, const uint8_t *buf, uint8_t len);
+uint8_t msg_f_PackTsyStats_u8(uint8_t *buf, const msg_s_TsyStats_t *msg);
+uint8_t msg_f_UnpackTsyStats_u8(msg_s_TsyStats_t *msg, const uint8_t *buf, uint8_t len);
+uint8_t msg_f_PackSubState_u8(uint8_t *buf, const msg_s_SubState_t *msg);
+uint8_t msg_f_UnpackSubState_u8(msg_s_SubState_t *msg, const uint8_t *buf, uint8_t len);
+uint8_t msg_f_PackStpStats_u8(uint8_t *buf, const msg_s_StpStats_t *msg);
+uint8_t msg_f_UnpackStpStats_u8(msg_s_StpStats_t *msg, const uint8_t *buf, uint8_t len);
+uint8_t msg_f_PackCfg_u8(uint8_t *buf, const msg_s_Cfg_t *msg);
+uint8_t msg_f_UnpackCfg_u8(msg_s_Cfg_t *msg, const uint8_t *buf, uint8_t len);
+uint8_t msg_f_PackOsStats_u8(uint8_t *buf, const msg_s_OsStats_t *msg);
+uint8_t msg_f_UnpackOsStats_u8(msg_s_OsStats_t *msg, const uint8_t *buf, uint8_t len);
+uint8_t msg_f_PackTrace_u8(uint8_t *buf, const msg_s_Trace_t *msg);
+uint8_t msg_f_UnpackTrace_u8(msg_s_Trace_t *msg, const uint8_t *buf, uint8_t len);
+uint8_t msg_f_PackTraceTasks_u8(uint8_t *buf, const msg_s_TraceTasks_t *msg);
+uint8_t msg_f_UnpackTraceTasks_u8(msg_s_TraceTasks_t *msg, const uint8_t *buf, uint8_t len);
+uint8_t msg_f_PackErrStats_u8(uint8_t *buf, const msg_s_ErrStats_t *msg);
+uint8_t msg_f_UnpackErrStats_u8(msg_s_ErrStats_t *msg, const uint8_t *buf, uint8_t len);
+
+uint8_t msg_f_PutU16_u8(uint8_t *buf, uint8_t idx, uint16_t val);
+uint8_t msg_f_PutU32_u8(uint8_t *buf, uint8_t idx, uint32_t val);
+uint8_t msg_f_PutU64_u8(uint8_t *buf, uint8_t idx, uint64_t val);
+uint16_t msg_f_GetU16_u16(const uint8_t *buf);
+uint32_t msg_f_GetU32_u32(const uint8_t *buf);
+uint64_t msg_f_GetU64_u64(const uint8_t *buf);
+
+/**
+ * @brief Write UPD_BEGIN into a payload
+ *
+ * @param buf - payload, room for MSG_UPD_BEGIN_LEN bytes
+ * @param msg - message to write
+ *
+ * @return uint8_t - payload length
+ */
+uint8_t msg_f_PackUpdBegin_u8(uint8_t *buf, const msg_s_UpdBegin_t *msg)
+{
+  uint8_t l_idx_u8 = 0;
+
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->size_u32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->crc_u32);
+
+  return l_idx_u8;
+}
+
+/**
+ * @brief Read UPD_BEGIN out of a payload
+ *
+ * @param msg - message to fill
+ * @param buf - payload
+ * @param len - payload length
+ *
+ * @return uint8_t - 1 if the payload holds at least MSG_UPD_BEGIN_MIN_LEN bytes, 0 if not
+ */
+uint8_t msg_f_UnpackUpdBegin_u8(msg_s_UpdBegin_t *msg, const uint8_t *buf, uint8_t len)
+{
+  if (len < MSG_UPD_BEGIN_MIN_LEN)
+  {
+    return 0;
+  }
+
+  msg->size_u32 = msg_f_GetU32_u32(&buf[0]);
+  msg->crc_u32 = msg_f_GetU32_u32(&buf[4]);
+
+  return 1;
+}
+
+/**
+ * @brief Write UPD_DATA into a payload
+ *
+ * @param buf - payload, room for MSG_UPD_DATA_LEN bytes plus the bytes
+ * @param msg - message to write
+ *
+ * @return uint8_t - payload length
+ */
+uint8_t msg_f_PackUpdData_u8(uint8_t *buf, const msg_s_UpdData_t *msg)
+{
+  uint8_t l_idx_u8 = 0;
+
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->offset_u32);
+  memcpy(&buf[l_idx_u8], msg->data_pu8, msg->dataLen_u8);
+  l_idx_u8 += msg->dataLen_u8;
+
+  return l_idx_u8;
+}
+
+/**
+ * @brief Read UPD_DATA out of a payload
+ *
+ * @param msg - message to fill
+ * @param buf - payload
+ * @param len - payload length
+ *
+ * @return uint8_t - 1 if the payload holds at least MSG_UPD_DATA_MIN_LEN bytes, 0 if not
+ */
+uint8_t msg_f_UnpackUpdData_u8(msg_s_UpdData_t *msg, const uint8_t *buf, uint8_t len)
+{
+  if (len < MSG_UPD_DATA_MIN_LEN)
+  {
+    return 0;
+  }
+
+  msg->offset_u32 = msg_f_GetU32_u32(&buf[0]);
+  msg->data_pu8 = &buf[4];
+  msg->dataLen_u8 = len - 4;
+
+  return 1;
+}
+
+/**
+ * @brief Write TSY_REQ into a payload
+ *
+ * @param buf - payload, room for MSG_TSY_REQ_LEN bytes
+ * @param msg - message to write
+ *
+ * @return uint8_t - payload length
+ */
+uint8_t msg_f_PackTsyReq_u8(uint8_t *buf, const msg_s_TsyReq_t *msg)
+{
+  uint8_t l_idx_u8 = 0;
+
+  buf[l_idx_u8++] = msg->tag_u8;
+
+  return l_idx_u8;
+}
+
+/**
+ * @brief Read TSY_REQ out of a payload
+ *
+ * @param msg - message to fill
+ * @param buf - payload
+ * @param len - payload length
+ *
+ * @return uint8_t - 1 if the payload holds at least MSG_TSY_REQ_MIN_LEN bytes, 0 if not
+ */
+uint8_t msg_f_UnpackTsyReq_u8(msg_s_TsyReq_t *msg, const uint8_t *buf, uint8_t len)
+{
+  if (len < MSG_TSY_REQ_MIN_LEN)
+  {
+    return 0;
+  }
+
+  msg->tag_u8 = buf[0];
+
+  return 1;
+}
+
+/**
+ * @brief Write SUB into a payload
+ *
+ * @param buf - payload, room for MSG_SUB_LEN bytes
+ * @param msg - message to write
+ *
+ * @return uint8_t - payload length
+ */
+uint8_t msg_f_PackSub_u8(uint8_t *buf, const msg_s_Sub_t *msg)
+{
+  uint8_t l_idx_u8 = 0;
+
+  buf[l_idx_u8++] = msg->signal_u8;
+  buf[l_idx_u8++] = msg->mode_u8;
+  l_idx_u8 = msg_f_PutU16_u8(buf, l_idx_u8, msg->periodMs_u16);
+  l_idx_u8 = msg_f_PutU16_u8(buf, l_idx_u8, msg->threshold_u16);
+
+  return l_idx_u8;
+}
+
+/**
+ * @brief Read SUB out of a payload
+ *
+ * @param msg - message to fill
+ * @param buf - payload
+ * @param len - payload length
+ *
+ * @return uint8_t - 1 if the payload holds at least MSG_SUB_MIN_LEN bytes, 0 if not
+ */
+uint8_t msg_f_UnpackSub_u8(msg_s_Sub_t *msg, const uint8_t *buf, uint8_t len)
+{
+  if (len < MSG_SUB_MIN_LEN)
+  {
+    return 0;
+  }
+
+  msg->signal_u8 = buf[0];
+  msg->mode_u8 = buf[1];
+  msg->periodMs_u16 = msg_f_GetU16_u16(&buf[2]);
+  msg->threshold_u16 = msg_f_GetU16_u16(&buf[4]);
+
+  return 1;
+}
+
+/**
+ * @brief Write STP_CTRL into a payload
+ *
+ * @param buf - payload, room for MSG_STP_CTRL_LEN bytes
+ * @param msg - message to write
+ *
+ * @return uint8_t - payload length
+ */
+uint8_t msg_f_PackStpCtrl_u8(uint8_t *buf, const msg_s_StpCtrl_t *msg)
+{
+  uint8_t l_idx_u8 = 0;
+
+  buf[l_idx_u8++] = msg->mode_u8;
+  l_idx_u8 = msg_f_PutU16_u8(buf, l_idx_u8, msg->delayUs_u16);
+  l_idx_u8 = msg_f_PutU16_u8(buf, l_idx_u8, msg->timeoutMs_u16);
+
+  return l_idx_u8;
+}
+
+/**
+ * @brief Read STP_CTRL out of a payload
+ *
+ * @param msg - message to fill
+ * @param buf - payload
+ * @param len - payload length
+ *
+ * @return uint8_t - 1 if the payload holds at least MSG_STP_CTRL_MIN_LEN bytes, 0 if not
+ */
+uint8_t msg_f_UnpackStpCtrl_u8(msg_s_StpCtrl_t *msg, const uint8_t *buf, uint8_t len)
+{
+  if (len < MSG_STP_CTRL_MIN_LEN)
+  {
+    return 0;
+  }
+
+  msg->mode_u8 = buf[0];
+  msg->delayUs_u16 = msg_f_GetU16_u16(&buf[1]);
+  msg->timeoutMs_u16 = msg_f_GetU16_u16(&buf[3]);
+
+  return 1;
+}
+
+/**
+ * @brief Write STP into a payload
+ *
+ * @param buf - payload, room for MSG_STP_LEN bytes
+ * @param msg - message to write
+ *
+ * @return uint8_t - payload length
+ */
+uint8_t msg_f_PackStp_u8(uint8_t *buf, const msg_s_Stp_t *msg)
+{
+  uint8_t l_idx_u8 = 0;
+  uint8_t i;
+
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->hostUs_u32);
+  l_idx_u8 = msg_f_PutU16_u8(buf, l_idx_u8, msg->seq_u16);
+  for (i = 0; (i < msg->targetsCount_u8) && (i < MSG_STP_TARGETS_MAX); i++)
+  {
+    l_idx_u8 = msg_f_PutU16_u8(buf, l_idx_u8, msg->targets_s[i].position_u16);
+  }
+
+  return l_idx_u8;
+}
+
+/**
+ * @brief Read STP out of a payload
+ *
+ * @param msg - message to fill
+ * @param buf - payload
+ * @param len - payload length
+ *
+ * @return uint8_t - 1 if the payload holds at least MSG_STP_MIN_LEN bytes, 0 if not
+ */
+uint8_t msg_f_UnpackStp_u8(msg_s_Stp_t *msg, const uint8_t *buf, uint8_t len)
+{
+  uint8_t l_pos_u8;
+  uint8_t i;
+
+  if (len < MSG_STP_MIN_LEN)
+  {
+    return 0;
+  }
+
+  msg->hostUs_u32 = msg_f_GetU32_u32(&buf[0]);
+  msg->seq_u16 = msg_f_GetU16_u16(&buf[4]);
+
+  msg->targetsCount_u8 = (len - MSG_STP_MIN_LEN) / MSG_STP_TARGET_LEN;
+  if (msg->targetsCount_u8 > MSG_STP_TARGETS_MAX)
+  {
+    msg->targetsCount_u8 = MSG_STP_TARGETS_MAX;
+  }
+  for (i = 0; i < msg->targetsCount_u8; i++)
+  {
+    l_pos_u8 = MSG_STP_MIN_LEN + (i * MSG_STP_TARGET_LEN);
+    msg->targets_s[i].position_u16 = msg_f_GetU16_u16(&buf[l_pos_u8]);
+  }
+
+  return 1;
+}
+
+/**
+ * @brief Write CFG_SET into a payload
+ *
+ * @param buf - payload, room for MSG_CFG_SET_LEN bytes
+ * @param msg - message to write
+ *
+ * @return uint8_t - payload length
+ */
+uint8_t msg_f_PackCfgSet_u8(uint8_t *buf, const msg_s_CfgSet_t *msg)
+{
+  uint8_t l_idx_u8 = 0;
+  uint8_t i;
+
+  for (i = 0; (i < msg->valuesCount_u8) && (i < MSG_CFG_SET_VALUES_MAX); i++)
+  {
+    l_idx_u8 = msg_f_PutU16_u8(buf, l_idx_u8, msg->values_s[i].value_u16);
+  }
+
+  return l_idx_u8;
+}
+
+/**
+ * @brief Read CFG_SET out of a payload
+ *
+ * @param msg - message to fill
+ * @param buf - payload
+ * @param len - payload length
+ *
+ * @return uint8_t - 1 if the payload holds at least MSG_CFG_SET_MIN_LEN bytes, 0 if not
+ */
+uint8_t msg_f_UnpackCfgSet_u8(msg_s_CfgSet_t *msg, const uint8_t *buf, uint8_t len)
+{
+  uint8_t l_pos_u8;
+  uint8_t i;
+
+  msg->valuesCount_u8 = (len - MSG_CFG_SET_MIN_LEN) / MSG_CFG_SET_VALUE_LEN;
+  if (msg->valuesCount_u8 > MSG_CFG_SET_VALUES_MAX)
+  {
+    msg->valuesCount_u8 = MSG_CFG_SET_VALUES_MAX;
+  }
+  for (i = 0; i < msg->valuesCount_u8; i++)
+  {
+    l_pos_u8 = MSG_CFG_SET_MIN_LEN + (i * MSG_CFG_SET_VALUE_LEN);
+    msg->values_s[i].value_u16 = msg_f_GetU16_u16(&buf[l_pos_u8]);
+  }
+
+  return 1;
+}
+
+/**
+ * @brief Write LINK_STATS into a payload
+ *
+ * @param buf - payload, room for MSG_LINK_STATS_LEN bytes
+ * @param msg - message to write
+ *
+ * @return uint8_t - payload length
+ */
+uint8_t msg_f_PackLinkStats_u8(uint8_t *buf, const msg_s_LinkStats_t *msg)
+{
+  uint8_t l_idx_u8 = 0;
+
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->timeUs_u32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->txBytes_u32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->txFrames_u32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->txDropped_u32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->rxFrames_u32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->rxErrors_u32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->txBytesPerSec_u32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->maxWriteUs_u32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->maxBacklogUs_u32);
+
+  return l_idx_u8;
+}
+
+/**
+ * @brief Read LINK_STATS out of a payload
+ *
+ * @param msg - message to fill
+ * @param buf - payload
+ * @param len - payload length
+ *
+ * @return uint8_t - 1 if the payload holds at least MSG_LINK_STATS_MIN_LEN bytes, 0 if not
+ */
+uint8_t msg_f_UnpackLinkStats_u8(msg_s_LinkStats_t *msg, const uint8_t *buf, uint8_t len)
+{
+  if (len < MSG_LINK_STATS_MIN_LEN)
+  {
+    return 0;
+  }
+
+  msg->timeUs_u32 = msg_f_GetU32_u32(&buf[0]);
+  msg->txBytes_u32 = msg_f_GetU32_u32(&buf[4]);
+  msg->txFrames_u32 = msg_f_GetU32_u32(&buf[8]);
+  msg->txDropped_u32 = msg_f_GetU32_u32(&buf[12]);
+  msg->rxFrames_u32 = msg_f_GetU32_u32(&buf[16]);
+  msg->rxErrors_u32 = msg_f_GetU32_u32(&buf[20]);
+  msg->txBytesPerSec_u32 = msg_f_GetU32_u32(&buf[24]);
+  msg->maxWriteUs_u32 = msg_f_GetU32_u32(&buf[28]);
+  msg->maxBacklogUs_u32 = msg_f_GetU32_u32(&buf[32]);
+
+  return 1;
+}
+
+/**
+ * @brief Write RTM into a payload
+ *
+ * @param buf - payload, room for MSG_RTM_LEN bytes
+ * @param msg - message to write
+ *
+ * @return uint8_t - payload length
+ */
+uint8_t msg_f_PackRtm_u8(uint8_t *buf, const msg_s_Rtm_t *msg)
+{
+  uint8_t l_idx_u8 = 0;
+  uint8_t i;
+
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->timeUs_u32);
+  for (i = 0; (i < msg->slotsCount_u8) && (i < MSG_RTM_SLOTS_MAX); i++)
+  {
+    l_idx_u8 = msg_f_PutU16_u8(buf, l_idx_u8, msg->slots_s[i].currentUs_u16);
+    l_idx_u8 = msg_f_PutU16_u8(buf, l_idx_u8, msg->slots_s[i].minUs_u16);
+    l_idx_u8 = msg_f_PutU16_u8(buf, l_idx_u8, msg->slots_s[i].maxUs_u16);
+  }
+
+  return l_idx_u8;
+}
+
+/**
+ * @brief Read RTM out of a payload
+ *
+ * @param msg - message to fill
+ * @param buf - payload
+ * @param len - payload length
+ *
+ * @return uint8_t - 1 if the payload holds at least MSG_RTM_MIN_LEN bytes, 0 if not
+ */
+uint8_t msg_f_UnpackRtm_u8(msg_s_Rtm_t *msg, const uint8_t *buf, uint8_t len)
+{
+  uint8_t l_pos_u8;
+  uint8_t i;
+
+  if (len < MSG_RTM_MIN_LEN)
+  {
+    return 0;
+  }
+
+  msg->timeUs_u32 = msg_f_GetU32_u32(&buf[0]);
+
+  msg->slotsCount_u8 = (len - MSG_RTM_MIN_LEN) / MSG_RTM_SLOT_LEN;
+  if (msg->slotsCount_u8 > MSG_RTM_SLOTS_MAX)
+  {
+    msg->slotsCount_u8 = MSG_RTM_SLOTS_MAX;
+  }
+  for (i = 0; i < msg->slotsCount_u8; i++)
+  {
+    l_pos_u8 = MSG_RTM_MIN_LEN + (i * MSG_RTM_SLOT_LEN);
+    msg->slots_s[i].currentUs_u16 = msg_f_GetU16_u16(&buf[l_pos_u8]);
+    msg->slots_s[i].minUs_u16 = msg_f_GetU16_u16(&buf[l_pos_u8 + 2]);
+    msg->slots_s[i].maxUs_u16 = msg_f_GetU16_u16(&buf[l_pos_u8 + 4]);
+  }
+
+  return 1;
+}
+
+/**
+ * @brief Write SIGNALS into a payload
+ *
+ * @param buf - payload, room for MSG_SIGNALS_LEN bytes plus the bytes
+ * @param msg - message to write
+ *
+ * @return uint8_t - payload length
+ */
+uint8_t msg_f_PackSignals_u8(uint8_t *buf, const msg_s_Signals_t *msg)
+{
+  uint8_t l_idx_u8 = 0;
+
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->timeUs_u32);
+  memcpy(&buf[l_idx_u8], msg->records_pu8, msg->recordsLen_u8);
+  l_idx_u8 += msg->recordsLen_u8;
+
+  return l_idx_u8;
+}
+
+/**
+ * @brief Read SIGNALS out of a payload
+ *
+ * @param msg - message to fill
+ * @param buf - payload
+ * @param len - payload length
+ *
+ * @return uint8_t - 1 if the payload holds at least MSG_SIGNALS_MIN_LEN bytes, 0 if not
+ */
+uint8_t msg_f_UnpackSignals_u8(msg_s_Signals_t *msg, const uint8_t *buf, uint8_t len)
+{
+  if (len < MSG_SIGNALS_MIN_LEN)
+  {
+    return 0;
+  }
+
+  msg->timeUs_u32 = msg_f_GetU32_u32(&buf[0]);
+  msg->records_pu8 = &buf[4];
+  msg->recordsLen_u8 = len - 4;
+
+  return 1;
+}
+
+/**
+ * @brief Write TSY_RESP into a payload
+ *
+ * @param buf - payload, room for MSG_TSY_RESP_LEN bytes
+ * @param msg - message to write
+ *
+ * @return uint8_t - payload length
+ */
+uint8_t msg_f_PackTsyResp_u8(uint8_t *buf, const msg_s_TsyResp_t *msg)
+{
+  uint8_t l_idx_u8 = 0;
+
+  buf[l_idx_u8++] = msg->tag_u8;
+  l_idx_u8 = msg_f_PutU64_u8(buf, l_idx_u8, msg->rxUs_u64);
+  l_idx_u8 = msg_f_PutU64_u8(buf, l_idx_u8, msg->txUs_u64);
+
+  return l_idx_u8;
+}
+
+/**
+ * @brief Read TSY_RESP out of a payload
+ *
+ * @param msg - message to fill
+ * @param buf - payload
+ * @param len - payload length
+ *
+ * @return uint8_t - 1 if the payload holds at least MSG_TSY_RESP_MIN_LEN bytes, 0 if not
+ */
+uint8_t msg_f_UnpackTsyResp_u8(msg_s_TsyResp_t *msg, const uint8_t *buf, uint8_t len)
+{
+  if (len < MSG_TSY_RESP_MIN_LEN)
+  {
+    return 0;
+  }
+
+  msg->tag_u8 = buf[0];
+  msg->rxUs_u64 = msg_f_GetU64_u64(&buf[1]);
+  msg->txUs_u64 = msg_f_GetU64_u64(&buf[9]);
+
+  return 1;
+}
+
+/**
+ * @brief Write TSY_STATS into a payload
+ *
+ * @param buf - payload, room for MSG_TSY_STATS_LEN bytes
+ * @param msg - message to write
+ *
+ * @return uint8_t - payload length
+ */
+uint8_t msg_f_PackTsyStats_u8(uint8_t *buf, const msg_s_TsyStats_t *msg)
+{
+  uint8_t l_idx_u8 = 0;
+
+  l_idx_u8 = msg_f_PutU64_u8(buf, l_idx_u8, msg->refUs_u64);
+  l_idx_u8 = msg_f_PutU64_u8(buf, l_idx_u8, (uint64_t)msg->offsetUs_s64);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, (uint32_t)msg->driftPpb_s32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->rttUs_u32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->errorUs_u32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->samples_u32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->lost_u32);
+
+  return l_idx_u8;
+}
+
+/**
+ * @brief Read TSY_STATS out of a payload
+ *
+ * @param msg - message to fill
+ * @param buf - payload
+ * @param len - payload length
+ *
+ * @return uint8_t - 1 if the payload holds at least MSG_TSY_STATS_MIN_LEN bytes, 0 if not
+ */
+uint8_t msg_f_UnpackTsyStats_u8(msg_s_TsyStats_t *msg, const uint8_t *buf, uint8_t len)
+{
+  if (len < MSG_TSY_STATS_MIN_LEN)
+  {
+    return 0;
+  }
+
+  msg->refUs_u64 = msg_f_GetU64_u64(&buf[0]);
+  msg->offsetUs_s64 = (int64_t)msg_f_GetU64_u64(&buf[8]);
+  msg->driftPpb_s32 = (int32_t)msg_f_GetU32_u32(&buf[16]);
+  msg->rttUs_u32 = msg_f_GetU32_u32(&buf[20]);
+  msg->errorUs_u32 = msg_f_GetU32_u32(&buf[24]);
+  msg->samples_u32 = msg_f_GetU32_u32(&buf[28]);
+  msg->lost_u32 = msg_f_GetU32_u32(&buf[32]);
+
+  return 1;
+}
+
+/**
+ * @brief Write SUB_STATE into a payload
+ *
+ * @param buf - payload, room for MSG_SUB_STATE_LEN bytes
+ * @param msg - message to write
+ *
+ * @return uint8_t - payload length
+ */
+uint8_t msg_f_PackSubState_u8(uint8_t *buf, const msg_s_SubState_t *msg)
+{
+  uint8_t l_idx_u8 = 0;
+
+  buf[l_idx_u8++] = msg->signal_u8;
+  buf[l_idx_u8++] = msg->mode_u8;
+  l_idx_u8 = msg_f_PutU16_u8(buf, l_idx_u8, msg->periodMs_u16);
+  l_idx_u8 = msg_f_PutU16_u8(buf, l_idx_u8, msg->threshold_u16);
+  buf[l_idx_u8++] = msg->channels_u8;
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->bytesPerSec_u32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->dropped_u32);
+
+  return l_idx_u8;
+}
+
+/**
+ * @brief Read SUB_STATE out of a payload
+ *
+ * @param msg - message to fill
+ * @param buf - payload
+ * @param len - payload length
+ *
+ * @return uint8_t - 1 if the payload holds at least MSG_SUB_STATE_MIN_LEN bytes, 0 if not
+ */
+uint8_t msg_f_UnpackSubState_u8(msg_s_SubState_t *msg, const uint8_t *buf, uint8_t len)
+{
+  if (len < MSG_SUB_STATE_MIN_LEN)
+  {
+    return 0;
+  }
+
+  msg->signal_u8 = buf[0];
+  msg->mode_u8 = buf[1];
+  msg->periodMs_u16 = msg_f_GetU16_u16(&buf[2]);
+  msg->threshold_u16 = msg_f_GetU16_u16(&buf[4]);
+  msg->channels_u8 = buf[6];
+  msg->bytesPerSec_u32 = msg_f_GetU32_u32(&buf[7]);
+  msg->dropped_u32 = msg_f_GetU32_u32(&buf[11]);
+
+  return 1;
+}
+
+/**
+ * @brief Write STP_STATS into a payload
+ *
+ * @param buf - payload, room for MSG_STP_STATS_LEN bytes
+ * @param msg - message to write
+ *
+ * @return uint8_t - payload length
+ */
+uint8_t msg_f_PackStpStats_u8(uint8_t *buf, const msg_s_StpStats_t *msg)
+{
+  uint8_t l_idx_u8 = 0;
+
+  buf[l_idx_u8++] = msg->mode_u8;
+  buf[l_idx_u8++] = msg->state_u8;
+  buf[l_idx_u8++] = msg->depth_u8;
+  l_idx_u8 = msg_f_PutU16_u8(buf, l_idx_u8, msg->delayUs_u16);
+  l_idx_u8 = msg_f_PutU16_u8(buf, l_idx_u8, msg->timeoutMs_u16);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->received_u32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->late_u32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->dropped_u32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->holds_u32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->timeouts_u32);
+  l_idx_u8 = msg_f_PutU16_u8(buf, l_idx_u8, msg->lastSeq_u16);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->lastHostUs_u32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->dwellUs_u32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->jitterUs_u32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->minLatencyUs_u32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->maxLatencyUs_u32);
+
+  return l_idx_u8;
+}
+
+/**
+ * @brief Read STP_STATS out of a payload
+ *
+ * @param msg - message to fill
+ * @param buf - payload
+ * @param len - payload length
+ *
+ * @return uint8_t - 1 if the payload holds at least MSG_STP_STATS_MIN_LEN bytes, 0 if not
+ */
+uint8_t msg_f_UnpackStpStats_u8(msg_s_StpStats_t *msg, const uint8_t *buf, uint8_t len)
+{
+  if (len < MSG_STP_STATS_MIN_LEN)
+  {
+    return 0;
+  }
+
+  msg->mode_u8 = buf[0];
+  msg->state_u8 = buf[1];
+  msg->depth_u8 = buf[2];
+  msg->delayUs_u16 = msg_f_GetU16_u16(&buf[3]);
+  msg->timeoutMs_u16 = msg_f_GetU16_u16(&buf[5]);
+  msg->received_u32 = msg_f_GetU32_u32(&buf[7]);
+  msg->late_u32 = msg_f_GetU32_u32(&buf[11]);
+  msg->dropped_u32 = msg_f_GetU32_u32(&buf[15]);
+  msg->holds_u32 = msg_f_GetU32_u32(&buf[19]);
+  msg->timeouts_u32 = msg_f_GetU32_u32(&buf[23]);
+  msg->lastSeq_u16 = msg_f_GetU16_u16(&buf[27]);
+  msg->lastHostUs_u32 = msg_f_GetU32_u32(&buf[29]);
+  msg->dwellUs_u32 = msg_f_GetU32_u32(&buf[33]);
+  msg->jitterUs_u32 = msg_f_GetU32_u32(&buf[37]);
+  msg->minLatencyUs_u32 = msg_f_GetU32_u32(&buf[41]);
+  msg->maxLatencyUs_u32 = msg_f_GetU32_u32(&buf[45]);
+
+  return 1;
+}
+
+/**
+ * @brief Write CFG into a payload
+ *
+ * @param buf - payload, room for MSG_CFG_LEN bytes
+ * @param msg - message to write
+ *
+ * @return uint8_t - payload length
+ */
+uint8_t msg_f_PackCfg_u8(uint8_t *buf, const msg_s_Cfg_t *msg)
+{
+  uint8_t l_idx_u8 = 0;
+  uint8_t i;
+
+  for (i = 0; (i < msg->valuesCount_u8) && (i < MSG_CFG_VALUES_MAX); i++)
+  {
+    l_idx_u8 = msg_f_PutU16_u8(buf, l_idx_u8, msg->values_s[i].value_u16);
+  }
+
+  return l_idx_u8;
+}
+
+/**
+ * @brief Read CFG out of a payload
+ *
+ * @param msg - message to fill
+ * @param buf - payload
+ * @param len - payload length
+ *
+ * @return uint8_t - 1 if the payload holds at least MSG_CFG_MIN_LEN bytes, 0 if not
+ */
+uint8_t msg_f_UnpackCfg_u8(msg_s_Cfg_t *msg, const uint8_t *buf, uint8_t len)
+{
+  uint8_t l_pos_u8;
+  uint8_t i;
+
+  msg->valuesCount_u8 = (len - MSG_CFG_MIN_LEN) / MSG_CFG_VALUE_LEN;
+  if (msg->valuesCount_u8 > MSG_CFG_VALUES_MAX)
+  {
+    msg->valuesCount_u8 = MSG_CFG_VALUES_MAX;
+  }
+  for (i = 0; i < msg->valuesCount_u8; i++)
+  {
+    l_pos_u8 = MSG_CFG_MIN_LEN + (i * MSG_CFG_VALUE_LEN);
+    msg->values_s[i].value_u16 = msg_f_GetU16_u16(&buf[l_pos_u8]);
+  }
+
+  return 1;
+}
+
+/**
+ * @brief Write OS_STATS into a payload
+ *
+ * @param buf - payload, room for MSG_OS_STATS_LEN bytes
+ * @param msg - message to write
+ *
+ * @return uint8_t - payload length
+ */
+uint8_t msg_f_PackOsStats_u8(uint8_t *buf, const msg_s_OsStats_t *msg)
+{
+  uint8_t l_idx_u8 = 0;
+  uint8_t i;
+
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->timeUs_u32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->windowUs_u32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->heapFree_u32);
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->heapMinFree_u32);
+  l_idx_u8 = msg_f_PutU16_u8(buf, l_idx_u8, msg->idle0_u16);
+  l_idx_u8 = msg_f_PutU16_u8(buf, l_idx_u8, msg->idle1_u16);
+  l_idx_u8 = msg_f_PutU16_u8(buf, l_idx_u8, msg->collectUs_u16);
+  buf[l_idx_u8++] = msg->taskCount_u8;
+  for (i = 0; (i < msg->tasksCount_u8) && (i < MSG_OS_STATS_TASKS_MAX); i++)
+  {
+    l_idx_u8 = msg_f_PutU64_u8(buf, l_idx_u8, msg->tasks_s[i].name_u64);
+    buf[l_idx_u8++] = msg->tasks_s[i].core_u8;
+    buf[l_idx_u8++] = msg->tasks_s[i].priority_u8;
+    l_idx_u8 = msg_f_PutU16_u8(buf, l_idx_u8, msg->tasks_s[i].stackFree_u16);
+    l_idx_u8 = msg_f_PutU16_u8(buf, l_idx_u8, msg->tasks_s[i].load_u16);
+  }
+
+  return l_idx_u8;
+}
+
+/**
+ * @brief Read OS_STATS out of a payload
+ *
+ * @param msg - message to fill
+ * @param buf - payload
+ * @param len - payload length
+ *
+ * @return uint8_t - 1 if the payload holds at least MSG_OS_STATS_MIN_LEN bytes, 0 if not
+ */
+uint8_t msg_f_UnpackOsStats_u8(msg_s_OsStats_t *msg, const uint8_t *buf, uint8_t len)
+{
+  uint8_t l_pos_u8;
+  uint8_t i;
+
+  if (len < MSG_OS_STATS_MIN_LEN)
+  {
+    return 0;
+  }
+
+  msg->timeUs_u32 = msg_f_GetU32_u32(&buf[0]);
+  msg->windowUs_u32 = msg_f_GetU32_u32(&buf[4]);
+  msg->heapFree_u32 = msg_f_GetU32_u32(&buf[8]);
+  msg->heapMinFree_u32 = msg_f_GetU32_u32(&buf[12]);
+  msg->idle0_u16 = msg_f_GetU16_u16(&buf[16]);
+  msg->idle1_u16 = msg_f_GetU16_u16(&buf[18]);
+  msg->collectUs_u16 = msg_f_GetU16_u16(&buf[20]);
+  msg->taskCount_u8 = buf[22];
+
+  msg->tasksCount_u8 = (len - MSG_OS_STATS_MIN_LEN) / MSG_OS_STATS_TASK_LEN;
+  if (msg->tasksCount_u8 > MSG_OS_STATS_TASKS_MAX)
+  {
+    msg->tasksCount_u8 = MSG_OS_STATS_TASKS_MAX;
+  }
+  for (i = 0; i < msg->tasksCount_u8; i++)
+  {
+    l_pos_u8 = MSG_OS_STATS_MIN_LEN + (i * MSG_OS_STATS_TASK_LEN);
+    msg->tasks_s[i].name_u64 = msg_f_GetU64_u64(&buf[l_pos_u8]);
+    msg->tasks_s[i].core_u8 = buf[l_pos_u8 + 8];
+    msg->tasks_s[i].priority_u8 = buf[l_pos_u8 + 9];
+    msg->tasks_s[i].stackFree_u16 = msg_f_GetU16_u16(&buf[l_pos_u8 + 10]);
+    msg->tasks_s[i].load_u16 = msg_f_GetU16_u16(&buf[l_pos_u8 + 12]);
+  }
+
+  return 1;
+}
+
+/**
+ * @brief Write TRACE into a payload
+ *
+ * @param buf - payload, room for MSG_TRACE_LEN bytes
+ * @param msg - message to write
+ *
+ * @return uint8_t - payload length
+ */
+uint8_t msg_f_PackTrace_u8(uint8_t *buf, const msg_s_Trace_t *msg)
+{
+  uint8_t l_idx_u8 = 0;
+  uint8_t i;
+
+  buf[l_idx_u8++] = msg->core_u8;
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->lost_u32);
+  for (i = 0; (i < msg->recordsCount_u8) && (i < MSG_TRACE_RECORDS_MAX); i++)
+  {
+    l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->records_s[i].timeUs_u32);
+    buf[l_idx_u8++] = msg->records_s[i].type_u8;
+    buf[l_idx_u8++] = msg->records_s[i].id_u8;
+    l_idx_u8 = msg_f_PutU16_u8(buf, l_idx_u8, msg->records_s[i].arg_u16);
+  }
+
+  return l_idx_u8;
+}
+
+/**
+ * @brief Read TRACE out of a payload
+ *
+ * @param msg - message to fill
+ * @param buf - payload
+ * @param len - payload length
+ *
+ * @return uint8_t - 1 if the payload holds at least MSG_TRACE_MIN_LEN bytes, 0 if not
+ */
+uint8_t msg_f_UnpackTrace_u8(msg_s_Trace_t *msg, const uint8_t *buf, uint8_t len)
+{
+  uint8_t l_pos_u8;
+  uint8_t i;
+
+  if (len < MSG_TRACE_MIN_LEN)
+  {
+    return 0;
+  }
+
+  msg->core_u8 = buf[0];
+  msg->lost_u32 = msg_f_GetU32_u32(&buf[1]);
+
+  msg->recordsCount_u8 = (len - MSG_TRACE_MIN_LEN) / MSG_TRACE_RECORD_LEN;
+  if (msg->recordsCount_u8 > MSG_TRACE_RECORDS_MAX)
+  {
+    msg->recordsCount_u8 = MSG_TRACE_RECORDS_MAX;
+  }
+  for (i = 0; i < msg->recordsCount_u8; i++)
+  {
+    l_pos_u8 = MSG_TRACE_MIN_LEN + (i * MSG_TRACE_RECORD_LEN);
+    msg->records_s[i].timeUs_u32 = msg_f_GetU32_u32(&buf[l_pos_u8]);
+    msg->records_s[i].type_u8 = buf[l_pos_u8 + 4];
+    msg->records_s[i].id_u8 = buf[l_pos_u8 + 5];
+    msg->records_s[i].arg_u16 = msg_f_GetU16_u16(&buf[l_pos_u8 + 6]);
+  }
+
+  return 1;
+}
+
+/**
+ * @brief Write TRACE_TASKS into a payload
+ *
+ * @param buf - payload, room for MSG_TRACE_TASKS_LEN bytes
+ * @param msg - message to write
+ *
+ * @return uint8_t - payload length
+ */
+uint8_t msg_f_PackTraceTasks_u8(uint8_t *buf, const msg_s_TraceTasks_t *msg)
+{
+  uint8_t l_idx_u8 = 0;
+  uint8_t i;
+
+  buf[l_idx_u8++] = msg->core_u8;
+  for (i = 0; (i < msg->tasksCount_u8) && (i < MSG_TRACE_TASKS_TASKS_MAX); i++)
+  {
+    buf[l_idx_u8++] = msg->tasks_s[i].index_u8;
+    l_idx_u8 = msg_f_PutU64_u8(buf, l_idx_u8, msg->tasks_s[i].name_u64);
+  }
+
+  return l_idx_u8;
+}
+
+/**
+ * @brief Read TRACE_TASKS out of a payload
+ *
+ * @param msg - message to fill
+ * @param buf - payload
+ * @param len - payload length
+ *
+ * @return uint8_t - 1 if the payload holds at least MSG_TRACE_TASKS_MIN_LEN bytes, 0 if not
+ */
+uint8_t msg_f_UnpackTraceTasks_u8(msg_s_TraceTasks_t *msg, const uint8_t *buf, uint8_t len)
+{
+  uint8_t l_pos_u8;
+  uint8_t i;
+
+  if (len < MSG_TRACE_TASKS_MIN_LEN)
+  {
+    return 0;
+  }
+
+  msg->core_u8 = buf[0];
+
+  msg->tasksCount_u8 = (len - MSG_TRACE_TASKS_MIN_LEN) / MSG_TRACE_TASKS_TASK_LEN;
+  if (msg->tasksCount_u8 > MSG_TRACE_TASKS_TASKS_MAX)
+  {
+    msg->tasksCount_u8 = MSG_TRACE_TASKS_TASKS_MAX;
+  }
+  for (i = 0; i < msg->tasksCount_u8; i++)
+  {
+    l_pos_u8 = MSG_TRACE_TASKS_MIN_LEN + (i * MSG_TRACE_TASKS_TASK_LEN);
+    msg->tasks_s[i].index_u8 = buf[l_pos_u8];
+    msg->tasks_s[i].name_u64 = msg_f_GetU64_u64(&buf[l_pos_u8 + 1]);
+  }
+
+  return 1;
+}
+
+/**
+ * @brief Write ERR_STATS into a payload
+ *
+ * @param buf - payload, room for MSG_ERR_STATS_LEN bytes
+ * @param msg - message to write
+ *
+ * @return uint8_t - payload length
+ */
+uint8_t msg_f_PackErrStats_u8(uint8_t *buf, const msg_s_ErrStats_t *msg)
+{
+  uint8_t l_idx_u8 = 0;
+  uint8_t i;
+
+  l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->timeUs_u32);
+  for (i = 0; (i < msg->sourcesCount_u8) && (i < MSG_ERR_STATS_SOURCES_MAX); i++)
+  {
+    l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->sources_s[i].errors_u32);
+    l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->sources_s[i].retries_u32);
+    l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, msg->sources_s[i].failures_u32);
+    l_idx_u8 = msg_f_PutU32_u8(buf, l_idx_u8, (uint32_t)msg->sources_s[i].lastError_s32);
+    buf[l_idx_u8++] = msg->sources_s[i].degraded_u8;
+  }
+
+  return l_idx_u8;
+}
+
+/**
+ * @brief Read ERR_STATS out of a payload
+ *
+ * @param msg - message to fill
+ * @param buf - payload
+ * @param len - payload length
+ *
+ * @return uint8_t - 1 if the payload holds at least MSG_ERR_STATS_MIN_LEN bytes, 0 if not
+ */
+uint8_t msg_f_UnpackErrStats_u8(msg_s_ErrStats_t *msg, const uint8_t *buf, uint8_t len)
+{
+  uint8_t l_pos_u8;
+  uint8_t i;
+
+  if (len < MSG_ERR_STATS_MIN_LEN)
+  {
+    return 0;
+  }
+
+  msg->timeUs_u32 = msg_f_GetU32_u32(&buf[0]);
+
+  msg->sourcesCount_u8 = (len - MSG_ERR_STATS_MIN_LEN) / MSG_ERR_STATS_SOURCE_LEN;
+  if (msg->sourcesCount_u8 > MSG_ERR_STATS_SOURCES_MAX)
+  {
+    msg->sourcesCount_u8 = MSG_ERR_STATS_SOURCES_MAX;
+  }
+  for (i = 0; i < msg->sourcesCount_u8; i++)
+  {
+    l_pos_u8 = MSG_ERR_STATS_MIN_LEN + (i * MSG_ERR_STATS_SOURCE_LEN);
+    msg->sources_s[i].errors_u32 = msg_f_GetU32_u32(&buf[l_pos_u8]);
+    msg->sources_s[i].retries_u32 = msg_f_GetU32_u32(&buf[l_pos_u8 + 4]);
+    msg->sources_s[i].failures_u32 = msg_f_GetU32_u32(&buf[l_pos_u8 + 8]);
+    msg->sources_s[i].lastError_s32 = (int32_t)msg_f_GetU32_u32(&buf[l_pos_u8 + 12]);
+    msg->sources_s[i].degraded_u8 = buf[l_pos_u8 + 16];
+  }
+
+  return 1;
+}
+
+/**
+ * @brief Write a value LSB first
+ *
+ * @param buf - payload
+ * @param idx - where to write
+ * @param val - value
+ *
+ * @return uint8_t - index after the value
+ */
+uint8_t msg_f_PutU16_u8(uint8_t *buf, uint8_t idx, uint16_t val)
+{
+  buf[idx++] = (uint8_t)val;
+  buf[idx++] = (uint8_t)(val >> 8);
+  return idx;
+}
+
+uint8_t msg_f_PutU32_u8(uint8_t *buf, uint8_t idx, uint32_t val)
+{
+  idx = msg_f_PutU16_u8(buf, idx, (uint16_t)val);
+  return msg_f_PutU16_u8(buf, idx, (uint16_t)(val >> 16));
+}
+
+uint8_t msg_f_PutU64_u8(uint8_t *buf, uint8_t idx, uint64_t val)
+{
+  idx = msg_f_PutU32_u8(buf, idx, (uint32_t)val);
+  return msg_f_PutU32_u8(buf, idx, (uint32_t)(val >> 32));
+}
+
+/**
+ * @brief Read a value sent LSB first, from any alignment
+ *
+ * @param buf - first byte of the value
+ *
+ * @return the value
+ */
+uint16_t msg_f_GetU16_u16(const uint8_t *buf)
+{
+  return (uint16_t)(buf[0] | ((uint16_t)buf[1] << 8));
+}
+
+uint32_t msg_f_GetU32_u32(const uint8_t *buf)
+{
+  return (uint32_t)msg_f_GetU16_u16(buf) | ((uint32_t)msg_f_GetU16_u16(&buf[2]) << 16);
+}
+
+uint64_t msg_f_GetU64_u64(const uint8_t *buf)
+{
+  return (uint64_t)msg_f_GetU32_u32(buf) | ((uint64_t)msg_f_GetU32_u32(&buf[4]) << 32);
+}
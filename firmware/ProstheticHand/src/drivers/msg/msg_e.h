@@ -0,0 +1,515 @@
+/**
+ * @file msg_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding msg.c
+ *
+ * Generated from firmware/msg/messages.py by firmware/msg/msggen.py, do not edit.
+ * Packers write the current layout, unpackers take every layout since version 1 (newer fields
+ * missing from an older payload are 0, anything after the known fields is ignored)
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef MSG_E_H
+#define MSG_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "stdint.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Version of messages.py this was generated from
+ *
+ */
+#define MSG_SCHEMA_VERSION 8
+
+/**
+ * @brief Frame IDs, payload lengths (_MIN_LEN of the oldest layout, _LEN of the current one with all group
+ * entries) and group sizes
+ *
+ */
+#define MSG_ID_PING 0x01
+#define MSG_ID_UPD_BEGIN 0x10
+#define MSG_UPD_BEGIN_MIN_LEN 8
+#define MSG_UPD_BEGIN_LEN 8
+#define MSG_ID_UPD_DATA 0x11
+#define MSG_UPD_DATA_MIN_LEN 4
+#define MSG_UPD_DATA_LEN 4
+#define MSG_ID_UPD_COMMIT 0x12
+#define MSG_UPD_COMMIT_MIN_LEN 0
+#define MSG_UPD_COMMIT_LEN 0
+#define MSG_ID_UPD_STATUS 0x13
+#define MSG_UPD_STATUS_MIN_LEN 0
+#define MSG_UPD_STATUS_LEN 0
+#define MSG_ID_TSY_REQ 0x14
+#define MSG_TSY_REQ_MIN_LEN 1
+#define MSG_TSY_REQ_LEN 1
+#define MSG_ID_SUB 0x15
+#define MSG_SUB_MIN_LEN 6
+#define MSG_SUB_LEN 6
+#define MSG_ID_STP_CTRL 0x16
+#define MSG_STP_CTRL_MIN_LEN 5
+#define MSG_STP_CTRL_LEN 5
+#define MSG_ID_STP 0x17
+#define MSG_STP_MIN_LEN 6
+#define MSG_STP_LEN 22
+#define MSG_STP_TARGETS_MAX 8
+#define MSG_STP_TARGET_LEN 2
+#define MSG_ID_CFG_SET 0x18
+#define MSG_CFG_SET_MIN_LEN 0
+#define MSG_CFG_SET_LEN 32
+#define MSG_CFG_SET_VALUES_MAX 16
+#define MSG_CFG_SET_VALUE_LEN 2
+#define MSG_ID_PONG 0x81
+#define MSG_ID_LINK_STATS 0x82
+#define MSG_LINK_STATS_MIN_LEN 36
+#define MSG_LINK_STATS_LEN 36
+#define MSG_ID_RTM 0x83
+#define MSG_RTM_MIN_LEN 4
+#define MSG_RTM_LEN 64
+#define MSG_RTM_SLOTS_MAX 10
+#define MSG_RTM_SLOT_LEN 6
+#define MSG_ID_SIGNALS 0x85
+#define MSG_SIGNALS_MIN_LEN 4
+#define MSG_SIGNALS_LEN 4
+#define MSG_ID_TSY_RESP 0x94
+#define MSG_TSY_RESP_MIN_LEN 17
+#define MSG_TSY_RESP_LEN 17
+#define MSG_ID_TSY_STATS 0x95
+#define MSG_TSY_STATS_MIN_LEN 36
+#define MSG_TSY_STATS_LEN 36
+#define MSG_ID_SUB_STATE 0x96
+#define MSG_SUB_STATE_MIN_LEN 15
+#define MSG_SUB_STATE_LEN 15
+#define MSG_ID_STP_STATS 0x97
+#define MSG_STP_STATS_MIN_LEN 49
+#define MSG_STP_STATS_LEN 49
+#define MSG_ID_CFG 0x98
+#define MSG_CFG_MIN_LEN 0
+#define MSG_CFG_LEN 32
+#define MSG_CFG_VALUES_MAX 16
+#define MSG_CFG_VALUE_LEN 2
+#define MSG_ID_OS_STATS 0x99
+#define MSG_OS_STATS_MIN_LEN 23
+#define MSG_OS_STATS_LEN 233
+#define MSG_OS_STATS_TASKS_MAX 15
+#define MSG_OS_STATS_TASK_LEN 14
+#define MSG_ID_TRACE 0x9A
+#define MSG_TRACE_MIN_LEN 5
+#define MSG_TRACE_LEN 237
+#define MSG_TRACE_RECORDS_MAX 29
+#define MSG_TRACE_RECORD_LEN 8
+#define MSG_ID_TRACE_TASKS 0x9B
+#define MSG_TRACE_TASKS_MIN_LEN 1
+#define MSG_TRACE_TASKS_LEN 145
+#define MSG_TRACE_TASKS_TASKS_MAX 16
+#define MSG_TRACE_TASKS_TASK_LEN 9
+#define MSG_ID_ERR_STATS 0x9C
+#define MSG_ERR_STATS_MIN_LEN 4
+#define MSG_ERR_STATS_LEN 140
+#define MSG_ERR_STATS_SOURCES_MAX 8
+#define MSG_ERR_STATS_SOURCE_LEN 17
+
+/**
+ * @brief Configuration parameters, the index of their value in CFG_SET and CFG
+ *
+ */
+typedef enum
+{
+  MSG_PARAM_SNS1_THRESHOLD = 0, /* Activation threshold of sensor 1, ADC counts 0..4095 */
+  MSG_PARAM_SNS2_THRESHOLD,     /* Activation threshold of sensor 2, ADC counts 0..4095 */
+  MSG_PARAM_SRV1_RANGE,         /* Travel of servo 1 above its minimum angle, degrees */
+  MSG_PARAM_SRV2_RANGE,         /* Travel of servo 2 above its minimum angle, degrees */
+  MSG_PARAM_SRV3_RANGE,         /* Travel of servo 3 above its minimum angle, degrees */
+  MSG_PARAM_OS_STATS_PERIOD,    /* How often OS_STATS is sent, milliseconds 100..60000, 0 - off */
+  MSG_PARAM_TRACE_EVENTS,       /* Events the tracer records and sends in TRACE, trc_EventMask_e bits, 0 - off */
+  MSG_PARAM_COUNT
+} msg_Param_e;
+
+/**************************************************************************
+ * Structures
+ **************************************************************************/
+
+/**
+ * @brief UPD_BEGIN (host -> device): Start or resume a firmware update
+ *
+ */
+typedef struct
+{
+  uint32_t size_u32; /* Size of the new image in bytes */
+  uint32_t crc_u32;  /* CRC-32 of the new image */
+} msg_s_UpdBegin_t;
+
+/**
+ * @brief UPD_DATA (host -> device): Next chunk of the new firmware
+ *
+ */
+typedef struct
+{
+  uint32_t offset_u32;     /* Offset of the chunk in the image */
+  const uint8_t *data_pu8; /* The chunk, an even number of bytes */
+  uint8_t dataLen_u8;      /* Length of data */
+} msg_s_UpdData_t;
+
+/**
+ * @brief TSY_REQ (either way): Time sync request, answered with TSY_RESP
+ *
+ */
+typedef struct
+{
+  uint8_t tag_u8; /* Tells the reply apart from a late reply to an earlier request */
+} msg_s_TsyReq_t;
+
+/**
+ * @brief SUB (host -> device): Subscribe to a telemetry signal, answered with SUB_STATE
+ *
+ */
+typedef struct
+{
+  uint8_t signal_u8;      /* tlm_Signal_e, 0xFF for all of them */
+  uint8_t mode_u8;        /* tlm_SubMode_e, 0xFF to only ask for the state */
+  uint16_t periodMs_u16;  /* How often the signal is sampled, rounded up to the telemetry task period */
+  uint16_t threshold_u16; /* On change: how far a channel has to move from the last sent value */
+} msg_s_Sub_t;
+
+/**
+ * @brief STP_CTRL (host -> device): Hand the servos to the setpoint stream or back to the local inputs, answered with STP_STATS
+ *
+ */
+typedef struct
+{
+  uint8_t mode_u8;        /* stp_Mode_e, 0xFF to only ask for the state */
+  uint16_t delayUs_u16;   /* Jitter buffer: how long after it was sent a setpoint is applied, 0 for the default */
+  uint16_t timeoutMs_u16; /* Watchdog: without setpoints for this long the hand goes to the safe posture, 0 for the default */
+} msg_s_StpCtrl_t;
+
+/**
+ * @brief One entry of STP
+ *
+ */
+typedef struct
+{
+  uint16_t position_u16; /* 0 (open, minimum angle)..10000 (maximum angle), in 0.01% */
+} msg_s_StpTarget_t;
+
+/**
+ * @brief STP (host -> device): One setpoint of the stream, one entry per servo from the first one on
+ *
+ */
+typedef struct
+{
+  uint32_t hostUs_u32;                              /* Host time the setpoint was sent at (or is meant for), microseconds */
+  uint16_t seq_u16;                                 /* Counted up with every setpoint, older or repeated ones are dropped */
+  uint8_t targetsCount_u8;                          /* Entries in targets_s */
+  msg_s_StpTarget_t targets_s[MSG_STP_TARGETS_MAX]; /* Entries */
+} msg_s_Stp_t;
+
+/**
+ * @brief One entry of CFG_SET
+ *
+ */
+typedef struct
+{
+  uint16_t value_u16; /* New value of the parameter with this index (cfg_Param_e), 0xFFFF leaves it as it is */
+} msg_s_CfgSetValue_t;
+
+/**
+ * @brief CFG_SET (host -> device): Change configuration parameters, answered with CFG. Also the value written to the BLE config characteristic
+ *
+ */
+typedef struct
+{
+  uint8_t valuesCount_u8;                               /* Entries in values_s */
+  msg_s_CfgSetValue_t values_s[MSG_CFG_SET_VALUES_MAX]; /* Entries */
+} msg_s_CfgSet_t;
+
+/**
+ * @brief LINK_STATS (device -> host): Telemetry link statistics
+ *
+ */
+typedef struct
+{
+  uint32_t timeUs_u32;        /* Device time */
+  uint32_t txBytes_u32;       /* Bytes written to the UART */
+  uint32_t txFrames_u32;      /* Frames written to the UART */
+  uint32_t txDropped_u32;     /* Frames dropped because the TX buffer was full */
+  uint32_t rxFrames_u32;      /* Valid frames received */
+  uint32_t rxErrors_u32;      /* Frames received with a bad CRC or length */
+  uint32_t txBytesPerSec_u32; /* Throughput over the last second */
+  uint32_t maxWriteUs_u32;    /* Longest time spent queueing a frame */
+  uint32_t maxBacklogUs_u32;  /* Longest time a byte waited in the TX buffer */
+} msg_s_LinkStats_t;
+
+/**
+ * @brief One entry of RTM
+ *
+ */
+typedef struct
+{
+  uint16_t currentUs_u16; /* Runtime of the last cycle */
+  uint16_t minUs_u16;     /* Shortest runtime */
+  uint16_t maxUs_u16;     /* Longest runtime */
+} msg_s_RtmSlot_t;
+
+/**
+ * @brief RTM (device -> host): Runtime measurement of the scheduler slots
+ *
+ */
+typedef struct
+{
+  uint32_t timeUs_u32;                        /* Device time */
+  uint8_t slotsCount_u8;                      /* Entries in slots_s */
+  msg_s_RtmSlot_t slots_s[MSG_RTM_SLOTS_MAX]; /* Entries */
+} msg_s_Rtm_t;
+
+/**
+ * @brief SIGNALS (device -> host): Samples of the subscribed signals that were due
+ *
+ */
+typedef struct
+{
+  uint32_t timeUs_u32;        /* Device time */
+  const uint8_t *records_pu8; /* Per signal: tlm_Signal_e u8, channel count u8, then a u16 per channel */
+  uint8_t recordsLen_u8;      /* Length of records */
+} msg_s_Signals_t;
+
+/**
+ * @brief TSY_RESP (either way): Time sync reply, dated by the last byte of both frames
+ *
+ */
+typedef struct
+{
+  uint8_t tag_u8;    /* Tag of the request */
+  uint64_t rxUs_u64; /* When the last byte of the request arrived */
+  uint64_t txUs_u64; /* When the last byte of this reply leaves */
+} msg_s_TsyResp_t;
+
+/**
+ * @brief TSY_STATS (STM32 -> ESP32): Clock model of the STM32 against the ESP32 clock
+ *
+ */
+typedef struct
+{
+  uint64_t refUs_u64;   /* STM32 time of the exchange the model is based on */
+  int64_t offsetUs_s64; /* ESP32 time minus STM32 time at refUs */
+  int32_t driftPpb_s32; /* How much faster the ESP32 clock runs, parts per billion */
+  uint32_t rttUs_u32;   /* Round trip of that exchange */
+  uint32_t errorUs_u32; /* Error bound of the model */
+  uint32_t samples_u32; /* Windows that had a usable exchange */
+  uint32_t lost_u32;    /* Requests without a usable reply */
+} msg_s_TsyStats_t;
+
+/**
+ * @brief SUB_STATE (device -> host): Subscription of one signal and what it costs, the reply to SUB and sent every second while subscribed
+ *
+ */
+typedef struct
+{
+  uint8_t signal_u8;        /* tlm_Signal_e */
+  uint8_t mode_u8;          /* tlm_SubMode_e */
+  uint16_t periodMs_u16;    /* Sampling period in effect */
+  uint16_t threshold_u16;   /* On change threshold */
+  uint8_t channels_u8;      /* Values per sample */
+  uint32_t bytesPerSec_u32; /* Link bandwidth the signal used over the last second */
+  uint32_t dropped_u32;     /* Samples dropped because the TX buffer was full */
+} msg_s_SubState_t;
+
+/**
+ * @brief STP_STATS (device -> host): State of the setpoint stream, the reply to STP_CTRL and sent every second while streaming
+ *
+ */
+typedef struct
+{
+  uint8_t mode_u8;           /* stp_Mode_e */
+  uint8_t state_u8;          /* stp_State_e */
+  uint8_t depth_u8;          /* Setpoints waiting in the jitter buffer */
+  uint16_t delayUs_u16;      /* Jitter buffer delay in effect */
+  uint16_t timeoutMs_u16;    /* Watchdog timeout in effect */
+  uint32_t received_u32;     /* Setpoints received */
+  uint32_t late_u32;         /* Setpoints that arrived after they were due, applied right away */
+  uint32_t dropped_u32;      /* Setpoints dropped because they were out of order or the jitter buffer was full */
+  uint32_t holds_u32;        /* Servo cycles without a new setpoint, the last one was held */
+  uint32_t timeouts_u32;     /* Times the watchdog sent the hand to the safe posture */
+  uint16_t lastSeq_u16;      /* seq of the setpoint applied last */
+  uint32_t lastHostUs_u32;   /* hostUs of the setpoint applied last */
+  uint32_t dwellUs_u32;      /* Time from receiving that setpoint until this frame was queued, round trip = host receive time - lastHostUs - dwellUs */
+  uint32_t jitterUs_u32;     /* Spread of the one-way transit time over the last second */
+  uint32_t minLatencyUs_u32; /* Shortest time from receiving a setpoint until it was applied, over the last second */
+  uint32_t maxLatencyUs_u32; /* Longest time from receiving a setpoint until it was applied, over the last second */
+} msg_s_StpStats_t;
+
+/**
+ * @brief One entry of CFG
+ *
+ */
+typedef struct
+{
+  uint16_t value_u16; /* Value of the parameter with this index (cfg_Param_e) */
+} msg_s_CfgValue_t;
+
+/**
+ * @brief CFG (device -> host): All configuration parameters, the reply to CFG_SET. Also the value read from the BLE config characteristic
+ *
+ */
+typedef struct
+{
+  uint8_t valuesCount_u8;                        /* Entries in values_s */
+  msg_s_CfgValue_t values_s[MSG_CFG_VALUES_MAX]; /* Entries */
+} msg_s_Cfg_t;
+
+/**
+ * @brief One entry of OS_STATS
+ *
+ */
+typedef struct
+{
+  uint64_t name_u64;      /* First 8 characters of the task name, zero padded, first character in the low byte */
+  uint8_t core_u8;        /* Core the task is pinned to, 0xFF if it runs on either */
+  uint8_t priority_u8;    /* Current priority */
+  uint16_t stackFree_u16; /* Least stack the task ever had left, bytes */
+  uint16_t load_u16;      /* Time the task ran over the window, in 0.01% of one core */
+} msg_s_OsStatsTask_t;
+
+/**
+ * @brief OS_STATS (device -> host): FreeRTOS load, stack and heap usage, sent every CFG_OS_STATS_PERIOD ms
+ *
+ */
+typedef struct
+{
+  uint32_t timeUs_u32;                                 /* Device time */
+  uint32_t windowUs_u32;                               /* Run time the CPU loads cover, since the previous OS_STATS */
+  uint32_t heapFree_u32;                               /* Free heap now, bytes */
+  uint32_t heapMinFree_u32;                            /* Least free heap since boot, bytes */
+  uint16_t idle0_u16;                                  /* Idle time of core 0 over the window, in 0.01% */
+  uint16_t idle1_u16;                                  /* Idle time of core 1 over the window, in 0.01% */
+  uint16_t collectUs_u16;                              /* How long collecting these stats took */
+  uint8_t taskCount_u8;                                /* Tasks in the system, entries are only sent for the first ones that fit */
+  uint8_t tasksCount_u8;                               /* Entries in tasks_s */
+  msg_s_OsStatsTask_t tasks_s[MSG_OS_STATS_TASKS_MAX]; /* Entries */
+} msg_s_OsStats_t;
+
+/**
+ * @brief One entry of TRACE
+ *
+ */
+typedef struct
+{
+  uint32_t timeUs_u32; /* Device time */
+  uint8_t type_u8;     /* What happened, trc_Event_e */
+  uint8_t id_u8;       /* Slot, interrupt source, task index (see TRACE_TASKS) or marker */
+  uint16_t arg_u16;    /* Depends on the marker, 0 otherwise */
+} msg_s_TraceRecord_t;
+
+/**
+ * @brief TRACE (device -> host): Events recorded on one core (drivers/trc), in the order they happened, while CFG_TRACE_EVENTS isn't 0
+ *
+ */
+typedef struct
+{
+  uint8_t core_u8;                                      /* Core the events happened on */
+  uint32_t lost_u32;                                    /* Events of this core that found its ring buffer full, since boot */
+  uint8_t recordsCount_u8;                              /* Entries in records_s */
+  msg_s_TraceRecord_t records_s[MSG_TRACE_RECORDS_MAX]; /* Entries */
+} msg_s_Trace_t;
+
+/**
+ * @brief One entry of TRACE_TASKS
+ *
+ */
+typedef struct
+{
+  uint8_t index_u8;  /* Task index of the task switch events */
+  uint64_t name_u64; /* First 8 characters of the task name, zero padded, first character in the low byte */
+} msg_s_TraceTasksTask_t;
+
+/**
+ * @brief TRACE_TASKS (device -> host): Names of the task indexes in the task switch events of one core, every second while tracing
+ *
+ */
+typedef struct
+{
+  uint8_t core_u8;                                           /* Core the indexes belong to */
+  uint8_t tasksCount_u8;                                     /* Entries in tasks_s */
+  msg_s_TraceTasksTask_t tasks_s[MSG_TRACE_TASKS_TASKS_MAX]; /* Entries */
+} msg_s_TraceTasks_t;
+
+/**
+ * @brief One entry of ERR_STATS
+ *
+ */
+typedef struct
+{
+  uint32_t errors_u32;   /* Driver calls of this err_Source_e that returned an error, retries included */
+  uint32_t retries_u32;  /* Driver calls repeated after an error */
+  uint32_t failures_u32; /* Driver calls that still failed after their retries */
+  int32_t lastError_s32; /* Last esp_err_t returned, 0 if none */
+  uint8_t degraded_u8;   /* 1 while the source is degraded, a degraded POT or SNS sends the servos to the open posture */
+} msg_s_ErrStatsSource_t;
+
+/**
+ * @brief ERR_STATS (device -> host): Runtime driver errors (drivers/err), sent every second
+ *
+ */
+typedef struct
+{
+  uint32_t timeUs_u32;                                         /* Device time */
+  uint8_t sourcesCount_u8;                                     /* Entries in sources_s */
+  msg_s_ErrStatsSource_t sources_s[MSG_ERR_STATS_SOURCES_MAX]; /* Entries */
+} msg_s_ErrStats_t;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern uint8_t msg_f_PackUpdBegin_u8(uint8_t *buf, const msg_s_UpdBegin_t *msg);
+extern uint8_t msg_f_UnpackUpdBegin_u8(msg_s_UpdBegin_t *msg, const uint8_t *buf, uint8_t len);
+extern uint8_t msg_f_PackUpdData_u8(uint8_t *buf, const msg_s_UpdData_t *msg);
+extern uint8_t msg_f_UnpackUpdData_u8(msg_s_UpdData_t *msg, const uint8_t *buf, uint8_t len);
+extern uint8_t msg_f_PackTsyReq_u8(uint8_t *buf, const msg_s_TsyReq_t *msg);
+extern uint8_t msg_f_UnpackTsyReq_u8(msg_s_TsyReq_t *msg, const uint8_t *buf, uint8_t len);
+extern uint8_t msg_f_PackSub_u8(uint8_t *buf, const msg_s_Sub_t *msg);
+extern uint8_t msg_f_UnpackSub_u8(msg_s_Sub_t *msg, const uint8_t *buf, uint8_t len);
+extern uint8_t msg_f_PackStpCtrl_u8(uint8_t *buf, const msg_s_StpCtrl_t *msg);
+extern uint8_t msg_f_UnpackStpCtrl_u8(msg_s_StpCtrl_t *msg, const uint8_t *buf, uint8_t len);
+extern uint8_t msg_f_PackStp_u8(uint8_t *buf, const msg_s_Stp_t *msg);
+extern uint8_t msg_f_UnpackStp_u8(msg_s_Stp_t *msg, const uint8_t *buf, uint8_t len);
+extern uint8_t msg_f_PackCfgSet_u8(uint8_t *buf, const msg_s_CfgSet_t *msg);
+extern uint8_t msg_f_UnpackCfgSet_u8(msg_s_CfgSet_t *msg, const uint8_t *buf, uint8_t len);
+extern uint8_t msg_f_PackLinkStats_u8(uint8_t *buf, const msg_s_LinkStats_t *msg);
+extern uint8_t msg_f_UnpackLinkStats_u8(msg_s_LinkStats_t *msg, const uint8_t *buf, uint8_t len);
+extern uint8_t msg_f_PackRtm_u8(uint8_t *buf, const msg_s_Rtm_t *msg);
+extern uint8_t msg_f_UnpackRtm_u8(msg_s_Rtm_t *msg, const uint8_t *buf, uint8_t len);
+extern uint8_t msg_f_PackSignals_u8(uint8_t *buf, const msg_s_Signals_t *msg);
+extern uint8_t msg_f_UnpackSignals_u8(msg_s_Signals_t *msg, const uint8_t *buf, uint8_t len);
+extern uint8_t msg_f_PackTsyResp_u8(uint8_t *buf, const msg_s_TsyResp_t *msg);
+extern uint8_t msg_f_UnpackTsyResp_u8(msg_s_TsyResp_t *msg, const uint8_t *buf, uint8_t len);
+extern uint8_t msg_f_PackTsyStats_u8(uint8_t *buf, const msg_s_TsyStats_t *msg);
+extern uint8_t msg_f_UnpackTsyStats_u8(msg_s_TsyStats_t *msg, const uint8_t *buf, uint8_t len);
+extern uint8_t msg_f_PackSubState_u8(uint8_t *buf, const msg_s_SubState_t *msg);
+extern uint8_t msg_f_UnpackSubState_u8(msg_s_SubState_t *msg, const uint8_t *buf, uint8_t len);
+extern uint8_t msg_f_PackStpStats_u8(uint8_t *buf, const msg_s_StpStats_t *msg);
+extern uint8_t msg_f_UnpackStpStats_u8(msg_s_StpStats_t *msg, const uint8_t *buf, uint8_t len);
+extern uint8_t msg_f_PackCfg_u8(uint8_t *buf, const msg_s_Cfg_t *msg);
+extern uint8_t msg_f_UnpackCfg_u8(msg_s_Cfg_t *msg, const uint8_t *buf, uint8_t len);
+extern uint8_t msg_f_PackOsStats_u8(uint8_t *buf, const msg_s_OsStats_t *msg);
+extern uint8_t msg_f_UnpackOsStats_u8(msg_s_OsStats_t *msg, const uint8_t *buf, uint8_t len);
+extern uint8_t msg_f_PackTrace_u8(uint8_t *buf, const msg_s_Trace_t *msg);
+extern uint8_t msg_f_UnpackTrace_u8(msg_s_Trace_t *msg, const uint8_t *buf, uint8_t len);
+extern uint8_t msg_f_PackTraceTasks_u8(uint8_t *buf, const msg_s_TraceTasks_t *msg);
+extern uint8_t msg_f_UnpackTraceTasks_u8(msg_s_TraceTasks_t *msg, const uint8_t *buf, uint8_t len);
+extern uint8_t msg_f_PackErrStats_u8(uint8_t *buf, const msg_s_ErrStats_t *msg);
+extern uint8_t msg_f_UnpackErrStats_u8(msg_s_ErrStats_t *msg, const uint8_t *buf, uint8_t len);
+
+#endif // MSG_E_H
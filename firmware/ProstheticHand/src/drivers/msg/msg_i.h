@@ -0,0 +1,37 @@
+/**
+ * @file msg_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding msg.c
+ *
+ * Generated from firmware/msg/messages.py by firmware/msg/msggen.py, do not edit
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef MSG_I_H
+#define MSG_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "msg_e.h"
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern uint8_t msg_f_PutU16_u8(uint8_t *buf, uint8_t idx, uint16_t val);
+extern uint8_t msg_f_PutU32_u8(uint8_t *buf, uint8_t idx, uint32_t val);
+extern uint8_t msg_f_PutU64_u8(uint8_t *buf, uint8_t idx, uint64_t val);
+extern uint16_t msg_f_GetU16_u16(const uint8_t *buf);
+extern uint32_t msg_f_GetU32_u32(const uint8_t *buf);
+extern uint64_t msg_f_GetU64_u64(const uint8_t *buf);
+
+#endif // MSG_I_H
@@ -0,0 +1,261 @@
+/**
+ * @file osm.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief OS monitor software component
+ *
+ * Collects what FreeRTOS knows about its tasks, for the OS_STATS telemetry frame: how long every task ran
+ * since the last collection, the least stack it ever had left, the idle time of both cores and the free heap.
+ * The RTM frame only covers the 1ms slots of the main OS, this shows what runs next to it (telemetry, BLE,
+ * the supervisor timer) and how close any task is to overflowing its stack.
+ *
+ * The run time counters come from esp_timer (CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS and
+ * CONFIG_FREERTOS_USE_TRACE_FACILITY in the sdkconfig), so loads are in real time. Core 1 shows almost no idle
+ * time, as the main OS polls its slots instead of blocking; its own load is in RTM.
+ *
+ * Collected from the telemetry task every CFG_OS_STATS_PERIOD ms, only compiled in when TELEMETRY is defined
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "osm_e.h"
+#include "osm_i.h"
+
+#ifdef TELEMETRY
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Statistics collected last, as sent in OS_STATS
+ *
+ */
+msg_s_OsStats_t osm_g_Stats_s;
+
+/**
+ * @brief How often OS_STATS is sent
+ *
+ * @values in milliseconds, 0 - off, OSM_PERIOD_MIN_MS..OSM_PERIOD_MAX_MS
+ */
+uint16_t osm_g_PeriodMs_u16 = OSM_PERIOD_DEFAULT_MS;
+
+/**
+ * @brief State of every task as FreeRTOS reports it, and how much of the window each one ran
+ *
+ * Static, far too large for the stack of the telemetry task
+ */
+TaskStatus_t osm_g_Tasks_s[OSM_MAX_TASKS];
+uint16_t osm_g_Load_u16[OSM_MAX_TASKS];
+
+/**
+ * @brief Run time counters at the last collection
+ *
+ */
+osm_s_Prev_t osm_g_Prev_s[OSM_MAX_TASKS];
+uint8_t osm_g_PrevCount_u8 = 0;
+uint32_t osm_g_PrevTotal_u32 = 0;
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+uint8_t osm_f_Pack_u8(uint8_t *buf);
+uint16_t osm_f_GetPeriod_u16(void);
+uint8_t osm_f_SetPeriod_u8(uint16_t periodMs);
+
+void osm_f_Collect_v(void);
+uint32_t osm_f_RanSince_u32(const TaskStatus_t *task);
+
+#ifdef SERIAL_DEBUG
+void osm_f_SerialDebug_v(void);
+#endif
+
+/**
+ * @brief Collect the statistics and write them into a payload
+ *
+ * Payload: OS_STATS, see firmware/msg/messages.py. The window starts where the previous call ended,
+ * the first one covers the time since boot
+ *
+ * @param buf room for MSG_OS_STATS_LEN bytes
+ * @return payload length
+ */
+uint8_t osm_f_Pack_u8(uint8_t *buf)
+{
+  osm_f_Collect_v();
+  return msg_f_PackOsStats_u8(buf, &osm_g_Stats_s);
+}
+
+/**
+ * @brief How often OS_STATS is sent, CFG_OS_STATS_PERIOD
+ *
+ * @return period in milliseconds, 0 if the statistics are off
+ */
+uint16_t osm_f_GetPeriod_u16(void)
+{
+  return osm_g_PeriodMs_u16;
+}
+
+/**
+ * @brief Change how often OS_STATS is sent
+ *
+ * @param periodMs new period in milliseconds, 0 turns the statistics off
+ * @return 1 if it was changed, 0 if it is out of range
+ */
+uint8_t osm_f_SetPeriod_u8(uint16_t periodMs)
+{
+  if ((periodMs != 0) && ((periodMs < OSM_PERIOD_MIN_MS) || (periodMs > OSM_PERIOD_MAX_MS)))
+  {
+    return 0;
+  }
+
+  osm_g_PeriodMs_u16 = periodMs;
+  return 1;
+}
+
+/**
+ * @brief Take a snapshot of every task and turn it into osm_g_Stats_s
+ *
+ * The tasks are sent by their load, highest first, so the ones that don't fit into the frame are the idle ones
+ *
+ * @return void
+ */
+void osm_f_Collect_v(void)
+{
+  uint64_t l_startUs_u64 = esp_timer_get_time();
+  uint32_t l_total_u32 = 0;
+  uint32_t l_windowUs_u32;
+  uint32_t l_value_u32;
+  UBaseType_t l_count_u32;
+  TaskHandle_t l_idle_ps[2];
+  TaskStatus_t *l_task_ps;
+  msg_s_OsStatsTask_t *l_entry_ps;
+  uint8_t l_best_u8;
+  uint8_t i, j;
+
+  l_count_u32 = uxTaskGetSystemState(osm_g_Tasks_s, OSM_MAX_TASKS, &l_total_u32);
+  if (l_count_u32 == 0)
+  {
+    /* More tasks than OSM_MAX_TASKS, the next window that works starts where the last one ended */
+    l_total_u32 = osm_g_PrevTotal_u32;
+  }
+
+  l_windowUs_u32 = l_total_u32 - osm_g_PrevTotal_u32;
+
+  l_idle_ps[0] = xTaskGetIdleTaskHandleForCPU(0);
+  l_idle_ps[1] = xTaskGetIdleTaskHandleForCPU(1);
+  osm_g_Stats_s.idle0_u16 = 0;
+  osm_g_Stats_s.idle1_u16 = 0;
+
+  for (i = 0; i < l_count_u32; i++)
+  {
+    l_value_u32 = (l_windowUs_u32 == 0) ? 0 : (uint32_t)(((uint64_t)osm_f_RanSince_u32(&osm_g_Tasks_s[i]) * 10000) / l_windowUs_u32);
+    osm_g_Load_u16[i] = (l_value_u32 > 10000) ? 10000 : (uint16_t)l_value_u32;
+
+    if (osm_g_Tasks_s[i].xHandle == l_idle_ps[0])
+    {
+      osm_g_Stats_s.idle0_u16 = osm_g_Load_u16[i];
+    }
+    else if (osm_g_Tasks_s[i].xHandle == l_idle_ps[1])
+    {
+      osm_g_Stats_s.idle1_u16 = osm_g_Load_u16[i];
+    }
+  }
+
+  /* Counters for the next window, only after all the loads are known */
+  for (i = 0; i < l_count_u32; i++)
+  {
+    osm_g_Prev_s[i].number_u32 = osm_g_Tasks_s[i].xTaskNumber;
+    osm_g_Prev_s[i].runTime_u32 = osm_g_Tasks_s[i].ulRunTimeCounter;
+  }
+  if (l_count_u32 > 0)
+  {
+    osm_g_PrevCount_u8 = (uint8_t)l_count_u32;
+    osm_g_PrevTotal_u32 = l_total_u32;
+  }
+
+  /* Highest load first, each pick marks its task with a load above 10000 so it isn't picked again */
+  for (i = 0; (i < l_count_u32) && (i < MSG_OS_STATS_TASKS_MAX); i++)
+  {
+    l_best_u8 = 0xFF;
+    for (j = 0; j < l_count_u32; j++)
+    {
+      if ((osm_g_Load_u16[j] <= 10000) && ((l_best_u8 == 0xFF) || (osm_g_Load_u16[j] > osm_g_Load_u16[l_best_u8])))
+      {
+        l_best_u8 = j;
+      }
+    }
+
+    l_task_ps = &osm_g_Tasks_s[l_best_u8];
+    l_entry_ps = &osm_g_Stats_s.tasks_s[i];
+
+    l_entry_ps->name_u64 = 0;
+    for (j = 0; (j < 8) && (l_task_ps->pcTaskName[j] != '\0'); j++)
+    {
+      l_entry_ps->name_u64 |= (uint64_t)(uint8_t)l_task_ps->pcTaskName[j] << (8 * j);
+    }
+    l_value_u32 = (uint32_t)xTaskGetAffinity(l_task_ps->xHandle);
+    l_entry_ps->core_u8 = (l_value_u32 < configNUM_CORES) ? (uint8_t)l_value_u32 : 0xFF;
+    l_entry_ps->priority_u8 = (uint8_t)l_task_ps->uxCurrentPriority;
+    /* StackType_t is a byte on the ESP32, so the high water mark already is in bytes */
+    l_value_u32 = (uint32_t)l_task_ps->usStackHighWaterMark;
+    l_entry_ps->stackFree_u16 = (l_value_u32 > UINT16_MAX) ? UINT16_MAX : (uint16_t)l_value_u32;
+    l_entry_ps->load_u16 = osm_g_Load_u16[l_best_u8];
+
+    osm_g_Load_u16[l_best_u8] = UINT16_MAX;
+  }
+  osm_g_Stats_s.tasksCount_u8 = i;
+
+  osm_g_Stats_s.timeUs_u32 = (uint32_t)l_startUs_u64;
+  osm_g_Stats_s.windowUs_u32 = l_windowUs_u32;
+  osm_g_Stats_s.heapFree_u32 = esp_get_free_heap_size();
+  osm_g_Stats_s.heapMinFree_u32 = esp_get_minimum_free_heap_size();
+  osm_g_Stats_s.taskCount_u8 = (uint8_t)uxTaskGetNumberOfTasks();
+
+  l_value_u32 = (uint32_t)(esp_timer_get_time() - l_startUs_u64);
+  osm_g_Stats_s.collectUs_u16 = (l_value_u32 > UINT16_MAX) ? UINT16_MAX : (uint16_t)l_value_u32;
+}
+
+/**
+ * @brief How long a task ran since the last collection
+ *
+ * @param task as reported now
+ * @return run time in microseconds, all of it for a task created since
+ */
+uint32_t osm_f_RanSince_u32(const TaskStatus_t *task)
+{
+  uint8_t i;
+
+  for (i = 0; i < osm_g_PrevCount_u8; i++)
+  {
+    if (osm_g_Prev_s[i].number_u32 == task->xTaskNumber)
+    {
+      return task->ulRunTimeCounter - osm_g_Prev_s[i].runTime_u32;
+    }
+  }
+
+  return task->ulRunTimeCounter;
+}
+
+#ifdef SERIAL_DEBUG
+void osm_f_SerialDebug_v(void)
+{
+  ESP_LOGD(OSM_TAG, "idle core 0 = %u.%02u%%, core 1 = %u.%02u%%, heap free = %lu (min %lu), %u tasks, collected in %u us",
+           osm_g_Stats_s.idle0_u16 / 100, osm_g_Stats_s.idle0_u16 % 100,
+           osm_g_Stats_s.idle1_u16 / 100, osm_g_Stats_s.idle1_u16 % 100,
+           osm_g_Stats_s.heapFree_u32, osm_g_Stats_s.heapMinFree_u32,
+           osm_g_Stats_s.taskCount_u8, osm_g_Stats_s.collectUs_u16);
+}
+#endif
+
+#endif // TELEMETRY
@@ -0,0 +1,55 @@
+/**
+ * @file osm_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding osm.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef OSM_E_H
+#define OSM_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "config/project.h"
+#include "drivers/msg/msg_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+#define OSM_TAG "OSM"
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Statistics collected last, as sent in OS_STATS
+ *
+ */
+extern msg_s_OsStats_t osm_g_Stats_s;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern uint8_t osm_f_Pack_u8(uint8_t *buf);
+extern uint16_t osm_f_GetPeriod_u16(void);
+extern uint8_t osm_f_SetPeriod_u8(uint16_t periodMs);
+
+#ifdef SERIAL_DEBUG
+extern void osm_f_SerialDebug_v(void);
+#endif
+
+#endif // OSM_E_H
@@ -0,0 +1,62 @@
+/**
+ * @file osm_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding osm.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef OSM_I_H
+#define OSM_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "osm_e.h"
+#include "esp_system.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Most tasks the statistics are collected for
+ *
+ * uxTaskGetSystemState() gives nothing at all if there are more tasks than this, OS_STATS then only has the heap.
+ * There are about 15 with telemetry and BLE (both idle tasks, esp_timer, ipc, NimBLE, the ones of this program)
+ *
+ * @values each one costs about 50 bytes of RAM
+ */
+#define OSM_MAX_TASKS 32
+
+/**
+ * @brief How often OS_STATS is sent after boot, and the range CFG_OS_STATS_PERIOD accepts
+ *
+ * Collecting suspends the scheduler for a few tens of microseconds per task, the minimum keeps that well below 0.1%
+ *
+ * @values in milliseconds, rounded up to the telemetry task period, 0 turns the statistics off
+ */
+#define OSM_PERIOD_DEFAULT_MS 1000
+#define OSM_PERIOD_MIN_MS 100
+#define OSM_PERIOD_MAX_MS 60000
+
+/**
+ * @brief Run time counter of a task at the last collection, to get how long it ran since
+ *
+ */
+typedef struct
+{
+  UBaseType_t number_u32;  /* xTaskNumber, unique for every task ever created */
+  uint32_t runTime_u32;    /* ulRunTimeCounter, microseconds */
+} osm_s_Prev_t;
+
+#endif // OSM_I_H
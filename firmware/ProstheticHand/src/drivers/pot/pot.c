@@ -23,6 +23,9 @@
 #include "pot_e.h"
 #include "pot_i.h"
 
+/* Other components used here */
+#include "drivers/err/err_e.h"
+
 /**************************************************************************
  * Global variables
  **************************************************************************/
@@ -35,11 +38,12 @@
 float32_t pot_g_PotValues_f32[POT_COUNT];
 
 /**
- * @brief Buffer for storing previous values of the potentiometers for filtering
+ * @brief Last POT_AVG_CNT readings of every potentiometer for filtering, and their storage
  *
  * @values See pot_g_PotConfig_s in pot_i.h
  */
-float32_t pot_g_PrevValues_f32[POT_COUNT][POT_AVG_CNT];
+blk_s_Block_t pot_g_Block_s;
+float32_t pot_g_Samples_f32[POT_COUNT][BLK_STRIDE(POT_AVG_CNT)] BLK_STORAGE_ATTR;
 
 /**
  * @brief Analog to digital converter channel
@@ -56,7 +60,7 @@ adc_oneshot_unit_handle_t *pot_g_AdcHandle_s;
 void pot_f_Init_v(void);
 void pot_f_Handle_v(void);
 
-float32_t pot_f_AnalogRead_f32(uint16_t potIndex);
+uint8_t pot_f_AnalogRead_u8(uint16_t potIndex, float32_t *value);
 
 #ifdef SERIAL_DEBUG
 void pot_f_SerialDebug_v(void);
@@ -71,7 +75,7 @@ void pot_f_SerialDebug_v(void);
  */
 void pot_f_Init_v(void)
 {
-  uint16_t i, j;
+  uint16_t i;
 
   /* Default configuration for all channels */
   adc_oneshot_chan_cfg_t channel_config = {
@@ -93,13 +97,7 @@ void pot_f_Init_v(void)
   }
 
   /* Set initial pot read value for filter */
-  for (i = 0; i < POT_COUNT; i++)
-  {
-    for (j = 0; j < POT_AVG_CNT; j++)
-    {
-      pot_g_PrevValues_f32[i][j] = 0;
-    }
-  }
+  blk_f_Init_v(&pot_g_Block_s, &pot_g_Samples_f32[0][0], POT_COUNT, POT_AVG_CNT);
 }
 
 /**
@@ -109,31 +107,24 @@ void pot_f_Init_v(void)
  *
  * @return void
  */
-void pot_f_Handle_v(void)
+void POT_IRAM_ATTR pot_f_Handle_v(void)
 {
-  uint16_t i, j;
-  float32_t sum = 0;
+  uint16_t i;
+  float32_t l_frame_f32[POT_COUNT];
 
   /* Go over all the channels to be read */
   for (i = 0; i < POT_COUNT; i++)
   {
-    /* Shift all values in buffer to the next place in the array */
-    for (j = POT_AVG_CNT - 1; j > 0; j--)
+    /* Read current pot value, a failed read repeats the last good value */
+    if (!pot_f_AnalogRead_u8(i, &l_frame_f32[i]))
     {
-      pot_g_PrevValues_f32[i][j] = pot_g_PrevValues_f32[i][j - 1];
+      l_frame_f32[i] = blk_f_Latest_f32(&pot_g_Block_s, i);
     }
-
-    /* Read current pot value: */
-    pot_g_PrevValues_f32[i][0] = pot_f_AnalogRead_f32(i);
-
-    /* Take the average of those readings */
-    sum = 0;
-    for (j = 0; j < POT_AVG_CNT; j++)
-    {
-      sum += pot_g_PrevValues_f32[i][j];
-    }
-    pot_g_PotValues_f32[i] = sum / POT_AVG_CNT;
   }
+
+  /* Take the average of those readings, for all the pots at once */
+  blk_f_Push_v(&pot_g_Block_s, l_frame_f32, (uint32_t)esp_timer_get_time());
+  blk_f_Mean_v(&pot_g_Block_s, pot_g_PotValues_f32);
 }
 
 #ifdef SERIAL_DEBUG
@@ -154,29 +145,36 @@ void pot_f_SerialDebug_v(void)
  * Read ADC value of pot, and scale it as in config in pot_i.h
  *
  * @param potIndex
- * @return One time scaled analog reading of given pin index as float32_t
+ * @param value one time scaled analog reading of given pin index, only written if the read worked
+ * @return 1 if the read worked, 0 if it failed even after its retries
  */
-float32_t pot_f_AnalogRead_f32(uint16_t potIndex)
+uint8_t POT_IRAM_ATTR pot_f_AnalogRead_u8(uint16_t potIndex, float32_t *value)
 {
-  uint16_t adcAnalogRead = 0;
+  int l_raw_s32 = 0;
+  esp_err_t l_err_s32;
+  adc_oneshot_unit_handle_t l_unit_s;
 
   /* Based on which ADC group this pin belongs to, read the corresponding group */
-  if (pot_g_PotConfig_s[potIndex].adc_unit_s == ADC_UNIT_1)
+  l_unit_s = (pot_g_PotConfig_s[potIndex].adc_unit_s == ADC_UNIT_1) ? main_g_AdcUnit1Handle_s : main_g_AdcUnit2Handle_s;
+
+  l_err_s32 = adc_oneshot_read(l_unit_s, pot_g_channel_s[potIndex], &l_raw_s32);
+  while (err_f_Retry_u8(ERR_SRC_POT, l_err_s32))
   {
-    ESP_ERROR_CHECK(adc_oneshot_read(main_g_AdcUnit1Handle_s, pot_g_channel_s[potIndex], (int *)&adcAnalogRead));
+    l_err_s32 = adc_oneshot_read(l_unit_s, pot_g_channel_s[potIndex], &l_raw_s32);
   }
-  else // ADC_UNIT_2
+  if (l_err_s32 != ESP_OK)
   {
-    ESP_ERROR_CHECK(adc_oneshot_read(main_g_AdcUnit2Handle_s, pot_g_channel_s[potIndex], (int *)&adcAnalogRead));
+    return 0;
   }
 
-  /* Return scaled value based on POT define */
-  return pot_g_PotConfig_s[potIndex].offset_f32 + (float32_t)pot_f_MapFloat_f32(
-                                                      adcAnalogRead,
-                                                      0,
-                                                      4095,
-                                                      pot_g_PotConfig_s[potIndex].min_val_f32,
-                                                      pot_g_PotConfig_s[potIndex].max_val_f32);
+  /* Scaled value based on POT define */
+  *value = pot_g_PotConfig_s[potIndex].offset_f32 + (float32_t)pot_f_MapFloat_f32(
+                                                        (uint16_t)l_raw_s32,
+                                                        0,
+                                                        4095,
+                                                        pot_g_PotConfig_s[potIndex].min_val_f32,
+                                                        pot_g_PotConfig_s[potIndex].max_val_f32);
+  return 1;
 }
 
 /**
@@ -189,7 +187,7 @@ float32_t pot_f_AnalogRead_f32(uint16_t potIndex)
  * @param out_max
  * @return scaled float32_t value
  */
-float32_t pot_f_MapFloat_f32(uint16_t val, uint16_t in_min, uint16_t in_max, float32_t out_min, float32_t out_max)
+float32_t POT_IRAM_ATTR pot_f_MapFloat_f32(uint16_t val, uint16_t in_min, uint16_t in_max, float32_t out_min, float32_t out_max)
 {
   return (float32_t)(val - in_min) * (out_max - out_min) / (float32_t)(in_max - in_min) + out_min;
 }
@@ -23,6 +23,7 @@
  **************************************************************************/
 
 #include "config/project.h"
+#include "drivers/blk/blk_e.h"
 
 /**************************************************************************
  * Defines
@@ -44,6 +45,13 @@
  */
 extern float32_t pot_g_PotValues_f32[POT_COUNT];
 
+/**
+ * @brief Last POT_AVG_CNT readings of every potentiometer, for the filters and recording to take by reference
+ *
+ * @values See pot_g_PotConfig_s in pot_i.h, and blk_s_Block_t
+ */
+extern blk_s_Block_t pot_g_Block_s;
+
 /**************************************************************************
  * Function prototypes
  **************************************************************************/
@@ -40,7 +40,7 @@
  * 
  * @values 0..1
  */
-const float32_t pot_c_PotMaxVal_f32 = 1.0;
+POT_DRAM_ATTR const float32_t pot_c_PotMaxVal_f32 = 1.0;
 
 /**
  * @brief Configuration parameters of a potentiometer
@@ -107,7 +107,7 @@ pot_s_PotConfig_t pot_g_PotConfig_s[POT_COUNT] = {
  * 
  * @values same as pot values
  */
-extern float32_t pot_g_PrevValues_f32[POT_COUNT][POT_AVG_CNT];
+extern float32_t pot_g_Samples_f32[POT_COUNT][BLK_STRIDE(POT_AVG_CNT)];
 
 /**
  * @brief Analog to digital converter channel
@@ -119,7 +119,7 @@ extern adc_channel_t pot_g_channel_s[POT_COUNT];
  * Function prototypes
  **************************************************************************/
 
-extern float32_t pot_f_AnalogRead_f32(uint16_t potIndex);
+extern uint8_t pot_f_AnalogRead_u8(uint16_t potIndex, float32_t *value);
 extern float32_t pot_f_MapFloat_f32(uint16_t val, uint16_t in_min, uint16_t in_max, float32_t out_min, float32_t out_max);
 
 #endif // POT_I_H
\ No newline at end of file
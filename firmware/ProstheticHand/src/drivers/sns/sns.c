@@ -22,6 +22,9 @@
 #include "sns_e.h"
 #include "sns_i.h"
 
+/* Other components used here */
+#include "drivers/err/err_e.h"
+
 /**************************************************************************
  * Global variables
  **************************************************************************/
@@ -34,14 +37,22 @@
  */
 uint16_t sns_g_Values_u16[SNS_COUNT];
 
+/**
+ * @brief Last reading of every sensor, before averaging
+ *
+ * @values 0-4095
+ */
+uint16_t sns_g_RawValues_u16[SNS_COUNT];
+
 uint8_t sns_g_ActiveStatus_u8[SNS_COUNT];
 
 /**
- * @brief Buffer for storing previous values of the potentiometers for filtering
+ * @brief Last SNS_AVG_CNT readings of every sensor for filtering, and their storage
  *
- * @valuessame as sensor values
+ * @values same as sensor values
  */
-uint16_t sns_g_PrevValues_u16[SNS_COUNT][SNS_AVG_CNT];
+blk_s_Block_t sns_g_Block_s;
+float32_t sns_g_Samples_f32[SNS_COUNT][BLK_STRIDE(SNS_AVG_CNT)] BLK_STORAGE_ATTR;
 
 /**
  * @brief Analog to digital converter channel
@@ -55,6 +66,8 @@ adc_channel_t sns_g_sensorChannel_t[SNS_COUNT];
 
 void sns_f_Init_v(void);
 void sns_f_Handle_v(void);
+uint16_t sns_f_GetThreshold_u16(uint8_t sensorIndex);
+uint8_t sns_f_SetThreshold_u8(uint8_t sensorIndex, uint16_t threshold);
 
 #ifdef SERIAL_DEBUG
 void sns_f_SerialDebug_v(void);
@@ -69,7 +82,7 @@ void sns_f_SerialDebug_v(void);
  */
 void sns_f_Init_v(void)
 {
-  uint8_t i, j;
+  uint8_t i;
 
   /* Default ADC channel config for all inputs */
   adc_oneshot_chan_cfg_t channel_config = {
@@ -87,13 +100,10 @@ void sns_f_Init_v(void)
     {
       ESP_ERROR_CHECK(adc_oneshot_config_channel(main_g_AdcUnit2Handle_s, sns_g_sensorChannel_t[i], &channel_config));
     }
-
-    /* And set all initial values for filter */
-    for (j = 0; j < SNS_AVG_CNT; j++)
-    {
-      sns_g_PrevValues_u16[i][j] = 0;
-    }
   }
+
+  /* And set all initial values for filter */
+  blk_f_Init_v(&sns_g_Block_s, &sns_g_Samples_f32[0][0], SNS_COUNT, SNS_AVG_CNT);
 }
 
 /**
@@ -103,49 +113,84 @@ void sns_f_Init_v(void)
  *
  * @return void
  */
-void sns_f_Handle_v(void)
+void SNS_IRAM_ATTR sns_f_Handle_v(void)
 {
-  int i, j;
-  uint32_t sum = 0;
+  int i;
   int readValue = 0;
+  esp_err_t l_err_s32;
+  adc_oneshot_unit_handle_t l_unit_s;
+  float32_t l_frame_f32[SNS_COUNT];
+  float32_t l_means_f32[SNS_COUNT];
 
   /* Go over all connected sensors */
   for (i = 0; i < SNS_COUNT; i++)
   {
     /* Based on pins ADC group, do the right reading: */
-    if (sns_g_SensorConfig_s[i].adc_unit_s == ADC_UNIT_1)
-    {
-      ESP_ERROR_CHECK(adc_oneshot_read(main_g_AdcUnit1Handle_s, sns_g_sensorChannel_t[i], &readValue));
-    }
-    else // ADC_UNIT_2
+    l_unit_s = (sns_g_SensorConfig_s[i].adc_unit_s == ADC_UNIT_1) ? main_g_AdcUnit1Handle_s : main_g_AdcUnit2Handle_s;
+
+    l_err_s32 = adc_oneshot_read(l_unit_s, sns_g_sensorChannel_t[i], &readValue);
+    while (err_f_Retry_u8(ERR_SRC_SNS, l_err_s32))
     {
-      ESP_ERROR_CHECK(adc_oneshot_read(main_g_AdcUnit2Handle_s, sns_g_sensorChannel_t[i], &readValue));
+      l_err_s32 = adc_oneshot_read(l_unit_s, sns_g_sensorChannel_t[i], &readValue);
     }
 
-    /* Shift all values in buffer to the next place in the array */
-    for (j = SNS_AVG_CNT - 1; j > 0; j--)
+    /* A failed read repeats the last good reading */
+    if (l_err_s32 != ESP_OK)
     {
-      sns_g_PrevValues_u16[i][j] = sns_g_PrevValues_u16[i][j - 1];
+      l_frame_f32[i] = blk_f_Latest_f32(&sns_g_Block_s, i);
+      continue;
     }
 
     /* Set the current sensor value */
-    sns_g_PrevValues_u16[i][0] = (uint16_t)readValue;
+    l_frame_f32[i] = (float32_t)readValue;
+    sns_g_RawValues_u16[i] = (uint16_t)readValue;
+  }
 
-    /* Take the average of those readings */
-    sum = 0;
-    for (j = 0; j < SNS_AVG_CNT; j++)
-    {
-      sum += sns_g_PrevValues_u16[i][j];
-    }
+  /* Take the average of the last readings of all the sensors at once */
+  blk_f_Push_v(&sns_g_Block_s, l_frame_f32, (uint32_t)esp_timer_get_time());
+  blk_f_Mean_v(&sns_g_Block_s, l_means_f32);
 
-    /* Final sensor value assignment */
-    sns_g_Values_u16[i] = (sum / SNS_AVG_CNT);
+  for (i = 0; i < SNS_COUNT; i++)
+  {
+    /* Final sensor value assignment, the readings are whole numbers so their sum is exact */
+    sns_g_Values_u16[i] = (uint16_t)l_means_f32[i];
 
-    /* Set sensor active if over threshold */
-    sns_g_ActiveStatus_u8[i] = sns_g_Values_u16[i] > sns_g_SensorConfig_s[i].thresh_u16;
+    /* Set sensor active if over threshold, never while the reads keep failing */
+    sns_g_ActiveStatus_u8[i] = !err_f_Degraded_u8(ERR_SRC_SNS) && (sns_g_Values_u16[i] > sns_g_SensorConfig_s[i].thresh_u16);
   }
 }
 
+/**
+ * @brief Activation threshold of a sensor
+ *
+ * @param sensorIndex 0..SNS_COUNT-1
+ * @return threshold, 0..4095
+ */
+uint16_t sns_f_GetThreshold_u16(uint8_t sensorIndex)
+{
+  return sns_g_SensorConfig_s[sensorIndex].thresh_u16;
+}
+
+/**
+ * @brief Change the activation threshold of a sensor, e.g. while tuning it over the telemetry link
+ *
+ * A single u16 write, so the handle function sees either the old or the new threshold
+ *
+ * @param sensorIndex 0..SNS_COUNT-1
+ * @param threshold 0..4095
+ * @return 1 if it was changed, 0 if the threshold is out of range
+ */
+uint8_t sns_f_SetThreshold_u8(uint8_t sensorIndex, uint16_t threshold)
+{
+  if (threshold > 4095)
+  {
+    return 0;
+  }
+
+  sns_g_SensorConfig_s[sensorIndex].thresh_u16 = threshold;
+  return 1;
+}
+
 #ifdef SERIAL_DEBUG
 void sns_f_SerialDebug_v(void)
 {
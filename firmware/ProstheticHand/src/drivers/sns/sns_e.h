@@ -22,6 +22,7 @@
  **************************************************************************/
 
 #include "config/project.h"
+#include "drivers/blk/blk_e.h"
 
 /**************************************************************************
  * Defines
@@ -37,14 +38,25 @@
 
 extern uint16_t sns_g_Values_u16[SNS_COUNT];
 
+extern uint16_t sns_g_RawValues_u16[SNS_COUNT];
+
 extern uint8_t sns_g_ActiveStatus_u8[SNS_COUNT];
 
+/**
+ * @brief Last SNS_AVG_CNT readings of every sensor, for the filters, features and recording to take by reference
+ *
+ * @values 0-4095, see blk_s_Block_t
+ */
+extern blk_s_Block_t sns_g_Block_s;
+
 /**************************************************************************
  * Function prototypes
  **************************************************************************/
 
 extern void sns_f_Init_v(void);
 extern void sns_f_Handle_v(void);
+extern uint16_t sns_f_GetThreshold_u16(uint8_t sensorIndex);
+extern uint8_t sns_f_SetThreshold_u8(uint8_t sensorIndex, uint16_t threshold);
 
 #ifdef SERIAL_DEBUG
 extern void sns_f_SerialDebug_v(void);
@@ -92,11 +92,11 @@ sns_s_SensorConfig_t sns_g_SensorConfig_s[SNS_COUNT] = {
 };
 
 /**
- * @brief Buffer for storing previous values of the potentiometers for filtering
- * 
- * @valuessame as sensor values
+ * @brief Samples of sns_g_Block_s
+ *
+ * @values same as sensor values
  */
-extern uint16_t sns_g_PrevValues_u16[SNS_COUNT][SNS_AVG_CNT];
+extern float32_t sns_g_Samples_f32[SNS_COUNT][BLK_STRIDE(SNS_AVG_CNT)];
 
 /**
  * @brief Analog to digital converter channel
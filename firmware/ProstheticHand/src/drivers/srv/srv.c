@@ -32,6 +32,9 @@
 #include "drivers/pot/pot_e.h"
 #include "drivers/sns/sns_e.h"
 #include "drivers/btn/btn_e.h"
+#include "drivers/stp/stp_e.h"
+#include "drivers/sup/sup_e.h"
+#include "drivers/err/err_e.h"
 
 
 /**************************************************************************
@@ -45,6 +48,34 @@
  */
 uint16_t srv_g_Positions_u16[SRV_COUNT];
 
+/**
+ * @brief Duty cycle actually sent to each servo
+ *
+ * @values srv_c_minimumAllowedDuty_f32..max allowed duty
+ */
+uint16_t srv_g_Output_u16[SRV_COUNT];
+
+/**
+ * @brief Whether the servos have reached the commanded position after boot
+ *
+ * @values 0 - homing, 1 - done
+ */
+uint8_t srv_g_Homed_u8;
+
+/**
+ * @brief Whether the outputs follow the sensor threshold this cycle (REV03 without setpoints from the host)
+ *
+ * @values 0 - continuous input, 1 - threshold, the outputs jump between two positions
+ */
+uint8_t srv_g_Threshold_u8;
+
+/**
+ * @brief Main cycles spent homing so far
+ *
+ * @values 0..SERVO_HOME_HOLD_CYCLES
+ */
+uint16_t srv_g_HomeCycles_u16;
+
 /**************************************************************************
  * Functions
  **************************************************************************/
@@ -57,6 +88,15 @@ void srv_f_CalculateSrvAngleFromSensor_f32(uint8_t servoIndex, uint8_t sensorInd
 void srv_f_CalculateSrvAngleFromSensorThreshold_f32(uint8_t servoIndex, uint8_t sensorIndex);
 void srv_f_CalculateSrvAngleFromBtn_f32(uint8_t servoIndex, uint8_t btnIndex);
 void srv_f_CalculatePWMFromPercentage_f32(uint8_t servoIndex, float32_t pwmDutyPercent);
+void srv_f_CalculateSrvAngleFromStream_v(uint8_t servoIndex, uint16_t position);
+void srv_f_Home_v(void);
+esp_err_t srv_f_WriteDuty_s32(uint8_t servoIndex);
+uint16_t srv_f_GetRange_u16(uint8_t servoIndex);
+uint8_t srv_f_SetRange_u8(uint8_t servoIndex, uint16_t range);
+uint8_t srv_f_GetDutyLimits_u8(uint8_t servoIndex, uint16_t *minDuty, uint16_t *maxDuty);
+uint8_t srv_f_Continuous_u8(uint8_t servoIndex);
+uint8_t srv_f_InputDegraded_u8(void);
+void srv_f_SafeState_v(void);
 
 #ifdef SERIAL_DEBUG
 void srv_f_SerialDebug_v(void);
@@ -67,7 +107,8 @@ float32_t srv_c_minimumAllowedDuty_f32[SRV_COUNT];
 /**
  * @brief Init function called once on boot
  *
- * Set timer and channel configuration for the PWM signal
+ * Set timer and channel configuration for the PWM signal,
+ * with every servo starting in the open posture
  *
  * @return void
  */
@@ -86,36 +127,69 @@ void srv_f_Init_v(void)
   /* Go over all servo pins and initialize the channel */
   for (i = 0; i < SRV_COUNT; i++)
   {
+    srv_c_minimumAllowedDuty_f32[i] = SERVO_MIN_DUTY_CYCLE + (srv_s_ServoConfig_s[i].min_angle_u16 * srv_c_OneDegreeAsDuty_f32);
+    srv_g_Output_u16[i] = srv_c_minimumAllowedDuty_f32[i];
+
     ledc_channel_config_t srvPWM_ChannelConfig = {
         .gpio_num = srv_s_ServoConfig_s[i].pin_u16,
         .speed_mode = LEDC_LOW_SPEED_MODE,
         .channel = srv_s_ServoConfig_s[i].chn_s,
         .intr_type = LEDC_INTR_DISABLE,
         .timer_sel = LEDC_TIMER_0,
-        .duty = 0,
+        .duty = srv_g_Output_u16[i],
         .hpoint = 0,
         .flags = {.output_invert = 0}};
     ESP_ERROR_CHECK(ledc_channel_config(&srvPWM_ChannelConfig));
-
-    srv_c_minimumAllowedDuty_f32[i] = SERVO_MIN_DUTY_CYCLE + (srv_s_ServoConfig_s[i].min_angle_u16 * srv_c_OneDegreeAsDuty_f32);
   }
+
+  srv_g_Homed_u8 = 0;
+  srv_g_HomeCycles_u16 = 0;
 }
 
 /**
  * @brief Handle function to be called cyclically
  *
- * Set the servos to an angle that relates to the chosen potentiometer/sensor
+ * Set the servos to an angle that relates to the chosen potentiometer/sensor,
+ * or to the setpoints streamed by the host while it asks for that.
+ * While the chosen potentiometer/sensor is degraded (drivers/err) its held value can't be trusted,
+ * so the servos go to the open posture until it recovers
  *
  * @return void
  */
-void srv_f_Handle_v(void)
+void SRV_IRAM_ATTR srv_f_Handle_v(void)
 {
   uint8_t i;
+  uint8_t l_stream_u8 = 0;
+  uint8_t l_degraded_u8;
+  uint8_t l_written_u8 = 1;
+  uint16_t l_targets_u16[SRV_COUNT];
+  esp_err_t l_err_s32;
+
+  /* Once the supervisor tripped, nothing but the safe posture goes out until a reset */
+  if (sup_f_Safe_u8())
+  {
+    srv_f_SafeState_v();
+    return;
+  }
+
+#ifdef TELEMETRY
+  l_stream_u8 = stp_f_GetTargets_u8(l_targets_u16);
+#endif
+  srv_g_Threshold_u8 = !l_stream_u8 && (dsw_g_HardwareRevision_e == REV03);
+  l_degraded_u8 = !l_stream_u8 && srv_f_InputDegraded_u8();
 
   for (i = 0; i < SRV_COUNT; i++)
   {
     /* Check how should the angle be calculated (by pot or sensor value?)*/
-    if (dsw_g_HardwareRevision_e == REV00) /* POT controlled */
+    if (l_stream_u8) /* Setpoints from the host */
+    {
+      srv_f_CalculateSrvAngleFromStream_v(i, l_targets_u16[i]);
+    }
+    else if (l_degraded_u8) /* Input failing, open posture */
+    {
+      srv_g_Positions_u16[i] = srv_c_minimumAllowedDuty_f32[i];
+    }
+    else if (dsw_g_HardwareRevision_e == REV00) /* POT controlled */
     {
       srv_f_CalculateSrvAngleFromPot_f32(i, SERVO_CONTROL_POT_INDEX);
     }
@@ -132,18 +206,66 @@ void srv_f_Handle_v(void)
     else if (dsw_g_HardwareRevision_e == REV04) { /* Full PWM range control (through POT) */
       srv_f_CalculatePWMFromPercentage_f32(i, pot_g_PotValues_f32[SERVO_PWM_POT_INDEX]);
     }
+  }
+
+  /* Until homing is done, don't let the servos jump to the first commanded position */
+  if (srv_g_Homed_u8)
+  {
+    for (i = 0; i < SRV_COUNT; i++)
+    {
+      srv_g_Output_u16[i] = srv_g_Positions_u16[i];
+    }
+  }
+  else
+  {
+    srv_f_Home_v();
+  }
 
+  for (i = 0; i < SRV_COUNT; i++)
+  {
     /* Finally set and update each servo PWM signal's duty cycle  */
-    ESP_ERROR_CHECK(ledc_set_duty(LEDC_LOW_SPEED_MODE, srv_s_ServoConfig_s[i].chn_s, srv_g_Positions_u16[i]));
-    ESP_ERROR_CHECK(ledc_update_duty(LEDC_LOW_SPEED_MODE, srv_s_ServoConfig_s[i].chn_s));
+    l_err_s32 = srv_f_WriteDuty_s32(i);
+    while (err_f_Retry_u8(ERR_SRC_SRV, l_err_s32))
+    {
+      l_err_s32 = srv_f_WriteDuty_s32(i);
+    }
+    if (l_err_s32 != ESP_OK)
+    {
+      l_written_u8 = 0;
+    }
+  }
+
+  /* The outputs are out, tell the supervisor the control loop is alive. If they can't be written
+     for longer than its heartbeat timeout, the supervisor takes over */
+  if (l_written_u8)
+  {
+    sup_f_Heartbeat_v();
+  }
+}
+
+/**
+ * @brief Set and update the PWM duty cycle of a servo to its output
+ *
+ * @param servoIndex 0..SRV_COUNT-1
+ * @return ESP_OK or the error of the LEDC driver
+ */
+esp_err_t SRV_IRAM_ATTR srv_f_WriteDuty_s32(uint8_t servoIndex)
+{
+  esp_err_t l_err_s32;
+
+  l_err_s32 = ledc_set_duty(LEDC_LOW_SPEED_MODE, srv_s_ServoConfig_s[servoIndex].chn_s, srv_g_Output_u16[servoIndex]);
+  if (l_err_s32 == ESP_OK)
+  {
+    l_err_s32 = ledc_update_duty(LEDC_LOW_SPEED_MODE, srv_s_ServoConfig_s[servoIndex].chn_s);
   }
+  return l_err_s32;
 }
 
 /**
  * @brief Calculates angle for given servo based on given potentiometer
  *
  */
-void srv_f_CalculateSrvAngleFromPot_f32(uint8_t servoIndex, uint8_t potIndex)
+void SRV_IRAM_ATTR srv_f_CalculateSrvAngleFromPot_f32(uint8_t servoIndex, uint8_t potIndex)
 {
   srv_g_Positions_u16[servoIndex] = srv_c_minimumAllowedDuty_f32[servoIndex] + (srv_s_ServoConfig_s[servoIndex].max_angle_u16 * srv_c_OneDegreeAsDuty_f32) * pot_g_PotValues_f32[SERVO_CONTROL_POT_INDEX];
 }
@@ -152,7 +274,7 @@ void srv_f_CalculateSrvAngleFromPot_f32(uint8_t servoIndex, uint8_t potIndex)
  * @brief Calculates angle for given servo based on given sensor
  *
  */
-void srv_f_CalculateSrvAngleFromSensor_f32(uint8_t servoIndex, uint8_t sensorIndex)
+void SRV_IRAM_ATTR srv_f_CalculateSrvAngleFromSensor_f32(uint8_t servoIndex, uint8_t sensorIndex)
 {
   srv_g_Positions_u16[servoIndex] = srv_c_minimumAllowedDuty_f32[servoIndex] + (srv_s_ServoConfig_s[servoIndex].max_angle_u16 * srv_c_OneDegreeAsDuty_f32) * sns_g_Values_u16[0] / 4095;
 }
@@ -162,7 +284,7 @@ void srv_f_CalculateSrvAngleFromSensor_f32(uint8_t servoIndex, uint8_t sensorInd
  * while taking into account the activation threshold of the sensor
  * 
  */
-void srv_f_CalculateSrvAngleFromSensorThreshold_f32(uint8_t servoIndex, uint8_t sensorIndex)
+void SRV_IRAM_ATTR srv_f_CalculateSrvAngleFromSensorThreshold_f32(uint8_t servoIndex, uint8_t sensorIndex)
 {
   float32_t angle;
 
@@ -180,7 +302,7 @@ void srv_f_CalculateSrvAngleFromSensorThreshold_f32(uint8_t servoIndex, uint8_t
  * @brief Calculates angle for given servo based on button press
  * 
  */
-void srv_f_CalculateSrvAngleFromBtn_f32(uint8_t servoIndex, uint8_t btnIndex)
+void SRV_IRAM_ATTR srv_f_CalculateSrvAngleFromBtn_f32(uint8_t servoIndex, uint8_t btnIndex)
 {
   float32_t angle;
   if(btn_g_BtnStates_u8[btnIndex] == 1){
@@ -192,11 +314,160 @@ void srv_f_CalculateSrvAngleFromBtn_f32(uint8_t servoIndex, uint8_t btnIndex)
   srv_g_Positions_u16[servoIndex] = srv_c_minimumAllowedDuty_f32[servoIndex] + (srv_s_ServoConfig_s[servoIndex].max_angle_u16 * srv_c_OneDegreeAsDuty_f32) * angle;
 }
 
+/**
+ * @brief Calculates angle for given servo based on a setpoint streamed by the host
+ *
+ * The position maps onto the same range as the potentiometer control
+ *
+ */
+void SRV_IRAM_ATTR srv_f_CalculateSrvAngleFromStream_v(uint8_t servoIndex, uint16_t position)
+{
+  srv_g_Positions_u16[servoIndex] = srv_c_minimumAllowedDuty_f32[servoIndex] + (srv_s_ServoConfig_s[servoIndex].max_angle_u16 * srv_c_OneDegreeAsDuty_f32) * position / STP_POSITION_MAX;
+}
+
+/**
+ * @brief Boot homing, called every main cycle until it is done
+ *
+ * Hold the open posture for SERVO_HOME_HOLD_CYCLES, then move each servo
+ * to its commanded position by at most SERVO_HOME_SLEW_STEP per cycle
+ *
+ */
+void SRV_IRAM_ATTR srv_f_Home_v(void)
+{
+  uint8_t i;
+  uint8_t l_arrived_u8 = 1;
+
+  if (srv_g_HomeCycles_u16 < SERVO_HOME_HOLD_CYCLES)
+  {
+    srv_g_HomeCycles_u16++;
+    return;
+  }
+
+  for (i = 0; i < SRV_COUNT; i++)
+  {
+    if (srv_g_Positions_u16[i] > (srv_g_Output_u16[i] + SERVO_HOME_SLEW_STEP))
+    {
+      srv_g_Output_u16[i] += SERVO_HOME_SLEW_STEP;
+      l_arrived_u8 = 0;
+    }
+    else if ((srv_g_Positions_u16[i] + SERVO_HOME_SLEW_STEP) < srv_g_Output_u16[i])
+    {
+      srv_g_Output_u16[i] -= SERVO_HOME_SLEW_STEP;
+      l_arrived_u8 = 0;
+    }
+    else
+    {
+      srv_g_Output_u16[i] = srv_g_Positions_u16[i];
+    }
+  }
+
+  srv_g_Homed_u8 = l_arrived_u8;
+}
+
+/**
+ * @brief How far a servo travels above its minimum angle at full input
+ *
+ * @param servoIndex 0..SRV_COUNT-1
+ * @return range in degrees
+ */
+uint16_t srv_f_GetRange_u16(uint8_t servoIndex)
+{
+  return srv_s_ServoConfig_s[servoIndex].max_angle_u16;
+}
+
+/**
+ * @brief Change how far a servo travels above its minimum angle, e.g. while tuning it over the telemetry link
+ *
+ * Takes effect with the next position calculated, a single u16 write
+ *
+ * @param servoIndex 0..SRV_COUNT-1
+ * @param range in degrees, the minimum angle plus the range can't go past 180
+ * @return 1 if it was changed, 0 if the range is out of bounds
+ */
+uint8_t srv_f_SetRange_u8(uint8_t servoIndex, uint16_t range)
+{
+  if ((srv_s_ServoConfig_s[servoIndex].min_angle_u16 + range) > 180)
+  {
+    return 0;
+  }
+
+  srv_s_ServoConfig_s[servoIndex].max_angle_u16 = range;
+  return 1;
+}
+
+/**
+ * @brief Duty cycles a servo may get, from its minimum angle to the end of its current travel
+ *
+ * @param servoIndex 0..SRV_COUNT-1
+ * @param minDuty lowest duty cycle
+ * @param maxDuty highest duty cycle
+ * @return 1 if the servo is bound to them, 0 in REV04, which drives the full PWM range on purpose
+ */
+uint8_t SRV_IRAM_ATTR srv_f_GetDutyLimits_u8(uint8_t servoIndex, uint16_t *minDuty, uint16_t *maxDuty)
+{
+  *minDuty = srv_c_minimumAllowedDuty_f32[servoIndex];
+  *maxDuty = srv_c_minimumAllowedDuty_f32[servoIndex] + (srv_s_ServoConfig_s[servoIndex].max_angle_u16 * srv_c_OneDegreeAsDuty_f32);
+
+  return (dsw_g_HardwareRevision_e != REV04);
+}
+
+/**
+ * @brief Whether a servo follows its input smoothly, so its outputs moving back and forth fast mean garbage input
+ *
+ * @param servoIndex 0..SRV_COUNT-1
+ * @return 1 if so, 0 in REV04 (full PWM range) and while it follows the sensor threshold, where it jumps
+ * between two positions whenever the sensor crosses it
+ */
+uint8_t SRV_IRAM_ATTR srv_f_Continuous_u8(uint8_t servoIndex)
+{
+  return (dsw_g_HardwareRevision_e != REV04) && !srv_g_Threshold_u8;
+}
+
+/**
+ * @brief Whether the potentiometer or sensor the selected revision follows is degraded
+ *
+ * @return 1 if so, 0 otherwise and in REV02 (buttons)
+ */
+uint8_t SRV_IRAM_ATTR srv_f_InputDegraded_u8(void)
+{
+  switch (dsw_g_HardwareRevision_e)
+  {
+  case REV00:
+  case REV04:
+    return err_f_Degraded_u8(ERR_SRC_POT);
+  case REV01:
+  case REV03:
+    return err_f_Degraded_u8(ERR_SRC_SNS);
+  default:
+    return 0;
+  }
+}
+
+/**
+ * @brief Put every servo into the open posture (minimum angle) right away, without homing or slew limit
+ *
+ * Called by the supervisor from its own timer on core 0 as well as by srv_f_Handle_v() while the safe state holds,
+ * the LEDC driver guards its registers with a spinlock
+ *
+ * @return void
+ */
+void SRV_IRAM_ATTR srv_f_SafeState_v(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < SRV_COUNT; i++)
+  {
+    srv_g_Output_u16[i] = srv_c_minimumAllowedDuty_f32[i];
+    ledc_set_duty(LEDC_LOW_SPEED_MODE, srv_s_ServoConfig_s[i].chn_s, srv_g_Output_u16[i]);
+    ledc_update_duty(LEDC_LOW_SPEED_MODE, srv_s_ServoConfig_s[i].chn_s);
+  }
+}
+
 /**
  * @brief Writes PWM signal from 0% duty to 100% duty (always on) based on given value
  * 
  */
-void srv_f_CalculatePWMFromPercentage_f32(uint8_t servoIndex, float32_t pwmDutyPercent)
+void SRV_IRAM_ATTR srv_f_CalculatePWMFromPercentage_f32(uint8_t servoIndex, float32_t pwmDutyPercent)
 {
   srv_g_Positions_u16[servoIndex] = SERVO_100_PERCENT_DUTY_CYCLE * pwmDutyPercent;
 }
@@ -209,7 +480,7 @@ void srv_f_SerialDebug_v(void)
   /* Go over all servos */
   for (i = 0; i < SRV_COUNT; i++)
   {
-    ESP_LOGD(SRV_TAG, "Servo #%d position = %d", i, srv_g_Positions_u16[i]);
+    ESP_LOGD(SRV_TAG, "Servo #%d position = %d, output = %d, homed = %d", i, srv_g_Positions_u16[i], srv_g_Output_u16[i], srv_g_Homed_u8);
   }
 }
 #endif
\ No newline at end of file
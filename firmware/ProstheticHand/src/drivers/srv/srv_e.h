@@ -87,12 +87,41 @@
  */
 extern uint16_t srv_g_Positions_u16[SRV_COUNT];
 
+/**
+ * @brief Duty cycle actually sent to each servo
+ *
+ * Equals srv_g_Positions_u16 once homing is done, until then it starts at the open posture and
+ * moves towards it at a limited rate
+ *
+ * @values srv_c_minimumAllowedDuty_f32..max allowed duty
+ */
+extern uint16_t srv_g_Output_u16[SRV_COUNT];
+
+/**
+ * @brief Whether the servos have reached the commanded position after boot
+ *
+ * @values 0 - homing, 1 - done
+ */
+extern uint8_t srv_g_Homed_u8;
+
+/**
+ * @brief Whether the outputs follow the sensor threshold this cycle (REV03 without setpoints from the host)
+ *
+ * @values 0 - continuous input, 1 - threshold, the outputs jump between two positions
+ */
+extern uint8_t srv_g_Threshold_u8;
+
 /**************************************************************************
  * Function prototypes
  **************************************************************************/
 
 extern void srv_f_Init_v(void);
 extern void srv_f_Handle_v(void);
+extern uint16_t srv_f_GetRange_u16(uint8_t servoIndex);
+extern uint8_t srv_f_SetRange_u8(uint8_t servoIndex, uint16_t range);
+extern uint8_t srv_f_GetDutyLimits_u8(uint8_t servoIndex, uint16_t *minDuty, uint16_t *maxDuty);
+extern uint8_t srv_f_Continuous_u8(uint8_t servoIndex);
+extern void srv_f_SafeState_v(void);
 
 #ifdef SERIAL_DEBUG
 extern void srv_f_SerialDebug_v(void);
@@ -82,11 +82,28 @@
  */
 #define SERVO_100_PERCENT_DUTY_CYCLE BITS_TO_MAX_VAL(PWM_RESOLUTION)
 
+/**
+ * @brief How long the servos are held in the open posture (minimum angle) after boot
+ *
+ * Hobby servos have no position feedback, so the first pulse always makes them jump.
+ * Sending the open posture first makes that jump go to a known place, and gives the servos time to get there
+ *
+ * @values in main cycles (10ms), long enough for a servo to travel its full range
+ */
+#define SERVO_HOME_HOLD_CYCLES 50
+
+/**
+ * @brief After holding, largest change of the duty cycle per main cycle while moving to the first commanded position
+ *
+ * @values 1..SERVO_100_PERCENT_DUTY_CYCLE (duty cycle steps per 10ms)
+ */
+#define SERVO_HOME_SLEW_STEP 8
+
 /**
  * @brief The value of a single degree angle in duty cycle length
  *
  */
-const float32_t srv_c_OneDegreeAsDuty_f32 = (SERVO_MAX_DUTY_CYCLE - SERVO_MIN_DUTY_CYCLE) / 180.0;
+SRV_DRAM_ATTR const float32_t srv_c_OneDegreeAsDuty_f32 = (SERVO_MAX_DUTY_CYCLE - SERVO_MIN_DUTY_CYCLE) / 180.0;
 
 /**
  * @brief Configuration parameters of a servo motor
@@ -147,6 +164,13 @@ srv_s_ServoConfig_t srv_s_ServoConfig_s[SRV_COUNT] = {
  */
 extern float32_t srv_c_minimumAllowedDuty_f32[SRV_COUNT];
 
+/**
+ * @brief Main cycles spent homing so far
+ *
+ * @values 0..SERVO_HOME_HOLD_CYCLES
+ */
+extern uint16_t srv_g_HomeCycles_u16;
+
 /**************************************************************************
  * Function prototypes
  **************************************************************************/
@@ -155,5 +179,8 @@ extern void srv_f_CalculateSrvAngleFromPot_f32(uint8_t servoIndex, uint8_t potIn
 extern void srv_f_CalculateSrvAngleFromSensor_f32(uint8_t servoIndex, uint8_t sensorIndex);
 extern void srv_f_CalculateSrvAngleFromSensorThreshold_f32(uint8_t servoIndex, uint8_t sensorIndex);
 extern void srv_f_CalculateSrvAngleFromBtn_f32(uint8_t servoIndex, uint8_t btnIndex);
+extern void srv_f_CalculateSrvAngleFromStream_v(uint8_t servoIndex, uint16_t position);
+extern void srv_f_Home_v(void);
+extern esp_err_t srv_f_WriteDuty_s32(uint8_t servoIndex);
 
 #endif // SRV_I_H
\ No newline at end of file
@@ -0,0 +1,448 @@
+/**
+ * @file stp.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Setpoint streaming software component
+ *
+ * Lets a PC drive the servos over the telemetry link, e.g. to replay recorded finger trajectories
+ * or to try out decoders running on the host. The host streams timestamped setpoints (STP) at up to 1kHz,
+ * which go through a jitter buffer: each one is applied a fixed delay after the least delayed setpoint
+ * would have arrived, so the spacing the host sent them at survives the jitter of the host OS and the link.
+ * The servos take the newest setpoint that is due every servo cycle (10ms, the servos only update every 20ms anyway).
+ *
+ * If the setpoints stop coming for longer than the watchdog timeout, the servos go to the safe posture (open)
+ * and stay there until the stream resumes or the host hands the servos back to the local inputs.
+ *
+ * Only compiled in when TELEMETRY is defined (see defines.h), as the setpoints come over its link
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "stp_e.h"
+#include "stp_i.h"
+
+#include "string.h"
+
+#ifdef TELEMETRY
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Guards all the state below, written by the telemetry task on core 0 and read by the servos on core 1
+ *
+ */
+portMUX_TYPE stp_g_Lock_s = portMUX_INITIALIZER_UNLOCKED;
+
+/**
+ * @brief Current mode and state, and the settings of the stream
+ *
+ */
+stp_Mode_e stp_g_Mode_e;
+stp_State_e stp_g_State_e;
+uint16_t stp_g_DelayUs_u16;
+uint16_t stp_g_TimeoutMs_u16;
+
+/**
+ * @brief Jitter buffer, a ring of setpoints in the order they arrived
+ *
+ */
+stp_s_Entry_t stp_g_Buffer_s[STP_BUFFER_LEN];
+uint8_t stp_g_Head_u8;
+uint8_t stp_g_Depth_u8;
+
+/**
+ * @brief The setpoint received last, setpoints that don't set every servo take the rest from it
+ *
+ */
+stp_s_Entry_t stp_g_Received_s;
+uint8_t stp_g_HaveReceived_u8;
+
+/**
+ * @brief The setpoint applied last
+ *
+ */
+stp_s_Entry_t stp_g_Applied_s;
+uint8_t stp_g_HaveApplied_u8;
+
+/**
+ * @brief Device minus host time of the least delayed setpoint (the clock offset), and of the current window
+ *
+ */
+uint32_t stp_g_OffsetUs_u32;
+uint32_t stp_g_WindowMinUs_u32;
+int64_t stp_g_WindowStartUs_s64;
+
+/**
+ * @brief Counters and latencies sent in STP_STATS, and the spread of the transit times in the current stats period
+ *
+ */
+msg_s_StpStats_t stp_g_Stats_s;
+uint32_t stp_g_TransitMinUs_u32;
+uint32_t stp_g_TransitMaxUs_u32;
+uint8_t stp_g_HaveTransit_u8;
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+void stp_f_Init_v(void);
+uint8_t stp_f_Control_u8(const uint8_t *payload, uint8_t len);
+uint8_t stp_f_Receive_u8(const uint8_t *payload, uint8_t len, int64_t rxUs);
+uint8_t stp_f_GetTargets_u8(uint16_t *positions);
+uint8_t stp_f_Active_u8(void);
+void stp_f_GetStats_v(msg_s_StpStats_t *stats);
+void stp_f_Restart_v(void);
+void stp_f_ApplyDue_v(int64_t nowUs);
+
+/**
+ * @brief Init function called once on boot
+ *
+ * The servos start with the local inputs, the host has to ask for the stream
+ *
+ * @return void
+ */
+void stp_f_Init_v(void)
+{
+  stp_g_Mode_e = STP_MODE_LOCAL;
+  stp_g_State_e = STP_STATE_OFF;
+  stp_g_DelayUs_u16 = STP_DEFAULT_DELAY_US;
+  stp_g_TimeoutMs_u16 = STP_DEFAULT_TIMEOUT_MS;
+
+  memset(&stp_g_Stats_s, 0, sizeof(stp_g_Stats_s));
+  stp_g_Stats_s.minLatencyUs_u32 = UINT32_MAX;
+  stp_g_HaveTransit_u8 = 0;
+
+  stp_f_Restart_v();
+}
+
+/**
+ * @brief Act on STP_CTRL from the host: switch between the local inputs and the stream, and set up the stream
+ *
+ * Payload: STP_CTRL, see firmware/msg/messages.py. Called from the telemetry task, which replies with STP_STATS
+ *
+ * @param payload received payload
+ * @param len payload length
+ * @return 1 if the request was valid, 0 if it was ignored
+ */
+uint8_t stp_f_Control_u8(const uint8_t *payload, uint8_t len)
+{
+  msg_s_StpCtrl_t l_ctrl_s;
+
+  if (!msg_f_UnpackStpCtrl_u8(&l_ctrl_s, payload, len) ||
+      ((l_ctrl_s.mode_u8 > STP_MODE_STREAM) && (l_ctrl_s.mode_u8 != STP_MODE_KEEP)))
+  {
+    return 0;
+  }
+
+  if (l_ctrl_s.mode_u8 == STP_MODE_KEEP)
+  {
+    return 1;
+  }
+
+  portENTER_CRITICAL(&stp_g_Lock_s);
+
+  stp_g_DelayUs_u16 = (l_ctrl_s.delayUs_u16 != 0) ? l_ctrl_s.delayUs_u16 : STP_DEFAULT_DELAY_US;
+  stp_g_TimeoutMs_u16 = (l_ctrl_s.timeoutMs_u16 != 0) ? l_ctrl_s.timeoutMs_u16 : STP_DEFAULT_TIMEOUT_MS;
+
+  if (l_ctrl_s.mode_u8 != stp_g_Mode_e)
+  {
+    stp_g_Mode_e = (stp_Mode_e)l_ctrl_s.mode_u8;
+    stp_g_State_e = (stp_g_Mode_e == STP_MODE_STREAM) ? STP_STATE_WAITING : STP_STATE_OFF;
+    stp_f_Restart_v();
+  }
+
+  portEXIT_CRITICAL(&stp_g_Lock_s);
+
+  return 1;
+}
+
+/**
+ * @brief Put a setpoint received from the host into the jitter buffer
+ *
+ * Payload: STP, see firmware/msg/messages.py. Called from the telemetry task. Setpoints are ignored
+ * unless the host asked for the stream first
+ *
+ * @param payload received payload
+ * @param len payload length
+ * @param rxUs when the setpoint arrived, in esp_timer_get_time() microseconds
+ * @return 1 if the payload was valid, 0 if it was not
+ */
+uint8_t stp_f_Receive_u8(const uint8_t *payload, uint8_t len, int64_t rxUs)
+{
+  msg_s_Stp_t l_stp_s;
+  stp_s_Entry_t *l_entry_ps;
+  uint32_t l_transitUs_u32;
+  uint8_t i;
+
+  if (!msg_f_UnpackStp_u8(&l_stp_s, payload, len))
+  {
+    return 0;
+  }
+
+  portENTER_CRITICAL(&stp_g_Lock_s);
+
+  if (stp_g_Mode_e != STP_MODE_STREAM)
+  {
+    portEXIT_CRITICAL(&stp_g_Lock_s);
+    return 1;
+  }
+
+  stp_g_Stats_s.received_u32++;
+
+  /* The host may send a setpoint again, or the same setpoint over two paths, only the newest one counts */
+  if (stp_g_HaveReceived_u8 && ((int16_t)(l_stp_s.seq_u16 - stp_g_Received_s.seq_u16) <= 0))
+  {
+    stp_g_Stats_s.dropped_u32++;
+    portEXIT_CRITICAL(&stp_g_Lock_s);
+    return 1;
+  }
+
+  /* Transit time including the unknown clock offset, the least delayed setpoint tells the offset */
+  l_transitUs_u32 = (uint32_t)rxUs - l_stp_s.hostUs_u32;
+  if (!stp_g_HaveReceived_u8 || ((int32_t)(l_transitUs_u32 - stp_g_OffsetUs_u32) < 0))
+  {
+    stp_g_OffsetUs_u32 = l_transitUs_u32;
+  }
+  if (!stp_g_HaveReceived_u8 || ((int32_t)(l_transitUs_u32 - stp_g_WindowMinUs_u32) < 0))
+  {
+    stp_g_WindowMinUs_u32 = l_transitUs_u32;
+  }
+  if (!stp_g_HaveReceived_u8)
+  {
+    stp_g_WindowStartUs_s64 = rxUs;
+  }
+  else if ((rxUs - stp_g_WindowStartUs_s64) >= STP_OFFSET_WINDOW_US)
+  {
+    stp_g_OffsetUs_u32 = stp_g_WindowMinUs_u32;
+    stp_g_WindowMinUs_u32 = l_transitUs_u32;
+    stp_g_WindowStartUs_s64 = rxUs;
+  }
+
+  if (!stp_g_HaveTransit_u8 || ((int32_t)(l_transitUs_u32 - stp_g_TransitMinUs_u32) < 0))
+  {
+    stp_g_TransitMinUs_u32 = l_transitUs_u32;
+  }
+  if (!stp_g_HaveTransit_u8 || ((int32_t)(l_transitUs_u32 - stp_g_TransitMaxUs_u32) > 0))
+  {
+    stp_g_TransitMaxUs_u32 = l_transitUs_u32;
+  }
+  stp_g_HaveTransit_u8 = 1;
+
+  /* Servos the setpoint doesn't mention stay where the previous one put them */
+  stp_g_Received_s.rxUs_s64 = rxUs;
+  stp_g_Received_s.hostUs_u32 = l_stp_s.hostUs_u32;
+  stp_g_Received_s.seq_u16 = l_stp_s.seq_u16;
+  stp_g_Received_s.dueUs_s64 = rxUs - (int32_t)(l_transitUs_u32 - stp_g_OffsetUs_u32) + stp_g_DelayUs_u16;
+  for (i = 0; (i < l_stp_s.targetsCount_u8) && (i < SRV_COUNT); i++)
+  {
+    stp_g_Received_s.positions_u16[i] = (l_stp_s.targets_s[i].position_u16 > STP_POSITION_MAX) ? STP_POSITION_MAX : l_stp_s.targets_s[i].position_u16;
+  }
+  stp_g_HaveReceived_u8 = 1;
+
+  if (stp_g_Received_s.dueUs_s64 < rxUs)
+  {
+    stp_g_Stats_s.late_u32++;
+  }
+
+  /* A full buffer means the servos fell behind, so the oldest setpoint is the one to lose */
+  if (stp_g_Depth_u8 == STP_BUFFER_LEN)
+  {
+    stp_g_Head_u8 = (stp_g_Head_u8 + 1) % STP_BUFFER_LEN;
+    stp_g_Depth_u8--;
+    stp_g_Stats_s.dropped_u32++;
+  }
+  l_entry_ps = &stp_g_Buffer_s[(stp_g_Head_u8 + stp_g_Depth_u8) % STP_BUFFER_LEN];
+  *l_entry_ps = stp_g_Received_s;
+  stp_g_Depth_u8++;
+
+  stp_g_State_e = STP_STATE_RUNNING;
+
+  portEXIT_CRITICAL(&stp_g_Lock_s);
+
+  return 1;
+}
+
+/**
+ * @brief Get the positions the servos should take now, called by the servos every cycle
+ *
+ * Takes the newest setpoint that is due, and checks the watchdog
+ *
+ * @param positions position of every servo (SRV_COUNT), in 0.01% of its range, only written while streaming
+ * @return 1 if the stream drives the servos, 0 if the local inputs do
+ */
+uint8_t stp_f_GetTargets_u8(uint16_t *positions)
+{
+  int64_t l_nowUs_s64 = esp_timer_get_time();
+  uint8_t l_streaming_u8 = 1;
+  uint8_t i;
+
+  portENTER_CRITICAL(&stp_g_Lock_s);
+
+  if ((stp_g_State_e == STP_STATE_RUNNING) &&
+      ((l_nowUs_s64 - stp_g_Received_s.rxUs_s64) > ((int64_t)stp_g_TimeoutMs_u16 * MILLISEC_TO_MICROSEC)))
+  {
+    /* The host is gone or stuck, the clocks may not match anymore once it is back */
+    stp_g_State_e = STP_STATE_TIMEOUT;
+    stp_g_Stats_s.timeouts_u32++;
+    stp_f_Restart_v();
+  }
+
+  switch (stp_g_State_e)
+  {
+  case STP_STATE_RUNNING:
+    /* The local inputs keep the servos until the first setpoint is due */
+    stp_f_ApplyDue_v(l_nowUs_s64);
+    if (stp_g_HaveApplied_u8)
+    {
+      memcpy(positions, stp_g_Applied_s.positions_u16, sizeof(stp_g_Applied_s.positions_u16));
+    }
+    else
+    {
+      l_streaming_u8 = 0;
+    }
+    break;
+  case STP_STATE_TIMEOUT:
+    for (i = 0; i < SRV_COUNT; i++)
+    {
+      positions[i] = STP_SAFE_POSITION;
+    }
+    break;
+  case STP_STATE_OFF:
+  case STP_STATE_WAITING:
+  default:
+    l_streaming_u8 = 0;
+    break;
+  }
+
+  portEXIT_CRITICAL(&stp_g_Lock_s);
+
+  return l_streaming_u8;
+}
+
+/**
+ * @brief Whether the host asked for the stream, so it gets STP_STATS every second
+ *
+ * @return 1 if streaming, 0 if the local inputs are used
+ */
+uint8_t stp_f_Active_u8(void)
+{
+  return (stp_g_Mode_e == STP_MODE_STREAM);
+}
+
+/**
+ * @brief Get the state and statistics of the stream for STP_STATS, and start a new stats period
+ *
+ * @param stats filled in, ready to be packed
+ * @return void
+ */
+void stp_f_GetStats_v(msg_s_StpStats_t *stats)
+{
+  int64_t l_nowUs_s64 = esp_timer_get_time();
+
+  portENTER_CRITICAL(&stp_g_Lock_s);
+
+  *stats = stp_g_Stats_s;
+  stats->mode_u8 = (uint8_t)stp_g_Mode_e;
+  stats->state_u8 = (uint8_t)stp_g_State_e;
+  stats->depth_u8 = stp_g_Depth_u8;
+  stats->delayUs_u16 = stp_g_DelayUs_u16;
+  stats->timeoutMs_u16 = stp_g_TimeoutMs_u16;
+
+  if (stp_g_HaveApplied_u8)
+  {
+    stats->lastSeq_u16 = stp_g_Applied_s.seq_u16;
+    stats->lastHostUs_u32 = stp_g_Applied_s.hostUs_u32;
+    stats->dwellUs_u32 = (uint32_t)(l_nowUs_s64 - stp_g_Applied_s.rxUs_s64);
+  }
+
+  stats->jitterUs_u32 = stp_g_HaveTransit_u8 ? (stp_g_TransitMaxUs_u32 - stp_g_TransitMinUs_u32) : 0;
+  if (stats->minLatencyUs_u32 == UINT32_MAX)
+  {
+    stats->minLatencyUs_u32 = 0;
+  }
+
+  stp_g_HaveTransit_u8 = 0;
+  stp_g_Stats_s.minLatencyUs_u32 = UINT32_MAX;
+  stp_g_Stats_s.maxLatencyUs_u32 = 0;
+
+  portEXIT_CRITICAL(&stp_g_Lock_s);
+}
+
+/**
+ * @brief Forget the buffered setpoints and the clock offset, the next setpoint starts the stream over
+ *
+ * Servos the first setpoint doesn't mention start in the safe posture. Call with stp_g_Lock_s taken
+ *
+ * @return void
+ */
+void stp_f_Restart_v(void)
+{
+  uint8_t i;
+
+  stp_g_Head_u8 = 0;
+  stp_g_Depth_u8 = 0;
+  stp_g_HaveReceived_u8 = 0;
+  stp_g_HaveApplied_u8 = 0;
+
+  for (i = 0; i < SRV_COUNT; i++)
+  {
+    stp_g_Received_s.positions_u16[i] = STP_SAFE_POSITION;
+  }
+}
+
+/**
+ * @brief Take every setpoint that is due off the buffer, the newest of them becomes the applied one
+ *
+ * Call with stp_g_Lock_s taken
+ *
+ * @param nowUs current esp_timer_get_time()
+ * @return void
+ */
+void stp_f_ApplyDue_v(int64_t nowUs)
+{
+  uint32_t l_latencyUs_u32;
+  uint8_t l_applied_u8 = 0;
+
+  while ((stp_g_Depth_u8 > 0) && (stp_g_Buffer_s[stp_g_Head_u8].dueUs_s64 <= nowUs))
+  {
+    stp_g_Applied_s = stp_g_Buffer_s[stp_g_Head_u8];
+    stp_g_Head_u8 = (stp_g_Head_u8 + 1) % STP_BUFFER_LEN;
+    stp_g_Depth_u8--;
+    l_applied_u8 = 1;
+  }
+
+  if (!l_applied_u8)
+  {
+    if (stp_g_HaveApplied_u8)
+    {
+      stp_g_Stats_s.holds_u32++;
+    }
+    return;
+  }
+
+  stp_g_HaveApplied_u8 = 1;
+
+  l_latencyUs_u32 = (uint32_t)(nowUs - stp_g_Applied_s.rxUs_s64);
+  if (l_latencyUs_u32 < stp_g_Stats_s.minLatencyUs_u32)
+  {
+    stp_g_Stats_s.minLatencyUs_u32 = l_latencyUs_u32;
+  }
+  if (l_latencyUs_u32 > stp_g_Stats_s.maxLatencyUs_u32)
+  {
+    stp_g_Stats_s.maxLatencyUs_u32 = l_latencyUs_u32;
+  }
+}
+
+#endif
@@ -0,0 +1,74 @@
+/**
+ * @file stp_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding stp.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef STP_E_H
+#define STP_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "config/project.h"
+#include "drivers/msg/msg_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+#define STP_TAG "STP"
+
+/**
+ * @brief Position of a servo at its maximum angle in a setpoint, the open posture (minimum angle) is 0
+ *
+ * @values in 0.01% of the servo range
+ */
+#define STP_POSITION_MAX 10000
+
+/**
+ * @brief Who drives the servos, set by the host with STP_CTRL
+ *
+ */
+typedef enum
+{
+  STP_MODE_LOCAL = 0,  /* Local inputs (pots, sensors, buttons), as selected by the hardware revision */
+  STP_MODE_STREAM,     /* Setpoints streamed by the host, once the first one arrived */
+  STP_MODE_KEEP = 0xFF /* In STP_CTRL: leave the mode and settings as they are, only report the state */
+} stp_Mode_e;
+
+/**
+ * @brief Where the setpoint stream stands
+ *
+ */
+typedef enum
+{
+  STP_STATE_OFF = 0, /* Local inputs drive the servos */
+  STP_STATE_WAITING, /* Streaming, but no setpoint arrived yet, the local inputs still drive the servos */
+  STP_STATE_RUNNING, /* Setpoints drive the servos */
+  STP_STATE_TIMEOUT  /* Setpoints stopped coming, the servos are held in the safe posture until the next one */
+} stp_State_e;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void stp_f_Init_v(void);
+extern uint8_t stp_f_Control_u8(const uint8_t *payload, uint8_t len);
+extern uint8_t stp_f_Receive_u8(const uint8_t *payload, uint8_t len, int64_t rxUs);
+extern uint8_t stp_f_GetTargets_u8(uint16_t *positions);
+extern uint8_t stp_f_Active_u8(void);
+extern void stp_f_GetStats_v(msg_s_StpStats_t *stats);
+
+#endif // STP_E_H
@@ -0,0 +1,154 @@
+/**
+ * @file stp_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding stp.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef STP_I_H
+#define STP_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "stp_e.h"
+#include "drivers/srv/srv_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Setpoints the jitter buffer holds
+ *
+ * Has to hold everything that arrives within the delay and one servo cycle, at the highest rate of 1kHz
+ *
+ * @values 1..255
+ */
+#define STP_BUFFER_LEN 64
+
+/**
+ * @brief Default delay of the jitter buffer, used until the host sets another one
+ *
+ * How long after the least delayed setpoint arrived a setpoint is applied, so setpoints that took longer
+ * through the host OS and USB adapter still get applied at the same spacing as they were sent
+ *
+ * @values in microseconds, more than the jitter of the host, 0..65535
+ */
+#define STP_DEFAULT_DELAY_US 20000
+
+/**
+ * @brief Default watchdog timeout, used until the host sets another one
+ *
+ * @values in milliseconds, 1..65535
+ */
+#define STP_DEFAULT_TIMEOUT_MS 100
+
+/**
+ * @brief Position of every servo in the safe posture, taken when the setpoints stop coming
+ *
+ * @values 0 (open, minimum angle)..STP_POSITION_MAX
+ */
+#define STP_SAFE_POSITION 0
+
+/**
+ * @brief How long the shortest transit time is looked for before it replaces the clock offset
+ *
+ * The host and device clocks drift apart, so the offset is taken from the last window only, a faster
+ * setpoint than any before lowers it right away
+ *
+ * @values in microseconds
+ */
+#define STP_OFFSET_WINDOW_US 1000000
+
+/**
+ * @brief One setpoint waiting in the jitter buffer, all times in esp_timer_get_time() microseconds
+ *
+ */
+typedef struct
+{
+  int64_t dueUs_s64;                 /* When it is applied */
+  int64_t rxUs_s64;                  /* When it arrived */
+  uint32_t hostUs_u32;               /* Host time it was sent at */
+  uint16_t seq_u16;                  /* Its sequence number */
+  uint16_t positions_u16[SRV_COUNT]; /* Position of every servo, in 0.01% */
+} stp_s_Entry_t;
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Guards all the state below, written by the telemetry task on core 0 and read by the servos on core 1
+ *
+ */
+extern portMUX_TYPE stp_g_Lock_s;
+
+/**
+ * @brief Current mode and state, and the settings of the stream
+ *
+ */
+extern stp_Mode_e stp_g_Mode_e;
+extern stp_State_e stp_g_State_e;
+extern uint16_t stp_g_DelayUs_u16;
+extern uint16_t stp_g_TimeoutMs_u16;
+
+/**
+ * @brief Jitter buffer, a ring of setpoints in the order they arrived
+ *
+ */
+extern stp_s_Entry_t stp_g_Buffer_s[STP_BUFFER_LEN];
+extern uint8_t stp_g_Head_u8;
+extern uint8_t stp_g_Depth_u8;
+
+/**
+ * @brief The setpoint received last, setpoints that don't set every servo take the rest from it
+ *
+ */
+extern stp_s_Entry_t stp_g_Received_s;
+extern uint8_t stp_g_HaveReceived_u8;
+
+/**
+ * @brief The setpoint applied last
+ *
+ */
+extern stp_s_Entry_t stp_g_Applied_s;
+extern uint8_t stp_g_HaveApplied_u8;
+
+/**
+ * @brief Device minus host time of the least delayed setpoint (the clock offset), and of the current window
+ *
+ * Both wrap around with the 32 bit host time, so they are only ever compared through their difference
+ */
+extern uint32_t stp_g_OffsetUs_u32;
+extern uint32_t stp_g_WindowMinUs_u32;
+extern int64_t stp_g_WindowStartUs_s64;
+
+/**
+ * @brief Counters and latencies sent in STP_STATS (minLatencyUs_u32 is UINT32_MAX while nothing was applied
+ * in the current stats period), and the spread of the transit times in that period
+ *
+ */
+extern msg_s_StpStats_t stp_g_Stats_s;
+extern uint32_t stp_g_TransitMinUs_u32;
+extern uint32_t stp_g_TransitMaxUs_u32;
+extern uint8_t stp_g_HaveTransit_u8;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void stp_f_Restart_v(void);
+extern void stp_f_ApplyDue_v(int64_t nowUs);
+
+#endif // STP_I_H
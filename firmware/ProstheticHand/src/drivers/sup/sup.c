@@ -0,0 +1,395 @@
+/**
+ * @file sup.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Safety supervisor software component
+ *
+ * Watches the control loop from outside of it: a periodic esp_timer (esp_timer task, core 0, above every task
+ * of this program) checks every SUP_PERIOD_US that
+ *  - the servo outputs were updated within SUP_HEARTBEAT_TIMEOUT_US (srv_f_Handle_v() beats after writing them),
+ *    so the main OS on core 1 hanging in any module is caught
+ *  - every output lies within the duty cycles of its minimum angle and travel (min_angle_u16 / max_angle_u16),
+ *    still after SUP_RANGE_BEATS output updates, as the travel can change (CFG_SET) while an output is calculated
+ *  - the outputs don't move back and forth faster than a hand can, which is what garbage inputs look like:
+ *    by how far they move (SUP_TRAVEL_LIMIT), or while they follow the sensor threshold and jump between two
+ *    positions on purpose, by how often they turn around (SUP_REVERSAL_LIMIT)
+ *  - the battery is not critically low, and its measurement makes sense
+ *  - no other module asked for the safe posture with sup_f_Trip_v()
+ * On the first violation it writes the open posture (minimum angle) to the servo PWM itself, from the timer,
+ * without waiting for the main OS, and holds it until a reset. srv_f_Handle_v() then only sends the open
+ * posture as well, and LED01 shows the safe state blink code.
+ *
+ * Worst case from the last good output update to the safe posture on the PWM: SUP_HEARTBEAT_TIMEOUT_US plus one
+ * SUP_PERIOD_US (31ms), the servos see it with their next pulse, at most one PWM period (20ms) later. An output out of
+ * range is caught after the next two output updates (~20ms).
+ * REV04 drives the full PWM range on purpose, so only the heartbeat and the battery are checked there.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "sup_e.h"
+#include "sup_i.h"
+
+/* Other components used here */
+#include "drivers/bat/bat_e.h"
+#include "drivers/led/led_e.h"
+#include "drivers/srv/srv_e.h"
+#include "drivers/trc/trc_e.h"
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Every fault seen since boot, latched until reset
+ *
+ * @values 0 - servos run normally, otherwise sup_Fault_e bits
+ */
+volatile uint8_t sup_g_Faults_u8 = 0;
+
+/**
+ * @brief When the servo outputs were updated last, and whether they ever were
+ *
+ * @values lower 32 bits of esp_timer_get_time(), 0 - not yet, 1 - beating
+ */
+volatile uint32_t sup_g_LastBeatUs_u32 = 0;
+volatile uint8_t sup_g_Armed_u8 = 0;
+
+/**
+ * @brief Output updates since boot
+ *
+ * @values counts up, wraps
+ */
+volatile uint32_t sup_g_Beats_u32 = 0;
+
+/**
+ * @brief Longest time between two output updates seen so far
+ *
+ * @values in microseconds
+ */
+uint32_t sup_g_MaxBeatGapUs_u32 = 0;
+
+/**
+ * @brief Outputs at the last check, and the travel budget used up (see SUP_TRAVEL_LIMIT)
+ *
+ * @values duty cycle steps
+ */
+uint16_t sup_g_LastOutput_u16[SRV_COUNT];
+uint32_t sup_g_Travel_u32 = 0;
+uint32_t sup_g_MaxTravel_u32 = 0;
+
+/**
+ * @brief Direction each output moved in last, and the reversal budget used up (see SUP_REVERSAL_LIMIT)
+ *
+ * @values -1 - down, 0 - not moved yet, 1 - up; budget
+ */
+int8_t sup_g_LastDir_s8[SRV_COUNT];
+uint32_t sup_g_Reversals_u32 = 0;
+uint32_t sup_g_MaxReversals_u32 = 0;
+
+/**
+ * @brief Whether the last check found an output out of range, and sup_g_Beats_u32 when it first did
+ *
+ * @values 0 - all in range, 1 - out of range since sup_g_RangeBeats_u32
+ */
+uint8_t sup_g_RangeSeen_u8 = 0;
+uint32_t sup_g_RangeBeats_u32 = 0;
+
+/**
+ * @brief Checks in a row the battery was critically low
+ *
+ * @values 0..SUP_BAT_DEBOUNCE_MS
+ */
+uint16_t sup_g_BatLowMs_u16 = 0;
+
+/**
+ * @brief Faults other modules reported with sup_f_Trip_v(), taken over by the next check, and its lock
+ *
+ * @values sup_Fault_e bits
+ */
+volatile uint8_t sup_g_Requested_u8 = 0;
+portMUX_TYPE sup_g_Lock_s = portMUX_INITIALIZER_UNLOCKED;
+
+/**
+ * @brief When the supervisor tripped
+ *
+ * @values lower 32 bits of esp_timer_get_time(), valid while sup_g_Faults_u8 isn't 0
+ */
+uint32_t sup_g_TripUs_u32 = 0;
+
+/**
+ * @brief Periodic timer of the checks
+ *
+ */
+esp_timer_handle_t sup_g_Timer_s;
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+void sup_f_Init_v(void);
+void sup_f_Heartbeat_v(void);
+uint8_t sup_f_Safe_u8(void);
+void sup_f_Trip_v(sup_Fault_e fault);
+
+void sup_f_Check_v(void *arg);
+uint8_t sup_f_CheckOutputs_u8(void);
+uint8_t sup_f_CheckBattery_u8(void);
+
+#ifdef SERIAL_DEBUG
+void sup_f_SerialDebug_v(void);
+#endif
+
+/**
+ * @brief Init function called once on boot, after the servos are set up
+ *
+ * Starts the checks right away, the heartbeat is only checked from the first output update on,
+ * so the rest of the boot can take as long as it needs
+ *
+ * @return void
+ */
+void sup_f_Init_v(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < SRV_COUNT; i++)
+  {
+    sup_g_LastOutput_u16[i] = srv_g_Output_u16[i];
+  }
+
+  esp_timer_create_args_t supCheck_TimerArgs = {
+      .callback = sup_f_Check_v,
+      .arg = NULL,
+      .dispatch_method = ESP_TIMER_TASK,
+      .name = "sup_f_Check_v",
+      .skip_unhandled_events = true};
+  ESP_ERROR_CHECK(esp_timer_create(&supCheck_TimerArgs, &sup_g_Timer_s));
+  ESP_ERROR_CHECK(esp_timer_start_periodic(sup_g_Timer_s, SUP_PERIOD_US));
+}
+
+/**
+ * @brief Called by the control loop every time it updated the servo outputs
+ *
+ * @return void
+ */
+void SUP_IRAM_ATTR sup_f_Heartbeat_v(void)
+{
+  sup_g_LastBeatUs_u32 = (uint32_t)esp_timer_get_time();
+  sup_g_Beats_u32++;
+  sup_g_Armed_u8 = 1;
+}
+
+/**
+ * @brief Whether the servos are held in the safe posture
+ *
+ * @return 1 after any fault (until reset), 0 otherwise
+ */
+uint8_t SUP_IRAM_ATTR sup_f_Safe_u8(void)
+{
+  return (sup_g_Faults_u8 != 0);
+}
+
+/**
+ * @brief Put the servos into the safe posture because of a fault another module found
+ *
+ * Only notes the fault, the next check (within SUP_PERIOD_US) trips on it like on its own,
+ * so the posture is always written from the timer
+ *
+ * @param fault why
+ * @return void
+ */
+void SUP_IRAM_ATTR sup_f_Trip_v(sup_Fault_e fault)
+{
+  portENTER_CRITICAL(&sup_g_Lock_s);
+  sup_g_Requested_u8 |= (uint8_t)fault;
+  portEXIT_CRITICAL(&sup_g_Lock_s);
+}
+
+/**
+ * @brief Timer callback, runs every check and trips on the first fault
+ *
+ * @param arg - unused
+ *
+ * @return void
+ */
+void SUP_IRAM_ATTR sup_f_Check_v(void *arg)
+{
+  uint32_t l_lastBeatUs_u32 = sup_g_LastBeatUs_u32; /* before now, so a beat in between can't look like it's from the future */
+  uint32_t l_nowUs_u32 = (uint32_t)esp_timer_get_time();
+  uint32_t l_gapUs_u32;
+  uint8_t l_faults_u8 = 0;
+
+  trc_f_Record_v(TRC_EV_ISR_ENTER, TRC_ISR_SUP, 0);
+
+  if (sup_g_Armed_u8)
+  {
+    l_gapUs_u32 = l_nowUs_u32 - l_lastBeatUs_u32;
+    if (l_gapUs_u32 > sup_g_MaxBeatGapUs_u32)
+    {
+      sup_g_MaxBeatGapUs_u32 = l_gapUs_u32;
+    }
+    if (l_gapUs_u32 > SUP_HEARTBEAT_TIMEOUT_US)
+    {
+      l_faults_u8 |= SUP_FAULT_HEARTBEAT;
+    }
+  }
+
+  l_faults_u8 |= sup_f_CheckOutputs_u8();
+  l_faults_u8 |= sup_f_CheckBattery_u8();
+  l_faults_u8 |= sup_g_Requested_u8;
+
+  if (l_faults_u8 && !sup_g_Faults_u8)
+  {
+    sup_g_Faults_u8 = l_faults_u8;
+    sup_g_TripUs_u32 = l_nowUs_u32;
+
+    /* Posture first, the rest can wait */
+    srv_f_SafeState_v();
+    led_f_SetPattern_v(LED_ID_01, LED_PATTERN_CODE, SUP_LED_CODE_SAFE_STATE);
+    trc_f_Record_v(TRC_EV_MARK, TRC_MARK_SAFE_STATE, l_faults_u8);
+    ESP_LOGE(SUP_TAG, "Safe state, faults 0x%02x", l_faults_u8);
+    trc_f_Record_v(TRC_EV_ISR_EXIT, TRC_ISR_SUP, 0);
+    return;
+  }
+
+  sup_g_Faults_u8 |= l_faults_u8;
+  if (sup_g_Faults_u8)
+  {
+    /* Again every check, so an update the control loop had already started when it tripped can't stick */
+    srv_f_SafeState_v();
+  }
+
+  trc_f_Record_v(TRC_EV_ISR_EXIT, TRC_ISR_SUP, 0);
+}
+
+/**
+ * @brief Range and rate of change of the servo outputs
+ *
+ * The limits are the ones in effect now, an output the control loop calculated before the travel was reduced
+ * lies outside of them until it is updated. So an output only counts as out of range if it still is after
+ * SUP_RANGE_BEATS updates, the last of them calculated entirely with the new limits
+ *
+ * @return SUP_FAULT_RANGE and/or SUP_FAULT_RATE, 0 if the outputs look fine
+ */
+uint8_t SUP_IRAM_ATTR sup_f_CheckOutputs_u8(void)
+{
+  uint8_t i;
+  uint8_t l_faults_u8 = 0;
+  uint8_t l_outOfRange_u8 = 0;
+  uint32_t l_beats_u32 = sup_g_Beats_u32; /* before the outputs, so they are at least as new as the count */
+  uint16_t l_output_u16;
+  uint16_t l_minDuty_u16;
+  uint16_t l_maxDuty_u16;
+  int8_t l_dir_s8;
+
+  for (i = 0; i < SRV_COUNT; i++)
+  {
+    l_output_u16 = srv_g_Output_u16[i];
+
+    if (srv_f_GetDutyLimits_u8(i, &l_minDuty_u16, &l_maxDuty_u16) &&
+        (((l_output_u16 + SUP_DUTY_TOLERANCE) < l_minDuty_u16) || (l_output_u16 > (l_maxDuty_u16 + SUP_DUTY_TOLERANCE))))
+    {
+      l_outOfRange_u8 = 1;
+    }
+
+    /* Servos that follow their input smoothly use up the travel budget, the ones that jump between two positions
+       the reversal budget */
+    if (srv_f_Continuous_u8(i))
+    {
+      sup_g_Travel_u32 += (l_output_u16 > sup_g_LastOutput_u16[i]) ? (l_output_u16 - sup_g_LastOutput_u16[i]) : (sup_g_LastOutput_u16[i] - l_output_u16);
+    }
+    else if (srv_g_Threshold_u8 && (l_output_u16 != sup_g_LastOutput_u16[i]))
+    {
+      l_dir_s8 = (l_output_u16 > sup_g_LastOutput_u16[i]) ? 1 : -1;
+      if (sup_g_LastDir_s8[i] == -l_dir_s8)
+      {
+        sup_g_Reversals_u32 += SUP_REVERSAL_WEIGHT;
+      }
+      sup_g_LastDir_s8[i] = l_dir_s8;
+    }
+    sup_g_LastOutput_u16[i] = l_output_u16;
+  }
+
+  if (!l_outOfRange_u8)
+  {
+    sup_g_RangeSeen_u8 = 0;
+  }
+  else if (!sup_g_RangeSeen_u8)
+  {
+    sup_g_RangeSeen_u8 = 1;
+    sup_g_RangeBeats_u32 = l_beats_u32;
+  }
+  else if ((l_beats_u32 - sup_g_RangeBeats_u32) >= SUP_RANGE_BEATS)
+  {
+    l_faults_u8 |= SUP_FAULT_RANGE;
+  }
+
+  sup_g_Travel_u32 = (sup_g_Travel_u32 > SUP_TRAVEL_LEAK) ? (sup_g_Travel_u32 - SUP_TRAVEL_LEAK) : 0;
+  if (sup_g_Travel_u32 > sup_g_MaxTravel_u32)
+  {
+    sup_g_MaxTravel_u32 = sup_g_Travel_u32;
+  }
+  if (sup_g_Travel_u32 > SUP_TRAVEL_LIMIT)
+  {
+    l_faults_u8 |= SUP_FAULT_RATE;
+  }
+
+  sup_g_Reversals_u32 = (sup_g_Reversals_u32 > SUP_REVERSAL_LEAK) ? (sup_g_Reversals_u32 - SUP_REVERSAL_LEAK) : 0;
+  if (sup_g_Reversals_u32 > sup_g_MaxReversals_u32)
+  {
+    sup_g_MaxReversals_u32 = sup_g_Reversals_u32;
+  }
+  if (sup_g_Reversals_u32 > SUP_REVERSAL_LIMIT)
+  {
+    l_faults_u8 |= SUP_FAULT_RATE;
+  }
+
+  return l_faults_u8;
+}
+
+/**
+ * @brief Battery voltage, no battery connected (powered over USB) is fine
+ *
+ * @return SUP_FAULT_BATTERY or 0
+ */
+uint8_t SUP_IRAM_ATTR sup_f_CheckBattery_u8(void)
+{
+  float32_t l_voltage_f32 = bat_g_BatVoltage_f32;
+
+  /* Also true for NaN */
+  if (!(l_voltage_f32 < SUP_BAT_MAX_V))
+  {
+    return SUP_FAULT_BATTERY;
+  }
+
+  if ((l_voltage_f32 > BAT_PRESENT_V) && (l_voltage_f32 < BAT_CRITICAL_V))
+  {
+    if (sup_g_BatLowMs_u16 < SUP_BAT_DEBOUNCE_MS)
+    {
+      sup_g_BatLowMs_u16++;
+    }
+  }
+  else
+  {
+    sup_g_BatLowMs_u16 = 0;
+  }
+
+  return (sup_g_BatLowMs_u16 >= SUP_BAT_DEBOUNCE_MS) ? SUP_FAULT_BATTERY : 0;
+}
+
+#ifdef SERIAL_DEBUG
+void sup_f_SerialDebug_v(void)
+{
+  ESP_LOGD(SUP_TAG, "faults = 0x%02x, tripped at %lu us, max beat gap = %lu us, travel = %lu (max %lu), reversals = %lu (max %lu)", sup_g_Faults_u8, sup_g_TripUs_u32, sup_g_MaxBeatGapUs_u32, sup_g_Travel_u32, sup_g_MaxTravel_u32, sup_g_Reversals_u32, sup_g_MaxReversals_u32);
+}
+#endif
@@ -0,0 +1,76 @@
+/**
+ * @file sup_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding sup.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef SUP_E_H
+#define SUP_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "config/project.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+#define SUP_TAG "SUP"
+
+/**
+ * @brief Blink code of LED01 while the servos are held in the safe posture, after the battery codes of main
+ *
+ * @values 1..LED_CODE_MAX
+ */
+#define SUP_LED_CODE_SAFE_STATE 4
+
+/**
+ * @brief Reasons the supervisor put the servos into the safe posture, as bits of sup_g_Faults_u8
+ *
+ */
+typedef enum
+{
+  SUP_FAULT_HEARTBEAT = 0x01, /* The servo outputs were not updated for SUP_HEARTBEAT_TIMEOUT_US */
+  SUP_FAULT_RANGE = 0x02,     /* A servo output left the duty cycles of its minimum angle and travel */
+  SUP_FAULT_RATE = 0x04,      /* The servo outputs moved back and forth faster than a hand can */
+  SUP_FAULT_BATTERY = 0x08,   /* Battery critically low for SUP_BAT_DEBOUNCE_MS, or an impossible reading */
+  SUP_FAULT_DEADLINE = 0x10   /* A slot of the main OS kept overrunning its budget, see DLM */
+} sup_Fault_e;
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Every fault seen since boot, latched until reset
+ *
+ * @values 0 - servos run normally, otherwise sup_Fault_e bits and the servos are held in the open posture
+ */
+extern volatile uint8_t sup_g_Faults_u8;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void sup_f_Init_v(void);
+extern void sup_f_Heartbeat_v(void);
+extern uint8_t sup_f_Safe_u8(void);
+extern void sup_f_Trip_v(sup_Fault_e fault);
+
+#ifdef SERIAL_DEBUG
+extern void sup_f_SerialDebug_v(void);
+#endif
+
+#endif // SUP_E_H
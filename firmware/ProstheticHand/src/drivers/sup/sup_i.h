@@ -0,0 +1,108 @@
+/**
+ * @file sup_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding sup.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef SUP_I_H
+#define SUP_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "sup_e.h"
+
+#include "esp_timer.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief How often the supervisor checks
+ *
+ * @values in microseconds
+ */
+#define SUP_PERIOD_US 1000
+
+/**
+ * @brief Longest the servo outputs may go without an update before the control loop counts as hung
+ *
+ * The outputs are updated every main cycle (10ms), so this allows two missed cycles
+ *
+ * @values in microseconds, more than one main cycle
+ */
+#define SUP_HEARTBEAT_TIMEOUT_US 30000
+
+/**
+ * @brief Output updates an output has to stay out of range for before it trips
+ *
+ * The update running when the travel is reduced may still have calculated some outputs with the old one,
+ * the one after it has all of them from the new travel
+ *
+ * @values output updates (main cycles, 10ms)
+ */
+#define SUP_RANGE_BEATS 2
+
+/**
+ * @brief Duty cycle steps an output may lie outside its limits, for the rounding of the float calculations
+ *
+ * @values duty cycle steps
+ */
+#define SUP_DUTY_TOLERANCE 4
+
+/**
+ * @brief Travel budget of the outputs: every check adds how far the outputs moved and takes off SUP_TRAVEL_LEAK,
+ * the fault trips when more than SUP_TRAVEL_LIMIT is left
+ *
+ * A single jump over the whole travel (about 300 steps) or turning a pot fast stays far below the limit, outputs
+ * jumping back and forth every cycle because of garbage inputs trip it within ~50ms. Outputs that follow the sensor
+ * threshold (REV03) jump over the whole travel on purpose, they count their reversals instead (SUP_REVERSAL_LIMIT)
+ *
+ * @values duty cycle steps per check, and duty cycle steps
+ */
+#define SUP_TRAVEL_LEAK 2
+#define SUP_TRAVEL_LIMIT 1500
+
+/**
+ * @brief Reversal budget of the outputs that follow the sensor threshold: every time one of them starts moving
+ * the other way adds SUP_REVERSAL_WEIGHT, every check takes off SUP_REVERSAL_LEAK, the fault trips when more than
+ * SUP_REVERSAL_LIMIT is left
+ *
+ * Each reversal is remembered for half a second, so opening and closing the hand once a second never adds up,
+ * and up to 8 reversals in a row (a hand opening and closing four times in quick succession) are fine.
+ * A sensor chattering around its threshold every main cycle trips it within ~90ms, four times a second within ~4s
+ *
+ * @values budget per reversal, budget per check, and budget
+ */
+#define SUP_REVERSAL_WEIGHT 1000
+#define SUP_REVERSAL_LEAK 2
+#define SUP_REVERSAL_LIMIT 8000
+
+/**
+ * @brief How long the battery has to stay critically low before it trips, so the voltage sagging while
+ * the servos start up doesn't
+ *
+ * @values in checks (milliseconds)
+ */
+#define SUP_BAT_DEBOUNCE_MS 500
+
+/**
+ * @brief Anything above this can't come from the 4 cell battery, so the measurement is broken
+ *
+ * @values in volts, 4.2V per cell is 16.8V
+ */
+#define SUP_BAT_MAX_V 18.0
+
+#endif // SUP_I_H
@@ -0,0 +1,1149 @@
+/**
+ * @file tlm.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Telemetry link software component
+ *
+ * Binary, framed telemetry over its own UART, so the data can be read by a program on the PC
+ * instead of parsing the human readable serial debug output. It runs as a separate task on
+ * core 0 next to the serial debug task, so the main OS on core 1 never waits for it.
+ *
+ * Besides the data itself it keeps statistics about the link (throughput, dropped frames,
+ * how long frames wait in the TX buffer), and echoes ping frames back with a device timestamp
+ * so the host can measure the round trip of the whole device-to-host path.
+ *
+ * The STM32 board is wired to a second UART, the peer link. Our clock is the shared timebase: the STM32 board keeps
+ * asking for our time (TSY_REQ, answered with the receive and send timestamps like NTP), estimates its offset and
+ * drift against it and reports its clock model back (TSY_STATS), which tlm_f_PeerToLocalUs_s64() uses to convert
+ * its timestamps. Received bursts are dated by an interrupt on the start bit of their first byte and their length on
+ * the wire, not by the task, whose wake-up latency varies by tens of microseconds or more while core 0 is busy.
+ * The host reaches the STM32 board through us: its UPD frames are relayed to the peer link, and every frame of the
+ * board but the time sync goes to the host transports, so the host tools keep their UART while the boards sync.
+ *
+ * The frames themselves are built and parsed by lnk, the UART is only one of its transports (BLE can be another).
+ * Periodic frames go to every connected transport, PONG and TSY_RESP only to the transport the request came on.
+ * Each transport keeps its own statistics, LINK_STATS is sent on each of them with its own numbers.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "tlm_e.h"
+#include "tlm_i.h"
+
+#include "string.h"
+
+/* Other components used here */
+#include "main_e.h"
+#include "drivers/msg/msg_e.h"
+#include "drivers/lnk/lnk_e.h"
+#include "drivers/cfg/cfg_e.h"
+#include "drivers/sns/sns_e.h"
+#include "drivers/pot/pot_e.h"
+#include "drivers/bat/bat_e.h"
+#include "drivers/srv/srv_e.h"
+#include "drivers/stp/stp_e.h"
+#include "drivers/osm/osm_e.h"
+#include "drivers/trc/trc_e.h"
+#include "drivers/err/err_e.h"
+
+#ifdef TELEMETRY
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief The telemetry UART as a transport of the link, always connected as there is no way to tell,
+ * and trusted as whoever is on it is wired to the hand
+ *
+ */
+lnk_s_Transport_t tlm_g_Uart_s = {
+    .name_pc = "UART",
+    .write_pf = tlm_f_UartWrite_u8,
+    .flush_pf = 0,
+    .poll_pf = 0,
+    .connected_u8 = 1,
+    .trusted_u8 = 1};
+
+/**
+ * @brief The UART to the STM32 board, a transport that is not added to the link, so only the frames meant for
+ * the board go there. Always connected and trusted, the board is wired to it
+ *
+ */
+lnk_s_Transport_t tlm_g_Peer_s = {
+    .name_pc = "Peer",
+    .write_pf = tlm_f_PeerWrite_u8,
+    .flush_pf = 0,
+    .poll_pf = 0,
+    .connected_u8 = 1,
+    .trusted_u8 = 1};
+
+/**
+ * @brief Both UARTs, see tlm_Uart_e
+ *
+ */
+tlm_g_UartTyp_t tlm_g_Uarts_s[TLM_UART_COUNT] = {
+    {.port_e = TLM_UART_PORT, .txPin_e = TLM_UART_TX_PIN, .rxPin_e = TLM_UART_RX_PIN, .transport_ps = &tlm_g_Uart_s},
+    {.port_e = TLM_PEER_UART_PORT, .txPin_e = TLM_PEER_TX_PIN, .rxPin_e = TLM_PEER_RX_PIN, .transport_ps = &tlm_g_Peer_s}};
+
+/**
+ * @brief Transport the frame being handled came on, receive errors are counted there
+ *
+ */
+lnk_s_Transport_t *tlm_g_Rx_ps = &tlm_g_Uart_s;
+
+/**
+ * @brief Clock model of the peer, see tlm_g_PeerSyncTyp_t
+ *
+ */
+tlm_g_PeerSyncTyp_t tlm_g_PeerSync_s;
+
+/**
+ * @brief Event queues of both UART drivers, the telemetry task wakes up on them
+ *
+ */
+QueueSetHandle_t tlm_g_UartQueues_s;
+
+/**
+ * @brief Subscription of every signal, only touched by the telemetry task
+ *
+ */
+tlm_g_SubscriptionTyp_t tlm_g_Subs_s[TLM_SIG_COUNT];
+
+/**
+ * @brief Guards tlm_g_PeerSync_s, which is written by the telemetry task and read from both cores
+ *
+ */
+portMUX_TYPE tlm_g_PeerSyncLock_s = portMUX_INITIALIZER_UNLOCKED;
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+void tlm_f_Init_v(void);
+void tlm_f_Task_v(void *arg);
+uint8_t tlm_f_SendFrame_u8(tlm_MsgId_e id, const uint8_t *payload, uint8_t len);
+int64_t tlm_f_PeerToLocalUs_s64(int64_t peerUs);
+
+void tlm_f_InitUart_v(tlm_g_UartTyp_t *uart);
+void tlm_f_RxStartIsr_v(void *arg);
+void tlm_f_HandleEvent_v(tlm_g_UartTyp_t *uart, const uart_event_t *event);
+void tlm_f_Receive_v(tlm_g_UartTyp_t *uart);
+uint8_t tlm_f_Write_u8(tlm_g_UartTyp_t *uart, const uint8_t *frame, uint16_t len);
+uint8_t tlm_f_UartWrite_u8(const uint8_t *frame, uint16_t len);
+uint8_t tlm_f_PeerWrite_u8(const uint8_t *frame, uint16_t len);
+void tlm_f_HandleFrame_v(lnk_s_Transport_t *transport, uint8_t id, const uint8_t *payload, uint8_t len);
+uint8_t tlm_f_SendRTM_u8(void);
+void tlm_f_Subscribe_v(const uint8_t *payload, uint8_t len);
+void tlm_f_SendSubState_v(tlm_Signal_e signal);
+void tlm_f_SendSignals_v(void);
+void tlm_f_FlushSignals_v(const uint8_t *records, uint8_t len, const uint8_t *bytes);
+uint8_t tlm_f_ReadSignal_u8(tlm_Signal_e signal, uint16_t *values);
+void tlm_f_SendStpStats_v(void);
+void tlm_f_SendOsStats_v(void);
+void tlm_f_SendErrStats_v(void);
+void tlm_f_SendTrace_v(uint8_t sendTasks);
+void tlm_f_SendLinkStats_v(lnk_s_Transport_t *transport);
+void tlm_f_SendTimeSync_v(const uint8_t *payload, uint8_t len);
+void tlm_f_StorePeerSync_v(const uint8_t *payload, uint8_t len);
+
+#ifdef SERIAL_DEBUG
+void tlm_f_SerialDebug_v(void);
+#endif
+
+/**
+ * @brief Initialize function to be called once on startup/boot
+ *
+ * Bring up the UART to the host and the one to the STM32 board, and add the first to the link.
+ * Other transports add themselves after this
+ *
+ * @return void
+ */
+void tlm_f_Init_v(void)
+{
+  uint8_t i;
+
+  /* Another module may have installed the service */
+  if (gpio_install_isr_service(0) == ESP_ERR_INVALID_STATE)
+  {
+    ESP_LOGD(TLM_TAG, "GPIO interrupt service already installed");
+  }
+
+  /* Every event of both queues has a place in the set */
+  tlm_g_UartQueues_s = xQueueCreateSet(TLM_UART_COUNT * TLM_UART_EVENT_QUEUE_LEN);
+  configASSERT(tlm_g_UartQueues_s != NULL);
+
+  for (i = 0; i < TLM_UART_COUNT; i++)
+  {
+    tlm_f_InitUart_v(&tlm_g_Uarts_s[i]);
+  }
+
+  lnk_f_Init_v(tlm_f_HandleFrame_v);
+  lnk_f_Add_u8(&tlm_g_Uart_s);
+
+  memset(&tlm_g_PeerSync_s, 0, sizeof(tlm_g_PeerSync_s));
+
+  /* Nothing but the runtime measurement is sent until the host asks for more */
+  memset(tlm_g_Subs_s, 0, sizeof(tlm_g_Subs_s));
+  tlm_g_Subs_s[TLM_SIG_RTM].mode_e = TLM_SUB_PERIODIC;
+  tlm_g_Subs_s[TLM_SIG_RTM].periodTicks_u16 = TLM_RTM_PERIOD_MS / TLM_TASK_PERIOD_MS;
+}
+
+/**
+ * @brief Install the driver of one UART with ring buffers and an event queue, and watch its RX pin for the start
+ * of a burst
+ *
+ * @param uart the UART, see tlm_g_Uarts_s
+ * @return void
+ */
+void tlm_f_InitUart_v(tlm_g_UartTyp_t *uart)
+{
+  uart_config_t tlm_uart_config = {
+      .baud_rate = TLM_UART_BAUD,
+      .data_bits = UART_DATA_8_BITS,
+      .parity = UART_PARITY_DISABLE,
+      .stop_bits = UART_STOP_BITS_1,
+      .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+      .source_clk = UART_SCLK_DEFAULT};
+
+  ESP_ERROR_CHECK(uart_driver_install(uart->port_e, TLM_UART_RX_BUF_SIZE, TLM_UART_TX_BUF_SIZE, TLM_UART_EVENT_QUEUE_LEN, &uart->queue_s, 0));
+  ESP_ERROR_CHECK(uart_param_config(uart->port_e, &tlm_uart_config));
+  ESP_ERROR_CHECK(uart_set_pin(uart->port_e, uart->txPin_e, uart->rxPin_e, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE));
+  ESP_ERROR_CHECK(uart_set_rx_timeout(uart->port_e, TLM_UART_RX_TOUT));
+
+  /* Still empty, so it can join the set */
+  configASSERT(xQueueAddToSet(uart->queue_s, tlm_g_UartQueues_s) == pdPASS);
+
+  /* The pin stays routed to the UART, the interrupt only watches it */
+  ESP_ERROR_CHECK(gpio_set_intr_type(uart->rxPin_e, GPIO_INTR_NEGEDGE));
+  ESP_ERROR_CHECK(gpio_isr_handler_add(uart->rxPin_e, tlm_f_RxStartIsr_v, uart));
+  ESP_ERROR_CHECK(gpio_intr_enable(uart->rxPin_e));
+}
+
+/**
+ * @brief Telemetry task, runs on core 0 next to the serial debug task
+ *
+ * Reads and handles frames from the host and the STM32 board as soon as their UART reports them, and sends
+ * the periodic frames.
+ * Transports that can't wake the task up are polled once every period
+ *
+ * @return void
+ */
+void tlm_f_Task_v(void *arg)
+{
+  TickType_t l_nextWake_u32 = xTaskGetTickCount() + (TLM_TASK_PERIOD_MS / portTICK_PERIOD_MS);
+  TickType_t l_wait_u32;
+  QueueSetMemberHandle_t l_queue_s;
+  uart_event_t l_event_s;
+  uint32_t l_ticks_u32 = 0;
+  uint32_t l_osTicks_u32 = 0;
+  uint32_t l_lastTxBytes_u32[LNK_MAX_TRANSPORTS] = {0};
+  lnk_s_Transport_t *l_transport_ps;
+  uint8_t i;
+
+  while (true)
+  {
+    /* Wait for the next period, unless a UART reports something first (a wait above one period means it is overdue) */
+    l_wait_u32 = l_nextWake_u32 - xTaskGetTickCount();
+    l_queue_s = NULL;
+    if (l_wait_u32 <= (TLM_TASK_PERIOD_MS / portTICK_PERIOD_MS))
+    {
+      l_queue_s = xQueueSelectFromSet(tlm_g_UartQueues_s, l_wait_u32);
+    }
+    if (l_queue_s != NULL)
+    {
+      for (i = 0; i < TLM_UART_COUNT; i++)
+      {
+        if ((l_queue_s == tlm_g_Uarts_s[i].queue_s) && (xQueueReceive(l_queue_s, &l_event_s, 0) == pdTRUE))
+        {
+          tlm_f_HandleEvent_v(&tlm_g_Uarts_s[i], &l_event_s);
+        }
+      }
+      continue;
+    }
+    l_nextWake_u32 += TLM_TASK_PERIOD_MS / portTICK_PERIOD_MS;
+
+    l_ticks_u32++;
+
+    lnk_f_Poll_v();
+
+    tlm_f_SendSignals_v();
+
+    if (l_ticks_u32 % (TLM_STATS_PERIOD_MS / TLM_TASK_PERIOD_MS) == 0)
+    {
+      for (i = 0; i < lnk_f_Count_u8(); i++)
+      {
+        l_transport_ps = lnk_f_Get_ps(i);
+        l_transport_ps->stats_s.txBytesPerSec_u32 = (l_transport_ps->stats_s.txBytes_u32 - l_lastTxBytes_u32[i]) * MILLISEC_TO_MICROSEC / TLM_STATS_PERIOD_MS;
+        l_lastTxBytes_u32[i] = l_transport_ps->stats_s.txBytes_u32;
+        if (l_transport_ps->connected_u8)
+        {
+          tlm_f_SendLinkStats_v(l_transport_ps);
+        }
+      }
+
+      for (i = 0; i < TLM_SIG_COUNT; i++)
+      {
+        tlm_g_Subs_s[i].bytesPerSec_u32 = tlm_g_Subs_s[i].bytes_u32 * MILLISEC_TO_MICROSEC / TLM_STATS_PERIOD_MS;
+        tlm_g_Subs_s[i].bytes_u32 = 0;
+        if (tlm_g_Subs_s[i].mode_e != TLM_SUB_OFF)
+        {
+          tlm_f_SendSubState_v((tlm_Signal_e)i);
+        }
+      }
+
+      if (stp_f_Active_u8())
+      {
+        tlm_f_SendStpStats_v();
+      }
+
+      tlm_f_SendErrStats_v();
+    }
+
+    /* The period can change any time over CFG_SET, a shorter one takes effect right away */
+    l_osTicks_u32++;
+    if ((osm_f_GetPeriod_u16() != 0) && (l_osTicks_u32 >= ((osm_f_GetPeriod_u16() + TLM_TASK_PERIOD_MS - 1) / TLM_TASK_PERIOD_MS)))
+    {
+      l_osTicks_u32 = 0;
+      tlm_f_SendOsStats_v();
+    }
+
+    /* Task names again every second, so a recording started halfway through still gets them */
+    tlm_f_SendTrace_v(l_ticks_u32 % (TLM_STATS_PERIOD_MS / TLM_TASK_PERIOD_MS) == 0);
+
+    /* Transports that batch frames send everything of this period at once */
+    lnk_f_Flush_v();
+  }
+}
+
+/**
+ * @brief Date the start of a receive burst, interrupt on the falling edge of the RX pin
+ *
+ * Only the first start bit of a burst is wanted, so the interrupt turns itself off until the task has handled
+ * the burst, and costs one interrupt per burst instead of one per byte
+ *
+ * @param arg the UART, see tlm_g_Uarts_s
+ * @return void
+ */
+void IRAM_ATTR tlm_f_RxStartIsr_v(void *arg)
+{
+  tlm_g_UartTyp_t *l_uart_ps = (tlm_g_UartTyp_t *)arg;
+
+  l_uart_ps->rxStartUs_s64 = esp_timer_get_time();
+  gpio_intr_disable(l_uart_ps->rxPin_e);
+}
+
+/**
+ * @brief Act on an event of the UART driver
+ *
+ * Data is reported once the line was quiet for TLM_UART_RX_TOUT byte times (or the hardware FIFO fills up).
+ * The report that ends a burst dates its last byte: the start bit interrupt plus the bytes of the burst at
+ * TLM_BYTE_NS each, exact as long as the sender sends a burst without gaps. Dating it by when the task gets to
+ * the report instead would add the wake-up latency of the task to every time sync request.
+ * A burst that was already running when the interrupt was armed again is dated too late, but never later
+ * than the task time (also too late, never too early), which is used instead whenever it is earlier
+ *
+ * @param uart the UART that reported it
+ * @param event event taken from its driver queue
+ * @return void
+ */
+void tlm_f_HandleEvent_v(tlm_g_UartTyp_t *uart, const uart_event_t *event)
+{
+  int64_t l_taskUs_s64;
+  int64_t l_isrUs_s64;
+
+  switch (event->type)
+  {
+  case UART_DATA:
+    l_taskUs_s64 = esp_timer_get_time();
+    uart->transport_ps->rxUs_s64 = l_taskUs_s64;
+    uart->burstBytes_u32 += event->size;
+    if (event->timeout_flag)
+    {
+      l_taskUs_s64 -= (int64_t)((TLM_UART_RX_TOUT * TLM_BYTE_NS) / 1000);
+      l_isrUs_s64 = uart->rxStartUs_s64 + (int64_t)((uart->burstBytes_u32 * TLM_BYTE_NS) / 1000);
+
+      if ((uart->rxStartUs_s64 != 0) && (uart->burstBytes_u32 <= TLM_UART_RX_BURST_MAX) && (l_isrUs_s64 <= l_taskUs_s64))
+      {
+        uart->transport_ps->rxUs_s64 = l_isrUs_s64;
+      }
+      else
+      {
+        uart->transport_ps->rxUs_s64 = l_taskUs_s64;
+        uart->lateStamps_u32++;
+      }
+
+      /* The next burst starts a new measurement */
+      uart->burstBytes_u32 = 0;
+      uart->rxStartUs_s64 = 0;
+      gpio_intr_enable(uart->rxPin_e);
+    }
+    tlm_f_Receive_v(uart);
+    break;
+  case UART_FIFO_OVF:
+  case UART_BUFFER_FULL:
+    /* Bytes were lost, so whatever is buffered can't be trusted, start over with the next frame. The queue is not
+       reset, it belongs to the set, the events still in it find nothing or the next bytes to read */
+    uart_flush_input(uart->port_e);
+    uart->transport_ps->rx_s.state_e = LNK_RX_SYNC_1;
+    uart->transport_ps->stats_s.rxErrors_u32++;
+    uart->burstBytes_u32 = 0;
+    uart->rxStartUs_s64 = 0;
+    gpio_intr_enable(uart->rxPin_e);
+    break;
+  default:
+    break;
+  }
+}
+
+/**
+ * @brief Send a frame on every connected transport of the link
+ *
+ * Never waits: a transport without room for the whole frame drops it and counts it
+ *
+ * @param id frame ID, see tlm_MsgId_e
+ * @param payload pointer to the payload bytes (already packed)
+ * @param len payload length, no more than TLM_MAX_PAYLOAD
+ * @return 1 if at least one transport queued the frame, 0 if it was dropped everywhere
+ */
+uint8_t tlm_f_SendFrame_u8(tlm_MsgId_e id, const uint8_t *payload, uint8_t len)
+{
+  return lnk_f_Send_u8((uint8_t)id, payload, len);
+}
+
+/**
+ * @brief Queue a frame into the TX buffer of a UART
+ *
+ * @param uart where to send it
+ * @param frame whole frame, built by lnk
+ * @param len frame length
+ * @return 1 if the frame was queued, 0 if the TX buffer has no room for it
+ */
+uint8_t tlm_f_Write_u8(tlm_g_UartTyp_t *uart, const uint8_t *frame, uint16_t len)
+{
+  lnk_s_Stats_t *l_stats_ps = &uart->transport_ps->stats_s;
+  size_t l_free_u32 = 0;
+  uint64_t l_startUs_u64;
+  uint32_t l_durationUs_u32;
+
+  /* If the TX buffer is this full, the link is saturated, don't let it block the task */
+  if ((uart_get_tx_buffer_free_size(uart->port_e, &l_free_u32) != ESP_OK) || (l_free_u32 < len))
+  {
+    return 0;
+  }
+
+  l_startUs_u64 = esp_timer_get_time();
+  uart_write_bytes(uart->port_e, frame, len);
+  l_durationUs_u32 = (uint32_t)(esp_timer_get_time() - l_startUs_u64);
+
+  if (l_durationUs_u32 > l_stats_ps->maxWriteUs_u32)
+  {
+    l_stats_ps->maxWriteUs_u32 = l_durationUs_u32;
+  }
+
+  /* Last byte of this frame waits for everything queued in front of it (10 bits per byte) */
+  l_durationUs_u32 = (uint32_t)(((uint64_t)(TLM_UART_TX_BUF_SIZE - l_free_u32 + len) * 10 * 1000000) / TLM_UART_BAUD);
+  if (l_durationUs_u32 > l_stats_ps->maxBacklogUs_u32)
+  {
+    l_stats_ps->maxBacklogUs_u32 = l_durationUs_u32;
+  }
+
+  return 1;
+}
+
+/**
+ * @brief write_pf of the UART transport and of the peer link
+ *
+ * @param frame whole frame, built by lnk
+ * @param len frame length
+ * @return 1 if the frame was queued, 0 if the TX buffer has no room for it
+ */
+uint8_t tlm_f_UartWrite_u8(const uint8_t *frame, uint16_t len)
+{
+  return tlm_f_Write_u8(&tlm_g_Uarts_s[TLM_UART_HOST], frame, len);
+}
+
+uint8_t tlm_f_PeerWrite_u8(const uint8_t *frame, uint16_t len)
+{
+  return tlm_f_Write_u8(&tlm_g_Uarts_s[TLM_UART_PEER], frame, len);
+}
+
+/**
+ * @brief Read whatever arrived on a UART since the last call and run it through the frame parser of its transport
+ *
+ * @param uart the UART to read
+ * @return void
+ */
+void tlm_f_Receive_v(tlm_g_UartTyp_t *uart)
+{
+  uint8_t l_buf_u8[64];
+  int l_cnt_s32;
+
+  while ((l_cnt_s32 = uart_read_bytes(uart->port_e, l_buf_u8, sizeof(l_buf_u8), 0)) > 0)
+  {
+    lnk_f_Receive_v(uart->transport_ps, l_buf_u8, (uint32_t)l_cnt_s32);
+  }
+}
+
+/**
+ * @brief Act on a valid frame received from the host or the STM32 board, handler of the link
+ *
+ * Frames that move the hand or change its parameters, or update the STM32 board, are only taken from a trusted
+ * transport (the UART, BLE once the link is encrypted with a bonded, authenticated key), on any other they are
+ * dropped and counted as errors. Of the frames of the STM32 board only the time sync is for us, the rest goes to
+ * every host transport
+ *
+ * @param transport the frame came on, replies to the sender go back on it
+ * @param id frame ID, see tlm_MsgId_e
+ * @param payload received payload
+ * @param len payload length
+ * @return void
+ */
+void tlm_f_HandleFrame_v(lnk_s_Transport_t *transport, uint8_t id, const uint8_t *payload, uint8_t len)
+{
+  uint8_t l_reply_u8[TLM_MAX_PAYLOAD];
+  uint8_t l_idx_u8;
+
+  tlm_g_Rx_ps = transport;
+
+  if ((transport == &tlm_g_Peer_s) && (id != TLM_ID_TSY_REQ) && (id != TLM_ID_TSY_STATS))
+  {
+    lnk_f_Send_u8(id, payload, len);
+    return;
+  }
+
+  switch (id)
+  {
+  case TLM_ID_PING:
+    /* Echo the host's payload (its own timestamp) followed by ours */
+    if (len > TLM_MAX_PAYLOAD - 4)
+    {
+      len = TLM_MAX_PAYLOAD - 4;
+    }
+    memcpy(l_reply_u8, payload, len);
+    l_idx_u8 = lnk_f_PutU32_u8(l_reply_u8, len, (uint32_t)esp_timer_get_time());
+    lnk_f_SendTo_u8(transport, TLM_ID_PONG, l_reply_u8, l_idx_u8);
+    break;
+  case TLM_ID_TSY_REQ:
+    tlm_f_SendTimeSync_v(payload, len);
+    break;
+  case TLM_ID_TSY_STATS:
+    tlm_f_StorePeerSync_v(payload, len);
+    break;
+  case TLM_ID_SUB:
+    tlm_f_Subscribe_v(payload, len);
+    break;
+  case TLM_ID_STP_CTRL:
+    if (!transport->trusted_u8)
+    {
+      transport->stats_s.rxErrors_u32++;
+    }
+    else if (stp_f_Control_u8(payload, len))
+    {
+      tlm_f_SendStpStats_v();
+    }
+    else
+    {
+      transport->stats_s.rxErrors_u32++;
+    }
+    break;
+  case TLM_ID_STP:
+    if (!transport->trusted_u8 || !stp_f_Receive_u8(payload, len, transport->rxUs_s64))
+    {
+      transport->stats_s.rxErrors_u32++;
+    }
+    break;
+  case TLM_ID_UPD_BEGIN:
+  case TLM_ID_UPD_DATA:
+  case TLM_ID_UPD_COMMIT:
+  case TLM_ID_UPD_STATUS:
+    /* For the STM32 board, its UPD_REPLY comes back to every host transport. A full peer TX buffer drops the frame
+       and counts it there, the host sends it again when the reply doesn't come */
+    if (!transport->trusted_u8)
+    {
+      transport->stats_s.rxErrors_u32++;
+    }
+    else
+    {
+      lnk_f_SendTo_u8(&tlm_g_Peer_s, id, payload, len);
+    }
+    break;
+  case TLM_ID_CFG_SET:
+    /* The parameters are the same for every transport, so everyone listening sees what they are now */
+    if (!transport->trusted_u8 || !cfg_f_Apply_u8(payload, len))
+    {
+      transport->stats_s.rxErrors_u32++;
+    }
+    tlm_f_SendFrame_u8(TLM_ID_CFG, l_reply_u8, cfg_f_Pack_u8(l_reply_u8));
+    break;
+  default:
+    /* Unknown frames are ignored, the host might be newer than the firmware */
+    break;
+  }
+}
+
+/**
+ * @brief Answer a time sync request of the peer
+ *
+ * Payload: tag of the request u8, when the last byte of the request arrived (u64), and when the last byte
+ * of this reply will leave (u64), both in microseconds of esp_timer_get_time(). Dating both ends of the exchange
+ * by their last byte makes the two directions look the same to the peer, however long each frame is.
+ * The send time is only that exact on a UART, the peer is wired to one
+ *
+ * @param payload request payload, its first byte is the tag
+ * @param len payload length
+ * @return void
+ */
+void tlm_f_SendTimeSync_v(const uint8_t *payload, uint8_t len)
+{
+  msg_s_TsyReq_t l_req_s;
+  msg_s_TsyResp_t l_resp_s;
+  uint8_t l_reply_u8[MSG_TSY_RESP_LEN];
+  size_t l_free_u32 = TLM_UART_TX_BUF_SIZE;
+  uint8_t i;
+
+  if (!msg_f_UnpackTsyReq_u8(&l_req_s, payload, len))
+  {
+    return;
+  }
+
+  /* Anything still in the TX buffer goes out first */
+  for (i = 0; i < TLM_UART_COUNT; i++)
+  {
+    if (tlm_g_Rx_ps == tlm_g_Uarts_s[i].transport_ps)
+    {
+      uart_get_tx_buffer_free_size(tlm_g_Uarts_s[i].port_e, &l_free_u32);
+    }
+  }
+
+  l_resp_s.tag_u8 = l_req_s.tag_u8;
+  l_resp_s.rxUs_u64 = (uint64_t)tlm_g_Rx_ps->rxUs_s64;
+  l_resp_s.txUs_u64 = (uint64_t)(esp_timer_get_time() + (int64_t)(((TLM_UART_TX_BUF_SIZE - l_free_u32 + LNK_HEADER_LEN + MSG_TSY_RESP_LEN + LNK_CRC_LEN) * TLM_BYTE_NS) / 1000));
+  lnk_f_SendTo_u8(tlm_g_Rx_ps, TLM_ID_TSY_RESP, l_reply_u8, msg_f_PackTsyResp_u8(l_reply_u8, &l_resp_s));
+}
+
+/**
+ * @brief Keep the clock model the peer reported
+ *
+ * Payload: TSY_STATS, see firmware/msg/messages.py
+ *
+ * @param payload received payload
+ * @param len payload length
+ * @return void
+ */
+void tlm_f_StorePeerSync_v(const uint8_t *payload, uint8_t len)
+{
+  msg_s_TsyStats_t l_stats_s;
+  tlm_g_PeerSyncTyp_t l_sync_s;
+
+  if (!msg_f_UnpackTsyStats_u8(&l_stats_s, payload, len))
+  {
+    tlm_g_Rx_ps->stats_s.rxErrors_u32++;
+    return;
+  }
+
+  l_sync_s.refPeerUs_s64 = (int64_t)l_stats_s.refUs_u64;
+  l_sync_s.offsetUs_s64 = l_stats_s.offsetUs_s64;
+  l_sync_s.driftPpb_s32 = l_stats_s.driftPpb_s32;
+  l_sync_s.rttUs_u32 = l_stats_s.rttUs_u32;
+  l_sync_s.errorUs_u32 = l_stats_s.errorUs_u32;
+  l_sync_s.samples_u32 = l_stats_s.samples_u32;
+  l_sync_s.lost_u32 = l_stats_s.lost_u32;
+  l_sync_s.rxUs_s64 = esp_timer_get_time();
+
+  /* The main OS converts timestamps from the other core, it must never see half a model */
+  portENTER_CRITICAL(&tlm_g_PeerSyncLock_s);
+  tlm_g_PeerSync_s = l_sync_s;
+  portEXIT_CRITICAL(&tlm_g_PeerSyncLock_s);
+}
+
+/**
+ * @brief Convert a timestamp of the peer (STM32 board) into our time
+ *
+ * Only meaningful once the peer has reported its clock model (tlm_g_PeerSync_s.rxUs_s64 != 0),
+ * until then the timestamp is returned as it is
+ *
+ * @param peerUs timestamp of the peer, microseconds
+ * @return the same moment in esp_timer_get_time() microseconds
+ */
+int64_t tlm_f_PeerToLocalUs_s64(int64_t peerUs)
+{
+  int64_t l_refUs_s64;
+  int64_t l_offsetUs_s64;
+  int32_t l_driftPpb_s32;
+
+  portENTER_CRITICAL(&tlm_g_PeerSyncLock_s);
+  l_refUs_s64 = tlm_g_PeerSync_s.refPeerUs_s64;
+  l_offsetUs_s64 = tlm_g_PeerSync_s.offsetUs_s64;
+  l_driftPpb_s32 = tlm_g_PeerSync_s.driftPpb_s32;
+  portEXIT_CRITICAL(&tlm_g_PeerSyncLock_s);
+
+  return peerUs + l_offsetUs_s64 + (((peerUs - l_refUs_s64) * l_driftPpb_s32) / 1000000000LL);
+}
+
+/**
+ * @brief Send the runtime measurements of all scheduler slots
+ *
+ * Payload: RTM, see firmware/msg/messages.py
+ *
+ * @return 1 if the frame was queued, 0 if it was dropped
+ */
+uint8_t tlm_f_SendRTM_u8(void)
+{
+  msg_s_Rtm_t l_rtm_s;
+  uint8_t l_payload_u8[MSG_RTM_LEN];
+  uint16_t i;
+
+  l_rtm_s.timeUs_u32 = (uint32_t)esp_timer_get_time();
+  for (i = 0; (i < MAIN_CYCLE_TASK_COUNT) && (i < MSG_RTM_SLOTS_MAX); i++)
+  {
+    l_rtm_s.slots_s[i].currentUs_u16 = (uint16_t)main_g_RuntimeMeas_s[i].currentCycle_u32;
+    l_rtm_s.slots_s[i].minUs_u16 = (uint16_t)main_g_RuntimeMeas_s[i].minCycle_u32;
+    l_rtm_s.slots_s[i].maxUs_u16 = (uint16_t)main_g_RuntimeMeas_s[i].maxCycle_u32;
+  }
+  l_rtm_s.slotsCount_u8 = (uint8_t)i;
+
+  return tlm_f_SendFrame_u8(TLM_ID_RTM, l_payload_u8, msg_f_PackRtm_u8(l_payload_u8, &l_rtm_s));
+}
+
+/**
+ * @brief Change the subscription of one or all signals, and report it back with SUB_STATE
+ *
+ * Payload: SUB, see firmware/msg/messages.py. A new subscription is sampled right in the next task period
+ *
+ * @param payload received payload
+ * @param len payload length
+ * @return void
+ */
+void tlm_f_Subscribe_v(const uint8_t *payload, uint8_t len)
+{
+  msg_s_Sub_t l_sub_s;
+  tlm_g_SubscriptionTyp_t *l_sub_ps;
+  uint32_t l_periodTicks_u32;
+  uint8_t i;
+
+  if (!msg_f_UnpackSub_u8(&l_sub_s, payload, len) ||
+      ((l_sub_s.signal_u8 >= TLM_SIG_COUNT) && (l_sub_s.signal_u8 != TLM_SIG_ALL)) ||
+      ((l_sub_s.mode_u8 > TLM_SUB_ON_CHANGE) && (l_sub_s.mode_u8 != TLM_SUB_KEEP)))
+  {
+    tlm_g_Rx_ps->stats_s.rxErrors_u32++;
+    return;
+  }
+
+  l_periodTicks_u32 = ((uint32_t)l_sub_s.periodMs_u16 + TLM_TASK_PERIOD_MS - 1) / TLM_TASK_PERIOD_MS;
+  if (l_periodTicks_u32 == 0)
+  {
+    l_periodTicks_u32 = 1;
+  }
+
+  for (i = 0; i < TLM_SIG_COUNT; i++)
+  {
+    if ((l_sub_s.signal_u8 != TLM_SIG_ALL) && (l_sub_s.signal_u8 != i))
+    {
+      continue;
+    }
+
+    l_sub_ps = &tlm_g_Subs_s[i];
+    if (l_sub_s.mode_u8 != TLM_SUB_KEEP)
+    {
+      l_sub_ps->mode_e = (tlm_SubMode_e)l_sub_s.mode_u8;
+      l_sub_ps->periodTicks_u16 = (uint16_t)l_periodTicks_u32;
+      l_sub_ps->threshold_u16 = l_sub_s.threshold_u16;
+      l_sub_ps->ticks_u16 = l_sub_ps->periodTicks_u16 - 1;
+      l_sub_ps->sent_u8 = 0;
+    }
+
+    tlm_f_SendSubState_v((tlm_Signal_e)i);
+  }
+}
+
+/**
+ * @brief Send the subscription of a signal together with the bandwidth it used and its drops
+ *
+ * Payload: SUB_STATE, see firmware/msg/messages.py
+ *
+ * @param signal signal to report
+ * @return void
+ */
+void tlm_f_SendSubState_v(tlm_Signal_e signal)
+{
+  msg_s_SubState_t l_state_s;
+  uint8_t l_payload_u8[MSG_SUB_STATE_LEN];
+  uint16_t l_values_u16[TLM_SIG_MAX_CHANNELS];
+  tlm_g_SubscriptionTyp_t *l_sub_ps = &tlm_g_Subs_s[signal];
+
+  l_state_s.signal_u8 = (uint8_t)signal;
+  l_state_s.mode_u8 = (uint8_t)l_sub_ps->mode_e;
+  l_state_s.periodMs_u16 = (uint16_t)(l_sub_ps->periodTicks_u16 * TLM_TASK_PERIOD_MS);
+  l_state_s.threshold_u16 = l_sub_ps->threshold_u16;
+  l_state_s.channels_u8 = tlm_f_ReadSignal_u8(signal, l_values_u16);
+  l_state_s.bytesPerSec_u32 = l_sub_ps->bytesPerSec_u32;
+  l_state_s.dropped_u32 = l_sub_ps->dropped_u32;
+
+  tlm_f_SendFrame_u8(TLM_ID_SUB_STATE, l_payload_u8, msg_f_PackSubState_u8(l_payload_u8, &l_state_s));
+}
+
+/**
+ * @brief Sample every subscribed signal that is due and send the samples, packed into as few frames as they fit
+ *
+ * Called every task period. RTM keeps its own frame, all other signals go into SIGNALS frames
+ *
+ * @return void
+ */
+void tlm_f_SendSignals_v(void)
+{
+  uint8_t l_records_u8[TLM_MAX_PAYLOAD - MSG_SIGNALS_MIN_LEN];
+  uint8_t l_bytes_u8[TLM_SIG_COUNT];
+  uint16_t l_values_u16[TLM_SIG_MAX_CHANNELS];
+  tlm_g_SubscriptionTyp_t *l_sub_ps;
+  uint8_t l_len_u8 = 0;
+  uint8_t l_count_u8;
+  int32_t l_delta_s32;
+  uint8_t l_changed_u8;
+  uint8_t i, j;
+
+  /* Record bytes of every signal in the frame being built, they are only counted once the frame is queued */
+  memset(l_bytes_u8, 0, sizeof(l_bytes_u8));
+
+  for (i = 0; i < TLM_SIG_COUNT; i++)
+  {
+    l_sub_ps = &tlm_g_Subs_s[i];
+    if (l_sub_ps->mode_e == TLM_SUB_OFF)
+    {
+      continue;
+    }
+
+    l_sub_ps->ticks_u16++;
+    if (l_sub_ps->ticks_u16 < l_sub_ps->periodTicks_u16)
+    {
+      continue;
+    }
+    l_sub_ps->ticks_u16 = 0;
+
+    if (i == TLM_SIG_RTM)
+    {
+      if (tlm_f_SendRTM_u8())
+      {
+        l_sub_ps->bytes_u32 += LNK_HEADER_LEN + MSG_RTM_LEN + LNK_CRC_LEN;
+      }
+      else
+      {
+        l_sub_ps->dropped_u32++;
+      }
+      continue;
+    }
+
+    l_count_u8 = tlm_f_ReadSignal_u8((tlm_Signal_e)i, l_values_u16);
+
+    if ((l_sub_ps->mode_e == TLM_SUB_ON_CHANGE) && l_sub_ps->sent_u8)
+    {
+      l_changed_u8 = 0;
+      for (j = 0; j < l_count_u8; j++)
+      {
+        l_delta_s32 = (int32_t)l_values_u16[j] - (int32_t)l_sub_ps->last_u16[j];
+        if ((l_delta_s32 > l_sub_ps->threshold_u16) || (-l_delta_s32 > l_sub_ps->threshold_u16))
+        {
+          l_changed_u8 = 1;
+        }
+      }
+      if (!l_changed_u8)
+      {
+        continue;
+      }
+    }
+
+    /* Signal id, channel count, then a u16 per channel */
+    if ((l_len_u8 + 2 + (2 * l_count_u8)) > sizeof(l_records_u8))
+    {
+      tlm_f_FlushSignals_v(l_records_u8, l_len_u8, l_bytes_u8);
+      memset(l_bytes_u8, 0, sizeof(l_bytes_u8));
+      l_len_u8 = 0;
+    }
+
+    l_records_u8[l_len_u8++] = i;
+    l_records_u8[l_len_u8++] = l_count_u8;
+    for (j = 0; j < l_count_u8; j++)
+    {
+      l_len_u8 = lnk_f_PutU16_u8(l_records_u8, l_len_u8, l_values_u16[j]);
+      l_sub_ps->last_u16[j] = l_values_u16[j];
+    }
+    l_sub_ps->sent_u8 = 1;
+    l_bytes_u8[i] = 2 + (2 * l_count_u8);
+  }
+
+  if (l_len_u8 > 0)
+  {
+    tlm_f_FlushSignals_v(l_records_u8, l_len_u8, l_bytes_u8);
+  }
+}
+
+/**
+ * @brief Send one SIGNALS frame and book its bytes, or its drop, to the signals in it
+ *
+ * The whole frame is booked, not only the records: the frame header, the SIGNALS timestamp and the CRC are shared
+ * by the signals in proportion to their record bytes, the rounding remainder goes to the last one, so the
+ * bandwidth of all signals adds up to what the frames take on the link
+ *
+ * @param records signal records of the frame
+ * @param len length of the records
+ * @param bytes record bytes of every signal in the frame, 0 for the ones not in it
+ * @return void
+ */
+void tlm_f_FlushSignals_v(const uint8_t *records, uint8_t len, const uint8_t *bytes)
+{
+  msg_s_Signals_t l_signals_s;
+  uint8_t l_payload_u8[TLM_MAX_PAYLOAD];
+  uint8_t l_queued_u8;
+  uint32_t l_overhead_u32 = LNK_HEADER_LEN + MSG_SIGNALS_MIN_LEN + LNK_CRC_LEN;
+  uint32_t l_share_u32;
+  uint8_t l_last_u8 = TLM_SIG_COUNT;
+  uint8_t i;
+
+  l_signals_s.timeUs_u32 = (uint32_t)esp_timer_get_time();
+  l_signals_s.records_pu8 = records;
+  l_signals_s.recordsLen_u8 = len;
+  l_queued_u8 = tlm_f_SendFrame_u8(TLM_ID_SIGNALS, l_payload_u8, msg_f_PackSignals_u8(l_payload_u8, &l_signals_s));
+
+  for (i = 0; i < TLM_SIG_COUNT; i++)
+  {
+    if (bytes[i] == 0)
+    {
+      continue;
+    }
+
+    if (l_queued_u8)
+    {
+      l_share_u32 = ((LNK_HEADER_LEN + MSG_SIGNALS_MIN_LEN + LNK_CRC_LEN) * (uint32_t)bytes[i]) / len;
+      tlm_g_Subs_s[i].bytes_u32 += bytes[i] + l_share_u32;
+      l_overhead_u32 -= l_share_u32;
+      l_last_u8 = i;
+    }
+    else
+    {
+      /* The host never saw these values, so an on change signal is sent again even if it stays where it is */
+      tlm_g_Subs_s[i].dropped_u32++;
+      tlm_g_Subs_s[i].sent_u8 = 0;
+    }
+  }
+
+  if (l_last_u8 < TLM_SIG_COUNT)
+  {
+    tlm_g_Subs_s[l_last_u8].bytes_u32 += l_overhead_u32;
+  }
+}
+
+/**
+ * @brief Send the state of the setpoint stream
+ *
+ * Payload: STP_STATS, see firmware/msg/messages.py
+ *
+ * @return void
+ */
+void tlm_f_SendStpStats_v(void)
+{
+  msg_s_StpStats_t l_stats_s;
+  uint8_t l_payload_u8[MSG_STP_STATS_LEN];
+
+  stp_f_GetStats_v(&l_stats_s);
+  tlm_f_SendFrame_u8(TLM_ID_STP_STATS, l_payload_u8, msg_f_PackStpStats_u8(l_payload_u8, &l_stats_s));
+}
+
+/**
+ * @brief Collect the FreeRTOS statistics and send them
+ *
+ * Payload: OS_STATS, see firmware/msg/messages.py
+ *
+ * @return void
+ */
+void tlm_f_SendOsStats_v(void)
+{
+  uint8_t l_payload_u8[MSG_OS_STATS_LEN];
+
+  tlm_f_SendFrame_u8(TLM_ID_OS_STATS, l_payload_u8, osm_f_Pack_u8(l_payload_u8));
+}
+
+/**
+ * @brief Send the runtime driver error counters
+ *
+ * Payload: ERR_STATS, see firmware/msg/messages.py
+ *
+ * @return void
+ */
+void tlm_f_SendErrStats_v(void)
+{
+  uint8_t l_payload_u8[MSG_ERR_STATS_LEN];
+
+  tlm_f_SendFrame_u8(TLM_ID_ERR_STATS, l_payload_u8, err_f_Pack_u8(l_payload_u8));
+}
+
+/**
+ * @brief Send what the tracer recorded on both cores since the last period
+ *
+ * Payload: TRACE and TRACE_TASKS, see firmware/msg/messages.py. Records stay in the rings until a frame
+ * with them is queued, so while the link is full they pile up there (and are lost there once the rings are full)
+ *
+ * @param sendTasks 1 to send TRACE_TASKS of every core, otherwise only of a core with new task indexes
+ * @return void
+ */
+void tlm_f_SendTrace_v(uint8_t sendTasks)
+{
+  uint8_t l_payload_u8[MSG_TRACE_LEN];
+  uint8_t l_len_u8;
+  uint8_t l_count_u8;
+  uint8_t l_core_u8;
+
+  for (l_core_u8 = 0; l_core_u8 < configNUM_CORES; l_core_u8++)
+  {
+    /* Names first, so the host knows the indexes of the switches that follow */
+    if ((trc_f_GetEvents_u16() != 0) && (sendTasks || trc_f_NewTasks_u8(l_core_u8)))
+    {
+      tlm_f_SendFrame_u8(TLM_ID_TRACE_TASKS, l_payload_u8, trc_f_PackTasks_u8(l_core_u8, l_payload_u8));
+    }
+
+    while ((l_len_u8 = trc_f_PackTrace_u8(l_core_u8, l_payload_u8, &l_count_u8)) != 0)
+    {
+      if (!tlm_f_SendFrame_u8(TLM_ID_TRACE, l_payload_u8, l_len_u8))
+      {
+        break;
+      }
+      trc_f_Consume_v(l_core_u8, l_count_u8);
+    }
+  }
+}
+
+/**
+ * @brief Read the current values of a signal
+ *
+ * The modules write their values from the other core, every single u16/float read is atomic,
+ * which is all the telemetry needs
+ *
+ * @param signal signal to read
+ * @param values up to TLM_SIG_MAX_CHANNELS values, see tlm_Signal_e for their units
+ * @return number of channels, 0 for RTM (sent as its own frame)
+ */
+uint8_t tlm_f_ReadSignal_u8(tlm_Signal_e signal, uint16_t *values)
+{
+  float32_t l_value_f32;
+  uint8_t l_count_u8 = 0;
+  uint8_t i;
+
+  switch (signal)
+  {
+  case TLM_SIG_SNS_RAW:
+    for (i = 0; (i < SNS_COUNT) && (l_count_u8 < TLM_SIG_MAX_CHANNELS); i++)
+    {
+      values[l_count_u8++] = sns_g_RawValues_u16[i];
+    }
+    break;
+  case TLM_SIG_SNS_FILTERED:
+    for (i = 0; (i < SNS_COUNT) && (l_count_u8 < TLM_SIG_MAX_CHANNELS); i++)
+    {
+      values[l_count_u8++] = sns_g_Values_u16[i];
+    }
+    break;
+  case TLM_SIG_POT:
+    for (i = 0; (i < POT_COUNT) && (l_count_u8 < TLM_SIG_MAX_CHANNELS); i++)
+    {
+      l_value_f32 = pot_g_PotValues_f32[i] * 100.0f;
+      values[l_count_u8++] = (l_value_f32 <= 0.0f) ? 0 : ((l_value_f32 >= 65535.0f) ? 65535 : (uint16_t)l_value_f32);
+    }
+    break;
+  case TLM_SIG_BAT:
+    l_value_f32 = bat_g_BatVoltage_f32 * 1000.0f;
+    values[l_count_u8++] = (l_value_f32 <= 0.0f) ? 0 : ((l_value_f32 >= 65535.0f) ? 65535 : (uint16_t)l_value_f32);
+    break;
+  case TLM_SIG_SRV_DUTY:
+    for (i = 0; (i < SRV_COUNT) && (l_count_u8 < TLM_SIG_MAX_CHANNELS); i++)
+    {
+      values[l_count_u8++] = srv_g_Output_u16[i];
+    }
+    break;
+  case TLM_SIG_RTM:
+  default:
+    break;
+  }
+
+  return l_count_u8;
+}
+
+/**
+ * @brief Send the statistics of a transport on that transport
+ *
+ * Payload: LINK_STATS, see firmware/msg/messages.py
+ *
+ * @param transport whose statistics to send
+ * @return void
+ */
+void tlm_f_SendLinkStats_v(lnk_s_Transport_t *transport)
+{
+  msg_s_LinkStats_t l_stats_s;
+  uint8_t l_payload_u8[MSG_LINK_STATS_LEN];
+
+  l_stats_s.timeUs_u32 = (uint32_t)esp_timer_get_time();
+  l_stats_s.txBytes_u32 = transport->stats_s.txBytes_u32;
+  l_stats_s.txFrames_u32 = transport->stats_s.txFrames_u32;
+  l_stats_s.txDropped_u32 = transport->stats_s.txDropped_u32;
+  l_stats_s.rxFrames_u32 = transport->stats_s.rxFrames_u32;
+  l_stats_s.rxErrors_u32 = transport->stats_s.rxErrors_u32;
+  l_stats_s.txBytesPerSec_u32 = transport->stats_s.txBytesPerSec_u32;
+  l_stats_s.maxWriteUs_u32 = transport->stats_s.maxWriteUs_u32;
+  l_stats_s.maxBacklogUs_u32 = transport->stats_s.maxBacklogUs_u32;
+
+  lnk_f_SendTo_u8(transport, TLM_ID_LINK_STATS, l_payload_u8, msg_f_PackLinkStats_u8(l_payload_u8, &l_stats_s));
+}
+
+#ifdef SERIAL_DEBUG
+void tlm_f_SerialDebug_v(void)
+{
+  lnk_s_Transport_t *l_transport_ps;
+  uint8_t i;
+
+  for (i = 0; i < lnk_f_Count_u8(); i++)
+  {
+    l_transport_ps = lnk_f_Get_ps(i);
+    ESP_LOGD(TLM_TAG, "Telemetry %s%s: tx %lu B/s, %lu frames, %lu dropped, rx %lu frames, %lu errors, max write %lu us, max backlog %lu us",
+             l_transport_ps->name_pc,
+             l_transport_ps->connected_u8 ? "" : " (not connected)",
+             l_transport_ps->stats_s.txBytesPerSec_u32,
+             l_transport_ps->stats_s.txFrames_u32,
+             l_transport_ps->stats_s.txDropped_u32,
+             l_transport_ps->stats_s.rxFrames_u32,
+             l_transport_ps->stats_s.rxErrors_u32,
+             l_transport_ps->stats_s.maxWriteUs_u32,
+             l_transport_ps->stats_s.maxBacklogUs_u32);
+  }
+  ESP_LOGD(TLM_TAG, "Telemetry peer link: %lu frames, %lu dropped, rx %lu frames, %lu errors, max backlog %lu us",
+           tlm_g_Peer_s.stats_s.txFrames_u32,
+           tlm_g_Peer_s.stats_s.txDropped_u32,
+           tlm_g_Peer_s.stats_s.rxFrames_u32,
+           tlm_g_Peer_s.stats_s.rxErrors_u32,
+           tlm_g_Peer_s.stats_s.maxBacklogUs_u32);
+  ESP_LOGD(TLM_TAG, "Receive bursts dated by the task: %lu host UART, %lu peer link",
+           tlm_g_Uarts_s[TLM_UART_HOST].lateStamps_u32,
+           tlm_g_Uarts_s[TLM_UART_PEER].lateStamps_u32);
+
+  if (tlm_g_PeerSync_s.rxUs_s64 != 0)
+  {
+    ESP_LOGD(TLM_TAG, "Peer clock: offset %lld us, drift %ld ppb, error %lu us, rtt %lu us, %lu samples, %lu lost, reported %lld us ago",
+             tlm_g_PeerSync_s.offsetUs_s64,
+             tlm_g_PeerSync_s.driftPpb_s32,
+             tlm_g_PeerSync_s.errorUs_u32,
+             tlm_g_PeerSync_s.rttUs_u32,
+             tlm_g_PeerSync_s.samples_u32,
+             tlm_g_PeerSync_s.lost_u32,
+             esp_timer_get_time() - tlm_g_PeerSync_s.rxUs_s64);
+  }
+}
+#endif
+
+#endif // TELEMETRY
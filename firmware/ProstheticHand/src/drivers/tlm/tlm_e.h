@@ -0,0 +1,146 @@
+/**
+ * @file tlm_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding tlm.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef TLM_E_H
+#define TLM_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "config/project.h"
+#include "drivers/msg/msg_e.h"
+#include "drivers/lnk/lnk_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+#define TLM_TAG "TLM"
+
+/**
+ * @brief Largest payload a single frame can carry, the frames themselves are built by lnk
+ *
+ */
+#define TLM_MAX_PAYLOAD LNK_MAX_PAYLOAD
+
+/**
+ * @brief IDs of the frames sent over the telemetry link
+ *
+ * Frames from the host have the MSB cleared, frames from the device have it set.
+ * The IDs and payloads are defined in firmware/msg/messages.py, see msg_e.h
+ */
+typedef enum
+{
+  TLM_ID_PING = MSG_ID_PING,               /* host -> device: echo the payload back */
+  TLM_ID_UPD_BEGIN = MSG_ID_UPD_BEGIN,     /* host -> peer: firmware update of the STM32 board, relayed to it */
+  TLM_ID_UPD_DATA = MSG_ID_UPD_DATA,       /* host -> peer: relayed, the board replies with UPD_REPLY to the host */
+  TLM_ID_UPD_COMMIT = MSG_ID_UPD_COMMIT,   /* host -> peer: relayed */
+  TLM_ID_UPD_STATUS = MSG_ID_UPD_STATUS,   /* host -> peer: relayed */
+  TLM_ID_TSY_REQ = MSG_ID_TSY_REQ,         /* peer -> device: time sync request, answered with TSY_RESP */
+  TLM_ID_SUB = MSG_ID_SUB,                 /* host -> device: subscribe to a signal, answered with SUB_STATE */
+  TLM_ID_STP_CTRL = MSG_ID_STP_CTRL,       /* host -> device: hand the servos to the setpoint stream or back, answered with STP_STATS */
+  TLM_ID_STP = MSG_ID_STP,                 /* host -> device: one setpoint of the stream */
+  TLM_ID_CFG_SET = MSG_ID_CFG_SET,         /* host -> device: change configuration parameters, answered with CFG */
+  TLM_ID_PONG = MSG_ID_PONG,               /* device -> host: ping payload + device timestamp */
+  TLM_ID_LINK_STATS = MSG_ID_LINK_STATS,   /* device -> host: telemetry link statistics */
+  TLM_ID_RTM = MSG_ID_RTM,                 /* device -> host: runtime measurement of the scheduler slots */
+  TLM_ID_SIGNALS = MSG_ID_SIGNALS,         /* device -> host: samples of the subscribed signals */
+  TLM_ID_TSY_RESP = MSG_ID_TSY_RESP,       /* device -> peer: time sync reply, request tag + receive and send timestamps */
+  TLM_ID_TSY_STATS = MSG_ID_TSY_STATS,     /* peer -> device: how the peer (STM32) maps its clock onto ours */
+  TLM_ID_SUB_STATE = MSG_ID_SUB_STATE,     /* device -> host: subscription of a signal and the bandwidth it uses */
+  TLM_ID_STP_STATS = MSG_ID_STP_STATS,     /* device -> host: state of the setpoint stream and its latencies */
+  TLM_ID_CFG = MSG_ID_CFG,                 /* device -> host: value of every configuration parameter */
+  TLM_ID_OS_STATS = MSG_ID_OS_STATS,       /* device -> host: FreeRTOS task loads, stack watermarks and heap */
+  TLM_ID_TRACE = MSG_ID_TRACE,             /* device -> host: events recorded by the tracer on one core */
+  TLM_ID_TRACE_TASKS = MSG_ID_TRACE_TASKS, /* device -> host: names of the task indexes in TRACE */
+  TLM_ID_ERR_STATS = MSG_ID_ERR_STATS      /* device -> host: runtime driver error counters */
+} tlm_MsgId_e;
+
+/**
+ * @brief Signals the host can subscribe to, every one is sent as a u16 per channel
+ *
+ */
+typedef enum
+{
+  TLM_SIG_RTM = 0,      /* Runtime measurement, sent as its own RTM frame */
+  TLM_SIG_SNS_RAW,      /* Last reading of every EMG sensor, ADC counts */
+  TLM_SIG_SNS_FILTERED, /* Averaged EMG sensor values (sns_g_Values_u16), ADC counts */
+  TLM_SIG_POT,          /* Potentiometer values (pot_g_PotValues_f32), in 0.01 */
+  TLM_SIG_BAT,          /* Battery voltage, in mV */
+  TLM_SIG_SRV_DUTY,     /* Duty cycle sent to every servo (srv_g_Output_u16) */
+  TLM_SIG_COUNT,
+  TLM_SIG_ALL = 0xFF    /* In SUB: applies to every signal */
+} tlm_Signal_e;
+
+/**
+ * @brief How a subscribed signal is delivered
+ *
+ */
+typedef enum
+{
+  TLM_SUB_OFF = 0,       /* Not sent */
+  TLM_SUB_PERIODIC,      /* Sent every period */
+  TLM_SUB_ON_CHANGE,     /* Checked every period, sent when a channel moved more than the threshold since it was last sent */
+  TLM_SUB_KEEP = 0xFF    /* In SUB: leave the subscription as it is, only report its state */
+} tlm_SubMode_e;
+
+/**************************************************************************
+ * Structures
+ **************************************************************************/
+
+/**
+ * @brief Clock model of the peer on the other end of the link (the STM32 board), as it reports it in TSY_STATS
+ *
+ * Our clock (esp_timer_get_time()) is the shared timebase, the peer keeps estimating its offset and drift against it:
+ * ours = peer + offsetUs + driftPpb * (peer - refPeerUs) / 10^9
+ */
+typedef struct
+{
+  int64_t refPeerUs_s64;  /* Peer time of the last good exchange */
+  int64_t offsetUs_s64;   /* Our time minus the peer time at refPeerUs */
+  int32_t driftPpb_s32;   /* How much faster our clock runs than the peer clock, parts per billion */
+  uint32_t rttUs_u32;     /* Round trip of the exchange the model is based on */
+  uint32_t errorUs_u32;   /* Error bound the peer gives for the model */
+  uint32_t samples_u32;   /* Good exchanges so far */
+  uint32_t lost_u32;      /* Requests without a usable reply */
+  int64_t rxUs_s64;       /* When the model arrived, 0 while none has */
+} tlm_g_PeerSyncTyp_t;
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Clock model of the peer, see tlm_g_PeerSyncTyp_t
+ *
+ */
+extern tlm_g_PeerSyncTyp_t tlm_g_PeerSync_s;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void tlm_f_Init_v(void);
+extern void tlm_f_Task_v(void *arg);
+extern uint8_t tlm_f_SendFrame_u8(tlm_MsgId_e id, const uint8_t *payload, uint8_t len);
+extern int64_t tlm_f_PeerToLocalUs_s64(int64_t peerUs);
+
+#ifdef SERIAL_DEBUG
+extern void tlm_f_SerialDebug_v(void);
+#endif
+
+#endif // TLM_E_H
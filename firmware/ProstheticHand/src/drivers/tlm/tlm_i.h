@@ -0,0 +1,243 @@
+/**
+ * @file tlm_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding tlm.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef TLM_I_H
+#define TLM_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "tlm_e.h"
+#include "driver/uart.h"
+#include "driver/gpio.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief UART used for the telemetry link to the host and its pins
+ *
+ * UART0 stays with the console (ESP_LOG), so the telemetry gets its own port
+ *
+ * @values see which pins are usable in file "ESP32_Pins.xlsx"
+ */
+#define TLM_UART_PORT UART_NUM_1
+#define TLM_UART_TX_PIN GPIO_NUM_15
+#define TLM_UART_RX_PIN GPIO_NUM_16
+
+/**
+ * @brief UART wired to the telemetry link of the STM32 board (its UART4) and its pins
+ *
+ * A port of its own, so the host tools keep the telemetry UART while the boards sync their clocks. The STM32 board
+ * is reached through us: UPD frames of the host are relayed to it, and its frames to the host
+ *
+ * @values see which pins are usable in file "ESP32_Pins.xlsx"
+ */
+#define TLM_PEER_UART_PORT UART_NUM_2
+#define TLM_PEER_TX_PIN GPIO_NUM_8
+#define TLM_PEER_RX_PIN GPIO_NUM_9
+
+/**
+ * @brief Baud rate of both UARTs
+ *
+ * Same as the telemetry link of the STM32 board
+ *
+ * @values up to 5000000, as long as the USB-UART bridge on the other side can keep up
+ */
+#define TLM_UART_BAUD 1000000
+
+/**
+ * @brief Time one byte takes on the wire (start + 8 data + stop bits)
+ *
+ * @values in nanoseconds
+ */
+#define TLM_BYTE_NS ((10ULL * 1000000000ULL) / TLM_UART_BAUD)
+
+/**
+ * @brief How long the line has to be quiet after a byte before the UART reports the data it received
+ *
+ * Kept short, the report that ends a burst dates its last byte, see tlm_f_HandleEvent_v()
+ *
+ * @values in byte times (symbols), 1..126
+ */
+#define TLM_UART_RX_TOUT 2
+
+/**
+ * @brief Receive reports dated later than this after the start bit interrupt are dated by the task instead
+ *
+ * A burst longer than the RX buffer can't be told apart from two bursts, see tlm_f_HandleEvent_v()
+ *
+ * @values in bytes
+ */
+#define TLM_UART_RX_BURST_MAX TLM_UART_RX_BUF_SIZE
+
+/**
+ * @brief Length of the event queue of each UART driver, the telemetry task waits on both
+ *
+ */
+#define TLM_UART_EVENT_QUEUE_LEN 8
+
+/**
+ * @brief Size of the UART driver ring buffers
+ *
+ * Frames are only queued into the TX buffer, so the telemetry task never waits for the wire
+ *
+ * @values > 128 (UART hardware FIFO size)
+ */
+#define TLM_UART_TX_BUF_SIZE 4096
+#define TLM_UART_RX_BUF_SIZE 1024
+
+/**
+ * @brief How often the telemetry task wakes up to read and send frames
+ *
+ * @values in milliseconds
+ */
+#define TLM_TASK_PERIOD_MS 10
+
+/**
+ * @brief How often each of the periodic frames is sent, RTM only until the host subscribes to it otherwise
+ *
+ * @values in milliseconds, multiple of TLM_TASK_PERIOD_MS
+ */
+#define TLM_RTM_PERIOD_MS 100
+#define TLM_STATS_PERIOD_MS 1000
+
+/**
+ * @brief Most channels a signal has, see tlm_f_ReadSignal_u8()
+ *
+ */
+#define TLM_SIG_MAX_CHANNELS 4
+
+/**
+ * @brief UARTs of the link
+ *
+ */
+typedef enum
+{
+  TLM_UART_HOST = 0, /* Host tools */
+  TLM_UART_PEER,     /* STM32 board */
+  TLM_UART_COUNT
+} tlm_Uart_e;
+
+/**
+ * @brief One UART of the link and how its receive bursts are dated
+ *
+ */
+typedef struct
+{
+  uart_port_t port_e;               /* UART of the transport */
+  gpio_num_t txPin_e;               /* Its pins, RX is also watched for the start bit of a burst */
+  gpio_num_t rxPin_e;
+  lnk_s_Transport_t *transport_ps;  /* Transport the received bytes go to */
+  QueueHandle_t queue_s;            /* Events of the UART driver */
+  volatile int64_t rxStartUs_s64;   /* When the start bit of the first byte of the current burst fell, 0 while none did */
+  uint32_t burstBytes_u32;          /* Bytes reported so far for the current burst */
+  uint32_t lateStamps_u32;          /* Bursts that had to be dated by the task instead of the interrupt */
+} tlm_g_UartTyp_t;
+
+/**
+ * @brief Subscription of one signal and what it costs
+ *
+ */
+typedef struct
+{
+  tlm_SubMode_e mode_e;                     /* How the signal is delivered */
+  uint16_t periodTicks_u16;                 /* Sampling period, in telemetry task periods */
+  uint16_t threshold_u16;                   /* TLM_SUB_ON_CHANGE: how far a channel has to move */
+  uint16_t ticks_u16;                       /* Task periods since the signal was last sampled */
+  uint8_t sent_u8;                          /* Whether last_u16 holds the values last sent */
+  uint16_t last_u16[TLM_SIG_MAX_CHANNELS];  /* Values last sent */
+  uint32_t bytes_u32;                       /* Bytes sent since the last statistics */
+  uint32_t bytesPerSec_u32;                 /* Bandwidth used over the last second */
+  uint32_t dropped_u32;                     /* Samples dropped because the TX buffer was full */
+} tlm_g_SubscriptionTyp_t;
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief The telemetry UART as a transport of the link
+ *
+ */
+extern lnk_s_Transport_t tlm_g_Uart_s;
+
+/**
+ * @brief The UART to the STM32 board, a transport that is not added to the link, so only the frames meant for
+ * the board go there
+ *
+ */
+extern lnk_s_Transport_t tlm_g_Peer_s;
+
+/**
+ * @brief Both UARTs, see tlm_Uart_e
+ *
+ */
+extern tlm_g_UartTyp_t tlm_g_Uarts_s[TLM_UART_COUNT];
+
+/**
+ * @brief Transport the frame being handled came on, receive errors are counted there
+ *
+ */
+extern lnk_s_Transport_t *tlm_g_Rx_ps;
+
+/**
+ * @brief Event queues of both UART drivers, the telemetry task wakes up on them
+ *
+ */
+extern QueueSetHandle_t tlm_g_UartQueues_s;
+
+/**
+ * @brief Subscription of every signal, only touched by the telemetry task
+ *
+ */
+extern tlm_g_SubscriptionTyp_t tlm_g_Subs_s[TLM_SIG_COUNT];
+
+/**
+ * @brief Guards tlm_g_PeerSync_s, which is written by the telemetry task and read from both cores
+ *
+ */
+extern portMUX_TYPE tlm_g_PeerSyncLock_s;
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void tlm_f_InitUart_v(tlm_g_UartTyp_t *uart);
+extern void tlm_f_RxStartIsr_v(void *arg);
+extern void tlm_f_HandleEvent_v(tlm_g_UartTyp_t *uart, const uart_event_t *event);
+extern void tlm_f_Receive_v(tlm_g_UartTyp_t *uart);
+extern uint8_t tlm_f_Write_u8(tlm_g_UartTyp_t *uart, const uint8_t *frame, uint16_t len);
+extern uint8_t tlm_f_UartWrite_u8(const uint8_t *frame, uint16_t len);
+extern uint8_t tlm_f_PeerWrite_u8(const uint8_t *frame, uint16_t len);
+extern void tlm_f_HandleFrame_v(lnk_s_Transport_t *transport, uint8_t id, const uint8_t *payload, uint8_t len);
+extern uint8_t tlm_f_SendRTM_u8(void);
+extern void tlm_f_Subscribe_v(const uint8_t *payload, uint8_t len);
+extern void tlm_f_SendSubState_v(tlm_Signal_e signal);
+extern void tlm_f_SendSignals_v(void);
+extern void tlm_f_FlushSignals_v(const uint8_t *records, uint8_t len, const uint8_t *bytes);
+extern uint8_t tlm_f_ReadSignal_u8(tlm_Signal_e signal, uint16_t *values);
+extern void tlm_f_SendStpStats_v(void);
+extern void tlm_f_SendOsStats_v(void);
+extern void tlm_f_SendErrStats_v(void);
+extern void tlm_f_SendTrace_v(uint8_t sendTasks);
+extern void tlm_f_SendLinkStats_v(lnk_s_Transport_t *transport);
+extern void tlm_f_SendTimeSync_v(const uint8_t *payload, uint8_t len);
+extern void tlm_f_StorePeerSync_v(const uint8_t *payload, uint8_t len);
+
+#endif // TLM_I_H
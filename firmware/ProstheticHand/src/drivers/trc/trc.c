@@ -0,0 +1,331 @@
+/**
+ * @file trc.c
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Event tracer software component
+ *
+ * RTM gives the min/max runtime of every slot, but not how the slots, the timer callbacks and the tasks
+ * on core 0 interleave. The tracer records each of these events with a timestamp into a ring buffer of the
+ * core it happened on: slot begin/end (main OS), interrupt handler / esp_timer callback enter/exit, every
+ * task switch (FreeRTOS calls trc_f_TaskSwitchedIn_v() through trc_hook.h) and markers.
+ * The telemetry task empties the rings into TRACE frames every period, openhand-trace (host/tools/trace.cpp)
+ * turns a recording of them into a Chrome trace / Perfetto timeline.
+ *
+ * A record is 8 bytes and costs about a microsecond, with nothing recorded (CFG_TRACE_EVENTS 0, the default)
+ * every call is a load and a branch. Records that find the ring full are counted as lost, never waited for.
+ * Everything that can run on a task switch is in IRAM, the kernel switches tasks while the flash cache is off.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+/* Own header file */
+#include "trc_e.h"
+#include "trc_i.h"
+
+/**************************************************************************
+ * Global variables
+ **************************************************************************/
+
+/**
+ * @brief Events that are recorded, CFG_TRACE_EVENTS
+ *
+ * @values trc_EventMask_e bits, 0 - tracing is off
+ */
+volatile uint16_t trc_g_Events_u16 = 0;
+
+/**
+ * @brief Ring buffer of every core
+ *
+ */
+DRAM_ATTR trc_s_Ring_t trc_g_Rings_s[configNUM_CORES] = {
+    {.lock_s = portMUX_INITIALIZER_UNLOCKED},
+    {.lock_s = portMUX_INITIALIZER_UNLOCKED}};
+
+/**
+ * @brief Bit of trc_g_Events_u16 that switches each event type on
+ *
+ * @values indexed by trc_Event_e
+ */
+DRAM_ATTR const uint8_t trc_c_EventMask_u8[TRC_EV_COUNT] = {
+    TRC_EVENTS_SLOT, TRC_EVENTS_SLOT, TRC_EVENTS_ISR, TRC_EVENTS_ISR, TRC_EVENTS_TASK, TRC_EVENTS_MARK};
+
+/**************************************************************************
+ * Functions
+ **************************************************************************/
+
+void trc_f_Record_v(trc_Event_e type, uint8_t id, uint16_t arg);
+void trc_f_TaskSwitchedIn_v(void);
+uint16_t trc_f_GetEvents_u16(void);
+uint8_t trc_f_SetEvents_u8(uint16_t events);
+uint8_t trc_f_PackTrace_u8(uint8_t core, uint8_t *buf, uint8_t *count);
+void trc_f_Consume_v(uint8_t core, uint8_t count);
+uint8_t trc_f_NewTasks_u8(uint8_t core);
+uint8_t trc_f_PackTasks_u8(uint8_t core, uint8_t *buf);
+
+void trc_f_Put_v(trc_s_Ring_t *ring, trc_Event_e type, uint8_t id, uint16_t arg);
+
+#ifdef SERIAL_DEBUG
+void trc_f_SerialDebug_v(void);
+#endif
+
+/**
+ * @brief Record an event on the core this runs on
+ *
+ * Callable from tasks, timer callbacks and interrupt handlers
+ *
+ * @param type what happened
+ * @param id see trc_Event_e
+ * @param arg see trc_Event_e
+ * @return void
+ */
+void IRAM_ATTR trc_f_Record_v(trc_Event_e type, uint8_t id, uint16_t arg)
+{
+  trc_s_Ring_t *l_ring_ps;
+
+  if (!(trc_g_Events_u16 & trc_c_EventMask_u8[type]))
+  {
+    return;
+  }
+
+  l_ring_ps = &trc_g_Rings_s[xPortGetCoreID()];
+  portENTER_CRITICAL_SAFE(&l_ring_ps->lock_s);
+  trc_f_Put_v(l_ring_ps, type, id, arg);
+  portEXIT_CRITICAL_SAFE(&l_ring_ps->lock_s);
+}
+
+/**
+ * @brief FreeRTOS trace hook traceTASK_SWITCHED_IN, see trc_hook.h
+ *
+ * Runs inside the scheduler, so it only looks the task up among the indexes of this core,
+ * a task seen for the first time gets the next one
+ *
+ * @return void
+ */
+void IRAM_ATTR trc_f_TaskSwitchedIn_v(void)
+{
+  trc_s_Ring_t *l_ring_ps;
+  TaskHandle_t l_task_ps;
+  const char *l_name_pc;
+  uint8_t l_index_u8;
+  uint8_t i;
+
+  if (!(trc_g_Events_u16 & TRC_EVENTS_TASK))
+  {
+    return;
+  }
+
+  l_task_ps = xTaskGetCurrentTaskHandle();
+  l_ring_ps = &trc_g_Rings_s[xPortGetCoreID()];
+
+  portENTER_CRITICAL_SAFE(&l_ring_ps->lock_s);
+
+  for (l_index_u8 = 0; l_index_u8 < l_ring_ps->tasksCount_u8; l_index_u8++)
+  {
+    if (l_ring_ps->tasks_ps[l_index_u8] == l_task_ps)
+    {
+      break;
+    }
+  }
+
+  if (l_index_u8 == l_ring_ps->tasksCount_u8)
+  {
+    if (l_index_u8 < TRC_MAX_TASKS)
+    {
+      l_name_pc = pcTaskGetName(l_task_ps);
+      l_ring_ps->tasks_ps[l_index_u8] = l_task_ps;
+      l_ring_ps->names_u64[l_index_u8] = 0;
+      for (i = 0; (i < 8) && (l_name_pc[i] != '\0'); i++)
+      {
+        l_ring_ps->names_u64[l_index_u8] |= (uint64_t)(uint8_t)l_name_pc[i] << (8 * i);
+      }
+      l_ring_ps->tasksCount_u8++;
+    }
+    else
+    {
+      l_index_u8 = TRC_TASK_OTHER;
+    }
+  }
+
+  trc_f_Put_v(l_ring_ps, TRC_EV_TASK_IN, l_index_u8, 0);
+
+  portEXIT_CRITICAL_SAFE(&l_ring_ps->lock_s);
+}
+
+/**
+ * @brief Write a record into a ring, the caller holds its lock
+ *
+ * @param ring of the core the event happened on
+ * @param type what happened
+ * @param id see trc_Event_e
+ * @param arg see trc_Event_e
+ * @return void
+ */
+void IRAM_ATTR trc_f_Put_v(trc_s_Ring_t *ring, trc_Event_e type, uint8_t id, uint16_t arg)
+{
+  trc_s_Record_t *l_record_ps;
+
+  if ((ring->head_u32 - ring->tail_u32) >= TRC_RING_LEN)
+  {
+    ring->lost_u32++;
+    return;
+  }
+
+  l_record_ps = &ring->records_s[ring->head_u32 & (TRC_RING_LEN - 1)];
+  l_record_ps->timeUs_u32 = (uint32_t)esp_timer_get_time();
+  l_record_ps->type_u8 = (uint8_t)type;
+  l_record_ps->id_u8 = id;
+  l_record_ps->arg_u16 = arg;
+  ring->head_u32++;
+}
+
+/**
+ * @brief Which events are recorded, CFG_TRACE_EVENTS
+ *
+ * @return trc_EventMask_e bits, 0 if tracing is off
+ */
+uint16_t trc_f_GetEvents_u16(void)
+{
+  return trc_g_Events_u16;
+}
+
+/**
+ * @brief Change which events are recorded
+ *
+ * @param events trc_EventMask_e bits, 0 turns tracing off
+ * @return 1 if it was changed, 0 if there are unknown bits
+ */
+uint8_t trc_f_SetEvents_u8(uint16_t events)
+{
+  if (events & ~TRC_EVENTS_ALL)
+  {
+    return 0;
+  }
+
+  trc_g_Events_u16 = events;
+  return 1;
+}
+
+/**
+ * @brief Write the oldest records of a core into a payload, without taking them out of the ring
+ *
+ * Payload: TRACE, see firmware/msg/messages.py. Once the frame is sent, trc_f_Consume_v() takes them out,
+ * if it can't be sent they stay for the next try
+ *
+ * @param core whose records
+ * @param buf room for MSG_TRACE_LEN bytes
+ * @param count records in the payload
+ * @return payload length, 0 if the ring is empty
+ */
+uint8_t trc_f_PackTrace_u8(uint8_t core, uint8_t *buf, uint8_t *count)
+{
+  trc_s_Ring_t *l_ring_ps = &trc_g_Rings_s[core];
+  msg_s_Trace_t l_trace_s;
+  trc_s_Record_t *l_record_ps;
+  uint32_t l_tail_u32;
+  uint8_t i;
+
+  portENTER_CRITICAL(&l_ring_ps->lock_s);
+  l_tail_u32 = l_ring_ps->tail_u32;
+  for (i = 0; (i < MSG_TRACE_RECORDS_MAX) && ((l_tail_u32 + i) != l_ring_ps->head_u32); i++)
+  {
+    l_record_ps = &l_ring_ps->records_s[(l_tail_u32 + i) & (TRC_RING_LEN - 1)];
+    l_trace_s.records_s[i].timeUs_u32 = l_record_ps->timeUs_u32;
+    l_trace_s.records_s[i].type_u8 = l_record_ps->type_u8;
+    l_trace_s.records_s[i].id_u8 = l_record_ps->id_u8;
+    l_trace_s.records_s[i].arg_u16 = l_record_ps->arg_u16;
+  }
+  l_trace_s.lost_u32 = l_ring_ps->lost_u32;
+  portEXIT_CRITICAL(&l_ring_ps->lock_s);
+
+  *count = i;
+  if (i == 0)
+  {
+    return 0;
+  }
+
+  l_trace_s.core_u8 = core;
+  l_trace_s.recordsCount_u8 = i;
+  return msg_f_PackTrace_u8(buf, &l_trace_s);
+}
+
+/**
+ * @brief Take the records of the last trc_f_PackTrace_u8() out of the ring
+ *
+ * @param core whose records
+ * @param count as trc_f_PackTrace_u8() gave it
+ * @return void
+ */
+void trc_f_Consume_v(uint8_t core, uint8_t count)
+{
+  trc_s_Ring_t *l_ring_ps = &trc_g_Rings_s[core];
+
+  portENTER_CRITICAL(&l_ring_ps->lock_s);
+  l_ring_ps->tail_u32 += count;
+  portEXIT_CRITICAL(&l_ring_ps->lock_s);
+}
+
+/**
+ * @brief Whether a core gave out task indexes since its last TRACE_TASKS
+ *
+ * @param core which one
+ * @return 1 if it did, 0 otherwise
+ */
+uint8_t trc_f_NewTasks_u8(uint8_t core)
+{
+  return (trc_g_Rings_s[core].tasksCount_u8 != trc_g_Rings_s[core].tasksSent_u8);
+}
+
+/**
+ * @brief Write the task indexes of a core into a payload
+ *
+ * Payload: TRACE_TASKS, see firmware/msg/messages.py
+ *
+ * @param core whose indexes
+ * @param buf room for MSG_TRACE_TASKS_LEN bytes
+ * @return payload length
+ */
+uint8_t trc_f_PackTasks_u8(uint8_t core, uint8_t *buf)
+{
+  trc_s_Ring_t *l_ring_ps = &trc_g_Rings_s[core];
+  msg_s_TraceTasks_t l_tasks_s;
+  uint8_t i;
+
+  portENTER_CRITICAL(&l_ring_ps->lock_s);
+  for (i = 0; i < l_ring_ps->tasksCount_u8; i++)
+  {
+    l_tasks_s.tasks_s[i].index_u8 = i;
+    l_tasks_s.tasks_s[i].name_u64 = l_ring_ps->names_u64[i];
+  }
+  l_ring_ps->tasksSent_u8 = i;
+  portEXIT_CRITICAL(&l_ring_ps->lock_s);
+
+  l_tasks_s.core_u8 = core;
+  l_tasks_s.tasksCount_u8 = i;
+  return msg_f_PackTraceTasks_u8(buf, &l_tasks_s);
+}
+
+#ifdef SERIAL_DEBUG
+void trc_f_SerialDebug_v(void)
+{
+  uint8_t i;
+
+  if (trc_g_Events_u16 == 0)
+  {
+    return;
+  }
+
+  for (i = 0; i < configNUM_CORES; i++)
+  {
+    ESP_LOGD(TRC_TAG, "Core %u: %lu events, %lu waiting, %lu lost, %u tasks", i, trc_g_Rings_s[i].head_u32, trc_g_Rings_s[i].head_u32 - trc_g_Rings_s[i].tail_u32, trc_g_Rings_s[i].lost_u32, trc_g_Rings_s[i].tasksCount_u8);
+  }
+}
+#endif
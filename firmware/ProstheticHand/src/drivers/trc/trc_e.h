@@ -0,0 +1,107 @@
+/**
+ * @file trc_e.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding trc.c
+ *
+ * This file contains everything needed by other modules in order to use this module
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef TRC_E_H
+#define TRC_E_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "config/project.h"
+#include "drivers/msg/msg_e.h"
+#include "trc_hook.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+#define TRC_TAG "TRC"
+
+/**
+ * @brief What an event record says happened, the type of TRACE records
+ *
+ */
+typedef enum
+{
+  TRC_EV_SLOT_BEGIN = 0, /* A 1ms slot of the main OS starts, id: slot */
+  TRC_EV_SLOT_END,       /* and ends */
+  TRC_EV_ISR_ENTER,      /* An interrupt handler or esp_timer callback starts, id: trc_Isr_e, arg: which instance */
+  TRC_EV_ISR_EXIT,       /* and ends */
+  TRC_EV_TASK_IN,        /* The core switches to a task, id: its index (see TRACE_TASKS), TRC_TASK_OTHER if there was no room */
+  TRC_EV_MARK,           /* Something worth seeing on the timeline, id: trc_Mark_e */
+  TRC_EV_COUNT
+} trc_Event_e;
+
+/**
+ * @brief Which events are recorded, bits of CFG_TRACE_EVENTS
+ *
+ */
+typedef enum
+{
+  TRC_EVENTS_SLOT = 0x01, /* TRC_EV_SLOT_BEGIN / END */
+  TRC_EVENTS_ISR = 0x02,  /* TRC_EV_ISR_ENTER / EXIT */
+  TRC_EVENTS_TASK = 0x04, /* TRC_EV_TASK_IN */
+  TRC_EVENTS_MARK = 0x08, /* TRC_EV_MARK */
+  TRC_EVENTS_ALL = 0x0F
+} trc_EventMask_e;
+
+/**
+ * @brief Interrupt handlers and timer callbacks that record their runtime
+ *
+ * The esp_timer callbacks run in the esp_timer task on core 0 above every task of this program,
+ * so they interrupt the others just like a handler does
+ */
+typedef enum
+{
+  TRC_ISR_SUP = 0, /* Safety supervisor check, every 1ms */
+  TRC_ISR_LED      /* Next step of an LED pattern, arg: led_Id_e */
+} trc_Isr_e;
+
+/**
+ * @brief Markers, the id of TRC_EV_MARK
+ *
+ */
+typedef enum
+{
+  TRC_MARK_SAFE_STATE = 0, /* The supervisor tripped, arg: its sup_Fault_e bits */
+  TRC_MARK_DRIVER_FAILURE, /* A driver call failed even after its retries, arg: err_Source_e */
+  TRC_MARK_OVERRUN         /* A slot of the main OS ran longer than its budget, arg: slot */
+} trc_Mark_e;
+
+/**
+ * @brief Task index of the switches to a task the index table had no room for
+ *
+ */
+#define TRC_TASK_OTHER 0xFF
+
+/**************************************************************************
+ * Function prototypes
+ **************************************************************************/
+
+extern void trc_f_Record_v(trc_Event_e type, uint8_t id, uint16_t arg);
+extern uint16_t trc_f_GetEvents_u16(void);
+extern uint8_t trc_f_SetEvents_u8(uint16_t events);
+extern uint8_t trc_f_PackTrace_u8(uint8_t core, uint8_t *buf, uint8_t *count);
+extern void trc_f_Consume_v(uint8_t core, uint8_t count);
+extern uint8_t trc_f_NewTasks_u8(uint8_t core);
+extern uint8_t trc_f_PackTasks_u8(uint8_t core, uint8_t *buf);
+
+#ifdef SERIAL_DEBUG
+extern void trc_f_SerialDebug_v(void);
+#endif
+
+#endif // TRC_E_H
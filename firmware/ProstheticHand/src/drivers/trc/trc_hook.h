@@ -0,0 +1,31 @@
+/**
+ * @file trc_hook.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief FreeRTOS trace hook of trc.c
+ *
+ * Included into every source file of the build, FreeRTOS itself included, by the project CMakeLists.txt,
+ * so the kernel calls the tracer on every task switch. That's why it must not include anything.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef TRC_HOOK_H
+#define TRC_HOOK_H
+
+#ifndef __ASSEMBLER__
+extern void trc_f_TaskSwitchedIn_v(void);
+#endif
+
+/**
+ * @brief Called by vTaskSwitchContext() right after it picked the next task of a core
+ *
+ */
+#define traceTASK_SWITCHED_IN() trc_f_TaskSwitchedIn_v()
+
+#endif // TRC_HOOK_H
@@ -0,0 +1,80 @@
+/**
+ * @file trc_i.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Header file for the corresponding trc.c
+ *
+ * This file contains configurations needed by this module that should not be visible to other modules
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef TRC_I_H
+#define TRC_I_H
+
+/**************************************************************************
+ * Includes
+ **************************************************************************/
+
+#include "trc_e.h"
+
+/**************************************************************************
+ * Defines
+ **************************************************************************/
+
+/**
+ * @brief Records in the ring buffer of each core
+ *
+ * The telemetry task empties the rings every 10ms, a full UART carries about 12000 records per second,
+ * so this holds several periods' worth
+ *
+ * @values power of 2, 8 bytes each
+ */
+#define TRC_RING_LEN 512
+
+/**
+ * @brief Tasks each core gives an index to, the ones after that show up as TRC_TASK_OTHER
+ *
+ * @values 1..MSG_TRACE_TASKS_TASKS_MAX
+ */
+#define TRC_MAX_TASKS 16
+
+/**
+ * @brief One event, as it is sent in TRACE
+ *
+ */
+typedef struct
+{
+  uint32_t timeUs_u32; /* Lower 32 bits of esp_timer_get_time() */
+  uint8_t type_u8;     /* trc_Event_e */
+  uint8_t id_u8;       /* see trc_Event_e */
+  uint16_t arg_u16;    /* see trc_Event_e */
+} trc_s_Record_t;
+
+/**
+ * @brief Events of one core and the tasks it ran
+ *
+ * Only that core writes records, only the telemetry task takes them out, both under lock_s
+ */
+typedef struct
+{
+  portMUX_TYPE lock_s;
+  trc_s_Record_t records_s[TRC_RING_LEN];
+  uint32_t head_u32;                     /* Records written, the next one goes to head_u32 % TRC_RING_LEN */
+  uint32_t tail_u32;                     /* Records taken out */
+  uint32_t lost_u32;                     /* Records that found the ring full */
+  TaskHandle_t tasks_ps[TRC_MAX_TASKS];  /* Task of every index */
+  uint64_t names_u64[TRC_MAX_TASKS];     /* and the first 8 characters of its name */
+  uint8_t tasksCount_u8;                 /* Indexes given out */
+  uint8_t tasksSent_u8;                  /* Indexes in the last TRACE_TASKS */
+} trc_s_Ring_t;
+
+_Static_assert((TRC_RING_LEN & (TRC_RING_LEN - 1)) == 0, "TRC_RING_LEN has to be a power of 2");
+_Static_assert(TRC_MAX_TASKS <= MSG_TRACE_TASKS_TASKS_MAX, "More task indexes than a TRACE_TASKS frame can carry");
+
+#endif // TRC_I_H
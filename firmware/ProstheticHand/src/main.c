@@ -11,7 +11,6 @@
  * we constantly call each ` function in constrained timing containers (1ms, 10ms etc.)
  * 
  * @todo: Update file description
- * @todo: Populate debug LED02 functionalities
  *
  * @version 0.1
  * @date 2023-09-21
@@ -29,12 +28,32 @@
 #include "main_e.h"
 
 /* Include all drivers/software components... */
+#include "drivers/err/err_e.h"
 #include "drivers/dsw/dsw_e.h"
 #include "drivers/bat/bat_e.h"
 #include "drivers/btn/btn_e.h"
 #include "drivers/pot/pot_e.h"
 #include "drivers/sns/sns_e.h"
 #include "drivers/srv/srv_e.h"
+#include "drivers/led/led_e.h"
+#include "drivers/sup/sup_e.h"
+#include "drivers/trc/trc_e.h"
+#include "drivers/dlm/dlm_e.h"
+
+#ifdef TELEMETRY
+#include "drivers/tlm/tlm_e.h"
+#include "drivers/stp/stp_e.h"
+#include "drivers/osm/osm_e.h"
+#endif
+#ifdef BLUETOOTH
+#include "drivers/ble/ble_e.h"
+#endif
+#ifdef LOAD_TEST
+#include "drivers/ldt/ldt_e.h"
+#endif
+#ifdef CACHE_TEST
+#include "drivers/cht/cht_e.h"
+#endif
 
 /**************************************************************************
  * Global variables
@@ -55,13 +74,6 @@ uint64_t main_g_LastMicros_u64 = 0;
  */
 uint16_t main_g_CurrTaskIndex_u16 = 0;
 
-/**
- * Counter to know when to turn on/off the debug LED
- *
- * @values 0..MAIN_DEBUG_LED_01_CYCLE_COUNT
- */
-uint16_t main_g_DebugLED01Countdown_u16 = 0;
-
 /**
  * Buffer for runtime measurement statistics
  *
@@ -85,6 +97,14 @@ adc_oneshot_unit_handle_t main_g_AdcUnit2Handle_s;
 TaskHandle_t main_g_SerialDebugTaskHandle_s = NULL;
 #endif
 
+#ifdef TELEMETRY
+/**
+ * @brief Handle for the telemetry task, running next to the serial debug task
+ *
+ */
+TaskHandle_t main_g_TelemetryTaskHandle_s = NULL;
+#endif
+
 /**************************************************************************
  * Functions
  **************************************************************************/
@@ -100,7 +120,6 @@ uint32_t main_f_StartRTM_v(void);
 uint32_t main_f_StopRTM_v(uint32_t rtmStart);
 void main_f_HandleRTMStats_v(uint16_t index);
 void main_f_ADCInit_v(void);
-void main_f_DebugLEDInit_v(void);
 void main_f_DebugLEDHandle_v(void);
 
 /**************************************************************************
@@ -118,6 +137,11 @@ void app_main(void)
   xTaskCreatePinnedToCore(main_f_SerialDebug_v, "main_f_SerialDebug_v", 4096, NULL, 10, &main_g_SerialDebugTaskHandle_s, 0);
 #endif
 
+#ifdef TELEMETRY
+  /* Telemetry also runs on core 0, so the main OS never waits for the UART */
+  xTaskCreatePinnedToCore(tlm_f_Task_v, "tlm_f_Task_v", 4096, NULL, 9, &main_g_TelemetryTaskHandle_s, 0);
+#endif
+
   while (true)
   {
     main_f_Handle_v();
@@ -144,8 +168,9 @@ void main_f_Init_v(void)
   }
 
   /* Call all the initialization functions */
-  main_f_ADCInit_v();       /* First configure ADC groups */
-  main_f_DebugLEDInit_v();  /* then initialize blinky LED */
+  err_f_Init_v();           /* Runtime error counters before anything reports to them */
+  main_f_ADCInit_v();       /* then configure ADC groups */
+  led_f_Init_v();           /* then the debug LEDs        */
   dsw_f_Init_v();           /* now bootstrap pins         */
 
   bat_f_Init_v();           /* after that all the other 'input' modules */
@@ -154,6 +179,26 @@ void main_f_Init_v(void)
   sns_f_Init_v();
 
   srv_f_Init_v();           /* finally all the 'output' modules */
+  sup_f_Init_v();           /* and the supervisor watching them */
+
+#ifdef TELEMETRY
+  stp_f_Init_v();           /* setpoint stream, before the link that feeds it */
+  tlm_f_Init_v();           /* telemetry link, its task is started from app_main */
+#endif
+
+#ifdef BLUETOOTH
+  ble_f_Init_v();           /* BLE service, adds itself to the telemetry link */
+#endif
+
+#ifdef LOAD_TEST
+  ldt_f_Init_v();           /* load test, so its calibration doesn't delay the others */
+#endif
+
+#ifdef CACHE_TEST
+  cht_f_Init_v();           /* flash cache benchmark, starts its flash task */
+#endif
+
+  dlm_f_Init_v();           /* deadline monitor last, the task watchdog starts watching from here */
 }
 
 /**
@@ -162,64 +207,90 @@ void main_f_Init_v(void)
  * This function calls handle functions of all the other components
  *
  */
-void main_f_Handle_v(void)
+void MAIN_IRAM_ATTR main_f_Handle_v(void)
 {
   uint32_t l_rtmMeas_u32;
+  uint32_t l_startDelay_u32;
 
   /* Get current time */
   main_g_CurrMicros_u64 = esp_timer_get_time();
 
   if (main_g_CurrMicros_u64 - main_g_LastMicros_u64 >= main_c_CycleTaskLengthUs_u16)
   {
+    /* How late this task starts compared to when it should have */
+    l_startDelay_u32 = (uint32_t)(main_g_CurrMicros_u64 - main_g_LastMicros_u64) - main_c_CycleTaskLengthUs_u16;
+
     /* Keep track of the last task time */
     main_g_LastMicros_u64 = main_g_CurrMicros_u64;
 
-    /* Start of runtime measurement */
-    l_rtmMeas_u32 = main_f_StartRTM_v();
-
-    /* Call the right handle functions for this task */
-    switch (main_g_CurrTaskIndex_u16)
+    /* A slot that kept overrunning its budget sits this period out, see DLM */
+    if (!dlm_f_Skip_u8(main_g_CurrTaskIndex_u16))
     {
-    case 0:
-      main_f_DebugLEDHandle_v();  /* First handle the debug LED */
-      break;
-    case 1:
-      bat_f_Handle_v();           /* then one by one 'input' modules */
-      break;
-    case 2:
-      btn_f_Handle_v();
-      break;
-    case 3:
-      pot_f_Handle_v();
-      break;
-    case 4:
-      sns_f_Handle_v();
-      break;
-    case 5:
-      srv_f_Handle_v();           /* finally handle the 'output' module(s) */
-      break;
-    case 6:
-      /* To be populated*/
-      break;
-    case 7:
-      /* To be populated*/
-      break;
-    case 8:
-      /* To be populated*/
-      break;
-    case 9:
-      /* To be populated*/
-      break;
-    default:
-      /* This should not happen */
-      break;
-    }
+      /* Start of runtime measurement */
+      l_rtmMeas_u32 = main_f_StartRTM_v();
+      trc_f_Record_v(TRC_EV_SLOT_BEGIN, (uint8_t)main_g_CurrTaskIndex_u16, 0);
+
+      /* Call the right handle functions for this task */
+      switch (main_g_CurrTaskIndex_u16)
+      {
+      case 0:
+        main_f_DebugLEDHandle_v();  /* First pick the debug LED patterns */
+        break;
+      case 1:
+        bat_f_Handle_v();           /* then one by one 'input' modules */
+        break;
+      case 2:
+        btn_f_Handle_v();
+        break;
+      case 3:
+        pot_f_Handle_v();
+        break;
+      case 4:
+        sns_f_Handle_v();
+        break;
+      case 5:
+        srv_f_Handle_v();           /* finally handle the 'output' module(s) */
+        break;
+      case 6:
+        err_f_Handle_v();           /* refill the retry budgets for the next cycle */
+        break;
+      case 7:
+        /* To be populated*/
+        break;
+      case 8:
+        /* To be populated*/
+        break;
+      case 9:
+        /* To be populated*/
+        break;
+      default:
+        /* This should not happen */
+        break;
+      }
+
+#ifdef LOAD_TEST
+      /* Synthetic work is part of the task, so it goes inside the runtime measurement */
+      ldt_f_InjectLoad_v(main_g_CurrTaskIndex_u16);
+#endif
 
-    /* Calculate current task execution time */
-    main_g_RuntimeMeas_s[main_g_CurrTaskIndex_u16].currentCycle_u32 = main_f_StopRTM_v(l_rtmMeas_u32);
+      /* Calculate current task execution time */
+      main_g_RuntimeMeas_s[main_g_CurrTaskIndex_u16].currentCycle_u32 = main_f_StopRTM_v(l_rtmMeas_u32);
+      trc_f_Record_v(TRC_EV_SLOT_END, (uint8_t)main_g_CurrTaskIndex_u16, 0);
 
-    /* Calculate the rest of the statistics for runtime measurement (min/max) */
-    main_f_HandleRTMStats_v(main_g_CurrTaskIndex_u16);
+      /* Calculate the rest of the statistics for runtime measurement (min/max) */
+      main_f_HandleRTMStats_v(main_g_CurrTaskIndex_u16);
+
+#ifdef LOAD_TEST
+      ldt_f_Handle_v(main_g_CurrTaskIndex_u16, main_g_LastMicros_u64, l_startDelay_u32, main_g_RuntimeMeas_s[main_g_CurrTaskIndex_u16].currentCycle_u32);
+#endif
+
+#ifdef CACHE_TEST
+      cht_f_Handle_v(main_g_CurrTaskIndex_u16, l_startDelay_u32, main_g_RuntimeMeas_s[main_g_CurrTaskIndex_u16].currentCycle_u32);
+#endif
+
+      /* Budget and deadline of the slot */
+      dlm_f_Check_v(main_g_CurrTaskIndex_u16, l_startDelay_u32, main_g_RuntimeMeas_s[main_g_CurrTaskIndex_u16].currentCycle_u32);
+    }
 
     /* Keep track of which task we're in */
     main_g_CurrTaskIndex_u16++;
@@ -238,7 +309,7 @@ void main_f_Handle_v(void)
  * @brief Gets current time in microseconds
  *
  */
-uint32_t main_f_StartRTM_v(void)
+uint32_t MAIN_IRAM_ATTR main_f_StartRTM_v(void)
 {
   return esp_timer_get_time();
 }
@@ -247,7 +318,7 @@ uint32_t main_f_StartRTM_v(void)
  * @brief Returns time passed since the given parameter rtmStart
  *
  */
-uint32_t main_f_StopRTM_v(uint32_t rtmStart)
+uint32_t MAIN_IRAM_ATTR main_f_StopRTM_v(uint32_t rtmStart)
 {
   return esp_timer_get_time() - rtmStart;
 }
@@ -256,7 +327,7 @@ uint32_t main_f_StopRTM_v(uint32_t rtmStart)
  * @brief Calculate min/max values for RTM measurement for given task index
  *
  */
-void main_f_HandleRTMStats_v(uint16_t index)
+void MAIN_IRAM_ATTR main_f_HandleRTMStats_v(uint16_t index)
 {
   /* Keep track of max execution time */
   if (main_g_RuntimeMeas_s[index].currentCycle_u32 > main_g_RuntimeMeas_s[index].maxCycle_u32)
@@ -299,57 +370,50 @@ void main_f_ADCInit_v(void)
   ESP_ERROR_CHECK(adc_oneshot_new_unit(&init_config2, &main_g_AdcUnit2Handle_s));
 }
 
-/** @brief Configures the LED debug output pins accordingly
- */
-void main_f_DebugLEDInit_v(void)
-{
-  /* Output pin without any pullup/pulldown */
-  gpio_config_t dbg_pin_config = {
-      (1ULL << MAIN_DEBUG_LED_01_PIN | 1ULL << MAIN_DEBUG_LED_02_PIN),
-      GPIO_MODE_INPUT_OUTPUT,
-      GPIO_PULLUP_DISABLE,
-      GPIO_PULLDOWN_DISABLE,
-      GPIO_INTR_DISABLE};
-  ESP_ERROR_CHECK(gpio_config(&dbg_pin_config));
-}
-
 /** @brief Handles the logic of debug LEDs
- * 
- * Turns on/off debug LED01 when needed - cyclically
- * Turns on/off debug LED02 when needed - based on the selected revision
+ *
+ * Only picks the pattern of each LED, the LED driver plays it on its own timer
+ * LED01 shows the state of the board: breathing when running, fast blinking while the servos home,
+ * and a blink code when the battery runs low
+ * LED02 shows what the selected revision does, or the revision itself as a blink code
  */
-void main_f_DebugLEDHandle_v(void)
+void MAIN_IRAM_ATTR main_f_DebugLEDHandle_v(void)
 {
-  /* If debug LED01 cycle counter greater than 0, decrement it */
-  if (main_g_DebugLED01Countdown_u16 > 0)
+  /* LED01 logic - the safe state comes first, no battery connected (powered over USB) reads close to 0V */
+  if (sup_f_Safe_u8())
+  {
+    led_f_SetPattern_v(LED_ID_01, LED_PATTERN_CODE, SUP_LED_CODE_SAFE_STATE);
+  }
+  else if (err_f_AnyDegraded_u8())
+  {
+    led_f_SetPattern_v(LED_ID_01, LED_PATTERN_CODE, ERR_LED_CODE_DEGRADED);
+  }
+  else if ((bat_g_BatVoltage_f32 > BAT_PRESENT_V) && (bat_g_BatVoltage_f32 < BAT_CRITICAL_V))
+  {
+    led_f_SetPattern_v(LED_ID_01, LED_PATTERN_CODE, MAIN_LED_CODE_BAT_CRITICAL);
+  }
+  else if ((bat_g_BatVoltage_f32 > BAT_PRESENT_V) && (bat_g_BatVoltage_f32 < BAT_LOW_V))
   {
-    main_g_DebugLED01Countdown_u16--;
+    led_f_SetPattern_v(LED_ID_01, LED_PATTERN_CODE, MAIN_LED_CODE_BAT_LOW);
+  }
+  else if (!srv_g_Homed_u8)
+  {
+    led_f_SetPattern_v(LED_ID_01, LED_PATTERN_BLINK_FAST, 0);
   }
-  /* If countdown done: set LED01 to inverse of itself and reset the counter! */
   else
   {
-    main_g_DebugLED01Countdown_u16 = MAIN_DEBUG_LED_01_CYCLE_COUNT;
-    ESP_ERROR_CHECK(gpio_set_level(MAIN_DEBUG_LED_01_PIN, !gpio_get_level(MAIN_DEBUG_LED_01_PIN)));
+    led_f_SetPattern_v(LED_ID_01, LED_PATTERN_BREATHE, 0);
   }
 
   /* LED02 logic */
-  if (dsw_g_HardwareRevision_e == REV00)
-    {
-      /* To be populated */
-    }
-    else if (dsw_g_HardwareRevision_e == REV01)
-    {
-      /* To be populated */
-    }
-    else if (dsw_g_HardwareRevision_e == REV02){
-      /* To be populated */
-    }
-    else if (dsw_g_HardwareRevision_e == REV03){ /* SNS controlled servo (with threshold) - Turns LED02 on when above threshold */
-      ESP_ERROR_CHECK(gpio_set_level(MAIN_DEBUG_LED_02_PIN, sns_g_ActiveStatus_u8[SERVO_CONTROL_SNS_INDEX]));
-    }
-    else if (dsw_g_HardwareRevision_e == REV04) {
-      /* To be populated */
-    }
+  if (dsw_g_HardwareRevision_e == REV03)
+  { /* SNS controlled servo (with threshold) - Turns LED02 on when above threshold */
+    led_f_SetPattern_v(LED_ID_02, sns_g_ActiveStatus_u8[SERVO_CONTROL_SNS_INDEX] ? LED_PATTERN_ON : LED_PATTERN_OFF, 0);
+  }
+  else
+  { /* Revision number as a blink code, REV00 flashes once */
+    led_f_SetPattern_v(LED_ID_02, LED_PATTERN_CODE, (uint8_t)dsw_g_HardwareRevision_e + 1);
+  }
 }
 
 #ifdef SERIAL_DEBUG
@@ -377,6 +441,20 @@ void main_f_SerialDebug_v(void *arg)
     pot_f_SerialDebug_v();
     sns_f_SerialDebug_v();
     srv_f_SerialDebug_v();
+    sup_f_SerialDebug_v();
+    dlm_f_SerialDebug_v();
+    err_f_SerialDebug_v();
+    trc_f_SerialDebug_v();
+#ifdef TELEMETRY
+    tlm_f_SerialDebug_v();
+    osm_f_SerialDebug_v();
+#endif
+#ifdef LOAD_TEST
+    ldt_f_SerialDebug_v();
+#endif
+#ifdef CACHE_TEST
+    cht_f_SerialDebug_v();
+#endif
 
     vTaskDelay(MAIN_SERIAL_DEBUG_DELAY);
   }
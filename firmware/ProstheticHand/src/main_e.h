@@ -53,7 +53,7 @@
  *
  * @values in  microseconds
  */
-const uint16_t main_c_CycleTaskLengthUs_u16 = MILLISEC_TO_MICROSEC * MAIN_CYCLE_LENGTH_MS / MAIN_CYCLE_TASK_COUNT;
+static const uint16_t main_c_CycleTaskLengthUs_u16 = MILLISEC_TO_MICROSEC * MAIN_CYCLE_LENGTH_MS / MAIN_CYCLE_TASK_COUNT;
 
 /**************************************************************************
  * Structures
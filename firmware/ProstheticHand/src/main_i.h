@@ -37,29 +37,12 @@
 #endif
 
 /**
- * @brief Debug LED pin
- * 
- * Indicates that the board is functional
+ * @brief Blink codes shown on LED01, number of flashes before every pause
  *
- * @values GPIO pin
+ * @values 1..LED_CODE_MAX
  */
-#define MAIN_DEBUG_LED_01_PIN GPIO_NUM_37
-
-/**
- * @brief How many main 10ms cycles to wait until changing debug LED state
- *
- * @values 0-250 = 0-2.5s
- */
-#define MAIN_DEBUG_LED_01_CYCLE_COUNT 99
-
-/**
- * @brief Debug LED pin
- * 
- * Indicates sensor threshold
- * 
- * @values GPIO pin
- */
-#define MAIN_DEBUG_LED_02_PIN GPIO_NUM_38
+#define MAIN_LED_CODE_BAT_LOW 2
+#define MAIN_LED_CODE_BAT_CRITICAL 3
 
 /**************************************************************************
  * Structures
@@ -74,8 +57,8 @@ extern uint64_t main_g_LastMicros_u64;
 
 extern uint16_t main_g_CurrTaskIndex_u16;
 
-extern uint16_t main_g_DebugLED01Countdown_u16;
 extern TaskHandle_t main_g_SerialDebugTaskHandle_s;
+extern TaskHandle_t main_g_TelemetryTaskHandle_s;
 
 /**************************************************************************
  * Functions
@@ -92,7 +75,6 @@ extern uint32_t main_f_StartRTM_v(void);
 extern uint32_t main_f_StopRTM_v(uint32_t rtmStart);
 extern void main_f_HandleRTMStats_v(uint16_t index);
 extern void main_f_ADCInit_v(void);
-extern void main_f_DebugLEDInit_v(void);
 extern void main_f_DebugLEDHandle_v(void);
 
 #endif // MAIN_I_H
\ No newline at end of file
@@ -0,0 +1,338 @@
+"""
+Message schema of the telemetry link, the one place where the payload of every frame is defined.
+
+msggen.py turns it into the packers and unpackers of both firmwares (msg.c / msg_e.h) and into the zero-copy views
+of the host (host/include/openhand/msg.hpp). Run it after every change here and commit the generated files with it.
+
+Every message has:
+ - id: frame ID, frames from the device have the MSB set. IDs are never reused, a message that is not sent anymore
+   stays here with "retired": True, so old recordings still decode
+ - name: upper case, becomes MSG_ID_<name> in C and a CamelCase view name on the host
+ - boards: which firmwares send or receive it ("esp32", "stm32"), the ESP32 also lists the UPD frames it relays
+   from the host to the STM32 board
+ - dir: who sends it to whom
+ - doc: one line description
+ - since: schema version the message appeared in
+ - fields: (name, type, since, doc), all little endian without any padding, in wire order.
+   Types: u8, u16, u32, u64, s8, s16, s32, s64, and bytes (the rest of the payload, only as the last field)
+ - group (optional): entries repeated up to "max" times at the end of the payload, their count follows from the length
+ - raw (optional): the payload is not described here (e.g. echoed as it is), only the ID is generated
+
+Versioning, so a host decodes recordings of every older firmware and a newer firmware can talk to an older host:
+ - fields are only ever appended, with the current SCHEMA_VERSION as their "since", never removed, reordered
+   or changed in type. A payload shorter than the current layout simply lacks the newer fields
+ - a message with a group or bytes keeps its fixed fields forever (a new message is added instead),
+   otherwise the start of the group would move
+ - decoders accept longer payloads than they know and ignore the rest
+
+CFG_PARAMS lists the configuration parameters of CFG_SET and CFG in the order of their values, (name, since, doc).
+They become msg_Param_e (MSG_PARAM_<name>, firmware) and msg::Param (host), and are only ever appended as well, so an
+older host still finds the ones it knows where it expects them
+"""
+
+SCHEMA_VERSION = 8
+
+MESSAGES = [
+    {
+        "id": 0x01, "name": "PING", "boards": ["esp32"], "dir": "host -> device", "since": 1,
+        "doc": "Echoed back as PONG, the payload is up to the host (usually its own timestamp)",
+        "raw": True,
+    },
+    {
+        "id": 0x10, "name": "UPD_BEGIN", "boards": ["esp32", "stm32"], "dir": "host -> device", "since": 1,
+        "doc": "Start or resume a firmware update",
+        "fields": [
+            ("size", "u32", 1, "Size of the new image in bytes"),
+            ("crc", "u32", 1, "CRC-32 of the new image"),
+        ],
+    },
+    {
+        "id": 0x11, "name": "UPD_DATA", "boards": ["esp32", "stm32"], "dir": "host -> device", "since": 1,
+        "doc": "Next chunk of the new firmware",
+        "fields": [
+            ("offset", "u32", 1, "Offset of the chunk in the image"),
+            ("data", "bytes", 1, "The chunk, an even number of bytes"),
+        ],
+    },
+    {
+        "id": 0x12, "name": "UPD_COMMIT", "boards": ["esp32", "stm32"], "dir": "host -> device", "since": 1,
+        "doc": "Check the whole new firmware and install it",
+        "fields": [],
+    },
+    {
+        "id": 0x13, "name": "UPD_STATUS", "boards": ["esp32", "stm32"], "dir": "host -> device", "since": 1,
+        "doc": "Ask where the update stands",
+        "fields": [],
+    },
+    {
+        "id": 0x14, "name": "TSY_REQ", "boards": ["esp32", "stm32"], "dir": "either way", "since": 1,
+        "doc": "Time sync request, answered with TSY_RESP",
+        "fields": [
+            ("tag", "u8", 1, "Tells the reply apart from a late reply to an earlier request"),
+        ],
+    },
+    {
+        "id": 0x15, "name": "SUB", "boards": ["esp32"], "dir": "host -> device", "since": 2,
+        "doc": "Subscribe to a telemetry signal, answered with SUB_STATE",
+        "fields": [
+            ("signal", "u8", 2, "tlm_Signal_e, 0xFF for all of them"),
+            ("mode", "u8", 2, "tlm_SubMode_e, 0xFF to only ask for the state"),
+            ("periodMs", "u16", 2, "How often the signal is sampled, rounded up to the telemetry task period"),
+            ("threshold", "u16", 2, "On change: how far a channel has to move from the last sent value"),
+        ],
+    },
+    {
+        "id": 0x16, "name": "STP_CTRL", "boards": ["esp32"], "dir": "host -> device", "since": 3,
+        "doc": "Hand the servos to the setpoint stream or back to the local inputs, answered with STP_STATS",
+        "fields": [
+            ("mode", "u8", 3, "stp_Mode_e, 0xFF to only ask for the state"),
+            ("delayUs", "u16", 3, "Jitter buffer: how long after it was sent a setpoint is applied, 0 for the default"),
+            ("timeoutMs", "u16", 3, "Watchdog: without setpoints for this long the hand goes to the safe posture, 0 for the default"),
+        ],
+    },
+    {
+        "id": 0x17, "name": "STP", "boards": ["esp32"], "dir": "host -> device", "since": 3,
+        "doc": "One setpoint of the stream, one entry per servo from the first one on",
+        "fields": [
+            ("hostUs", "u32", 3, "Host time the setpoint was sent at (or is meant for), microseconds"),
+            ("seq", "u16", 3, "Counted up with every setpoint, older or repeated ones are dropped"),
+        ],
+        "group": {
+            "name": "targets", "entry": "Target", "max": 8,
+            "fields": [
+                ("position", "u16", 3, "0 (open, minimum angle)..10000 (maximum angle), in 0.01%"),
+            ],
+        },
+    },
+    {
+        "id": 0x18, "name": "CFG_SET", "boards": ["esp32"], "dir": "host -> device", "since": 4,
+        "doc": "Change configuration parameters, answered with CFG. Also the value written to the BLE config characteristic",
+        "fields": [],
+        "group": {
+            "name": "values", "entry": "Value", "max": 16,
+            "fields": [
+                ("value", "u16", 4, "New value of the parameter with this index (cfg_Param_e), 0xFFFF leaves it as it is"),
+            ],
+        },
+    },
+    {
+        "id": 0x81, "name": "PONG", "boards": ["esp32"], "dir": "device -> host", "since": 1,
+        "doc": "PING payload followed by the device time in microseconds (u32)",
+        "raw": True,
+    },
+    {
+        "id": 0x82, "name": "LINK_STATS", "boards": ["esp32"], "dir": "device -> host", "since": 1,
+        "doc": "Telemetry link statistics",
+        "fields": [
+            ("timeUs", "u32", 1, "Device time"),
+            ("txBytes", "u32", 1, "Bytes written to the UART"),
+            ("txFrames", "u32", 1, "Frames written to the UART"),
+            ("txDropped", "u32", 1, "Frames dropped because the TX buffer was full"),
+            ("rxFrames", "u32", 1, "Valid frames received"),
+            ("rxErrors", "u32", 1, "Frames received with a bad CRC or length"),
+            ("txBytesPerSec", "u32", 1, "Throughput over the last second"),
+            ("maxWriteUs", "u32", 1, "Longest time spent queueing a frame"),
+            ("maxBacklogUs", "u32", 1, "Longest time a byte waited in the TX buffer"),
+        ],
+    },
+    {
+        "id": 0x83, "name": "RTM", "boards": ["esp32"], "dir": "device -> host", "since": 1,
+        "doc": "Runtime measurement of the scheduler slots",
+        "fields": [
+            ("timeUs", "u32", 1, "Device time"),
+        ],
+        "group": {
+            "name": "slots", "entry": "Slot", "max": 10,
+            "fields": [
+                ("currentUs", "u16", 1, "Runtime of the last cycle"),
+                ("minUs", "u16", 1, "Shortest runtime"),
+                ("maxUs", "u16", 1, "Longest runtime"),
+            ],
+        },
+    },
+    {
+        "id": 0x84, "name": "IRQ_STATS", "boards": ["stm32"], "dir": "device -> host", "since": 1,
+        "doc": "Interrupt timing, one entry per irq_Id_e",
+        "fields": [
+            ("cpuHz", "u32", 1, "CPU clock, to convert the cycles"),
+        ],
+        "group": {
+            "name": "irqs", "entry": "Irq", "max": 4,
+            "fields": [
+                ("count", "u32", 1, "Number of times the interrupt ran"),
+                ("maxCycles", "u32", 1, "Worst execution time"),
+                ("maxLatency", "u32", 1, "Worst entry latency, 0 where it is not measured"),
+            ],
+        },
+    },
+    {
+        "id": 0x85, "name": "SIGNALS", "boards": ["esp32"], "dir": "device -> host", "since": 2,
+        "doc": "Samples of the subscribed signals that were due",
+        "fields": [
+            ("timeUs", "u32", 2, "Device time"),
+            ("records", "bytes", 2, "Per signal: tlm_Signal_e u8, channel count u8, then a u16 per channel"),
+        ],
+    },
+    {
+        "id": 0x90, "name": "UPD_REPLY", "boards": ["stm32"], "dir": "device -> host", "since": 1,
+        "doc": "Reply to every firmware update frame",
+        "fields": [
+            ("reqId", "u8", 1, "ID of the frame replied to"),
+            ("status", "u8", 1, "upd_Status_e"),
+            ("state", "u8", 1, "upd_State_e"),
+            ("next", "u32", 1, "Offset of the next chunk expected"),
+            ("image", "u8", 8, "upd_Image_e, where the last committed image stands with the boot stage"),
+            ("crc", "u32", 8, "CRC-32 of the last committed image, 0 without one"),
+        ],
+    },
+    {
+        "id": 0x94, "name": "TSY_RESP", "boards": ["esp32", "stm32"], "dir": "either way", "since": 1,
+        "doc": "Time sync reply, dated by the last byte of both frames",
+        "fields": [
+            ("tag", "u8", 1, "Tag of the request"),
+            ("rxUs", "u64", 1, "When the last byte of the request arrived"),
+            ("txUs", "u64", 1, "When the last byte of this reply leaves"),
+        ],
+    },
+    {
+        "id": 0x95, "name": "TSY_STATS", "boards": ["esp32", "stm32"], "dir": "STM32 -> ESP32", "since": 1,
+        "doc": "Clock model of the STM32 against the ESP32 clock",
+        "fields": [
+            ("refUs", "u64", 1, "STM32 time of the exchange the model is based on"),
+            ("offsetUs", "s64", 1, "ESP32 time minus STM32 time at refUs"),
+            ("driftPpb", "s32", 1, "How much faster the ESP32 clock runs, parts per billion"),
+            ("rttUs", "u32", 1, "Round trip of that exchange"),
+            ("errorUs", "u32", 1, "Error bound of the model"),
+            ("samples", "u32", 1, "Windows that had a usable exchange"),
+            ("lost", "u32", 1, "Requests without a usable reply"),
+        ],
+    },
+    {
+        "id": 0x96, "name": "SUB_STATE", "boards": ["esp32"], "dir": "device -> host", "since": 2,
+        "doc": "Subscription of one signal and what it costs, the reply to SUB and sent every second while subscribed",
+        "fields": [
+            ("signal", "u8", 2, "tlm_Signal_e"),
+            ("mode", "u8", 2, "tlm_SubMode_e"),
+            ("periodMs", "u16", 2, "Sampling period in effect"),
+            ("threshold", "u16", 2, "On change threshold"),
+            ("channels", "u8", 2, "Values per sample"),
+            ("bytesPerSec", "u32", 2, "Link bandwidth the signal used over the last second"),
+            ("dropped", "u32", 2, "Samples dropped because the TX buffer was full"),
+        ],
+    },
+    {
+        "id": 0x97, "name": "STP_STATS", "boards": ["esp32"], "dir": "device -> host", "since": 3,
+        "doc": "State of the setpoint stream, the reply to STP_CTRL and sent every second while streaming",
+        "fields": [
+            ("mode", "u8", 3, "stp_Mode_e"),
+            ("state", "u8", 3, "stp_State_e"),
+            ("depth", "u8", 3, "Setpoints waiting in the jitter buffer"),
+            ("delayUs", "u16", 3, "Jitter buffer delay in effect"),
+            ("timeoutMs", "u16", 3, "Watchdog timeout in effect"),
+            ("received", "u32", 3, "Setpoints received"),
+            ("late", "u32", 3, "Setpoints that arrived after they were due, applied right away"),
+            ("dropped", "u32", 3, "Setpoints dropped because they were out of order or the jitter buffer was full"),
+            ("holds", "u32", 3, "Servo cycles without a new setpoint, the last one was held"),
+            ("timeouts", "u32", 3, "Times the watchdog sent the hand to the safe posture"),
+            ("lastSeq", "u16", 3, "seq of the setpoint applied last"),
+            ("lastHostUs", "u32", 3, "hostUs of the setpoint applied last"),
+            ("dwellUs", "u32", 3, "Time from receiving that setpoint until this frame was queued, round trip = host receive time - lastHostUs - dwellUs"),
+            ("jitterUs", "u32", 3, "Spread of the one-way transit time over the last second"),
+            ("minLatencyUs", "u32", 3, "Shortest time from receiving a setpoint until it was applied, over the last second"),
+            ("maxLatencyUs", "u32", 3, "Longest time from receiving a setpoint until it was applied, over the last second"),
+        ],
+    },
+    {
+        "id": 0x98, "name": "CFG", "boards": ["esp32"], "dir": "device -> host", "since": 4,
+        "doc": "All configuration parameters, the reply to CFG_SET. Also the value read from the BLE config characteristic",
+        "fields": [],
+        "group": {
+            "name": "values", "entry": "Value", "max": 16,
+            "fields": [
+                ("value", "u16", 4, "Value of the parameter with this index (cfg_Param_e)"),
+            ],
+        },
+    },
+    {
+        "id": 0x99, "name": "OS_STATS", "boards": ["esp32"], "dir": "device -> host", "since": 5,
+        "doc": "FreeRTOS load, stack and heap usage, sent every CFG_OS_STATS_PERIOD ms",
+        "fields": [
+            ("timeUs", "u32", 5, "Device time"),
+            ("windowUs", "u32", 5, "Run time the CPU loads cover, since the previous OS_STATS"),
+            ("heapFree", "u32", 5, "Free heap now, bytes"),
+            ("heapMinFree", "u32", 5, "Least free heap since boot, bytes"),
+            ("idle0", "u16", 5, "Idle time of core 0 over the window, in 0.01%"),
+            ("idle1", "u16", 5, "Idle time of core 1 over the window, in 0.01%"),
+            ("collectUs", "u16", 5, "How long collecting these stats took"),
+            ("taskCount", "u8", 5, "Tasks in the system, entries are only sent for the first ones that fit"),
+        ],
+        "group": {
+            "name": "tasks", "entry": "Task", "max": 15,
+            "fields": [
+                ("name", "u64", 5, "First 8 characters of the task name, zero padded, first character in the low byte"),
+                ("core", "u8", 5, "Core the task is pinned to, 0xFF if it runs on either"),
+                ("priority", "u8", 5, "Current priority"),
+                ("stackFree", "u16", 5, "Least stack the task ever had left, bytes"),
+                ("load", "u16", 5, "Time the task ran over the window, in 0.01% of one core"),
+            ],
+        },
+    },
+    {
+        "id": 0x9A, "name": "TRACE", "boards": ["esp32"], "dir": "device -> host", "since": 6,
+        "doc": "Events recorded on one core (drivers/trc), in the order they happened, while CFG_TRACE_EVENTS isn't 0",
+        "fields": [
+            ("core", "u8", 6, "Core the events happened on"),
+            ("lost", "u32", 6, "Events of this core that found its ring buffer full, since boot"),
+        ],
+        "group": {
+            "name": "records", "entry": "Record", "max": 29,
+            "fields": [
+                ("timeUs", "u32", 6, "Device time"),
+                ("type", "u8", 6, "What happened, trc_Event_e"),
+                ("id", "u8", 6, "Slot, interrupt source, task index (see TRACE_TASKS) or marker"),
+                ("arg", "u16", 6, "Depends on the marker, 0 otherwise"),
+            ],
+        },
+    },
+    {
+        "id": 0x9B, "name": "TRACE_TASKS", "boards": ["esp32"], "dir": "device -> host", "since": 6,
+        "doc": "Names of the task indexes in the task switch events of one core, every second while tracing",
+        "fields": [
+            ("core", "u8", 6, "Core the indexes belong to"),
+        ],
+        "group": {
+            "name": "tasks", "entry": "Task", "max": 16,
+            "fields": [
+                ("index", "u8", 6, "Task index of the task switch events"),
+                ("name", "u64", 6, "First 8 characters of the task name, zero padded, first character in the low byte"),
+            ],
+        },
+    },
+    {
+        "id": 0x9C, "name": "ERR_STATS", "boards": ["esp32"], "dir": "device -> host", "since": 7,
+        "doc": "Runtime driver errors (drivers/err), sent every second",
+        "fields": [
+            ("timeUs", "u32", 7, "Device time"),
+        ],
+        "group": {
+            "name": "sources", "entry": "Source", "max": 8,
+            "fields": [
+                ("errors", "u32", 7, "Driver calls of this err_Source_e that returned an error, retries included"),
+                ("retries", "u32", 7, "Driver calls repeated after an error"),
+                ("failures", "u32", 7, "Driver calls that still failed after their retries"),
+                ("lastError", "s32", 7, "Last esp_err_t returned, 0 if none"),
+                ("degraded", "u8", 7, "1 while the source is degraded, a degraded POT or SNS sends the servos to the open posture"),
+            ],
+        },
+    },
+]
+
+CFG_PARAMS = [
+    ("SNS1_THRESHOLD", 4, "Activation threshold of sensor 1, ADC counts 0..4095"),
+    ("SNS2_THRESHOLD", 4, "Activation threshold of sensor 2, ADC counts 0..4095"),
+    ("SRV1_RANGE", 4, "Travel of servo 1 above its minimum angle, degrees"),
+    ("SRV2_RANGE", 4, "Travel of servo 2 above its minimum angle, degrees"),
+    ("SRV3_RANGE", 4, "Travel of servo 3 above its minimum angle, degrees"),
+    ("OS_STATS_PERIOD", 5, "How often OS_STATS is sent, milliseconds 100..60000, 0 - off"),
+    ("TRACE_EVENTS", 6, "Events the tracer records and sends in TRACE, trc_EventMask_e bits, 0 - off"),
+]
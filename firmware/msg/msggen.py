@@ -0,0 +1,768 @@
+#!/usr/bin/env python3
+"""
+Generates the telemetry message code from messages.py:
+ - msg_e.h, msg_i.h and msg.c of both firmwares: a struct per message with its packer and unpacker,
+   writing and reading byte by byte, so neither the alignment nor the padding of the structs ever matters
+ - host/include/openhand/msg.hpp: a zero-copy view per message, reading the fields straight out of a received payload
+
+Usage: python3 msggen.py          write all generated files
+       python3 msggen.py --check  only check that they are up to date (exit code 1 if not)
+"""
+
+import os
+import sys
+
+import messages
+
+ROOT = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", ".."))
+
+# Where the generated files of each firmware go, and the largest payload its telemetry link can carry
+BOARDS = {
+    "esp32": {
+        "header": "firmware/ProstheticHand/src/drivers/msg/msg_e.h",
+        "internal": "firmware/ProstheticHand/src/drivers/msg/msg_i.h",
+        "source": "firmware/ProstheticHand/src/drivers/msg/msg.c",
+        "max_payload": 240,
+    },
+    "stm32": {
+        "header": "firmware/OpenHand_STM32/OpenHandFirmware/Core/Inc/msg_e.h",
+        "internal": "firmware/OpenHand_STM32/OpenHandFirmware/Core/Inc/msg_i.h",
+        "source": "firmware/OpenHand_STM32/OpenHandFirmware/Core/Src/msg.c",
+        "max_payload": 57,
+    },
+}
+HOST_HEADER = "host/include/openhand/msg.hpp"
+
+# Wire type -> (size, C type, C suffix, C++ type)
+TYPES = {
+    "u8": (1, "uint8_t", "u8", "std::uint8_t"),
+    "u16": (2, "uint16_t", "u16", "std::uint16_t"),
+    "u32": (4, "uint32_t", "u32", "std::uint32_t"),
+    "u64": (8, "uint64_t", "u64", "std::uint64_t"),
+    "s8": (1, "int8_t", "s8", "std::int8_t"),
+    "s16": (2, "int16_t", "s16", "std::int16_t"),
+    "s32": (4, "int32_t", "s32", "std::int32_t"),
+    "s64": (8, "int64_t", "s64", "std::int64_t"),
+}
+
+GENERATED_NOTE = "Generated from firmware/msg/messages.py by firmware/msg/msggen.py, do not edit"
+
+
+class SchemaError(Exception):
+    pass
+
+
+def camel(name):
+    return "".join(part.capitalize() for part in name.split("_"))
+
+
+def upper_first(name):
+    return name[0].upper() + name[1:]
+
+
+def layout(fields):
+    """Offsets of the fixed fields, and the size of all of them together"""
+    offsets = []
+    offset = 0
+    for name, typ, since, doc in fields:
+        if typ == "bytes":
+            offsets.append(offset)
+            continue
+        offsets.append(offset)
+        offset += TYPES[typ][0]
+    return offsets, offset
+
+
+def min_len(msg):
+    """Payload of the oldest layout of the message"""
+    length = 0
+    for name, typ, since, doc in msg.get("fields", []):
+        if typ != "bytes" and since == msg["since"]:
+            length += TYPES[typ][0]
+    return length
+
+
+def entry_len(group):
+    return layout(group["fields"])[1]
+
+
+def max_len(msg):
+    """Payload of the current layout, with all group entries"""
+    length = layout(msg.get("fields", []))[1]
+    if "group" in msg:
+        length += entry_len(msg["group"]) * msg["group"]["max"]
+    return length
+
+
+def has_bytes(msg):
+    return any(typ == "bytes" for name, typ, since, doc in msg.get("fields", []))
+
+
+def validate():
+    ids = set()
+    names = set()
+    for msg in messages.MESSAGES:
+        where = msg["name"]
+        if msg["id"] in ids or msg["name"] in names:
+            raise SchemaError(f"{where}: ID or name used twice")
+        ids.add(msg["id"])
+        names.add(msg["name"])
+        if not 1 <= msg["since"] <= messages.SCHEMA_VERSION:
+            raise SchemaError(f"{where}: since has to be 1..SCHEMA_VERSION")
+        for board in msg["boards"]:
+            if board not in BOARDS:
+                raise SchemaError(f"{where}: unknown board {board}")
+        if msg.get("raw"):
+            continue
+
+        fields = msg.get("fields", [])
+        last_since = msg["since"]
+        for i, (name, typ, since, doc) in enumerate(fields):
+            if typ != "bytes" and typ not in TYPES:
+                raise SchemaError(f"{where}.{name}: unknown type {typ}")
+            if typ == "bytes" and (i != len(fields) - 1 or "group" in msg):
+                raise SchemaError(f"{where}.{name}: bytes only as the last field and without a group")
+            if since < last_since or since > messages.SCHEMA_VERSION:
+                raise SchemaError(f"{where}.{name}: fields are only appended, since can't go back or ahead")
+            last_since = since
+            if ("group" in msg or has_bytes(msg)) and since != msg["since"]:
+                raise SchemaError(f"{where}.{name}: a message with a group or bytes can't get new fixed fields")
+
+        if "group" in msg:
+            group = msg["group"]
+            for name, typ, since, doc in group["fields"]:
+                if typ not in TYPES:
+                    raise SchemaError(f"{where}.{group['name']}.{name}: groups only take fixed size types")
+                if since != msg["since"]:
+                    raise SchemaError(f"{where}.{group['name']}.{name}: group entries can't change")
+
+        for board in msg["boards"]:
+            if max_len(msg) > BOARDS[board]["max_payload"]:
+                raise SchemaError(f"{where}: {max_len(msg)} bytes don't fit into a frame of {board}")
+
+    params = set()
+    last_since = 1
+    for name, since, doc in messages.CFG_PARAMS:
+        if name in params:
+            raise SchemaError(f"CFG_PARAMS.{name}: name used twice")
+        params.add(name)
+        if since < last_since or since > messages.SCHEMA_VERSION:
+            raise SchemaError(f"CFG_PARAMS.{name}: parameters are only appended, since can't go back or ahead")
+        last_since = since
+    for msg in messages.MESSAGES:
+        if msg["name"] in ("CFG", "CFG_SET") and len(messages.CFG_PARAMS) > msg["group"]["max"]:
+            raise SchemaError(f"{msg['name']}: more CFG_PARAMS than values")
+
+
+def has_params(msgs):
+    """Whether a board gets the configuration parameters, it does if it takes CFG_SET"""
+    return any(msg["name"] == "CFG_SET" for msg in msgs)
+
+
+# ---------------------------------------------------------------------------------------------------------------
+# C
+# ---------------------------------------------------------------------------------------------------------------
+
+def c_member(name, typ):
+    if typ == "bytes":
+        return [("const uint8_t *", f"{name}_pu8"), ("uint8_t", f"{name}Len_u8")]
+    return [(TYPES[typ][1], f"{name}_{TYPES[typ][2]}")]
+
+
+def c_struct(type_name, members, brief):
+    """members: (C type, name, comment)"""
+    width = max(len(f"{ctype} {name};") if not ctype.endswith("*") else len(f"{ctype}{name};")
+                for ctype, name, comment in members)
+    lines = ["/**", f" * @brief {brief}", " *", " */", "typedef struct", "{"]
+    for ctype, name, comment in members:
+        decl = f"{ctype}{name};" if ctype.endswith("*") else f"{ctype} {name};"
+        lines.append(f"  {decl.ljust(width)} /* {comment} */")
+    lines.append(f"}} {type_name};")
+    return lines
+
+
+def c_header(board, msgs):
+    out = [
+        "/**",
+        " * @file msg_e.h",
+        " *",
+        " * @author Aleksa Heler (aleksaheler@gmail.com)",
+        " *",
+        " * @brief Header file for the corresponding msg.c",
+        " *",
+        f" * {GENERATED_NOTE}.",
+        " * Packers write the current layout, unpackers take every layout since version 1 (newer fields",
+        " * missing from an older payload are 0, anything after the known fields is ignored)",
+        " *",
+        " * @version 0.1",
+        " * @date 2026-10-18",
+        " *",
+        " * @copyright Copyright (c) 2026",
+        " *",
+        " */",
+        "",
+        "#ifndef MSG_E_H",
+        "#define MSG_E_H",
+        "",
+        "/**************************************************************************",
+        " * Includes",
+        " **************************************************************************/",
+        "",
+        '#include "stdint.h"',
+        "",
+        "/**************************************************************************",
+        " * Defines",
+        " **************************************************************************/",
+        "",
+        "/**",
+        " * @brief Version of messages.py this was generated from",
+        " *",
+        " */",
+        f"#define MSG_SCHEMA_VERSION {messages.SCHEMA_VERSION}",
+        "",
+        "/**",
+        " * @brief Frame IDs, payload lengths (_MIN_LEN of the oldest layout, _LEN of the current one with all group",
+        " * entries) and group sizes",
+        " *",
+        " */",
+    ]
+    for msg in msgs:
+        up = msg["name"]
+        out.append(f"#define MSG_ID_{up} 0x{msg['id']:02X}")
+        if msg.get("raw"):
+            continue
+        out.append(f"#define MSG_{up}_MIN_LEN {min_len(msg)}")
+        out.append(f"#define MSG_{up}_LEN {max_len(msg)}")
+        if "group" in msg:
+            group = msg["group"]
+            out.append(f"#define MSG_{up}_{group['name'].upper()}_MAX {group['max']}")
+            out.append(f"#define MSG_{up}_{group['entry'].upper()}_LEN {entry_len(group)}")
+
+    if has_params(msgs):
+        decls = [f"MSG_PARAM_{name}" + (" = 0," if i == 0 else ",") for i, (name, since, doc) in enumerate(messages.CFG_PARAMS)]
+        width = max(len(decl) for decl in decls)
+        out += [
+            "",
+            "/**",
+            " * @brief Configuration parameters, the index of their value in CFG_SET and CFG",
+            " *",
+            " */",
+            "typedef enum",
+            "{",
+        ]
+        for decl, (name, since, doc) in zip(decls, messages.CFG_PARAMS):
+            out.append(f"  {decl.ljust(width)} /* {doc} */")
+        out += [
+            "  MSG_PARAM_COUNT",
+            "} msg_Param_e;",
+        ]
+
+    out += [
+        "",
+        "/**************************************************************************",
+        " * Structures",
+        " **************************************************************************/",
+    ]
+    for msg in msgs:
+        if msg.get("raw") or not (msg.get("fields") or msg.get("group")):
+            continue
+        name = camel(msg["name"])
+        members = []
+        for fname, typ, since, doc in msg["fields"]:
+            cm = c_member(fname, typ)
+            if typ == "bytes":
+                members.append((cm[0][0], cm[0][1], doc))
+                members.append((cm[1][0], cm[1][1], f"Length of {fname}"))
+            else:
+                members.append((cm[0][0], cm[0][1], doc + (f" (since version {since})" if since != msg["since"] else "")))
+        if "group" in msg:
+            group = msg["group"]
+            entry_type = f"msg_s_{name}{group['entry']}_t"
+            out.append("")
+            out += c_struct(entry_type, [(TYPES[t][1], f"{n}_{TYPES[t][2]}", d) for n, t, s, d in group["fields"]],
+                            f"One entry of {msg['name']}")
+            members.append(("uint8_t", f"{group['name']}Count_u8", f"Entries in {group['name']}_s"))
+            members.append((entry_type, f"{group['name']}_s[MSG_{msg['name']}_{group['name'].upper()}_MAX]", "Entries"))
+        out.append("")
+        out += c_struct(f"msg_s_{name}_t", members, f"{msg['name']} ({msg['dir']}): {msg['doc']}")
+
+    out += [
+        "",
+        "/**************************************************************************",
+        " * Function prototypes",
+        " **************************************************************************/",
+        "",
+    ]
+    for msg in msgs:
+        if msg.get("raw") or not (msg.get("fields") or msg.get("group")):
+            continue
+        name = camel(msg["name"])
+        out.append(f"extern uint8_t msg_f_Pack{name}_u8(uint8_t *buf, const msg_s_{name}_t *msg);")
+        out.append(f"extern uint8_t msg_f_Unpack{name}_u8(msg_s_{name}_t *msg, const uint8_t *buf, uint8_t len);")
+    out += ["", "#endif // MSG_E_H", ""]
+    return "\n".join(out)
+
+
+def c_internal():
+    return "\n".join([
+        "/**",
+        " * @file msg_i.h",
+        " *",
+        " * @author Aleksa Heler (aleksaheler@gmail.com)",
+        " *",
+        " * @brief Header file for the corresponding msg.c",
+        " *",
+        f" * {GENERATED_NOTE}",
+        " *",
+        " * @version 0.1",
+        " * @date 2026-10-18",
+        " *",
+        " * @copyright Copyright (c) 2026",
+        " *",
+        " */",
+        "",
+        "#ifndef MSG_I_H",
+        "#define MSG_I_H",
+        "",
+        "/**************************************************************************",
+        " * Includes",
+        " **************************************************************************/",
+        "",
+        '#include "msg_e.h"',
+        "",
+        "/**************************************************************************",
+        " * Function prototypes",
+        " **************************************************************************/",
+        "",
+        "extern uint8_t msg_f_PutU16_u8(uint8_t *buf, uint8_t idx, uint16_t val);",
+        "extern uint8_t msg_f_PutU32_u8(uint8_t *buf, uint8_t idx, uint32_t val);",
+        "extern uint8_t msg_f_PutU64_u8(uint8_t *buf, uint8_t idx, uint64_t val);",
+        "extern uint16_t msg_f_GetU16_u16(const uint8_t *buf);",
+        "extern uint32_t msg_f_GetU32_u32(const uint8_t *buf);",
+        "extern uint64_t msg_f_GetU64_u64(const uint8_t *buf);",
+        "",
+        "#endif // MSG_I_H",
+        "",
+    ])
+
+
+def c_put(typ, value):
+    size, ctype, suffix, cpp = TYPES[typ]
+    cast = f"(uint{size * 8}_t)" if typ.startswith("s") else ""
+    if size == 1:
+        return [f"buf[l_idx_u8++] = {cast}{value};"]
+    return [f"l_idx_u8 = msg_f_PutU{size * 8}_u8(buf, l_idx_u8, {cast}{value});"]
+
+
+def c_get(typ, at):
+    size, ctype, suffix, cpp = TYPES[typ]
+    cast = f"({ctype})" if typ.startswith("s") else ""
+    if size == 1:
+        return f"{cast}buf[{at}]"
+    return f"{cast}msg_f_GetU{size * 8}_u{size * 8}(&buf[{at}])"
+
+
+def c_source(board, msgs):
+    out = [
+        "/**",
+        " * @file msg.c",
+        " *",
+        " * @author Aleksa Heler (aleksaheler@gmail.com)",
+        " *",
+        " * @brief Telemetry message packers and unpackers",
+        " *",
+        f" * {GENERATED_NOTE}",
+        " *",
+        " * @version 0.1",
+        " * @date 2026-10-18",
+        " *",
+        " * @copyright Copyright (c) 2026",
+        " *",
+        " */",
+        "",
+        "/**************************************************************************",
+        " * Includes",
+        " **************************************************************************/",
+        "",
+        "/* Own header file */",
+        '#include "msg_e.h"',
+        '#include "msg_i.h"',
+        "",
+        '#include "string.h"',
+        "",
+        "/**************************************************************************",
+        " * Functions",
+        " **************************************************************************/",
+        "",
+    ]
+    protos = []
+    bodies = []
+    for msg in msgs:
+        if msg.get("raw") or not (msg.get("fields") or msg.get("group")):
+            continue
+        name = camel(msg["name"])
+        up = msg["name"]
+        fields = msg.get("fields", [])
+        offsets, fixed = layout(fields)
+        group = msg.get("group")
+        loop = group is not None
+
+        protos.append(f"uint8_t msg_f_Pack{name}_u8(uint8_t *buf, const msg_s_{name}_t *msg);")
+        protos.append(f"uint8_t msg_f_Unpack{name}_u8(msg_s_{name}_t *msg, const uint8_t *buf, uint8_t len);")
+
+        # Packer
+        bodies += [
+            "/**",
+            f" * @brief Write {up} into a payload",
+            " *",
+            f" * @param buf - payload, room for MSG_{up}_LEN bytes" + (" plus the bytes" if has_bytes(msg) else ""),
+            " * @param msg - message to write",
+            " *",
+            " * @return uint8_t - payload length",
+            " */",
+            f"uint8_t msg_f_Pack{name}_u8(uint8_t *buf, const msg_s_{name}_t *msg)",
+            "{",
+            "  uint8_t l_idx_u8 = 0;",
+        ]
+        if loop:
+            bodies.append("  uint8_t i;")
+        bodies.append("")
+        for fname, typ, since, doc in fields:
+            if typ == "bytes":
+                bodies.append(f"  memcpy(&buf[l_idx_u8], msg->{fname}_pu8, msg->{fname}Len_u8);")
+                bodies.append(f"  l_idx_u8 += msg->{fname}Len_u8;")
+            else:
+                bodies += ["  " + line for line in c_put(typ, f"msg->{fname}_{TYPES[typ][2]}")]
+        if loop:
+            gname = group["name"]
+            bodies += [
+                f"  for (i = 0; (i < msg->{gname}Count_u8) && (i < MSG_{up}_{gname.upper()}_MAX); i++)",
+                "  {",
+            ]
+            for fname, typ, since, doc in group["fields"]:
+                bodies += ["    " + line for line in c_put(typ, f"msg->{gname}_s[i].{fname}_{TYPES[typ][2]}")]
+            bodies.append("  }")
+        bodies += ["", "  return l_idx_u8;", "}", ""]
+
+        # Unpacker
+        bodies += [
+            "/**",
+            f" * @brief Read {up} out of a payload",
+            " *",
+            " * @param msg - message to fill",
+            " * @param buf - payload",
+            " * @param len - payload length",
+            " *",
+            f" * @return uint8_t - 1 if the payload holds at least MSG_{up}_MIN_LEN bytes, 0 if not",
+            " */",
+            f"uint8_t msg_f_Unpack{name}_u8(msg_s_{name}_t *msg, const uint8_t *buf, uint8_t len)",
+            "{",
+        ]
+        if loop:
+            bodies += ["  uint8_t l_pos_u8;", "  uint8_t i;", ""]
+        if min_len(msg) > 0:
+            bodies += [
+                f"  if (len < MSG_{up}_MIN_LEN)",
+                "  {",
+                "    return 0;",
+                "  }",
+                "",
+            ]
+        for (fname, typ, since, doc), offset in zip(fields, offsets):
+            if typ == "bytes":
+                bodies.append(f"  msg->{fname}_pu8 = &buf[{offset}];")
+                bodies.append(f"  msg->{fname}Len_u8 = len - {offset};")
+            elif since == msg["since"]:
+                bodies.append(f"  msg->{fname}_{TYPES[typ][2]} = {c_get(typ, offset)};")
+            else:
+                end = offset + TYPES[typ][0]
+                bodies.append(f"  msg->{fname}_{TYPES[typ][2]} = (len >= {end}) ? {c_get(typ, offset)} : 0;")
+        if loop:
+            gname = group["name"]
+            entry = group["entry"].upper()
+            if fields:
+                bodies.append("")
+            bodies += [
+                f"  msg->{gname}Count_u8 = (len - MSG_{up}_MIN_LEN) / MSG_{up}_{entry}_LEN;",
+                f"  if (msg->{gname}Count_u8 > MSG_{up}_{gname.upper()}_MAX)",
+                "  {",
+                f"    msg->{gname}Count_u8 = MSG_{up}_{gname.upper()}_MAX;",
+                "  }",
+                f"  for (i = 0; i < msg->{gname}Count_u8; i++)",
+                "  {",
+                f"    l_pos_u8 = MSG_{up}_MIN_LEN + (i * MSG_{up}_{entry}_LEN);",
+            ]
+            for (fname, typ, since, doc), offset in zip(group["fields"], layout(group["fields"])[0]):
+                at = f"l_pos_u8 + {offset}" if offset else "l_pos_u8"
+                bodies.append(f"    msg->{gname}_s[i].{fname}_{TYPES[typ][2]} = {c_get(typ, at)};")
+            bodies.append("  }")
+        bodies += ["", "  return 1;", "}", ""]
+
+    helpers_protos = [
+        "uint8_t msg_f_PutU16_u8(uint8_t *buf, uint8_t idx, uint16_t val);",
+        "uint8_t msg_f_PutU32_u8(uint8_t *buf, uint8_t idx, uint32_t val);",
+        "uint8_t msg_f_PutU64_u8(uint8_t *buf, uint8_t idx, uint64_t val);",
+        "uint16_t msg_f_GetU16_u16(const uint8_t *buf);",
+        "uint32_t msg_f_GetU32_u32(const uint8_t *buf);",
+        "uint64_t msg_f_GetU64_u64(const uint8_t *buf);",
+    ]
+    helpers = [
+        "/**",
+        " * @brief Write a value LSB first",
+        " *",
+        " * @param buf - payload",
+        " * @param idx - where to write",
+        " * @param val - value",
+        " *",
+        " * @return uint8_t - index after the value",
+        " */",
+        "uint8_t msg_f_PutU16_u8(uint8_t *buf, uint8_t idx, uint16_t val)",
+        "{",
+        "  buf[idx++] = (uint8_t)val;",
+        "  buf[idx++] = (uint8_t)(val >> 8);",
+        "  return idx;",
+        "}",
+        "",
+        "uint8_t msg_f_PutU32_u8(uint8_t *buf, uint8_t idx, uint32_t val)",
+        "{",
+        "  idx = msg_f_PutU16_u8(buf, idx, (uint16_t)val);",
+        "  return msg_f_PutU16_u8(buf, idx, (uint16_t)(val >> 16));",
+        "}",
+        "",
+        "uint8_t msg_f_PutU64_u8(uint8_t *buf, uint8_t idx, uint64_t val)",
+        "{",
+        "  idx = msg_f_PutU32_u8(buf, idx, (uint32_t)val);",
+        "  return msg_f_PutU32_u8(buf, idx, (uint32_t)(val >> 32));",
+        "}",
+        "",
+        "/**",
+        " * @brief Read a value sent LSB first, from any alignment",
+        " *",
+        " * @param buf - first byte of the value",
+        " *",
+        " * @return the value",
+        " */",
+        "uint16_t msg_f_GetU16_u16(const uint8_t *buf)",
+        "{",
+        "  return (uint16_t)(buf[0] | ((uint16_t)buf[1] << 8));",
+        "}",
+        "",
+        "uint32_t msg_f_GetU32_u32(const uint8_t *buf)",
+        "{",
+        "  return (uint32_t)msg_f_GetU16_u16(buf) | ((uint32_t)msg_f_GetU16_u16(&buf[2]) << 16);",
+        "}",
+        "",
+        "uint64_t msg_f_GetU64_u64(const uint8_t *buf)",
+        "{",
+        "  return (uint64_t)msg_f_GetU32_u32(buf) | ((uint64_t)msg_f_GetU32_u32(&buf[4]) << 32);",
+        "}",
+        "",
+    ]
+    out += protos + [""] + helpers_protos + [""] + bodies + helpers
+    return "\n".join(out)
+
+
+# ---------------------------------------------------------------------------------------------------------------
+# C++ (host)
+# ---------------------------------------------------------------------------------------------------------------
+
+def cpp_field(lines, indent, fname, typ, offset, optional, doc):
+    size, ctype, suffix, cpp = TYPES[typ]
+    load = f"detail::load<{cpp}>(data_ + {offset})"
+    if optional:
+        end = offset + size
+        lines.append(f"{indent}/// Whether the payload has {fname} (newer layout)")
+        lines.append(f"{indent}constexpr bool has{upper_first(fname)}() const noexcept {{ return size_ >= {end}; }}")
+        lines.append(f"{indent}/// {doc}, 0 if the payload is older than the field")
+        lines.append(f"{indent}constexpr {cpp} {fname}() const noexcept {{ return has{upper_first(fname)}() ? {load} : 0; }}")
+    else:
+        lines.append(f"{indent}/// {doc}")
+        lines.append(f"{indent}constexpr {cpp} {fname}() const noexcept {{ return {load}; }}")
+
+
+def cpp_header():
+    out = [
+        "/**",
+        " * @file msg.hpp",
+        " *",
+        " * @brief Zero-copy views of the telemetry payloads of both boards",
+        " *",
+        f" * {GENERATED_NOTE}.",
+        " * A view only keeps a pointer to the received payload and reads every field straight out of it, LSB first",
+        " * and from any alignment. Check valid() before reading: it tells whether the payload holds the oldest layout",
+        " * of the message, fields added later have a has...() of their own, so recordings of older firmware decode too",
+        " *",
+        " */",
+        "",
+        "#pragma once",
+        "",
+        "#include <cstddef>",
+        "#include <cstdint>",
+        "#include <type_traits>",
+        "",
+        "namespace openhand {",
+        "namespace msg {",
+        "",
+        "/// Version of messages.py this was generated from",
+        f"constexpr unsigned kSchemaVersion = {messages.SCHEMA_VERSION};",
+        "",
+        "/// Frame IDs",
+        "enum class Id : std::uint8_t",
+        "{",
+    ]
+    for msg in messages.MESSAGES:
+        out.append(f"  {camel(msg['name'])} = 0x{msg['id']:02X}, ///< {msg['dir']}: {msg['doc']}")
+    out += [
+        "};",
+        "",
+        "/// Name of a frame ID as used in messages.py, nullptr if the ID is unknown",
+        "constexpr const char *name(std::uint8_t id) noexcept",
+        "{",
+        "  switch (id)",
+        "  {",
+    ]
+    for msg in messages.MESSAGES:
+        out.append(f"  case 0x{msg['id']:02X}: return \"{msg['name']}\";")
+    out += [
+        "  default: return nullptr;",
+        "  }",
+        "}",
+        "",
+        "/// Configuration parameters, the index of their value in CFG_SET and CFG",
+        "enum class Param : std::uint8_t",
+        "{",
+    ]
+    for i, (name, since, doc) in enumerate(messages.CFG_PARAMS):
+        out.append(f"  {camel(name)}{' = 0' if i == 0 else ''}, ///< {doc}")
+    out += [
+        "};",
+        "",
+        "/// Number of configuration parameters",
+        f"constexpr std::size_t kParamCount = {len(messages.CFG_PARAMS)};",
+        "",
+        "namespace detail {",
+        "",
+        "template <typename T>",
+        "constexpr T load(const std::uint8_t *p) noexcept",
+        "{",
+        "  using U = typename std::make_unsigned<T>::type;",
+        "  U value = 0;",
+        "  for (std::size_t i = 0; i < sizeof(T); ++i)",
+        "  {",
+        "    value = static_cast<U>(value | (static_cast<U>(p[i]) << (8 * i)));",
+        "  }",
+        "  return static_cast<T>(value);",
+        "}",
+        "",
+        "} // namespace detail",
+    ]
+
+    for msg in messages.MESSAGES:
+        if msg.get("raw"):
+            continue
+        name = camel(msg["name"])
+        fields = msg.get("fields", [])
+        offsets, fixed = layout(fields)
+        out += [
+            "",
+            f"/// {msg['name']} ({msg['dir']}): {msg['doc']}" + (" (retired)" if msg.get("retired") else ""),
+            f"class {name}",
+            "{",
+            "public:",
+            f"  static constexpr Id kId = Id::{name};",
+            f"  static constexpr std::size_t kMinSize = {min_len(msg)};",
+            "",
+            f"  constexpr {name}(const std::uint8_t *data, std::size_t size) noexcept : data_(data), size_(size) {{}}",
+            "",
+            "  constexpr bool valid() const noexcept { return size_ >= kMinSize; }",
+        ]
+        for (fname, typ, since, doc), offset in zip(fields, offsets):
+            out.append("")
+            if typ == "bytes":
+                out.append(f"  /// {doc}")
+                out.append(f"  constexpr const std::uint8_t *{fname}() const noexcept {{ return data_ + {offset}; }}")
+                out.append(f"  constexpr std::size_t {fname}Size() const noexcept {{ return size_ - {offset}; }}")
+            else:
+                cpp_field(out, "  ", fname, typ, offset, since != msg["since"], doc)
+        if "group" in msg:
+            group = msg["group"]
+            gname = group["name"]
+            entry = group["entry"]
+            out += [
+                "",
+                f"  /// One entry of {gname}",
+                f"  class {entry}",
+                "  {",
+                "  public:",
+                f"    static constexpr std::size_t kSize = {entry_len(group)};",
+                "",
+                f"    constexpr explicit {entry}(const std::uint8_t *data) noexcept : data_(data) {{}}",
+            ]
+            for (fname, typ, since, doc), offset in zip(group["fields"], layout(group["fields"])[0]):
+                out.append("")
+                cpp_field(out, "    ", fname, typ, offset, False, doc)
+            out += [
+                "",
+                "  private:",
+                "    const std::uint8_t *data_;",
+                "  };",
+                "",
+                f"  /// Number of {gname} entries in the payload",
+                f"  constexpr std::size_t {gname}Count() const noexcept {{ return (size_ - kMinSize) / {entry}::kSize; }}",
+                f"  /// Entry i of {gname}, i < {gname}Count()",
+                f"  constexpr {entry} {gname}(std::size_t i) const noexcept {{ return {entry}(data_ + kMinSize + i * {entry}::kSize); }}",
+            ]
+        out += [
+            "",
+            "private:",
+            "  const std::uint8_t *data_;",
+            "  std::size_t size_;",
+            "};",
+        ]
+    out += ["", "} // namespace msg", "} // namespace openhand", ""]
+    return "\n".join(out)
+
+
+# ---------------------------------------------------------------------------------------------------------------
+
+def outputs():
+    files = {}
+    for board, paths in BOARDS.items():
+        msgs = [m for m in messages.MESSAGES if board in m["boards"] and not m.get("retired")]
+        files[paths["header"]] = c_header(board, msgs)
+        files[paths["internal"]] = c_internal()
+        files[paths["source"]] = c_source(board, msgs)
+    files[HOST_HEADER] = cpp_header()
+    return files
+
+
+def main():
+    check = "--check" in sys.argv[1:]
+    try:
+        validate()
+    except SchemaError as err:
+        print(f"messages.py: {err}", file=sys.stderr)
+        return 1
+
+    stale = []
+    for rel, text in outputs().items():
+        path = os.path.join(ROOT, rel)
+        old = None
+        if os.path.exists(path):
+            with open(path, encoding="utf-8") as f:
+                old = f.read()
+        if old == text:
+            continue
+        stale.append(rel)
+        if not check:
+            os.makedirs(os.path.dirname(path), exist_ok=True)
+            with open(path, "w", encoding="utf-8", newline="\n") as f:
+                f.write(text)
+
+    for rel in stale:
+        print(("out of date: " if check else "written: ") + rel)
+    return 1 if (check and stale) else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,190 @@
+/**
+ * @file client.hpp
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Asynchronous client for the telemetry link of either board
+ *
+ * A background I/O thread reads the transport, timestamps every read, finds the frames and hands them over
+ * a lock-free queue, so nothing a callback does can make it miss bytes. The frames are dispatched to the
+ * callbacks either by a dispatcher thread of the client, which wakes up as soon as the I/O thread queued
+ * something, or by the application calling dispatch() from its own thread (a GUI or a Python loop).
+ *
+ * Callbacks are typed with the views of msg.hpp:
+ *
+ *   openhand::Client client(openhand::openSerial("/dev/ttyUSB0"));
+ *   client.on<openhand::msg::LinkStats>([](const openhand::msg::LinkStats &stats, const openhand::Frame &frame) {
+ *     std::printf("%u B/s\n", stats.txBytesPerSec());
+ *   });
+ *   client.start();
+ *
+ * The view points into the frame, both are only valid during the callback.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "openhand/frame.hpp"
+#include "openhand/msg.hpp"
+#include "openhand/spsc_queue.hpp"
+#include "openhand/transport.hpp"
+
+namespace openhand {
+
+/// What the client saw so far, see Client::stats()
+struct ClientStats
+{
+  std::uint64_t rxBytes = 0;          ///< Bytes read from the transport
+  std::uint64_t rxFrames = 0;         ///< Valid frames found in them
+  std::uint64_t crcErrors = 0;        ///< Frames thrown away because of their CRC
+  std::uint64_t lostFrames = 0;       ///< Gaps in the sequence numbers of the sender
+  std::uint64_t queueDrops = 0;       ///< Frames dropped because the callbacks did not keep up
+  std::uint64_t invalidPayloads = 0;  ///< Frames too short for the view of their typed callback
+  std::uint64_t dispatched = 0;       ///< Frames handed to the callbacks
+  std::uint64_t txFrames = 0;         ///< Frames sent
+  std::int64_t maxLatencyNs = 0;      ///< Longest time from reading a frame to its callbacks
+  std::int64_t meanLatencyNs = 0;     ///< Average of the same
+  std::uint64_t lateFrames = 0;       ///< Frames that took longer than 1 ms to their callbacks
+  bool running = false;               ///< Whether the I/O thread runs
+  std::string error;                  ///< Why the I/O thread stopped on its own (transport gone), empty while it runs
+};
+
+class Client
+{
+public:
+  /// Callback for raw frames
+  using Handler = std::function<void(const Frame &)>;
+
+  /// Frames that fit between the I/O thread and the callbacks, about a second of the full 1 Mbaud link
+  static constexpr std::size_t kQueueSize = 4096;
+
+  /// How often the I/O thread looks whether it should stop, and the longest dispatch() waits without a timeout
+  static constexpr std::chrono::milliseconds kPollPeriod{20};
+
+  explicit Client(std::unique_ptr<Transport> transport);
+  ~Client();
+
+  Client(const Client &) = delete;
+  Client &operator=(const Client &) = delete;
+
+  /// Call back for every valid frame with this ID
+  void onFrame(msg::Id id, Handler handler);
+
+  /// Call back for every valid frame
+  void onAny(Handler handler);
+
+  /// Call back for every frame of message Msg (a view of msg.hpp) that holds at least its oldest layout
+  /// @param callback void(const Msg &, const Frame &)
+  template <typename Msg, typename F>
+  void on(F &&callback)
+  {
+    onFrame(Msg::kId, [this, cb = std::forward<F>(callback)](const Frame &frame) {
+      const Msg message(frame.data(), frame.size);
+      if (!message.valid())
+      {
+        invalidPayloads_.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      cb(message, frame);
+    });
+  }
+
+  /// Start the I/O thread, and the dispatcher thread unless the application calls dispatch() itself
+  void start(bool dispatchThread = true);
+
+  /// Stop both threads, frames still queued are dropped. Called by the destructor
+  void stop();
+
+  /// Hand the queued frames to the callbacks, from the calling thread. Only while there is no dispatcher thread
+  /// @param timeout how long to wait for the first frame if none is queued
+  /// @return number of frames dispatched
+  std::size_t dispatch(std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+
+  /// Send a frame to the board, from any thread
+  /// @return false if the payload is too long or the transport failed
+  bool send(msg::Id id, const std::uint8_t *payload, std::size_t size);
+
+  /// Send a PING carrying the host time in microseconds, the PONG has it back followed by the device time
+  bool ping();
+
+  /// Record every byte read into a file (see transport.hpp for the format), replacing a recording that runs.
+  /// An empty path stops recording
+  /// @return false if the file can't be created
+  bool record(const std::string &path);
+
+  ClientStats stats() const;
+
+  /// steady_clock now, in the nanoseconds of Frame::rxNs
+  static std::int64_t nowNs() noexcept;
+
+private:
+  void ioLoop();
+  void dispatchLoop();
+  void deliver(const Frame &frame);
+  void wake();
+
+  std::unique_ptr<Transport> transport_;
+  FrameParser parser_;
+  SpscQueue<Frame, kQueueSize> queue_;
+
+  std::mutex handlersMutex_;
+  std::array<std::vector<Handler>, 256> handlers_;
+  std::vector<Handler> anyHandlers_;
+
+  std::thread ioThread_;
+  std::thread dispatchThread_;
+  std::atomic<bool> running_{false};
+  std::atomic<bool> ioRunning_{false};
+
+  /// The consumer sleeps on this while the queue is empty, the I/O thread only takes the lock if it does
+  std::mutex wakeMutex_;
+  std::condition_variable wakeCv_;
+  std::atomic<bool> waiting_{false};
+
+  std::mutex txMutex_;
+  std::uint8_t txSeq_ = 0;
+
+  std::mutex recordMutex_;
+  std::FILE *record_ = nullptr;
+  std::int64_t recordStartNs_ = 0;
+
+  /// Written by the I/O thread only
+  std::atomic<std::uint64_t> rxBytes_{0};
+  std::atomic<std::uint64_t> rxFrames_{0};
+  std::atomic<std::uint64_t> crcErrors_{0};
+  std::atomic<std::uint64_t> lostFrames_{0};
+  std::atomic<std::uint64_t> queueDrops_{0};
+  bool haveSeq_ = false;
+  std::uint8_t lastSeq_ = 0;
+
+  /// Written by whoever dispatches
+  std::atomic<std::uint64_t> invalidPayloads_{0};
+  std::atomic<std::uint64_t> dispatched_{0};
+  std::atomic<std::int64_t> maxLatencyNs_{0};
+  std::atomic<std::int64_t> sumLatencyNs_{0};
+  std::atomic<std::uint64_t> lateFrames_{0};
+
+  std::atomic<std::uint64_t> txFrames_{0};
+
+  mutable std::mutex errorMutex_;
+  std::string error_;
+};
+
+} // namespace openhand
@@ -0,0 +1,152 @@
+/**
+ * @file frame.hpp
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Telemetry frames as they come over the link, and the parser that finds them in the byte stream
+ *
+ * Same framing as drivers/lnk of the ESP32 and the telemetry link of the STM32:
+ * sync1 0xA5, sync2 0x5A, id, seq, len, payload[len], CRC-16/CCITT (init 0xFFFF) over id, seq, len
+ * and payload, LSB first. The payloads are read with the views in msg.hpp
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace openhand {
+
+/// Two sync bytes that start every frame
+constexpr std::uint8_t kSync1 = 0xA5;
+constexpr std::uint8_t kSync2 = 0x5A;
+
+/// Frame layout around the payload
+constexpr std::size_t kHeaderSize = 5;
+constexpr std::size_t kCrcSize = 2;
+
+/// Largest payload the length byte allows, the boards send less (see LNK_MAX_PAYLOAD)
+constexpr std::size_t kMaxPayload = 255;
+constexpr std::size_t kMaxFrame = kHeaderSize + kMaxPayload + kCrcSize;
+
+/// One valid frame received from a board
+struct Frame
+{
+  std::uint8_t id = 0;   ///< Frame ID, see msg::Id
+  std::uint8_t seq = 0;  ///< Sequence number of the sender, counts up by one per frame
+  std::uint8_t size = 0; ///< Payload length
+  std::int64_t rxNs = 0; ///< When the read that completed the frame returned, steady_clock nanoseconds
+  std::array<std::uint8_t, kMaxPayload> payload{};
+
+  const std::uint8_t *data() const noexcept { return payload.data(); }
+};
+
+/// CRC-16/CCITT, bit by bit like on the boards
+/// @param crc starting value, 0xFFFF for a new frame, lets the CRC be computed in parts
+constexpr std::uint16_t crc16(std::uint16_t crc, const std::uint8_t *data, std::size_t size) noexcept
+{
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    crc = static_cast<std::uint16_t>(crc ^ (static_cast<std::uint16_t>(data[i]) << 8));
+    for (int j = 0; j < 8; ++j)
+    {
+      crc = (crc & 0x8000) ? static_cast<std::uint16_t>((crc << 1) ^ 0x1021) : static_cast<std::uint16_t>(crc << 1);
+    }
+  }
+  return crc;
+}
+
+/// Put a frame together
+/// @param out room for kHeaderSize + size + kCrcSize bytes
+/// @return length of the frame, 0 if the payload is too long
+std::size_t encodeFrame(std::uint8_t id, std::uint8_t seq, const std::uint8_t *payload, std::size_t size, std::uint8_t *out) noexcept;
+
+/// Finds the frames in a byte stream, resyncs on the next sync bytes after anything broken.
+/// The bytes of a frame that fails its CRC are searched again from after its sync bytes: when bytes were lost, the
+/// broken frame has taken the start of the next one, and sync bytes in a payload would otherwise keep the parser
+/// off the real frames
+class FrameParser
+{
+public:
+  /// Run received bytes through the parser
+  /// @param rxNs when the bytes were read, given to every frame they complete
+  /// @param onFrame called with every valid frame, void(const Frame &)
+  template <typename F>
+  void feed(const std::uint8_t *data, std::size_t size, std::int64_t rxNs, F &&onFrame)
+  {
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      if (step(data[i], false))
+      {
+        frame_.rxNs = rxNs;
+        onFrame(static_cast<const Frame &>(frame_));
+      }
+      while (rescanPos_ < rescanSize_)
+      {
+        if (step(rescan_[rescanPos_++], true))
+        {
+          frame_.rxNs = rxNs;
+          onFrame(static_cast<const Frame &>(frame_));
+        }
+      }
+      rescanPos_ = rescanSize_ = 0;
+    }
+  }
+
+  /// Start over with the next frame, e.g. after bytes were lost
+  void reset() noexcept
+  {
+    state_ = State::Sync1;
+    rescanPos_ = rescanSize_ = 0;
+  }
+
+  /// Frames that were thrown away because of their CRC. Frames that only seemed to start inside a broken one
+  /// are not counted
+  std::uint64_t crcErrors() const noexcept { return crcErrors_; }
+
+private:
+  enum class State : std::uint8_t
+  {
+    Sync1,
+    Sync2,
+    Id,
+    Seq,
+    Len,
+    Payload,
+    Crc1,
+    Crc2
+  };
+
+  /// @param rescanned whether the byte is searched again, see rescan()
+  /// @return true when the byte completed a valid frame
+  bool step(std::uint8_t byte, bool rescanned) noexcept;
+
+  /// Search the bytes of the frame that just failed again, before anything not yet parsed
+  void rescan() noexcept;
+
+  State state_ = State::Sync1;
+  std::size_t index_ = 0;
+  std::uint16_t crc_ = 0;
+  std::uint64_t crcErrors_ = 0;
+  Frame frame_;
+
+  /// Bytes of the frame being parsed, from its first sync byte, and whether it started in rescanned bytes
+  std::array<std::uint8_t, kMaxFrame> raw_{};
+  std::size_t rawSize_ = 0;
+  bool rawRescanned_ = false;
+
+  /// Bytes still to be searched again, ahead of the received ones. Never more than a frame: a frame that fails
+  /// while they are searched is made of them
+  std::array<std::uint8_t, kMaxFrame> rescan_{};
+  std::size_t rescanPos_ = 0;
+  std::size_t rescanSize_ = 0;
+};
+
+} // namespace openhand
@@ -0,0 +1,957 @@
+/**
+ * @file msg.hpp
+ *
+ * @brief Zero-copy views of the telemetry payloads of both boards
+ *
+ * Generated from firmware/msg/messages.py by firmware/msg/msggen.py, do not edit.
+ * A view only keeps a pointer to the received payload and reads every field straight out of it, LSB first
+ * and from any alignment. Check valid() before reading: it tells whether the payload holds the oldest layout
+ * of the message, fields added later have a has...() of their own, so recordings of older firmware decode too
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace openhand {
+namespace msg {
+
+/// Version of messages.py this was generated from
+constexpr unsigned kSchemaVersion = 8;
+
+/// Frame IDs
+enum class Id : std::uint8_t
+{
+  Ping = 0x01, ///< host -> device: Echoed back as PONG, the payload is up to the host (usually its own timestamp)
+  UpdBegin = 0x10, ///< host -> device: Start or resume a firmware update
+  UpdData = 0x11, ///< host -> device: Next chunk of the new firmware
+  UpdCommit = 0x12, ///< host -> device: Check the whole new firmware and install it
+  UpdStatus = 0x13, ///< host -> device: Ask where the update stands
+  TsyReq = 0x14, ///< either way: Time sync request, answered with TSY_RESP
+  Sub = 0x15, ///< host -> device: Subscribe to a telemetry signal, answered with SUB_STATE
+  StpCtrl = 0x16, ///< host -> device: Hand the servos to the setpoint stream or back to the local inputs, answered with STP_STATS
+  Stp = 0x17, ///< host -> device: One setpoint of the stream, one entry per servo from the first one on
+  CfgSet = 0x18, ///< host -> device: Change configuration parameters, answered with CFG. Also the value written to the BLE config characteristic
+  Pong = 0x81, ///< device -> host: PING payload followed by the device time in microseconds (u32)
+  LinkStats = 0x82, ///< device -> host: Telemetry link statistics
+  Rtm = 0x83, ///< device -> host: Runtime measurement of the scheduler slots
+  IrqStats = 0x84, ///< device -> host: Interrupt timing, one entry per irq_Id_e
+  Signals = 0x85, ///< device -> host: Samples of the subscribed signals that were due
+  UpdReply = 0x90, ///< device -> host: Reply to every firmware update frame
+  TsyResp = 0x94, ///< either way: Time sync reply, dated by the last byte of both frames
+  TsyStats = 0x95, ///< STM32 -> ESP32: Clock model of the STM32 against the ESP32 clock
+  SubState = 0x96, ///< device -> host: Subscription of one signal and what it costs, the reply to SUB and sent every second while subscribed
+  StpStats = 0x97, ///< device -> host: State of the setpoint stream, the reply to STP_CTRL and sent every second while streaming
+  Cfg = 0x98, ///< device -> host: All configuration parameters, the reply to CFG_SET. Also the value read from the BLE config characteristic
+  OsStats = 0x99, ///< device -> host: FreeRTOS load, stack and heap usage, sent every CFG_OS_STATS_PERIOD ms
+  Trace = 0x9A, ///< device -> host: Events recorded on one core (drivers/trc), in the order they happened, while CFG_TRACE_EVENTS isn't 0
+  TraceTasks = 0x9B, ///< device -> host: Names of the task indexes in the task switch events of one core, every second while tracing
+  ErrStats = 0x9C, ///< device -> host: Runtime driver errors (drivers/err), sent every second
+};
+
+/// Name of a frame ID as used in messages.py, nullptr if the ID is unknown
+constexpr const char *name(std::uint8_t id) noexcept
+{
+  switch (id)
+  {
+  case 0x01: return "PING";
+  case 0x10: return "UPD_BEGIN";
+  case 0x11: return "UPD_DATA";
+  case 0x12: return "UPD_COMMIT";
+  case 0x13: return "UPD_STATUS";
+  case 0x14: return "TSY_REQ";
+  case 0x15: return "SUB";
+  case 0x16: return "STP_CTRL";
+  case 0x17: return "STP";
+  case 0x18: return "CFG_SET";
+  case 0x81: return "PONG";
+  case 0x82: return "LINK_STATS";
+  case 0x83: return "RTM";
+  case 0x84: return "IRQ_STATS";
+  case 0x85: return "SIGNALS";
+  case 0x90: return "UPD_REPLY";
+  case 0x94: return "TSY_RESP";
+  case 0x95: return "TSY_STATS";
+  case 0x96: return "SUB_STATE";
+  case 0x97: return "STP_STATS";
+  case 0x98: return "CFG";
+  case 0x99: return "OS_STATS";
+  case 0x9A: return "TRACE";
+  case 0x9B: return "TRACE_TASKS";
+  case 0x9C: return "ERR_STATS";
+  default: return nullptr;
+  }
+}
+
+/// Configuration parameters, the index of their value in CFG_SET and CFG
+enum class Param : std::uint8_t
+{
+  Sns1Threshold = 0, ///< Activation threshold of sensor 1, ADC counts 0..4095
+  Sns2Threshold, ///< Activation threshold of sensor 2, ADC counts 0..4095
+  Srv1Range, ///< Travel of servo 1 above its minimum angle, degrees
+  Srv2Range, ///< Travel of servo 2 above its minimum angle, degrees
+  Srv3Range, ///< Travel of servo 3 above its minimum angle, degrees
+  OsStatsPeriod, ///< How often OS_STATS is sent, milliseconds 100..60000, 0 - off
+  TraceEvents, ///< Events the tracer records and sends in TRACE, trc_EventMask_e bits, 0 - off
+};
+
+/// Number of configuration parameters
+constexpr std::size_t kParamCount = 7;
+
+namespace detail {
+
+template <typename T>
+constexpr T load(const std::uint8_t *p) noexcept
+{
+  using U = typename std::make_unsigned<T>::type;
+  U value = 0;
+  for (std::size_t i = 0; i < sizeof(T); ++i)
+  {
+    value = static_cast<U>(value | (static_cast<U>(p[i]) << (8 * i)));
+  }
+  return static_cast<T>(value);
+}
+
+} // namespace detail
+
+/// UPD_BEGIN (host -> device): Start or resume a firmware update
+class UpdBegin
+{
+public:
+  static constexpr Id kId = Id::UpdBegin;
+  static constexpr std::size_t kMinSize = 8;
+
+  constexpr UpdBegin(const std::uint8_t *data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+  constexpr bool valid() const noexcept { return size_ >= kMinSize; }
+
+  /// Size of the new image in bytes
+  constexpr std::uint32_t size() const noexcept { return detail::load<std::uint32_t>(data_ + 0); }
+
+  /// CRC-32 of the new image
+  constexpr std::uint32_t crc() const noexcept { return detail::load<std::uint32_t>(data_ + 4); }
+
+private:
+  const std::uint8_t *data_;
+  std::size_t size_;
+};
+
+/// UPD_DATA (host -> device): Next chunk of the new firmware
+class UpdData
+{
+public:
+  static constexpr Id kId = Id::UpdData;
+  static constexpr std::size_t kMinSize = 4;
+
+  constexpr UpdData(const std::uint8_t *data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+  constexpr bool valid() const noexcept { return size_ >= kMinSize; }
+
+  /// Offset of the chunk in the image
+  constexpr std::uint32_t offset() const noexcept { return detail::load<std::uint32_t>(data_ + 0); }
+
+  /// The chunk, an even number of bytes
+  constexpr const std::uint8_t *data() const noexcept { return data_ + 4; }
+  constexpr std::size_t dataSize() const noexcept { return size_ - 4; }
+
+private:
+  const std::uint8_t *data_;
+  std::size_t size_;
+};
+
+/// UPD_COMMIT (host -> device): Check the whole new firmware and install it
+class UpdCommit
+{
+public:
+  static constexpr Id kId = Id::UpdCommit;
+  static constexpr std::size_t kMinSize = 0;
+
+  constexpr UpdCommit(const std::uint8_t *data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+  constexpr bool valid() const noexcept { return size_ >= kMinSize; }
+
+private:
+  const std::uint8_t *data_;
+  std::size_t size_;
+};
+
+/// UPD_STATUS (host -> device): Ask where the update stands
+class UpdStatus
+{
+public:
+  static constexpr Id kId = Id::UpdStatus;
+  static constexpr std::size_t kMinSize = 0;
+
+  constexpr UpdStatus(const std::uint8_t *data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+  constexpr bool valid() const noexcept { return size_ >= kMinSize; }
+
+private:
+  const std::uint8_t *data_;
+  std::size_t size_;
+};
+
+/// TSY_REQ (either way): Time sync request, answered with TSY_RESP
+class TsyReq
+{
+public:
+  static constexpr Id kId = Id::TsyReq;
+  static constexpr std::size_t kMinSize = 1;
+
+  constexpr TsyReq(const std::uint8_t *data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+  constexpr bool valid() const noexcept { return size_ >= kMinSize; }
+
+  /// Tells the reply apart from a late reply to an earlier request
+  constexpr std::uint8_t tag() const noexcept { return detail::load<std::uint8_t>(data_ + 0); }
+
+private:
+  const std::uint8_t *data_;
+  std::size_t size_;
+};
+
+/// SUB (host -> device): Subscribe to a telemetry signal, answered with SUB_STATE
+class Sub
+{
+public:
+  static constexpr Id kId = Id::Sub;
+  static constexpr std::size_t kMinSize = 6;
+
+  constexpr Sub(const std::uint8_t *data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+  constexpr bool valid() const noexcept { return size_ >= kMinSize; }
+
+  /// tlm_Signal_e, 0xFF for all of them
+  constexpr std::uint8_t signal() const noexcept { return detail::load<std::uint8_t>(data_ + 0); }
+
+  /// tlm_SubMode_e, 0xFF to only ask for the state
+  constexpr std::uint8_t mode() const noexcept { return detail::load<std::uint8_t>(data_ + 1); }
+
+  /// How often the signal is sampled, rounded up to the telemetry task period
+  constexpr std::uint16_t periodMs() const noexcept { return detail::load<std::uint16_t>(data_ + 2); }
+
+  /// On change: how far a channel has to move from the last sent value
+  constexpr std::uint16_t threshold() const noexcept { return detail::load<std::uint16_t>(data_ + 4); }
+
+private:
+  const std::uint8_t *data_;
+  std::size_t size_;
+};
+
+/// STP_CTRL (host -> device): Hand the servos to the setpoint stream or back to the local inputs, answered with STP_STATS
+class StpCtrl
+{
+public:
+  static constexpr Id kId = Id::StpCtrl;
+  static constexpr std::size_t kMinSize = 5;
+
+  constexpr StpCtrl(const std::uint8_t *data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+  constexpr bool valid() const noexcept { return size_ >= kMinSize; }
+
+  /// stp_Mode_e, 0xFF to only ask for the state
+  constexpr std::uint8_t mode() const noexcept { return detail::load<std::uint8_t>(data_ + 0); }
+
+  /// Jitter buffer: how long after it was sent a setpoint is applied, 0 for the default
+  constexpr std::uint16_t delayUs() const noexcept { return detail::load<std::uint16_t>(data_ + 1); }
+
+  /// Watchdog: without setpoints for this long the hand goes to the safe posture, 0 for the default
+  constexpr std::uint16_t timeoutMs() const noexcept { return detail::load<std::uint16_t>(data_ + 3); }
+
+private:
+  const std::uint8_t *data_;
+  std::size_t size_;
+};
+
+/// STP (host -> device): One setpoint of the stream, one entry per servo from the first one on
+class Stp
+{
+public:
+  static constexpr Id kId = Id::Stp;
+  static constexpr std::size_t kMinSize = 6;
+
+  constexpr Stp(const std::uint8_t *data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+  constexpr bool valid() const noexcept { return size_ >= kMinSize; }
+
+  /// Host time the setpoint was sent at (or is meant for), microseconds
+  constexpr std::uint32_t hostUs() const noexcept { return detail::load<std::uint32_t>(data_ + 0); }
+
+  /// Counted up with every setpoint, older or repeated ones are dropped
+  constexpr std::uint16_t seq() const noexcept { return detail::load<std::uint16_t>(data_ + 4); }
+
+  /// One entry of targets
+  class Target
+  {
+  public:
+    static constexpr std::size_t kSize = 2;
+
+    constexpr explicit Target(const std::uint8_t *data) noexcept : data_(data) {}
+
+    /// 0 (open, minimum angle)..10000 (maximum angle), in 0.01%
+    constexpr std::uint16_t position() const noexcept { return detail::load<std::uint16_t>(data_ + 0); }
+
+  private:
+    const std::uint8_t *data_;
+  };
+
+  /// Number of targets entries in the payload
+  constexpr std::size_t targetsCount() const noexcept { return (size_ - kMinSize) / Target::kSize; }
+  /// Entry i of targets, i < targetsCount()
+  constexpr Target targets(std::size_t i) const noexcept { return Target(data_ + kMinSize + i * Target::kSize); }
+
+private:
+  const std::uint8_t *data_;
+  std::size_t size_;
+};
+
+/// CFG_SET (host -> device): Change configuration parameters, answered with CFG. Also the value written to the BLE config characteristic
+class CfgSet
+{
+public:
+  static constexpr Id kId = Id::CfgSet;
+  static constexpr std::size_t kMinSize = 0;
+
+  constexpr CfgSet(const std::uint8_t *data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+  constexpr bool valid() const noexcept { return size_ >= kMinSize; }
+
+  /// One entry of values
+  class Value
+  {
+  public:
+    static constexpr std::size_t kSize = 2;
+
+    constexpr explicit Value(const std::uint8_t *data) noexcept : data_(data) {}
+
+    /// New value of the parameter with this index (cfg_Param_e), 0xFFFF leaves it as it is
+    constexpr std::uint16_t value() const noexcept { return detail::load<std::uint16_t>(data_ + 0); }
+
+  private:
+    const std::uint8_t *data_;
+  };
+
+  /// Number of values entries in the payload
+  constexpr std::size_t valuesCount() const noexcept { return (size_ - kMinSize) / Value::kSize; }
+  /// Entry i of values, i < valuesCount()
+  constexpr Value values(std::size_t i) const noexcept { return Value(data_ + kMinSize + i * Value::kSize); }
+
+private:
+  const std::uint8_t *data_;
+  std::size_t size_;
+};
+
+/// LINK_STATS (device -> host): Telemetry link statistics
+class LinkStats
+{
+public:
+  static constexpr Id kId = Id::LinkStats;
+  static constexpr std::size_t kMinSize = 36;
+
+  constexpr LinkStats(const std::uint8_t *data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+  constexpr bool valid() const noexcept { return size_ >= kMinSize; }
+
+  /// Device time
+  constexpr std::uint32_t timeUs() const noexcept { return detail::load<std::uint32_t>(data_ + 0); }
+
+  /// Bytes written to the UART
+  constexpr std::uint32_t txBytes() const noexcept { return detail::load<std::uint32_t>(data_ + 4); }
+
+  /// Frames written to the UART
+  constexpr std::uint32_t txFrames() const noexcept { return detail::load<std::uint32_t>(data_ + 8); }
+
+  /// Frames dropped because the TX buffer was full
+  constexpr std::uint32_t txDropped() const noexcept { return detail::load<std::uint32_t>(data_ + 12); }
+
+  /// Valid frames received
+  constexpr std::uint32_t rxFrames() const noexcept { return detail::load<std::uint32_t>(data_ + 16); }
+
+  /// Frames received with a bad CRC or length
+  constexpr std::uint32_t rxErrors() const noexcept { return detail::load<std::uint32_t>(data_ + 20); }
+
+  /// Throughput over the last second
+  constexpr std::uint32_t txBytesPerSec() const noexcept { return detail::load<std::uint32_t>(data_ + 24); }
+
+  /// Longest time spent queueing a frame
+  constexpr std::uint32_t maxWriteUs() const noexcept { return detail::load<std::uint32_t>(data_ + 28); }
+
+  /// Longest time a byte waited in the TX buffer
+  constexpr std::uint32_t maxBacklogUs() const noexcept { return detail::load<std::uint32_t>(data_ + 32); }
+
+private:
+  const std::uint8_t *data_;
+  std::size_t size_;
+};
+
+/// RTM (device -> host): Runtime measurement of the scheduler slots
+class Rtm
+{
+public:
+  static constexpr Id kId = Id::Rtm;
+  static constexpr std::size_t kMinSize = 4;
+
+  constexpr Rtm(const std::uint8_t *data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+  constexpr bool valid() const noexcept { return size_ >= kMinSize; }
+
+  /// Device time
+  constexpr std::uint32_t timeUs() const noexcept { return detail::load<std::uint32_t>(data_ + 0); }
+
+  /// One entry of slots
+  class Slot
+  {
+  public:
+    static constexpr std::size_t kSize = 6;
+
+    constexpr explicit Slot(const std::uint8_t *data) noexcept : data_(data) {}
+
+    /// Runtime of the last cycle
+    constexpr std::uint16_t currentUs() const noexcept { return detail::load<std::uint16_t>(data_ + 0); }
+
+    /// Shortest runtime
+    constexpr std::uint16_t minUs() const noexcept { return detail::load<std::uint16_t>(data_ + 2); }
+
+    /// Longest runtime
+    constexpr std::uint16_t maxUs() const noexcept { return detail::load<std::uint16_t>(data_ + 4); }
+
+  private:
+    const std::uint8_t *data_;
+  };
+
+  /// Number of slots entries in the payload
+  constexpr std::size_t slotsCount() const noexcept { return (size_ - kMinSize) / Slot::kSize; }
+  /// Entry i of slots, i < slotsCount()
+  constexpr Slot slots(std::size_t i) const noexcept { return Slot(data_ + kMinSize + i * Slot::kSize); }
+
+private:
+  const std::uint8_t *data_;
+  std::size_t size_;
+};
+
+/// IRQ_STATS (device -> host): Interrupt timing, one entry per irq_Id_e
+class IrqStats
+{
+public:
+  static constexpr Id kId = Id::IrqStats;
+  static constexpr std::size_t kMinSize = 4;
+
+  constexpr IrqStats(const std::uint8_t *data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+  constexpr bool valid() const noexcept { return size_ >= kMinSize; }
+
+  /// CPU clock, to convert the cycles
+  constexpr std::uint32_t cpuHz() const noexcept { return detail::load<std::uint32_t>(data_ + 0); }
+
+  /// One entry of irqs
+  class Irq
+  {
+  public:
+    static constexpr std::size_t kSize = 12;
+
+    constexpr explicit Irq(const std::uint8_t *data) noexcept : data_(data) {}
+
+    /// Number of times the interrupt ran
+    constexpr std::uint32_t count() const noexcept { return detail::load<std::uint32_t>(data_ + 0); }
+
+    /// Worst execution time
+    constexpr std::uint32_t maxCycles() const noexcept { return detail::load<std::uint32_t>(data_ + 4); }
+
+    /// Worst entry latency, 0 where it is not measured
+    constexpr std::uint32_t maxLatency() const noexcept { return detail::load<std::uint32_t>(data_ + 8); }
+
+  private:
+    const std::uint8_t *data_;
+  };
+
+  /// Number of irqs entries in the payload
+  constexpr std::size_t irqsCount() const noexcept { return (size_ - kMinSize) / Irq::kSize; }
+  /// Entry i of irqs, i < irqsCount()
+  constexpr Irq irqs(std::size_t i) const noexcept { return Irq(data_ + kMinSize + i * Irq::kSize); }
+
+private:
+  const std::uint8_t *data_;
+  std::size_t size_;
+};
+
+/// SIGNALS (device -> host): Samples of the subscribed signals that were due
+class Signals
+{
+public:
+  static constexpr Id kId = Id::Signals;
+  static constexpr std::size_t kMinSize = 4;
+
+  constexpr Signals(const std::uint8_t *data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+  constexpr bool valid() const noexcept { return size_ >= kMinSize; }
+
+  /// Device time
+  constexpr std::uint32_t timeUs() const noexcept { return detail::load<std::uint32_t>(data_ + 0); }
+
+  /// Per signal: tlm_Signal_e u8, channel count u8, then a u16 per channel
+  constexpr const std::uint8_t *records() const noexcept { return data_ + 4; }
+  constexpr std::size_t recordsSize() const noexcept { return size_ - 4; }
+
+private:
+  const std::uint8_t *data_;
+  std::size_t size_;
+};
+
+/// UPD_REPLY (device -> host): Reply to every firmware update frame
+class UpdReply
+{
+public:
+  static constexpr Id kId = Id::UpdReply;
+  static constexpr std::size_t kMinSize = 7;
+
+  constexpr UpdReply(const std::uint8_t *data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+  constexpr bool valid() const noexcept { return size_ >= kMinSize; }
+
+  /// ID of the frame replied to
+  constexpr std::uint8_t reqId() const noexcept { return detail::load<std::uint8_t>(data_ + 0); }
+
+  /// upd_Status_e
+  constexpr std::uint8_t status() const noexcept { return detail::load<std::uint8_t>(data_ + 1); }
+
+  /// upd_State_e
+  constexpr std::uint8_t state() const noexcept { return detail::load<std::uint8_t>(data_ + 2); }
+
+  /// Offset of the next chunk expected
+  constexpr std::uint32_t next() const noexcept { return detail::load<std::uint32_t>(data_ + 3); }
+
+  /// Whether the payload has image (newer layout)
+  constexpr bool hasImage() const noexcept { return size_ >= 8; }
+  /// upd_Image_e, where the last committed image stands with the boot stage, 0 if the payload is older than the field
+  constexpr std::uint8_t image() const noexcept { return hasImage() ? detail::load<std::uint8_t>(data_ + 7) : 0; }
+
+  /// Whether the payload has crc (newer layout)
+  constexpr bool hasCrc() const noexcept { return size_ >= 12; }
+  /// CRC-32 of the last committed image, 0 without one, 0 if the payload is older than the field
+  constexpr std::uint32_t crc() const noexcept { return hasCrc() ? detail::load<std::uint32_t>(data_ + 8) : 0; }
+
+private:
+  const std::uint8_t *data_;
+  std::size_t size_;
+};
+
+/// TSY_RESP (either way): Time sync reply, dated by the last byte of both frames
+class TsyResp
+{
+public:
+  static constexpr Id kId = Id::TsyResp;
+  static constexpr std::size_t kMinSize = 17;
+
+  constexpr TsyResp(const std::uint8_t *data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+  constexpr bool valid() const noexcept { return size_ >= kMinSize; }
+
+  /// Tag of the request
+  constexpr std::uint8_t tag() const noexcept { return detail::load<std::uint8_t>(data_ + 0); }
+
+  /// When the last byte of the request arrived
+  constexpr std::uint64_t rxUs() const noexcept { return detail::load<std::uint64_t>(data_ + 1); }
+
+  /// When the last byte of this reply leaves
+  constexpr std::uint64_t txUs() const noexcept { return detail::load<std::uint64_t>(data_ + 9); }
+
+private:
+  const std::uint8_t *data_;
+  std::size_t size_;
+};
+
+/// TSY_STATS (STM32 -> ESP32): Clock model of the STM32 against the ESP32 clock
+class TsyStats
+{
+public:
+  static constexpr Id kId = Id::TsyStats;
+  static constexpr std::size_t kMinSize = 36;
+
+  constexpr TsyStats(const std::uint8_t *data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+  constexpr bool valid() const noexcept { return size_ >= kMinSize; }
+
+  /// STM32 time of the exchange the model is based on
+  constexpr std::uint64_t refUs() const noexcept { return detail::load<std::uint64_t>(data_ + 0); }
+
+  /// ESP32 time minus STM32 time at refUs
+  constexpr std::int64_t offsetUs() const noexcept { return detail::load<std::int64_t>(data_ + 8); }
+
+  /// How much faster the ESP32 clock runs, parts per billion
+  constexpr std::int32_t driftPpb() const noexcept { return detail::load<std::int32_t>(data_ + 16); }
+
+  /// Round trip of that exchange
+  constexpr std::uint32_t rttUs() const noexcept { return detail::load<std::uint32_t>(data_ + 20); }
+
+  /// Error bound of the model
+  constexpr std::uint32_t errorUs() const noexcept { return detail::load<std::uint32_t>(data_ + 24); }
+
+  /// Windows that had a usable exchange
+  constexpr std::uint32_t samples() const noexcept { return detail::load<std::uint32_t>(data_ + 28); }
+
+  /// Requests without a usable reply
+  constexpr std::uint32_t lost() const noexcept { return detail::load<std::uint32_t>(data_ + 32); }
+
+private:
+  const std::uint8_t *data_;
+  std::size_t size_;
+};
+
+/// SUB_STATE (device -> host): Subscription of one signal and what it costs, the reply to SUB and sent every second while subscribed
+class SubState
+{
+public:
+  static constexpr Id kId = Id::SubState;
+  static constexpr std::size_t kMinSize = 15;
+
+  constexpr SubState(const std::uint8_t *data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+  constexpr bool valid() const noexcept { return size_ >= kMinSize; }
+
+  /// tlm_Signal_e
+  constexpr std::uint8_t signal() const noexcept { return detail::load<std::uint8_t>(data_ + 0); }
+
+  /// tlm_SubMode_e
+  constexpr std::uint8_t mode() const noexcept { return detail::load<std::uint8_t>(data_ + 1); }
+
+  /// Sampling period in effect
+  constexpr std::uint16_t periodMs() const noexcept { return detail::load<std::uint16_t>(data_ + 2); }
+
+  /// On change threshold
+  constexpr std::uint16_t threshold() const noexcept { return detail::load<std::uint16_t>(data_ + 4); }
+
+  /// Values per sample
+  constexpr std::uint8_t channels() const noexcept { return detail::load<std::uint8_t>(data_ + 6); }
+
+  /// Link bandwidth the signal used over the last second
+  constexpr std::uint32_t bytesPerSec() const noexcept { return detail::load<std::uint32_t>(data_ + 7); }
+
+  /// Samples dropped because the TX buffer was full
+  constexpr std::uint32_t dropped() const noexcept { return detail::load<std::uint32_t>(data_ + 11); }
+
+private:
+  const std::uint8_t *data_;
+  std::size_t size_;
+};
+
+/// STP_STATS (device -> host): State of the setpoint stream, the reply to STP_CTRL and sent every second while streaming
+class StpStats
+{
+public:
+  static constexpr Id kId = Id::StpStats;
+  static constexpr std::size_t kMinSize = 49;
+
+  constexpr StpStats(const std::uint8_t *data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+  constexpr bool valid() const noexcept { return size_ >= kMinSize; }
+
+  /// stp_Mode_e
+  constexpr std::uint8_t mode() const noexcept { return detail::load<std::uint8_t>(data_ + 0); }
+
+  /// stp_State_e
+  constexpr std::uint8_t state() const noexcept { return detail::load<std::uint8_t>(data_ + 1); }
+
+  /// Setpoints waiting in the jitter buffer
+  constexpr std::uint8_t depth() const noexcept { return detail::load<std::uint8_t>(data_ + 2); }
+
+  /// Jitter buffer delay in effect
+  constexpr std::uint16_t delayUs() const noexcept { return detail::load<std::uint16_t>(data_ + 3); }
+
+  /// Watchdog timeout in effect
+  constexpr std::uint16_t timeoutMs() const noexcept { return detail::load<std::uint16_t>(data_ + 5); }
+
+  /// Setpoints received
+  constexpr std::uint32_t received() const noexcept { return detail::load<std::uint32_t>(data_ + 7); }
+
+  /// Setpoints that arrived after they were due, applied right away
+  constexpr std::uint32_t late() const noexcept { return detail::load<std::uint32_t>(data_ + 11); }
+
+  /// Setpoints dropped because they were out of order or the jitter buffer was full
+  constexpr std::uint32_t dropped() const noexcept { return detail::load<std::uint32_t>(data_ + 15); }
+
+  /// Servo cycles without a new setpoint, the last one was held
+  constexpr std::uint32_t holds() const noexcept { return detail::load<std::uint32_t>(data_ + 19); }
+
+  /// Times the watchdog sent the hand to the safe posture
+  constexpr std::uint32_t timeouts() const noexcept { return detail::load<std::uint32_t>(data_ + 23); }
+
+  /// seq of the setpoint applied last
+  constexpr std::uint16_t lastSeq() const noexcept { return detail::load<std::uint16_t>(data_ + 27); }
+
+  /// hostUs of the setpoint applied last
+  constexpr std::uint32_t lastHostUs() const noexcept { return detail::load<std::uint32_t>(data_ + 29); }
+
+  /// Time from receiving that setpoint until this frame was queued, round trip = host receive time - lastHostUs - dwellUs
+  constexpr std::uint32_t dwellUs() const noexcept { return detail::load<std::uint32_t>(data_ + 33); }
+
+  /// Spread of the one-way transit time over the last second
+  constexpr std::uint32_t jitterUs() const noexcept { return detail::load<std::uint32_t>(data_ + 37); }
+
+  /// Shortest time from receiving a setpoint until it was applied, over the last second
+  constexpr std::uint32_t minLatencyUs() const noexcept { return detail::load<std::uint32_t>(data_ + 41); }
+
+  /// Longest time from receiving a setpoint until it was applied, over the last second
+  constexpr std::uint32_t maxLatencyUs() const noexcept { return detail::load<std::uint32_t>(data_ + 45); }
+
+private:
+  const std::uint8_t *data_;
+  std::size_t size_;
+};
+
+/// CFG (device -> host): All configuration parameters, the reply to CFG_SET. Also the value read from the BLE config characteristic
+class Cfg
+{
+public:
+  static constexpr Id kId = Id::Cfg;
+  static constexpr std::size_t kMinSize = 0;
+
+  constexpr Cfg(const std::uint8_t *data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+  constexpr bool valid() const noexcept { return size_ >= kMinSize; }
+
+  /// One entry of values
+  class Value
+  {
+  public:
+    static constexpr std::size_t kSize = 2;
+
+    constexpr explicit Value(const std::uint8_t *data) noexcept : data_(data) {}
+
+    /// Value of the parameter with this index (cfg_Param_e)
+    constexpr std::uint16_t value() const noexcept { return detail::load<std::uint16_t>(data_ + 0); }
+
+  private:
+    const std::uint8_t *data_;
+  };
+
+  /// Number of values entries in the payload
+  constexpr std::size_t valuesCount() const noexcept { return (size_ - kMinSize) / Value::kSize; }
+  /// Entry i of values, i < valuesCount()
+  constexpr Value values(std::size_t i) const noexcept { return Value(data_ + kMinSize + i * Value::kSize); }
+
+private:
+  const std::uint8_t *data_;
+  std::size_t size_;
+};
+
+/// OS_STATS (device -> host): FreeRTOS load, stack and heap usage, sent every CFG_OS_STATS_PERIOD ms
+class OsStats
+{
+public:
+  static constexpr Id kId = Id::OsStats;
+  static constexpr std::size_t kMinSize = 23;
+
+  constexpr OsStats(const std::uint8_t *data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+  constexpr bool valid() const noexcept { return size_ >= kMinSize; }
+
+  /// Device time
+  constexpr std::uint32_t timeUs() const noexcept { return detail::load<std::uint32_t>(data_ + 0); }
+
+  /// Run time the CPU loads cover, since the previous OS_STATS
+  constexpr std::uint32_t windowUs() const noexcept { return detail::load<std::uint32_t>(data_ + 4); }
+
+  /// Free heap now, bytes
+  constexpr std::uint32_t heapFree() const noexcept { return detail::load<std::uint32_t>(data_ + 8); }
+
+  /// Least free heap since boot, bytes
+  constexpr std::uint32_t heapMinFree() const noexcept { return detail::load<std::uint32_t>(data_ + 12); }
+
+  /// Idle time of core 0 over the window, in 0.01%
+  constexpr std::uint16_t idle0() const noexcept { return detail::load<std::uint16_t>(data_ + 16); }
+
+  /// Idle time of core 1 over the window, in 0.01%
+  constexpr std::uint16_t idle1() const noexcept { return detail::load<std::uint16_t>(data_ + 18); }
+
+  /// How long collecting these stats took
+  constexpr std::uint16_t collectUs() const noexcept { return detail::load<std::uint16_t>(data_ + 20); }
+
+  /// Tasks in the system, entries are only sent for the first ones that fit
+  constexpr std::uint8_t taskCount() const noexcept { return detail::load<std::uint8_t>(data_ + 22); }
+
+  /// One entry of tasks
+  class Task
+  {
+  public:
+    static constexpr std::size_t kSize = 14;
+
+    constexpr explicit Task(const std::uint8_t *data) noexcept : data_(data) {}
+
+    /// First 8 characters of the task name, zero padded, first character in the low byte
+    constexpr std::uint64_t name() const noexcept { return detail::load<std::uint64_t>(data_ + 0); }
+
+    /// Core the task is pinned to, 0xFF if it runs on either
+    constexpr std::uint8_t core() const noexcept { return detail::load<std::uint8_t>(data_ + 8); }
+
+    /// Current priority
+    constexpr std::uint8_t priority() const noexcept { return detail::load<std::uint8_t>(data_ + 9); }
+
+    /// Least stack the task ever had left, bytes
+    constexpr std::uint16_t stackFree() const noexcept { return detail::load<std::uint16_t>(data_ + 10); }
+
+    /// Time the task ran over the window, in 0.01% of one core
+    constexpr std::uint16_t load() const noexcept { return detail::load<std::uint16_t>(data_ + 12); }
+
+  private:
+    const std::uint8_t *data_;
+  };
+
+  /// Number of tasks entries in the payload
+  constexpr std::size_t tasksCount() const noexcept { return (size_ - kMinSize) / Task::kSize; }
+  /// Entry i of tasks, i < tasksCount()
+  constexpr Task tasks(std::size_t i) const noexcept { return Task(data_ + kMinSize + i * Task::kSize); }
+
+private:
+  const std::uint8_t *data_;
+  std::size_t size_;
+};
+
+/// TRACE (device -> host): Events recorded on one core (drivers/trc), in the order they happened, while CFG_TRACE_EVENTS isn't 0
+class Trace
+{
+public:
+  static constexpr Id kId = Id::Trace;
+  static constexpr std::size_t kMinSize = 5;
+
+  constexpr Trace(const std::uint8_t *data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+  constexpr bool valid() const noexcept { return size_ >= kMinSize; }
+
+  /// Core the events happened on
+  constexpr std::uint8_t core() const noexcept { return detail::load<std::uint8_t>(data_ + 0); }
+
+  /// Events of this core that found its ring buffer full, since boot
+  constexpr std::uint32_t lost() const noexcept { return detail::load<std::uint32_t>(data_ + 1); }
+
+  /// One entry of records
+  class Record
+  {
+  public:
+    static constexpr std::size_t kSize = 8;
+
+    constexpr explicit Record(const std::uint8_t *data) noexcept : data_(data) {}
+
+    /// Device time
+    constexpr std::uint32_t timeUs() const noexcept { return detail::load<std::uint32_t>(data_ + 0); }
+
+    /// What happened, trc_Event_e
+    constexpr std::uint8_t type() const noexcept { return detail::load<std::uint8_t>(data_ + 4); }
+
+    /// Slot, interrupt source, task index (see TRACE_TASKS) or marker
+    constexpr std::uint8_t id() const noexcept { return detail::load<std::uint8_t>(data_ + 5); }
+
+    /// Depends on the marker, 0 otherwise
+    constexpr std::uint16_t arg() const noexcept { return detail::load<std::uint16_t>(data_ + 6); }
+
+  private:
+    const std::uint8_t *data_;
+  };
+
+  /// Number of records entries in the payload
+  constexpr std::size_t recordsCount() const noexcept { return (size_ - kMinSize) / Record::kSize; }
+  /// Entry i of records, i < recordsCount()
+  constexpr Record records(std::size_t i) const noexcept { return Record(data_ + kMinSize + i * Record::kSize); }
+
+private:
+  const std::uint8_t *data_;
+  std::size_t size_;
+};
+
+/// TRACE_TASKS (device -> host): Names of the task indexes in the task switch events of one core, every second while tracing
+class TraceTasks
+{
+public:
+  static constexpr Id kId = Id::TraceTasks;
+  static constexpr std::size_t kMinSize = 1;
+
+  constexpr TraceTasks(const std::uint8_t *data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+  constexpr bool valid() const noexcept { return size_ >= kMinSize; }
+
+  /// Core the indexes belong to
+  constexpr std::uint8_t core() const noexcept { return detail::load<std::uint8_t>(data_ + 0); }
+
+  /// One entry of tasks
+  class Task
+  {
+  public:
+    static constexpr std::size_t kSize = 9;
+
+    constexpr explicit Task(const std::uint8_t *data) noexcept : data_(data) {}
+
+    /// Task index of the task switch events
+    constexpr std::uint8_t index() const noexcept { return detail::load<std::uint8_t>(data_ + 0); }
+
+    /// First 8 characters of the task name, zero padded, first character in the low byte
+    constexpr std::uint64_t name() const noexcept { return detail::load<std::uint64_t>(data_ + 1); }
+
+  private:
+    const std::uint8_t *data_;
+  };
+
+  /// Number of tasks entries in the payload
+  constexpr std::size_t tasksCount() const noexcept { return (size_ - kMinSize) / Task::kSize; }
+  /// Entry i of tasks, i < tasksCount()
+  constexpr Task tasks(std::size_t i) const noexcept { return Task(data_ + kMinSize + i * Task::kSize); }
+
+private:
+  const std::uint8_t *data_;
+  std::size_t size_;
+};
+
+/// ERR_STATS (device -> host): Runtime driver errors (drivers/err), sent every second
+class ErrStats
+{
+public:
+  static constexpr Id kId = Id::ErrStats;
+  static constexpr std::size_t kMinSize = 4;
+
+  constexpr ErrStats(const std::uint8_t *data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+  constexpr bool valid() const noexcept { return size_ >= kMinSize; }
+
+  /// Device time
+  constexpr std::uint32_t timeUs() const noexcept { return detail::load<std::uint32_t>(data_ + 0); }
+
+  /// One entry of sources
+  class Source
+  {
+  public:
+    static constexpr std::size_t kSize = 17;
+
+    constexpr explicit Source(const std::uint8_t *data) noexcept : data_(data) {}
+
+    /// Driver calls of this err_Source_e that returned an error, retries included
+    constexpr std::uint32_t errors() const noexcept { return detail::load<std::uint32_t>(data_ + 0); }
+
+    /// Driver calls repeated after an error
+    constexpr std::uint32_t retries() const noexcept { return detail::load<std::uint32_t>(data_ + 4); }
+
+    /// Driver calls that still failed after their retries
+    constexpr std::uint32_t failures() const noexcept { return detail::load<std::uint32_t>(data_ + 8); }
+
+    /// Last esp_err_t returned, 0 if none
+    constexpr std::int32_t lastError() const noexcept { return detail::load<std::int32_t>(data_ + 12); }
+
+    /// 1 while the source is degraded, a degraded POT or SNS sends the servos to the open posture
+    constexpr std::uint8_t degraded() const noexcept { return detail::load<std::uint8_t>(data_ + 16); }
+
+  private:
+    const std::uint8_t *data_;
+  };
+
+  /// Number of sources entries in the payload
+  constexpr std::size_t sourcesCount() const noexcept { return (size_ - kMinSize) / Source::kSize; }
+  /// Entry i of sources, i < sourcesCount()
+  constexpr Source sources(std::size_t i) const noexcept { return Source(data_ + kMinSize + i * Source::kSize); }
+
+private:
+  const std::uint8_t *data_;
+  std::size_t size_;
+};
+
+} // namespace msg
+} // namespace openhand
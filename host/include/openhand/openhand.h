@@ -0,0 +1,84 @@
+/**
+ * @file openhand.h
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief C interface of the host client, for bindings (python/openhand.py loads it with ctypes)
+ *
+ * Every function that can fail returns NULL or a negative value and leaves the reason in oh_last_error().
+ * Callbacks run on the dispatcher thread, or on the thread calling oh_dispatch() if the client was started
+ * without one, and the payload pointer is only valid during the callback.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef OPENHAND_H
+#define OPENHAND_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct oh_client oh_client;
+
+typedef void (*oh_callback)(void *user, uint8_t id, uint8_t seq, const uint8_t *payload, size_t size, int64_t rx_ns);
+
+/** See openhand::ClientStats */
+typedef struct
+{
+  uint64_t rx_bytes;
+  uint64_t rx_frames;
+  uint64_t crc_errors;
+  uint64_t lost_frames;
+  uint64_t queue_drops;
+  uint64_t invalid_payloads;
+  uint64_t dispatched;
+  uint64_t tx_frames;
+  int64_t max_latency_ns;
+  int64_t mean_latency_ns;
+  uint64_t late_frames;
+  int32_t running;
+} oh_stats;
+
+oh_client *oh_open_serial(const char *path, unsigned baud);
+oh_client *oh_open_tcp(const char *host, uint16_t port);
+oh_client *oh_open_replay(const char *path, double speed);
+
+/** Why the last call on this thread failed, or why the I/O thread of the client stopped */
+const char *oh_last_error(void);
+
+/** Stop the client and free it */
+void oh_close(oh_client *client);
+
+/** Register a callback for one frame ID, or for every frame with id -1 */
+int oh_on(oh_client *client, int id, oh_callback callback, void *user);
+
+int oh_start(oh_client *client, int dispatch_thread);
+void oh_stop(oh_client *client);
+
+/** @return number of frames dispatched */
+size_t oh_dispatch(oh_client *client, uint32_t timeout_ms);
+
+int oh_send(oh_client *client, uint8_t id, const uint8_t *payload, size_t size);
+int oh_ping(oh_client *client);
+
+/** Start recording into path, or stop with NULL or "" */
+int oh_record(oh_client *client, const char *path);
+
+void oh_stats_get(oh_client *client, oh_stats *stats);
+
+/** Name of a frame ID, "?" if unknown */
+const char *oh_id_name(uint8_t id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OPENHAND_H */
@@ -0,0 +1,76 @@
+/**
+ * @file spsc_queue.hpp
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Lock-free queue between exactly one producer thread and one consumer thread
+ *
+ * Carries the frames from the I/O thread to whoever dispatches them. Neither side ever blocks or takes a lock,
+ * so a slow callback can't stall the reading of the port: when the queue is full the frame is dropped and counted
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace openhand {
+
+/// Ring of Capacity - 1 usable slots, Capacity a power of two
+template <typename T, std::size_t Capacity>
+class SpscQueue
+{
+  static_assert((Capacity >= 2) && ((Capacity & (Capacity - 1)) == 0), "Capacity has to be a power of two");
+
+public:
+  /// Producer only
+  /// @return false if the queue is full, the item is not taken then
+  bool push(const T &item) noexcept
+  {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    const std::size_t next = (head + 1) & (Capacity - 1);
+    if (next == tail_.load(std::memory_order_acquire))
+    {
+      return false;
+    }
+    items_[head] = item;
+    head_.store(next, std::memory_order_release);
+    return true;
+  }
+
+  /// Consumer only: the oldest item, nullptr if there is none. It stays valid until pop()
+  const T *front() const noexcept
+  {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail == head_.load(std::memory_order_acquire))
+    {
+      return nullptr;
+    }
+    return &items_[tail];
+  }
+
+  /// Consumer only: drop the item front() returned
+  void pop() noexcept
+  {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    tail_.store((tail + 1) & (Capacity - 1), std::memory_order_release);
+  }
+
+  /// Either side, only a snapshot
+  bool empty() const noexcept { return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire); }
+
+private:
+  /// Head and tail on their own cache lines, so the two threads don't keep taking the line from each other
+  alignas(64) std::atomic<std::size_t> head_{0};
+  alignas(64) std::atomic<std::size_t> tail_{0};
+  alignas(64) std::array<T, Capacity> items_{};
+};
+
+} // namespace openhand
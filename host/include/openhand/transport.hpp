@@ -0,0 +1,65 @@
+/**
+ * @file transport.hpp
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Byte streams the client reads frames from: a serial port, a TCP socket, or a recording
+ *
+ * A transport only moves bytes, like on the boards (drivers/lnk). The serial port is the USB-UART adapter on the
+ * telemetry UART of either board, TCP is for firmware/ProstheticHand/linux/lnk_host.c, and a recording made with
+ * Client::record() is played back with the same timing as it was received.
+ *
+ * Recording format: 8 byte magic "OHREC1\n\0", then one chunk per read: u64 nanoseconds since the recording started,
+ * u32 length, the bytes as they were read. All LSB first. The raw bytes are kept, so a replay goes through the
+ * same parser as the live data, broken frames included
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace openhand {
+
+/// Magic at the start of a recording
+constexpr char kRecordMagic[8] = {'O', 'H', 'R', 'E', 'C', '1', '\n', '\0'};
+
+class Transport
+{
+public:
+  virtual ~Transport() = default;
+
+  /// Wait up to timeout for bytes and read what is there
+  /// @return number of bytes read, 0 if none came in time, -1 if the transport is gone (unplugged, closed, end of recording)
+  virtual long read(std::uint8_t *buf, std::size_t size, std::chrono::milliseconds timeout) = 0;
+
+  /// Write all bytes
+  /// @return false if they could not be written
+  virtual bool write(const std::uint8_t *data, std::size_t size) = 0;
+};
+
+/// Open a serial port, raw 8N1 without flow control. On Linux the driver is also asked for low latency,
+/// so an FTDI adapter hands over the bytes right away instead of every 16 ms
+/// @param baud the boards use 1000000
+/// @throws std::system_error if the port can't be opened or set up
+std::unique_ptr<Transport> openSerial(const std::string &path, unsigned baud = 1000000);
+
+/// Connect to a TCP server, e.g. lnk_host on localhost
+/// @throws std::system_error if the connection fails
+std::unique_ptr<Transport> openTcp(const std::string &host, std::uint16_t port);
+
+/// Play a recording back
+/// @param speed 1 for the recorded timing, 2 for twice as fast..., 0 as fast as the client takes it
+/// @throws std::system_error if the file can't be opened, std::runtime_error if it is no recording
+std::unique_ptr<Transport> openReplay(const std::string &path, double speed = 1.0);
+
+} // namespace openhand
@@ -0,0 +1,252 @@
+"""Python bindings of the host client (host/include/openhand/openhand.h), over ctypes.
+
+The C++ client does the work: a background thread reads the transport and parses the frames, so Python only
+runs the callbacks. Either let the client call them from its own dispatcher thread (start()), or call them
+from the script's own loop (start(dispatch_thread=False) and dispatch()), which keeps everything on one thread:
+
+    import openhand
+
+    with openhand.Client.tcp("localhost", 5760) as hand:
+        hand.on(openhand.LINK_STATS, lambda frame: print(frame.name, frame.payload.hex()))
+        hand.start(dispatch_thread=False)
+        hand.ping()
+        while True:
+            hand.dispatch(100)
+
+The shared library is looked up in $OPENHAND_LIB, then in host/_gate_build and host/build, then on the
+library path. Payloads are plain bytes, unpack them with struct as laid out in firmware/msg/messages.py.
+"""
+
+import ctypes
+import ctypes.util
+import os
+import struct
+from dataclasses import dataclass
+
+# Frame IDs the scripts use most, the rest are in msg.hpp
+PING = 0x01
+TSY_REQ = 0x14
+SUB = 0x15
+STP_CTRL = 0x16
+STP = 0x17
+CFG_SET = 0x18
+PONG = 0x81
+LINK_STATS = 0x82
+RTM = 0x83
+SIGNALS = 0x85
+TSY_RESP = 0x94
+SUB_STATE = 0x96
+STP_STATS = 0x97
+CFG = 0x98
+OS_STATS = 0x99
+TRACE = 0x9A
+TRACE_TASKS = 0x9B
+
+ANY = -1
+
+
+class _Stats(ctypes.Structure):
+    _fields_ = [
+        ("rx_bytes", ctypes.c_uint64),
+        ("rx_frames", ctypes.c_uint64),
+        ("crc_errors", ctypes.c_uint64),
+        ("lost_frames", ctypes.c_uint64),
+        ("queue_drops", ctypes.c_uint64),
+        ("invalid_payloads", ctypes.c_uint64),
+        ("dispatched", ctypes.c_uint64),
+        ("tx_frames", ctypes.c_uint64),
+        ("max_latency_ns", ctypes.c_int64),
+        ("mean_latency_ns", ctypes.c_int64),
+        ("late_frames", ctypes.c_uint64),
+        ("running", ctypes.c_int32),
+    ]
+
+
+_CALLBACK = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.c_uint8, ctypes.c_uint8,
+                             ctypes.POINTER(ctypes.c_uint8), ctypes.c_size_t, ctypes.c_int64)
+
+
+def _load():
+    here = os.path.dirname(os.path.abspath(__file__))
+    candidates = []
+    if os.environ.get("OPENHAND_LIB"):
+        candidates.append(os.environ["OPENHAND_LIB"])
+    for build in ("_gate_build", "build"):
+        for name in ("libopenhand_c.so", "libopenhand_c.dylib"):
+            candidates.append(os.path.join(here, "..", build, name))
+    found = ctypes.util.find_library("openhand_c")
+    if found:
+        candidates.append(found)
+
+    for path in candidates:
+        if os.path.exists(path) or path == found:
+            lib = ctypes.CDLL(path)
+            break
+    else:
+        raise OSError("libopenhand_c not found, build host/ with cmake or set OPENHAND_LIB")
+
+    lib.oh_open_serial.restype = ctypes.c_void_p
+    lib.oh_open_serial.argtypes = [ctypes.c_char_p, ctypes.c_uint]
+    lib.oh_open_tcp.restype = ctypes.c_void_p
+    lib.oh_open_tcp.argtypes = [ctypes.c_char_p, ctypes.c_uint16]
+    lib.oh_open_replay.restype = ctypes.c_void_p
+    lib.oh_open_replay.argtypes = [ctypes.c_char_p, ctypes.c_double]
+    lib.oh_last_error.restype = ctypes.c_char_p
+    lib.oh_last_error.argtypes = []
+    lib.oh_close.restype = None
+    lib.oh_close.argtypes = [ctypes.c_void_p]
+    lib.oh_on.restype = ctypes.c_int
+    lib.oh_on.argtypes = [ctypes.c_void_p, ctypes.c_int, _CALLBACK, ctypes.c_void_p]
+    lib.oh_start.restype = ctypes.c_int
+    lib.oh_start.argtypes = [ctypes.c_void_p, ctypes.c_int]
+    lib.oh_stop.restype = None
+    lib.oh_stop.argtypes = [ctypes.c_void_p]
+    lib.oh_dispatch.restype = ctypes.c_size_t
+    lib.oh_dispatch.argtypes = [ctypes.c_void_p, ctypes.c_uint32]
+    lib.oh_send.restype = ctypes.c_int
+    lib.oh_send.argtypes = [ctypes.c_void_p, ctypes.c_uint8, ctypes.c_char_p, ctypes.c_size_t]
+    lib.oh_ping.restype = ctypes.c_int
+    lib.oh_ping.argtypes = [ctypes.c_void_p]
+    lib.oh_record.restype = ctypes.c_int
+    lib.oh_record.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
+    lib.oh_stats_get.restype = None
+    lib.oh_stats_get.argtypes = [ctypes.c_void_p, ctypes.POINTER(_Stats)]
+    lib.oh_id_name.restype = ctypes.c_char_p
+    lib.oh_id_name.argtypes = [ctypes.c_uint8]
+    return lib
+
+
+_lib = _load()
+
+
+def _error():
+    return _lib.oh_last_error().decode(errors="replace")
+
+
+def id_name(frame_id):
+    return _lib.oh_id_name(frame_id).decode()
+
+
+@dataclass
+class Frame:
+    id: int
+    seq: int
+    payload: bytes
+    rx_ns: int  # steady clock of the read that completed the frame, time.monotonic_ns() on Linux
+
+    @property
+    def name(self):
+        return id_name(self.id)
+
+
+class Client:
+    def __init__(self, handle):
+        self._handle = handle
+        if not handle:
+            raise OSError(_error())
+        self._callbacks = []  # ctypes callbacks must outlive the client
+
+    @classmethod
+    def serial(cls, path, baud=1000000):
+        return cls(_lib.oh_open_serial(path.encode(), baud))
+
+    @classmethod
+    def tcp(cls, host, port=5760):
+        return cls(_lib.oh_open_tcp(host.encode(), port))
+
+    @classmethod
+    def replay(cls, path, speed=1.0):
+        return cls(_lib.oh_open_replay(path.encode(), speed))
+
+    def on(self, frame_id, callback):
+        """Call callback(Frame) for every frame with this ID, or every frame with ANY"""
+        def trampoline(_user, frame_id, seq, payload, size, rx_ns):
+            callback(Frame(frame_id, seq, ctypes.string_at(payload, size), rx_ns))
+
+        c_callback = _CALLBACK(trampoline)
+        if _lib.oh_on(self._handle, frame_id, c_callback, None) != 0:
+            raise ValueError(_error())
+        self._callbacks.append(c_callback)
+
+    def start(self, dispatch_thread=True):
+        _lib.oh_start(self._handle, 1 if dispatch_thread else 0)
+
+    def stop(self):
+        _lib.oh_stop(self._handle)
+
+    def dispatch(self, timeout_ms=0):
+        """Run the callbacks of the queued frames on this thread, waiting up to timeout_ms for the first one"""
+        return _lib.oh_dispatch(self._handle, timeout_ms)
+
+    def send(self, frame_id, payload=b""):
+        if _lib.oh_send(self._handle, frame_id, bytes(payload), len(payload)) != 0:
+            raise OSError(_error())
+
+    def ping(self):
+        """PING with the host time in microseconds, the PONG has it back followed by the device time"""
+        if _lib.oh_ping(self._handle) != 0:
+            raise OSError(_error())
+
+    def set_config(self, *values):
+        """CFG_SET, one value per cfg_Param_e, None leaves a parameter as it is and no values only asks"""
+        self.send(CFG_SET, b"".join(struct.pack("<H", 0xFFFF if v is None else v) for v in values))
+
+    def record(self, path):
+        """Record everything read into path, None stops recording"""
+        if _lib.oh_record(self._handle, path.encode() if path else None) != 0:
+            raise OSError(_error())
+
+    def stats(self):
+        stats = _Stats()
+        _lib.oh_stats_get(self._handle, ctypes.byref(stats))
+        result = {name: getattr(stats, name) for name, _ in _Stats._fields_}
+        result["running"] = bool(result["running"])
+        if not result["running"]:
+            result["error"] = _error()
+        return result
+
+    def close(self):
+        if self._handle:
+            _lib.oh_close(self._handle)
+            self._handle = None
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+    def __del__(self):
+        self.close()
+
+
+def _main():
+    import argparse
+
+    parser = argparse.ArgumentParser(description="Print the frames of a board")
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--serial")
+    source.add_argument("--tcp", help="host:port")
+    source.add_argument("--replay")
+    parser.add_argument("--speed", type=float, default=1.0)
+    args = parser.parse_args()
+
+    if args.serial:
+        hand = Client.serial(args.serial)
+    elif args.tcp:
+        host, port = args.tcp.rsplit(":", 1)
+        hand = Client.tcp(host, int(port))
+    else:
+        hand = Client.replay(args.replay, args.speed)
+
+    with hand:
+        hand.on(ANY, lambda f: print(f"{f.rx_ns / 1e9:12.6f} {f.name:<10} seq {f.seq:3} {f.payload.hex(' ')}"))
+        hand.start(dispatch_thread=False)
+        hand.ping()
+        while hand.stats()["running"] or hand.dispatch(0):
+            hand.dispatch(100)
+        print(hand.stats())
+
+
+if __name__ == "__main__":
+    _main()
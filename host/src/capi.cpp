@@ -0,0 +1,169 @@
+/**
+ * @file capi.cpp
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief C interface of the host client
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "openhand/openhand.h"
+
+#include <exception>
+#include <string>
+
+#include "openhand/client.hpp"
+
+struct oh_client
+{
+  openhand::Client client;
+};
+
+namespace {
+
+thread_local std::string lastError;
+
+template <typename F>
+oh_client *open(F &&factory)
+{
+  try
+  {
+    return new oh_client{openhand::Client(factory())};
+  }
+  catch (const std::exception &e)
+  {
+    lastError = e.what();
+    return nullptr;
+  }
+}
+
+} // namespace
+
+extern "C" {
+
+oh_client *oh_open_serial(const char *path, unsigned baud)
+{
+  return open([&] { return openhand::openSerial(path, baud); });
+}
+
+oh_client *oh_open_tcp(const char *host, uint16_t port)
+{
+  return open([&] { return openhand::openTcp(host, port); });
+}
+
+oh_client *oh_open_replay(const char *path, double speed)
+{
+  return open([&] { return openhand::openReplay(path, speed); });
+}
+
+const char *oh_last_error(void)
+{
+  return lastError.c_str();
+}
+
+void oh_close(oh_client *client)
+{
+  delete client;
+}
+
+int oh_on(oh_client *client, int id, oh_callback callback, void *user)
+{
+  if (id < -1 || id > 0xFF || callback == nullptr)
+  {
+    lastError = "invalid frame ID or callback";
+    return -1;
+  }
+
+  auto handler = [callback, user](const openhand::Frame &frame) {
+    callback(user, frame.id, frame.seq, frame.data(), frame.size, frame.rxNs);
+  };
+  if (id < 0)
+  {
+    client->client.onAny(handler);
+  }
+  else
+  {
+    client->client.onFrame(static_cast<openhand::msg::Id>(id), handler);
+  }
+  return 0;
+}
+
+int oh_start(oh_client *client, int dispatch_thread)
+{
+  client->client.start(dispatch_thread != 0);
+  return 0;
+}
+
+void oh_stop(oh_client *client)
+{
+  client->client.stop();
+}
+
+size_t oh_dispatch(oh_client *client, uint32_t timeout_ms)
+{
+  return client->client.dispatch(std::chrono::milliseconds(timeout_ms));
+}
+
+int oh_send(oh_client *client, uint8_t id, const uint8_t *payload, size_t size)
+{
+  if (!client->client.send(static_cast<openhand::msg::Id>(id), payload, size))
+  {
+    lastError = "payload too long or transport failed";
+    return -1;
+  }
+  return 0;
+}
+
+int oh_ping(oh_client *client)
+{
+  if (!client->client.ping())
+  {
+    lastError = "transport failed";
+    return -1;
+  }
+  return 0;
+}
+
+int oh_record(oh_client *client, const char *path)
+{
+  if (!client->client.record((path != nullptr) ? path : ""))
+  {
+    lastError = std::string("can't create ") + path;
+    return -1;
+  }
+  return 0;
+}
+
+void oh_stats_get(oh_client *client, oh_stats *stats)
+{
+  const openhand::ClientStats s = client->client.stats();
+  stats->rx_bytes = s.rxBytes;
+  stats->rx_frames = s.rxFrames;
+  stats->crc_errors = s.crcErrors;
+  stats->lost_frames = s.lostFrames;
+  stats->queue_drops = s.queueDrops;
+  stats->invalid_payloads = s.invalidPayloads;
+  stats->dispatched = s.dispatched;
+  stats->tx_frames = s.txFrames;
+  stats->max_latency_ns = s.maxLatencyNs;
+  stats->mean_latency_ns = s.meanLatencyNs;
+  stats->late_frames = s.lateFrames;
+  stats->running = s.running ? 1 : 0;
+  if (!s.error.empty())
+  {
+    lastError = s.error;
+  }
+}
+
+const char *oh_id_name(uint8_t id)
+{
+  const char *name = openhand::msg::name(id);
+  return (name != nullptr) ? name : "?";
+}
+
+} // extern "C"
@@ -0,0 +1,315 @@
+/**
+ * @file client.cpp
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Asynchronous client for the telemetry link of either board
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "openhand/client.hpp"
+
+#include <stdexcept>
+
+namespace openhand {
+
+namespace {
+
+void putU32(std::uint8_t *buf, std::uint32_t value)
+{
+  for (int i = 0; i < 4; ++i)
+  {
+    buf[i] = static_cast<std::uint8_t>(value >> (8 * i));
+  }
+}
+
+void putU64(std::uint8_t *buf, std::uint64_t value)
+{
+  for (int i = 0; i < 8; ++i)
+  {
+    buf[i] = static_cast<std::uint8_t>(value >> (8 * i));
+  }
+}
+
+} // namespace
+
+Client::Client(std::unique_ptr<Transport> transport) : transport_(std::move(transport))
+{
+  if (!transport_)
+  {
+    throw std::invalid_argument("Client needs a transport");
+  }
+}
+
+Client::~Client()
+{
+  stop();
+  record("");
+}
+
+void Client::onFrame(msg::Id id, Handler handler)
+{
+  std::lock_guard<std::mutex> lock(handlersMutex_);
+  handlers_[static_cast<std::uint8_t>(id)].push_back(std::move(handler));
+}
+
+void Client::onAny(Handler handler)
+{
+  std::lock_guard<std::mutex> lock(handlersMutex_);
+  anyHandlers_.push_back(std::move(handler));
+}
+
+void Client::start(bool dispatchThread)
+{
+  if (running_.exchange(true))
+  {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(errorMutex_);
+    error_.clear();
+  }
+
+  ioRunning_ = true;
+  ioThread_ = std::thread(&Client::ioLoop, this);
+  if (dispatchThread)
+  {
+    dispatchThread_ = std::thread(&Client::dispatchLoop, this);
+  }
+}
+
+void Client::stop()
+{
+  if (!running_.exchange(false))
+  {
+    return;
+  }
+
+  wake();
+  if (ioThread_.joinable())
+  {
+    ioThread_.join();
+  }
+  if (dispatchThread_.joinable())
+  {
+    dispatchThread_.join();
+  }
+
+  while (queue_.front() != nullptr)
+  {
+    queue_.pop();
+  }
+}
+
+std::size_t Client::dispatch(std::chrono::milliseconds timeout)
+{
+  if (queue_.empty() && timeout.count() > 0)
+  {
+    std::unique_lock<std::mutex> lock(wakeMutex_);
+    waiting_.store(true);
+    /* Pairs with the fence in ioLoop(): either the I/O thread sees waiting_ or we see its frame */
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (queue_.empty() && ioRunning_)
+    {
+      wakeCv_.wait_for(lock, timeout);
+    }
+    waiting_.store(false);
+  }
+
+  std::size_t count = 0;
+  while (const Frame *frame = queue_.front())
+  {
+    deliver(*frame);
+    queue_.pop();
+    ++count;
+  }
+  return count;
+}
+
+bool Client::send(msg::Id id, const std::uint8_t *payload, std::size_t size)
+{
+  std::uint8_t frame[kMaxFrame];
+
+  std::lock_guard<std::mutex> lock(txMutex_);
+  const std::size_t length = encodeFrame(static_cast<std::uint8_t>(id), txSeq_, payload, size, frame);
+  if (length == 0 || !transport_->write(frame, length))
+  {
+    return false;
+  }
+  ++txSeq_;
+  txFrames_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+bool Client::ping()
+{
+  std::uint8_t payload[4];
+  putU32(payload, static_cast<std::uint32_t>(nowNs() / 1000));
+  return send(msg::Id::Ping, payload, sizeof(payload));
+}
+
+bool Client::record(const std::string &path)
+{
+  std::FILE *file = nullptr;
+  if (!path.empty())
+  {
+    file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr)
+    {
+      return false;
+    }
+    /* A large buffer, so the I/O thread only hits the disk every few hundred milliseconds at full rate */
+    std::setvbuf(file, nullptr, _IOFBF, 1 << 16);
+    std::fwrite(kRecordMagic, 1, sizeof(kRecordMagic), file);
+  }
+
+  std::lock_guard<std::mutex> lock(recordMutex_);
+  if (record_ != nullptr)
+  {
+    std::fclose(record_);
+  }
+  record_ = file;
+  recordStartNs_ = nowNs();
+  return true;
+}
+
+ClientStats Client::stats() const
+{
+  ClientStats stats;
+  stats.rxBytes = rxBytes_.load();
+  stats.rxFrames = rxFrames_.load();
+  stats.crcErrors = crcErrors_.load();
+  stats.lostFrames = lostFrames_.load();
+  stats.queueDrops = queueDrops_.load();
+  stats.invalidPayloads = invalidPayloads_.load();
+  stats.dispatched = dispatched_.load();
+  stats.txFrames = txFrames_.load();
+  stats.maxLatencyNs = maxLatencyNs_.load();
+  stats.meanLatencyNs = (stats.dispatched > 0) ? static_cast<std::int64_t>(sumLatencyNs_.load() / static_cast<std::int64_t>(stats.dispatched)) : 0;
+  stats.lateFrames = lateFrames_.load();
+  stats.running = ioRunning_.load();
+
+  std::lock_guard<std::mutex> lock(errorMutex_);
+  stats.error = error_;
+  return stats;
+}
+
+std::int64_t Client::nowNs() noexcept
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Client::ioLoop()
+{
+  std::uint8_t buf[4096];
+
+  while (running_)
+  {
+    const long count = transport_->read(buf, sizeof(buf), kPollPeriod);
+    if (count < 0)
+    {
+      std::lock_guard<std::mutex> lock(errorMutex_);
+      error_ = "transport closed";
+      break;
+    }
+    if (count == 0)
+    {
+      continue;
+    }
+
+    const std::int64_t rxNs = nowNs();
+    rxBytes_.fetch_add(static_cast<std::uint64_t>(count), std::memory_order_relaxed);
+
+    {
+      std::lock_guard<std::mutex> lock(recordMutex_);
+      if (record_ != nullptr)
+      {
+        std::uint8_t header[12];
+        putU64(header, static_cast<std::uint64_t>(rxNs - recordStartNs_));
+        putU32(header + 8, static_cast<std::uint32_t>(count));
+        std::fwrite(header, 1, sizeof(header), record_);
+        std::fwrite(buf, 1, static_cast<std::size_t>(count), record_);
+      }
+    }
+
+    bool queued = false;
+    parser_.feed(buf, static_cast<std::size_t>(count), rxNs, [&](const Frame &frame) {
+      rxFrames_.fetch_add(1, std::memory_order_relaxed);
+      if (haveSeq_ && frame.seq != static_cast<std::uint8_t>(lastSeq_ + 1))
+      {
+        lostFrames_.fetch_add(static_cast<std::uint8_t>(frame.seq - lastSeq_ - 1), std::memory_order_relaxed);
+      }
+      haveSeq_ = true;
+      lastSeq_ = frame.seq;
+
+      if (queue_.push(frame))
+      {
+        queued = true;
+      }
+      else
+      {
+        queueDrops_.fetch_add(1, std::memory_order_relaxed);
+      }
+    });
+    crcErrors_.store(parser_.crcErrors(), std::memory_order_relaxed);
+
+    if (queued)
+    {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (waiting_.load())
+      {
+        wake();
+      }
+    }
+  }
+
+  ioRunning_ = false;
+  wake();
+}
+
+void Client::dispatchLoop()
+{
+  while (running_ && (ioRunning_ || !queue_.empty()))
+  {
+    dispatch(kPollPeriod);
+  }
+}
+
+void Client::deliver(const Frame &frame)
+{
+  const std::int64_t latencyNs = nowNs() - frame.rxNs;
+  sumLatencyNs_.fetch_add(latencyNs, std::memory_order_relaxed);
+  if (latencyNs > maxLatencyNs_.load(std::memory_order_relaxed))
+  {
+    maxLatencyNs_.store(latencyNs, std::memory_order_relaxed);
+  }
+  if (latencyNs > 1000000)
+  {
+    lateFrames_.fetch_add(1, std::memory_order_relaxed);
+  }
+  dispatched_.fetch_add(1, std::memory_order_relaxed);
+
+  std::lock_guard<std::mutex> lock(handlersMutex_);
+  for (const Handler &handler : handlers_[frame.id])
+  {
+    handler(frame);
+  }
+  for (const Handler &handler : anyHandlers_)
+  {
+    handler(frame);
+  }
+}
+
+void Client::wake()
+{
+  std::lock_guard<std::mutex> lock(wakeMutex_);
+  wakeCv_.notify_all();
+}
+
+} // namespace openhand
@@ -0,0 +1,131 @@
+/**
+ * @file frame.cpp
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Building and parsing of the telemetry frames
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "openhand/frame.hpp"
+
+#include <cstring>
+
+namespace openhand {
+
+std::size_t encodeFrame(std::uint8_t id, std::uint8_t seq, const std::uint8_t *payload, std::size_t size, std::uint8_t *out) noexcept
+{
+  if (size > kMaxPayload)
+  {
+    return 0;
+  }
+
+  out[0] = kSync1;
+  out[1] = kSync2;
+  out[2] = id;
+  out[3] = seq;
+  out[4] = static_cast<std::uint8_t>(size);
+  if (size > 0)
+  {
+    std::memcpy(out + kHeaderSize, payload, size);
+  }
+
+  const std::uint16_t crc = crc16(0xFFFF, out + 2, kHeaderSize - 2 + size);
+  out[kHeaderSize + size] = static_cast<std::uint8_t>(crc);
+  out[kHeaderSize + size + 1] = static_cast<std::uint8_t>(crc >> 8);
+
+  return kHeaderSize + size + kCrcSize;
+}
+
+bool FrameParser::step(std::uint8_t byte, bool rescanned) noexcept
+{
+  if (state_ != State::Sync1)
+  {
+    raw_[rawSize_++] = byte;
+  }
+
+  switch (state_)
+  {
+  case State::Sync1:
+    if (byte == kSync1)
+    {
+      raw_[0] = byte;
+      rawSize_ = 1;
+      rawRescanned_ = rescanned;
+      state_ = State::Sync2;
+    }
+    break;
+  case State::Sync2:
+    /* A5 A5 5A is still a frame start */
+    if (byte == kSync1)
+    {
+      rawSize_ = 1;
+    }
+    state_ = (byte == kSync2) ? State::Id : ((byte == kSync1) ? State::Sync2 : State::Sync1);
+    break;
+  case State::Id:
+    frame_.id = byte;
+    state_ = State::Seq;
+    break;
+  case State::Seq:
+    frame_.seq = byte;
+    state_ = State::Len;
+    break;
+  case State::Len:
+    frame_.size = byte;
+    index_ = 0;
+    state_ = (byte > 0) ? State::Payload : State::Crc1;
+    break;
+  case State::Payload:
+    frame_.payload[index_++] = byte;
+    if (index_ >= frame_.size)
+    {
+      state_ = State::Crc1;
+    }
+    break;
+  case State::Crc1:
+    crc_ = byte;
+    state_ = State::Crc2;
+    break;
+  case State::Crc2:
+  {
+    crc_ = static_cast<std::uint16_t>(crc_ | (static_cast<std::uint16_t>(byte) << 8));
+    state_ = State::Sync1;
+
+    const std::uint8_t header[3] = {frame_.id, frame_.seq, frame_.size};
+    if (crc16(crc16(0xFFFF, header, 3), frame_.payload.data(), frame_.size) == crc_)
+    {
+      return true;
+    }
+    if (!rawRescanned_)
+    {
+      ++crcErrors_;
+    }
+    rescan();
+    break;
+  }
+  }
+
+  return false;
+}
+
+void FrameParser::rescan() noexcept
+{
+  /* The broken frame's bytes after its sync bytes, then what was still waiting to be searched again.
+   * The broken frame is made of bytes that came before the waiting ones, so both fit */
+  std::array<std::uint8_t, kMaxFrame> bytes;
+  const std::size_t own = rawSize_ - 2;
+  const std::size_t waiting = rescanSize_ - rescanPos_;
+  std::memcpy(bytes.data(), raw_.data() + 2, own);
+  std::memcpy(bytes.data() + own, rescan_.data() + rescanPos_, waiting);
+  std::memcpy(rescan_.data(), bytes.data(), own + waiting);
+  rescanPos_ = 0;
+  rescanSize_ = own + waiting;
+}
+
+} // namespace openhand
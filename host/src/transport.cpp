@@ -0,0 +1,352 @@
+/**
+ * @file transport.cpp
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Serial port, TCP and replay transports, POSIX only (Linux and macOS)
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "openhand/transport.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/serial.h>
+#elif defined(__APPLE__)
+#include <IOKit/serial/ioss.h>
+#endif
+
+namespace openhand {
+
+namespace {
+
+std::system_error lastError(const std::string &what)
+{
+  return std::system_error(errno, std::generic_category(), what);
+}
+
+/// Serial port and TCP socket are both a file descriptor that poll() works on
+class FdTransport : public Transport
+{
+public:
+  explicit FdTransport(int fd) : fd_(fd) {}
+  ~FdTransport() override { ::close(fd_); }
+
+  long read(std::uint8_t *buf, std::size_t size, std::chrono::milliseconds timeout) override
+  {
+    pollfd pfd{fd_, POLLIN, 0};
+    const int ready = ::poll(&pfd, 1, static_cast<int>(timeout.count()));
+    if (ready == 0 || (ready < 0 && errno == EINTR))
+    {
+      return 0;
+    }
+    if (ready < 0 || (pfd.revents & (POLLERR | POLLNVAL)))
+    {
+      return -1;
+    }
+
+    const ssize_t count = ::read(fd_, buf, size);
+    if (count > 0)
+    {
+      return static_cast<long>(count);
+    }
+    if (count < 0 && (errno == EAGAIN || errno == EINTR))
+    {
+      return 0;
+    }
+    /* Readable but nothing to read: the other end is gone */
+    return -1;
+  }
+
+  bool write(const std::uint8_t *data, std::size_t size) override
+  {
+    while (size > 0)
+    {
+      const ssize_t count = ::write(fd_, data, size);
+      if (count < 0)
+      {
+        if (errno == EINTR)
+        {
+          continue;
+        }
+        if (errno != EAGAIN)
+        {
+          return false;
+        }
+        pollfd pfd{fd_, POLLOUT, 0};
+        if (::poll(&pfd, 1, 100) <= 0)
+        {
+          return false;
+        }
+        continue;
+      }
+      data += count;
+      size -= static_cast<std::size_t>(count);
+    }
+    return true;
+  }
+
+private:
+  int fd_;
+};
+
+speed_t standardBaud(unsigned baud)
+{
+  switch (baud)
+  {
+  case 9600: return B9600;
+  case 19200: return B19200;
+  case 38400: return B38400;
+  case 57600: return B57600;
+  case 115200: return B115200;
+  case 230400: return B230400;
+#if defined(B460800)
+  case 460800: return B460800;
+#endif
+#if defined(B921600)
+  case 921600: return B921600;
+#endif
+#if defined(B1000000)
+  case 1000000: return B1000000;
+#endif
+#if defined(B2000000)
+  case 2000000: return B2000000;
+#endif
+  default: return 0;
+  }
+}
+
+/// One chunk of a recording, timed relative to the start of the replay
+class ReplayTransport : public Transport
+{
+public:
+  ReplayTransport(std::FILE *file, double speed) : file_(file), speed_(speed), startNs_(now()) {}
+  ~ReplayTransport() override { std::fclose(file_); }
+
+  long read(std::uint8_t *buf, std::size_t size, std::chrono::milliseconds timeout) override
+  {
+    if (pending_ == chunk_.size() && !next())
+    {
+      return -1;
+    }
+
+    if (speed_ > 0)
+    {
+      const std::int64_t dueNs = startNs_ + static_cast<std::int64_t>(static_cast<double>(chunkNs_) / speed_);
+      const std::int64_t waitNs = dueNs - now();
+      if (waitNs > 0)
+      {
+        if (waitNs > std::chrono::nanoseconds(timeout).count())
+        {
+          std::this_thread::sleep_for(timeout);
+          return 0;
+        }
+        std::this_thread::sleep_for(std::chrono::nanoseconds(waitNs));
+      }
+    }
+
+    const std::size_t count = std::min(size, chunk_.size() - pending_);
+    std::memcpy(buf, chunk_.data() + pending_, count);
+    pending_ += count;
+    return static_cast<long>(count);
+  }
+
+  /// Nobody listens in a recording
+  bool write(const std::uint8_t *, std::size_t) override { return true; }
+
+private:
+  static std::int64_t now()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  bool next()
+  {
+    std::uint8_t header[12];
+    if (std::fread(header, 1, sizeof(header), file_) != sizeof(header))
+    {
+      return false;
+    }
+
+    std::uint64_t ns = 0;
+    std::uint32_t size = 0;
+    for (int i = 0; i < 8; ++i)
+    {
+      ns |= static_cast<std::uint64_t>(header[i]) << (8 * i);
+    }
+    for (int i = 0; i < 4; ++i)
+    {
+      size |= static_cast<std::uint32_t>(header[8 + i]) << (8 * i);
+    }
+
+    chunk_.resize(size);
+    if (std::fread(chunk_.data(), 1, size, file_) != size)
+    {
+      return false;
+    }
+    chunkNs_ = static_cast<std::int64_t>(ns);
+    pending_ = 0;
+    return true;
+  }
+
+  std::FILE *file_;
+  double speed_;
+  std::int64_t startNs_;
+  std::int64_t chunkNs_ = 0;
+  std::vector<std::uint8_t> chunk_;
+  std::size_t pending_ = 0;
+};
+
+} // namespace
+
+std::unique_ptr<Transport> openSerial(const std::string &path, unsigned baud)
+{
+  const int fd = ::open(path.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
+  if (fd < 0)
+  {
+    throw lastError("open " + path);
+  }
+
+  termios tio{};
+  if (::tcgetattr(fd, &tio) != 0)
+  {
+    const auto error = lastError("tcgetattr " + path);
+    ::close(fd);
+    throw error;
+  }
+  ::cfmakeraw(&tio);
+  tio.c_cflag |= CLOCAL | CREAD;
+  tio.c_cflag &= ~(CSTOPB | CRTSCTS);
+  tio.c_cc[VMIN] = 0;
+  tio.c_cc[VTIME] = 0;
+
+  const speed_t speed = standardBaud(baud);
+#if defined(__APPLE__)
+  /* Anything above 230400 is set with an ioctl after the rest */
+  ::cfsetspeed(&tio, (speed != 0) ? speed : B230400);
+#else
+  if (speed == 0)
+  {
+    ::close(fd);
+    throw std::system_error(EINVAL, std::generic_category(), "baud rate " + std::to_string(baud));
+  }
+  ::cfsetspeed(&tio, speed);
+#endif
+
+  if (::tcsetattr(fd, TCSANOW, &tio) != 0)
+  {
+    const auto error = lastError("tcsetattr " + path);
+    ::close(fd);
+    throw error;
+  }
+
+#if defined(__APPLE__)
+  if (speed == 0)
+  {
+    speed_t custom = baud;
+    if (::ioctl(fd, IOSSIOSPEED, &custom) != 0)
+    {
+      const auto error = lastError("IOSSIOSPEED " + path);
+      ::close(fd);
+      throw error;
+    }
+  }
+#elif defined(__linux__)
+  /* Not every driver knows it, the port works without */
+  serial_struct serial{};
+  if (::ioctl(fd, TIOCGSERIAL, &serial) == 0)
+  {
+    serial.flags |= ASYNC_LOW_LATENCY;
+    ::ioctl(fd, TIOCSSERIAL, &serial);
+  }
+#endif
+
+  ::tcflush(fd, TCIOFLUSH);
+  return std::make_unique<FdTransport>(fd);
+}
+
+std::unique_ptr<Transport> openTcp(const std::string &host, std::uint16_t port)
+{
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+
+  addrinfo *result = nullptr;
+  const int rc = ::getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &result);
+  if (rc != 0)
+  {
+    throw std::system_error(EHOSTUNREACH, std::generic_category(), host + ": " + ::gai_strerror(rc));
+  }
+
+  int fd = -1;
+  for (addrinfo *ai = result; ai != nullptr; ai = ai->ai_next)
+  {
+    fd = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+    if (fd < 0)
+    {
+      continue;
+    }
+    if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0)
+    {
+      break;
+    }
+    ::close(fd);
+    fd = -1;
+  }
+  ::freeaddrinfo(result);
+
+  if (fd < 0)
+  {
+    throw lastError("connect " + host + ":" + std::to_string(port));
+  }
+
+  /* Small frames, send them right away */
+  const int one = 1;
+  ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+  return std::make_unique<FdTransport>(fd);
+}
+
+std::unique_ptr<Transport> openReplay(const std::string &path, double speed)
+{
+  std::FILE *file = std::fopen(path.c_str(), "rb");
+  if (file == nullptr)
+  {
+    throw lastError("open " + path);
+  }
+
+  char magic[sizeof(kRecordMagic)];
+  if (std::fread(magic, 1, sizeof(magic), file) != sizeof(magic) || std::memcmp(magic, kRecordMagic, sizeof(magic)) != 0)
+  {
+    std::fclose(file);
+    throw std::runtime_error(path + " is no recording");
+  }
+
+  return std::make_unique<ReplayTransport>(file, speed);
+}
+
+} // namespace openhand
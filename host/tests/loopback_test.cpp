@@ -0,0 +1,213 @@
+/**
+ * @file loopback_test.cpp
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief What the client adds to the latency of a frame, and how many bytes per second it takes, over an in-memory link
+ *
+ *   openhand-test-loopback [--seconds 2] [--max-p99-us 1000] [--min-rate B/S]
+ *
+ * Without a wire and a second process the measurement is only the client: its I/O thread, parser, queue and
+ * dispatcher thread, from handing the bytes to the transport to the callback.
+ *  - paced: frames at the rate of the 1 Mbaud UART, the latency of every frame, p99 checked against --max-p99-us
+ *    (the client's own ClientStats latency is reported too)
+ *  - burst: as many frames as fit into a few megabytes at once, the rate the client gets through them,
+ *    checked against --min-rate
+ * Neither may lose, break or drop a frame. Exits with the number of failed checks, 2 on bad arguments
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "openhand/client.hpp"
+#include "test_util.hpp"
+
+namespace {
+
+/// Payload of the test frames: the sender's nowNs() and padding, the size of an RTM frame
+constexpr std::size_t kPayloadSize = 40;
+constexpr std::size_t kFrameSize = openhand::kHeaderSize + kPayloadSize + openhand::kCrcSize;
+
+/// Bytes per second of the 1 Mbaud UART (10 bits per byte)
+constexpr double kLinkRate = 100000.0;
+
+std::vector<std::uint8_t> makeFrame(std::uint8_t seq, std::int64_t sentNs)
+{
+  std::vector<std::uint8_t> payload(kPayloadSize, 0x55);
+  for (int i = 0; i < 8; ++i)
+  {
+    payload[static_cast<std::size_t>(i)] = static_cast<std::uint8_t>(static_cast<std::uint64_t>(sentNs) >> (8 * i));
+  }
+  std::vector<std::uint8_t> frame;
+  openhand::test::appendFrame(frame, static_cast<std::uint8_t>(openhand::msg::Id::Rtm), seq, payload);
+  return frame;
+}
+
+std::int64_t sentNs(const openhand::Frame &frame)
+{
+  std::uint64_t ns = 0;
+  for (int i = 0; i < 8; ++i)
+  {
+    ns |= static_cast<std::uint64_t>(frame.payload[static_cast<std::size_t>(i)]) << (8 * i);
+  }
+  return static_cast<std::int64_t>(ns);
+}
+
+std::int64_t quantile(std::vector<std::int64_t> values, double q)
+{
+  if (values.empty())
+  {
+    return 0;
+  }
+  const std::size_t index = std::min(values.size() - 1, static_cast<std::size_t>(q * static_cast<double>(values.size())));
+  std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+  return values[index];
+}
+
+void checkClean(const openhand::ClientStats &stats, std::uint64_t frames)
+{
+  OH_CHECK(stats.rxFrames == frames);
+  OH_CHECK(stats.dispatched == frames);
+  OH_CHECK(stats.crcErrors == 0);
+  OH_CHECK(stats.lostFrames == 0);
+  OH_CHECK(stats.queueDrops == 0);
+}
+
+/// Wait until the client dispatched count frames, 10 s at most
+void waitFor(openhand::Client &client, std::uint64_t count)
+{
+  const auto end = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while ((client.stats().dispatched < count) && (std::chrono::steady_clock::now() < end))
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+void testPaced(double seconds, double maxP99Us)
+{
+  auto loopback = std::make_unique<openhand::test::LoopbackTransport>();
+  openhand::test::LoopbackTransport *link = loopback.get();
+  openhand::Client client(std::move(loopback));
+
+  std::mutex mutex;
+  std::vector<std::int64_t> latencyNs;
+  client.onAny([&](const openhand::Frame &frame) {
+    const std::int64_t ns = openhand::Client::nowNs() - sentNs(frame);
+    std::lock_guard<std::mutex> lock(mutex);
+    latencyNs.push_back(ns);
+  });
+  client.start();
+
+  const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(kFrameSize / kLinkRate));
+  const std::uint64_t frames = static_cast<std::uint64_t>(seconds * kLinkRate / kFrameSize);
+  auto next = std::chrono::steady_clock::now();
+  for (std::uint64_t i = 0; i < frames; ++i)
+  {
+    std::this_thread::sleep_until(next);
+    next += period;
+    const std::vector<std::uint8_t> frame = makeFrame(static_cast<std::uint8_t>(i), openhand::Client::nowNs());
+    link->inject(frame.data(), frame.size());
+  }
+
+  waitFor(client, frames);
+  const openhand::ClientStats stats = client.stats();
+  client.stop();
+
+  std::lock_guard<std::mutex> lock(mutex);
+  const std::int64_t p50 = quantile(latencyNs, 0.5);
+  const std::int64_t p99 = quantile(latencyNs, 0.99);
+  const std::int64_t max = quantile(latencyNs, 1.0);
+  std::printf("paced: %llu frames at %.0f B/s, latency p50 %.1f us, p99 %.1f us, max %.1f us\n", static_cast<unsigned long long>(frames), kLinkRate,
+              static_cast<double>(p50) / 1e3, static_cast<double>(p99) / 1e3, static_cast<double>(max) / 1e3);
+  std::printf("paced: client latency mean %.1f us, max %.1f us, >1ms %llu\n", static_cast<double>(stats.meanLatencyNs) / 1e3,
+              static_cast<double>(stats.maxLatencyNs) / 1e3, static_cast<unsigned long long>(stats.lateFrames));
+
+  checkClean(stats, frames);
+  OH_CHECK(latencyNs.size() == frames);
+  OH_CHECK(static_cast<double>(p99) <= maxP99Us * 1e3);
+}
+
+void testBurst(double minRate)
+{
+  constexpr std::uint64_t kFrames = 100000;
+
+  auto loopback = std::make_unique<openhand::test::LoopbackTransport>();
+  openhand::test::LoopbackTransport *link = loopback.get();
+  openhand::Client client(std::move(loopback));
+  client.onAny([](const openhand::Frame &) {});
+  client.start();
+
+  std::vector<std::uint8_t> stream;
+  stream.reserve(kFrames * kFrameSize);
+  for (std::uint64_t i = 0; i < kFrames; ++i)
+  {
+    const std::vector<std::uint8_t> frame = makeFrame(static_cast<std::uint8_t>(i), 0);
+    stream.insert(stream.end(), frame.begin(), frame.end());
+  }
+
+  /* Handed over in pieces of the size the client reads, the queue between the threads is what is tested */
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t pos = 0; pos < stream.size(); pos += 4096)
+  {
+    link->inject(stream.data() + pos, std::min<std::size_t>(4096, stream.size() - pos));
+  }
+  waitFor(client, kFrames);
+  const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  const openhand::ClientStats stats = client.stats();
+  client.stop();
+
+  const double rate = static_cast<double>(stats.rxBytes) / elapsed;
+  std::printf("burst: %llu frames in %.1f ms, %.0f B/s (%.0fx the UART)\n", static_cast<unsigned long long>(kFrames), elapsed * 1e3, rate, rate / kLinkRate);
+
+  checkClean(stats, kFrames);
+  OH_CHECK(rate >= minRate);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  double seconds = 2.0;
+  double maxP99Us = 1000.0;
+  double minRate = 10 * kLinkRate;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    if ((arg == "--seconds") && (i + 1 < argc))
+    {
+      seconds = std::strtod(argv[++i], nullptr);
+    }
+    else if ((arg == "--max-p99-us") && (i + 1 < argc))
+    {
+      maxP99Us = std::strtod(argv[++i], nullptr);
+    }
+    else if ((arg == "--min-rate") && (i + 1 < argc))
+    {
+      minRate = std::strtod(argv[++i], nullptr);
+    }
+    else
+    {
+      std::fprintf(stderr, "usage: openhand-test-loopback [--seconds N] [--max-p99-us US] [--min-rate B/S]\n");
+      return 2;
+    }
+  }
+
+  testPaced(seconds, maxP99Us);
+  testBurst(minRate);
+  return openhand::test::failures();
+}
@@ -0,0 +1,251 @@
+/**
+ * @file parser_test.cpp
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief FrameParser: frames split over any number of reads, and resync after broken, cut and stray bytes
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "openhand/frame.hpp"
+#include "test_util.hpp"
+
+namespace {
+
+using openhand::test::appendFrame;
+
+struct Sent
+{
+  std::uint8_t id;
+  std::uint8_t seq;
+  std::vector<std::uint8_t> payload;
+  std::size_t offset; ///< Where the frame starts in the stream
+};
+
+/// Frames of every length, the payloads also hold the sync bytes, so a parser that looks for them inside a frame fails
+std::vector<Sent> makeFrames(std::vector<std::uint8_t> &stream)
+{
+  std::vector<Sent> frames;
+  for (int i = 0; i < 64; ++i)
+  {
+    Sent frame{static_cast<std::uint8_t>(0x80 + (i % 16)), static_cast<std::uint8_t>(i), {}, stream.size()};
+    const std::size_t size = (static_cast<std::size_t>(i) * 37) % 200;
+    for (std::size_t j = 0; j < size; ++j)
+    {
+      frame.payload.push_back(static_cast<std::uint8_t>((j % 7 == 0) ? openhand::kSync1 : ((j % 7 == 1) ? openhand::kSync2 : (i + j))));
+    }
+    appendFrame(stream, frame.id, frame.seq, frame.payload);
+    frames.push_back(frame);
+  }
+  return frames;
+}
+
+bool same(const openhand::Frame &frame, const Sent &sent)
+{
+  return (frame.id == sent.id) && (frame.seq == sent.seq) && (frame.size == sent.payload.size()) &&
+         std::equal(sent.payload.begin(), sent.payload.end(), frame.data());
+}
+
+/// Feed the stream in reads of the given sizes, cycling through them
+std::vector<openhand::Frame> parse(openhand::FrameParser &parser, const std::vector<std::uint8_t> &stream, const std::vector<std::size_t> &reads)
+{
+  std::vector<openhand::Frame> frames;
+  std::size_t pos = 0;
+  std::size_t i = 0;
+  while (pos < stream.size())
+  {
+    const std::size_t count = std::min(reads[i++ % reads.size()], stream.size() - pos);
+    parser.feed(stream.data() + pos, count, static_cast<std::int64_t>(pos), [&](const openhand::Frame &frame) { frames.push_back(frame); });
+    pos += count;
+  }
+  return frames;
+}
+
+/// Every frame received is one that was sent, in order, and says whether each sent frame was received
+std::vector<bool> match(const std::vector<openhand::Frame> &received, const std::vector<Sent> &sent)
+{
+  std::vector<bool> found(sent.size(), false);
+  std::size_t next = 0;
+  for (const openhand::Frame &frame : received)
+  {
+    while ((next < sent.size()) && !same(frame, sent[next]))
+    {
+      ++next;
+    }
+    OH_CHECK(next < sent.size());
+    if (next < sent.size())
+    {
+      found[next++] = true;
+    }
+  }
+  return found;
+}
+
+void testSplit()
+{
+  std::vector<std::uint8_t> stream;
+  const std::vector<Sent> sent = makeFrames(stream);
+
+  for (const std::vector<std::size_t> &reads : {std::vector<std::size_t>{stream.size()}, std::vector<std::size_t>{1},
+                                                 std::vector<std::size_t>{2, 3, 5, 7, 11, 13, 17, 64, 1, 300}})
+  {
+    openhand::FrameParser parser;
+    const std::vector<openhand::Frame> received = parse(parser, stream, reads);
+    OH_CHECK(received.size() == sent.size());
+    for (std::size_t i = 0; i < std::min(received.size(), sent.size()); ++i)
+    {
+      OH_CHECK(same(received[i], sent[i]));
+    }
+    OH_CHECK(parser.crcErrors() == 0);
+  }
+
+  /* A frame is given the time of the read that completed it */
+  openhand::FrameParser parser;
+  const std::vector<openhand::Frame> received = parse(parser, stream, {1});
+  for (std::size_t i = 0; i < std::min(received.size(), sent.size()); ++i)
+  {
+    OH_CHECK(received[i].rxNs == static_cast<std::int64_t>(sent[i].offset + openhand::kHeaderSize + sent[i].payload.size() + openhand::kCrcSize - 1));
+  }
+}
+
+void testCorrupted()
+{
+  std::vector<std::uint8_t> stream;
+  const std::vector<Sent> sent = makeFrames(stream);
+
+  /* One bit of a payload: only that frame goes, counted as a CRC error */
+  std::vector<std::uint8_t> broken = stream;
+  broken[sent[10].offset + openhand::kHeaderSize + 3] ^= 0x10;
+  openhand::FrameParser parser;
+  std::vector<bool> found = match(parse(parser, broken, {5, 64}), sent);
+  for (std::size_t i = 0; i < sent.size(); ++i)
+  {
+    OH_CHECK(found[i] == (i != 10));
+  }
+  OH_CHECK(parser.crcErrors() == 1);
+
+  /* The length byte: the frame takes the following frames with it, they are found when its bytes are searched again */
+  broken = stream;
+  broken[sent[20].offset + 4] = 255;
+  openhand::FrameParser lengthParser;
+  found = match(parse(lengthParser, broken, {7}), sent);
+  for (std::size_t i = 0; i < sent.size(); ++i)
+  {
+    OH_CHECK(found[i] == (i != 20));
+  }
+  OH_CHECK(lengthParser.crcErrors() == 1);
+}
+
+void testCut()
+{
+  std::vector<std::uint8_t> stream;
+  const std::vector<Sent> sent = makeFrames(stream);
+
+  /* Bytes lost in the middle of a frame (a UART overrun): the frame takes the start of the next one for its rest,
+   * only the frame that lost bytes is gone. The sync bytes in the payloads must not keep the parser off the frames */
+  for (std::size_t lost : {1, 3, 40})
+  {
+    std::vector<std::uint8_t> cut = stream;
+    const std::size_t at = sent[30].offset + openhand::kHeaderSize + 2;
+    cut.erase(cut.begin() + static_cast<std::ptrdiff_t>(at), cut.begin() + static_cast<std::ptrdiff_t>(at + lost));
+    openhand::FrameParser parser;
+    const std::vector<bool> found = match(parse(parser, cut, {13}), sent);
+    for (std::size_t i = 0; i < sent.size(); ++i)
+    {
+      OH_CHECK(found[i] == (i != 30));
+    }
+    OH_CHECK(parser.crcErrors() == 1);
+  }
+
+  /* Only the start of a frame, then reset() as after lost bytes: the next frame is there */
+  openhand::FrameParser resetParser;
+  std::vector<openhand::Frame> received;
+  resetParser.feed(stream.data() + sent[5].offset, 4, 0, [&](const openhand::Frame &frame) { received.push_back(frame); });
+  resetParser.reset();
+  resetParser.feed(stream.data() + sent[6].offset, sent[7].offset - sent[6].offset, 0, [&](const openhand::Frame &frame) { received.push_back(frame); });
+  OH_CHECK(received.size() == 1 && same(received[0], sent[6]));
+}
+
+void testStrayBytes()
+{
+  std::vector<std::uint8_t> stream;
+  const std::vector<Sent> sent = makeFrames(stream);
+
+  /* Noise before the first frame, ending in a lone sync byte: A5 A5 5A is still a frame start */
+  std::vector<std::uint8_t> noisy = {0x00, 0xFF, openhand::kSync2, openhand::kSync1, 0x13, 0x37, openhand::kSync1};
+  noisy.insert(noisy.end(), stream.begin(), stream.end());
+
+  openhand::FrameParser parser;
+  const std::vector<openhand::Frame> received = parse(parser, noisy, {3});
+  OH_CHECK(received.size() == sent.size());
+  for (std::size_t i = 0; i < std::min(received.size(), sent.size()); ++i)
+  {
+    OH_CHECK(same(received[i], sent[i]));
+  }
+  OH_CHECK(parser.crcErrors() == 0);
+}
+
+/// Random damage of every kind: nothing is made up, and the frames before and well after the damage are there
+void testRandomDamage()
+{
+  std::vector<std::uint8_t> stream;
+  const std::vector<Sent> sent = makeFrames(stream);
+  std::mt19937 random(12345);
+
+  for (int round = 0; round < 500; ++round)
+  {
+    std::vector<std::uint8_t> damaged = stream;
+    const std::size_t at = std::uniform_int_distribution<std::size_t>(0, stream.size() / 2)(random);
+    const std::size_t count = std::uniform_int_distribution<std::size_t>(1, 300)(random);
+    switch (round % 3)
+    {
+    case 0:
+      damaged.erase(damaged.begin() + static_cast<std::ptrdiff_t>(at), damaged.begin() + static_cast<std::ptrdiff_t>(at + count));
+      break;
+    case 1:
+      for (std::size_t i = at; i < at + count; ++i)
+      {
+        damaged[i] = static_cast<std::uint8_t>(random());
+      }
+      break;
+    default:
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        damaged.insert(damaged.begin() + static_cast<std::ptrdiff_t>(at), (i % 5 == 0) ? openhand::kSync1 : static_cast<std::uint8_t>(random()));
+      }
+      break;
+    }
+
+    openhand::FrameParser parser;
+    const std::vector<bool> found = match(parse(parser, damaged, {1 + static_cast<std::size_t>(round % 97)}), sent);
+    for (std::size_t i = 0; i < sent.size(); ++i)
+    {
+      const std::size_t end = sent[i].offset + openhand::kHeaderSize + sent[i].payload.size() + openhand::kCrcSize;
+      if ((end <= at) || ((round % 3 != 2) && (sent[i].offset >= at + count + openhand::kMaxFrame)))
+      {
+        OH_CHECK(found[i]);
+      }
+    }
+  }
+}
+
+} // namespace
+
+int main()
+{
+  testSplit();
+  testCorrupted();
+  testCut();
+  testStrayBytes();
+  testRandomDamage();
+  return openhand::test::failures();
+}
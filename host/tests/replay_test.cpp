@@ -0,0 +1,174 @@
+/**
+ * @file replay_test.cpp
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief Record and replay: what a client recorded plays back as the same frames, broken ones included
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+#include "openhand/client.hpp"
+#include "test_util.hpp"
+
+namespace {
+
+struct Received
+{
+  std::uint8_t id;
+  std::uint8_t seq;
+  std::vector<std::uint8_t> payload;
+  std::int64_t rxNs;
+
+  bool operator==(const Received &other) const { return (id == other.id) && (seq == other.seq) && (payload == other.payload); }
+};
+
+/// Collects the frames from the dispatcher thread
+struct Collector
+{
+  std::mutex mutex;
+  std::vector<Received> frames;
+
+  void attach(openhand::Client &client)
+  {
+    client.onAny([this](const openhand::Frame &frame) {
+      std::lock_guard<std::mutex> lock(mutex);
+      frames.push_back({frame.id, frame.seq, std::vector<std::uint8_t>(frame.data(), frame.data() + frame.size), frame.rxNs});
+    });
+  }
+
+  std::size_t size()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return frames.size();
+  }
+};
+
+/// Wait until the client stopped on its own or has dispatched count frames
+void waitFor(openhand::Client &client, Collector &collector, std::size_t count)
+{
+  const auto end = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while ((collector.size() < count) && client.stats().running && (std::chrono::steady_clock::now() < end))
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+}
+
+void testRoundTrip(const std::string &path)
+{
+  constexpr int kBursts = 20;
+  constexpr int kFramesPerBurst = 10;
+
+  /* Live: bursts of frames 10 ms apart, one of them broken, recorded as they are read */
+  auto loopback = std::make_unique<openhand::test::LoopbackTransport>();
+  openhand::test::LoopbackTransport *link = loopback.get();
+  openhand::Client live(std::move(loopback));
+  Collector liveFrames;
+  liveFrames.attach(live);
+  OH_CHECK(live.record(path));
+  live.start();
+
+  std::uint8_t seq = 0;
+  for (int burst = 0; burst < kBursts; ++burst)
+  {
+    std::vector<std::uint8_t> stream;
+    for (int i = 0; i < kFramesPerBurst; ++i)
+    {
+      std::vector<std::uint8_t> payload(static_cast<std::size_t>(4 + (burst * 7 + i) % 60), static_cast<std::uint8_t>(burst));
+      payload[0] = static_cast<std::uint8_t>(i);
+      openhand::test::appendFrame(stream, static_cast<std::uint8_t>(openhand::msg::Id::Rtm), seq++, payload);
+    }
+    if (burst == 5)
+    {
+      stream[8] ^= 0xFF;
+    }
+    link->inject(stream.data(), stream.size());
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  waitFor(live, liveFrames, kBursts * kFramesPerBurst - 1);
+  OH_CHECK(live.record(""));
+  const openhand::ClientStats liveStats = live.stats();
+  live.stop();
+
+  OH_CHECK(liveFrames.frames.size() == kBursts * kFramesPerBurst - 1);
+  OH_CHECK(liveStats.crcErrors == 1);
+  OH_CHECK(liveStats.lostFrames == 1);
+
+  /* Replay at the recorded speed: same frames, same statistics, and the bursts keep their spacing */
+  openhand::Client replay(openhand::openReplay(path, 1.0));
+  Collector replayFrames;
+  replayFrames.attach(replay);
+  replay.start();
+  waitFor(replay, replayFrames, liveFrames.frames.size() + 1);
+  const openhand::ClientStats replayStats = replay.stats();
+  replay.stop();
+
+  OH_CHECK(replayFrames.frames == liveFrames.frames);
+  OH_CHECK(replayStats.crcErrors == liveStats.crcErrors);
+  OH_CHECK(replayStats.lostFrames == liveStats.lostFrames);
+  OH_CHECK(replayStats.rxBytes == liveStats.rxBytes);
+  OH_CHECK(!replayStats.running && (replayStats.error == "transport closed"));
+
+  if (replayFrames.frames.size() == liveFrames.frames.size())
+  {
+    const std::int64_t liveSpanNs = liveFrames.frames.back().rxNs - liveFrames.frames.front().rxNs;
+    const std::int64_t replaySpanNs = replayFrames.frames.back().rxNs - replayFrames.frames.front().rxNs;
+    std::printf("%zu frames, live over %.1f ms, replayed over %.1f ms\n", replayFrames.frames.size(), static_cast<double>(liveSpanNs) / 1e6,
+                static_cast<double>(replaySpanNs) / 1e6);
+    OH_CHECK(replaySpanNs >= liveSpanNs * 8 / 10);
+  }
+
+  /* As fast as possible: the same frames again */
+  openhand::Client fast(openhand::openReplay(path, 0));
+  Collector fastFrames;
+  fastFrames.attach(fast);
+  fast.start();
+  waitFor(fast, fastFrames, liveFrames.frames.size() + 1);
+  fast.stop();
+  OH_CHECK(fastFrames.frames == liveFrames.frames);
+}
+
+void testNoRecording(const std::string &path)
+{
+  std::FILE *file = std::fopen(path.c_str(), "wb");
+  std::fputs("not a recording", file);
+  std::fclose(file);
+
+  bool threw = false;
+  try
+  {
+    openhand::openReplay(path);
+  }
+  catch (const std::runtime_error &)
+  {
+    threw = true;
+  }
+  OH_CHECK(threw);
+}
+
+} // namespace
+
+int main()
+{
+  const std::string path = "openhand_replay_test_" + std::to_string(getpid()) + ".ohrec";
+
+  testRoundTrip(path);
+  testNoRecording(path);
+
+  std::remove(path.c_str());
+  return openhand::test::failures();
+}
@@ -0,0 +1,108 @@
+/**
+ * @file spsc_queue_test.cpp
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief SpscQueue: order, full and empty, and one producer against one consumer thread
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <cstdint>
+#include <thread>
+
+#include "openhand/spsc_queue.hpp"
+#include "test_util.hpp"
+
+namespace {
+
+void testSingleThread()
+{
+  openhand::SpscQueue<int, 8> queue;
+
+  OH_CHECK(queue.empty());
+  OH_CHECK(queue.front() == nullptr);
+
+  /* Capacity - 1 usable slots */
+  for (int i = 0; i < 7; ++i)
+  {
+    OH_CHECK(queue.push(i));
+  }
+  OH_CHECK(!queue.push(7));
+
+  for (int i = 0; i < 7; ++i)
+  {
+    const int *item = queue.front();
+    OH_CHECK(item != nullptr && *item == i);
+    queue.pop();
+  }
+  OH_CHECK(queue.empty());
+
+  /* Around the end of the ring */
+  for (int i = 0; i < 20; ++i)
+  {
+    OH_CHECK(queue.push(i));
+    OH_CHECK(queue.push(i + 100));
+    OH_CHECK(*queue.front() == i);
+    queue.pop();
+    OH_CHECK(*queue.front() == i + 100);
+    queue.pop();
+  }
+  OH_CHECK(queue.empty());
+}
+
+/// Every item arrives once and in order, however the two threads interleave
+void testTwoThreads()
+{
+  constexpr std::uint64_t kItems = 2000000;
+  openhand::SpscQueue<std::uint64_t, 64> queue;
+  std::uint64_t fullCount = 0;
+
+  std::thread producer([&] {
+    for (std::uint64_t i = 0; i < kItems; ++i)
+    {
+      while (!queue.push(i))
+      {
+        ++fullCount;
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  std::uint64_t expected = 0;
+  std::uint64_t outOfOrder = 0;
+  while (expected < kItems)
+  {
+    const std::uint64_t *item = queue.front();
+    if (item == nullptr)
+    {
+      std::this_thread::yield();
+      continue;
+    }
+    if (*item != expected)
+    {
+      ++outOfOrder;
+    }
+    queue.pop();
+    ++expected;
+  }
+  producer.join();
+
+  OH_CHECK(outOfOrder == 0);
+  OH_CHECK(queue.empty());
+  std::printf("%llu items, producer found the queue full %llu times\n", static_cast<unsigned long long>(kItems),
+              static_cast<unsigned long long>(fullCount));
+}
+
+} // namespace
+
+int main()
+{
+  testSingleThread();
+  testTwoThreads();
+  return openhand::test::failures();
+}
@@ -0,0 +1,114 @@
+/**
+ * @file test_util.hpp
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief What the host tests share: a check that counts failures, and an in-memory transport
+ *
+ * Every test is its own program, run by ctest, that prints what failed and returns the number of failures
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "openhand/frame.hpp"
+#include "openhand/transport.hpp"
+
+namespace openhand {
+namespace test {
+
+/// Failed checks of the test program so far, main() returns it
+inline int &failures()
+{
+  static int count = 0;
+  return count;
+}
+
+#define OH_CHECK(condition)                                                            \
+  do                                                                                   \
+  {                                                                                    \
+    if (!(condition))                                                                  \
+    {                                                                                  \
+      std::printf("%s:%d: FAIL: %s\n", __FILE__, __LINE__, #condition);                \
+      ++openhand::test::failures();                                                    \
+    }                                                                                  \
+  } while (0)
+
+/// Bytes written by the test are read by the client, like a link with no wire in between
+class LoopbackTransport : public Transport
+{
+public:
+  long read(std::uint8_t *buf, std::size_t size, std::chrono::milliseconds timeout) override
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait_for(lock, timeout, [this] { return !bytes_.empty() || closed_; });
+    if (bytes_.empty())
+    {
+      return closed_ ? -1 : 0;
+    }
+    const std::size_t count = std::min(size, bytes_.size());
+    std::copy(bytes_.begin(), bytes_.begin() + static_cast<std::ptrdiff_t>(count), buf);
+    bytes_.erase(bytes_.begin(), bytes_.begin() + static_cast<std::ptrdiff_t>(count));
+    return static_cast<long>(count);
+  }
+
+  /// What the client sends, kept for the test to look at
+  bool write(const std::uint8_t *data, std::size_t size) override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sent_.insert(sent_.end(), data, data + size);
+    return true;
+  }
+
+  /// The other end sends bytes, from any thread
+  void inject(const std::uint8_t *data, std::size_t size)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      bytes_.insert(bytes_.end(), data, data + size);
+    }
+    cv_.notify_one();
+  }
+
+  /// The other end goes away, reads fail once everything was read
+  void close()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closed_ = true;
+    }
+    cv_.notify_one();
+  }
+
+private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::uint8_t> bytes_;
+  std::vector<std::uint8_t> sent_;
+  bool closed_ = false;
+};
+
+/// Append a frame to a byte stream
+inline void appendFrame(std::vector<std::uint8_t> &stream, std::uint8_t id, std::uint8_t seq, const std::vector<std::uint8_t> &payload)
+{
+  std::uint8_t frame[kMaxFrame];
+  const std::size_t size = encodeFrame(id, seq, payload.data(), payload.size(), frame);
+  stream.insert(stream.end(), frame, frame + size);
+}
+
+} // namespace test
+} // namespace openhand
@@ -0,0 +1,203 @@
+/**
+ * @file dump.cpp
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief openhand-dump: prints the frames of a board and the client statistics every second
+ *
+ *   openhand-dump --serial /dev/ttyUSB0 [--baud 1000000] [--record run.ohrec]
+ *   openhand-dump --tcp localhost:5760
+ *   openhand-dump --replay run.ohrec [--speed 0]
+ *
+ * With --quiet only the statistics are printed, e.g. to check the latency of the client at full rate.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <thread>
+
+#include "openhand/client.hpp"
+
+namespace {
+
+std::atomic<bool> stopRequested{false};
+
+void onSignal(int)
+{
+  stopRequested = true;
+}
+
+void usage()
+{
+  std::fprintf(stderr,
+               "usage: openhand-dump (--serial PATH [--baud N] | --tcp HOST:PORT | --replay FILE [--speed X])\n"
+               "                     [--record FILE] [--quiet]\n");
+}
+
+void printFrame(const openhand::Frame &frame)
+{
+  const char *name = openhand::msg::name(frame.id);
+  std::printf("%12.6f %-10s seq %3u len %3u:", static_cast<double>(frame.rxNs) / 1e9, (name != nullptr) ? name : "?", frame.seq, frame.size);
+  for (std::size_t i = 0; i < frame.size; ++i)
+  {
+    std::printf(" %02x", frame.payload[i]);
+  }
+  std::printf("\n");
+}
+
+void printStats(const openhand::ClientStats &stats)
+{
+  std::printf("-- rx %llu B %llu frames, crc %llu, lost %llu, dropped %llu, invalid %llu, tx %llu, latency mean %.1f us max %.1f us, >1ms %llu\n",
+              static_cast<unsigned long long>(stats.rxBytes), static_cast<unsigned long long>(stats.rxFrames),
+              static_cast<unsigned long long>(stats.crcErrors), static_cast<unsigned long long>(stats.lostFrames),
+              static_cast<unsigned long long>(stats.queueDrops), static_cast<unsigned long long>(stats.invalidPayloads),
+              static_cast<unsigned long long>(stats.txFrames), static_cast<double>(stats.meanLatencyNs) / 1e3,
+              static_cast<double>(stats.maxLatencyNs) / 1e3, static_cast<unsigned long long>(stats.lateFrames));
+  std::fflush(stdout);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  std::string serial, tcp, replay, record;
+  unsigned baud = 1000000;
+  double speed = 1.0;
+  bool quiet = false;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    const bool hasValue = (i + 1 < argc);
+    if (arg == "--serial" && hasValue)
+    {
+      serial = argv[++i];
+    }
+    else if (arg == "--baud" && hasValue)
+    {
+      baud = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+    }
+    else if (arg == "--tcp" && hasValue)
+    {
+      tcp = argv[++i];
+    }
+    else if (arg == "--replay" && hasValue)
+    {
+      replay = argv[++i];
+    }
+    else if (arg == "--speed" && hasValue)
+    {
+      speed = std::strtod(argv[++i], nullptr);
+    }
+    else if (arg == "--record" && hasValue)
+    {
+      record = argv[++i];
+    }
+    else if (arg == "--quiet")
+    {
+      quiet = true;
+    }
+    else
+    {
+      usage();
+      return 2;
+    }
+  }
+
+  std::unique_ptr<openhand::Transport> transport;
+  try
+  {
+    if (!serial.empty())
+    {
+      transport = openhand::openSerial(serial, baud);
+    }
+    else if (!tcp.empty())
+    {
+      const std::size_t colon = tcp.rfind(':');
+      if (colon == std::string::npos)
+      {
+        usage();
+        return 2;
+      }
+      transport = openhand::openTcp(tcp.substr(0, colon), static_cast<std::uint16_t>(std::strtoul(tcp.c_str() + colon + 1, nullptr, 10)));
+    }
+    else if (!replay.empty())
+    {
+      transport = openhand::openReplay(replay, speed);
+    }
+    else
+    {
+      usage();
+      return 2;
+    }
+  }
+  catch (const std::exception &e)
+  {
+    std::fprintf(stderr, "openhand-dump: %s\n", e.what());
+    return 1;
+  }
+
+  openhand::Client client(std::move(transport));
+  if (!quiet)
+  {
+    client.onAny(printFrame);
+  }
+  if (!record.empty() && !client.record(record))
+  {
+    std::fprintf(stderr, "openhand-dump: can't create %s\n", record.c_str());
+    return 1;
+  }
+
+  std::signal(SIGINT, onSignal);
+  std::signal(SIGTERM, onSignal);
+
+  client.start();
+  client.ping();
+
+  int ticks = 0;
+  while (!stopRequested)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    const openhand::ClientStats stats = client.stats();
+    if (!stats.running)
+    {
+      /* Let the dispatcher hand over what is still queued */
+      for (int wait = 0; wait < 100; ++wait)
+      {
+        const openhand::ClientStats now = client.stats();
+        if (now.dispatched + now.queueDrops >= now.rxFrames)
+        {
+          break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+      client.stop();
+      printStats(client.stats());
+      if (!stats.error.empty() && replay.empty())
+      {
+        std::fprintf(stderr, "openhand-dump: %s\n", stats.error.c_str());
+        return 1;
+      }
+      return 0;
+    }
+    if (++ticks % 10 == 0)
+    {
+      printStats(stats);
+    }
+  }
+
+  client.stop();
+  printStats(client.stats());
+  return 0;
+}
@@ -0,0 +1,241 @@
+/**
+ * @file linkcheck.cpp
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief openhand-linkcheck: measures throughput and latency of the link and fails if they regressed
+ *
+ *   openhand-linkcheck --serial PATH [--baud 1000000] [--seconds 5] [--min-rate B/S] [--max-latency-us US] [--max-rtt-us US]
+ *   openhand-linkcheck --tcp HOST:PORT ...
+ *
+ * Meant for the host build of the link (firmware/ProstheticHand/linux/lnk_host.c with --stream) behind a
+ * pseudo-terminal, see tools/linkcheck.sh, which the regression test runs. It also works against a board, but only
+ * the round trip and the client latency are meaningful then.
+ *
+ * What it measures, after the first half second:
+ *  - throughput: bytes per second read from the transport
+ *  - frame latency: from building an RTM frame (its timestamp, CLOCK_MONOTONIC of lnk_host on the same machine)
+ *    to its callback, so the whole path: link layer, pseudo-terminal, I/O thread, queue and dispatch
+ *  - client latency: from reading the frame to its callback, what the client adds (ClientStats)
+ *  - round trip: PING to PONG, 20 per second
+ * and that no frame was lost, broken or dropped on the way. Exits with 1 if anything is off, 2 on bad arguments.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "openhand/client.hpp"
+
+namespace {
+
+/// Measurements start after this, so opening the port and the first burst don't count
+constexpr std::chrono::milliseconds kWarmUp{500};
+
+constexpr std::chrono::milliseconds kPingPeriod{50};
+
+void usage()
+{
+  std::fprintf(stderr,
+               "usage: openhand-linkcheck (--serial PATH [--baud N] | --tcp HOST:PORT) [--seconds N]\n"
+               "                          [--min-rate B/S] [--max-latency-us US] [--max-rtt-us US]\n");
+}
+
+/// Microseconds, wrapping like the u32 timestamps of the frames
+std::uint32_t nowUs32()
+{
+  return static_cast<std::uint32_t>(openhand::Client::nowNs() / 1000);
+}
+
+struct Samples
+{
+  std::mutex mutex;
+  std::vector<std::int64_t> values;
+
+  void add(std::int64_t value)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    values.push_back(value);
+  }
+
+  /// @param q 0..1
+  std::int64_t quantile(double q)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (values.empty())
+    {
+      return 0;
+    }
+    std::vector<std::int64_t> sorted = values;
+    const std::size_t index = std::min(sorted.size() - 1, static_cast<std::size_t>(q * static_cast<double>(sorted.size())));
+    std::nth_element(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(index), sorted.end());
+    return sorted[index];
+  }
+
+  std::size_t size()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return values.size();
+  }
+};
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  std::string serial, tcp;
+  unsigned baud = 1000000;
+  double seconds = 5.0;
+  double minRate = 0;
+  double maxLatencyUs = 0;
+  double maxRttUs = 0;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    const bool hasValue = (i + 1 < argc);
+    if (arg == "--serial" && hasValue)
+    {
+      serial = argv[++i];
+    }
+    else if (arg == "--baud" && hasValue)
+    {
+      baud = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+    }
+    else if (arg == "--tcp" && hasValue)
+    {
+      tcp = argv[++i];
+    }
+    else if (arg == "--seconds" && hasValue)
+    {
+      seconds = std::strtod(argv[++i], nullptr);
+    }
+    else if (arg == "--min-rate" && hasValue)
+    {
+      minRate = std::strtod(argv[++i], nullptr);
+    }
+    else if (arg == "--max-latency-us" && hasValue)
+    {
+      maxLatencyUs = std::strtod(argv[++i], nullptr);
+    }
+    else if (arg == "--max-rtt-us" && hasValue)
+    {
+      maxRttUs = std::strtod(argv[++i], nullptr);
+    }
+    else
+    {
+      usage();
+      return 2;
+    }
+  }
+
+  std::unique_ptr<openhand::Transport> transport;
+  try
+  {
+    if (!serial.empty())
+    {
+      transport = openhand::openSerial(serial, baud);
+    }
+    else if (!tcp.empty())
+    {
+      const std::size_t colon = tcp.rfind(':');
+      if (colon == std::string::npos)
+      {
+        usage();
+        return 2;
+      }
+      transport = openhand::openTcp(tcp.substr(0, colon), static_cast<std::uint16_t>(std::strtoul(tcp.c_str() + colon + 1, nullptr, 10)));
+    }
+    else
+    {
+      usage();
+      return 2;
+    }
+  }
+  catch (const std::exception &e)
+  {
+    std::fprintf(stderr, "openhand-linkcheck: %s\n", e.what());
+    return 1;
+  }
+
+  openhand::Client client(std::move(transport));
+  std::atomic<bool> measuring{false};
+  Samples frameLatency;
+  Samples rtt;
+
+  client.on<openhand::msg::Rtm>([&](const openhand::msg::Rtm &rtm, const openhand::Frame &) {
+    if (measuring)
+    {
+      frameLatency.add(static_cast<std::int32_t>(nowUs32() - rtm.timeUs()));
+    }
+  });
+  client.onFrame(openhand::msg::Id::Pong, [&](const openhand::Frame &frame) {
+    if (measuring && frame.size >= 8)
+    {
+      const std::uint32_t sentUs = openhand::msg::detail::load<std::uint32_t>(frame.data());
+      rtt.add(static_cast<std::int32_t>(nowUs32() - sentUs));
+    }
+  });
+
+  client.start();
+  std::this_thread::sleep_for(kWarmUp);
+
+  const openhand::ClientStats before = client.stats();
+  const auto start = std::chrono::steady_clock::now();
+  const auto end = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+  measuring = true;
+  while (std::chrono::steady_clock::now() < end && client.stats().running)
+  {
+    client.ping();
+    std::this_thread::sleep_for(kPingPeriod);
+  }
+  measuring = false;
+  const openhand::ClientStats after = client.stats();
+  const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  client.stop();
+
+  const double rate = static_cast<double>(after.rxBytes - before.rxBytes) / elapsed;
+  const std::uint64_t lost = after.lostFrames - before.lostFrames;
+  const std::uint64_t broken = after.crcErrors - before.crcErrors;
+  const std::uint64_t dropped = after.queueDrops - before.queueDrops;
+
+  std::printf("rate %.0f B/s, %zu frames timed, lost %llu, crc %llu, dropped %llu\n", rate, frameLatency.size(),
+              static_cast<unsigned long long>(lost), static_cast<unsigned long long>(broken), static_cast<unsigned long long>(dropped));
+  std::printf("frame latency p50 %lld us, p99 %lld us, max %lld us\n", static_cast<long long>(frameLatency.quantile(0.5)),
+              static_cast<long long>(frameLatency.quantile(0.99)), static_cast<long long>(frameLatency.quantile(1.0)));
+  std::printf("client latency mean %.1f us, max %.1f us, >1ms %llu\n", static_cast<double>(after.meanLatencyNs) / 1e3,
+              static_cast<double>(after.maxLatencyNs) / 1e3, static_cast<unsigned long long>(after.lateFrames));
+  std::printf("round trip %zu pings, p50 %lld us, max %lld us\n", rtt.size(), static_cast<long long>(rtt.quantile(0.5)),
+              static_cast<long long>(rtt.quantile(1.0)));
+
+  bool ok = true;
+  auto check = [&ok](bool pass, const char *what) {
+    if (!pass)
+    {
+      std::printf("FAIL: %s\n", what);
+      ok = false;
+    }
+  };
+  check(after.running, "transport closed");
+  check(lost == 0 && broken == 0 && dropped == 0, "frames lost, broken or dropped");
+  check(rtt.size() > 0, "no PONG");
+  check(minRate <= 0 || rate >= minRate, "throughput below --min-rate");
+  check(maxLatencyUs <= 0 || (frameLatency.size() > 0 && static_cast<double>(frameLatency.quantile(0.99)) <= maxLatencyUs),
+        "frame latency p99 above --max-latency-us");
+  check(maxRttUs <= 0 || static_cast<double>(rtt.quantile(1.0)) <= maxRttUs, "round trip above --max-rtt-us");
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,35 @@
+#!/bin/sh
+# Regression test of the link: runs the host build of the firmware link behind a pseudo-terminal, streaming at the
+# rate of the 1 Mbaud UART, and openhand-linkcheck on it like on the serial port of a board.
+#
+#   linkcheck.sh LNK_HOST LINKCHECK [linkcheck arguments...]
+set -u
+
+lnk_host=$1
+linkcheck=$2
+shift 2
+
+dir=$(mktemp -d)
+trap 'kill $pid 2>/dev/null; wait $pid 2>/dev/null; rm -rf "$dir"' EXIT
+
+"$lnk_host" --pty "$dir/tty" --stream 100000 > "$dir/lnk_host.log" 2>&1 &
+pid=$!
+
+# Wait for the link to the pseudo-terminal
+i=0
+while [ ! -e "$dir/tty" ]; do
+  i=$((i + 1))
+  if [ $i -gt 50 ] || ! kill -0 $pid 2>/dev/null; then
+    echo "lnk_host did not start:"
+    cat "$dir/lnk_host.log"
+    exit 1
+  fi
+  sleep 0.1
+done
+
+"$linkcheck" --serial "$dir/tty" "$@"
+rc=$?
+kill $pid
+wait $pid 2>/dev/null
+cat "$dir/lnk_host.log"
+exit $rc
@@ -0,0 +1,480 @@
+/**
+ * @file trace.cpp
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief openhand-trace: turns the TRACE frames of the ESP32 into a Chrome trace / Perfetto timeline
+ *
+ *   openhand-trace --serial /dev/ttyUSB0 [--baud 1000000] [--events 15] [--seconds 5] -o trace.json
+ *   openhand-trace --replay run.ohrec [--speed 0] -o trace.json
+ *
+ * Live, --events sets CFG_TRACE_EVENTS (drivers/trc, trc_EventMask_e: 1 slots, 2 interrupts and timers,
+ * 4 task switches, 8 markers) when it starts and back to 0 when it stops. Open the file in ui.perfetto.dev
+ * or chrome://tracing: every core is a process, with a track each for the slots of the main OS, the interrupt
+ * handlers / timer callbacks, the task that runs and the markers. Times are device microseconds.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "openhand/client.hpp"
+
+namespace {
+
+/// Index of CFG_TRACE_EVENTS in CFG_SET
+constexpr std::size_t kCfgTraceEvents = static_cast<std::size_t>(openhand::msg::Param::TraceEvents);
+constexpr std::uint16_t kCfgKeep = 0xFFFF;
+
+/// trc_Event_e
+enum Event : std::uint8_t
+{
+  kSlotBegin = 0,
+  kSlotEnd,
+  kIsrEnter,
+  kIsrExit,
+  kTaskIn,
+  kMark
+};
+
+/// Tracks of every core, the tid in the trace
+enum Track : int
+{
+  kTrackSlots = 0,
+  kTrackIsr,
+  kTrackTasks,
+  kTrackMarks
+};
+
+constexpr std::uint8_t kTaskOther = 0xFF;
+
+std::atomic<bool> stopRequested{false};
+
+void onSignal(int)
+{
+  stopRequested = true;
+}
+
+void usage()
+{
+  std::fprintf(stderr,
+               "usage: openhand-trace (--serial PATH [--baud N] | --tcp HOST:PORT | --replay FILE [--speed X])\n"
+               "                      [--events MASK] [--seconds N] -o FILE\n");
+}
+
+/// Begin of an event that waits for its end
+struct Open
+{
+  bool active = false;
+  std::uint8_t id = 0;
+  std::uint16_t arg = 0;
+  std::uint64_t us = 0;
+};
+
+/// Time a task ran, named once the whole recording is through, as TRACE_TASKS may come after its first switches
+struct TaskSpan
+{
+  std::uint8_t index;
+  std::uint64_t us;
+  std::uint64_t durUs;
+};
+
+/// Everything known about one core
+struct Core
+{
+  bool started = false;
+  std::uint32_t lastUs = 0;
+  std::uint64_t wrapUs = 0;
+  std::uint32_t lost = 0;
+  Open slot;
+  std::vector<Open> isrs;
+  Open task;
+  std::vector<TaskSpan> spans;
+  std::map<std::uint8_t, std::string> names;
+};
+
+/// Writes the trace events, one per line
+class Writer
+{
+public:
+  explicit Writer(std::FILE *file) : file_(file) { std::fprintf(file_, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"); }
+
+  ~Writer() { std::fprintf(file_, "\n]}\n"); }
+
+  void meta(int pid, int tid, const char *what, const std::string &name)
+  {
+    next();
+    std::fprintf(file_, "{\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"name\":\"%s\",\"args\":{\"name\":\"%s\"}}", pid, tid, what, escape(name).c_str());
+  }
+
+  void complete(int pid, int tid, const std::string &name, std::uint64_t us, std::uint64_t durUs)
+  {
+    next();
+    std::fprintf(file_, "{\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"name\":\"%s\",\"ts\":%llu,\"dur\":%llu}", pid, tid, escape(name).c_str(),
+                 static_cast<unsigned long long>(us), static_cast<unsigned long long>(durUs));
+  }
+
+  void instant(int pid, int tid, const std::string &name, std::uint64_t us, unsigned arg)
+  {
+    next();
+    std::fprintf(file_, "{\"ph\":\"i\",\"s\":\"t\",\"pid\":%d,\"tid\":%d,\"name\":\"%s\",\"ts\":%llu,\"args\":{\"arg\":%u}}", pid, tid,
+                 escape(name).c_str(), static_cast<unsigned long long>(us), arg);
+  }
+
+  std::size_t count() const { return count_; }
+
+private:
+  void next()
+  {
+    if (count_++ != 0)
+    {
+      std::fprintf(file_, ",\n");
+    }
+  }
+
+  static std::string escape(const std::string &text)
+  {
+    std::string out;
+    for (const char c : text)
+    {
+      if (c == '"' || c == '\\')
+      {
+        out += '\\';
+      }
+      out += (static_cast<unsigned char>(c) < 0x20) ? '?' : c;
+    }
+    return out;
+  }
+
+  std::FILE *file_;
+  std::size_t count_ = 0;
+};
+
+std::string nameOf(std::uint64_t packed)
+{
+  std::string name;
+  for (int i = 0; i < 8 && ((packed >> (8 * i)) & 0xFF) != 0; ++i)
+  {
+    name += static_cast<char>((packed >> (8 * i)) & 0xFF);
+  }
+  return name;
+}
+
+std::string isrName(std::uint8_t id, std::uint16_t arg)
+{
+  switch (id)
+  {
+  case 0: return "sup check";
+  case 1: return "led " + std::to_string(arg) + " step";
+  default: return "isr " + std::to_string(id);
+  }
+}
+
+std::string markName(std::uint8_t id)
+{
+  switch (id)
+  {
+  case 0: return "safe state";
+  case 1: return "driver failure";
+  case 2: return "overrun";
+  default: return "mark " + std::to_string(id);
+  }
+}
+
+/// Turns the records of every core into trace events
+class Converter
+{
+public:
+  explicit Converter(Writer &out) : out_(out) {}
+
+  void tasks(const openhand::msg::TraceTasks &msg)
+  {
+    Core &core = coreOf(msg.core());
+    for (std::size_t i = 0; i < msg.tasksCount(); ++i)
+    {
+      core.names[msg.tasks(i).index()] = nameOf(msg.tasks(i).name());
+    }
+  }
+
+  void trace(const openhand::msg::Trace &msg)
+  {
+    const int pid = msg.core();
+    Core &core = coreOf(msg.core());
+
+    for (std::size_t i = 0; i < msg.recordsCount(); ++i)
+    {
+      const auto record = msg.records(i);
+
+      /* Records of a core are in order, a step back by more than half the range is the u32 wrapping */
+      if (core.started && record.timeUs() < core.lastUs && (core.lastUs - record.timeUs()) > 0x80000000u)
+      {
+        core.wrapUs += 0x100000000ull;
+      }
+      core.started = true;
+      core.lastUs = record.timeUs();
+      const std::uint64_t us = core.wrapUs + record.timeUs();
+
+      switch (record.type())
+      {
+      case kSlotBegin:
+        core.slot = Open{true, record.id(), 0, us};
+        break;
+      case kSlotEnd:
+        if (core.slot.active && core.slot.id == record.id())
+        {
+          out_.complete(pid, kTrackSlots, "slot " + std::to_string(record.id()), core.slot.us, us - core.slot.us);
+        }
+        core.slot.active = false;
+        break;
+      case kIsrEnter:
+        core.isrs.push_back(Open{true, record.id(), record.arg(), us});
+        break;
+      case kIsrExit:
+        if (!core.isrs.empty() && core.isrs.back().id == record.id())
+        {
+          out_.complete(pid, kTrackIsr, isrName(record.id(), record.arg()), core.isrs.back().us, us - core.isrs.back().us);
+          core.isrs.pop_back();
+        }
+        else
+        {
+          core.isrs.clear();
+        }
+        break;
+      case kTaskIn:
+        closeTask(core, us);
+        core.task = Open{true, record.id(), 0, us};
+        break;
+      case kMark:
+        out_.instant(pid, kTrackMarks, markName(record.id()), us, record.arg());
+        break;
+      default:
+        break;
+      }
+    }
+
+    /* Lost records break the pairs, so nothing open is trusted after them */
+    if (msg.lost() != core.lost)
+    {
+      if (core.started)
+      {
+        out_.instant(pid, kTrackMarks, std::to_string(msg.lost() - core.lost) + " events lost", core.wrapUs + core.lastUs, msg.lost() - core.lost);
+      }
+      core.lost = msg.lost();
+      core.slot.active = false;
+      core.isrs.clear();
+      core.task.active = false;
+    }
+  }
+
+  void finish()
+  {
+    for (auto &[pid, core] : cores_)
+    {
+      closeTask(core, core.wrapUs + core.lastUs);
+      for (const TaskSpan &span : core.spans)
+      {
+        const auto name = core.names.find(span.index);
+        if (span.index == kTaskOther)
+        {
+          out_.complete(pid, kTrackTasks, "other task", span.us, span.durUs);
+        }
+        else
+        {
+          out_.complete(pid, kTrackTasks, (name != core.names.end()) ? name->second : ("task " + std::to_string(span.index)), span.us, span.durUs);
+        }
+      }
+      out_.meta(pid, 0, "process_name", "core " + std::to_string(pid));
+      out_.meta(pid, kTrackSlots, "thread_name", "main OS slots");
+      out_.meta(pid, kTrackIsr, "thread_name", "interrupts / timers");
+      out_.meta(pid, kTrackTasks, "thread_name", "tasks");
+      out_.meta(pid, kTrackMarks, "thread_name", "markers");
+    }
+  }
+
+private:
+  Core &coreOf(std::uint8_t index) { return cores_[index]; }
+
+  static void closeTask(Core &core, std::uint64_t us)
+  {
+    if (core.task.active)
+    {
+      core.spans.push_back(TaskSpan{core.task.id, core.task.us, us - core.task.us});
+      core.task.active = false;
+    }
+  }
+
+  Writer &out_;
+  std::map<int, Core> cores_;
+};
+
+bool setEvents(openhand::Client &client, std::uint16_t events)
+{
+  std::uint8_t payload[2 * (kCfgTraceEvents + 1)];
+  for (std::size_t i = 0; i <= kCfgTraceEvents; ++i)
+  {
+    const std::uint16_t value = (i == kCfgTraceEvents) ? events : kCfgKeep;
+    payload[2 * i] = static_cast<std::uint8_t>(value);
+    payload[2 * i + 1] = static_cast<std::uint8_t>(value >> 8);
+  }
+  return client.send(openhand::msg::Id::CfgSet, payload, sizeof(payload));
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  std::string serial, tcp, replay, output;
+  unsigned baud = 1000000;
+  double speed = 0.0;
+  long events = -1;
+  double seconds = 0.0;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    const bool hasValue = (i + 1 < argc);
+    if (arg == "--serial" && hasValue)
+    {
+      serial = argv[++i];
+    }
+    else if (arg == "--baud" && hasValue)
+    {
+      baud = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+    }
+    else if (arg == "--tcp" && hasValue)
+    {
+      tcp = argv[++i];
+    }
+    else if (arg == "--replay" && hasValue)
+    {
+      replay = argv[++i];
+    }
+    else if (arg == "--speed" && hasValue)
+    {
+      speed = std::strtod(argv[++i], nullptr);
+    }
+    else if (arg == "--events" && hasValue)
+    {
+      events = std::strtol(argv[++i], nullptr, 0);
+    }
+    else if (arg == "--seconds" && hasValue)
+    {
+      seconds = std::strtod(argv[++i], nullptr);
+    }
+    else if (arg == "-o" && hasValue)
+    {
+      output = argv[++i];
+    }
+    else
+    {
+      usage();
+      return 2;
+    }
+  }
+
+  if (output.empty() || events > 0xFFFF)
+  {
+    usage();
+    return 2;
+  }
+
+  std::unique_ptr<openhand::Transport> transport;
+  try
+  {
+    if (!serial.empty())
+    {
+      transport = openhand::openSerial(serial, baud);
+    }
+    else if (!tcp.empty())
+    {
+      const std::size_t colon = tcp.rfind(':');
+      if (colon == std::string::npos)
+      {
+        usage();
+        return 2;
+      }
+      transport = openhand::openTcp(tcp.substr(0, colon), static_cast<std::uint16_t>(std::strtoul(tcp.c_str() + colon + 1, nullptr, 10)));
+    }
+    else if (!replay.empty())
+    {
+      transport = openhand::openReplay(replay, speed);
+    }
+    else
+    {
+      usage();
+      return 2;
+    }
+  }
+  catch (const std::exception &e)
+  {
+    std::fprintf(stderr, "openhand-trace: %s\n", e.what());
+    return 1;
+  }
+
+  std::FILE *file = std::fopen(output.c_str(), "w");
+  if (file == nullptr)
+  {
+    std::fprintf(stderr, "openhand-trace: can't create %s\n", output.c_str());
+    return 1;
+  }
+
+  std::size_t written = 0;
+  {
+    Writer writer(file);
+    Converter converter(writer);
+
+    /* Everything is dispatched on this thread, so the converter needs no lock */
+    openhand::Client client(std::move(transport));
+    client.on<openhand::msg::TraceTasks>([&](const openhand::msg::TraceTasks &msg, const openhand::Frame &) { converter.tasks(msg); });
+    client.on<openhand::msg::Trace>([&](const openhand::msg::Trace &msg, const openhand::Frame &) { converter.trace(msg); });
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    client.start(false);
+    if (events >= 0 && replay.empty())
+    {
+      setEvents(client, static_cast<std::uint16_t>(events));
+    }
+
+    const std::int64_t endNs = openhand::Client::nowNs() + static_cast<std::int64_t>(seconds * 1e9);
+    while (!stopRequested && (seconds <= 0.0 || openhand::Client::nowNs() < endNs))
+    {
+      client.dispatch(std::chrono::milliseconds(100));
+      const openhand::ClientStats stats = client.stats();
+      if (!stats.running && stats.dispatched + stats.queueDrops >= stats.rxFrames)
+      {
+        break;
+      }
+    }
+
+    if (events > 0 && replay.empty())
+    {
+      setEvents(client, 0);
+    }
+    client.stop();
+
+    converter.finish();
+    written = writer.count();
+
+    const openhand::ClientStats stats = client.stats();
+    std::fprintf(stderr, "openhand-trace: %zu trace events from %llu frames (crc %llu, lost %llu)\n", written,
+                 static_cast<unsigned long long>(stats.rxFrames), static_cast<unsigned long long>(stats.crcErrors),
+                 static_cast<unsigned long long>(stats.lostFrames));
+  }
+  std::fclose(file);
+
+  return 0;
+}
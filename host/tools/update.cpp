@@ -0,0 +1,382 @@
+/**
+ * @file update.cpp
+ *
+ * @author Aleksa Heler (aleksaheler@gmail.com)
+ *
+ * @brief openhand-update: puts a new application onto the STM32 over the telemetry link
+ *
+ *   openhand-update --serial /dev/ttyUSB0 [--baud 1000000] app.bin
+ *   openhand-update --tcp localhost:5760 [--confirm-seconds 30] app.bin
+ *
+ * The image is the application part of the STM32 build, without the boot stage:
+ *
+ *   arm-none-eabi-objcopy -O binary -R .boot OpenHandFirmware.elf app.bin
+ *
+ * Directly on UART4 of the STM32, or through the ESP32, which passes the UPD frames of a trusted host on.
+ * Sends BEGIN, the chunks and COMMIT (upd.c), repeating every request whose reply doesn't come. Once committed,
+ * the boot stage swaps the new image in on the reset, and the tool asks for the status until the new image
+ * replies: that reply confirms it. If it never does, resetting the board swaps the old application back.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "openhand/client.hpp"
+
+namespace {
+
+/// Most image bytes in one DATA frame, UPD_CHUNK_SIZE
+constexpr std::size_t kChunkSize = 128;
+
+/// upd_Status_e
+enum Status : std::uint8_t
+{
+  kOk = 0,
+  kRefused,
+  kBadRequest,
+  kBadState,
+  kBadOffset,
+  kFlashError,
+  kBadCrc
+};
+
+/// upd_Image_e
+enum Image : std::uint8_t
+{
+  kImageNone = 0,
+  kImageCommitted,
+  kImageTrial,
+  kImageConfirmed,
+  kImageReverted
+};
+
+/// Replies take this long at most, but BEGIN erases the whole staging area first (up to 122 pages of about 20 ms)
+constexpr std::chrono::milliseconds kReplyTimeout{1000};
+constexpr std::chrono::milliseconds kBeginTimeout{6000};
+constexpr std::chrono::milliseconds kStatusInterval{500};
+constexpr std::chrono::milliseconds kRefusedDelay{1000};
+
+/// Times a request is sent without a reply, or a begin is refused, before giving up
+constexpr int kAttempts = 5;
+
+void usage()
+{
+  std::fprintf(stderr, "usage: openhand-update (--serial PATH [--baud N] | --tcp HOST:PORT) [--confirm-seconds N] IMAGE\n");
+}
+
+const char *statusName(std::uint8_t status)
+{
+  switch (status)
+  {
+  case kOk: return "ok";
+  case kRefused: return "refused, fingers moving, calibrating or homing";
+  case kBadRequest: return "bad request";
+  case kBadState: return "bad state";
+  case kBadOffset: return "bad offset";
+  case kFlashError: return "flash error";
+  case kBadCrc: return "bad CRC";
+  default: return "unknown status";
+  }
+}
+
+/// Same CRC-32 as upd_f_Crc32_u32() and boot_f_Crc32_u32()
+std::uint32_t crc32(const std::vector<std::uint8_t> &data)
+{
+  std::uint32_t crc = 0xFFFFFFFFu;
+  for (const std::uint8_t byte : data)
+  {
+    crc ^= byte;
+    for (int i = 0; i < 8; ++i)
+    {
+      crc = (crc & 1) ? ((crc >> 1) ^ 0xEDB88320u) : (crc >> 1);
+    }
+  }
+  return ~crc;
+}
+
+void putU32(std::uint8_t *out, std::uint32_t value)
+{
+  for (int i = 0; i < 4; ++i)
+  {
+    out[i] = static_cast<std::uint8_t>(value >> (8 * i));
+  }
+}
+
+/// Last reply of the board, written and read on this thread only, as it dispatches itself
+struct Reply
+{
+  bool received = false;
+  std::uint8_t reqId = 0;
+  std::uint8_t status = 0;
+  std::uint32_t next = 0;
+  std::uint8_t image = 0;
+  std::uint32_t crc = 0;
+};
+
+class Updater
+{
+public:
+  explicit Updater(openhand::Client &client) : client_(client)
+  {
+    client_.on<openhand::msg::UpdReply>([this](const openhand::msg::UpdReply &msg, const openhand::Frame &) {
+      reply_ = Reply{true, msg.reqId(), msg.status(), msg.next(), msg.image(), msg.crc()};
+    });
+  }
+
+  /// Send a request and wait for its reply, once
+  bool request(openhand::msg::Id id, const std::uint8_t *payload, std::size_t size, std::chrono::milliseconds timeout)
+  {
+    reply_.received = false;
+    if (!client_.send(id, payload, size))
+    {
+      return false;
+    }
+
+    const std::int64_t endNs = openhand::Client::nowNs() + std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count();
+    while (openhand::Client::nowNs() < endNs)
+    {
+      client_.dispatch(std::chrono::milliseconds(10));
+      if (reply_.received && reply_.reqId == static_cast<std::uint8_t>(id))
+      {
+        return true;
+      }
+      reply_.received = false;
+    }
+    return false;
+  }
+
+  /// Send a request until it gets a reply, a refused one is repeated a bit later
+  bool exchange(openhand::msg::Id id, const std::uint8_t *payload, std::size_t size, std::chrono::milliseconds timeout)
+  {
+    for (int attempt = 0; attempt < kAttempts; ++attempt)
+    {
+      if (request(id, payload, size, timeout))
+      {
+        if (reply_.status != kRefused)
+        {
+          return true;
+        }
+        std::this_thread::sleep_for(kRefusedDelay);
+      }
+    }
+    return false;
+  }
+
+  /// BEGIN, the chunks from wherever the board wants them, COMMIT
+  bool send(const std::vector<std::uint8_t> &image, std::uint32_t crc)
+  {
+    std::uint8_t payload[4 + kChunkSize];
+
+    putU32(payload, static_cast<std::uint32_t>(image.size()));
+    putU32(payload + 4, crc);
+    if (!exchange(openhand::msg::Id::UpdBegin, payload, 8, kBeginTimeout))
+    {
+      return fail("no reply to begin");
+    }
+    if (reply_.status != kOk)
+    {
+      return fail("begin", reply_.status);
+    }
+    if (reply_.next != 0)
+    {
+      std::fprintf(stderr, "openhand-update: resuming at %u of %zu bytes\n", reply_.next, image.size());
+    }
+
+    std::size_t lastPercent = 101;
+    std::uint32_t offset = reply_.next;
+    while (offset < image.size())
+    {
+      const std::size_t len = std::min(kChunkSize, image.size() - offset);
+      putU32(payload, offset);
+      std::copy(image.begin() + offset, image.begin() + offset + len, payload + 4);
+
+      if (!exchange(openhand::msg::Id::UpdData, payload, 4 + len, kReplyTimeout))
+      {
+        return fail("no reply to data");
+      }
+      if (reply_.status != kOk && reply_.status != kBadOffset)
+      {
+        return fail("data", reply_.status);
+      }
+      offset = reply_.next;
+
+      const std::size_t percent = (100 * static_cast<std::size_t>(offset)) / image.size();
+      if (percent / 10 != lastPercent / 10)
+      {
+        std::fprintf(stderr, "openhand-update: %zu%%\n", percent);
+        lastPercent = percent;
+      }
+    }
+
+    if (!exchange(openhand::msg::Id::UpdCommit, nullptr, 0, kReplyTimeout))
+    {
+      return fail("no reply to commit");
+    }
+    if (reply_.status != kOk)
+    {
+      return fail("commit", reply_.status);
+    }
+    return true;
+  }
+
+  /// Ask for the status until the new image replies, which confirms it, or the boot stage has taken it back
+  bool confirm(std::uint32_t crc, double seconds)
+  {
+    const std::int64_t endNs = openhand::Client::nowNs() + static_cast<std::int64_t>(seconds * 1e9);
+    while (openhand::Client::nowNs() < endNs)
+    {
+      if (request(openhand::msg::Id::UpdStatus, nullptr, 0, kStatusInterval) && reply_.crc == crc)
+      {
+        if (reply_.image == kImageConfirmed)
+        {
+          return true;
+        }
+        if (reply_.image == kImageReverted)
+        {
+          return fail("the boot stage took the new image back, the old one is running again");
+        }
+        std::this_thread::sleep_for(kStatusInterval);
+      }
+    }
+    return fail("the new image didn't reply in time, resetting the board swaps the old one back");
+  }
+
+private:
+  static bool fail(const char *what)
+  {
+    std::fprintf(stderr, "openhand-update: %s\n", what);
+    return false;
+  }
+
+  static bool fail(const char *what, std::uint8_t status)
+  {
+    std::fprintf(stderr, "openhand-update: %s failed: %s\n", what, statusName(status));
+    return false;
+  }
+
+  openhand::Client &client_;
+  Reply reply_;
+};
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  std::string serial, tcp, path;
+  unsigned baud = 1000000;
+  double confirmSeconds = 30.0;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    const bool hasValue = (i + 1 < argc);
+    if (arg == "--serial" && hasValue)
+    {
+      serial = argv[++i];
+    }
+    else if (arg == "--baud" && hasValue)
+    {
+      baud = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+    }
+    else if (arg == "--tcp" && hasValue)
+    {
+      tcp = argv[++i];
+    }
+    else if (arg == "--confirm-seconds" && hasValue)
+    {
+      confirmSeconds = std::strtod(argv[++i], nullptr);
+    }
+    else if (path.empty() && !arg.empty() && arg[0] != '-')
+    {
+      path = arg;
+    }
+    else
+    {
+      usage();
+      return 2;
+    }
+  }
+
+  if (path.empty())
+  {
+    usage();
+    return 2;
+  }
+
+  std::ifstream file(path, std::ios::binary);
+  const std::vector<std::uint8_t> image((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  if (!file.good() && !file.eof())
+  {
+    std::fprintf(stderr, "openhand-update: can't read %s\n", path.c_str());
+    return 1;
+  }
+  if (image.empty())
+  {
+    std::fprintf(stderr, "openhand-update: %s is empty\n", path.c_str());
+    return 1;
+  }
+
+  std::unique_ptr<openhand::Transport> transport;
+  try
+  {
+    if (!serial.empty())
+    {
+      transport = openhand::openSerial(serial, baud);
+    }
+    else if (!tcp.empty())
+    {
+      const std::size_t colon = tcp.rfind(':');
+      if (colon == std::string::npos)
+      {
+        usage();
+        return 2;
+      }
+      transport = openhand::openTcp(tcp.substr(0, colon), static_cast<std::uint16_t>(std::strtoul(tcp.c_str() + colon + 1, nullptr, 10)));
+    }
+    else
+    {
+      usage();
+      return 2;
+    }
+  }
+  catch (const std::exception &e)
+  {
+    std::fprintf(stderr, "openhand-update: %s\n", e.what());
+    return 1;
+  }
+
+  const std::uint32_t crc = crc32(image);
+  std::fprintf(stderr, "openhand-update: %s, %zu bytes, CRC-32 %08x\n", path.c_str(), image.size(), crc);
+
+  openhand::Client client(std::move(transport));
+  Updater updater(client);
+  client.start(false);
+
+  bool ok = updater.send(image, crc);
+  if (ok)
+  {
+    std::fprintf(stderr, "openhand-update: committed, waiting for the new image\n");
+    ok = updater.confirm(crc, confirmSeconds);
+  }
+  client.stop();
+
+  if (ok)
+  {
+    std::fprintf(stderr, "openhand-update: new image running and confirmed\n");
+  }
+  return ok ? 0 : 1;
+}